@@ -0,0 +1,198 @@
+/**
+ * @file automation_protocol.cpp
+ * @brief Разбор команд автоматизации и объединение трансформаций
+ */
+
+#include "automation_protocol.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <sstream>
+
+namespace s21 {
+
+namespace {
+
+bool ParseAxis(const std::string& text, transformation_t& axis) {
+  if (text == "x" || text == "X") {
+    axis = kX;
+  } else if (text == "y" || text == "Y") {
+    axis = kY;
+  } else if (text == "z" || text == "Z") {
+    axis = kZ;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+bool ParseNumber(const std::string& text, double& value) {
+  if (text.empty()) return false;
+  char* end = nullptr;
+  value = std::strtod(text.c_str(), &end);
+  return end == text.c_str() + text.size() && std::isfinite(value);
+}
+
+/**
+ * @brief Разбирает одну команду из слов
+ */
+bool BuildCommand(const std::vector<std::string>& words,
+                  AutomationCommand& command, std::string& error) {
+  size_t next = 0;
+  if (words[0][0] == '@') {
+    command.id = words[0].substr(1);
+    ++next;
+  }
+  if (next >= words.size()) {
+    error = "missing command";
+    return false;
+  }
+
+  const std::string& name = words[next++];
+  size_t expected = 0;
+  if (name == "ping") {
+    command.type = kCommandPing;
+  } else if (name == "stats") {
+    command.type = kCommandStats;
+  } else if (name == "quit") {
+    command.type = kCommandQuit;
+  } else if (name == "load") {
+    command.type = kCommandLoad;
+    expected = 1;
+    if (next < words.size()) command.path = words[next];
+  } else if (name == "capture") {
+    command.type = kCommandCapture;
+    command.value = 1.0;
+    expected = words.size() - next == 2 ? 2 : 1;
+    if (next < words.size()) command.path = words[next];
+    if (expected == 2 &&
+        (!ParseNumber(words[next + 1], command.value) ||
+         command.value < 1.0 || command.value > kMaxCaptureScale ||
+         command.value != static_cast<int>(command.value))) {
+      error = "capture: scale must be an integer 1.." +
+              std::to_string(kMaxCaptureScale);
+      return false;
+    }
+  } else if (name == "record") {
+    command.type = kCommandRecord;
+    command.value = kDefaultRecordSeconds;
+    expected = words.size() - next == 2 ? 2 : 1;
+    if (next < words.size()) command.path = words[next];
+    if (expected == 2 &&
+        (!ParseNumber(words[next + 1], command.value) ||
+         command.value <= 0.0 || command.value > kMaxRecordSeconds)) {
+      error = "record: seconds must be in (0, " +
+              std::to_string(static_cast<int>(kMaxRecordSeconds)) + "]";
+      return false;
+    }
+  } else if (name == "move" || name == "rotate") {
+    command.type = kCommandTransform;
+    command.strategy = name == "move" ? kMove : kRotate;
+    expected = 2;
+    if (next + 1 < words.size() && !ParseAxis(words[next], command.axis)) {
+      error = name + ": bad axis '" + words[next] + "'";
+      return false;
+    }
+    if (next + 1 < words.size() &&
+        !ParseNumber(words[next + 1], command.value)) {
+      error = name + ": bad value '" + words[next + 1] + "'";
+      return false;
+    }
+  } else if (name == "scale") {
+    command.type = kCommandTransform;
+    command.strategy = kScale;
+    expected = 1;
+    if (next < words.size() &&
+        (!ParseNumber(words[next], command.value) || command.value <= 0.0)) {
+      error = "scale: bad factor '" + words[next] + "'";
+      return false;
+    }
+  } else {
+    error = "unknown command '" + name + "'";
+    return false;
+  }
+
+  if (words.size() - next != expected) {
+    error = name + ": expected " + std::to_string(expected) + " argument" +
+            (expected == 1 ? "" : "s");
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+bool ParseAutomationBatch(const std::string& line,
+                          std::vector<AutomationCommand>& commands,
+                          std::string& error) {
+  std::istringstream statements(line);
+  std::string statement;
+  while (std::getline(statements, statement, ';')) {
+    std::istringstream input(statement);
+    std::vector<std::string> words;
+    for (std::string word; input >> word;) words.push_back(word);
+    if (words.empty()) continue;
+
+    AutomationCommand command;
+    if (!BuildCommand(words, command, error)) return false;
+    commands.push_back(std::move(command));
+  }
+  return true;
+}
+
+std::string FormatAutomationReply(const std::string& id, bool ok,
+                                  const std::string& text) {
+  std::string reply;
+  if (!id.empty()) reply = '@' + id + ' ';
+  reply += ok ? "ok" : "error";
+  if (!text.empty()) {
+    reply += ' ';
+    for (char c : text) reply += c == '\n' || c == '\r' ? ' ' : c;
+  }
+  reply += '\n';
+  return reply;
+}
+
+void TransformCoalescer::Add(int strategy, double value,
+                             transformation_t axis) {
+  if (strategy == kScale) axis = kX;
+  ++pending_commands_;
+
+  if (!pending_.empty()) {
+    CoalescedTransform& last = pending_.back();
+    if (last.strategy == strategy && last.axis == axis) {
+      last.value = strategy == kScale ? last.value * value : last.value + value;
+      ++last.merged;
+      ++coalesced_;
+      return;
+    }
+  }
+
+  CoalescedTransform transform;
+  transform.strategy = strategy;
+  transform.axis = axis;
+  transform.value = value;
+  pending_.push_back(transform);
+}
+
+std::vector<CoalescedTransform> TransformCoalescer::Take() {
+  std::vector<CoalescedTransform> result;
+  result.reserve(pending_.size());
+  for (const CoalescedTransform& transform : pending_) {
+    const double change = transform.strategy == kScale
+                              ? transform.value - 1.0
+                              : transform.value;
+    if (std::abs(change) > kNoOpThreshold) {
+      result.push_back(transform);
+    } else {
+      // Например, поворот туда и обратно: применять нечего. Слитые
+      // команды уже учтены в Add, остаётся первая из группы
+      ++coalesced_;
+    }
+  }
+  pending_.clear();
+  pending_commands_ = 0;
+  return result;
+}
+
+}  // namespace s21
@@ -0,0 +1,156 @@
+#ifndef AUTOMATION_AUTOMATION_PROTOCOL_H
+#define AUTOMATION_AUTOMATION_PROTOCOL_H
+
+/**
+ * @file automation_protocol.h
+ * @brief Протокол управления запущенным просмотрщиком из скриптов
+ */
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "../model/tranformation.h"
+#include "../render/camera.h"
+
+namespace s21 {
+
+/**
+ * @brief Команды автоматизации
+ */
+enum automation_command_t {
+  kCommandPing = 0,       ///< Проверка связи, ответ сразу
+  kCommandLoad = 1,       ///< Загрузка OBJ файла
+  kCommandTransform = 2,  ///< Перемещение, поворот или масштаб
+  kCommandCapture = 3,    ///< Снимок кадра (BMP, JPEG или PNG)
+  kCommandStats = 4,      ///< Счётчики модели и канала
+  kCommandQuit = 5,       ///< Закрыть соединение
+  kCommandRecord = 6      ///< Запись экрана в GIF
+};
+
+constexpr double kDefaultRecordSeconds = 5.0;  ///< Длительность записи
+constexpr double kMaxRecordSeconds = 60.0;     ///< Наибольшая длительность
+
+/**
+ * @brief Одна команда пакета
+ */
+struct AutomationCommand {
+  std::string id;  ///< Идентификатор запроса (эхо в ответе), может быть пуст
+  automation_command_t type = kCommandPing;  ///< Тип команды
+  int strategy = kMove;        ///< Тип трансформации для kCommandTransform
+  transformation_t axis = kX;  ///< Ось трансформации
+  /// Смещение, угол, масштаб, увеличение снимка или длительность записи
+  double value = 0.0;
+  std::string path;  ///< Файл для load, capture и record
+};
+
+/**
+ * @brief Разбирает строку пакета команд
+ *
+ * Команды разделяются ';' и образуют один пакет. Перед командой может
+ * стоять идентификатор "@<id>", который повторяется в ответе:
+ * @code
+ * @1 load /models/cube.obj; @2 rotate y 30; move x 0.5; scale 1.2
+ * @3 capture /tmp/frame.png
+ * @4 capture /tmp/poster.jpg 4
+ * @5 record /tmp/screencast.gif 5
+ * stats
+ * @endcode
+ *
+ * Второй аргумент capture - во сколько раз снимок больше окна (1 по
+ * умолчанию), формат файла определяется расширением. Аргумент record -
+ * длительность записи в секундах (kDefaultRecordSeconds по умолчанию).
+ *
+ * @param line Строка без перевода строки
+ * @param commands Выходной пакет (дописывается)
+ * @param error Описание первой ошибки
+ * @return false при ошибке; команды до ошибочной остаются в commands
+ */
+bool ParseAutomationBatch(const std::string& line,
+                          std::vector<AutomationCommand>& commands,
+                          std::string& error);
+
+/**
+ * @brief Формирует строку ответа
+ *
+ * Формат: "[@<id> ]ok[ <text>]\n" или "[@<id> ]error <text>\n".
+ * Переводы строк в тексте заменяются пробелами.
+ */
+std::string FormatAutomationReply(const std::string& id, bool ok,
+                                  const std::string& text);
+
+/**
+ * @brief Трансформация после объединения
+ */
+struct CoalescedTransform {
+  int strategy = kMove;        ///< Тип трансформации
+  transformation_t axis = kX;  ///< Ось
+  double value = 0.0;  ///< Суммарное смещение/угол или произведение масштабов
+  size_t merged = 1;   ///< Сколько команд объединено
+};
+
+/**
+ * @brief Объединяет частые команды трансформации между кадрами
+ *
+ * Команды копятся до следующего вывода кадра. Подряд идущие команды одного
+ * типа по одной оси складываются (перемещение, поворот) или
+ * перемножаются (масштаб), как приращения слайдера при быстром движении.
+ * Разные типы не переставляются: перемещение и поворот не коммутируют.
+ * Объединённые приращения меньше порога слайдеров не применяются.
+ *
+ * @example
+ * @code
+ * TransformCoalescer coalescer;
+ * coalescer.Add(kRotate, 1.0, kY);
+ * coalescer.Add(kRotate, 2.0, kY);
+ * for (const CoalescedTransform& t : coalescer.Take()) {
+ *   controller.TransformModel(t.strategy, t.value, t.axis);  // 3 градуса
+ * }
+ * @endcode
+ */
+class TransformCoalescer {
+ public:
+  /// Порог приращения, как у слайдеров (View::CreateSliderHandler_)
+  static constexpr double kNoOpThreshold = 0.001;
+
+  /**
+   * @brief Добавляет команду трансформации
+   * @param strategy Тип трансформации (kMove, kRotate, kScale)
+   * @param value Приращение или коэффициент масштаба
+   * @param axis Ось (для масштаба не учитывается)
+   */
+  void Add(int strategy, double value, transformation_t axis);
+
+  /**
+   * @brief Забирает накопленные трансформации, пропуская пустые
+   * @return Трансформации в порядке поступления
+   */
+  std::vector<CoalescedTransform> Take();
+
+  /**
+   * @brief Проверяет, есть ли накопленные команды
+   */
+  bool IsEmpty() const noexcept { return pending_.empty(); }
+
+  /**
+   * @brief Возвращает количество накопленных команд до объединения
+   */
+  size_t GetPendingCount() const noexcept { return pending_commands_; }
+
+  /**
+   * @brief Возвращает общее количество поглощённых команд
+   *
+   * Команда считается поглощённой, если она слита с предыдущей или
+   * её приращение оказалось меньше порога.
+   */
+  size_t GetCoalescedCount() const noexcept { return coalesced_; }
+
+ private:
+  std::vector<CoalescedTransform> pending_;  ///< Накопленные трансформации
+  size_t pending_commands_ = 0;  ///< Команд в pending_
+  size_t coalesced_ = 0;         ///< Всего поглощено команд
+};
+
+}  // namespace s21
+
+#endif  // AUTOMATION_AUTOMATION_PROTOCOL_H
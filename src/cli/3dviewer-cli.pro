@@ -0,0 +1,66 @@
+QT -= core gui
+
+CONFIG += console c++20
+CONFIG -= qt app_bundle
+
+QMAKE_CXXFLAGS += -Wall -Wextra -Wpedantic -std=c++20
+
+CONFIG(release, debug|release) {
+    QMAKE_CXXFLAGS += -O2
+}
+
+CONFIG(debug, debug|release) {
+    QMAKE_CXXFLAGS += -g -O0
+}
+
+LIBS += -pthread -lz
+
+TARGET = 3dviewer-cli
+TEMPLATE = app
+
+INCLUDEPATH += $$PWD/.. \
+               $$PWD/../model \
+               $$PWD/../render
+
+# Модель подключается теми же исходниками, что и в 3DViewer.pro, но без
+# Qt: загрузка и трансформации идут по одному коду с GUI
+SOURCES += \
+    main.cpp \
+    batch_runner.cpp \
+    batch_script.cpp \
+    render_service.cpp \
+    ../model/bvh.cpp \
+    ../model/deviation.cpp \
+    ../model/hull.cpp \
+    ../model/mesh_tools.cpp \
+    ../model/obj_parser.cpp \
+    ../model/slicer.cpp \
+    ../model/topology.cpp \
+    ../model/tranformation.cpp \
+    ../render/camera.cpp \
+    ../render/image.cpp \
+    ../render/model_cache.cpp \
+    ../render/rasterizer.cpp \
+    ../render/render_mesh.cpp \
+    ../render/vector_export.cpp
+
+HEADERS += \
+    batch_runner.h \
+    batch_script.h \
+    render_service.h \
+    ../model/bvh.h \
+    ../model/deviation.h \
+    ../model/hull.h \
+    ../model/mesh.h \
+    ../model/mesh_tools.h \
+    ../model/obj_parser.h \
+    ../model/parallel.h \
+    ../model/slicer.h \
+    ../model/topology.h \
+    ../model/tranformation.h \
+    ../render/camera.h \
+    ../render/image.h \
+    ../render/model_cache.h \
+    ../render/rasterizer.h \
+    ../render/render_mesh.h \
+    ../render/vector_export.h
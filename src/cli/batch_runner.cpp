@@ -0,0 +1,419 @@
+/**
+ * @file batch_runner.cpp
+ * @brief Реализация пакетного исполнителя
+ */
+
+#include "batch_runner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+
+#include "../model/obj_parser.h"
+#include "../model/parallel.h"
+#include "../model/slicer.h"
+#include "../model/tranformation.h"
+#include "../render/rasterizer.h"
+#include "../render/vector_export.h"
+
+namespace s21 {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double ElapsedMs(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+      .count();
+}
+
+bool IsParseError(int error) {
+  return error == kIncorrectData || error == kIndexOutOfRange;
+}
+
+/**
+ * @brief Место и токен ошибки разбора для сообщения
+ */
+std::string ParseErrorText(const ObjParseError& error) {
+  std::string text =
+      error.line > 0 ? "line " + std::to_string(error.line) + ", column " +
+                           std::to_string(error.column)
+                     : "offset " + std::to_string(error.offset);
+  text += error.token.empty() ? ", missing value"
+                              : ", token \"" + error.token + '"';
+  if (error.code == kIndexOutOfRange) {
+    text += error.element == 'l' ? ", polyline " : ", face ";
+    text += std::to_string(error.face + 1) + " references vertex " +
+            std::to_string(error.index) + " of " +
+            std::to_string(error.vertex_count);
+  }
+  return text;
+}
+
+const char* ErrorText(int error) {
+  switch (error) {
+    case kFileWrongExtension:
+      return "wrong extension, expected .obj";
+    case kFailedToOpen:
+      return "failed to open";
+    case kIncorrectData:
+      return "incorrect data";
+    case kFailedToWrite:
+      return "failed to write";
+    case kIndexOutOfRange:
+      return "vertex index out of range";
+    default:
+      return "ok";
+  }
+}
+
+int TransformType(batch_op_t type) {
+  switch (type) {
+    case kOpMove:
+      return kMove;
+    case kOpRotate:
+      return kRotate;
+    default:
+      return kScale;
+  }
+}
+
+/**
+ * @brief Камера, вписывающая модель в кадр с полем в 5% по краям
+ */
+Camera FitCamera(const MeshStats& stats) {
+  Camera camera;
+  double extent = 0.0;
+  for (int axis = 0; axis < 3; ++axis) {
+    extent = std::max(extent, stats.max[axis] - stats.min[axis]);
+  }
+  camera.scale = extent > 0.0 ? 1.8 / extent : 1.0;
+  for (int axis = 0; axis < 3; ++axis) {
+    camera.translate[axis] =
+        -(stats.min[axis] + stats.max[axis]) * 0.5 * camera.scale;
+  }
+  return camera;
+}
+
+/**
+ * @brief Создаёт каталог выходного файла
+ */
+void CreateParentDirectory(const std::string& output) {
+  const std::filesystem::path parent =
+      std::filesystem::path(output).parent_path();
+  std::error_code code;
+  if (!parent.empty()) std::filesystem::create_directories(parent, code);
+}
+
+}  // namespace
+
+/**
+ * @brief Состояние рабочего потока, переиспользуемое между файлами
+ */
+struct BatchRunner::Worker {
+  ObjParser parser;
+  Transformer transformer;
+  Mesh mesh;
+  Rasterizer rasterizer;
+  Image image;
+  VectorExporter exporter;
+  Topology topology;
+};
+
+BatchRunner::BatchRunner(std::vector<BatchOp> ops) : ops_(std::move(ops)) {}
+
+std::vector<BatchFileResult> BatchRunner::Run(
+    const std::vector<std::string>& files, unsigned threads,
+    BatchSummary& summary) {
+  if (threads == 0) threads = DefaultThreadCount();
+  threads = static_cast<unsigned>(
+      std::min<size_t>(threads, std::max<size_t>(files.size(), 1)));
+
+  std::vector<BatchFileResult> results(files.size());
+  std::vector<Worker> workers(threads);
+  for (Worker& worker : workers) worker.parser.SetLenient(lenient_);
+  for (size_t i = 0; i < files.size(); ++i) results[i].path = files[i];
+
+  const Clock::time_point start = Clock::now();
+  ParallelFor(files.size(), threads, [&](unsigned worker, size_t index) {
+    ProcessFile_(workers[worker], results[index]);
+  });
+
+  summary = BatchSummary();
+  summary.wall_ms = ElapsedMs(start);
+  summary.threads = threads;
+  summary.files = results.size();
+  for (const BatchFileResult& result : results) {
+    if (result.error != kNoError) ++summary.failed;
+    summary.bytes += result.bytes;
+    summary.vertices += result.vertex_count;
+  }
+  return results;
+}
+
+void BatchRunner::ProcessFile_(Worker& worker, BatchFileResult& result) const {
+  const Clock::time_point start = Clock::now();
+  std::error_code code;
+  const auto size = std::filesystem::file_size(result.path, code);
+  result.bytes = code ? 0 : static_cast<size_t>(size);
+
+  auto load = [&worker, &result] {
+    const Clock::time_point load_start = Clock::now();
+    result.error = worker.parser.Load(result.path, worker.mesh);
+    result.load_ms += ElapsedMs(load_start);
+    const ObjParseError& error = worker.parser.GetLastError();
+    if (result.error == kNoError) {
+      result.vertex_count = worker.mesh.GetVertexCount();
+      result.skipped_lines = error.skipped_lines;
+      if (error.skipped_lines > 0) result.first_skipped = ParseErrorText(error);
+    } else if (IsParseError(result.error)) {
+      result.message = ParseErrorText(error) + ": ";
+    }
+  };
+
+  load();
+  for (size_t i = 0; i < ops_.size() && result.error == kNoError; ++i) {
+    const BatchOp& op = ops_[i];
+    switch (op.type) {
+      case kOpLoad:
+        load();
+        break;
+      case kOpMove:
+      case kOpRotate:
+      case kOpScale:
+        worker.transformer.Apply(worker.mesh.vertex_coord,
+                                 TransformType(op.type), op.value, op.axis);
+        break;
+      case kOpWeld:
+        result.welded += WeldVertices(worker.mesh, op.value);
+        break;
+      case kOpStats:
+        result.stats.push_back(ComputeMeshStats(worker.mesh));
+        break;
+      case kOpExport: {
+        const std::string output = ExpandOutputPath(op.path, result.path);
+        CreateParentDirectory(output);
+        result.error = ExportObj(worker.mesh, output);
+        if (result.error == kNoError) {
+          result.exported.push_back(output);
+        } else {
+          result.message = "export " + output + ": ";
+        }
+        break;
+      }
+      case kOpThumbnail: {
+        const std::string output = ExpandOutputPath(op.path, result.path);
+        const int size = static_cast<int>(op.value);
+        CreateParentDirectory(output);
+        worker.rasterizer.Render(BuildRenderMesh(worker.mesh),
+                                 FitCamera(ComputeMeshStats(worker.mesh)),
+                                 RenderStyle(), size, size, worker.image);
+        if (WritePng(worker.image, output)) {
+          result.thumbnails.push_back(output);
+        } else {
+          result.error = kFailedToWrite;
+          result.message = "thumbnail " + output + ": ";
+        }
+        break;
+      }
+      case kOpVector: {
+        const std::string output = ExpandOutputPath(op.path, result.path);
+        const int size = static_cast<int>(op.value);
+        const VectorStyle style;
+        CreateParentDirectory(output);
+        const auto lines = worker.exporter.Build(
+            worker.mesh, FitCamera(ComputeMeshStats(worker.mesh)), size, size,
+            style);
+        if (WriteVectorDrawing(output, lines, size, size, style)) {
+          result.drawings.push_back(output);
+        } else {
+          result.error = kFailedToWrite;
+          result.message = "vector " + output + ": ";
+        }
+        break;
+      }
+      case kOpSection: {
+        // Файлы уже разложены по потокам: сечение строится в одном
+        const std::string output = ExpandOutputPath(op.path, result.path);
+        CreateParentDirectory(output);
+        Slicer slicer;
+        slicer.Build(worker.mesh);
+        SlicePlane plane;
+        plane.normal[2] = 0.0;
+        plane.normal[op.axis] = 1.0;
+        plane.offset = op.value;
+        const Section section = slicer.Slice(plane);
+        result.error = ExportSection(section, output);
+        if (result.error == kNoError) {
+          result.sections.push_back(
+              {output, section.polylines.size(), section.GetPointCount()});
+        } else {
+          result.message = "section " + output + ": ";
+        }
+        break;
+      }
+      case kOpTopology:
+        worker.topology.Build(worker.mesh);
+        result.topology.push_back(worker.topology.GetStats());
+        break;
+      case kOpDeviation: {
+        BatchDeviation deviation;
+        deviation.reference = ExpandOutputPath(op.path, result.path);
+        Mesh reference;
+        result.error = worker.parser.Load(deviation.reference, reference);
+        if (result.error != kNoError) {
+          result.message = "deviation " + deviation.reference + ": ";
+          if (IsParseError(result.error)) {
+            result.message +=
+                ParseErrorText(worker.parser.GetLastError()) + ": ";
+          }
+          break;
+        }
+        // Хаусдорф симметричен: нужны оба направления
+        std::vector<float> distance;
+        Deviation to_reference, to_model;
+        to_reference.Build(reference);
+        deviation.stats = to_reference.Measure(worker.mesh.vertex_coord,
+                                               distance);
+        to_model.Build(worker.mesh);
+        deviation.hausdorff =
+            std::max(deviation.stats.max,
+                     to_model.Measure(reference.vertex_coord, distance).max);
+        result.deviations.push_back(std::move(deviation));
+        break;
+      }
+    }
+  }
+
+  if (result.error != kNoError) {
+    result.message += ErrorText(result.error);
+  }
+  result.total_ms = ElapsedMs(start);
+}
+
+bool BatchRunner::CollectInputFiles(const std::vector<std::string>& inputs,
+                                    std::vector<std::string>& files,
+                                    std::string& error) {
+  namespace fs = std::filesystem;
+  files.clear();
+
+  for (const std::string& input : inputs) {
+    std::error_code code;
+    if (!fs::is_directory(input, code)) {
+      if (!fs::exists(input, code)) {
+        error = "no such file or directory: " + input;
+        return false;
+      }
+      files.push_back(input);
+      continue;
+    }
+
+    std::vector<std::string> found;
+    for (const auto& entry : fs::directory_iterator(input, code)) {
+      if (entry.is_regular_file(code) &&
+          ObjParser::IsValidObjExtension(entry.path().filename().string())) {
+        found.push_back(entry.path().string());
+      }
+    }
+    std::sort(found.begin(), found.end());
+    files.insert(files.end(), found.begin(), found.end());
+  }
+  return true;
+}
+
+std::string BatchRunner::ExpandOutputPath(const std::string& pattern,
+                                          const std::string& input) {
+  static const std::string kPlaceholder = "{name}";
+  const std::string name = std::filesystem::path(input).stem().string();
+
+  std::string output = pattern;
+  for (size_t pos = output.find(kPlaceholder); pos != std::string::npos;
+       pos = output.find(kPlaceholder, pos + name.size())) {
+    output.replace(pos, kPlaceholder.size(), name);
+  }
+  return output;
+}
+
+std::string BatchRunner::FormatReport(
+    const std::vector<BatchFileResult>& results, const BatchSummary& summary) {
+  std::string report;
+  char line[512];
+
+  for (const BatchFileResult& result : results) {
+    std::snprintf(line, sizeof(line),
+                  "%-40s %8.2f ms  load %8.2f ms  %9zu vertices  %s\n",
+                  result.path.c_str(), result.total_ms, result.load_ms,
+                  result.vertex_count,
+                  result.error == kNoError ? "ok" : result.message.c_str());
+    report += line;
+
+    for (const MeshStats& stats : result.stats) {
+      std::snprintf(line, sizeof(line),
+                    "  stats: vertices %zu, edges %zu (unique %zu), faces %zu,"
+                    " box [%g %g %g] - [%g %g %g]\n",
+                    stats.vertex_count, stats.edge_count,
+                    stats.unique_edge_count, stats.face_count, stats.min[0],
+                    stats.min[1], stats.min[2], stats.max[0], stats.max[1],
+                    stats.max[2]);
+      report += line;
+    }
+    if (result.skipped_lines > 0) {
+      report += "  lenient: " + std::to_string(result.skipped_lines) +
+                " bad lines skipped, first at " + result.first_skipped + '\n';
+    }
+    if (result.welded > 0) {
+      std::snprintf(line, sizeof(line), "  weld: %zu vertices merged\n",
+                    result.welded);
+      report += line;
+    }
+    for (const std::string& output : result.exported) {
+      report += "  export: " + output + '\n';
+    }
+    for (const std::string& output : result.thumbnails) {
+      report += "  thumbnail: " + output + '\n';
+    }
+    for (const std::string& output : result.drawings) {
+      report += "  vector: " + output + '\n';
+    }
+    for (const BatchSection& section : result.sections) {
+      std::snprintf(line, sizeof(line),
+                    "  section: %s (%zu contours, %zu points)\n",
+                    section.path.c_str(), section.contours, section.points);
+      report += line;
+    }
+    for (const TopologyStats& topology : result.topology) {
+      std::snprintf(line, sizeof(line),
+                    "  topology: shells %zu, edges %zu, boundary %zu, "
+                    "non-manifold %zu, flipped %zu, %s\n",
+                    topology.component_count, topology.edge_count,
+                    topology.boundary_edge_count,
+                    topology.non_manifold_edge_count,
+                    topology.flipped_edge_count,
+                    topology.IsClosed() ? "closed" : "open");
+      report += line;
+    }
+    for (const BatchDeviation& deviation : result.deviations) {
+      std::snprintf(line, sizeof(line),
+                    "  deviation: %s max %g (vertex %zu), mean %g, rms %g, "
+                    "hausdorff %g\n",
+                    deviation.reference.c_str(), deviation.stats.max,
+                    deviation.stats.max_vertex + 1, deviation.stats.mean,
+                    deviation.stats.rms, deviation.hausdorff);
+      report += line;
+    }
+  }
+
+  const double seconds = summary.wall_ms / 1000.0;
+  const double rate = seconds > 0.0 ? 1.0 / seconds : 0.0;
+  std::snprintf(line, sizeof(line),
+                "%zu files (%zu failed) in %.1f ms on %u threads: "
+                "%.1f files/s, %.1f MB/s, %.2f Mvertices/s\n",
+                summary.files, summary.failed, summary.wall_ms,
+                summary.threads, summary.files * rate,
+                summary.bytes * rate / 1e6, summary.vertices * rate / 1e6);
+  report += line;
+  return report;
+}
+
+}  // namespace s21
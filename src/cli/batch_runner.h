@@ -0,0 +1,153 @@
+#ifndef CLI_BATCH_RUNNER_H
+#define CLI_BATCH_RUNNER_H
+
+/**
+ * @file batch_runner.h
+ * @brief Параллельное выполнение сценария над множеством файлов
+ */
+
+#include <string>
+#include <vector>
+
+#include "../model/deviation.h"
+#include "../model/mesh_tools.h"
+#include "../model/topology.h"
+#include "batch_script.h"
+
+namespace s21 {
+
+/**
+ * @brief Записанное сечение
+ */
+struct BatchSection {
+  std::string path;     ///< Выходной файл
+  size_t contours = 0;  ///< Контуров
+  size_t points = 0;    ///< Точек во всех контурах
+};
+
+/**
+ * @brief Отклонение от эталона
+ */
+struct BatchDeviation {
+  std::string reference;   ///< Файл эталона
+  DeviationStats stats;    ///< От вершин модели до эталона
+  double hausdorff = 0.0;  ///< Симметричное расстояние Хаусдорфа
+};
+
+/**
+ * @brief Результат обработки одного файла
+ */
+struct BatchFileResult {
+  std::string path;            ///< Входной файл
+  int error = kNoError;        ///< Код ошибки из error_list
+  std::string message;         ///< Описание ошибки
+  size_t bytes = 0;            ///< Размер входного файла
+  size_t vertex_count = 0;     ///< Вершин после загрузки
+  size_t skipped_lines = 0;    ///< Пропущено строк при мягком разборе
+  std::string first_skipped;   ///< Место первой пропущенной строки
+  double load_ms = 0.0;        ///< Время загрузки (все load)
+  double total_ms = 0.0;       ///< Полное время обработки файла
+  size_t welded = 0;           ///< Удалено вершин сваркой
+  std::vector<MeshStats> stats;         ///< Результаты операций stats
+  std::vector<std::string> exported;    ///< Записанные файлы
+  std::vector<std::string> thumbnails;  ///< Записанные миниатюры
+  std::vector<std::string> drawings;    ///< Записанные чертежи
+  std::vector<BatchSection> sections;   ///< Записанные сечения
+  std::vector<TopologyStats> topology;  ///< Результаты операций topology
+  std::vector<BatchDeviation> deviations;  ///< Результаты deviation
+};
+
+/**
+ * @brief Итог пакетного прогона
+ */
+struct BatchSummary {
+  size_t files = 0;      ///< Обработано файлов
+  size_t failed = 0;     ///< Из них с ошибкой
+  size_t bytes = 0;      ///< Суммарный размер входных файлов
+  size_t vertices = 0;   ///< Суммарное число вершин
+  double wall_ms = 0.0;  ///< Время прогона
+  unsigned threads = 1;  ///< Число рабочих потоков
+};
+
+/**
+ * @brief Исполнитель сценария
+ *
+ * Каждый файл обрабатывается целиком в одном потоке: ObjParser,
+ * Transformer, Mesh, растеризатор миниатюр, построитель чертежей и
+ * Topology (однопоточные: потоки уже заняты файлами) заводятся на поток
+ * и переиспользуются между файлами. Загрузка и трансформации идут через
+ * тот же код, что и в GUI (Model делегирует ObjParser и Transformer),
+ * поэтому результат совпадает побитово.
+ *
+ * @example
+ * @code
+ * std::vector<BatchOp> ops;
+ * std::string error;
+ * ParseBatchScript("rotate y 90; export out/{name}.obj", ops, error);
+ * BatchSummary summary;
+ * auto results = BatchRunner(ops).Run(files, 8, summary);
+ * std::fputs(BatchRunner::FormatReport(results, summary).c_str(), stdout);
+ * @endcode
+ */
+class BatchRunner {
+ public:
+  /**
+   * @brief Создаёт исполнитель для сценария
+   */
+  explicit BatchRunner(std::vector<BatchOp> ops);
+
+  /**
+   * @brief Обрабатывает файлы в threads потоках
+   *
+   * @param files Входные файлы
+   * @param threads Число потоков (0 - по числу ядер)
+   * @param summary Выходная сводка прогона
+   * @return Результаты в порядке входных файлов
+   */
+  std::vector<BatchFileResult> Run(const std::vector<std::string>& files,
+                                   unsigned threads, BatchSummary& summary);
+
+  /**
+   * @brief Включает мягкий разбор: неверные строки пропускаются
+   */
+  void SetLenient(bool lenient) noexcept { lenient_ = lenient; }
+
+  /**
+   * @brief Раскрывает каталоги в отсортированные списки .obj файлов
+   *
+   * @param inputs Файлы и каталоги из командной строки
+   * @param files Выходной список файлов
+   * @param error Описание ошибки
+   * @return false если путь не существует
+   */
+  static bool CollectInputFiles(const std::vector<std::string>& inputs,
+                                std::vector<std::string>& files,
+                                std::string& error);
+
+  /**
+   * @brief Подставляет имя входного файла без расширения вместо {name}
+   */
+  static std::string ExpandOutputPath(const std::string& pattern,
+                                      const std::string& input);
+
+  /**
+   * @brief Формирует текстовый отчёт: строка на файл, статистика и итог
+   */
+  static std::string FormatReport(const std::vector<BatchFileResult>& results,
+                                  const BatchSummary& summary);
+
+ private:
+  struct Worker;
+
+  /**
+   * @brief Выполняет сценарий над одним файлом
+   */
+  void ProcessFile_(Worker& worker, BatchFileResult& result) const;
+
+  std::vector<BatchOp> ops_;  ///< Операции сценария
+  bool lenient_ = false;      ///< Мягкий разбор входных файлов
+};
+
+}  // namespace s21
+
+#endif  // CLI_BATCH_RUNNER_H
@@ -0,0 +1,304 @@
+/**
+ * @file batch_script.cpp
+ * @brief Разбор сценария пакетной обработки
+ */
+
+#include "batch_script.h"
+
+#include <cctype>
+#include <cstdlib>
+#include <map>
+#include <sstream>
+
+namespace s21 {
+
+namespace {
+
+constexpr const char* kOpNames[] = {"load",   "move",      "rotate",
+                                    "scale",  "weld",      "stats",
+                                    "export", "thumbnail", "vector",
+                                    "section", "topology", "deviation"};
+
+/**
+ * @brief Поля операции до проверки
+ */
+struct RawOp {
+  std::string name;
+  std::string axis;
+  std::string value;
+  std::string path;
+};
+
+bool ParseAxis(const std::string& text, transformation_t& axis) {
+  if (text == "x" || text == "X") {
+    axis = kX;
+  } else if (text == "y" || text == "Y") {
+    axis = kY;
+  } else if (text == "z" || text == "Z") {
+    axis = kZ;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+bool ParseNumber(const std::string& text, double& value) {
+  if (text.empty()) return false;
+  char* end = nullptr;
+  value = std::strtod(text.c_str(), &end);
+  return end == text.c_str() + text.size();
+}
+
+/**
+ * @brief Проверяет поля и строит операцию
+ */
+bool BuildOp(const RawOp& raw, BatchOp& op, std::string& error) {
+  op = BatchOp();
+  bool known = false;
+  for (int type = kOpLoad; type <= kOpDeviation; ++type) {
+    if (raw.name == kOpNames[type]) {
+      op.type = static_cast<batch_op_t>(type);
+      known = true;
+    }
+  }
+  if (!known) {
+    error = "unknown operation '" + raw.name + "'";
+    return false;
+  }
+
+  if ((op.type == kOpMove || op.type == kOpRotate ||
+       op.type == kOpSection) &&
+      !ParseAxis(raw.axis, op.axis)) {
+    error = raw.name + ": expected axis x, y or z";
+    return false;
+  }
+
+  if (op.type == kOpMove || op.type == kOpRotate || op.type == kOpScale) {
+    if (!ParseNumber(raw.value, op.value)) {
+      error = raw.name + ": expected numeric value";
+      return false;
+    }
+    if (op.type == kOpScale && op.value <= 0.0) {
+      error = "scale: value must be positive";
+      return false;
+    }
+  } else if (op.type == kOpSection && !raw.value.empty()) {
+    if (!ParseNumber(raw.value, op.value)) {
+      error = "section: expected numeric level";
+      return false;
+    }
+  } else if (op.type == kOpWeld && !raw.value.empty()) {
+    if (!ParseNumber(raw.value, op.value) || op.value < 0.0) {
+      error = "weld: expected non-negative tolerance";
+      return false;
+    }
+  }
+
+  if (op.type == kOpThumbnail || op.type == kOpVector) {
+    op.value =
+        op.type == kOpThumbnail ? kDefaultThumbnailSize : kDefaultVectorSize;
+    if (!raw.value.empty() &&
+        (!ParseNumber(raw.value, op.value) || op.value < 1.0 ||
+         op.value > kMaxThumbnailSize ||
+         op.value != static_cast<int>(op.value))) {
+      error = raw.name + ": size must be an integer 1.." +
+              std::to_string(kMaxThumbnailSize);
+      return false;
+    }
+  }
+
+  if (op.type == kOpExport || op.type == kOpThumbnail ||
+      op.type == kOpVector || op.type == kOpSection ||
+      op.type == kOpDeviation) {
+    if (raw.path.empty()) {
+      error = raw.name + (op.type == kOpDeviation ? ": expected reference path"
+                                                  : ": expected output path");
+      return false;
+    }
+    op.path = raw.path;
+  }
+  return true;
+}
+
+bool ParseLines(const std::string& text, std::vector<BatchOp>& ops,
+                std::string& error) {
+  std::string statement;
+  std::istringstream input(text);
+  int line_number = 0;
+  std::string line;
+
+  while (std::getline(input, line)) {
+    ++line_number;
+    line = line.substr(0, line.find('#'));
+
+    std::istringstream statements(line);
+    while (std::getline(statements, statement, ';')) {
+      std::istringstream words(statement);
+      std::vector<std::string> args;
+      for (std::string word; words >> word;) args.push_back(word);
+      if (args.empty()) continue;
+
+      RawOp raw;
+      raw.name = args[0];
+      size_t next = 1;
+      if (raw.name == "move" || raw.name == "rotate" ||
+          raw.name == "section") {
+        if (next < args.size()) raw.axis = args[next++];
+      }
+      if (raw.name == "export" || raw.name == "thumbnail" ||
+          raw.name == "vector" || raw.name == "section" ||
+          raw.name == "deviation") {
+        if (next < args.size()) raw.path = args[next++];
+      }
+      if (raw.name != "load" && raw.name != "stats" &&
+          raw.name != "export" && raw.name != "topology" &&
+          raw.name != "deviation") {
+        if (next < args.size()) raw.value = args[next++];
+      }
+
+      BatchOp op;
+      if (!BuildOp(raw, op, error)) {
+        error = "line " + std::to_string(line_number) + ": " + error;
+        return false;
+      }
+      if (next < args.size()) {
+        error = "line " + std::to_string(line_number) + ": unexpected '" +
+                args[next] + "'";
+        return false;
+      }
+      ops.push_back(op);
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Минимальный разбор JSON: массив плоских объектов
+ */
+class JsonReader {
+ public:
+  explicit JsonReader(const std::string& text) : text_(text) {}
+
+  bool ReadOps(std::vector<BatchOp>& ops, std::string& error) {
+    if (!Expect_('[')) return Fail_(error, "expected '['");
+    if (Peek_() == ']') {
+      ++pos_;
+      return AtEnd_() || Fail_(error, "trailing data");
+    }
+
+    do {
+      RawOp raw;
+      if (!ReadObject_(raw)) return Fail_(error, "malformed object");
+      BatchOp op;
+      if (!BuildOp(raw, op, error)) {
+        error = "operation " + std::to_string(ops.size() + 1) + ": " + error;
+        return false;
+      }
+      ops.push_back(op);
+    } while (Expect_(','));
+
+    if (!Expect_(']')) return Fail_(error, "expected ',' or ']'");
+    return AtEnd_() || Fail_(error, "trailing data");
+  }
+
+ private:
+  bool ReadObject_(RawOp& raw) {
+    std::map<std::string, std::string*> fields = {{"op", &raw.name},
+                                                  {"axis", &raw.axis},
+                                                  {"value", &raw.value},
+                                                  {"path", &raw.path}};
+    if (!Expect_('{')) return false;
+    if (Expect_('}')) return true;
+
+    do {
+      std::string key;
+      std::string value;
+      if (!ReadString_(key) || !Expect_(':') || !ReadValue_(value)) {
+        return false;
+      }
+      auto it = fields.find(key);
+      if (it != fields.end()) *it->second = value;
+    } while (Expect_(','));
+
+    return Expect_('}');
+  }
+
+  bool ReadValue_(std::string& value) {
+    if (Peek_() == '"') return ReadString_(value);
+
+    const size_t start = pos_;
+    while (pos_ < text_.size() &&
+           (std::isalnum(static_cast<unsigned char>(text_[pos_])) ||
+            text_[pos_] == '-' || text_[pos_] == '+' || text_[pos_] == '.')) {
+      ++pos_;
+    }
+    value = text_.substr(start, pos_ - start);
+    return !value.empty();
+  }
+
+  bool ReadString_(std::string& value) {
+    if (!Expect_('"')) return false;
+    value.clear();
+    while (pos_ < text_.size() && text_[pos_] != '"') {
+      char c = text_[pos_++];
+      if (c == '\\') {
+        if (pos_ >= text_.size()) return false;
+        c = text_[pos_++];
+        if (c == 'n') {
+          c = '\n';
+        } else if (c == 't') {
+          c = '\t';
+        } else if (c != '"' && c != '\\' && c != '/') {
+          return false;
+        }
+      }
+      value += c;
+    }
+    return Expect_('"');
+  }
+
+  char Peek_() {
+    while (pos_ < text_.size() &&
+           std::isspace(static_cast<unsigned char>(text_[pos_]))) {
+      ++pos_;
+    }
+    return pos_ < text_.size() ? text_[pos_] : '\0';
+  }
+
+  bool Expect_(char c) {
+    if (Peek_() != c) return false;
+    ++pos_;
+    return true;
+  }
+
+  bool AtEnd_() { return Peek_() == '\0'; }
+
+  bool Fail_(std::string& error, const std::string& message) {
+    error = "json offset " + std::to_string(pos_) + ": " + message;
+    return false;
+  }
+
+  const std::string& text_;
+  size_t pos_ = 0;
+};
+
+}  // namespace
+
+bool ParseBatchScript(const std::string& text, std::vector<BatchOp>& ops,
+                      std::string& error) {
+  ops.clear();
+  error.clear();
+
+  const size_t first = text.find_first_not_of(" \t\r\n");
+  if (first != std::string::npos && text[first] == '[') {
+    return JsonReader(text).ReadOps(ops, error);
+  }
+  return ParseLines(text, ops, error);
+}
+
+const char* BatchOpName(batch_op_t type) noexcept {
+  return type >= kOpLoad && type <= kOpDeviation ? kOpNames[type]
+                                                 : "unknown";
+}
+
+}  // namespace s21
@@ -0,0 +1,102 @@
+#ifndef CLI_BATCH_SCRIPT_H
+#define CLI_BATCH_SCRIPT_H
+
+/**
+ * @file batch_script.h
+ * @brief Сценарий пакетной обработки моделей
+ */
+
+#include <string>
+#include <vector>
+
+#include "../model/tranformation.h"
+
+namespace s21 {
+
+/**
+ * @brief Операции сценария
+ */
+enum batch_op_t {
+  kOpLoad = 0,    ///< Перезагрузить исходный файл
+  kOpMove = 1,    ///< Перемещение вдоль оси
+  kOpRotate = 2,  ///< Поворот вокруг оси (градусы)
+  kOpScale = 3,   ///< Масштабирование
+  kOpWeld = 4,    ///< Сварка совпадающих вершин
+  kOpStats = 5,   ///< Вывод статистики
+  kOpExport = 6,     ///< Сохранение в OBJ
+  kOpThumbnail = 7,  ///< Миниатюра PNG программным растеризатором
+  kOpVector = 8,     ///< Чертёж SVG или PDF без невидимых линий
+  kOpSection = 9,    ///< Сечение плоскостью axis = value в OBJ
+  kOpTopology = 10,  ///< Вывод связности: оболочки, край, неманифолдность
+  kOpDeviation = 11  ///< Отклонение от эталонной модели (Хаусдорф)
+};
+
+constexpr int kDefaultThumbnailSize = 256;  ///< Сторона миниатюры
+constexpr int kMaxThumbnailSize = 4096;     ///< Наибольшая сторона
+constexpr int kDefaultVectorSize = 1024;    ///< Сторона чертежа
+
+/**
+ * @brief Одна операция сценария
+ */
+struct BatchOp {
+  batch_op_t type = kOpLoad;   ///< Тип операции
+  transformation_t axis = kX;  ///< Ось трансформации
+  double value = 0.0;  ///< Смещение, угол, масштаб, допуск, размер, уровень
+  std::string path;  ///< Шаблон пути для export, thumbnail, ..., deviation
+};
+
+/**
+ * @brief Разбирает сценарий в строчном или JSON формате
+ *
+ * Строчный формат: одна операция на строку или через ';', комментарии
+ * начинаются с '#':
+ * @code
+ * rotate y 30
+ * move x 0.5
+ * scale 2
+ * weld 1e-6
+ * stats
+ * export out/{name}.obj
+ * thumbnail out/{name}.png 256
+ * vector out/{name}.pdf 1024
+ * section z out/{name}_z.obj 0.25
+ * topology
+ * deviation reference/{name}.obj
+ * @endcode
+ *
+ * JSON формат (распознаётся по первому символу '['): массив объектов
+ * с полями op, axis, value, path:
+ * @code
+ * [{"op": "rotate", "axis": "y", "value": 30},
+ *  {"op": "export", "path": "out/{name}.obj"}]
+ * @endcode
+ *
+ * Загрузка файла выполняется перед сценарием всегда; операция load
+ * отменяет все изменения, сделанные до неё. В пути export {name}
+ * заменяется именем входного файла без расширения, так же и в пути
+ * thumbnail, vector и section. Размер миниатюры по умолчанию -
+ * kDefaultThumbnailSize, чертежа - kDefaultVectorSize; формат чертежа
+ * выбирается по расширению (.pdf - PDF, иначе SVG). section сохраняет
+ * контуры сечения плоскостью, перпендикулярной оси, на уровне value
+ * (по умолчанию 0) ломаными OBJ. topology выводит число оболочек,
+ * рёбер края и неманифолдных рёбер текущей сетки. deviation загружает
+ * эталон по пути path (с подстановкой {name}) и выводит расстояния от
+ * вершин текущей сетки до его поверхности и симметричное расстояние
+ * Хаусдорфа.
+ *
+ * @param text Текст сценария
+ * @param ops Выходной список операций
+ * @param error Описание первой ошибки
+ * @return true при успешном разборе
+ */
+bool ParseBatchScript(const std::string& text, std::vector<BatchOp>& ops,
+                      std::string& error);
+
+/**
+ * @brief Возвращает имя операции
+ */
+const char* BatchOpName(batch_op_t type) noexcept;
+
+}  // namespace s21
+
+#endif  // CLI_BATCH_SCRIPT_H
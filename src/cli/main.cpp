@@ -0,0 +1,182 @@
+/**
+ * @file main.cpp
+ * @brief Точка входа 3dviewer-cli: пакетная обработка моделей без окна
+ *
+ * @example
+ * @code
+ * 3dviewer-cli -j 8 -e "weld; rotate y 90; stats; export out/{name}.obj" obj/
+ * 3dviewer-cli --script normalize.json a.obj b.obj
+ * 3dviewer-cli --serve /tmp/3dviewer.sock -j 4
+ * @endcode
+ */
+
+#include <signal.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "batch_runner.h"
+#include "batch_script.h"
+#include "render_service.h"
+
+namespace {
+
+constexpr int kExitFailedFiles = 1;  ///< Часть файлов не обработана
+constexpr int kExitUsage = 2;        ///< Ошибка аргументов или сценария
+
+void PrintUsage(const char* program) {
+  std::printf(
+      "Usage: %s [options] <file.obj|directory>...\n"
+      "  -s, --script FILE  script file (line-based or JSON array)\n"
+      "  -e, --exec TEXT    inline script, operations separated by ';'\n"
+      "  -j, --jobs N       worker threads (default: all cores)\n"
+      "  -q, --quiet        print only the summary line\n"
+      "  --lenient          skip malformed lines instead of failing\n"
+      "  --serve PATH       run the render service on a Unix socket\n"
+      "  --serve-port N     run the render service on 127.0.0.1:N\n"
+      "  --cache-mb N       render service model cache size (256)\n"
+      "  --render-threads N render service threads per request (1)\n"
+      "  -h, --help         show this help\n"
+      "Operations: load, move <x|y|z> <d>, rotate <x|y|z> <deg>,\n"
+      "  scale <k>, weld [tolerance], stats, export <path with {name}>,\n"
+      "  thumbnail <path with {name}> [size],\n"
+      "  vector <path with {name}.svg|.pdf> [size],\n"
+      "  section <x|y|z> <path with {name}.obj> [level], topology,\n"
+      "  deviation <reference path with {name}>\n",
+      program);
+}
+
+/**
+ * @brief Запускает сервис рендера и ждёт SIGINT или SIGTERM
+ */
+int Serve(s21::RenderService::Options options) {
+  // Сигналы блокируются до запуска потоков, чтобы их принял sigwait
+  sigset_t signals;
+  sigemptyset(&signals);
+  sigaddset(&signals, SIGINT);
+  sigaddset(&signals, SIGTERM);
+  pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+  s21::RenderService service(options);
+  std::string error;
+  if (!service.Start(error)) {
+    std::fprintf(stderr, "%s\n", error.c_str());
+    return kExitUsage;
+  }
+  if (options.socket_path.empty()) {
+    std::printf("listening on 127.0.0.1:%d\n", service.GetPort());
+  } else {
+    std::printf("listening on %s\n", options.socket_path.c_str());
+  }
+  std::fflush(stdout);
+
+  int signal_number = 0;
+  sigwait(&signals, &signal_number);
+  service.Stop();
+  std::fputs(service.FormatStats().c_str(), stdout);
+  return 0;
+}
+
+bool ReadFile(const std::string& path, std::string& text) {
+  std::ifstream file(path);
+  if (!file.is_open()) return false;
+  std::ostringstream content;
+  content << file.rdbuf();
+  text = content.str();
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::string script;
+  std::vector<std::string> inputs;
+  unsigned jobs = 0;
+  bool quiet = false;
+  bool lenient = false;
+  bool serve = false;
+  s21::RenderService::Options service_options;
+
+  for (int i = 1; i < argc; ++i) {
+    const char* arg = argv[i];
+    const bool has_value = i + 1 < argc;
+    if (!std::strcmp(arg, "-h") || !std::strcmp(arg, "--help")) {
+      PrintUsage(argv[0]);
+      return 0;
+    } else if (!std::strcmp(arg, "-q") || !std::strcmp(arg, "--quiet")) {
+      quiet = true;
+    } else if (!std::strcmp(arg, "--lenient")) {
+      lenient = true;
+    } else if ((!std::strcmp(arg, "-s") || !std::strcmp(arg, "--script")) &&
+               has_value) {
+      if (!ReadFile(argv[++i], script)) {
+        std::fprintf(stderr, "cannot read script %s\n", argv[i]);
+        return kExitUsage;
+      }
+    } else if ((!std::strcmp(arg, "-e") || !std::strcmp(arg, "--exec")) &&
+               has_value) {
+      script = argv[++i];
+    } else if ((!std::strcmp(arg, "-j") || !std::strcmp(arg, "--jobs")) &&
+               has_value) {
+      jobs = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (!std::strcmp(arg, "--serve") && has_value) {
+      serve = true;
+      service_options.socket_path = argv[++i];
+    } else if (!std::strcmp(arg, "--serve-port") && has_value) {
+      serve = true;
+      service_options.port = std::atoi(argv[++i]);
+    } else if (!std::strcmp(arg, "--cache-mb") && has_value) {
+      service_options.cache_bytes = std::strtoull(argv[++i], nullptr, 10)
+                                    << 20;
+    } else if (!std::strcmp(arg, "--render-threads") && has_value) {
+      service_options.render_threads =
+          static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (arg[0] == '-') {
+      std::fprintf(stderr, "unknown or incomplete option %s\n", arg);
+      PrintUsage(argv[0]);
+      return kExitUsage;
+    } else {
+      inputs.push_back(arg);
+    }
+  }
+
+  if (serve) {
+    service_options.workers = jobs;
+    return Serve(service_options);
+  }
+
+  std::vector<s21::BatchOp> ops;
+  std::string error;
+  if (!s21::ParseBatchScript(script, ops, error)) {
+    std::fprintf(stderr, "script error: %s\n", error.c_str());
+    return kExitUsage;
+  }
+
+  std::vector<std::string> files;
+  if (!s21::BatchRunner::CollectInputFiles(inputs, files, error)) {
+    std::fprintf(stderr, "%s\n", error.c_str());
+    return kExitUsage;
+  }
+  if (files.empty()) {
+    PrintUsage(argv[0]);
+    return kExitUsage;
+  }
+
+  s21::BatchSummary summary;
+  s21::BatchRunner runner(ops);
+  runner.SetLenient(lenient);
+  const auto results = runner.Run(files, jobs, summary);
+
+  std::string report = s21::BatchRunner::FormatReport(results, summary);
+  if (quiet) {
+    report = report.substr(report.rfind('\n', report.size() - 2) + 1);
+  }
+  std::fputs(report.c_str(), stdout);
+
+  return summary.failed == 0 ? 0 : kExitFailedFiles;
+}
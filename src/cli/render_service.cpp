@@ -0,0 +1,389 @@
+/**
+ * @file render_service.cpp
+ * @brief Реализация сервиса рендера
+ */
+
+#include "render_service.h"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+#include "../model/parallel.h"
+#include "../profiling/trace.h"
+
+namespace s21 {
+
+namespace {
+
+constexpr size_t kMaxLineLength = 64 * 1024;  ///< Предел длины команды
+constexpr int kMaxImageSide = 8192;           ///< Предел стороны кадра
+/// Период ожидания рабочего потока (wait_for, как в StallWatchdog)
+constexpr std::chrono::milliseconds kIdlePeriod{200};
+
+bool ParseInt(const std::string& text, int& value) {
+  char* end = nullptr;
+  const long parsed = std::strtol(text.c_str(), &end, 10);
+  if (text.empty() || *end != '\0') return false;
+  value = static_cast<int>(parsed);
+  return true;
+}
+
+bool ParseDouble(const std::string& text, double& value) {
+  char* end = nullptr;
+  value = std::strtod(text.c_str(), &end);
+  return !text.empty() && *end == '\0';
+}
+
+bool ParseColor(const std::string& text, uint32_t& color) {
+  const std::string hex = !text.empty() && text[0] == '#' ? text.substr(1)
+                                                          : text;
+  char* end = nullptr;
+  const unsigned long value = std::strtoul(hex.c_str(), &end, 16);
+  if (hex.size() != 6 || *end != '\0') return false;
+  color = MakeColor(static_cast<uint8_t>(value >> 16),
+                    static_cast<uint8_t>(value >> 8),
+                    static_cast<uint8_t>(value));
+  return true;
+}
+
+bool SendAll(int fd, const char* data, size_t size) {
+  while (size > 0) {
+    const ssize_t sent = send(fd, data, size, MSG_NOSIGNAL);
+    if (sent < 0 && errno == EINTR) continue;
+    if (sent <= 0) return false;
+    data += sent;
+    size -= static_cast<size_t>(sent);
+  }
+  return true;
+}
+
+void SetErrorResponse(std::string& response, const std::string& message) {
+  response = "error " + message + '\n';
+}
+
+}  // namespace
+
+bool ParseRenderRequest(const std::string& line, RenderRequest& request,
+                        std::string& error) {
+  std::istringstream words(line);
+  std::string command;
+  request = RenderRequest();
+  if (!(words >> command) || command != "render" || !(words >> request.path)) {
+    error = "expected: render <path> [key=value ...]";
+    return false;
+  }
+
+  for (std::string word; words >> word;) {
+    const size_t equals = word.find('=');
+    const std::string key = word.substr(0, equals);
+    const std::string value =
+        equals == std::string::npos ? std::string() : word.substr(equals + 1);
+    bool ok = true;
+
+    if (key == "width") {
+      ok = ParseInt(value, request.width);
+    } else if (key == "height") {
+      ok = ParseInt(value, request.height);
+    } else if (key == "rx" || key == "ry" || key == "rz") {
+      ok = ParseDouble(value, request.camera.rotation[key[1] - 'x']);
+    } else if (key == "tx" || key == "ty" || key == "tz") {
+      ok = ParseDouble(value, request.camera.translate[key[1] - 'x']);
+    } else if (key == "scale") {
+      ok = ParseDouble(value, request.camera.scale);
+    } else if (key == "projection") {
+      ok = value == "ortho" || value == "perspective";
+      request.camera.projection = value == "perspective"
+                                      ? kProjectionPerspective
+                                      : kProjectionOrthographic;
+    } else if (key == "style") {
+      ok = value == "lines" || value == "points" || value == "both";
+      request.style.style = value == "points" ? kStylePoints
+                            : value == "both" ? kStyleBoth
+                                              : kStyleLines;
+    } else if (key == "color") {
+      ok = ParseColor(value, request.style.line_color);
+    } else if (key == "points") {
+      ok = ParseColor(value, request.style.point_color);
+    } else if (key == "background") {
+      ok = ParseColor(value, request.style.background);
+    } else if (key == "point_size") {
+      ok = ParseInt(value, request.style.point_size) &&
+           request.style.point_size > 0 && request.style.point_size <= 64;
+    } else if (key == "aa") {
+      ok = value == "0" || value == "1";
+      request.style.antialias = value == "1";
+    } else {
+      error = "unknown key '" + key + "'";
+      return false;
+    }
+
+    if (!ok) {
+      error = "bad value for '" + key + "'";
+      return false;
+    }
+  }
+
+  if (request.width <= 0 || request.height <= 0 ||
+      request.width > kMaxImageSide || request.height > kMaxImageSide) {
+    error = "image size must be 1.." + std::to_string(kMaxImageSide);
+    return false;
+  }
+  return true;
+}
+
+RenderService::RenderService(Options options)
+    : options_(std::move(options)), cache_(options_.cache_bytes) {}
+
+RenderService::~RenderService() { Stop(); }
+
+bool RenderService::Start(std::string& error) {
+  if (listen_fd_ >= 0) return true;
+
+  if (!options_.socket_path.empty()) {
+    sockaddr_un address{};
+    if (options_.socket_path.size() >= sizeof(address.sun_path)) {
+      error = "socket path is too long";
+      return false;
+    }
+    address.sun_family = AF_UNIX;
+    std::strcpy(address.sun_path, options_.socket_path.c_str());
+    unlink(options_.socket_path.c_str());
+
+    listen_fd_ = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listen_fd_ < 0 ||
+        bind(listen_fd_, reinterpret_cast<sockaddr*>(&address),
+             sizeof(address)) != 0) {
+      error = "cannot bind " + options_.socket_path + ": " +
+              std::strerror(errno);
+      Stop();
+      return false;
+    }
+  } else {
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(static_cast<uint16_t>(options_.port));
+
+    listen_fd_ = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    const int reuse = 1;
+    if (listen_fd_ >= 0) {
+      setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    }
+    socklen_t length = sizeof(address);
+    if (listen_fd_ < 0 ||
+        bind(listen_fd_, reinterpret_cast<sockaddr*>(&address),
+             sizeof(address)) != 0 ||
+        getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&address),
+                    &length) != 0) {
+      error = "cannot bind port " + std::to_string(options_.port) + ": " +
+              std::strerror(errno);
+      Stop();
+      return false;
+    }
+    port_ = ntohs(address.sin_port);
+  }
+
+  if (listen(listen_fd_, SOMAXCONN) != 0 || pipe2(wake_pipe_, O_CLOEXEC) != 0) {
+    error = std::string("cannot listen: ") + std::strerror(errno);
+    Stop();
+    return false;
+  }
+
+  stopping_ = false;
+  started_ = std::chrono::steady_clock::now();
+  const unsigned workers =
+      options_.workers > 0 ? options_.workers : DefaultThreadCount();
+  for (unsigned i = 0; i < workers; ++i) {
+    workers_.emplace_back(&RenderService::WorkerLoop_, this);
+  }
+  acceptor_ = std::thread(&RenderService::AcceptLoop_, this);
+  return true;
+}
+
+void RenderService::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    stopping_ = true;
+    // Прерываем блокирующие recv в рабочих потоках
+    for (int client : active_) shutdown(client, SHUT_RDWR);
+  }
+  queue_cv_.notify_all();
+  if (wake_pipe_[1] >= 0) {
+    const char byte = 0;
+    if (write(wake_pipe_[1], &byte, 1) < 0) {
+      // Поток приёма всё равно завершится при закрытии сокета
+    }
+  }
+
+  if (acceptor_.joinable()) acceptor_.join();
+  for (std::thread& worker : workers_) worker.join();
+  workers_.clear();
+
+  for (int client : pending_) close(client);
+  pending_.clear();
+  if (listen_fd_ >= 0 && !options_.socket_path.empty()) {
+    unlink(options_.socket_path.c_str());
+  }
+  for (int* fd : {&listen_fd_, &wake_pipe_[0], &wake_pipe_[1]}) {
+    if (*fd >= 0) close(*fd);
+    *fd = -1;
+  }
+}
+
+void RenderService::AcceptLoop_() {
+  pollfd fds[2] = {{listen_fd_, POLLIN, 0}, {wake_pipe_[0], POLLIN, 0}};
+  for (;;) {
+    if (poll(fds, 2, -1) < 0 && errno != EINTR) break;
+    if (fds[1].revents != 0) break;
+    if ((fds[0].revents & POLLIN) == 0) continue;
+
+    const int client = accept4(listen_fd_, nullptr, nullptr, SOCK_CLOEXEC);
+    if (client < 0) continue;
+    {
+      std::lock_guard<std::mutex> lock(queue_mutex_);
+      pending_.push_back(client);
+    }
+    queue_cv_.notify_one();
+  }
+}
+
+void RenderService::WorkerLoop_() {
+  // Состояние потока живёт всё время работы сервиса
+  Rasterizer rasterizer(std::max(options_.render_threads, 1u));
+  Image image;
+
+  for (;;) {
+    int client = -1;
+    {
+      std::unique_lock<std::mutex> lock(queue_mutex_);
+      while (!stopping_ && pending_.empty()) {
+        queue_cv_.wait_for(lock, kIdlePeriod);
+      }
+      if (stopping_) return;
+      client = pending_.front();
+      pending_.pop_front();
+      active_.insert(client);
+    }
+
+    Serve_(client, rasterizer, image);
+
+    {
+      std::lock_guard<std::mutex> lock(queue_mutex_);
+      active_.erase(client);
+    }
+    close(client);
+  }
+}
+
+void RenderService::Serve_(int client, Rasterizer& rasterizer, Image& image) {
+  std::string buffer;
+  std::string response;
+  char chunk[4096];
+
+  for (;;) {
+    const size_t newline = buffer.find('\n');
+    if (newline == std::string::npos) {
+      if (buffer.size() > kMaxLineLength) return;
+      const ssize_t received = recv(client, chunk, sizeof(chunk), 0);
+      if (received < 0 && errno == EINTR) continue;
+      if (received <= 0) return;
+      buffer.append(chunk, static_cast<size_t>(received));
+      continue;
+    }
+
+    std::string line = buffer.substr(0, newline);
+    buffer.erase(0, newline + 1);
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+    if (line.empty()) continue;
+
+    const bool keep_open = HandleCommand(line, rasterizer, image, response);
+    if (!SendAll(client, response.data(), response.size()) || !keep_open) {
+      return;
+    }
+  }
+}
+
+bool RenderService::HandleCommand(const std::string& line,
+                                  Rasterizer& rasterizer, Image& image,
+                                  std::string& response) {
+  S21_TRACE_SCOPE("RenderService::HandleCommand");
+
+  if (line == "quit") {
+    response.clear();
+    return false;
+  }
+  if (line == "stats") {
+    const std::string text = FormatStats();
+    response = "ok " + std::to_string(text.size()) + '\n' + text;
+    return true;
+  }
+
+  RenderRequest request;
+  std::string error;
+  if (!ParseRenderRequest(line, request, error)) {
+    ++errors_;
+    SetErrorResponse(response, error);
+    return true;
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  int load_error = kNoError;
+  const std::shared_ptr<const RenderMesh> mesh =
+      cache_.Get(request.path, load_error);
+  if (!mesh) {
+    ++errors_;
+    SetErrorResponse(response, load_error == kFileWrongExtension
+                                   ? "wrong extension, expected .obj"
+                               : load_error == kFailedToOpen
+                                   ? "failed to open " + request.path
+                                   : "incorrect data in " + request.path);
+    return true;
+  }
+
+  rasterizer.Render(*mesh, request.camera, request.style, request.width,
+                    request.height, image);
+  const std::string png = EncodePng(image);
+  response = "ok " + std::to_string(png.size()) + '\n';
+  response += png;
+
+  ++renders_;
+  render_us_ += std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - start)
+                    .count();
+  return true;
+}
+
+std::string RenderService::FormatStats() const {
+  const ModelCache::Stats cache = cache_.GetStats();
+  const double uptime_s = std::chrono::duration<double>(
+                              std::chrono::steady_clock::now() - started_)
+                              .count();
+  const size_t renders = renders_.load();
+
+  char text[512];
+  std::snprintf(text, sizeof(text),
+                "renders %zu\nerrors %zu\nrender_ms_avg %.3f\n"
+                "renders_per_s %.2f\ncache_hits %zu\ncache_misses %zu\n"
+                "cache_evictions %zu\ncache_entries %zu\ncache_mb %.2f\n"
+                "uptime_s %.1f\n",
+                renders, errors_.load(),
+                renders ? render_us_.load() / 1000.0 / renders : 0.0,
+                uptime_s > 0.0 ? renders / uptime_s : 0.0, cache.hits,
+                cache.misses, cache.evictions, cache.entries,
+                cache.bytes / 1048576.0, uptime_s);
+  return text;
+}
+
+}  // namespace s21
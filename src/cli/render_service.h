@@ -0,0 +1,175 @@
+#ifndef CLI_RENDER_SERVICE_H
+#define CLI_RENDER_SERVICE_H
+
+/**
+ * @file render_service.h
+ * @brief Локальный сервис рендера моделей в PNG
+ */
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../render/model_cache.h"
+#include "../render/rasterizer.h"
+
+namespace s21 {
+
+/**
+ * @brief Запрос на рендер
+ */
+struct RenderRequest {
+  std::string path;   ///< OBJ файл
+  Camera camera;      ///< Камера
+  RenderStyle style;  ///< Оформление
+  int width = 512;    ///< Ширина кадра
+  int height = 512;   ///< Высота кадра
+};
+
+/**
+ * @brief Разбирает строку запроса render
+ *
+ * Формат: "render <path> [ключ=значение ...]". Ключи: width, height,
+ * rx, ry, rz (градусы), tx, ty, tz, scale, projection (ortho |
+ * perspective), style (lines | points | both), color, points,
+ * background (RRGGBB), point_size, aa (0 | 1 - сглаживание рёбер).
+ *
+ * @param line Строка без перевода строки
+ * @param request Выходной запрос
+ * @param error Описание ошибки
+ * @return true при успешном разборе
+ */
+bool ParseRenderRequest(const std::string& line, RenderRequest& request,
+                        std::string& error);
+
+/**
+ * @brief Сервис рендера на Unix-сокете или localhost TCP-порту
+ *
+ * Протокол строковый, одна команда на строку:
+ * - "render <path> [ключ=значение ...]" - ответ "ok <N>\n" и N байт PNG
+ * - "stats" - ответ "ok <N>\n" и N байт текста со счётчиками
+ * - "quit" - закрыть соединение
+ * Ошибка - строка "error <описание>\n".
+ *
+ * Соединения обслуживает пул рабочих потоков; у каждого свой
+ * растеризатор и буфер кадра (аналог пула контекстов OpenGL). Разобранные
+ * модели и их буферы рендера хранятся в общем ModelCache между
+ * запросами. Соединений сверх числа потоков ждут в очереди.
+ *
+ * @example
+ * @code
+ * RenderService::Options options;
+ * options.socket_path = "/tmp/3dviewer.sock";
+ * RenderService service(options);
+ * std::string error;
+ * if (service.Start(error)) {
+ *   // ... до сигнала остановки
+ *   service.Stop();
+ * }
+ * @endcode
+ */
+class RenderService {
+ public:
+  /**
+   * @brief Параметры сервиса
+   */
+  struct Options {
+    std::string socket_path;  ///< Unix-сокет (если пусто - TCP)
+    int port = 0;             ///< TCP-порт на 127.0.0.1 (0 - любой)
+    unsigned workers = 0;     ///< Рабочих потоков (0 - по числу ядер)
+    size_t cache_bytes = size_t{256} << 20;  ///< Ёмкость кэша моделей
+    unsigned render_threads = 1;  ///< Потоков растеризации на запрос
+  };
+
+  /**
+   * @brief Создаёт сервис (сокет открывается в Start)
+   */
+  explicit RenderService(Options options);
+
+  /**
+   * @brief Останавливает сервис
+   */
+  ~RenderService();
+
+  RenderService(const RenderService&) = delete;
+  RenderService& operator=(const RenderService&) = delete;
+
+  /**
+   * @brief Открывает сокет и запускает потоки
+   * @param error Описание ошибки
+   * @return false если сокет не открыт
+   */
+  bool Start(std::string& error);
+
+  /**
+   * @brief Закрывает сокет и соединения, дожидается потоков
+   */
+  void Stop();
+
+  /**
+   * @brief Возвращает фактический TCP-порт (после Start)
+   */
+  int GetPort() const noexcept { return port_; }
+
+  /**
+   * @brief Выполняет одну команду и формирует ответ
+   *
+   * @param line Строка команды
+   * @param rasterizer Растеризатор вызывающего потока
+   * @param image Буфер кадра вызывающего потока
+   * @param response Выходной ответ (перезаписывается)
+   * @return false если соединение нужно закрыть
+   */
+  bool HandleCommand(const std::string& line, Rasterizer& rasterizer,
+                     Image& image, std::string& response);
+
+  /**
+   * @brief Возвращает счётчики в текстовом виде
+   */
+  std::string FormatStats() const;
+
+ private:
+  /**
+   * @brief Цикл приёма соединений
+   */
+  void AcceptLoop_();
+
+  /**
+   * @brief Цикл рабочего потока
+   */
+  void WorkerLoop_();
+
+  /**
+   * @brief Обслуживает соединение до закрытия
+   */
+  void Serve_(int client, Rasterizer& rasterizer, Image& image);
+
+  Options options_;    ///< Параметры
+  ModelCache cache_;   ///< Кэш моделей
+  int listen_fd_ = -1;  ///< Слушающий сокет
+  int wake_pipe_[2] = {-1, -1};  ///< Пробуждение цикла приёма
+  int port_ = 0;       ///< Фактический TCP-порт
+
+  std::thread acceptor_;               ///< Поток приёма
+  std::vector<std::thread> workers_;   ///< Рабочие потоки
+  std::mutex queue_mutex_;             ///< Защищает очередь и клиентов
+  std::condition_variable queue_cv_;   ///< Новое соединение или останов
+  std::deque<int> pending_;            ///< Ожидающие соединения
+  std::set<int> active_;               ///< Обслуживаемые соединения
+  bool stopping_ = false;              ///< Идёт остановка
+
+  std::atomic<size_t> renders_{0};       ///< Выполнено рендеров
+  std::atomic<size_t> errors_{0};        ///< Ответов с ошибкой
+  std::atomic<int64_t> render_us_{0};    ///< Суммарное время рендера
+  std::chrono::steady_clock::time_point started_;  ///< Время запуска
+};
+
+}  // namespace s21
+
+#endif  // CLI_RENDER_SERVICE_H
@@ -6,6 +6,12 @@
 #include "controller.h"
 
 #include <QFileInfo>
+#include <chrono>
+#include <utility>
+
+#include "../profiling/latency.h"
+#include "../profiling/startup_profiler.h"
+#include "../profiling/trace.h"
 
 namespace s21 {
 
@@ -13,10 +19,55 @@ Controller::Controller(QObject* parent)
     : QObject(parent), model_(&Model::GetInstance()) {}
 
 void Controller::LoadModel(const QString& file_path) {
-  std::string std_file_path = file_path.toStdString();
+  S21_TRACE_SCOPE("Controller::LoadModel");
+
+  FinishPreload();
+  ParseModel_(file_path.toStdString());
+  EmitLoadResult_(file_path);
+}
+
+void Controller::PreloadModel(const QString& file_path, LoadCallback done) {
+  FinishPreload();
+  preload_path_ = file_path;
+  preload_done_ = std::move(done);
+  preload_ = std::async(std::launch::async,
+                        [this, path = file_path.toStdString()]() {
+                          S21_TRACE_SCOPE("Controller::PreloadModel");
+                          ParseModel_(path);
+                          StartupProfiler::GetInstance().Mark("preload parsed");
+                          // Результат отдаётся в GUI-поток, как только готов
+                          QMetaObject::invokeMethod(
+                              this, [this]() { FinishPreload(); },
+                              Qt::QueuedConnection);
+                        });
+}
+
+void Controller::FinishPreload() {
+  if (!preload_.valid()) {
+    return;
+  }
+
+  preload_.get();
+  StartupProfiler::GetInstance().Mark("preload delivered");
+  // Обработчик может начать следующую загрузку
+  LoadCallback done = std::move(preload_done_);
+  preload_done_ = nullptr;
+  EmitLoadResult_(preload_path_);
+  if (done) {
+    const int error_code = model_->GetError();
+    done(error_code != 0 ? GetErrorMessage_(error_code) : QString());
+  }
+}
 
-  model_->SetFileName(std_file_path);
+void Controller::ParseModel_(const std::string& file_path) {
+  auto start = std::chrono::steady_clock::now();
+  model_->SetFileName(file_path);
   model_->Parser();
+  timings_.load_ms = ElapsedMs_(start);
+}
+
+void Controller::EmitLoadResult_(const QString& file_path) {
+  emit OperationTimed(timings_.load_ms, timings_.transform_ms);
 
   int error_code = model_->GetError();
   if (error_code != 0) {
@@ -27,22 +78,53 @@ void Controller::LoadModel(const QString& file_path) {
 }
 
 void Controller::TransformModel(int strategy_type, double value, int axis) {
+  FinishPreload();
   transformation_t transform_axis = static_cast<transformation_t>(axis);
+
+  auto start = std::chrono::steady_clock::now();
   model_->Transform(strategy_type, value, transform_axis);
+  timings_.transform_ms = ElapsedMs_(start);
+  LatencyTracker::GetInstance().MarkStage(kStageTransformed);
+  emit OperationTimed(timings_.load_ms, timings_.transform_ms);
 
   const auto& vertex_index = model_->GetVertexIndex();
   const auto& vertex_coord = model_->GetVertexCoord();
   emit ModelTransformed(vertex_index, vertex_coord);
 }
 
+double Controller::ElapsedMs_(
+    std::chrono::steady_clock::time_point start) noexcept {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
 QString Controller::GetErrorMessage_(int error_code) const {
+  const ObjParseError& error = model_->GetParseError();
+  QString place;
+  if (error.line > 0) {
+    place = QString(" (строка %1, столбец %2)")
+                .arg(error.line)
+                .arg(error.column);
+  }
   switch (error_code) {
     case kFileWrongExtension:
       return "Неверное расширение файла. Ожидается .obj";
     case kFailedToOpen:
       return "Не удалось открыть файл";
     case kIncorrectData:
-      return "Некорректные данные в файле";
+      if (error.token.empty()) {
+        return "Не хватает координаты вершины" + place;
+      }
+      return QString("Некорректные данные в файле: \"%1\"%2")
+          .arg(QString::fromStdString(error.token), place);
+    case kIndexOutOfRange:
+      return QString("%1 %2 ссылается на вершину %3, а вершин %4%5")
+          .arg(error.element == 'l' ? "Ломаная" : "Грань")
+          .arg(error.face + 1)
+          .arg(error.index)
+          .arg(error.vertex_count)
+          .arg(place);
     default:
       return "Неизвестная ошибка";
   }
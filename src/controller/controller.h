@@ -8,9 +8,13 @@
 
 #include <QObject>
 #include <QString>
+#include <chrono>
+#include <functional>
+#include <future>
 #include <vector>
 
 #include "../model/model.h"
+#include "../profiling/frame_stats.h"
 
 namespace s21 {
 
@@ -69,6 +73,11 @@ class Controller : public QObject {
    */
   ~Controller() = default;
 
+  /**
+   * @brief Возвращает длительности последних операций
+   */
+  const OperationTimings& GetTimings() const noexcept { return timings_; }
+
   /**
    * @brief Загружает 3D модель из файла
    *
@@ -89,6 +98,38 @@ class Controller : public QObject {
    */
   void LoadModel(const QString& file_path);
 
+  /**
+   * @brief Результат фоновой загрузки
+   * @param error Описание ошибки, пустое при успехе
+   */
+  using LoadCallback = std::function<void(const QString& error)>;
+
+  /**
+   * @brief Начинает загрузку модели в фоновом потоке
+   *
+   * Используется при запуске с файлом в командной строке (разбор OBJ идёт
+   * параллельно с построением интерфейса) и командой load канала
+   * управления. Сигналы о результате испускаются из FinishPreload(),
+   * который сам ставится в очередь GUI-потока по окончании разбора.
+   * Незавершённая предыдущая загрузка сначала доводится до конца.
+   *
+   * @param file_path Путь к OBJ файлу для загрузки
+   * @param done Вызывается в GUI-потоке после сигналов именно этой
+   *        загрузки (необязателен)
+   *
+   * @warning До FinishPreload() модель принадлежит фоновому потоку:
+   *          LoadModel() и TransformModel() сначала дожидаются загрузки
+   */
+  void PreloadModel(const QString& file_path, LoadCallback done = nullptr);
+
+  /**
+   * @brief Дожидается фоновой загрузки и сообщает её результат
+   *
+   * @emit ModelLoaded или ModelLoadError, если загрузка была запущена
+   * @post Вызван обработчик done из PreloadModel()
+   */
+  void FinishPreload();
+
   /**
    * @brief Выполняет трансформацию загруженной модели
    *
@@ -165,6 +206,17 @@ class Controller : public QObject {
   void ModelTransformed(const std::vector<int>& vertex_index,
                         const std::vector<double>& vertex_coord);
 
+  /**
+   * @brief Сигнал с длительностями последних операций
+   *
+   * Испускается после каждой загрузки и трансформации, до сигналов
+   * ModelLoaded/ModelTransformed. Используется оверлеем производительности.
+   *
+   * @param load_ms Длительность последней загрузки модели, мс
+   * @param transform_ms Длительность последней трансформации, мс
+   */
+  void OperationTimed(double load_ms, double transform_ms);
+
  private:
   /**
    * @brief Преобразует код ошибки в пользовательское сообщение
@@ -197,7 +249,29 @@ class Controller : public QObject {
    */
   void EmitModelData_(const QString& filename);
 
+  /**
+   * @brief Загружает модель и замеряет длительность загрузки
+   * @note Не испускает сигналов, может выполняться вне GUI-потока
+   */
+  void ParseModel_(const std::string& file_path);
+
+  /**
+   * @brief Испускает сигналы о результате последней загрузки
+   * @param file_path Путь к загруженному файлу
+   */
+  void EmitLoadResult_(const QString& file_path);
+
+  /**
+   * @brief Возвращает время в миллисекундах, прошедшее с момента start
+   */
+  static double ElapsedMs_(
+      std::chrono::steady_clock::time_point start) noexcept;
+
   Model* model_;  ///< Указатель на единственный экземпляр модели (Singleton)
+  OperationTimings timings_;  ///< Длительности последних операций
+  std::future<void> preload_;  ///< Фоновая загрузка из командной строки
+  QString preload_path_;       ///< Файл фоновой загрузки
+  LoadCallback preload_done_;  ///< Обработчик результата фоновой загрузки
 };
 
 }  // namespace s21
@@ -28,9 +28,76 @@
  */
 
 #include <QApplication>
+#include <QCommandLineParser>
+#include <QTimer>
+#include <cstdio>
+#include <cstring>
 
 #include "controller/controller.h"
+#include "profiling/input_recorder.h"
+#include "profiling/latency.h"
+#include "profiling/soak.h"
+#include "profiling/stall_watchdog.h"
+#include "profiling/startup_profiler.h"
+#include "profiling/trace.h"
+#include "view/automation_server.h"
 #include "view/gui.h"
+#include "view/soak_runner.h"
+
+namespace {
+
+/**
+ * @brief Проверяет CSV телеметрии без запуска GUI
+ *
+ * @code{.sh}
+ * ./3DViewer --check-telemetry soak.csv
+ * @endcode
+ *
+ * @return 0 - дрейфа нет, 1 - файл не прочитан, 2 - обнаружен дрейф
+ */
+int CheckTelemetry(const char* path) {
+  std::vector<s21::TelemetrySample> samples;
+  if (!s21::ReadTelemetryCsv(path, samples)) {
+    std::fprintf(stderr, "cannot read telemetry: %s\n", path);
+    return 1;
+  }
+  const s21::DriftReport report = s21::CheckDrift(samples);
+  std::fputs(report.Summary().c_str(), stdout);
+  return report.HasDrift() ? 2 : 0;
+}
+
+/**
+ * @brief Собирает сценарий soak-прогона из моделей и записей ввода
+ *
+ * Записи ввода добавляются после встроенного сценария моделей со
+ * сдвигом времени, чтобы события шли по порядку.
+ */
+std::vector<s21::RecordedEvent> BuildSoakScenario(const QStringList& models,
+                                                  const QStringList& scripts) {
+  std::vector<std::string> model_paths;
+  for (const QString& model : models) {
+    model_paths.push_back(model.toStdString());
+  }
+  std::vector<s21::RecordedEvent> scenario = s21::BuildSoakScript(model_paths);
+
+  for (const QString& script : scripts) {
+    std::vector<s21::RecordedEvent> events;
+    if (!s21::InputRecorder::LoadEvents(script.toStdString(), events)) {
+      std::fprintf(stderr, "cannot read input recording: %s\n",
+                   qPrintable(script));
+      continue;
+    }
+    const uint64_t offset =
+        scenario.empty() ? 0 : scenario.back().time_us + s21::kSoakStepUs;
+    for (s21::RecordedEvent& event : events) {
+      event.time_us += offset;
+      scenario.push_back(std::move(event));
+    }
+  }
+  return scenario;
+}
+
+}  // namespace
 
 /**
  * @brief Главная функция приложения 3D Viewer v2.0
@@ -72,24 +139,118 @@
  * Запуск приложения из командной строки:
  * @code{.sh}
  * ./3DViewer                    # Запуск без аргументов
- * ./3DViewer model.obj          # Запуск с файлом (не реализовано)
+ * ./3DViewer model.obj          # Запуск с файлом (загрузка параллельно UI)
+ * ./3DViewer --startup-report --exit-after-first-frame  # Время запуска
+ * ./3DViewer --record s.s21rec  # Запись сессии ввода
+ * ./3DViewer --replay s.s21rec --replay-speed max  # Воспроизведение
+ * QT_QPA_PLATFORM=offscreen ./3DViewer --soak 240 --soak-model cube.obj
+ * ./3DViewer --check-telemetry soak.csv  # Проверка дрейфа
+ * ./3DViewer --automation /tmp/3dviewer.sock  # Управление из скриптов
+ * ./3DViewer --renderer cpu model.obj  # Программный растеризатор
  * @endcode
  *
  * @see QApplication::exec()
  * @see s21::View::show()
  */
 int main(int argc, char *argv[]) {
-  // Принудительное использование X11 платформы для совместимости
-  qputenv("QT_QPA_PLATFORM", "xcb");
+  s21::StartupProfiler& startup = s21::StartupProfiler::GetInstance();
+  startup.Mark("main");
+
+  if (argc == 3 && std::strcmp(argv[1], "--check-telemetry") == 0) {
+    return CheckTelemetry(argv[2]);
+  }
+
+  // X11 по умолчанию для совместимости; явно заданная платформа
+  // (например, offscreen для soak-прогонов) сохраняется
+  if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+    qputenv("QT_QPA_PLATFORM", "xcb");
+  }
 
   // Инициализация Qt приложения
   QApplication a(argc, argv);
+  startup.Mark("QApplication");
+
+  // Запись и воспроизведение ввода для повторяемых замеров
+  QCommandLineParser parser;
+  parser.addHelpOption();
+  const QCommandLineOption record_option(
+      "record", "Записать сессию ввода в <file>.", "file");
+  const QCommandLineOption replay_option(
+      "replay", "Воспроизвести сессию ввода из <file> и выйти.", "file");
+  const QCommandLineOption speed_option(
+      "replay-speed", "Скорость воспроизведения: original или max.", "speed",
+      "original");
+  // Длительный прогон: сценарий по кругу, телеметрия в CSV
+  const QCommandLineOption soak_option(
+      "soak", "Soak-прогон длительностью <minutes> минут.", "minutes");
+  const QCommandLineOption soak_model_option(
+      "soak-model", "Модель для встроенного сценария (можно повторять).",
+      "file");
+  const QCommandLineOption soak_script_option(
+      "soak-script", "Запись ввода для сценария (можно повторять).", "file");
+  const QCommandLineOption telemetry_option(
+      "telemetry", "CSV телеметрии soak-прогона.", "file", "soak.csv");
+  parser.addOption(record_option);
+  parser.addOption(replay_option);
+  parser.addOption(speed_option);
+  parser.addOption(soak_option);
+  parser.addOption(soak_model_option);
+  parser.addOption(soak_script_option);
+  // Время запуска: отчёт по этапам печатается после первого кадра
+  const QCommandLineOption startup_report_option(
+      "startup-report", "Напечатать разбивку времени запуска.");
+  const QCommandLineOption exit_option(
+      "exit-after-first-frame", "Выйти после первого кадра (замер запуска).");
+  // Канал автоматизации: команды скриптов через локальный сокет
+  const QCommandLineOption automation_option(
+      "automation", "Принимать команды автоматизации на сокете <name>.",
+      "name");
+  // Программный растеризатор вместо драйвера OpenGL
+  const QCommandLineOption renderer_option(
+      "renderer", "Чем рисовать модель: gl или cpu.", "name", "gl");
+  parser.addOption(telemetry_option);
+  parser.addOption(automation_option);
+  parser.addOption(renderer_option);
+  parser.addOption(startup_report_option);
+  parser.addOption(exit_option);
+  parser.addPositionalArgument("file", "OBJ файл для загрузки.", "[file]");
+  parser.process(a);
+
+  // Контроллер создаётся до интерфейса: файл из командной строки
+  // разбирается в фоне, пока строится окно
+  s21::Controller controller;
+  if (!parser.positionalArguments().isEmpty()) {
+    controller.PreloadModel(parser.positionalArguments().constFirst());
+  }
+
+  // Трассировка интервалов: S21_TRACE_FILE=trace.json ./3DViewer
+  // Трасса пишется при выходе и открывается в ui.perfetto.dev
+  const QByteArray trace_file = qgetenv("S21_TRACE_FILE");
+  if (!trace_file.isEmpty()) {
+    s21::Tracer::GetInstance().SetEnabled(true);
+    QObject::connect(&a, &QApplication::aboutToQuit, [&trace_file]() {
+      s21::Tracer::GetInstance().WriteChromeTrace(trace_file.toStdString());
+    });
+  }
 
   // Создание компонентов MVC архитектуры
   s21::View view;
   view.setWindowTitle("3D Viewer 2.0");
+  if (parser.value(renderer_option) == "cpu") {
+    view.SetRenderBackend(s21::kBackendCpu);
+  } else if (parser.value(renderer_option) != "gl") {
+    std::fprintf(stderr, "unknown renderer: %s\n",
+                 qPrintable(parser.value(renderer_option)));
+    return 1;
+  }
 
-  s21::Controller controller;
+  // Отчёт о задержке ввода: S21_LATENCY_REPORT=1 ./3DViewer
+  // Гистограммы по источникам ввода печатаются в stderr при выходе
+  if (!qEnvironmentVariableIsEmpty("S21_LATENCY_REPORT")) {
+    QObject::connect(&a, &QApplication::aboutToQuit, []() {
+      std::fputs(s21::LatencyTracker::GetInstance().Report().c_str(), stderr);
+    });
+  }
 
   /**
    * @brief Установка соединений Controller → View
@@ -112,6 +273,11 @@ int main(int argc, char *argv[]) {
   QObject::connect(&controller, &s21::Controller::ModelTransformed, &view,
                    &s21::View::HandleModelTransformed_);
 
+  // Замеры операций для HUD: Controller::OperationTimed →
+  // View::HandleOperationTimed_
+  QObject::connect(&controller, &s21::Controller::OperationTimed, &view,
+                   &s21::View::HandleOperationTimed_);
+
   /**
    * @brief Установка соединений View → Controller
    *
@@ -128,6 +294,127 @@ int main(int argc, char *argv[]) {
 
   // Отображение главного окна приложения
   view.show();
+  startup.Mark("View::show");
+
+  s21::SoakRunner soak(&view);
+
+  s21::AutomationServer automation(&controller, &view);
+  if (parser.isSet(automation_option)) {
+    QObject::connect(&view, &s21::View::FrameRendered, &automation,
+                     &s21::AutomationServer::HandleFrameRendered);
+    QString error;
+    if (!automation.Listen(parser.value(automation_option), error)) {
+      std::fprintf(stderr, "automation: %s\n", qPrintable(error));
+      return 1;
+    }
+    std::fprintf(stderr, "automation: listening on %s\n",
+                 qPrintable(automation.GetServerPath()));
+  }
+
+  // Сессия записывается с момента показа окна и сохраняется при выходе.
+  // Воспроизведение завершает приложение, чтобы трасса (S21_TRACE_FILE)
+  // и отчёт о задержке были сняты ровно с воспроизведённой сессии
+  if (parser.isSet(replay_option)) {
+    const QString replay_file = parser.value(replay_option);
+    const bool max_speed = parser.value(speed_option) == "max";
+    QObject::connect(&view, &s21::View::ReplayFinished,
+                     [](int event_count, double elapsed_ms) {
+                       std::fprintf(stderr, "replayed %d events in %.1f ms\n",
+                                    event_count, elapsed_ms);
+                       QApplication::quit();
+                     });
+    QTimer::singleShot(0, &view, [&view, replay_file, max_speed]() {
+      if (!view.StartReplay(replay_file, max_speed)) {
+        std::fprintf(stderr, "cannot read input recording: %s\n",
+                     qPrintable(replay_file));
+        QApplication::exit(1);
+      }
+    });
+  } else if (parser.isSet(soak_option)) {
+    // Прогон завершает приложение с кодом 2, если обнаружен дрейф
+    soak.SetCacheSizeFunction([]() {
+      const s21::Model& model = s21::Model::GetInstance();
+      const size_t bytes =
+          model.GetVertexCoord().capacity() * sizeof(double) +
+          model.GetVertexIndex().capacity() * sizeof(int);
+      return static_cast<int64_t>(bytes / 1024);
+    });
+    QObject::connect(&view, &s21::View::FrameRendered, &soak,
+                     &s21::SoakRunner::RecordFrame);
+    QObject::connect(&controller, &s21::Controller::ModelLoaded,
+                     [&soak, &controller]() {
+                       soak.RecordOperation(s21::kTelemetryLoad,
+                                            controller.GetTimings().load_ms);
+                     });
+    QObject::connect(
+        &controller, &s21::Controller::ModelTransformed,
+        [&soak, &controller]() {
+          soak.RecordOperation(s21::kTelemetryTransform,
+                               controller.GetTimings().transform_ms);
+        });
+    QObject::connect(&soak, &s21::SoakRunner::Finished,
+                     [](const s21::DriftReport& report) {
+                       std::fputs(report.Summary().c_str(), stderr);
+                       QApplication::exit(report.HasDrift() ? 2 : 0);
+                     });
+
+    const qint64 duration_ms = parser.value(soak_option).toLongLong() * 60000;
+    if (!soak.Start(parser.value(telemetry_option),
+                    BuildSoakScenario(parser.values(soak_model_option),
+                                      parser.values(soak_script_option)),
+                    duration_ms)) {
+      std::fprintf(stderr, "soak: empty scenario or cannot open %s\n",
+                   qPrintable(parser.value(telemetry_option)));
+      return 1;
+    }
+  } else if (parser.isSet(record_option)) {
+    const QString record_file = parser.value(record_option);
+    s21::InputRecorder::GetInstance().Start();
+    QObject::connect(&a, &QApplication::aboutToQuit, [record_file]() {
+      s21::InputRecorder& recorder = s21::InputRecorder::GetInstance();
+      recorder.Stop();
+      if (!recorder.Save(record_file.toStdString())) {
+        std::fprintf(stderr, "cannot write input recording: %s\n",
+                     qPrintable(record_file));
+      }
+    });
+  }
+
+  // Сторож зависаний GUI-потока: порог задаётся S21_STALL_THRESHOLD_MS
+  // (по умолчанию 100 мс), сводка печатается в stderr при выходе
+  bool threshold_ok = false;
+  int threshold_ms = qEnvironmentVariableIntValue("S21_STALL_THRESHOLD_MS",
+                                                  &threshold_ok);
+  s21::StallWatchdog watchdog(
+      std::chrono::milliseconds(threshold_ok && threshold_ms > 0 ? threshold_ms
+                                                                : 100));
+  watchdog.SetPingFunction([&watchdog, &a]() {
+    QMetaObject::invokeMethod(
+        &a, [&watchdog]() { watchdog.Heartbeat(); }, Qt::QueuedConnection);
+  });
+  QObject::connect(&a, &QApplication::aboutToQuit, [&watchdog]() {
+    watchdog.Stop();
+    if (watchdog.GetStallCount() > 0) {
+      std::fputs(watchdog.Report().c_str(), stderr);
+    }
+  });
+
+  // Необязательная инициализация откладывается до первого кадра:
+  // сторожевой поток не конкурирует с построением окна
+  QObject::connect(
+      &view, &s21::View::FrameRendered, &view,
+      [&watchdog, &startup, &parser, &startup_report_option, &exit_option]() {
+        watchdog.Start();
+        startup.Mark("deferred init");
+        if (parser.isSet(startup_report_option)) {
+          std::fputs(startup.Report().c_str(), stderr);
+        }
+        if (parser.isSet(exit_option)) {
+          QApplication::quit();
+        }
+      },
+      static_cast<Qt::ConnectionType>(Qt::QueuedConnection |
+                                      Qt::SingleShotConnection));
 
   // Запуск главного цикла обработки событий Qt
   return QApplication::exec();
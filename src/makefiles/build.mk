@@ -1,3 +1,8 @@
 _build:
 	@echo "🔧 Сборка 3DViewer..."
 	mkdir -p ../build && cd ../build && qmake6 ../src/view/3DViewer.pro && make
+
+_build_cli:
+	@echo "🔧 Сборка 3dviewer-cli..."
+	mkdir -p ../build/cli && cd ../build/cli && \
+		qmake6 ../../src/cli/3dviewer-cli.pro CONFIG+=release && make
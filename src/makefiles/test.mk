@@ -9,3 +9,45 @@ _start_test:
 _start_test_coverage:
 	cd tests/build && \
 	make coverage
+
+_start_bench:
+	cd tests/ && \
+	mkdir -p build && \
+	cd build && \
+	cmake .. -DCMAKE_BUILD_TYPE=Release && \
+	make run_benchmarks && \
+	./run_benchmarks $(FILTER)
+
+RUNS ?= 10
+
+_start_bench_startup:
+	python3 tests/scripts/cold_start.py ../build/3DViewer --runs $(RUNS) \
+		--history tests/cold_start_history.csv $(MODEL)
+
+CLIENTS ?= 4
+SECONDS ?= 10
+RENDER_MODEL ?= $(firstword $(wildcard obj/*.obj))
+
+_start_bench_render:
+	python3 tests/scripts/render_service_bench.py ../build/cli/3dviewer-cli \
+		$(or $(MODEL),$(RENDER_MODEL)) --clients $(CLIENTS) \
+		--seconds $(SECONDS)
+
+_start_bench_automation:
+	python3 tests/scripts/automation_latency.py ../build/3DViewer \
+		$(or $(MODEL),$(RENDER_MODEL))
+
+COUNT ?= 100
+
+_start_bench_renderer:
+	python3 tests/scripts/renderer_compare.py ../build/3DViewer \
+		$(or $(MODEL),$(RENDER_MODEL)) --count $(COUNT)
+
+MINUTES ?= 60
+SOAK_MODELS ?= $(wildcard obj/*.obj)
+
+_start_soak:
+	cd ../build && \
+	QT_QPA_PLATFORM=offscreen ./3DViewer --soak $(MINUTES) \
+		$(foreach model,$(abspath $(SOAK_MODELS)),--soak-model $(model)) \
+		--telemetry soak.csv
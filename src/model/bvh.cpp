@@ -0,0 +1,198 @@
+/**
+ * @file bvh.cpp
+ * @brief Построение иерархии ограничивающих box
+ */
+
+#include "bvh.h"
+
+#include "../profiling/trace.h"
+#include "parallel.h"
+
+namespace s21 {
+
+namespace {
+
+constexpr size_t kPrimitivesPerChunk = size_t{1} << 16;  ///< На задачу
+constexpr size_t kNodesPerChunk = size_t{1} << 12;  ///< Узлов на задачу
+constexpr size_t kSortChunksPerThread = 4;  ///< Блоков сортировки на поток
+constexpr int kMortonBits = 10;             ///< Бит на ось ключа Мортона
+
+/**
+ * @brief Раздвигает 10 младших бит так, что между ними по два нуля
+ */
+inline uint32_t SpreadBits(uint32_t value) {
+  value = (value * 0x00010001u) & 0xFF0000FFu;
+  value = (value * 0x00000101u) & 0x0F00F00Fu;
+  value = (value * 0x00000011u) & 0xC30C30C3u;
+  value = (value * 0x00000005u) & 0x49249249u;
+  return value;
+}
+
+/**
+ * @brief Устойчивая поразрядная сортировка по старшим 32 битам ключа
+ *
+ * Ключи делятся на блоки; на каждый байт строится гистограмма блока,
+ * префиксные суммы дают каждому блоку собственные позиции, и блоки
+ * раскладываются параллельно. Порядок не зависит от числа блоков.
+ */
+void SortKeys(std::vector<uint64_t>& keys, unsigned threads) {
+  const size_t count = keys.size();
+  const size_t chunks = std::max<size_t>(
+      1, std::min<size_t>(size_t{threads} * kSortChunksPerThread,
+                          count / kPrimitivesPerChunk));
+  const size_t step = (count + chunks - 1) / chunks;
+  std::vector<uint64_t> buffer(count);
+  std::vector<std::array<size_t, 256>> offsets(chunks);
+  for (int shift = 32; shift < 64; shift += 8) {
+    ParallelFor(chunks, threads, [&](unsigned, size_t chunk) {
+      std::array<size_t, 256>& histogram = offsets[chunk];
+      histogram.fill(0);
+      const size_t end = std::min(count, (chunk + 1) * step);
+      for (size_t i = chunk * step; i < end; ++i) {
+        ++histogram[keys[i] >> shift & 0xFF];
+      }
+    });
+    size_t position = 0;
+    for (size_t digit = 0; digit < 256; ++digit) {
+      for (size_t chunk = 0; chunk < chunks; ++chunk) {
+        const size_t size = offsets[chunk][digit];
+        offsets[chunk][digit] = position;
+        position += size;
+      }
+    }
+    ParallelFor(chunks, threads, [&](unsigned, size_t chunk) {
+      std::array<size_t, 256>& next = offsets[chunk];
+      const size_t end = std::min(count, (chunk + 1) * step);
+      for (size_t i = chunk * step; i < end; ++i) {
+        buffer[next[keys[i] >> shift & 0xFF]++] = keys[i];
+      }
+    });
+    keys.swap(buffer);
+  }
+}
+
+}  // namespace
+
+void Bvh::Build(size_t count, const BoundsFunction& bounds) {
+  S21_TRACE_SCOPE("Bvh::Build");
+  if (count == 0) {
+    Clear();
+    return;
+  }
+  const size_t chunks = (count + kPrimitivesPerChunk - 1) / kPrimitivesPerChunk;
+  auto chunk_end = [&](size_t chunk) {
+    return std::min(count, (chunk + 1) * kPrimitivesPerChunk);
+  };
+
+  // Box центров задаёт решётку ключей Мортона
+  std::vector<BvhBox> centers(chunks);
+  ParallelFor(chunks, threads_, [&](unsigned, size_t chunk) {
+    for (size_t i = chunk * kPrimitivesPerChunk; i < chunk_end(chunk); ++i) {
+      const BvhBox box = bounds(i);
+      if (box.IsEmpty()) continue;
+      float center[3];
+      for (int axis = 0; axis < 3; ++axis) {
+        center[axis] = 0.5f * (box.min[axis] + box.max[axis]);
+      }
+      centers[chunk].Expand(center);
+    }
+  });
+  BvhBox grid;
+  for (const BvhBox& box : centers) grid.Expand(box);
+
+  float scale[3] = {0.0f, 0.0f, 0.0f};
+  constexpr float kCells = 1 << kMortonBits;
+  for (int axis = 0; axis < 3 && !grid.IsEmpty(); ++axis) {
+    const float extent = grid.max[axis] - grid.min[axis];
+    if (extent > 0.0f) scale[axis] = kCells / extent;
+  }
+
+  std::vector<uint64_t> keys(count);
+  ParallelFor(chunks, threads_, [&](unsigned, size_t chunk) {
+    for (size_t i = chunk * kPrimitivesPerChunk; i < chunk_end(chunk); ++i) {
+      const BvhBox box = bounds(i);
+      uint32_t code = 0;
+      if (!box.IsEmpty()) {
+        for (int axis = 0; axis < 3; ++axis) {
+          const float center = 0.5f * (box.min[axis] + box.max[axis]);
+          const float cell = (center - grid.min[axis]) * scale[axis];
+          const uint32_t quantized = static_cast<uint32_t>(
+              std::min(std::max(cell, 0.0f), kCells - 1.0f));
+          code |= SpreadBits(quantized) << (2 - axis);
+        }
+      }
+      keys[i] = uint64_t{code} << 32 | i;
+    }
+  });
+  SortKeys(keys, threads_);
+
+  order_.resize(count);
+  ParallelFor(chunks, threads_, [&](unsigned, size_t chunk) {
+    for (size_t i = chunk * kPrimitivesPerChunk; i < chunk_end(chunk); ++i) {
+      order_[i] = static_cast<uint32_t>(keys[i]);
+    }
+  });
+  keys = std::vector<uint64_t>();
+  ComputeBoxes_(bounds);
+}
+
+void Bvh::Refit(const BoundsFunction& bounds) {
+  S21_TRACE_SCOPE("Bvh::Refit");
+  if (!order_.empty()) ComputeBoxes_(bounds);
+}
+
+void Bvh::Clear() noexcept {
+  order_ = std::vector<uint32_t>();
+  nodes_ = std::vector<BvhBox>();
+  levels_.clear();
+}
+
+void Bvh::ComputeBoxes_(const BoundsFunction& bounds) {
+  levels_.clear();
+  size_t total = 0;
+  for (size_t size = (order_.size() + kLeafSize - 1) / kLeafSize;;
+       size = (size + 1) / 2) {
+    levels_.push_back(total);
+    total += size;
+    if (size == 1) break;
+  }
+  nodes_.resize(total);
+
+  const size_t leaves = LevelSize_(0);
+  ParallelFor((leaves + kNodesPerChunk - 1) / kNodesPerChunk, threads_,
+              [&](unsigned, size_t chunk) {
+                const size_t end =
+                    std::min(leaves, (chunk + 1) * kNodesPerChunk);
+                for (size_t leaf = chunk * kNodesPerChunk; leaf < end;
+                     ++leaf) {
+                  BvhBox box;
+                  const size_t last =
+                      std::min(order_.size(), (leaf + 1) * kLeafSize);
+                  for (size_t k = leaf * kLeafSize; k < last; ++k) {
+                    box.Expand(bounds(order_[k]));
+                  }
+                  nodes_[leaf] = box;
+                }
+              });
+
+  for (size_t level = 1; level < levels_.size(); ++level) {
+    const size_t size = LevelSize_(level);
+    const size_t below = LevelOffset_(level - 1);
+    const size_t below_size = LevelSize_(level - 1);
+    BvhBox* out = &nodes_[LevelOffset_(level)];
+    ParallelFor((size + kNodesPerChunk - 1) / kNodesPerChunk, threads_,
+                [&](unsigned, size_t chunk) {
+                  const size_t end =
+                      std::min(size, (chunk + 1) * kNodesPerChunk);
+                  for (size_t j = chunk * kNodesPerChunk; j < end; ++j) {
+                    BvhBox box = nodes_[below + 2 * j];
+                    if (2 * j + 1 < below_size) {
+                      box.Expand(nodes_[below + 2 * j + 1]);
+                    }
+                    out[j] = box;
+                  }
+                });
+  }
+}
+
+}  // namespace s21
@@ -0,0 +1,278 @@
+#ifndef MODEL_BVH_H
+#define MODEL_BVH_H
+
+/**
+ * @file bvh.h
+ * @brief Иерархия ограничивающих box (BVH) для пространственных запросов
+ */
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "parallel.h"
+
+namespace s21 {
+
+/**
+ * @brief Ограничивающий box; пустой box имеет min > max
+ */
+struct BvhBox {
+  float min[3] = {INFINITY, INFINITY, INFINITY};
+  float max[3] = {-INFINITY, -INFINITY, -INFINITY};
+
+  /**
+   * @brief Расширяет box до точки
+   */
+  void Expand(const float point[3]) noexcept {
+    for (int axis = 0; axis < 3; ++axis) {
+      min[axis] = std::min(min[axis], point[axis]);
+      max[axis] = std::max(max[axis], point[axis]);
+    }
+  }
+
+  /**
+   * @brief Расширяет box до другого box
+   */
+  void Expand(const BvhBox& other) noexcept {
+    for (int axis = 0; axis < 3; ++axis) {
+      min[axis] = std::min(min[axis], other.min[axis]);
+      max[axis] = std::max(max[axis], other.max[axis]);
+    }
+  }
+
+  bool IsEmpty() const noexcept { return !(min[0] <= max[0]); }
+};
+
+/**
+ * @brief Положение узла относительно области запроса
+ */
+enum bvh_overlap_t {
+  kBvhOutside = 0,  ///< Ни один примитив узла не попадает в область
+  kBvhPartial = 1,  ///< Нужна проверка детей
+  kBvhInside = 2    ///< Все примитивы узла в области
+};
+
+/**
+ * @brief Иерархия ограничивающих box над произвольными примитивами
+ *
+ * Построение линейное (LBVH): центры примитивов кодируются 30-битным
+ * ключом Мортона, ключи сортируются параллельной поразрядной
+ * сортировкой, подряд идущие kLeafSize примитивов образуют лист, а
+ * каждый следующий уровень объединяет пары узлов предыдущего. Дерево
+ * хранится по уровням без указателей: дети узла j уровня level - узлы
+ * 2j и 2j + 1 уровня level - 1, а узлу соответствует непрерывный
+ * диапазон GetOrder(). Результат не зависит от числа потоков.
+ *
+ * Если примитивы сдвинулись, но не изменились (трансформация модели),
+ * Refit пересчитывает box при прежнем порядке без сортировки.
+ *
+ * @example
+ * @code
+ * Bvh bvh(DefaultThreadCount());
+ * bvh.Build(count, [&](size_t i) { return BoxOf(i); });
+ * bvh.VisitNearest(
+ *     [&](const BvhBox& box) { return LowerBound(box); },
+ *     [&](uint32_t i, double& limit) { limit = std::min(limit, Exact(i)); },
+ *     INFINITY);
+ * @endcode
+ */
+class Bvh {
+ public:
+  using BoundsFunction = std::function<BvhBox(size_t)>;
+
+  static constexpr size_t kLeafSize = 16;  ///< Примитивов в листе
+
+  explicit Bvh(unsigned threads = 1) : threads_(threads) {}
+
+  /**
+   * @brief Задаёт число потоков построения
+   */
+  void SetThreadCount(unsigned threads) noexcept { threads_ = threads; }
+  unsigned GetThreadCount() const noexcept { return threads_; }
+
+  /**
+   * @brief Строит иерархию над примитивами [0, count)
+   *
+   * @param count Количество примитивов (меньше 2^32)
+   * @param bounds Box примитива по номеру; вызывается из нескольких
+   * потоков, пустой box допустим (примитив не находится запросами)
+   */
+  void Build(size_t count, const BoundsFunction& bounds);
+
+  /**
+   * @brief Пересчитывает box узлов при прежнем порядке примитивов
+   */
+  void Refit(const BoundsFunction& bounds);
+
+  /**
+   * @brief Освобождает память
+   */
+  void Clear() noexcept;
+
+  size_t GetPrimitiveCount() const noexcept { return order_.size(); }
+
+  /**
+   * @brief Примитивы в порядке листьев
+   */
+  const std::vector<uint32_t>& GetOrder() const noexcept { return order_; }
+
+  /**
+   * @brief Box всех примитивов
+   */
+  BvhBox GetBounds() const noexcept {
+    return levels_.empty() ? BvhBox() : nodes_.back();
+  }
+
+  size_t GetLeafCount() const noexcept {
+    return levels_.empty() ? 0 : LevelSize_(0);
+  }
+
+  /**
+   * @brief Box листа: примитивы [leaf * kLeafSize, ...) из GetOrder()
+   */
+  const BvhBox& GetLeafBox(size_t leaf) const noexcept { return nodes_[leaf]; }
+
+  /**
+   * @brief Обход от ближнего к дальнему с отсечением по оценке
+   *
+   * Узел пропускается, если нижняя оценка bound(box) не меньше limit;
+   * из двух детей первым посещается ребёнок с меньшей оценкой. leaf
+   * может уменьшить limit, сужая дальнейший поиск.
+   *
+   * @param bound double(const BvhBox&) - нижняя оценка для узла
+   * @param leaf void(uint32_t primitive, double& limit)
+   * @param limit Начальная граница поиска
+   */
+  template <typename Bound, typename Leaf>
+  void VisitNearest(Bound&& bound, Leaf&& leaf, double limit) const;
+
+  /**
+   * @brief Обход с принятием и отбрасыванием узлов целиком
+   *
+   * Узел kBvhInside передаётся одним диапазоном позиций GetOrder(),
+   * примитивы частично попавших листьев проверяет leaf.
+   *
+   * @param classify bvh_overlap_t(const BvhBox&)
+   * @param accept void(size_t begin, size_t end) - позиции в GetOrder()
+   * @param leaf void(size_t position, uint32_t primitive)
+   * @param threads При > 1 поддеревья обходятся параллельно: колбэки
+   * вызываются одновременно, но диапазоны позиций разных поддеревьев не
+   * пересекаются и выровнены на 64, так что писать в общее битовое
+   * множество можно без синхронизации
+   */
+  template <typename Classify, typename Accept, typename Leaf>
+  void VisitOverlap(Classify&& classify, Accept&& accept, Leaf&& leaf,
+                    unsigned threads = 1) const;
+
+ private:
+  struct Pending {
+    size_t level;
+    size_t index;
+    double bound;
+  };
+
+  /**
+   * @brief Первый узел уровня в nodes_
+   */
+  size_t LevelOffset_(size_t level) const noexcept { return levels_[level]; }
+
+  size_t LevelSize_(size_t level) const noexcept {
+    return (level + 1 < levels_.size() ? levels_[level + 1] : nodes_.size()) -
+           levels_[level];
+  }
+
+  /**
+   * @brief Box листьев и всех уровней по текущему order_
+   */
+  void ComputeBoxes_(const BoundsFunction& bounds);
+
+  unsigned threads_ = 1;
+  std::vector<uint32_t> order_;  ///< Примитивы в порядке ключей Мортона
+  std::vector<BvhBox> nodes_;    ///< Узлы всех уровней, от листьев к корню
+  std::vector<size_t> levels_;   ///< Начало каждого уровня в nodes_
+};
+
+template <typename Bound, typename Leaf>
+void Bvh::VisitNearest(Bound&& bound, Leaf&& leaf, double limit) const {
+  if (levels_.empty()) return;
+  // Глубина не больше 32 уровней, в стеке на уровень ждёт один ребёнок
+  std::array<Pending, 64> stack;
+  size_t top = 0;
+  const size_t root = levels_.size() - 1;
+  stack[top++] = {root, 0, bound(nodes_.back())};
+  while (top > 0) {
+    const Pending node = stack[--top];
+    if (!(node.bound < limit)) continue;
+    if (node.level == 0) {
+      const size_t end =
+          std::min(order_.size(), (node.index + 1) * kLeafSize);
+      for (size_t k = node.index * kLeafSize; k < end; ++k) {
+        leaf(order_[k], limit);
+      }
+      continue;
+    }
+    const size_t level = node.level - 1;
+    const size_t first = node.index * 2;
+    const size_t offset = LevelOffset_(level);
+    Pending closer = {level, first, bound(nodes_[offset + first])};
+    if (first + 1 < LevelSize_(level)) {
+      Pending farther = {level, first + 1, bound(nodes_[offset + first + 1])};
+      if (farther.bound < closer.bound) std::swap(closer, farther);
+      stack[top++] = farther;
+    }
+    stack[top++] = closer;
+  }
+}
+
+template <typename Classify, typename Accept, typename Leaf>
+void Bvh::VisitOverlap(Classify&& classify, Accept&& accept, Leaf&& leaf,
+                       unsigned threads) const {
+  if (levels_.empty()) return;
+  const auto visit = [&](size_t root_level, size_t root) {
+    std::array<std::pair<size_t, size_t>, 64> stack;
+    size_t top = 0;
+    stack[top++] = {root_level, root};
+    while (top > 0) {
+      const auto [level, index] = stack[--top];
+      const bvh_overlap_t overlap =
+          classify(nodes_[LevelOffset_(level) + index]);
+      if (overlap == kBvhOutside) continue;
+      const size_t begin = (index << level) * kLeafSize;
+      const size_t end =
+          std::min(order_.size(), ((index + 1) << level) * kLeafSize);
+      if (overlap == kBvhInside) {
+        accept(begin, end);
+      } else if (level == 0) {
+        for (size_t k = begin; k < end; ++k) leaf(k, order_[k]);
+      } else {
+        if (index * 2 + 1 < LevelSize_(level - 1)) {
+          stack[top++] = {level - 1, index * 2 + 1};
+        }
+        stack[top++] = {level - 1, index * 2};
+      }
+    }
+  };
+
+  // Уровень разбиения: по нескольку поддеревьев на поток, узел - не
+  // меньше 64 позиций (kLeafSize << 2)
+  static_assert((kLeafSize << 2) % 64 == 0, "поддерево меньше слова");
+  size_t split = levels_.size() - 1;
+  while (split > 2 && LevelSize_(split) < size_t{threads} * 4) --split;
+  if (threads <= 1 || split < 2 || LevelSize_(split) < 2) {
+    visit(levels_.size() - 1, 0);
+    return;
+  }
+  ParallelFor(LevelSize_(split), threads,
+              [&](unsigned, size_t index) { visit(split, index); });
+}
+
+}  // namespace s21
+
+#endif  // MODEL_BVH_H
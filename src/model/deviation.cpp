@@ -0,0 +1,315 @@
+/**
+ * @file deviation.cpp
+ * @brief Реализация расстояний от вершин до эталонной поверхности
+ */
+
+#include "deviation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "../profiling/trace.h"
+#include "parallel.h"
+
+namespace s21 {
+
+namespace {
+
+constexpr size_t kDeviationChunk = 4096;  ///< Граней или вершин на задачу
+constexpr uint32_t kNoTriangle = UINT32_MAX;
+
+/**
+ * @brief Частичные итоги куска вершин
+ */
+struct DeviationPartial {
+  double sum = 0.0;
+  double sum_sq = 0.0;
+  double max = -1.0;
+  size_t max_vertex = 0;
+  size_t count = 0;
+};
+
+/**
+ * @brief Квадрат расстояния от точки до box (0 внутри)
+ */
+double BoxDistanceSq(const BvhBox& box, const double p[3]) noexcept {
+  double sum = 0.0;
+  for (int axis = 0; axis < 3; ++axis) {
+    const double gap =
+        std::max(double(box.min[axis]) - p[axis], p[axis] - box.max[axis]);
+    if (gap > 0.0) sum += gap * gap;
+  }
+  return sum;
+}
+
+double Dot(const double a[3], const double b[3]) noexcept {
+  return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+}  // namespace
+
+void Deviation::Build(const Mesh& reference) {
+  std::vector<float> positions(reference.vertex_coord.begin(),
+                               reference.vertex_coord.end());
+  Build(std::move(positions), reference.face_index, reference.face_offset);
+}
+
+void Deviation::Build(std::vector<float> positions,
+                      const std::vector<int>& face_index,
+                      const std::vector<int>& face_offset) {
+  S21_TRACE_SCOPE("Deviation::Build");
+  positions_ = std::move(positions);
+  const size_t faces = face_offset.empty() ? 0 : face_offset.size() - 1;
+  const size_t chunks = (faces + kDeviationChunk - 1) / kDeviationChunk;
+  const int vertices = static_cast<int>(positions_.size() / 3);
+  // Треугольников веера грани; 0 - грань пропускается
+  auto fan = [&](size_t face) -> size_t {
+    const int begin = face_offset[face], end = face_offset[face + 1];
+    if (end - begin < 3) return 0;
+    for (int i = begin; i < end; ++i) {
+      if (face_index[i] < 0 || face_index[i] >= vertices) return 0;
+    }
+    return size_t(end - begin - 2);
+  };
+
+  // Подсчёт по кускам граней, префиксная сумма, раскладка веером
+  std::vector<size_t> start(chunks + 1, 0);
+  ParallelFor(chunks, threads_, [&](unsigned, size_t chunk) {
+    const size_t to = std::min(faces, (chunk + 1) * kDeviationChunk);
+    for (size_t face = chunk * kDeviationChunk; face < to; ++face) {
+      start[chunk + 1] += fan(face);
+    }
+  });
+  for (size_t chunk = 0; chunk < chunks; ++chunk) {
+    start[chunk + 1] += start[chunk];
+  }
+  triangles_.resize(start.back() * 3);
+  ParallelFor(chunks, threads_, [&](unsigned, size_t chunk) {
+    const size_t to = std::min(faces, (chunk + 1) * kDeviationChunk);
+    uint32_t* out = triangles_.data() + start[chunk] * 3;
+    for (size_t face = chunk * kDeviationChunk; face < to; ++face) {
+      const size_t count = fan(face);
+      const int begin = face_offset[face];
+      for (size_t k = 0; k < count; ++k) {
+        *out++ = uint32_t(face_index[begin]);
+        *out++ = uint32_t(face_index[begin + k + 1]);
+        *out++ = uint32_t(face_index[begin + k + 2]);
+      }
+    }
+  });
+
+  // Описанные сферы: центр масс и наибольшее расстояние до вершины
+  const size_t triangles = GetTriangleCount();
+  const size_t triangle_chunks =
+      (triangles + kDeviationChunk - 1) / kDeviationChunk;
+  spheres_.resize(triangles * 4);
+  ParallelFor(triangle_chunks, threads_, [&](unsigned, size_t chunk) {
+    const size_t to = std::min(triangles, (chunk + 1) * kDeviationChunk);
+    for (size_t triangle = chunk * kDeviationChunk; triangle < to;
+         ++triangle) {
+      const float* corner[3];
+      for (int k = 0; k < 3; ++k) {
+        corner[k] = &positions_[size_t(triangles_[triangle * 3 + k]) * 3];
+      }
+      float* sphere = &spheres_[triangle * 4];
+      double radius = 0.0;
+      for (int axis = 0; axis < 3; ++axis) {
+        sphere[axis] = static_cast<float>(
+            (double(corner[0][axis]) + corner[1][axis] + corner[2][axis]) /
+            3.0);
+      }
+      for (int k = 0; k < 3; ++k) {
+        double sum = 0.0;
+        for (int axis = 0; axis < 3; ++axis) {
+          const double d = double(corner[k][axis]) - sphere[axis];
+          sum += d * d;
+        }
+        radius = std::max(radius, std::sqrt(sum));
+      }
+      // Запас на округление радиуса до float
+      sphere[3] = static_cast<float>(radius * (1.0 + 1e-6));
+    }
+  });
+
+  tree_.Build(triangles, [this](size_t triangle) {
+    BvhBox box;
+    for (int corner = 0; corner < 3; ++corner) {
+      box.Expand(&positions_[size_t(triangles_[triangle * 3 + corner]) * 3]);
+    }
+    return box;
+  });
+}
+
+double Deviation::ClosestPoint_(uint32_t triangle, const double p[3],
+                                double closest[3]) const noexcept {
+  // Области Вороного вершин, рёбер и грани (Ericson, Real-Time
+  // Collision Detection, 5.1.5)
+  double corner[3][3];
+  for (int k = 0; k < 3; ++k) {
+    const float* v = &positions_[size_t(triangles_[triangle * 3 + k]) * 3];
+    corner[k][0] = v[0];
+    corner[k][1] = v[1];
+    corner[k][2] = v[2];
+  }
+  const double* a = corner[0];
+  const double* b = corner[1];
+  const double* c = corner[2];
+  // Точка origin + u * t1 + w * t2 и квадрат расстояния до неё
+  auto finish = [&](const double* origin, const double* u, double t1,
+                    const double* w, double t2) {
+    double sum = 0.0;
+    for (int axis = 0; axis < 3; ++axis) {
+      closest[axis] = origin[axis] + u[axis] * t1 + w[axis] * t2;
+      const double d = p[axis] - closest[axis];
+      sum += d * d;
+    }
+    return sum;
+  };
+  const double ab[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+  const double ac[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+  const double bc[3] = {c[0] - b[0], c[1] - b[1], c[2] - b[2]};
+  auto vertex = [&](const double* v) { return finish(v, ab, 0.0, ac, 0.0); };
+  auto edge = [&](const double* origin, const double* direction, double t) {
+    return finish(origin, direction, t, ac, 0.0);
+  };
+
+  const double ap[3] = {p[0] - a[0], p[1] - a[1], p[2] - a[2]};
+  const double d1 = Dot(ab, ap), d2 = Dot(ac, ap);
+  if (d1 <= 0.0 && d2 <= 0.0) return vertex(a);
+
+  const double bp[3] = {p[0] - b[0], p[1] - b[1], p[2] - b[2]};
+  const double d3 = Dot(ab, bp), d4 = Dot(ac, bp);
+  if (d3 >= 0.0 && d4 <= d3) return vertex(b);
+
+  const double vc = d1 * d4 - d3 * d2;
+  if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0) return edge(a, ab, d1 / (d1 - d3));
+
+  const double cp[3] = {p[0] - c[0], p[1] - c[1], p[2] - c[2]};
+  const double d5 = Dot(ab, cp), d6 = Dot(ac, cp);
+  if (d6 >= 0.0 && d5 <= d6) return vertex(c);
+
+  const double vb = d5 * d2 - d1 * d6;
+  if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0) return edge(a, ac, d2 / (d2 - d6));
+
+  const double va = d3 * d6 - d5 * d4;
+  if (va <= 0.0 && d4 - d3 >= 0.0 && d5 - d6 >= 0.0) {
+    return edge(b, bc, (d4 - d3) / ((d4 - d3) + (d5 - d6)));
+  }
+
+  const double sum = va + vb + vc;
+  if (!(sum > 0.0)) {
+    // Вырожденный треугольник: ближайшая из вершин
+    double best = vertex(a), point[3] = {closest[0], closest[1], closest[2]};
+    for (const double* v : {b, c}) {
+      const double d = vertex(v);
+      if (d < best) {
+        best = d;
+        std::copy(closest, closest + 3, point);
+      }
+    }
+    std::copy(point, point + 3, closest);
+    return best;
+  }
+  return finish(a, ab, vb / sum, ac, vc / sum);
+}
+
+DeviationStats Deviation::Measure(const std::vector<double>& vertex_coord,
+                                  std::vector<float>& distance) const {
+  S21_TRACE_SCOPE("Deviation::Measure");
+  const size_t vertices = vertex_coord.size() / 3;
+  distance.assign(vertices, NAN);
+  DeviationStats stats;
+  if (GetTriangleCount() == 0) return stats;
+
+  const size_t chunks = (vertices + kDeviationChunk - 1) / kDeviationChunk;
+  std::vector<DeviationPartial> parts(chunks);
+  ParallelFor(chunks, threads_, [&](unsigned, size_t chunk) {
+    DeviationPartial& part = parts[chunk];
+    const size_t to = std::min(vertices, (chunk + 1) * kDeviationChunk);
+    uint32_t previous = kNoTriangle;
+    for (size_t vertex = chunk * kDeviationChunk; vertex < to; ++vertex) {
+      const double* p = &vertex_coord[vertex * 3];
+      // Соседняя вершина обычно ближе всего к тому же или соседнему
+      // треугольнику: расстояние до ближайшего треугольника предыдущей
+      // вершины - почти точная оценка сверху, и обход сразу отсекает
+      // почти всё дерево
+      double limit = INFINITY;
+      uint32_t nearest = previous;
+      if (previous != kNoTriangle) {
+        double point[3];
+        limit = ClosestPoint_(previous, p, point);
+      }
+      tree_.VisitNearest(
+          [p](const BvhBox& box) { return BoxDistanceSq(box, p); },
+          [&](uint32_t triangle, double& bound) {
+            // Описанная сфера отсекает треугольник дешевле точной проверки
+            const float* sphere = &spheres_[size_t(triangle) * 4];
+            const double dx = p[0] - sphere[0], dy = p[1] - sphere[1],
+                         dz = p[2] - sphere[2];
+            const double reach = std::sqrt(bound) + sphere[3];
+            if (dx * dx + dy * dy + dz * dz > reach * reach) return;
+            double point[3];
+            const double d = ClosestPoint_(triangle, p, point);
+            if (d < bound) {
+              bound = d;
+              limit = d;
+              nearest = triangle;
+            }
+          },
+          limit);
+      previous = nearest;
+      const double d = std::sqrt(limit);
+      distance[vertex] = static_cast<float>(d);
+      part.sum += d;
+      part.sum_sq += d * d;
+      if (d > part.max) {
+        part.max = d;
+        part.max_vertex = vertex;
+      }
+      ++part.count;
+    }
+  });
+
+  double sum = 0.0, sum_sq = 0.0;
+  for (const DeviationPartial& part : parts) {
+    if (part.count > 0 && part.max > stats.max) {
+      stats.max = part.max;
+      stats.max_vertex = part.max_vertex;
+    }
+    sum += part.sum;
+    sum_sq += part.sum_sq;
+    stats.vertex_count += part.count;
+  }
+  if (stats.vertex_count > 0) {
+    stats.mean = sum / double(stats.vertex_count);
+    stats.rms = std::sqrt(sum_sq / double(stats.vertex_count));
+  }
+  return stats;
+}
+
+void MakeHeatMap(const std::vector<float>& distance, double limit,
+                 std::vector<float>& rgb, unsigned threads) {
+  const size_t count = distance.size();
+  rgb.resize(count * 3);
+  const size_t chunks = (count + kDeviationChunk - 1) / kDeviationChunk;
+  ParallelFor(chunks, threads, [&](unsigned, size_t chunk) {
+    const size_t to = std::min(count, (chunk + 1) * kDeviationChunk);
+    for (size_t i = chunk * kDeviationChunk; i < to; ++i) {
+      float* color = &rgb[i * 3];
+      const double d = distance[i];
+      if (std::isnan(d)) {
+        color[0] = color[1] = color[2] = 0.5f;
+        continue;
+      }
+      const float t = static_cast<float>(
+          limit > 0.0 ? std::min(1.0, d / limit) : (d > 0.0 ? 1.0 : 0.0));
+      // Синий - зелёный - красный
+      color[0] = std::max(0.0f, 2.0f * t - 1.0f);
+      color[1] = 1.0f - std::abs(2.0f * t - 1.0f);
+      color[2] = std::max(0.0f, 1.0f - 2.0f * t);
+    }
+  });
+}
+
+}  // namespace s21
@@ -0,0 +1,128 @@
+#ifndef MODEL_DEVIATION_H
+#define MODEL_DEVIATION_H
+
+/**
+ * @file deviation.h
+ * @brief Отклонение сетки от эталонной поверхности (расстояние Хаусдорфа)
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "bvh.h"
+#include "mesh.h"
+
+namespace s21 {
+
+/**
+ * @brief Сводка расстояний вершин до эталона
+ */
+struct DeviationStats {
+  size_t vertex_count = 0;  ///< Измерено вершин
+  size_t max_vertex = 0;    ///< Вершина с наибольшим расстоянием
+  double max = 0.0;         ///< Наибольшее расстояние
+  double mean = 0.0;        ///< Среднее расстояние
+  double rms = 0.0;         ///< Среднеквадратичное расстояние
+};
+
+/**
+ * @brief Расстояния от вершин сетки до поверхности эталона
+ *
+ * Грани эталона разбиваются веером на треугольники, над ними строится
+ * Bvh. Для каждой вершины ищется ближайшая точка поверхности обходом
+ * от ближних узлов к дальним с отсечением по расстоянию до box.
+ * Вершины соседние в файле обычно соседние и в пространстве, поэтому
+ * поиск начинается с расстояния до ближайшего треугольника предыдущей
+ * вершины куска: эта оценка сверху почти точна и сразу отсекает почти
+ * всё дерево. Треугольники листа сначала проверяются описанной сферой,
+ * точная ближайшая точка ищется только для немногих оставшихся.
+ *
+ * Measure - одностороннее отклонение (от вершин к эталону).
+ * Симметричное расстояние Хаусдорфа - наибольшее из двух направлений:
+ * @code
+ * Deviation to_reference(DefaultThreadCount());
+ * to_reference.Build(reference);
+ * Deviation to_model(DefaultThreadCount());
+ * to_model.Build(model);
+ * std::vector<float> distance;
+ * const double hausdorff = std::max(
+ *     to_reference.Measure(model.vertex_coord, distance).max,
+ *     to_model.Measure(reference.vertex_coord, distance).max);
+ * @endcode
+ *
+ * Итог не зависит от числа потоков: вершины делятся на куски
+ * постоянного размера, суммы складываются по порядку кусков.
+ */
+class Deviation {
+ public:
+  explicit Deviation(unsigned threads = 1)
+      : threads_(threads), tree_(threads) {}
+
+  /**
+   * @brief Строит иерархию над гранями эталона
+   */
+  void Build(const Mesh& reference);
+
+  /**
+   * @brief Строит иерархию по собственной копии координат
+   *
+   * Грани с индексом вне диапазона вершин и грани меньше чем из трёх
+   * вершин пропускаются.
+   *
+   * @param positions Координаты вершин x, y, z подряд
+   * @param face_index Индексы вершин граней подряд
+   * @param face_offset Начала граней в face_index (граней + 1)
+   */
+  void Build(std::vector<float> positions, const std::vector<int>& face_index,
+             const std::vector<int>& face_offset);
+
+  size_t GetTriangleCount() const noexcept { return triangles_.size() / 3; }
+
+  /**
+   * @brief Box эталона
+   */
+  BvhBox GetBounds() const noexcept { return tree_.GetBounds(); }
+
+  /**
+   * @brief Расстояния вершин до поверхности эталона
+   *
+   * @param vertex_coord Координаты вершин x, y, z подряд
+   * @param distance Выход: расстояние каждой вершины; NaN, если у
+   * эталона нет треугольников
+   * @return Сводка; vertex_count = 0 без треугольников
+   */
+  DeviationStats Measure(const std::vector<double>& vertex_coord,
+                         std::vector<float>& distance) const;
+
+ private:
+  /**
+   * @brief Ближайшая к p точка треугольника и квадрат расстояния до неё
+   */
+  double ClosestPoint_(uint32_t triangle, const double p[3],
+                       double closest[3]) const noexcept;
+
+  unsigned threads_ = 1;
+  std::vector<float> positions_;     ///< Координаты вершин эталона
+  std::vector<uint32_t> triangles_;  ///< Вершины треугольников по три
+  std::vector<float> spheres_;       ///< Описанные сферы: центр, радиус
+  Bvh tree_;                         ///< Иерархия над треугольниками
+};
+
+/**
+ * @brief Цвета тепловой карты отклонений
+ *
+ * 0 - синий, limit / 2 - зелёный, limit и больше - красный; вершины без
+ * расстояния (NaN) - серые.
+ *
+ * @param distance Расстояния вершин
+ * @param limit Расстояние, которому соответствует красный
+ * @param rgb Выход: r, g, b в [0, 1] на вершину
+ * @param threads Число потоков
+ */
+void MakeHeatMap(const std::vector<float>& distance, double limit,
+                 std::vector<float>& rgb, unsigned threads = 1);
+
+}  // namespace s21
+
+#endif  // MODEL_DEVIATION_H
@@ -0,0 +1,861 @@
+/**
+ * @file hull.cpp
+ * @brief Реализация выпуклой оболочки и ориентированного box
+ */
+
+#include "hull.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+
+#include "../profiling/trace.h"
+#include "parallel.h"
+
+namespace s21 {
+
+namespace {
+
+constexpr size_t kHullChunk = 4096;       ///< Точек на задачу
+constexpr double kHullTolerance = 1e-10;  ///< Допуск относительно размера
+constexpr double kBoxPadding = 1e-9;      ///< Добавка к сторонам в сравнении
+constexpr int kBoxRefineRounds = 3;       ///< Уточнений лучшего box
+
+using Vector3 = std::array<double, 3>;
+
+Vector3 At(const std::vector<double>& coord, size_t i) noexcept {
+  return {coord[i * 3], coord[i * 3 + 1], coord[i * 3 + 2]};
+}
+
+Vector3 Sub(const Vector3& a, const Vector3& b) noexcept {
+  return {a[0] - b[0], a[1] - b[1], a[2] - b[2]};
+}
+
+double Dot(const Vector3& a, const Vector3& b) noexcept {
+  return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+Vector3 Cross(const Vector3& a, const Vector3& b) noexcept {
+  return {a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2],
+          a[0] * b[1] - a[1] * b[0]};
+}
+
+double Length(const Vector3& a) noexcept { return std::sqrt(Dot(a, a)); }
+
+/**
+ * @brief Единичный вектор того же направления; нулевой остаётся нулевым
+ */
+Vector3 Normalized(const Vector3& a) noexcept {
+  const double length = Length(a);
+  if (length == 0.0) return a;
+  return {a[0] / length, a[1] / length, a[2] / length};
+}
+
+/**
+ * @brief Индекс наибольшего score(i) из [0, count), при равенстве - первый
+ *
+ * Куски просматриваются параллельно, их лучшие сравниваются по порядку.
+ */
+template <typename Score>
+size_t ArgMax(size_t count, unsigned threads, Score score) {
+  const size_t chunks = (count + kHullChunk - 1) / kHullChunk;
+  std::vector<std::pair<double, size_t>> best(
+      chunks, {-std::numeric_limits<double>::infinity(), 0});
+  ParallelFor(chunks, threads, [&](unsigned, size_t chunk) {
+    const size_t to = std::min(count, (chunk + 1) * kHullChunk);
+    for (size_t i = chunk * kHullChunk; i < to; ++i) {
+      const double value = score(i);
+      if (value > best[chunk].first) best[chunk] = {value, i};
+    }
+  });
+  std::pair<double, size_t> result = {
+      -std::numeric_limits<double>::infinity(), 0};
+  for (const auto& candidate : best) {
+    if (candidate.first > result.first) result = candidate;
+  }
+  return result.second;
+}
+
+/**
+ * @brief Точка на плоскости с номером исходной вершины
+ */
+struct Point2 {
+  double x;
+  double y;
+  int index;
+};
+
+double Cross2(const Point2& o, const Point2& a, const Point2& b) noexcept {
+  return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+}
+
+/**
+ * @brief Выпуклый многоугольник точек (монотонная цепочка Эндрю)
+ *
+ * points сортируются на месте. Итог обходится против часовой стрелки,
+ * повторы и точки ближе tolerance к сторонам отбрасываются.
+ */
+void ConvexPolygon(std::vector<Point2>& points, double tolerance,
+                   std::vector<Point2>& polygon) {
+  // Поворот налево дальше допуска от прямой двух последних точек
+  auto turns_left = [tolerance](const Point2& o, const Point2& a,
+                                const Point2& b) {
+    const double cross = Cross2(o, a, b);
+    const double dx = a.x - o.x, dy = a.y - o.y;
+    return cross > 0.0 &&
+           cross * cross > tolerance * tolerance * (dx * dx + dy * dy);
+  };
+  std::sort(points.begin(), points.end(),
+            [](const Point2& a, const Point2& b) {
+              if (a.x != b.x) return a.x < b.x;
+              if (a.y != b.y) return a.y < b.y;
+              return a.index < b.index;
+            });
+  polygon.clear();
+  if (points.size() < 2) {
+    polygon = points;
+    return;
+  }
+  polygon.resize(points.size() * 2);
+  size_t size = 0;
+  for (const Point2& point : points) {
+    while (size >= 2 &&
+           !turns_left(polygon[size - 2], polygon[size - 1], point)) {
+      --size;
+    }
+    polygon[size++] = point;
+  }
+  const size_t lower = size + 1;
+  for (size_t i = points.size() - 1; i-- > 0;) {
+    while (size >= lower &&
+           !turns_left(polygon[size - 2], polygon[size - 1], points[i])) {
+      --size;
+    }
+    polygon[size++] = points[i];
+  }
+  polygon.resize(size - 1);
+}
+
+/**
+ * @brief Прямоугольник вокруг многоугольника в направлении стороны
+ *
+ * Вдоль direction точки лежат в [low[0], high[0]], вдоль перпендикуляра
+ * (-direction.y, direction.x) - в [low[1], high[1]].
+ */
+struct Rectangle {
+  double direction[2] = {1.0, 0.0};
+  double low[2] = {0.0, 0.0};
+  double high[2] = {0.0, 0.0};
+};
+
+/**
+ * @brief Прямоугольник вокруг точек со сторонами вдоль (ex, ey)
+ */
+Rectangle AlignedRectangle(const std::vector<Point2>& points, double ex,
+                           double ey) {
+  Rectangle rectangle;
+  rectangle.direction[0] = ex;
+  rectangle.direction[1] = ey;
+  for (int side = 0; side < 2; ++side) {
+    rectangle.low[side] = std::numeric_limits<double>::infinity();
+    rectangle.high[side] = -std::numeric_limits<double>::infinity();
+  }
+  for (const Point2& point : points) {
+    const double along = point.x * ex + point.y * ey;
+    const double across = point.y * ex - point.x * ey;
+    rectangle.low[0] = std::min(rectangle.low[0], along);
+    rectangle.high[0] = std::max(rectangle.high[0], along);
+    rectangle.low[1] = std::min(rectangle.low[1], across);
+    rectangle.high[1] = std::max(rectangle.high[1], across);
+  }
+  return rectangle;
+}
+
+/**
+ * @brief Прямоугольник наименьшей площади (вращающиеся калиперы)
+ *
+ * Одна из сторон такого прямоугольника лежит на стороне многоугольника.
+ * Для каждой стороны крайние вершины вдоль неё и по нормали только
+ * сдвигаются вперёд по обходу, поэтому перебор сторон линеен. Стороны
+ * не длиннее padding (почти совпавшие вершины тонких проекций) имеют
+ * случайное направление и пропускаются. Площадь сравнивается со
+ * сторонами, увеличенными на padding, чтобы вырожденные прямоугольники
+ * нулевой ширины различались длиной.
+ *
+ * @param polygon Выпуклый многоугольник против часовой стрелки
+ */
+Rectangle MinAreaRectangle(const std::vector<Point2>& polygon,
+                           double padding) {
+  const size_t size = polygon.size();
+  Rectangle best;
+  double best_cost = std::numeric_limits<double>::infinity();
+  double longest = 0.0;
+  double longest_direction[2] = {1.0, 0.0};
+  bool started = false;
+  size_t max_along = 0, min_along = 0, max_across = 0;
+  for (size_t i = 0; i < size; ++i) {
+    const Point2& from = polygon[i];
+    const Point2& to = polygon[(i + 1) % size];
+    const double length = std::hypot(to.x - from.x, to.y - from.y);
+    const double ex = (to.x - from.x) / length;
+    const double ey = (to.y - from.y) / length;
+    if (length > longest) {
+      longest = length;
+      longest_direction[0] = ex;
+      longest_direction[1] = ey;
+    }
+    if (size < 3 || length <= padding) continue;
+    auto along = [&](size_t j) {
+      return polygon[j].x * ex + polygon[j].y * ey;
+    };
+    auto across = [&](size_t j) {
+      return polygon[j].y * ex - polygon[j].x * ey;
+    };
+    if (!started) {
+      started = true;
+      max_along = min_along = max_across = i;
+      for (size_t j = 0; j < size; ++j) {
+        if (along(j) > along(max_along)) max_along = j;
+        if (along(j) < along(min_along)) min_along = j;
+        if (across(j) > across(max_across)) max_across = j;
+      }
+    } else {
+      // Равные значения тоже проходятся: у почти вырожденных
+      // многоугольников крайняя вершина бывает за плато
+      for (size_t step = 0; step < size &&
+                            along((max_along + 1) % size) >= along(max_along);
+           ++step) {
+        max_along = (max_along + 1) % size;
+      }
+      for (size_t step = 0; step < size &&
+                            along((min_along + 1) % size) <= along(min_along);
+           ++step) {
+        min_along = (min_along + 1) % size;
+      }
+      for (size_t step = 0;
+           step < size &&
+           across((max_across + 1) % size) >= across(max_across);
+           ++step) {
+        max_across = (max_across + 1) % size;
+      }
+    }
+    const double width = along(max_along) - along(min_along);
+    const double height = across(max_across) - across(i);
+    const double cost = (width + padding) * (height + padding);
+    if (cost < best_cost) {
+      best_cost = cost;
+      best.direction[0] = ex;
+      best.direction[1] = ey;
+      best.low[0] = along(min_along);
+      best.high[0] = along(max_along);
+      best.low[1] = across(i);
+      best.high[1] = across(max_across);
+    }
+  }
+  // Точка, отрезок или многоугольник из одних коротких сторон
+  if (!started) {
+    return AlignedRectangle(polygon, longest_direction[0],
+                            longest_direction[1]);
+  }
+  return best;
+}
+
+/**
+ * @brief Грань растущей оболочки
+ */
+struct HullFace {
+  int vertex[3] = {-1, -1, -1};    ///< Вершины против часовой стрелки
+  int neighbor[3] = {-1, -1, -1};  ///< Соседи через рёбра k -> k + 1
+  Vector3 normal;                  ///< Внешняя единичная нормаль
+  double offset = 0.0;  ///< Расстояние плоскости от начала координат
+  std::vector<int> outside;  ///< Точки над гранью
+  int farthest = -1;         ///< Самая дальняя из outside
+  bool alive = true;         ///< Грань ещё на оболочке
+  bool visible = false;      ///< Видна из добавляемой точки
+};
+
+/**
+ * @brief Ребро горизонта: край видимой области и невидимая грань за ним
+ */
+struct HorizonEdge {
+  int from;
+  int to;
+  int face;
+};
+
+/**
+ * @brief Построение оболочки quickhull
+ */
+class QuickHull {
+ public:
+  QuickHull(const std::vector<double>& coord, unsigned threads)
+      : coord_(coord), threads_(threads) {}
+
+  ConvexHull Run();
+
+ private:
+  double Distance_(const HullFace& face, int point) const noexcept {
+    return Dot(face.normal, At(coord_, point)) - face.offset;
+  }
+
+  int AddFace_(int a, int b, int c);
+
+  /**
+   * @brief Раздаёт точки первой грани из faces, над которой они лежат
+   *
+   * Точки не над одной из граней внутри оболочки и отбрасываются.
+   */
+  void Assign_(const std::vector<int>& points, const std::vector<int>& faces);
+
+  /**
+   * @brief Добавляет в оболочку самую дальнюю точку грани
+   */
+  void AddPoint_(int face);
+
+  /**
+   * @brief Оболочка точек одной плоскости: многоугольник на плоскости
+   */
+  ConvexHull Flat_(int a, int b, const Vector3& normal) const;
+
+  ConvexHull Collect_() const;
+
+  const std::vector<double>& coord_;
+  unsigned threads_;
+  double tolerance_ = 0.0;
+  std::vector<HullFace> faces_;
+  std::vector<int> pending_;  ///< Грани с точками снаружи
+  std::vector<int> visible_;
+  std::vector<int> orphans_;
+  std::vector<int> created_;
+  std::vector<HorizonEdge> horizon_;
+  std::unordered_map<int, int> starts_;  ///< Новая грань по from горизонта
+  std::unordered_map<int, int> ends_;    ///< Новая грань по to горизонта
+};
+
+int QuickHull::AddFace_(int a, int b, int c) {
+  HullFace face;
+  face.vertex[0] = a;
+  face.vertex[1] = b;
+  face.vertex[2] = c;
+  const Vector3 pa = At(coord_, a);
+  face.normal = Normalized(
+      Cross(Sub(At(coord_, b), pa), Sub(At(coord_, c), pa)));
+  face.offset = Dot(face.normal, pa);
+  faces_.push_back(std::move(face));
+  return static_cast<int>(faces_.size()) - 1;
+}
+
+void QuickHull::Assign_(const std::vector<int>& points,
+                        const std::vector<int>& faces) {
+  const size_t chunks = (points.size() + kHullChunk - 1) / kHullChunk;
+  auto target = [&](int point) {
+    for (size_t k = 0; k < faces.size(); ++k) {
+      if (Distance_(faces_[faces[k]], point) > tolerance_) return int(k);
+    }
+    return -1;
+  };
+  if (chunks <= 1) {
+    for (int point : points) {
+      const int k = target(point);
+      if (k >= 0) faces_[faces[k]].outside.push_back(point);
+    }
+  } else {
+    // Куски раздают в свои списки, склейка по порядку кусков
+    std::vector<std::vector<std::vector<int>>> parts(
+        chunks, std::vector<std::vector<int>>(faces.size()));
+    ParallelFor(chunks, threads_, [&](unsigned, size_t chunk) {
+      const size_t to = std::min(points.size(), (chunk + 1) * kHullChunk);
+      for (size_t i = chunk * kHullChunk; i < to; ++i) {
+        const int k = target(points[i]);
+        if (k >= 0) parts[chunk][k].push_back(points[i]);
+      }
+    });
+    for (const auto& part : parts) {
+      for (size_t k = 0; k < faces.size(); ++k) {
+        std::vector<int>& outside = faces_[faces[k]].outside;
+        outside.insert(outside.end(), part[k].begin(), part[k].end());
+      }
+    }
+  }
+  for (int id : faces) {
+    HullFace& face = faces_[id];
+    double farthest = -1.0;
+    face.farthest = -1;
+    for (int point : face.outside) {
+      const double distance = Distance_(face, point);
+      if (distance > farthest) {
+        farthest = distance;
+        face.farthest = point;
+      }
+    }
+  }
+}
+
+void QuickHull::AddPoint_(int face) {
+  const int point = faces_[face].farthest;
+
+  // Видимые грани - связная область вокруг face
+  visible_.assign(1, face);
+  faces_[face].visible = true;
+  for (size_t i = 0; i < visible_.size(); ++i) {
+    for (int neighbor : faces_[visible_[i]].neighbor) {
+      HullFace& next = faces_[neighbor];
+      if (!next.visible && Distance_(next, point) > tolerance_) {
+        next.visible = true;
+        visible_.push_back(neighbor);
+      }
+    }
+  }
+  horizon_.clear();
+  for (int id : visible_) {
+    const HullFace& current = faces_[id];
+    for (int k = 0; k < 3; ++k) {
+      if (!faces_[current.neighbor[k]].visible) {
+        horizon_.push_back({current.vertex[k], current.vertex[(k + 1) % 3],
+                            current.neighbor[k]});
+      }
+    }
+  }
+
+  // Горизонт должен быть одним простым циклом. Погрешность округления
+  // изредка даёт область с дырой; тогда точка считается лежащей на
+  // оболочке
+  starts_.clear();
+  ends_.clear();
+  bool simple = true;
+  for (const HorizonEdge& edge : horizon_) {
+    simple = simple && starts_.emplace(edge.from, -1).second &&
+             ends_.emplace(edge.to, -1).second;
+  }
+  for (const HorizonEdge& edge : horizon_) {
+    simple = simple && starts_.count(edge.to) != 0;
+  }
+  if (!simple) {
+    for (int id : visible_) faces_[id].visible = false;
+    HullFace& current = faces_[face];
+    current.outside.erase(
+        std::find(current.outside.begin(), current.outside.end(), point));
+    Assign_({}, {face});
+    if (!current.outside.empty()) pending_.push_back(face);
+    return;
+  }
+
+  // Новые грани - конус из точки на рёбра горизонта
+  created_.clear();
+  for (const HorizonEdge& edge : horizon_) {
+    const int id = AddFace_(edge.from, edge.to, point);
+    created_.push_back(id);
+    starts_[edge.from] = id;
+    ends_[edge.to] = id;
+    faces_[id].neighbor[0] = edge.face;
+    HullFace& behind = faces_[edge.face];
+    for (int k = 0; k < 3; ++k) {
+      if (behind.vertex[k] == edge.to &&
+          behind.vertex[(k + 1) % 3] == edge.from) {
+        behind.neighbor[k] = id;
+      }
+    }
+  }
+  for (int id : created_) {
+    HullFace& current = faces_[id];
+    current.neighbor[1] = starts_[current.vertex[1]];
+    current.neighbor[2] = ends_[current.vertex[0]];
+  }
+
+  orphans_.clear();
+  for (int id : visible_) {
+    HullFace& current = faces_[id];
+    for (int other : current.outside) {
+      if (other != point) orphans_.push_back(other);
+    }
+    std::vector<int>().swap(current.outside);
+    current.alive = false;
+    current.visible = false;
+  }
+  Assign_(orphans_, created_);
+  for (int id : created_) {
+    if (!faces_[id].outside.empty()) pending_.push_back(id);
+  }
+}
+
+ConvexHull QuickHull::Flat_(int a, int b, const Vector3& normal) const {
+  const size_t count = coord_.size() / 3;
+  const Vector3 origin = At(coord_, a);
+  const Vector3 u = Normalized(Sub(At(coord_, b), origin));
+  const Vector3 v = Cross(normal, u);
+  std::vector<Point2> points(count);
+  for (size_t i = 0; i < count; ++i) {
+    const Vector3 p = Sub(At(coord_, i), origin);
+    points[i] = {Dot(p, u), Dot(p, v), static_cast<int>(i)};
+  }
+  std::vector<Point2> polygon;
+  ConvexPolygon(points, tolerance_, polygon);
+  ConvexHull hull;
+  for (size_t i = 0; i < polygon.size(); ++i) {
+    const Vector3 p = At(coord_, polygon[i].index);
+    hull.vertex_coord.insert(hull.vertex_coord.end(), p.begin(), p.end());
+    const Point2& next = polygon[(i + 1) % polygon.size()];
+    hull.area += 0.5 * (polygon[i].x * next.y - next.x * polygon[i].y);
+  }
+  return hull;
+}
+
+ConvexHull QuickHull::Collect_() const {
+  ConvexHull hull;
+  std::vector<int> remap(coord_.size() / 3, -1);
+  for (const HullFace& face : faces_) {
+    if (!face.alive) continue;
+    for (int vertex : face.vertex) {
+      if (remap[vertex] < 0) {
+        remap[vertex] = static_cast<int>(hull.GetVertexCount());
+        const Vector3 p = At(coord_, vertex);
+        hull.vertex_coord.insert(hull.vertex_coord.end(), p.begin(), p.end());
+      }
+      hull.triangles.push_back(remap[vertex]);
+    }
+  }
+  // Объём - сумма тетраэдров с общей вершиной оболочки
+  const Vector3 origin = At(hull.vertex_coord, 0);
+  for (size_t i = 0; i < hull.triangles.size(); i += 3) {
+    const Vector3 a = Sub(At(hull.vertex_coord, hull.triangles[i]), origin);
+    const Vector3 b =
+        Sub(At(hull.vertex_coord, hull.triangles[i + 1]), origin);
+    const Vector3 c =
+        Sub(At(hull.vertex_coord, hull.triangles[i + 2]), origin);
+    hull.area += 0.5 * Length(Cross(Sub(b, a), Sub(c, a)));
+    hull.volume += Dot(a, Cross(b, c)) / 6.0;
+  }
+  return hull;
+}
+
+ConvexHull QuickHull::Run() {
+  const size_t count = coord_.size() / 3;
+  ConvexHull hull;
+  if (count == 0) return hull;
+
+  // Крайние точки по осям задают масштаб допуска и первую пару
+  int extreme[6];
+  double scale = 0.0;
+  for (int axis = 0; axis < 3; ++axis) {
+    extreme[axis * 2] = static_cast<int>(ArgMax(
+        count, threads_, [&](size_t i) { return -coord_[i * 3 + axis]; }));
+    extreme[axis * 2 + 1] = static_cast<int>(ArgMax(
+        count, threads_, [&](size_t i) { return coord_[i * 3 + axis]; }));
+    scale += std::max(std::abs(coord_[extreme[axis * 2] * 3 + axis]),
+                      std::abs(coord_[extreme[axis * 2 + 1] * 3 + axis]));
+  }
+  tolerance_ = kHullTolerance * scale;
+
+  int a = extreme[0], b = extreme[0];
+  double widest = -1.0;
+  for (int i = 0; i < 6; ++i) {
+    for (int j = i + 1; j < 6; ++j) {
+      const Vector3 d = Sub(At(coord_, extreme[j]), At(coord_, extreme[i]));
+      if (Dot(d, d) > widest) {
+        widest = Dot(d, d);
+        a = extreme[i];
+        b = extreme[j];
+      }
+    }
+  }
+  if (std::sqrt(widest) <= tolerance_) {
+    const Vector3 p = At(coord_, a);
+    hull.vertex_coord.assign(p.begin(), p.end());
+    return hull;
+  }
+
+  const Vector3 origin = At(coord_, a);
+  const Vector3 direction = Normalized(Sub(At(coord_, b), origin));
+  int c = static_cast<int>(ArgMax(count, threads_, [&](size_t i) {
+    return Length(Cross(Sub(At(coord_, i), origin), direction));
+  }));
+  if (Length(Cross(Sub(At(coord_, c), origin), direction)) <= tolerance_) {
+    for (int end : {a, b}) {
+      const Vector3 p = At(coord_, end);
+      hull.vertex_coord.insert(hull.vertex_coord.end(), p.begin(), p.end());
+    }
+    return hull;
+  }
+
+  const Vector3 normal = Normalized(
+      Cross(Sub(At(coord_, b), origin), Sub(At(coord_, c), origin)));
+  const int d = static_cast<int>(ArgMax(count, threads_, [&](size_t i) {
+    return std::abs(Dot(Sub(At(coord_, i), origin), normal));
+  }));
+  const double height = Dot(Sub(At(coord_, d), origin), normal);
+  if (std::abs(height) <= tolerance_) return Flat_(a, b, normal);
+
+  // Тетраэдр: d под гранью (a, b, c), остальные грани согласованы с ней
+  if (height > 0.0) std::swap(b, c);
+  AddFace_(a, b, c);
+  AddFace_(b, a, d);
+  AddFace_(c, b, d);
+  AddFace_(a, c, d);
+  for (HullFace& face : faces_) {
+    for (int k = 0; k < 3; ++k) {
+      const int from = face.vertex[k], to = face.vertex[(k + 1) % 3];
+      for (int other = 0; other < 4; ++other) {
+        for (int j = 0; j < 3; ++j) {
+          if (faces_[other].vertex[j] == to &&
+              faces_[other].vertex[(j + 1) % 3] == from) {
+            face.neighbor[k] = other;
+          }
+        }
+      }
+    }
+  }
+
+  std::vector<int> points(count);
+  for (size_t i = 0; i < count; ++i) points[i] = static_cast<int>(i);
+  Assign_(points, {0, 1, 2, 3});
+  for (int face = 3; face >= 0; --face) {
+    if (!faces_[face].outside.empty()) pending_.push_back(face);
+  }
+  while (!pending_.empty()) {
+    const int face = pending_.back();
+    pending_.pop_back();
+    if (faces_[face].alive && !faces_[face].outside.empty()) AddPoint_(face);
+  }
+  return Collect_();
+}
+
+/**
+ * @brief Box с одной осью вдоль normal и стороны вдоль каждой оси
+ */
+struct BoxCandidate {
+  double cost = std::numeric_limits<double>::infinity();
+  Vector3 axis[3];
+  double low[3];
+  double high[3];
+};
+
+/**
+ * @brief Буферы проекции, свои у каждого потока
+ */
+struct BoxScratch {
+  std::vector<Point2> points;
+  std::vector<Point2> polygon;
+};
+
+/**
+ * @brief Наименьший box с осью normal
+ */
+BoxCandidate FitAlong(const std::vector<double>& coord, const Vector3& normal,
+                      double padding, BoxScratch& scratch) {
+  // Плоскость проекции: u перпендикулярно normal от наименее
+  // сонаправленной с ней оси координат
+  int least = 0;
+  for (int axis = 1; axis < 3; ++axis) {
+    if (std::abs(normal[axis]) < std::abs(normal[least])) least = axis;
+  }
+  Vector3 basis = {0.0, 0.0, 0.0};
+  basis[least] = 1.0;
+  const Vector3 u = Normalized(Cross(normal, basis));
+  const Vector3 v = Cross(normal, u);
+
+  BoxCandidate box;
+  box.low[2] = std::numeric_limits<double>::infinity();
+  box.high[2] = -std::numeric_limits<double>::infinity();
+  const size_t count = coord.size() / 3;
+  scratch.points.resize(count);
+  for (size_t i = 0; i < count; ++i) {
+    const Vector3 p = At(coord, i);
+    scratch.points[i] = {Dot(p, u), Dot(p, v), static_cast<int>(i)};
+    box.low[2] = std::min(box.low[2], Dot(p, normal));
+    box.high[2] = std::max(box.high[2], Dot(p, normal));
+  }
+  ConvexPolygon(scratch.points, 0.0, scratch.polygon);
+  const Rectangle rectangle = MinAreaRectangle(scratch.polygon, padding);
+  const double ex = rectangle.direction[0], ey = rectangle.direction[1];
+  for (int k = 0; k < 3; ++k) {
+    box.axis[0][k] = ex * u[k] + ey * v[k];
+    box.axis[1][k] = ex * v[k] - ey * u[k];
+  }
+  box.axis[2] = normal;
+  for (int side = 0; side < 2; ++side) {
+    box.low[side] = rectangle.low[side];
+    box.high[side] = rectangle.high[side];
+  }
+  box.cost = 1.0;
+  for (int side = 0; side < 3; ++side) {
+    box.cost *= box.high[side] - box.low[side] + padding;
+  }
+  return box;
+}
+
+/**
+ * @brief Собственные векторы симметричной матрицы 3x3 (вращения Якоби)
+ */
+void SymmetricEigenvectors(double a[3][3], Vector3 vectors[3]) {
+  double v[3][3] = {{1.0, 0.0, 0.0}, {0.0, 1.0, 0.0}, {0.0, 0.0, 1.0}};
+  for (int sweep = 0; sweep < 32; ++sweep) {
+    const double off = a[0][1] * a[0][1] + a[0][2] * a[0][2] +
+                       a[1][2] * a[1][2];
+    const double diagonal = a[0][0] * a[0][0] + a[1][1] * a[1][1] +
+                            a[2][2] * a[2][2];
+    if (off <= 1e-30 * diagonal) break;
+    for (int p = 0; p < 2; ++p) {
+      for (int q = p + 1; q < 3; ++q) {
+        if (a[p][q] == 0.0) continue;
+        const double theta = (a[q][q] - a[p][p]) / (2.0 * a[p][q]);
+        const double t = (theta >= 0.0 ? 1.0 : -1.0) /
+                         (std::abs(theta) + std::sqrt(theta * theta + 1.0));
+        const double c = 1.0 / std::sqrt(t * t + 1.0);
+        const double s = t * c;
+        for (int k = 0; k < 3; ++k) {
+          const double kp = a[k][p], kq = a[k][q];
+          a[k][p] = c * kp - s * kq;
+          a[k][q] = s * kp + c * kq;
+        }
+        for (int k = 0; k < 3; ++k) {
+          const double pk = a[p][k], qk = a[q][k];
+          a[p][k] = c * pk - s * qk;
+          a[q][k] = s * pk + c * qk;
+        }
+        for (int k = 0; k < 3; ++k) {
+          const double kp = v[k][p], kq = v[k][q];
+          v[k][p] = c * kp - s * kq;
+          v[k][q] = s * kp + c * kq;
+        }
+      }
+    }
+  }
+  for (int i = 0; i < 3; ++i) vectors[i] = {v[0][i], v[1][i], v[2][i]};
+}
+
+/**
+ * @brief Направления-кандидаты: большие грани, главные оси, оси координат
+ */
+std::vector<Vector3> BoxDirections(const ConvexHull& hull) {
+  std::vector<Vector3> directions;
+  const size_t triangles = hull.GetTriangleCount();
+  std::vector<std::pair<double, size_t>> by_area(triangles);
+  std::vector<Vector3> normals(triangles);
+  for (size_t i = 0; i < triangles; ++i) {
+    const Vector3 a = At(hull.vertex_coord, hull.triangles[i * 3]);
+    normals[i] =
+        Cross(Sub(At(hull.vertex_coord, hull.triangles[i * 3 + 1]), a),
+              Sub(At(hull.vertex_coord, hull.triangles[i * 3 + 2]), a));
+    by_area[i] = {-Length(normals[i]), i};
+  }
+  const size_t taken = std::min(
+      {triangles, kBoxCandidates, kBoxProjections / hull.GetVertexCount()});
+  std::partial_sort(by_area.begin(), by_area.begin() + taken, by_area.end());
+  for (size_t i = 0; i < taken; ++i) {
+    directions.push_back(Normalized(normals[by_area[i].second]));
+  }
+
+  const size_t count = hull.GetVertexCount();
+  Vector3 mean = {0.0, 0.0, 0.0};
+  for (size_t i = 0; i < count; ++i) {
+    for (int k = 0; k < 3; ++k) mean[k] += hull.vertex_coord[i * 3 + k];
+  }
+  for (double& value : mean) value /= double(count);
+  double covariance[3][3] = {};
+  for (size_t i = 0; i < count; ++i) {
+    const Vector3 d = Sub(At(hull.vertex_coord, i), mean);
+    for (int row = 0; row < 3; ++row) {
+      for (int column = 0; column < 3; ++column) {
+        covariance[row][column] += d[row] * d[column];
+      }
+    }
+  }
+  Vector3 principal[3];
+  SymmetricEigenvectors(covariance, principal);
+  directions.insert(directions.end(), principal, principal + 3);
+  directions.push_back({1.0, 0.0, 0.0});
+  directions.push_back({0.0, 1.0, 0.0});
+  directions.push_back({0.0, 0.0, 1.0});
+
+  // Параллельные грани (половинки четырёхугольников) дают тот же box
+  std::vector<Vector3> unique;
+  for (const Vector3& direction : directions) {
+    if (Length(direction) == 0.0) continue;
+    bool repeated = false;
+    for (const Vector3& other : unique) {
+      repeated = repeated || std::abs(Dot(direction, other)) > 1.0 - 1e-12;
+    }
+    if (!repeated) unique.push_back(direction);
+  }
+  return unique;
+}
+
+}  // namespace
+
+ConvexHull ComputeConvexHull(const std::vector<double>& vertex_coord,
+                             unsigned threads) {
+  S21_TRACE_SCOPE("ComputeConvexHull");
+  return QuickHull(vertex_coord, threads).Run();
+}
+
+OrientedBox ComputeOrientedBox(const ConvexHull& hull, unsigned threads) {
+  S21_TRACE_SCOPE("ComputeOrientedBox");
+  OrientedBox result;
+  if (hull.GetVertexCount() == 0) return result;
+
+  double diameter = 0.0;
+  for (int axis = 0; axis < 3; ++axis) {
+    double low = hull.vertex_coord[axis], high = low;
+    for (size_t i = 1; i < hull.GetVertexCount(); ++i) {
+      low = std::min(low, hull.vertex_coord[i * 3 + axis]);
+      high = std::max(high, hull.vertex_coord[i * 3 + axis]);
+    }
+    diameter += (high - low) * (high - low);
+  }
+  const double padding = kBoxPadding * std::sqrt(diameter);
+
+  const std::vector<Vector3> directions = BoxDirections(hull);
+  std::vector<BoxCandidate> candidates(directions.size());
+  std::vector<BoxScratch> scratch(std::max(threads, 1u));
+  ParallelFor(directions.size(), threads, [&](unsigned worker, size_t i) {
+    candidates[i] =
+        FitAlong(hull.vertex_coord, directions[i], padding, scratch[worker]);
+  });
+  BoxCandidate best;
+  for (const BoxCandidate& candidate : candidates) {
+    if (candidate.cost < best.cost) best = candidate;
+  }
+  // Стороны лучшего box как новые кандидаты
+  for (int round = 0; round < kBoxRefineRounds; ++round) {
+    const BoxCandidate current = best;
+    for (int side = 0; side < 2; ++side) {
+      const BoxCandidate candidate =
+          FitAlong(hull.vertex_coord, current.axis[side], padding, scratch[0]);
+      if (candidate.cost < best.cost * (1.0 - 1e-12)) best = candidate;
+    }
+    if (best.cost == current.cost) break;
+  }
+
+  // Оси по убыванию сторон, знаки - к положительной наибольшей компоненте
+  int order[3] = {0, 1, 2};
+  std::stable_sort(order, order + 3, [&best](int x, int y) {
+    return best.high[x] - best.low[x] > best.high[y] - best.low[y];
+  });
+  for (int side = 0; side < 3; ++side) {
+    const int from = order[side];
+    const double middle = (best.low[from] + best.high[from]) * 0.5;
+    result.half[side] = (best.high[from] - best.low[from]) * 0.5;
+    for (int k = 0; k < 3; ++k) {
+      result.center[k] += middle * best.axis[from][k];
+    }
+    Vector3 axis = best.axis[from];
+    int largest = 0;
+    for (int k = 1; k < 3; ++k) {
+      if (std::abs(axis[k]) > std::abs(axis[largest])) largest = k;
+    }
+    if (axis[largest] < 0.0) axis = {-axis[0], -axis[1], -axis[2]};
+    std::copy(axis.begin(), axis.end(), result.axis[side]);
+  }
+  const Vector3 first = {result.axis[0][0], result.axis[0][1],
+                         result.axis[0][2]};
+  const Vector3 second = {result.axis[1][0], result.axis[1][1],
+                          result.axis[1][2]};
+  const Vector3 third = Cross(first, second);
+  std::copy(third.begin(), third.end(), result.axis[2]);
+  return result;
+}
+
+}  // namespace s21
@@ -0,0 +1,92 @@
+#ifndef MODEL_HULL_H
+#define MODEL_HULL_H
+
+/**
+ * @file hull.h
+ * @brief Выпуклая оболочка и ориентированный box облака вершин
+ */
+
+#include <cstddef>
+#include <vector>
+
+namespace s21 {
+
+/**
+ * @brief Выпуклая оболочка вершин
+ *
+ * Треугольники обходятся против часовой стрелки при взгляде снаружи.
+ * Если все точки лежат в одной плоскости, треугольников нет, а
+ * vertex_coord - вершины выпуклого многоугольника по порядку обхода;
+ * для точек на одной прямой - два конца отрезка.
+ */
+struct ConvexHull {
+  std::vector<double> vertex_coord;  ///< Вершины оболочки x, y, z подряд
+  std::vector<int> triangles;        ///< Индексы вершин граней по три
+  double area = 0.0;                 ///< Площадь поверхности
+  double volume = 0.0;               ///< Объём
+
+  size_t GetVertexCount() const noexcept { return vertex_coord.size() / 3; }
+  size_t GetTriangleCount() const noexcept { return triangles.size() / 3; }
+};
+
+/**
+ * @brief Ориентированный box
+ *
+ * Оси единичные, взаимно перпендикулярные и образуют правую тройку;
+ * упорядочены по убыванию полуразмеров: axis[0] - самая длинная сторона,
+ * axis[2] - самая короткая.
+ */
+struct OrientedBox {
+  double center[3] = {0.0, 0.0, 0.0};  ///< Центр
+  double axis[3][3] = {{1.0, 0.0, 0.0}, {0.0, 1.0, 0.0}, {0.0, 0.0, 1.0}};
+  double half[3] = {0.0, 0.0, 0.0};  ///< Полуразмеры вдоль осей
+
+  double GetVolume() const noexcept {
+    return 8.0 * half[0] * half[1] * half[2];
+  }
+};
+
+constexpr size_t kBoxCandidates = 256;  ///< Наибольшее число граней для box
+constexpr size_t kBoxProjections = size_t(1) << 22;  ///< Проекций вершин
+
+/**
+ * @brief Строит выпуклую оболочку алгоритмом quickhull
+ *
+ * Крайние точки начального тетраэдра и раздача точек по внешним
+ * множествам его граней идут параллельно по кускам постоянного размера;
+ * внутренние точки тетраэдра отбрасываются сразу. Дальше оболочка
+ * растёт от самой дальней точки грани; точки видимых граней
+ * перераздаются новым граням, большие наборы - тоже параллельно.
+ * Точки ближе допуска к плоскости грани считаются лежащими на ней.
+ * Итог не зависит от числа потоков.
+ *
+ * @param vertex_coord Координаты вершин x, y, z подряд
+ * @param threads Число потоков
+ */
+ConvexHull ComputeConvexHull(const std::vector<double>& vertex_coord,
+                             unsigned threads = 1);
+
+/**
+ * @brief Ориентированный box наименьшего объёма вокруг оболочки
+ *
+ * Точный минимум (O'Rourke) требует кубического времени, поэтому
+ * перебираются направления-кандидаты для одной из осей: нормали самых
+ * больших граней оболочки, главные оси разброса вершин и оси координат.
+ * Граней берётся не больше kBoxCandidates и не больше, чем помещается
+ * в kBoxProjections проекций вершин: у оболочек из миллиона вершин
+ * остаются в основном главные оси. Для каждого направления вершины
+ * проецируются на перпендикулярную плоскость, и вращающимися
+ * калиперами ищется прямоугольник наименьшей площади. Лучший box
+ * уточняется, пока его собственные оси как кандидаты уменьшают объём.
+ * Box не больше осевого и совпадает с минимальным для многогранников,
+ * у которых он прилегает к грани. Плоская оболочка даёт box нулевой толщины с
+ * прямоугольником наименьшей площади.
+ *
+ * @param hull Оболочка из ComputeConvexHull
+ * @param threads Число потоков (кандидаты проверяются параллельно)
+ */
+OrientedBox ComputeOrientedBox(const ConvexHull& hull, unsigned threads = 1);
+
+}  // namespace s21
+
+#endif  // MODEL_HULL_H
@@ -0,0 +1,92 @@
+#ifndef MODEL_MESH_H
+#define MODEL_MESH_H
+
+/**
+ * @file mesh.h
+ * @brief Геометрические данные загруженной модели
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace s21 {
+
+/**
+ * @brief Коды ошибок для операций с моделью
+ */
+enum error_list {
+  kNoError = 0,  ///< Операция выполнена успешно
+  kFileWrongExtension = 1,  ///< Неверное расширение файла
+  kFailedToOpen = 2,        ///< Не удалось открыть файл
+  kIncorrectData = 3,  ///< Некорректные данные в файле
+  kFailedToWrite = 4,  ///< Не удалось записать файл
+  kIndexOutOfRange = 5,  ///< Грань ссылается на несуществующую вершину
+};
+
+/**
+ * @brief Сетка модели: вершины, рёбра и грани
+ *
+ * Рёбра хранятся парами индексов в том виде, в котором их рисует
+ * OpenGLWidget: сначала рёбра граней (каждая грань даёт замкнутый
+ * контур, 2 * face_index.size() индексов), за ними отрезки ломаных
+ * OBJ (l), у которых граней нет. Грани хранятся компактно: индексы
+ * вершин всех граней подряд в face_index и смещения начала каждой
+ * грани в face_offset (размер граней + 1).
+ * В сетке из ObjParser все индексы лежат в [0, GetVertexCount()).
+ *
+ * @example
+ * @code
+ * for (size_t f = 0; f < mesh.GetFaceCount(); ++f) {
+ *   for (int i = mesh.face_offset[f]; i < mesh.face_offset[f + 1]; ++i) {
+ *     int vertex = mesh.face_index[i];
+ *   }
+ * }
+ * @endcode
+ */
+struct Mesh {
+  std::vector<double> vertex_coord;  ///< Координаты вершин (x,y,z,...)
+  std::vector<int> vertex_index;     ///< Индексы рёбер (парами)
+  std::vector<int> face_index;       ///< Индексы вершин граней подряд
+  std::vector<int> face_offset{0};   ///< Начала граней в face_index
+
+  /**
+   * @brief Возвращает количество вершин
+   */
+  size_t GetVertexCount() const noexcept { return vertex_coord.size() / 3; }
+
+  /**
+   * @brief Возвращает количество рёбер
+   */
+  size_t GetEdgeCount() const noexcept { return vertex_index.size() / 2; }
+
+  /**
+   * @brief Возвращает количество граней
+   */
+  size_t GetFaceCount() const noexcept {
+    return face_offset.empty() ? 0 : face_offset.size() - 1;
+  }
+
+  /**
+   * @brief Возвращает начало отрезков ломаных в vertex_index
+   *
+   * У сеток, собранных без рёбер граней, ломаных нет.
+   */
+  size_t GetPolylineBegin() const noexcept {
+    return std::min(vertex_index.size(), face_index.size() * 2);
+  }
+
+  /**
+   * @brief Удаляет все данные, сохраняя выделенную память
+   */
+  void Clear() noexcept {
+    vertex_coord.clear();
+    vertex_index.clear();
+    face_index.clear();
+    face_offset.assign(1, 0);
+  }
+};
+
+}  // namespace s21
+
+#endif  // MODEL_MESH_H
@@ -0,0 +1,540 @@
+/**
+ * @file mesh_tools.cpp
+ * @brief Реализация операций над сеткой
+ */
+
+#include "mesh_tools.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../profiling/trace.h"
+#include "parallel.h"
+
+namespace s21 {
+
+namespace {
+
+/**
+ * @brief Ключ ячейки пространственной сетки
+ */
+struct CellKey {
+  int64_t x, y, z;
+
+  bool operator==(const CellKey& other) const noexcept {
+    return x == other.x && y == other.y && z == other.z;
+  }
+};
+
+struct CellKeyHash {
+  size_t operator()(const CellKey& key) const noexcept {
+    uint64_t hash = static_cast<uint64_t>(key.x) * 0x9E3779B97F4A7C15ULL;
+    hash ^= static_cast<uint64_t>(key.y) + 0x7F4A7C159E3779B9ULL +
+            (hash << 6) + (hash >> 2);
+    hash ^= static_cast<uint64_t>(key.z) + 0x94D049BB133111EBULL +
+            (hash << 6) + (hash >> 2);
+    return static_cast<size_t>(hash);
+  }
+};
+
+/**
+ * @brief Ключ точного совпадения: битовое представление координат
+ */
+CellKey ExactKey(const double* point) noexcept {
+  CellKey key{};
+  // -0.0 и 0.0 должны совпадать
+  const double x = point[0] + 0.0, y = point[1] + 0.0, z = point[2] + 0.0;
+  std::memcpy(&key.x, &x, sizeof(double));
+  std::memcpy(&key.y, &y, sizeof(double));
+  std::memcpy(&key.z, &z, sizeof(double));
+  return key;
+}
+
+/**
+ * @brief Вычисляет отображение вершин на сваренные вершины
+ * @return Новый индекс для каждой исходной вершины
+ */
+std::vector<int> BuildWeldMap(const Mesh& mesh, double tolerance,
+                              size_t& unique_count) {
+  const size_t count = mesh.GetVertexCount();
+  const double* coord = mesh.vertex_coord.data();
+  std::vector<int> remap(count);
+  unique_count = 0;
+
+  if (tolerance <= 0.0) {
+    std::unordered_map<CellKey, int, CellKeyHash> seen;
+    seen.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+      auto [it, inserted] = seen.emplace(ExactKey(coord + i * 3),
+                                         static_cast<int>(unique_count));
+      if (inserted) ++unique_count;
+      remap[i] = it->second;
+    }
+    return remap;
+  }
+
+  // Ячейка размером tolerance: кандидаты на слияние лежат в соседних 27
+  std::unordered_multimap<CellKey, size_t, CellKeyHash> cells;
+  cells.reserve(count);
+  std::vector<int> unique_index(count, -1);
+  const double tolerance_sq = tolerance * tolerance;
+
+  for (size_t i = 0; i < count; ++i) {
+    const double* point = coord + i * 3;
+    const CellKey cell{static_cast<int64_t>(std::floor(point[0] / tolerance)),
+                       static_cast<int64_t>(std::floor(point[1] / tolerance)),
+                       static_cast<int64_t>(std::floor(point[2] / tolerance))};
+
+    size_t best = count;
+    for (int64_t dx = -1; dx <= 1; ++dx) {
+      for (int64_t dy = -1; dy <= 1; ++dy) {
+        for (int64_t dz = -1; dz <= 1; ++dz) {
+          auto range =
+              cells.equal_range({cell.x + dx, cell.y + dy, cell.z + dz});
+          for (auto it = range.first; it != range.second; ++it) {
+            const double* other = coord + it->second * 3;
+            const double ddx = point[0] - other[0];
+            const double ddy = point[1] - other[1];
+            const double ddz = point[2] - other[2];
+            if (ddx * ddx + ddy * ddy + ddz * ddz <= tolerance_sq &&
+                it->second < best) {
+              best = it->second;
+            }
+          }
+        }
+      }
+    }
+
+    if (best == count) {
+      unique_index[i] = static_cast<int>(unique_count++);
+      cells.emplace(cell, i);
+      remap[i] = unique_index[i];
+    } else {
+      remap[i] = unique_index[best];
+    }
+  }
+  return remap;
+}
+
+constexpr size_t kReportChunk = 4096;  ///< Элементов на задачу отчёта
+
+/**
+ * @brief Частичные итоги куска вершин
+ */
+struct VertexPartial {
+  double min[3] = {0.0, 0.0, 0.0};
+  double max[3] = {0.0, 0.0, 0.0};
+  double sum[3] = {0.0, 0.0, 0.0};
+  bool empty = true;
+};
+
+/**
+ * @brief Частичные итоги куска рёбер
+ */
+struct EdgePartial {
+  double min = 0.0;
+  double max = 0.0;
+  double sum = 0.0;
+  size_t measured = 0;    ///< Невырожденных рёбер
+  size_t degenerate = 0;  ///< Рёбер нулевой длины
+  size_t distinct = 0;    ///< Верных рёбер с разными вершинами
+};
+
+/**
+ * @brief Частичные итоги куска граней
+ */
+struct FacePartial {
+  size_t arity[MeshReport::kArityBins] = {};
+  double area = 0.0;
+};
+
+/**
+ * @brief Длина ребра i; false - индекс вершины вне диапазона
+ */
+bool EdgeLength(const Mesh& mesh, size_t i, int vertices, double& length) {
+  const int a = mesh.vertex_index[i], b = mesh.vertex_index[i + 1];
+  if (a < 0 || b < 0 || a >= vertices || b >= vertices) return false;
+  const double* p = &mesh.vertex_coord[size_t(a) * 3];
+  const double* q = &mesh.vertex_coord[size_t(b) * 3];
+  const double dx = q[0] - p[0], dy = q[1] - p[1], dz = q[2] - p[2];
+  length = std::sqrt(dx * dx + dy * dy + dz * dz);
+  return true;
+}
+
+/**
+ * @brief Сортировка вставками: в корзине вершины единицы записей
+ */
+void SortBucket(uint32_t* first, uint32_t* last) {
+  for (uint32_t* i = first + 1; i < last; ++i) {
+    const uint32_t value = *i;
+    uint32_t* j = i;
+    for (; j > first && *(j - 1) > value; --j) *j = *(j - 1);
+    *j = value;
+  }
+}
+
+}  // namespace
+
+size_t WeldVertices(Mesh& mesh, double tolerance) {
+  S21_TRACE_SCOPE("WeldVertices");
+
+  const size_t count = mesh.GetVertexCount();
+  size_t unique_count = 0;
+  const std::vector<int> remap = BuildWeldMap(mesh, tolerance, unique_count);
+  if (unique_count == count) {
+    return 0;
+  }
+
+  // Первая вершина группы остаётся на месте, порядок сохраняется
+  std::vector<double> coord(unique_count * 3);
+  for (size_t i = count; i-- > 0;) {
+    std::copy_n(mesh.vertex_coord.begin() + i * 3, 3,
+                coord.begin() + remap[i] * 3);
+  }
+  mesh.vertex_coord = std::move(coord);
+
+  std::vector<int> face_index;
+  std::vector<int> face_offset{0};
+  std::vector<int> vertex_index;
+  face_index.reserve(mesh.face_index.size());
+  vertex_index.reserve(mesh.vertex_index.size());
+
+  for (size_t f = 0; f < mesh.GetFaceCount(); ++f) {
+    const size_t begin = face_index.size();
+    const int original_size = mesh.face_offset[f + 1] - mesh.face_offset[f];
+    for (int i = mesh.face_offset[f]; i < mesh.face_offset[f + 1]; ++i) {
+      const int vertex = mesh.face_index[i] < static_cast<int>(count)
+                             ? remap[mesh.face_index[i]]
+                             : mesh.face_index[i];
+      if (face_index.size() == begin || face_index.back() != vertex) {
+        face_index.push_back(vertex);
+      }
+    }
+    while (face_index.size() - begin > 1 &&
+           face_index.back() == face_index[begin]) {
+      face_index.pop_back();
+    }
+
+    const size_t size = face_index.size() - begin;
+    if (size < 2 || (size < 3 && original_size >= 3)) {
+      face_index.resize(begin);
+      continue;
+    }
+    for (size_t i = 0; i < size; ++i) {
+      vertex_index.push_back(face_index[begin + i]);
+      vertex_index.push_back(face_index[begin + (i + 1) % size]);
+    }
+    face_offset.push_back(static_cast<int>(face_index.size()));
+  }
+
+  // Отрезки ломаных переносятся по одному, вырожденные выпадают
+  for (size_t i = mesh.GetPolylineBegin(); i + 1 < mesh.vertex_index.size();
+       i += 2) {
+    int a = mesh.vertex_index[i], b = mesh.vertex_index[i + 1];
+    if (a < static_cast<int>(count)) a = remap[a];
+    if (b < static_cast<int>(count)) b = remap[b];
+    if (a != b) vertex_index.insert(vertex_index.end(), {a, b});
+  }
+
+  mesh.face_index = std::move(face_index);
+  mesh.face_offset = std::move(face_offset);
+  mesh.vertex_index = std::move(vertex_index);
+  return count - unique_count;
+}
+
+MeshStats ComputeMeshStats(const Mesh& mesh) {
+  MeshStats stats;
+  stats.vertex_count = mesh.GetVertexCount();
+  stats.edge_count = mesh.GetEdgeCount();
+  stats.face_count = mesh.GetFaceCount();
+
+  for (size_t i = 0; i < stats.vertex_count; ++i) {
+    for (int axis = 0; axis < 3; ++axis) {
+      const double value = mesh.vertex_coord[i * 3 + axis];
+      if (i == 0 || value < stats.min[axis]) stats.min[axis] = value;
+      if (i == 0 || value > stats.max[axis]) stats.max[axis] = value;
+    }
+  }
+
+  std::vector<uint64_t> edges;
+  edges.reserve(stats.edge_count);
+  for (size_t i = 0; i + 1 < mesh.vertex_index.size(); i += 2) {
+    const auto [a, b] =
+        std::minmax(mesh.vertex_index[i], mesh.vertex_index[i + 1]);
+    edges.push_back((static_cast<uint64_t>(static_cast<uint32_t>(a)) << 32) |
+                    static_cast<uint32_t>(b));
+  }
+  std::sort(edges.begin(), edges.end());
+  stats.unique_edge_count = static_cast<size_t>(
+      std::unique(edges.begin(), edges.end()) - edges.begin());
+
+  return stats;
+}
+
+MeshReport ComputeMeshReport(const Mesh& mesh, unsigned threads) {
+  S21_TRACE_SCOPE("ComputeMeshReport");
+  MeshReport report;
+  const size_t vertex_count = mesh.GetVertexCount();
+  const size_t edge_count = mesh.vertex_index.size() / 2;
+  const size_t face_count = mesh.GetFaceCount();
+  const int vertices = static_cast<int>(vertex_count);
+  report.vertex_count = vertex_count;
+  report.edge_count = edge_count;
+  report.face_count = face_count;
+  auto chunks = [](size_t count) {
+    return (count + kReportChunk - 1) / kReportChunk;
+  };
+  const size_t vertex_chunks = chunks(vertex_count);
+  const size_t edge_chunks = chunks(edge_count);
+  const size_t face_chunks = chunks(face_count);
+
+  // 1. Box и сумма координат
+  std::vector<VertexPartial> vertex_parts(vertex_chunks);
+  ParallelFor(vertex_chunks, threads, [&](unsigned, size_t chunk) {
+    VertexPartial& part = vertex_parts[chunk];
+    const size_t to = std::min(vertex_count, (chunk + 1) * kReportChunk);
+    for (size_t i = chunk * kReportChunk; i < to; ++i) {
+      const double* p = &mesh.vertex_coord[i * 3];
+      for (int axis = 0; axis < 3; ++axis) {
+        if (part.empty || p[axis] < part.min[axis]) part.min[axis] = p[axis];
+        if (part.empty || p[axis] > part.max[axis]) part.max[axis] = p[axis];
+        part.sum[axis] += p[axis];
+      }
+      part.empty = false;
+    }
+  });
+  double sum[3] = {0.0, 0.0, 0.0};
+  for (size_t chunk = 0; chunk < vertex_chunks; ++chunk) {
+    const VertexPartial& part = vertex_parts[chunk];
+    for (int axis = 0; axis < 3; ++axis) {
+      if (chunk == 0 || part.min[axis] < report.min[axis]) {
+        report.min[axis] = part.min[axis];
+      }
+      if (chunk == 0 || part.max[axis] > report.max[axis]) {
+        report.max[axis] = part.max[axis];
+      }
+      sum[axis] += part.sum[axis];
+    }
+  }
+  for (int axis = 0; axis < 3 && vertex_count > 0; ++axis) {
+    report.centroid[axis] = sum[axis] / double(vertex_count);
+  }
+
+  // 2. Длины рёбер; рёбра с разными вершинами считаются по корзинам
+  // меньшей вершины
+  std::vector<EdgePartial> edge_parts(edge_chunks);
+  std::vector<std::atomic<uint32_t>> bucket(vertex_count);
+  ParallelFor(edge_chunks, threads, [&](unsigned, size_t chunk) {
+    EdgePartial& part = edge_parts[chunk];
+    const size_t to = std::min(edge_count, (chunk + 1) * kReportChunk);
+    for (size_t edge = chunk * kReportChunk; edge < to; ++edge) {
+      double length = 0.0;
+      if (!EdgeLength(mesh, edge * 2, vertices, length)) continue;
+      const int a = mesh.vertex_index[edge * 2];
+      const int b = mesh.vertex_index[edge * 2 + 1];
+      if (a != b) {
+        ++part.distinct;
+        bucket[std::min(a, b)].fetch_add(1, std::memory_order_relaxed);
+      }
+      if (length == 0.0) {
+        ++part.degenerate;
+        continue;
+      }
+      if (part.measured == 0 || length < part.min) part.min = length;
+      if (part.measured == 0 || length > part.max) part.max = length;
+      part.sum += length;
+      ++part.measured;
+    }
+  });
+  size_t measured = 0, distinct = 0;
+  double length_sum = 0.0;
+  for (const EdgePartial& part : edge_parts) {
+    if (part.measured > 0) {
+      if (measured == 0 || part.min < report.edge_min) {
+        report.edge_min = part.min;
+      }
+      if (measured == 0 || part.max > report.edge_max) {
+        report.edge_max = part.max;
+      }
+    }
+    measured += part.measured;
+    length_sum += part.sum;
+    distinct += part.distinct;
+    report.degenerate_edge_count += part.degenerate;
+  }
+  if (measured > 0) report.edge_mean = length_sum / double(measured);
+
+  // 3. Префиксная сумма по кускам вершин: bucket[v] - начало корзины
+  std::vector<uint32_t> chunk_start(vertex_chunks + 1, 0);
+  ParallelFor(vertex_chunks, threads, [&](unsigned, size_t chunk) {
+    const size_t to = std::min(vertex_count, (chunk + 1) * kReportChunk);
+    uint32_t total = 0;
+    for (size_t v = chunk * kReportChunk; v < to; ++v) {
+      total += bucket[v].load(std::memory_order_relaxed);
+    }
+    chunk_start[chunk + 1] = total;
+  });
+  for (size_t chunk = 0; chunk < vertex_chunks; ++chunk) {
+    chunk_start[chunk + 1] += chunk_start[chunk];
+  }
+  ParallelFor(vertex_chunks, threads, [&](unsigned, size_t chunk) {
+    const size_t to = std::min(vertex_count, (chunk + 1) * kReportChunk);
+    uint32_t total = chunk_start[chunk];
+    for (size_t v = chunk * kReportChunk; v < to; ++v) {
+      total += bucket[v].exchange(total, std::memory_order_relaxed);
+    }
+  });
+
+  // 4. Гистограмма по найденным пределам и раскладка большей вершины
+  // по корзинам. После неё bucket[v] - конец корзины v
+  constexpr int kBins = MeshReport::kEdgeBins;
+  const double range = report.edge_max - report.edge_min;
+  const double scale = range > 0.0 ? kBins / range : 0.0;
+  std::vector<uint32_t> entries(distinct);
+  std::vector<std::array<size_t, kBins>> histograms(edge_chunks);
+  ParallelFor(edge_chunks, threads, [&](unsigned, size_t chunk) {
+    std::array<size_t, kBins>& histogram = histograms[chunk];
+    histogram.fill(0);
+    const size_t to = std::min(edge_count, (chunk + 1) * kReportChunk);
+    for (size_t edge = chunk * kReportChunk; edge < to; ++edge) {
+      double length = 0.0;
+      if (!EdgeLength(mesh, edge * 2, vertices, length)) continue;
+      const int a = mesh.vertex_index[edge * 2];
+      const int b = mesh.vertex_index[edge * 2 + 1];
+      if (a != b) {
+        const uint32_t slot = bucket[std::min(a, b)].fetch_add(
+            1, std::memory_order_relaxed);
+        entries[slot] = uint32_t(std::max(a, b));
+      }
+      if (length == 0.0) continue;
+      const int bin = static_cast<int>((length - report.edge_min) * scale);
+      ++histogram[std::min(bin, kBins - 1)];
+    }
+  });
+  for (const std::array<size_t, kBins>& histogram : histograms) {
+    for (int bin = 0; bin < kBins; ++bin) {
+      report.edge_histogram[bin] += histogram[bin];
+    }
+  }
+
+  // 5. Различные рёбра: различные большие вершины в каждой корзине
+  std::vector<size_t> unique(vertex_chunks, 0);
+  ParallelFor(vertex_chunks, threads, [&](unsigned, size_t chunk) {
+    const size_t to = std::min(vertex_count, (chunk + 1) * kReportChunk);
+    for (size_t v = chunk * kReportChunk; v < to; ++v) {
+      uint32_t* first =
+          entries.data() +
+          (v > 0 ? bucket[v - 1].load(std::memory_order_relaxed) : 0);
+      uint32_t* last =
+          entries.data() + bucket[v].load(std::memory_order_relaxed);
+      SortBucket(first, last);
+      for (uint32_t* i = first; i != last; ++i) {
+        unique[chunk] += i == first || *i != *(i - 1);
+      }
+    }
+  });
+  for (size_t count : unique) report.unique_edge_count += count;
+  report.duplicate_edge_count = distinct - report.unique_edge_count;
+
+  // 6. Число вершин граней и площадь: половина длины векторной площади,
+  // вершины берутся относительно первой ради точности
+  std::vector<FacePartial> face_parts(face_chunks);
+  ParallelFor(face_chunks, threads, [&](unsigned, size_t chunk) {
+    FacePartial& part = face_parts[chunk];
+    const size_t to = std::min(face_count, (chunk + 1) * kReportChunk);
+    for (size_t face = chunk * kReportChunk; face < to; ++face) {
+      const int begin = mesh.face_offset[face];
+      const int end = mesh.face_offset[face + 1];
+      ++part.arity[std::min(end - begin, MeshReport::kArityBins - 1)];
+      bool valid = end - begin >= 3;
+      for (int i = begin; i < end && valid; ++i) {
+        valid = mesh.face_index[i] >= 0 && mesh.face_index[i] < vertices;
+      }
+      if (!valid) continue;
+      const double* o = &mesh.vertex_coord[size_t(mesh.face_index[begin]) * 3];
+      double normal[3] = {0.0, 0.0, 0.0};
+      for (int i = begin + 1; i + 1 < end; ++i) {
+        const double* p = &mesh.vertex_coord[size_t(mesh.face_index[i]) * 3];
+        const double* q =
+            &mesh.vertex_coord[size_t(mesh.face_index[i + 1]) * 3];
+        const double u[3] = {p[0] - o[0], p[1] - o[1], p[2] - o[2]};
+        const double w[3] = {q[0] - o[0], q[1] - o[1], q[2] - o[2]};
+        normal[0] += u[1] * w[2] - u[2] * w[1];
+        normal[1] += u[2] * w[0] - u[0] * w[2];
+        normal[2] += u[0] * w[1] - u[1] * w[0];
+      }
+      part.area += 0.5 * std::sqrt(normal[0] * normal[0] +
+                                   normal[1] * normal[1] +
+                                   normal[2] * normal[2]);
+    }
+  });
+  for (const FacePartial& part : face_parts) {
+    for (int bin = 0; bin < MeshReport::kArityBins; ++bin) {
+      report.face_arity[bin] += part.arity[bin];
+    }
+    report.surface_area += part.area;
+  }
+  return report;
+}
+
+int ExportObj(const Mesh& mesh, const std::string& file_name) {
+  S21_TRACE_SCOPE("ExportObj");
+
+  std::string data;
+  data.reserve(mesh.vertex_coord.size() * 12 + mesh.face_index.size() * 8);
+  char buffer[32];
+
+  for (size_t i = 0; i < mesh.vertex_coord.size(); ++i) {
+    data += i % 3 == 0 ? "v " : " ";
+    const auto result = std::to_chars(buffer, buffer + sizeof(buffer),
+                                      mesh.vertex_coord[i]);
+    data.append(buffer, result.ptr);
+    if (i % 3 == 2) data += '\n';
+  }
+
+  for (size_t f = 0; f < mesh.GetFaceCount(); ++f) {
+    data += 'f';
+    for (int i = mesh.face_offset[f]; i < mesh.face_offset[f + 1]; ++i) {
+      const auto result = std::to_chars(buffer, buffer + sizeof(buffer),
+                                        mesh.face_index[i] + 1);
+      data += ' ';
+      data.append(buffer, result.ptr);
+    }
+    data += '\n';
+  }
+
+  // Соседние отрезки с общей вершиной собираются обратно в ломаные
+  const size_t polyline_begin = mesh.GetPolylineBegin();
+  for (size_t i = polyline_begin; i + 1 < mesh.vertex_index.size(); i += 2) {
+    const bool chained = i > polyline_begin &&
+                         mesh.vertex_index[i] == mesh.vertex_index[i - 1];
+    if (!chained) {
+      if (i > polyline_begin) data += '\n';
+      data += 'l';
+      const auto result = std::to_chars(buffer, buffer + sizeof(buffer),
+                                        mesh.vertex_index[i] + 1);
+      data += ' ';
+      data.append(buffer, result.ptr);
+    }
+    const auto result = std::to_chars(buffer, buffer + sizeof(buffer),
+                                      mesh.vertex_index[i + 1] + 1);
+    data += ' ';
+    data.append(buffer, result.ptr);
+  }
+  if (polyline_begin + 1 < mesh.vertex_index.size()) data += '\n';
+
+  std::ofstream file(file_name, std::ios::binary);
+  file.write(data.data(), static_cast<std::streamsize>(data.size()));
+  return file ? kNoError : kFailedToWrite;
+}
+
+}  // namespace s21
@@ -0,0 +1,108 @@
+#ifndef MODEL_MESH_TOOLS_H
+#define MODEL_MESH_TOOLS_H
+
+/**
+ * @file mesh_tools.h
+ * @brief Операции над сеткой: сварка вершин, статистика, отчёт, экспорт
+ */
+
+#include <string>
+
+#include "mesh.h"
+
+namespace s21 {
+
+/**
+ * @brief Сводная статистика сетки
+ */
+struct MeshStats {
+  size_t vertex_count = 0;       ///< Количество вершин
+  size_t edge_count = 0;         ///< Количество рёбер (как рисуются)
+  size_t unique_edge_count = 0;  ///< Количество различных рёбер
+  size_t face_count = 0;         ///< Количество граней
+  double min[3] = {0.0, 0.0, 0.0};  ///< Минимум ограничивающего box
+  double max[3] = {0.0, 0.0, 0.0};  ///< Максимум ограничивающего box
+};
+
+/**
+ * @brief Подробный отчёт о сетке для панели статистики
+ *
+ * Длины, гистограмма и повторы считаются по буферу рёбер vertex_index
+ * (как рисуется: общее ребро двух граней входит в него дважды). Рёбра
+ * с индексом вне диапазона вершин пропускаются.
+ */
+struct MeshReport {
+  static constexpr int kEdgeBins = 16;  ///< Интервалов гистограммы длин
+  static constexpr int kArityBins = 8;  ///< Последний - 7 вершин и больше
+
+  size_t vertex_count = 0;           ///< Вершин
+  size_t edge_count = 0;             ///< Рёбер в буфере
+  size_t unique_edge_count = 0;      ///< Различных рёбер (a != b)
+  size_t duplicate_edge_count = 0;   ///< Повторов различных рёбер
+  size_t degenerate_edge_count = 0;  ///< Рёбер нулевой длины
+  size_t face_count = 0;             ///< Граней
+  double min[3] = {0.0, 0.0, 0.0};       ///< Минимум box
+  double max[3] = {0.0, 0.0, 0.0};       ///< Максимум box
+  double centroid[3] = {0.0, 0.0, 0.0};  ///< Среднее вершин
+  double edge_min = 0.0;   ///< Кратчайшее невырожденное ребро
+  double edge_max = 0.0;   ///< Длиннейшее ребро
+  double edge_mean = 0.0;  ///< Средняя длина невырожденных рёбер
+  /// Невырожденные рёбра по равным интервалам [edge_min, edge_max]
+  size_t edge_histogram[kEdgeBins] = {};
+  size_t face_arity[kArityBins] = {};  ///< Граней по числу вершин
+  double surface_area = 0.0;  ///< Площадь (векторная площадь граней)
+};
+
+/**
+ * @brief Сваривает совпадающие вершины
+ *
+ * Вершины на расстоянии не больше tolerance объединяются в первую по
+ * порядку; при tolerance = 0 объединяются только точные совпадения.
+ * Индексы граней переназначаются, вырожденные грани удаляются, рёбра
+ * перестраиваются из граней так же, как при разборе файла. Отрезки
+ * ломаных переназначаются, вырожденные удаляются.
+ *
+ * @param mesh Сетка для обработки
+ * @param tolerance Допуск расстояния между вершинами
+ * @return Количество удалённых вершин
+ */
+size_t WeldVertices(Mesh& mesh, double tolerance = 0.0);
+
+/**
+ * @brief Считает статистику сетки
+ */
+MeshStats ComputeMeshStats(const Mesh& mesh);
+
+/**
+ * @brief Строит подробный отчёт параллельными свёртками
+ *
+ * Каждая метрика - проход по массиву кусками с частичными итогами на
+ * кусок, которые складываются по порядку кусков: результат побитово
+ * не зависит от числа потоков. Вершины читаются один раз (box и
+ * центр), рёбра - дважды (длины, затем гистограмма по найденным
+ * пределам), грани - один раз (число вершин и площадь). Повторы рёбер
+ * считаются без сортировки всего буфера: рёбра раскладываются по
+ * корзинам меньшей вершины, как в Topology.
+ *
+ * @param mesh Сетка
+ * @param threads Число потоков
+ */
+MeshReport ComputeMeshReport(const Mesh& mesh, unsigned threads = 1);
+
+/**
+ * @brief Сохраняет сетку в OBJ файл
+ *
+ * Координаты записываются кратчайшим точным представлением, поэтому
+ * повторная загрузка файла восстанавливает их побитово (если не
+ * срабатывает нормализация). Отрезки ломаных, идущие цепочкой,
+ * записываются одной строкой l.
+ *
+ * @param mesh Сохраняемая сетка
+ * @param file_name Путь к выходному файлу
+ * @return kNoError или kFailedToWrite
+ */
+int ExportObj(const Mesh& mesh, const std::string& file_name);
+
+}  // namespace s21
+
+#endif  // MODEL_MESH_TOOLS_H
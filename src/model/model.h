@@ -6,33 +6,25 @@
  * @brief Модель данных для 3D Viewer приложения
  */
 
-#include <fstream>
-#include <sstream>
 #include <string>
 #include <vector>
 
+#include "mesh.h"
+#include "obj_parser.h"
 #include "tranformation.h"
 
 namespace s21 {
 
-/**
- * @brief Коды ошибок для операций с моделью
- */
-enum error_list {
-  kNoError = 0,  ///< Операция выполнена успешно
-  kFileWrongExtension = 1,  ///< Неверное расширение файла
-  kFailedToOpen = 2,        ///< Не удалось открыть файл
-  kIncorrectData = 3,  ///< Некорректные данные в файле
-};
-
 /**
  * @brief Основной класс модели для работы с 3D объектами
  *
  * Класс Model реализует паттерн Singleton и предоставляет функциональность
  * для загрузки, парсинга и трансформации 3D моделей из OBJ файлов.
+ * Разбор и трансформации делегируются ObjParser и Transformer, которые
+ * без Qt и синглтона использует также 3dviewer-cli.
  *
  * @details Модель поддерживает:
- * - Загрузку OBJ файлов с вершинами и гранями
+ * - Загрузку OBJ файлов с вершинами, гранями и ломаными
  * - Аффинные преобразования (перемещение, поворот, масштабирование)
  * - Автоматическую нормализацию координат
  * - Обработку ошибок при загрузке
@@ -52,8 +44,8 @@ class Model {
   /**
    * @brief Парсит OBJ файл и загружает данные модели
    *
-   * Читает файл построчно, извлекает вершины (v) и грани (f),
-   * выполняет нормализацию координат при необходимости.
+   * Читает файл построчно, извлекает вершины (v), грани (f) и
+   * ломаные (l), выполняет нормализацию координат при необходимости.
    *
    * @pre Имя файла должно быть установлено через SetFileName()
    * @post Данные модели загружены или установлен код ошибки
@@ -88,9 +80,23 @@ class Model {
    * @retval kFileWrongExtension Неверное расширение файла
    * @retval kFailedToOpen Не удалось открыть файл
    * @retval kIncorrectData Некорректные данные в файле
+   * @retval kIndexOutOfRange Грань ссылается на несуществующую вершину
    */
   int GetError() const noexcept;
 
+  /**
+   * @brief Возвращает подробности ошибки последнего разбора
+   */
+  const ObjParseError& GetParseError() const noexcept {
+    return parser_.GetLastError();
+  }
+
+  /**
+   * @brief Включает мягкий разбор: неверные строки пропускаются
+   * @see ObjParser::Parse()
+   */
+  void SetLenient(bool lenient) noexcept { parser_.SetLenient(lenient); }
+
   /**
    * @brief Возвращает константную ссылку на индексы вершин
    * @return Константная ссылка на вектор индексов рёбер
@@ -125,13 +131,23 @@ class Model {
    * @brief Возвращает количество вершин в модели
    * @return Количество вершин (размер координат / 3)
    */
-  size_t GetVertexCount() const noexcept { return vertex_coord_.size() / 3; }
+  size_t GetVertexCount() const noexcept { return mesh_.GetVertexCount(); }
 
   /**
    * @brief Возвращает количество рёбер в модели
    * @return Количество рёбер (размер индексов / 2)
    */
-  size_t GetEdgeCount() const noexcept { return vertex_index_.size() / 2; }
+  size_t GetEdgeCount() const noexcept { return mesh_.GetEdgeCount(); }
+
+  /**
+   * @brief Возвращает количество граней в модели
+   */
+  size_t GetFaceCount() const noexcept { return mesh_.GetFaceCount(); }
+
+  /**
+   * @brief Возвращает сетку модели целиком (вершины, рёбра и грани)
+   */
+  const Mesh& GetMesh() const noexcept { return mesh_; }
 
  private:
   /**
@@ -164,33 +180,6 @@ class Model {
    */
   Model& operator=(Model&&) = delete;
 
-  /**
-   * @brief Парсит строку с вершиной
-   * @param line Строка формата "v x y z"
-   * @post Координаты добавлены в vertex_coord_ или установлена ошибка
-   */
-  void VertexParser_(const std::string& line);
-
-  /**
-   * @brief Парсит строку с гранью
-   * @param line Строка с индексами вершин грани
-   * @post Индексы рёбер добавлены в vertex_index_
-   */
-  void EdgesParser_(const std::string& line);
-
-  /**
-   * @brief Нормализует координаты модели
-   * @post Максимальная координата не превышает 1.0
-   */
-  void Normalize_() noexcept;
-
-  /**
-   * @brief Проверяет корректность расширения файла
-   * @param filename Имя файла для проверки
-   * @return true если файл имеет расширение .obj
-   */
-  bool IsValidObjExtension_(const std::string& filename) const noexcept;
-
   /**
    * @brief Очищает все данные модели
    * @post Векторы координат и индексов очищены, код ошибки сброшен
@@ -198,15 +187,13 @@ class Model {
   void ClearData_() noexcept;
 
   std::string filename_;  ///< Имя загружаемого файла
-  std::vector<double> vertex_coord_;  ///< Координаты вершин (x,y,z,...)
-  std::vector<int> vertex_index_;  ///< Индексы рёбер
-  int error_code_{kNoError};       ///< Код последней ошибки
-  Strategy transformation_model_;  ///< Объект для выполнения трансформаций
-
-  static constexpr double kNormalizationThreshold =
-      10.0;  ///< Порог нормализации
-  static constexpr size_t kMinObjFilenameLength =
-      5;  ///< Минимальная длина имени OBJ файла
+  Mesh mesh_;             ///< Данные модели
+  int error_code_{kNoError};  ///< Код последней ошибки
+  ObjParser parser_;          ///< Парсер OBJ файлов
+
+  // Стратегии создаются один раз: переключение на горячем пути слайдеров
+  // не должно выделять память
+  Transformer transformer_;  ///< Исполнитель трансформаций
 };
 
 }  // namespace s21
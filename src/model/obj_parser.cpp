@@ -0,0 +1,336 @@
+/**
+ * @file obj_parser.cpp
+ * @brief Реализация парсера OBJ файлов
+ */
+
+#include "obj_parser.h"
+
+#include <algorithm>
+#include <cctype>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+#include "../profiling/trace.h"
+
+namespace s21 {
+
+int ObjParser::Load(const std::string& file_name, Mesh& mesh) {
+  mesh.Clear();
+  error_ = ObjParseError();
+  if (!IsValidObjExtension(file_name)) {
+    return error_.code = kFileWrongExtension;
+  }
+
+  std::ifstream file(file_name);
+  if (!file.is_open()) {
+    return error_.code = kFailedToOpen;
+  }
+  return Parse(file, mesh);
+}
+
+int ObjParser::Parse(std::istream& input, Mesh& mesh) {
+  S21_TRACE_SCOPE("ObjParser::Parse");
+
+  mesh.Clear();
+  mesh.vertex_coord.reserve(1000);
+  mesh.vertex_index.reserve(2000);
+  line_.reserve(256);
+  start_ = input.tellg();
+  line_offset_ = 0;
+  max_index_ = -1;
+  polyline_edges_.clear();
+  polyline_start_.clear();
+  polyline_count_ = 0;
+  error_ = ObjParseError();
+
+  for (; std::getline(input, line_); line_offset_ += line_.size() + 1) {
+    if (line_.size() < 2 || line_[0] == '#') {
+      continue;
+    }
+
+    bool parsed = true;
+    if (line_[0] == 'v' && line_[1] == ' ') {
+      parsed = VertexParser_(line_, mesh);
+    } else if ((line_[0] == 'f' || line_[0] == 'l') && line_[1] == ' ') {
+      parsed = ElementParser_(line_, mesh);
+    }
+    if (!parsed) {
+      if (!lenient_) break;
+      ++error_.skipped_lines;
+    }
+  }
+
+  // Ссылки вперёд допустимы, поэтому диапазон известен только в конце
+  const size_t vertex_count = mesh.GetVertexCount();
+  if (max_index_ >= static_cast<long>(vertex_count) &&
+      (lenient_ || error_.code == kNoError)) {
+    if (error_.code == kNoError) {
+      error_.code = kIndexOutOfRange;
+      error_.offset = max_offset_;
+      error_.column = max_column_;
+      error_.element = max_element_;
+      error_.face = max_face_;
+      error_.index = max_index_ + 1;
+      error_.vertex_count = vertex_count;
+    }
+    if (lenient_) error_.skipped_lines += DropBadElements_(mesh);
+  }
+  if (error_.code != kNoError) {
+    Locate_(input);
+    if (!lenient_) {
+      mesh.Clear();
+      return error_.code;
+    }
+  }
+
+  // Отрезки ломаных идут после рёбер граней; файл из одних ломаных
+  // забирает буфер без копирования
+  if (mesh.vertex_index.empty()) {
+    mesh.vertex_index.swap(polyline_edges_);
+  } else {
+    mesh.vertex_index.insert(mesh.vertex_index.end(), polyline_edges_.begin(),
+                             polyline_edges_.end());
+  }
+
+  Normalize_(mesh);
+  return kNoError;
+}
+
+bool ObjParser::VertexParser_(const std::string& line, Mesh& mesh) {
+  double x = 0.0, y = 0.0, z = 0.0;
+  char dummy = 0;
+
+  int parsed = std::sscanf(line.c_str(), "%c %lf %lf %lf", &dummy, &x, &y, &z);
+  if (parsed != 4 || dummy != 'v') {
+    // Ищем первую нечитаемую координату; если их меньше трёх - конец
+    // строки
+    const char* text = line.c_str();
+    size_t start = 1;
+    for (int axis = 0; axis < 3; ++axis) {
+      while (start < line.size() && std::isspace(uint8_t(text[start]))) {
+        ++start;
+      }
+      size_t end = start;
+      while (end < line.size() && !std::isspace(uint8_t(text[end]))) ++end;
+      char* parsed_end = nullptr;
+      std::strtod(text + start, &parsed_end);
+      if (end == start || parsed_end != text + end) {
+        Fail_(line, kIncorrectData, start, end);
+        return false;
+      }
+      start = end;
+    }
+    Fail_(line, kIncorrectData, 0, line.size());
+    return false;
+  }
+
+  mesh.vertex_coord.insert(mesh.vertex_coord.end(), {x, y, z});
+  return true;
+}
+
+bool ObjParser::ElementParser_(const std::string& line, Mesh& mesh) {
+  face_buffer_.clear();
+  const bool polyline = line[0] == 'l';
+  const size_t element = polyline ? polyline_count_ : mesh.GetFaceCount();
+  long line_max = -1;
+  size_t line_max_start = 0;
+  size_t references = 0;
+  auto fail = [&](int code, size_t start, size_t end) {
+    const bool first = Fail_(line, code, start, end);
+    if (first) {
+      error_.element = line[0];
+      error_.face = element;
+    }
+    return first;
+  };
+
+  // Токены после "f " или "l " разделены пробелами; из "v/vt/vn"
+  // берётся индекс вершины
+  const char* text = line.c_str();
+  size_t start = 2;
+  while (true) {
+    while (start < line.size() && std::isspace(uint8_t(text[start]))) {
+      ++start;
+    }
+    if (start == line.size()) break;
+    size_t end = start;
+    while (end < line.size() && !std::isspace(uint8_t(text[end]))) ++end;
+
+    char* parsed_end = nullptr;
+    const long index = std::strtol(text + start, &parsed_end, 10);
+    if (parsed_end == text + start ||
+        (parsed_end != text + end && *parsed_end != '/')) {
+      fail(kIncorrectData, start, end);
+      return false;
+    }
+    ++references;
+    // Отрицательные (относительные) индексы пропускаются
+    if (index >= 0) {
+      const long resolved = index - 1;
+      if (index == 0 || resolved > INT_MAX) {
+        if (fail(kIndexOutOfRange, start, end)) {
+          error_.index = index;
+          error_.vertex_count = mesh.GetVertexCount();
+        }
+        return false;
+      }
+      if (resolved > line_max) {
+        line_max = resolved;
+        line_max_start = start;
+      }
+      face_buffer_.push_back(static_cast<int>(resolved));
+    }
+    start = end;
+  }
+
+  // Грани и ломаной нужны хотя бы две вершины
+  if (references < 2) {
+    fail(kIncorrectData, line.size(), line.size());
+    return false;
+  }
+  if (face_buffer_.size() < 2) {
+    return true;
+  }
+  if (line_max > max_index_) {
+    max_index_ = line_max;
+    max_offset_ = line_offset_ + line_max_start;
+    max_column_ = line_max_start + 1;
+    max_face_ = element;
+    max_element_ = line[0];
+  }
+
+  if (polyline) {
+    // Ломаная даёт только отрезки между соседними вершинами
+    if (lenient_) polyline_start_.push_back(polyline_edges_.size());
+    for (size_t i = 0; i + 1 < face_buffer_.size(); ++i) {
+      polyline_edges_.push_back(face_buffer_[i]);
+      polyline_edges_.push_back(face_buffer_[i + 1]);
+    }
+    ++polyline_count_;
+    return true;
+  }
+
+  // Создаём рёбра для грани
+  for (size_t i = 0; i < face_buffer_.size(); ++i) {
+    size_t next = (i + 1) % face_buffer_.size();
+    mesh.vertex_index.push_back(face_buffer_[i]);
+    mesh.vertex_index.push_back(face_buffer_[next]);
+  }
+  mesh.face_index.insert(mesh.face_index.end(), face_buffer_.begin(),
+                         face_buffer_.end());
+  mesh.face_offset.push_back(static_cast<int>(mesh.face_index.size()));
+  return true;
+}
+
+bool ObjParser::Fail_(const std::string& line, int code, size_t start,
+                      size_t end) {
+  if (error_.code != kNoError) {
+    return false;
+  }
+  error_.code = code;
+  error_.offset = line_offset_ + start;
+  error_.column = start + 1;
+  error_.token = line.substr(start, end - start);
+  return true;
+}
+
+size_t ObjParser::DropBadElements_(Mesh& mesh) noexcept {
+  // Рёбра грани лежат в vertex_index по тем же позициям, что и её
+  // вершины в face_index, только вдвое дальше
+  const int vertex_count = static_cast<int>(mesh.GetVertexCount());
+  auto valid = [vertex_count](const int* first, const int* last) {
+    return std::all_of(first, last,
+                       [vertex_count](int v) { return v < vertex_count; });
+  };
+
+  const size_t face_count = mesh.GetFaceCount();
+  size_t kept = 0;
+  int write = 0;
+  for (size_t f = 0; f < face_count; ++f) {
+    const int begin = mesh.face_offset[f];
+    const int end = mesh.face_offset[f + 1];
+    const int* indices = mesh.face_index.data();
+    if (!valid(indices + begin, indices + end)) continue;
+    std::copy(mesh.face_index.begin() + begin, mesh.face_index.begin() + end,
+              mesh.face_index.begin() + write);
+    std::copy(mesh.vertex_index.begin() + 2 * begin,
+              mesh.vertex_index.begin() + 2 * end,
+              mesh.vertex_index.begin() + 2 * write);
+    write += end - begin;
+    mesh.face_offset[++kept] = write;
+  }
+  mesh.face_index.resize(write);
+  mesh.vertex_index.resize(2 * size_t(write));
+  mesh.face_offset.resize(kept + 1);
+  size_t dropped = face_count - kept;
+
+  size_t edge_write = 0;
+  for (size_t k = 0; k < polyline_start_.size(); ++k) {
+    const size_t begin = polyline_start_[k];
+    const size_t end = k + 1 < polyline_start_.size() ? polyline_start_[k + 1]
+                                                      : polyline_edges_.size();
+    const int* edges = polyline_edges_.data();
+    if (!valid(edges + begin, edges + end)) {
+      ++dropped;
+      continue;
+    }
+    std::copy(polyline_edges_.begin() + begin, polyline_edges_.begin() + end,
+              polyline_edges_.begin() + edge_write);
+    edge_write += end - begin;
+  }
+  polyline_edges_.resize(edge_write);
+  return dropped;
+}
+
+void ObjParser::Locate_(std::istream& input) {
+  input.clear();
+  if (start_ == std::streampos(-1) || !input.seekg(start_)) {
+    return;
+  }
+
+  error_.line = 1;
+  line_.resize(kLocateBlock);
+  for (size_t remaining = error_.offset; remaining > 0;) {
+    input.read(&line_[0], std::min(remaining, line_.size()));
+    const size_t count = static_cast<size_t>(input.gcount());
+    if (count == 0) break;
+    error_.line += std::count(line_.begin(), line_.begin() + count, '\n');
+    remaining -= count;
+  }
+  // Токен с наибольшим индексом не копировался при разборе
+  if (error_.token.empty() && error_.code == kIndexOutOfRange) {
+    input >> error_.token;
+  }
+}
+
+void ObjParser::Normalize_(Mesh& mesh) noexcept {
+  S21_TRACE_SCOPE("ObjParser::Normalize_");
+
+  double max_abs_value = 0.0;
+  for (double coord : mesh.vertex_coord) {
+    double abs_coord = std::abs(coord);
+    if (abs_coord > max_abs_value) {
+      max_abs_value = abs_coord;
+    }
+  }
+
+  if (max_abs_value > kNormalizationThreshold) {
+    double scale_factor = 1.0 / max_abs_value;
+    std::for_each(mesh.vertex_coord.begin(), mesh.vertex_coord.end(),
+                  [scale_factor](double& coord) { coord *= scale_factor; });
+  }
+}
+
+bool ObjParser::IsValidObjExtension(const std::string& file_name) noexcept {
+  if (file_name.size() < kMinObjFilenameLength) {
+    return false;
+  }
+
+  return file_name.compare(file_name.size() - 4, 4, ".obj") == 0;
+}
+
+}  // namespace s21
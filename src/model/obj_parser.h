@@ -0,0 +1,178 @@
+#ifndef MODEL_OBJ_PARSER_H
+#define MODEL_OBJ_PARSER_H
+
+/**
+ * @file obj_parser.h
+ * @brief Разбор OBJ файлов в сетку
+ */
+
+#include <istream>
+#include <string>
+#include <vector>
+
+#include "mesh.h"
+
+namespace s21 {
+
+/**
+ * @brief Подробности последней ошибки разбора
+ *
+ * Позиция считается от начала разбора. Номер строки вычисляется только
+ * после ошибки, повторным чтением потока до offset, поэтому для потока
+ * без перемотки он остаётся 0.
+ */
+struct ObjParseError {
+  int code = kNoError;      ///< Код из error_list
+  size_t offset = 0;        ///< Смещение неверного токена в байтах
+  size_t line = 0;          ///< Номер строки (с 1)
+  size_t column = 0;        ///< Номер столбца в байтах (с 1)
+  std::string token;        ///< Неверный токен, пусто если его не хватает
+  char element = 'f';       ///< Элемент с неверной ссылкой: 'f' или 'l'
+  size_t face = 0;          ///< Номер грани или ломаной (с 0)
+  long index = 0;           ///< Ссылка на вершину в том виде, как в файле
+  size_t vertex_count = 0;  ///< Вершин, объявленных к этому месту файла
+  size_t skipped_lines = 0;  ///< Пропущено строк в мягком режиме
+};
+
+/**
+ * @brief Парсер OBJ файлов
+ *
+ * Общий код загрузки для Model (GUI) и пакетного обработчика
+ * 3dviewer-cli: обе стороны получают побитово одинаковые координаты.
+ * Объект не разделяемый - каждому потоку нужен свой экземпляр, зато
+ * промежуточные буферы переиспользуются между файлами.
+ *
+ * @example
+ * @code
+ * ObjParser parser;
+ * Mesh mesh;
+ * if (parser.Load("cube.obj", mesh) == kNoError) {
+ *   // mesh.GetVertexCount() ...
+ * }
+ * @endcode
+ */
+class ObjParser {
+ public:
+  /**
+   * @brief Проверяет расширение и разбирает файл
+   *
+   * @param file_name Путь к OBJ файлу
+   * @param mesh Выходная сетка (предыдущее содержимое удаляется)
+   * @return Код ошибки из error_list
+   */
+  int Load(const std::string& file_name, Mesh& mesh);
+
+  /**
+   * @brief Разбирает OBJ данные из потока
+   *
+   * Читает вершины (v), грани (f) и ломаные (l), затем нормализует
+   * координаты, если максимальная по модулю превышает
+   * kNormalizationThreshold. Ломаные разбираются тем же кодом, что и
+   * грани, но дают только отрезки в vertex_index: без face_index и без
+   * замыкающего ребра. Отрицательные индексы пропускаются. Диапазон
+   * индексов проверяется без отдельного прохода: при разборе граней
+   * копится наибольший индекс вместе с его позицией, и если он вышел за
+   * число вершин, ошибка указывает на этот токен. При ошибке сетка
+   * очищается, так что отрисовка может не проверять индексы. Позиция
+   * ошибки стоит только сложения длины строки; номер строки вычисляется
+   * после ошибки.
+   *
+   * В мягком режиме строки с ошибками пропускаются, грани и ломаные
+   * со ссылками за пределы вершин удаляются, а разбор завершается
+   * успешно;
+   * GetLastError() описывает первую пропущенную строку.
+   *
+   * @param input Поток с содержимым OBJ файла
+   * @param mesh Выходная сетка (предыдущее содержимое удаляется)
+   * @return kNoError, kIncorrectData или kIndexOutOfRange
+   */
+  int Parse(std::istream& input, Mesh& mesh);
+
+  /**
+   * @brief Возвращает подробности последней ошибки Load или Parse
+   */
+  const ObjParseError& GetLastError() const noexcept { return error_; }
+
+  /**
+   * @brief Включает мягкий режим: неверные строки пропускаются
+   */
+  void SetLenient(bool lenient) noexcept { lenient_ = lenient; }
+
+  /**
+   * @brief Проверяет корректность расширения файла
+   * @param file_name Имя файла для проверки
+   * @return true если файл имеет расширение .obj
+   */
+  static bool IsValidObjExtension(const std::string& file_name) noexcept;
+
+  static constexpr double kNormalizationThreshold =
+      10.0;  ///< Порог нормализации
+
+ private:
+  /**
+   * @brief Парсит строку с вершиной
+   * @param line Строка формата "v x y z"
+   * @return false если строка некорректна
+   */
+  bool VertexParser_(const std::string& line, Mesh& mesh);
+
+  /**
+   * @brief Парсит строку с гранью или ломаной
+   * @param line Строка формата "f v1 v2 v3 ..." или "l v1 v2 ..."
+   *             (допускается v/vt/vn)
+   * @post Грань и её рёбра добавлены в сетку, отрезки ломаной - в
+   *       polyline_edges_
+   * @return false если токен не читается как индекс, вершин меньше двух
+   *         или индекс равен 0 (ссылки вперёд проверяются в конце
+   *         разбора)
+   */
+  bool ElementParser_(const std::string& line, Mesh& mesh);
+
+  /**
+   * @brief Запоминает ошибку в токене [start, end) текущей строки
+   * @return false если ошибка уже была (в мягком режиме важна первая)
+   */
+  bool Fail_(const std::string& line, int code, size_t start, size_t end);
+
+  /**
+   * @brief Удаляет грани и ломаные со ссылками за пределы вершин
+   * @return Число удалённых элементов
+   */
+  size_t DropBadElements_(Mesh& mesh) noexcept;
+
+  /**
+   * @brief Находит номер строки ошибки, перечитывая поток до offset
+   */
+  void Locate_(std::istream& input);
+
+  /**
+   * @brief Нормализует координаты сетки
+   * @post Максимальная координата не превышает 1.0
+   */
+  static void Normalize_(Mesh& mesh) noexcept;
+
+  static constexpr size_t kMinObjFilenameLength =
+      5;  ///< Минимальная длина имени OBJ файла
+
+  static constexpr size_t kLocateBlock =
+      size_t(1) << 16;  ///< Блок чтения при поиске строки ошибки
+
+  std::string line_;                    ///< Буфер текущей строки
+  std::vector<int> face_buffer_;        ///< Индексы текущей грани
+  std::vector<int> polyline_edges_;     ///< Отрезки ломаных до конца файла
+  std::vector<size_t> polyline_start_;  ///< Начала ломаных (мягкий режим)
+  size_t polyline_count_ = 0;           ///< Разобрано ломаных
+  std::streampos start_;                ///< Позиция потока в начале разбора
+  size_t line_offset_ = 0;              ///< Смещение текущей строки
+  long max_index_ = -1;                 ///< Наибольший индекс вершины
+  size_t max_offset_ = 0;               ///< Смещение токена с max_index_
+  size_t max_column_ = 0;               ///< Столбец токена с max_index_
+  size_t max_face_ = 0;                 ///< Грань или ломаная с max_index_
+  char max_element_ = 'f';              ///< Тип элемента с max_index_
+  bool lenient_ = false;                ///< Мягкий режим
+  ObjParseError error_;                 ///< Подробности последней ошибки
+};
+
+}  // namespace s21
+
+#endif  // MODEL_OBJ_PARSER_H
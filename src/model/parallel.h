@@ -0,0 +1,71 @@
+#ifndef MODEL_PARALLEL_H
+#define MODEL_PARALLEL_H
+
+/**
+ * @file parallel.h
+ * @brief Простой параллельный цикл на std::thread
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace s21 {
+
+/**
+ * @brief Возвращает число потоков по умолчанию (аппаратных, минимум 1)
+ */
+inline unsigned DefaultThreadCount() noexcept {
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+/**
+ * @brief Выполняет body(worker, index) для index из [0, count)
+ *
+ * Индексы раздаются потокам динамически по одному, поэтому задачи разной
+ * длительности (файлы разного размера) распределяются равномерно. Номер
+ * потока worker из [0, threads) позволяет держать состояние на поток
+ * без синхронизации. При threads <= 1 цикл выполняется в вызывающем
+ * потоке.
+ *
+ * @param count Количество задач
+ * @param threads Количество потоков
+ * @param body Функция void(unsigned worker, size_t index)
+ *
+ * @example
+ * @code
+ * std::vector<Transformer> transformers(threads);
+ * ParallelFor(files.size(), threads, [&](unsigned worker, size_t i) {
+ *   Process(files[i], transformers[worker]);
+ * });
+ * @endcode
+ */
+template <typename Body>
+void ParallelFor(size_t count, unsigned threads, Body&& body) {
+  threads = static_cast<unsigned>(
+      std::min<size_t>(std::max(threads, 1u), std::max<size_t>(count, 1)));
+  if (threads == 1) {
+    for (size_t i = 0; i < count; ++i) body(0u, i);
+    return;
+  }
+
+  std::atomic<size_t> next{0};
+  auto worker = [&](unsigned id) {
+    for (size_t i = next.fetch_add(1, std::memory_order_relaxed); i < count;
+         i = next.fetch_add(1, std::memory_order_relaxed)) {
+      body(id, i);
+    }
+  };
+
+  std::vector<std::thread> pool;
+  pool.reserve(threads - 1);
+  for (unsigned id = 1; id < threads; ++id) pool.emplace_back(worker, id);
+  worker(0);
+  for (std::thread& thread : pool) thread.join();
+}
+
+}  // namespace s21
+
+#endif  // MODEL_PARALLEL_H
@@ -0,0 +1,385 @@
+/**
+ * @file slicer.cpp
+ * @brief Реализация сечения сетки плоскостью
+ */
+
+#include "slicer.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <fstream>
+#include <utility>
+
+#include "../profiling/trace.h"
+#include "parallel.h"
+
+namespace s21 {
+
+namespace {
+
+constexpr size_t kSliceChunk = 4096;  ///< Граней на задачу ParallelFor
+constexpr uint32_t kNoLink = UINT32_MAX;
+
+/**
+ * @brief Пересечение ребра грани с плоскостью
+ */
+struct Crossing {
+  uint64_t key;
+  double point[3];
+};
+
+}  // namespace
+
+void Slicer::Build(const Mesh& mesh) {
+  std::vector<float> positions(mesh.vertex_coord.begin(),
+                               mesh.vertex_coord.end());
+  Build(std::move(positions), mesh.face_index, mesh.face_offset);
+}
+
+void Slicer::Build(std::vector<float> positions, std::vector<int> face_index,
+                   std::vector<int> face_offset) {
+  S21_TRACE_SCOPE("Slicer::Build");
+  positions_ = std::move(positions);
+  face_index_ = std::move(face_index);
+  face_offset_ = std::move(face_offset);
+  face_tree_.Build(GetFaceCount(),
+                   [this](size_t face) { return FaceBox_(face); });
+
+  // Грани переставляются в порядок листьев: сечение читает грани
+  // пограничных листьев подряд, а не вразброс по всему массиву
+  const std::vector<uint32_t>& order = face_tree_.GetOrder();
+  const size_t faces = order.size();
+  const size_t chunks = (faces + kSliceChunk - 1) / kSliceChunk;
+  std::vector<int> index(face_index_.size());
+  std::vector<int> offset(face_offset_.size(), 0);
+  face_slot_.resize(faces);
+  ParallelFor(chunks, threads_, [&](unsigned, size_t chunk) {
+    const size_t to = std::min(faces, (chunk + 1) * kSliceChunk);
+    for (size_t slot = chunk * kSliceChunk; slot < to; ++slot) {
+      const uint32_t face = order[slot];
+      offset[slot + 1] = face_offset_[face + 1] - face_offset_[face];
+      face_slot_[face] = static_cast<uint32_t>(slot);
+    }
+  });
+  for (size_t slot = 0; slot < faces; ++slot) {
+    offset[slot + 1] += offset[slot];
+  }
+  ParallelFor(chunks, threads_, [&](unsigned, size_t chunk) {
+    const size_t to = std::min(faces, (chunk + 1) * kSliceChunk);
+    for (size_t slot = chunk * kSliceChunk; slot < to; ++slot) {
+      const int begin = face_offset_[order[slot]];
+      std::copy(face_index_.begin() + begin,
+                face_index_.begin() + begin + (offset[slot + 1] - offset[slot]),
+                index.begin() + offset[slot]);
+    }
+  });
+  face_index_ = std::move(index);
+  face_offset_ = std::move(offset);
+}
+
+std::vector<float> Slicer::Refit(std::vector<float> positions) {
+  S21_TRACE_SCOPE("Slicer::Refit");
+  positions_.swap(positions);
+  if (positions.size() != positions_.size()) {
+    Build(std::move(positions_), std::move(face_index_),
+          std::move(face_offset_));
+    return positions;
+  }
+  face_tree_.Refit(
+      [this](size_t face) { return FaceBox_(face_slot_[face]); });
+  return positions;
+}
+
+BvhBox Slicer::FaceBox_(size_t face) const noexcept {
+  BvhBox box;
+  const int begin = face_offset_[face], end = face_offset_[face + 1];
+  const size_t count = positions_.size() / 3;
+  if (end - begin < 3) return box;
+  for (int i = begin; i < end; ++i) {
+    const int vertex = face_index_[i];
+    if (vertex < 0 || size_t(vertex) >= count) return BvhBox();
+    box.Expand(&positions_[size_t(vertex) * 3]);
+  }
+  return box;
+}
+
+void Slicer::IntersectFace_(uint32_t face, const double normal[3],
+                            double offset,
+                            std::vector<Segment>& segments) const {
+  const int begin = face_offset_[face], end = face_offset_[face + 1];
+  const size_t count = positions_.size() / 3;
+  if (end - begin < 3) return;
+  auto distance = [&](int vertex) {
+    const float* p = &positions_[size_t(vertex) * 3];
+    return normal[0] * p[0] + normal[1] * p[1] + normal[2] * p[2] - offset;
+  };
+
+  // Расстояния вершин считаются один раз; большая часть граней
+  // пограничных листьев целиком по одну сторону и отсекается сразу
+  constexpr int kCached = 8;
+  double cached[kCached];
+  bool above = false, below = false;
+  for (int i = begin; i < end; ++i) {
+    const int vertex = face_index_[i];
+    if (vertex < 0 || size_t(vertex) >= count) return;
+    const double d = distance(vertex);
+    if (i - begin < kCached) cached[i - begin] = d;
+    (d > 0.0 ? above : below) = true;
+  }
+  if (!above || !below) return;
+  auto distance_at = [&](int i) {
+    return i - begin < kCached ? cached[i - begin] : distance(face_index_[i]);
+  };
+
+  // Обычно граней с двумя пересечениями большинство: они не выделяют
+  // память, остальные (невыпуклые) собираются в more
+  Crossing found[2];
+  std::vector<Crossing> more;
+  size_t crossings = 0;
+  for (int i = begin; i < end; ++i) {
+    const int j = i + 1 < end ? i + 1 : begin;
+    const double a_distance = distance_at(i), b_distance = distance_at(j);
+    if ((a_distance > 0.0) == (b_distance > 0.0)) continue;
+    const bool swap = face_index_[j] < face_index_[i];
+    const int lo = face_index_[swap ? j : i], hi = face_index_[swap ? i : j];
+    const double lo_distance = swap ? b_distance : a_distance;
+    const double hi_distance = swap ? a_distance : b_distance;
+
+    // От меньшего индекса: соседняя грань получит ту же точку. Точка в
+    // вершине на плоскости получает ключ самой вершины
+    const int first = hi_distance == 0.0 ? hi : lo;
+    const int second = lo_distance == 0.0 ? lo : hi;
+    Crossing crossing;
+    crossing.key = uint64_t(uint32_t(first)) << 32 | uint32_t(second);
+    const double t = lo_distance / (lo_distance - hi_distance);
+    const float* p = &positions_[size_t(lo) * 3];
+    const float* q = &positions_[size_t(hi) * 3];
+    for (int axis = 0; axis < 3; ++axis) {
+      crossing.point[axis] = p[axis] + (double(q[axis]) - p[axis]) * t;
+    }
+    if (crossings < 2) {
+      found[crossings] = crossing;
+    } else {
+      if (more.empty()) more.assign(found, found + 2);
+      more.push_back(crossing);
+    }
+    ++crossings;
+  }
+
+  auto add = [&segments](const Crossing& from, const Crossing& to) {
+    Segment segment;
+    segment.key[0] = from.key;
+    segment.key[1] = to.key;
+    std::copy(from.point, from.point + 3, segment.point[0]);
+    std::copy(to.point, to.point + 3, segment.point[1]);
+    segments.push_back(segment);
+  };
+  if (crossings == 2) {
+    // Грань касается плоскости вершиной - отрезок нулевой длины
+    if (found[0].key != found[1].key) add(found[0], found[1]);
+    return;
+  }
+  if (crossings < 2) return;
+
+  // Невыпуклая грань: точки упорядочиваются вдоль линии пересечения
+  // плоскостей (нормаль грани по Ньюэллу) и соединяются парами
+  double face_normal[3] = {0.0, 0.0, 0.0};
+  for (int i = begin; i < end; ++i) {
+    const float* p = &positions_[size_t(face_index_[i]) * 3];
+    const float* q =
+        &positions_[size_t(face_index_[i + 1 < end ? i + 1 : begin]) * 3];
+    face_normal[0] += (double(p[1]) - q[1]) * (double(p[2]) + q[2]);
+    face_normal[1] += (double(p[2]) - q[2]) * (double(p[0]) + q[0]);
+    face_normal[2] += (double(p[0]) - q[0]) * (double(p[1]) + q[1]);
+  }
+  const double direction[3] = {
+      normal[1] * face_normal[2] - normal[2] * face_normal[1],
+      normal[2] * face_normal[0] - normal[0] * face_normal[2],
+      normal[0] * face_normal[1] - normal[1] * face_normal[0]};
+  auto along = [&direction](const Crossing& crossing) {
+    return crossing.point[0] * direction[0] +
+           crossing.point[1] * direction[1] + crossing.point[2] * direction[2];
+  };
+  std::sort(more.begin(), more.end(),
+            [&along](const Crossing& a, const Crossing& b) {
+              return along(a) < along(b);
+            });
+  for (size_t k = 0; k + 1 < more.size(); k += 2) {
+    if (more[k].key != more[k + 1].key) add(more[k], more[k + 1]);
+  }
+}
+
+Section Slicer::Slice(const SlicePlane& plane) const {
+  S21_TRACE_SCOPE("Slicer::Slice");
+  Section section;
+  const double length = std::sqrt(plane.normal[0] * plane.normal[0] +
+                                  plane.normal[1] * plane.normal[1] +
+                                  plane.normal[2] * plane.normal[2]);
+  if (GetFaceCount() == 0 || !(length > 0.0) || !std::isfinite(length) ||
+      !std::isfinite(plane.offset)) {
+    return section;
+  }
+  const double normal[3] = {plane.normal[0] / length,
+                            plane.normal[1] / length,
+                            plane.normal[2] / length};
+  const double offset = plane.offset / length;
+
+  // Узел нужен, если его вершины могут оказаться по обе стороны:
+  // расстояние центра box плюс-минус проекция полуразмеров
+  std::vector<uint32_t> faces;
+  face_tree_.VisitOverlap(
+      [&](const BvhBox& box) {
+        if (box.IsEmpty()) return kBvhOutside;
+        double center = -offset, radius = 0.0;
+        for (int axis = 0; axis < 3; ++axis) {
+          const double mid = (double(box.min[axis]) + box.max[axis]) * 0.5;
+          const double half = (double(box.max[axis]) - box.min[axis]) * 0.5;
+          center += normal[axis] * mid;
+          radius += std::abs(normal[axis]) * half;
+        }
+        // Запас на округление: расстояния вершин считаются иначе
+        const double slack = 1e-9 * (std::abs(center) + radius) + 1e-30;
+        if (center - radius > slack || center + radius < -slack) {
+          return kBvhOutside;
+        }
+        return kBvhPartial;
+      },
+      [](size_t, size_t) {},
+      [&faces](size_t slot, uint32_t) {
+        faces.push_back(static_cast<uint32_t>(slot));
+      });
+  section.faces_tested = faces.size();
+
+  const size_t chunks = (faces.size() + kSliceChunk - 1) / kSliceChunk;
+  std::vector<std::vector<Segment>> parts(chunks);
+  ParallelFor(chunks, threads_, [&](unsigned, size_t chunk) {
+    const size_t from = chunk * kSliceChunk;
+    const size_t to = std::min(faces.size(), from + kSliceChunk);
+    for (size_t i = from; i < to; ++i) {
+      IntersectFace_(faces[i], normal, offset, parts[chunk]);
+    }
+  });
+  std::vector<Segment> segments;
+  if (parts.size() == 1) {
+    segments = std::move(parts[0]);
+  } else {
+    size_t total = 0;
+    for (const auto& part : parts) total += part.size();
+    segments.reserve(total);
+    for (const auto& part : parts) {
+      segments.insert(segments.end(), part.begin(), part.end());
+    }
+  }
+  section.segment_count = segments.size();
+  Chain_(segments, section);
+  return section;
+}
+
+void Slicer::Chain_(const std::vector<Segment>& segments, Section& section) {
+  // Концы сшиваются по ключу через таблицу с открытой адресацией:
+  // ребро ровно двух концов связывает отрезки, у неманифолдного ребра
+  // (три конца и больше) связь снимается и контур обрывается
+  const uint32_t ends = static_cast<uint32_t>(segments.size() * 2);
+  std::vector<uint32_t> link(ends, kNoLink);
+  int bits = 1;
+  while ((size_t{1} << bits) < size_t{ends} * 2) ++bits;
+  const size_t mask = (size_t{1} << bits) - 1;
+  std::vector<uint32_t> table(mask + 1, kNoLink);
+  std::vector<uint8_t> broken(mask + 1, 0);
+  auto key_of = [&segments](uint32_t end) {
+    return segments[end / 2].key[end % 2];
+  };
+  for (uint32_t end = 0; end < ends; ++end) {
+    const uint64_t key = key_of(end);
+    size_t slot = (key * 0x9E3779B97F4A7C15ull) >> (64 - bits);
+    while (table[slot] != kNoLink && key_of(table[slot]) != key) {
+      slot = (slot + 1) & mask;
+    }
+    const uint32_t first = table[slot];
+    if (first == kNoLink) {
+      table[slot] = end;
+    } else if (!broken[slot] && link[first] == kNoLink) {
+      link[first] = end;
+      link[end] = first;
+    } else if (!broken[slot]) {
+      link[link[first]] = kNoLink;
+      link[first] = kNoLink;
+      broken[slot] = 1;
+    }
+  }
+
+  std::vector<uint8_t> visited(segments.size(), 0);
+  auto trace = [&](uint32_t start) {
+    SectionPolyline polyline;
+    auto push = [&](uint32_t end) {
+      const double* point = segments[end / 2].point[end % 2];
+      polyline.points.insert(polyline.points.end(), point, point + 3);
+    };
+    push(start);
+    for (uint32_t current = start;;) {
+      visited[current / 2] = 1;
+      const uint32_t exit = current ^ 1;
+      push(exit);
+      const uint32_t next = link[exit];
+      if (next == kNoLink) break;
+      if (visited[next / 2]) {
+        // Вернулись к началу: последняя точка повторяет первую
+        polyline.points.resize(polyline.points.size() - 3);
+        polyline.closed = true;
+        break;
+      }
+      current = next;
+    }
+    section.polylines.push_back(std::move(polyline));
+  };
+  // Сначала открытые контуры от свободных концов, затем циклы
+  for (uint32_t end = 0; end < ends; ++end) {
+    if (link[end] == kNoLink && !visited[end / 2]) trace(end);
+  }
+  for (uint32_t segment = 0; segment < segments.size(); ++segment) {
+    if (!visited[segment]) trace(segment * 2);
+  }
+}
+
+int ExportSection(const Section& section, const std::string& file_name) {
+  S21_TRACE_SCOPE("ExportSection");
+
+  std::string data;
+  data.reserve(section.GetPointCount() * 40);
+  char buffer[32];
+  for (const SectionPolyline& polyline : section.polylines) {
+    for (size_t i = 0; i < polyline.points.size(); ++i) {
+      data += i % 3 == 0 ? "v " : " ";
+      const auto result = std::to_chars(buffer, buffer + sizeof(buffer),
+                                        polyline.points[i]);
+      data.append(buffer, result.ptr);
+      if (i % 3 == 2) data += '\n';
+    }
+  }
+
+  size_t first = 1;
+  for (const SectionPolyline& polyline : section.polylines) {
+    const size_t count = polyline.points.size() / 3;
+    if (count < 2) {
+      first += count;
+      continue;
+    }
+    data += 'l';
+    for (size_t i = 0; i <= count; ++i) {
+      if (i == count && !polyline.closed) break;
+      const auto result = std::to_chars(buffer, buffer + sizeof(buffer),
+                                        first + i % count);
+      data += ' ';
+      data.append(buffer, result.ptr);
+    }
+    data += '\n';
+    first += count;
+  }
+
+  std::ofstream file(file_name, std::ios::binary);
+  file.write(data.data(), static_cast<std::streamsize>(data.size()));
+  return file ? kNoError : kFailedToWrite;
+}
+
+}  // namespace s21
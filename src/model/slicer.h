@@ -0,0 +1,173 @@
+#ifndef MODEL_SLICER_H
+#define MODEL_SLICER_H
+
+/**
+ * @file slicer.h
+ * @brief Сечение сетки плоскостью
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "bvh.h"
+#include "mesh.h"
+
+namespace s21 {
+
+/**
+ * @brief Плоскость normal * p = offset
+ */
+struct SlicePlane {
+  double normal[3] = {0.0, 0.0, 1.0};  ///< Нормаль (длина не важна)
+  double offset = 0.0;                 ///< Смещение в длинах нормали
+};
+
+/**
+ * @brief Контур сечения
+ */
+struct SectionPolyline {
+  std::vector<double> points;  ///< Точки x, y, z подряд
+  bool closed = false;  ///< Последняя точка соединяется с первой
+};
+
+/**
+ * @brief Результат сечения
+ */
+struct Section {
+  std::vector<SectionPolyline> polylines;  ///< Контуры
+  size_t faces_tested = 0;   ///< Граней в пограничных листьях
+  size_t segment_count = 0;  ///< Отрезков (пересечённых граней)
+
+  /**
+   * @brief Общее число точек контуров
+   */
+  size_t GetPointCount() const noexcept {
+    size_t count = 0;
+    for (const SectionPolyline& polyline : polylines) {
+      count += polyline.points.size() / 3;
+    }
+    return count;
+  }
+};
+
+/**
+ * @brief Сечение граней сетки произвольной плоскостью
+ *
+ * Над гранями строится Bvh; запрос проходит только по узлам, box
+ * которых пересекает плоскость, поэтому стоимость сечения зависит от
+ * длины контура, а не от размера сетки. Грани пограничных листьев
+ * пересекаются параллельно, отрезки сшиваются в контуры по рёбрам:
+ * точка пересечения ребра (a, b) считается от меньшего индекса,
+ * поэтому у соседних граней она совпадает побитово. Вершина на
+ * плоскости относится к отрицательной стороне, а точка в такой
+ * вершине сшивается по самой вершине: плоскость через вершины сетки
+ * не даёт ни разрывов, ни отрезков нулевой длины.
+ *
+ * Как и Picker, Slicer хранит копию координат в float и после
+ * трансформации модели обновляется через Refit.
+ *
+ * @example
+ * @code
+ * Slicer slicer(DefaultThreadCount());
+ * slicer.Build(mesh);
+ * SlicePlane plane;
+ * plane.offset = 0.25;  // z = 0.25
+ * const Section section = slicer.Slice(plane);
+ * ExportSection(section, "section.obj");
+ * @endcode
+ */
+class Slicer {
+ public:
+  explicit Slicer(unsigned threads = 1) : threads_(threads),
+                                          face_tree_(threads) {}
+
+  /**
+   * @brief Строит иерархию над гранями сетки
+   */
+  void Build(const Mesh& mesh);
+
+  /**
+   * @brief Строит иерархию по собственным копиям данных
+   *
+   * @param positions Координаты вершин x, y, z подряд
+   * @param face_index Индексы вершин граней подряд
+   * @param face_offset Начала граней в face_index (граней + 1)
+   */
+  void Build(std::vector<float> positions, std::vector<int> face_index,
+             std::vector<int> face_offset);
+
+  /**
+   * @brief Обновляет координаты при прежних гранях
+   *
+   * При другом числе вершин выполняется Build с прежними гранями.
+   *
+   * @return Прежние координаты для повторного использования буфера
+   */
+  std::vector<float> Refit(std::vector<float> positions);
+
+  size_t GetFaceCount() const noexcept {
+    return face_offset_.empty() ? 0 : face_offset_.size() - 1;
+  }
+
+  /**
+   * @brief Box всех граней
+   */
+  BvhBox GetBounds() const noexcept { return face_tree_.GetBounds(); }
+
+  /**
+   * @brief Сечение плоскостью
+   *
+   * Грани с индексами вне диапазона вершин пропускаются. Контуры
+   * замкнуты на замкнутой поверхности; на краю сетки и у
+   * неманифолдного ребра (больше двух граней) контур обрывается.
+   */
+  Section Slice(const SlicePlane& plane) const;
+
+ private:
+  /**
+   * @brief Отрезок пересечения грани
+   */
+  struct Segment {
+    uint64_t key[2];     ///< Рёбра концов: (меньший << 32) | больший
+    double point[2][3];  ///< Концы
+  };
+
+  /**
+   * @brief Box грани; пустой для грани с неверным индексом
+   */
+  BvhBox FaceBox_(size_t face) const noexcept;
+
+  /**
+   * @brief Добавляет отрезки пересечения грани с плоскостью
+   * @param face Номер грани в порядке листьев
+   */
+  void IntersectFace_(uint32_t face, const double normal[3], double offset,
+                      std::vector<Segment>& segments) const;
+
+  /**
+   * @brief Сшивает отрезки в контуры
+   */
+  static void Chain_(const std::vector<Segment>& segments, Section& section);
+
+  unsigned threads_ = 1;
+  std::vector<float> positions_;  ///< Координаты вершин
+  std::vector<int> face_index_;   ///< Индексы вершин граней (по листьям)
+  std::vector<int> face_offset_;  ///< Начала граней (по листьям)
+  std::vector<uint32_t> face_slot_;  ///< Место исходной грани в face_offset_
+  Bvh face_tree_;                    ///< Иерархия над гранями
+};
+
+/**
+ * @brief Сохраняет сечение в OBJ: вершины v и ломаные l
+ *
+ * Замкнутый контур записывается с повтором первой вершины в конце.
+ *
+ * @return kNoError или kFailedToWrite
+ */
+int ExportSection(const Section& section, const std::string& file_name);
+
+}  // namespace s21
+
+#endif  // MODEL_SLICER_H
@@ -0,0 +1,264 @@
+/**
+ * @file topology.cpp
+ * @brief Реализация полурёбер и связных компонент граней
+ */
+
+#include "topology.h"
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+
+#include "../profiling/trace.h"
+#include "parallel.h"
+
+namespace s21 {
+
+namespace {
+
+constexpr size_t kTopologyChunk = 4096;  ///< Граней или вершин на задачу
+
+using AtomicIndex = std::atomic<uint32_t>;
+
+/**
+ * @brief Корень множества; путь сокращается вдвое
+ *
+ * Родитель всегда меньше потомка, поэтому устаревшее чтение даёт
+ * предка, а не цикл, и порядок памяти relaxed достаточен.
+ */
+uint32_t FindRoot(AtomicIndex* parent, uint32_t x) {
+  for (;;) {
+    uint32_t up = parent[x].load(std::memory_order_relaxed);
+    if (up == x) return x;
+    const uint32_t next = parent[up].load(std::memory_order_relaxed);
+    if (next != up) {
+      parent[x].compare_exchange_weak(up, next, std::memory_order_relaxed);
+    }
+    x = next;
+  }
+}
+
+/**
+ * @brief Объединяет множества a и b без блокировок
+ */
+void Unite(AtomicIndex* parent, uint32_t a, uint32_t b) {
+  for (;;) {
+    a = FindRoot(parent, a);
+    b = FindRoot(parent, b);
+    if (a == b) return;
+    if (a < b) std::swap(a, b);
+    // Корень мог получить родителя после FindRoot - тогда повтор
+    uint32_t expected = a;
+    if (parent[a].compare_exchange_strong(expected, b,
+                                          std::memory_order_relaxed)) {
+      return;
+    }
+  }
+}
+
+/**
+ * @brief Сортировка вставками: в корзине вершины единицы записей
+ */
+void SortBucket(uint64_t* first, uint64_t* last) {
+  for (uint64_t* i = first + 1; i < last; ++i) {
+    const uint64_t value = *i;
+    uint64_t* j = i;
+    for (; j > first && *(j - 1) > value; --j) *j = *(j - 1);
+    *j = value;
+  }
+}
+
+/**
+ * @brief Счётчики рёбер куска вершин
+ */
+struct EdgeCounts {
+  size_t edges = 0;
+  size_t boundary = 0;
+  size_t non_manifold = 0;
+  size_t flipped = 0;
+};
+
+}  // namespace
+
+void Topology::Build(const Mesh& mesh) {
+  Build(mesh.face_index, mesh.face_offset, mesh.GetVertexCount());
+}
+
+void Topology::Build(const std::vector<int>& face_index,
+                     const std::vector<int>& face_offset,
+                     size_t vertex_count) {
+  S21_TRACE_SCOPE("Topology::Build");
+  stats_ = TopologyStats();
+  boundary_edges_.clear();
+  non_manifold_edges_.clear();
+  const size_t faces = face_offset.empty() ? 0 : face_offset.size() - 1;
+  const size_t face_chunks = (faces + kTopologyChunk - 1) / kTopologyChunk;
+  const size_t vertex_chunks =
+      (vertex_count + kTopologyChunk - 1) / kTopologyChunk;
+  stats_.face_count = faces;
+  twin_.assign(face_index.size(), kNoTwin);
+  half_edge_face_.assign(face_index.size(), UINT32_MAX);
+  component_.resize(faces);
+
+  // Концы полуребра i грани [begin, end); false - полуребро пропускается
+  const int vertices = static_cast<int>(vertex_count);
+  auto ends = [&face_index, vertices](int i, int begin, int end, int& a,
+                                      int& b) {
+    a = face_index[i];
+    b = face_index[i + 1 < end ? i + 1 : begin];
+    return end - begin >= 3 && a != b && a >= 0 && b >= 0 && a < vertices &&
+           b < vertices;
+  };
+
+  // 1. Полурёбра считаются по корзинам меньшей вершины
+  std::vector<AtomicIndex> bucket(vertex_count);
+  std::vector<AtomicIndex> parent(faces);
+  ParallelFor(face_chunks, threads_, [&](unsigned, size_t chunk) {
+    const size_t to = std::min(faces, (chunk + 1) * kTopologyChunk);
+    for (size_t face = chunk * kTopologyChunk; face < to; ++face) {
+      parent[face].store(static_cast<uint32_t>(face),
+                         std::memory_order_relaxed);
+      const int begin = face_offset[face], end = face_offset[face + 1];
+      for (int i = begin; i < end; ++i) {
+        half_edge_face_[i] = static_cast<uint32_t>(face);
+        int a, b;
+        if (ends(i, begin, end, a, b)) {
+          bucket[std::min(a, b)].fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+    }
+  });
+
+  // 2. Префиксная сумма по кускам вершин: bucket[v] - начало корзины
+  std::vector<uint32_t> chunk_start(vertex_chunks + 1, 0);
+  ParallelFor(vertex_chunks, threads_, [&](unsigned, size_t chunk) {
+    const size_t to = std::min(vertex_count, (chunk + 1) * kTopologyChunk);
+    uint32_t sum = 0;
+    for (size_t v = chunk * kTopologyChunk; v < to; ++v) {
+      sum += bucket[v].load(std::memory_order_relaxed);
+    }
+    chunk_start[chunk + 1] = sum;
+  });
+  for (size_t chunk = 0; chunk < vertex_chunks; ++chunk) {
+    chunk_start[chunk + 1] += chunk_start[chunk];
+  }
+  ParallelFor(vertex_chunks, threads_, [&](unsigned, size_t chunk) {
+    const size_t to = std::min(vertex_count, (chunk + 1) * kTopologyChunk);
+    uint32_t sum = chunk_start[chunk];
+    for (size_t v = chunk * kTopologyChunk; v < to; ++v) {
+      sum += bucket[v].exchange(sum, std::memory_order_relaxed);
+    }
+  });
+
+  // 3. Раскладка: запись (большая вершина, полуребро). После неё
+  // bucket[v] указывает на конец корзины v, то есть на начало v + 1
+  std::vector<uint64_t> entries(chunk_start.back());
+  ParallelFor(face_chunks, threads_, [&](unsigned, size_t chunk) {
+    const size_t to = std::min(faces, (chunk + 1) * kTopologyChunk);
+    for (size_t face = chunk * kTopologyChunk; face < to; ++face) {
+      const int begin = face_offset[face], end = face_offset[face + 1];
+      for (int i = begin; i < end; ++i) {
+        int a, b;
+        if (!ends(i, begin, end, a, b)) continue;
+        const uint32_t slot = bucket[std::min(a, b)].fetch_add(
+            1, std::memory_order_relaxed);
+        entries[slot] = uint64_t(std::max(a, b)) << 32 | uint32_t(i);
+      }
+    }
+  });
+
+  // 4. Корзины: одинаковая большая вершина - одно ребро. Пары
+  // связываются, грани ребра объединяются в оболочку
+  std::vector<EdgeCounts> counts(vertex_chunks);
+  std::vector<std::vector<int>> boundary(vertex_chunks);
+  std::vector<std::vector<int>> non_manifold(vertex_chunks);
+  ParallelFor(vertex_chunks, threads_, [&](unsigned, size_t chunk) {
+    const size_t to = std::min(vertex_count, (chunk + 1) * kTopologyChunk);
+    EdgeCounts& count = counts[chunk];
+    for (size_t v = chunk * kTopologyChunk; v < to; ++v) {
+      uint64_t* first =
+          entries.data() +
+          (v > 0 ? bucket[v - 1].load(std::memory_order_relaxed) : 0);
+      uint64_t* last =
+          entries.data() + bucket[v].load(std::memory_order_relaxed);
+      SortBucket(first, last);
+      for (uint64_t* run = first; run != last;) {
+        const uint32_t hi = uint32_t(*run >> 32);
+        uint64_t* run_end = run + 1;
+        while (run_end != last && uint32_t(*run_end >> 32) == hi) ++run_end;
+        const size_t k = run_end - run;
+        ++count.edges;
+        const uint32_t h0 = uint32_t(*run);
+        if (k == 1) {
+          ++count.boundary;
+          boundary[chunk].push_back(static_cast<int>(v));
+          boundary[chunk].push_back(static_cast<int>(hi));
+        } else {
+          for (size_t j = 0; j < k; ++j) {
+            const uint32_t h = uint32_t(run[j]);
+            twin_[h] = uint32_t(run[j + 1 < k ? j + 1 : 0]);
+            if (j > 0) {
+              Unite(parent.data(), half_edge_face_[h0], half_edge_face_[h]);
+            }
+          }
+          if (k == 2) {
+            // Согласованные грани проходят общее ребро навстречу
+            count.flipped +=
+                face_index[h0] == face_index[uint32_t(run[1])];
+          } else {
+            ++count.non_manifold;
+            non_manifold[chunk].push_back(static_cast<int>(v));
+            non_manifold[chunk].push_back(static_cast<int>(hi));
+          }
+        }
+        run = run_end;
+      }
+    }
+  });
+  for (size_t chunk = 0; chunk < vertex_chunks; ++chunk) {
+    stats_.edge_count += counts[chunk].edges;
+    stats_.boundary_edge_count += counts[chunk].boundary;
+    stats_.non_manifold_edge_count += counts[chunk].non_manifold;
+    stats_.flipped_edge_count += counts[chunk].flipped;
+    boundary_edges_.insert(boundary_edges_.end(), boundary[chunk].begin(),
+                           boundary[chunk].end());
+    non_manifold_edges_.insert(non_manifold_edges_.end(),
+                               non_manifold[chunk].begin(),
+                               non_manifold[chunk].end());
+  }
+
+  // 5. Номера оболочек: корни нумеруются по возрастанию
+  std::vector<uint32_t> roots(face_chunks + 1, 0);
+  ParallelFor(face_chunks, threads_, [&](unsigned, size_t chunk) {
+    const size_t to = std::min(faces, (chunk + 1) * kTopologyChunk);
+    uint32_t found = 0;
+    for (size_t face = chunk * kTopologyChunk; face < to; ++face) {
+      component_[face] = FindRoot(parent.data(), uint32_t(face));
+      found += component_[face] == face;
+    }
+    roots[chunk + 1] = found;
+  });
+  for (size_t chunk = 0; chunk < face_chunks; ++chunk) {
+    roots[chunk + 1] += roots[chunk];
+  }
+  // Номер корня записывается на место его родителя
+  ParallelFor(face_chunks, threads_, [&](unsigned, size_t chunk) {
+    const size_t to = std::min(faces, (chunk + 1) * kTopologyChunk);
+    uint32_t number = roots[chunk];
+    for (size_t face = chunk * kTopologyChunk; face < to; ++face) {
+      if (component_[face] == face) {
+        parent[face].store(number++, std::memory_order_relaxed);
+      }
+    }
+  });
+  ParallelFor(face_chunks, threads_, [&](unsigned, size_t chunk) {
+    const size_t to = std::min(faces, (chunk + 1) * kTopologyChunk);
+    for (size_t face = chunk * kTopologyChunk; face < to; ++face) {
+      component_[face] =
+          parent[component_[face]].load(std::memory_order_relaxed);
+    }
+  });
+  stats_.component_count = roots.back();
+}
+
+}  // namespace s21
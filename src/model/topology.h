@@ -0,0 +1,156 @@
+#ifndef MODEL_TOPOLOGY_H
+#define MODEL_TOPOLOGY_H
+
+/**
+ * @file topology.h
+ * @brief Связность граней: полурёбра, оболочки, края и неманифолдные рёбра
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "mesh.h"
+
+namespace s21 {
+
+/**
+ * @brief Сводка связности сетки
+ */
+struct TopologyStats {
+  size_t face_count = 0;              ///< Граней
+  size_t edge_count = 0;              ///< Различных рёбер граней
+  size_t boundary_edge_count = 0;     ///< Рёбер одной грани (край)
+  size_t non_manifold_edge_count = 0; ///< Рёбер трёх и более граней
+  size_t flipped_edge_count = 0;  ///< Рёбер двух граней, обходящих их
+                                  ///< в одну сторону (несогласованная
+                                  ///< ориентация)
+  size_t component_count = 0;  ///< Оболочек: граней, связанных рёбрами
+
+  /**
+   * @brief Поверхность замкнута: нет края и неманифолдных рёбер
+   */
+  bool IsClosed() const noexcept {
+    return edge_count > 0 && boundary_edge_count == 0 &&
+           non_manifold_edge_count == 0;
+  }
+};
+
+/**
+ * @brief Полурёбра и связные компоненты граней
+ *
+ * Полуребро - угол грани: полуребро h идёт из вершины face_index[h] в
+ * следующую вершину той же грани, его номер совпадает с позицией в
+ * face_index. Полурёбра одного ребра находятся без хеш-таблицы и без
+ * общей сортировки: они раскладываются по корзинам меньшей вершины
+ * (подсчёт, префиксная сумма, раскладка), а в корзине, где в среднем
+ * несколько записей, упорядочиваются по большей вершине. Все проходы
+ * параллельны по кускам граней или вершин, поэтому построение линейно
+ * по числу полурёбер и вершин.
+ *
+ * Оболочки считаются системой непересекающихся множеств над гранями:
+ * грани одного ребра объединяются прямо в проходе по корзинам,
+ * объединение без блокировок (корень с большим номером подвешивается
+ * к меньшему через compare_exchange, пути сокращаются вдвое). Номера
+ * оболочек идут по возрастанию наименьшей грани и от числа потоков не
+ * зависят.
+ *
+ * Полурёбра с неверным индексом вершины, вырожденные (обе вершины
+ * совпадают) и полурёбра граней меньше чем из трёх вершин
+ * пропускаются: у них нет пары, в рёбра они не входят.
+ *
+ * @example
+ * @code
+ * Topology topology(DefaultThreadCount());
+ * topology.Build(mesh);
+ * if (!topology.GetStats().IsClosed()) {
+ *   const std::vector<int>& edges = topology.GetBoundaryEdges();
+ *   // edges - пары вершин края, как vertex_index
+ * }
+ * @endcode
+ */
+class Topology {
+ public:
+  /// Пары нет: край или пропущенное полуребро
+  static constexpr uint32_t kNoTwin = UINT32_MAX;
+
+  explicit Topology(unsigned threads = 1) : threads_(threads) {}
+
+  /**
+   * @brief Строит связность граней сетки
+   */
+  void Build(const Mesh& mesh);
+
+  /**
+   * @brief Строит связность по граням
+   *
+   * @param face_index Индексы вершин граней подряд
+   * @param face_offset Начала граней в face_index (граней + 1)
+   * @param vertex_count Число вершин (индексы вне диапазона пропускаются)
+   */
+  void Build(const std::vector<int>& face_index,
+             const std::vector<int>& face_offset, size_t vertex_count);
+
+  /**
+   * @brief Возвращает сводку последнего построения
+   */
+  const TopologyStats& GetStats() const noexcept { return stats_; }
+
+  /**
+   * @brief Возвращает число полурёбер (позиций face_index)
+   */
+  size_t GetHalfEdgeCount() const noexcept { return twin_.size(); }
+
+  /**
+   * @brief Возвращает парное полуребро
+   *
+   * У ребра двух граней пары взаимны; у неманифолдного ребра полурёбра
+   * замкнуты в кольцо вокруг ребра.
+   *
+   * @return Номер полуребра или kNoTwin
+   */
+  uint32_t GetTwin(size_t half_edge) const noexcept {
+    return twin_[half_edge];
+  }
+
+  /**
+   * @brief Возвращает грань полуребра
+   */
+  uint32_t GetFace(size_t half_edge) const noexcept {
+    return half_edge_face_[half_edge];
+  }
+
+  /**
+   * @brief Возвращает номера оболочек граней (от 0, по граням)
+   */
+  const std::vector<uint32_t>& GetComponents() const noexcept {
+    return component_;
+  }
+
+  /**
+   * @brief Возвращает рёбра края парами вершин (меньшая, большая)
+   */
+  const std::vector<int>& GetBoundaryEdges() const noexcept {
+    return boundary_edges_;
+  }
+
+  /**
+   * @brief Возвращает неманифолдные рёбра парами вершин
+   */
+  const std::vector<int>& GetNonManifoldEdges() const noexcept {
+    return non_manifold_edges_;
+  }
+
+ private:
+  unsigned threads_ = 1;
+  TopologyStats stats_;
+  std::vector<uint32_t> twin_;            ///< Пары полурёбер
+  std::vector<uint32_t> half_edge_face_;  ///< Грань каждого полуребра
+  std::vector<uint32_t> component_;       ///< Оболочка каждой грани
+  std::vector<int> boundary_edges_;       ///< Рёбра края
+  std::vector<int> non_manifold_edges_;   ///< Неманифолдные рёбра
+};
+
+}  // namespace s21
+
+#endif  // MODEL_TOPOLOGY_H
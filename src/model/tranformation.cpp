@@ -86,7 +86,13 @@ void ScaleStrategy::Transform(std::vector<double>& vertex_coord, double scale,
 
 void Strategy::SetStrategy(
     std::unique_ptr<TransformationStrategy> strategy) noexcept {
-  strategy_ = std::move(strategy);
+  owned_ = std::move(strategy);
+  strategy_ = owned_.get();
+}
+
+void Strategy::SetStrategy(TransformationStrategy& strategy) noexcept {
+  owned_.reset();
+  strategy_ = &strategy;
 }
 
 void Strategy::PerformTransformation(std::vector<double>& vertex_coord,
@@ -96,4 +102,23 @@ void Strategy::PerformTransformation(std::vector<double>& vertex_coord,
   }
 }
 
+void Transformer::Apply(std::vector<double>& vertex_coord, int strategy_type,
+                        double value, transformation_t axis) {
+  switch (strategy_type) {
+    case kMove:
+      context_.SetStrategy(move_strategy_);
+      break;
+    case kRotate:
+      context_.SetStrategy(rotate_strategy_);
+      break;
+    case kScale:
+      context_.SetStrategy(scale_strategy_);
+      break;
+    default:
+      return;
+  }
+
+  context_.PerformTransformation(vertex_coord, value, axis);
+}
+
 }  // namespace s21
@@ -203,14 +203,19 @@ class ScaleStrategy final : public TransformationStrategy {
  * Класс-контекст паттерна Strategy, который управляет
  * выбором и выполнением различных типов трансформаций.
  *
- * @details Использует std::unique_ptr для автоматического
- * управления памятью стратегий.
+ * @details Стратегию можно передать во владение (std::unique_ptr) или
+ * по ссылке на заранее созданный объект. Второй вариант не выделяет
+ * память и используется на горячем пути трансформаций (слайдеры).
  *
  * @example
  * @code
  * Strategy context;
  * context.SetStrategy(std::make_unique<MoveStrategy>());
  * context.PerformTransformation(coords, 1.0, kX);
+ *
+ * RotateStrategy rotate;
+ * context.SetStrategy(rotate);  // без выделения памяти
+ * context.PerformTransformation(coords, 30.0, kY);
  * @endcode
  */
 class Strategy {
@@ -255,6 +260,15 @@ class Strategy {
    */
   void SetStrategy(std::unique_ptr<TransformationStrategy> strategy) noexcept;
 
+  /**
+   * @brief Устанавливает стратегию, не передавая владение
+   *
+   * @param strategy Стратегия, живущая дольше контекста
+   *
+   * @post Ранее переданная во владение стратегия удалена
+   */
+  void SetStrategy(TransformationStrategy& strategy) noexcept;
+
   /**
    * @brief Выполняет трансформацию с использованием текущей стратегии
    *
@@ -270,7 +284,44 @@ class Strategy {
 
  private:
   std::unique_ptr<TransformationStrategy>
-      strategy_;  ///< Текущая стратегия трансформации
+      owned_;  ///< Стратегия во владении контекста
+  TransformationStrategy* strategy_ = nullptr;  ///< Текущая стратегия
+};
+
+/**
+ * @brief Исполнитель трансформаций по типу операции
+ *
+ * Владеет контекстом Strategy и по одному экземпляру каждой стратегии,
+ * поэтому переключение типа трансформации не выделяет память. Используется
+ * Model (GUI) и пакетным обработчиком 3dviewer-cli - одинаковые команды
+ * дают побитово одинаковый результат. Каждому потоку нужен свой экземпляр.
+ *
+ * @example
+ * @code
+ * Transformer transformer;
+ * transformer.Apply(coords, kRotate, 30.0, kY);
+ * @endcode
+ */
+class Transformer {
+ public:
+  /**
+   * @brief Выполняет трансформацию выбранного типа
+   *
+   * @param vertex_coord Координаты вершин для трансформации
+   * @param strategy_type Тип трансформации (kMove, kRotate, kScale)
+   * @param value Значение трансформации (смещение, угол, масштаб)
+   * @param axis Ось трансформации
+   *
+   * @post Неизвестный тип трансформации игнорируется
+   */
+  void Apply(std::vector<double>& vertex_coord, int strategy_type,
+             double value, transformation_t axis);
+
+ private:
+  Strategy context_;                ///< Контекст стратегии
+  MoveStrategy move_strategy_;      ///< Стратегия перемещения
+  RotateStrategy rotate_strategy_;  ///< Стратегия поворота
+  ScaleStrategy scale_strategy_;    ///< Стратегия масштабирования
 };
 
 }  // namespace s21
@@ -0,0 +1,70 @@
+/**
+ * @file worker_queue.cpp
+ * @brief Реализация очереди фоновых задач
+ */
+
+#include "worker_queue.h"
+
+#include <algorithm>
+
+namespace s21 {
+
+WorkerQueue::WorkerQueue(size_t capacity)
+    : capacity_(std::max<size_t>(capacity, 1)), tasks_(capacity_) {}
+
+WorkerQueue::~WorkerQueue() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  task_cv_.notify_all();
+  if (thread_.joinable()) thread_.join();
+}
+
+bool WorkerQueue::Post(std::function<void()> task) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stopping_ || count_ >= capacity_) return false;
+    tasks_[(head_ + count_) % capacity_] = std::move(task);
+    ++count_;
+    if (!thread_.joinable()) thread_ = std::thread(&WorkerQueue::Run_, this);
+  }
+  task_cv_.notify_one();
+  return true;
+}
+
+void WorkerQueue::WaitIdle() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (busy_ || count_ > 0) {
+    idle_cv_.wait_for(lock, kIdlePeriod);
+  }
+}
+
+size_t WorkerQueue::GetPendingCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return count_ + (busy_ ? 1 : 0);
+}
+
+void WorkerQueue::Run_() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (;;) {
+    while (count_ == 0 && !stopping_) {
+      task_cv_.wait_for(lock, kIdlePeriod);
+    }
+    // При остановке оставшиеся задачи выполняются, новые не принимаются
+    if (count_ == 0) return;
+
+    std::function<void()> task;
+    task.swap(tasks_[head_]);
+    head_ = (head_ + 1) % capacity_;
+    --count_;
+    busy_ = true;
+    lock.unlock();
+    task();
+    lock.lock();
+    busy_ = false;
+    idle_cv_.notify_all();
+  }
+}
+
+}  // namespace s21
@@ -0,0 +1,102 @@
+#ifndef MODEL_WORKER_QUEUE_H
+#define MODEL_WORKER_QUEUE_H
+
+/**
+ * @file worker_queue.h
+ * @brief Ограниченная очередь задач с фоновым потоком
+ */
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace s21 {
+
+/**
+ * @brief Очередь задач, выполняемых по порядку в одном фоновом потоке
+ *
+ * Предназначена для работы, которую нельзя делать в GUI-потоке:
+ * кодирование снимков и кадров записи экрана. Ёмкость ограничена: если
+ * потребитель не успевает, Post возвращает false и вызывающий сам
+ * решает, пропустить задачу или подождать, - очередь не растёт без
+ * предела и не блокирует интерфейс.
+ *
+ * Поток создаётся при первой задаче, чтобы не занимать время запуска.
+ * Деструктор выполняет уже принятые задачи и останавливает поток.
+ * Слоты задач выделяются один раз в конструкторе, поэтому Post задачи,
+ * которая помещается в std::function без кучи (захват одного
+ * указателя), не выделяет память.
+ *
+ * @example
+ * @code
+ * WorkerQueue encoder(4);
+ * if (!encoder.Post([image, path] { image.save(path); })) {
+ *   // очередь полна - снимок пропущен
+ * }
+ * @endcode
+ */
+class WorkerQueue {
+ public:
+  /**
+   * @brief Создаёт очередь
+   * @param capacity Наибольшее число ожидающих задач (минимум 1)
+   */
+  explicit WorkerQueue(size_t capacity = 16);
+
+  /**
+   * @brief Выполняет принятые задачи и останавливает поток
+   */
+  ~WorkerQueue();
+
+  WorkerQueue(const WorkerQueue&) = delete;
+  WorkerQueue& operator=(const WorkerQueue&) = delete;
+
+  /**
+   * @brief Ставит задачу в очередь
+   * @return false если очередь полна (задача не принята)
+   */
+  bool Post(std::function<void()> task);
+
+  /**
+   * @brief Ждёт, пока очередь опустеет и текущая задача завершится
+   */
+  void WaitIdle();
+
+  /**
+   * @brief Возвращает число ожидающих и выполняемых задач
+   */
+  size_t GetPendingCount() const;
+
+  /**
+   * @brief Возвращает ёмкость очереди
+   */
+  size_t GetCapacity() const noexcept { return capacity_; }
+
+ private:
+  /// Период проверки флагов при ожидании
+  static constexpr std::chrono::milliseconds kIdlePeriod{100};
+
+  /**
+   * @brief Цикл фонового потока
+   */
+  void Run_();
+
+  size_t capacity_;                           ///< Ёмкость очереди
+  mutable std::mutex mutex_;                  ///< Защищает поля ниже
+  std::condition_variable task_cv_;           ///< Появилась задача
+  std::condition_variable idle_cv_;           ///< Задача завершена
+  std::vector<std::function<void()>> tasks_;  ///< Кольцо ожидающих задач
+  size_t head_ = 0;                           ///< Слот первой задачи
+  size_t count_ = 0;                          ///< Число ожидающих задач
+  bool busy_ = false;                         ///< Задача выполняется
+  bool stopping_ = false;                     ///< Запрошена остановка
+  std::thread thread_;                        ///< Фоновый поток
+};
+
+}  // namespace s21
+
+#endif  // MODEL_WORKER_QUEUE_H
@@ -0,0 +1,53 @@
+/**
+ * @file frame_stats.cpp
+ * @brief Реализация статистики кадров
+ */
+
+#include "frame_stats.h"
+
+#include <algorithm>
+
+namespace s21 {
+
+void FrameStats::AddFrame(double timestamp_ms, double cpu_ms) noexcept {
+  timestamps_ms_[head_] = timestamp_ms;
+  cpu_ms_[head_] = cpu_ms;
+  head_ = (head_ + 1) % kHistorySize;
+  size_ = std::min(size_ + 1, kHistorySize);
+}
+
+double FrameStats::GetFps() const noexcept {
+  if (size_ < 2) {
+    return 0.0;
+  }
+
+  const double last = timestamps_ms_[Slot_(size_ - 1)];
+  size_t first = size_ - 1;
+  while (first > 0 && last - timestamps_ms_[Slot_(first - 1)] <= kFpsWindowMs) {
+    --first;
+  }
+
+  const double span = last - timestamps_ms_[Slot_(first)];
+  if (span <= 0.0) {
+    return 0.0;
+  }
+  return (size_ - 1 - first) * 1000.0 / span;
+}
+
+double FrameStats::GetCpuMs() const noexcept {
+  return size_ == 0 ? 0.0 : cpu_ms_[Slot_(size_ - 1)];
+}
+
+double FrameStats::GetMaxCpuMs() const noexcept {
+  double max_ms = 0.0;
+  for (size_t i = 0; i < size_; ++i) {
+    max_ms = std::max(max_ms, cpu_ms_[Slot_(i)]);
+  }
+  return max_ms;
+}
+
+double FrameStats::GetCpuMsAt(size_t i) const noexcept {
+  return cpu_ms_[Slot_(i)];
+}
+
+}  // namespace s21
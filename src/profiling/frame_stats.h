@@ -0,0 +1,124 @@
+#ifndef PROFILING_FRAME_STATS_H
+#define PROFILING_FRAME_STATS_H
+
+/**
+ * @file frame_stats.h
+ * @brief Статистика кадров для оверлея производительности (HUD)
+ */
+
+#include <array>
+#include <cstddef>
+
+namespace s21 {
+
+/**
+ * @brief Счётчики отрисовки одного кадра
+ */
+struct RenderCounters {
+  size_t edges_submitted = 0;  ///< Рёбер передано в OpenGL
+  size_t edges_culled = 0;     ///< Рёбер отброшено до передачи
+  size_t upload_bytes = 0;     ///< Байт вершинных данных передано за кадр
+};
+
+/**
+ * @brief Длительности последних операций контроллера
+ */
+struct OperationTimings {
+  double load_ms = 0.0;       ///< Последняя загрузка модели, мс
+  double transform_ms = 0.0;  ///< Последняя трансформация, мс
+};
+
+/**
+ * @brief Скользящая история времени кадров
+ *
+ * Хранит последние kHistorySize кадров в кольцевом буфере фиксированного
+ * размера: добавление кадра не выделяет память и стоит O(1).
+ *
+ * @example
+ * @code
+ * FrameStats stats;
+ * stats.AddFrame(now_ms, cpu_ms);
+ * double fps = stats.GetFps();
+ * @endcode
+ */
+class FrameStats {
+ public:
+  static constexpr size_t kHistorySize = 120;  ///< Кадров в истории
+  static constexpr double kFpsWindowMs = 1000.0;  ///< Окно подсчёта FPS
+
+  /**
+   * @brief Добавляет кадр в историю
+   * @param timestamp_ms Момент начала кадра в миллисекундах
+   * @param cpu_ms Время CPU на кадр в миллисекундах
+   */
+  void AddFrame(double timestamp_ms, double cpu_ms) noexcept;
+
+  /**
+   * @brief Сохраняет время GPU последнего измеренного кадра
+   * @param gpu_ms Время GPU в миллисекундах
+   */
+  void SetGpuMs(double gpu_ms) noexcept { gpu_ms_ = gpu_ms; }
+
+  /**
+   * @brief Сохраняет счётчики отрисовки последнего кадра
+   */
+  void SetCounters(const RenderCounters& counters) noexcept {
+    counters_ = counters;
+  }
+
+  /**
+   * @brief Возвращает частоту кадров за последнюю секунду
+   * @return Кадров в секунду или 0, если кадров меньше двух
+   */
+  double GetFps() const noexcept;
+
+  /**
+   * @brief Возвращает время CPU последнего кадра, мс
+   */
+  double GetCpuMs() const noexcept;
+
+  /**
+   * @brief Возвращает время GPU, мс (отрицательно, если не измерялось)
+   */
+  double GetGpuMs() const noexcept { return gpu_ms_; }
+
+  /**
+   * @brief Возвращает максимальное время CPU в истории, мс
+   */
+  double GetMaxCpuMs() const noexcept;
+
+  /**
+   * @brief Возвращает счётчики отрисовки последнего кадра
+   */
+  const RenderCounters& GetCounters() const noexcept { return counters_; }
+
+  /**
+   * @brief Возвращает количество кадров в истории
+   */
+  size_t GetHistorySize() const noexcept { return size_; }
+
+  /**
+   * @brief Возвращает время CPU кадра из истории
+   * @param i Номер кадра от старого к новому, i < GetHistorySize()
+   */
+  double GetCpuMsAt(size_t i) const noexcept;
+
+ private:
+  /**
+   * @brief Индекс кольцевого буфера для i-го кадра от старого к новому
+   */
+  size_t Slot_(size_t i) const noexcept {
+    return (head_ + kHistorySize - size_ + i) % kHistorySize;
+  }
+
+  std::array<double, kHistorySize> timestamps_ms_{};  ///< Начала кадров
+  std::array<double, kHistorySize> cpu_ms_{};         ///< Время CPU кадров
+  size_t head_ = 0;             ///< Слот для следующего кадра
+  size_t size_ = 0;             ///< Заполненность истории
+  double gpu_ms_ = -1.0;        ///< Время GPU последнего измерения
+  RenderCounters counters_;     ///< Счётчики последнего кадра
+};
+
+}  // namespace s21
+
+#endif  // PROFILING_FRAME_STATS_H
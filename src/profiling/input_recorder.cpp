@@ -0,0 +1,156 @@
+/**
+ * @file input_recorder.cpp
+ * @brief Реализация записи пользовательского ввода
+ */
+
+#include "input_recorder.h"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace s21 {
+
+namespace {
+
+constexpr char kSignature[8] = {'S', '2', '1', 'R', 'E', 'C', '1', '\0'};
+constexpr uint64_t kMaxTextLength = 1 << 16;
+
+void WriteVarint(std::string& out, uint64_t value) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<char>(value));
+}
+
+void WriteSigned(std::string& out, int32_t value) {
+  // zigzag: малые по модулю отрицательные числа тоже занимают 1-2 байта
+  const uint32_t zigzag = (static_cast<uint32_t>(value) << 1) ^
+                          static_cast<uint32_t>(value >> 31);
+  WriteVarint(out, zigzag);
+}
+
+bool ReadVarint(const std::string& in, size_t& pos, uint64_t& value) {
+  value = 0;
+  for (int shift = 0; shift < 64 && pos < in.size(); shift += 7) {
+    const uint8_t byte = static_cast<uint8_t>(in[pos++]);
+    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) return true;
+  }
+  return false;
+}
+
+bool ReadSigned(const std::string& in, size_t& pos, int32_t& value) {
+  uint64_t zigzag = 0;
+  if (!ReadVarint(in, pos, zigzag)) return false;
+  const uint32_t bits = static_cast<uint32_t>(zigzag);
+  value = static_cast<int32_t>((bits >> 1) ^ (~(bits & 1) + 1));
+  return true;
+}
+
+}  // namespace
+
+InputRecorder& InputRecorder::GetInstance() noexcept {
+  static InputRecorder instance;
+  return instance;
+}
+
+void InputRecorder::Start() {
+  events_.clear();
+  start_ = std::chrono::steady_clock::now();
+  recording_ = true;
+}
+
+void InputRecorder::Record(recorded_event_t type, int32_t a, int32_t b,
+                           int32_t c, const std::string& text) {
+  if (!recording_) {
+    return;
+  }
+
+  RecordedEvent event;
+  event.time_us = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - start_)
+          .count());
+  event.type = type;
+  event.a = a;
+  event.b = b;
+  event.c = c;
+  event.text = text;
+  events_.push_back(std::move(event));
+}
+
+bool InputRecorder::Save(const std::string& path) const {
+  return SaveEvents(path, events_);
+}
+
+bool InputRecorder::SaveEvents(const std::string& path,
+                               const std::vector<RecordedEvent>& events) {
+  std::string data(kSignature, sizeof(kSignature));
+  WriteVarint(data, events.size());
+
+  uint64_t previous_us = 0;
+  for (const RecordedEvent& event : events) {
+    WriteVarint(data, event.time_us - previous_us);
+    previous_us = event.time_us;
+    data.push_back(static_cast<char>(event.type));
+    WriteSigned(data, event.a);
+    WriteSigned(data, event.b);
+    WriteSigned(data, event.c);
+    WriteVarint(data, event.text.size());
+    data += event.text;
+  }
+
+  std::ofstream file(path, std::ios::binary);
+  file.write(data.data(), static_cast<std::streamsize>(data.size()));
+  return static_cast<bool>(file);
+}
+
+bool InputRecorder::LoadEvents(const std::string& path,
+                               std::vector<RecordedEvent>& events) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file.is_open()) {
+    return false;
+  }
+  const std::string data((std::istreambuf_iterator<char>(file)),
+                         std::istreambuf_iterator<char>());
+
+  if (data.size() < sizeof(kSignature) ||
+      std::memcmp(data.data(), kSignature, sizeof(kSignature)) != 0) {
+    return false;
+  }
+
+  size_t pos = sizeof(kSignature);
+  uint64_t count = 0;
+  if (!ReadVarint(data, pos, count)) {
+    return false;
+  }
+
+  events.clear();
+  uint64_t time_us = 0;
+  for (uint64_t i = 0; i < count; ++i) {
+    RecordedEvent event;
+    uint64_t delta = 0;
+    uint64_t text_length = 0;
+    if (!ReadVarint(data, pos, delta) || pos >= data.size()) return false;
+    const uint8_t type = static_cast<uint8_t>(data[pos++]);
+    if (type >= kEventTypeCount || !ReadSigned(data, pos, event.a) ||
+        !ReadSigned(data, pos, event.b) || !ReadSigned(data, pos, event.c) ||
+        !ReadVarint(data, pos, text_length) || text_length > kMaxTextLength ||
+        text_length > data.size() - pos) {
+      return false;
+    }
+
+    time_us += delta;
+    event.time_us = time_us;
+    event.type = static_cast<recorded_event_t>(type);
+    event.text.assign(data, pos, text_length);
+    pos += text_length;
+    events.push_back(std::move(event));
+  }
+
+  return true;
+}
+
+}  // namespace s21
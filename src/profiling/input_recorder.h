@@ -0,0 +1,141 @@
+#ifndef PROFILING_INPUT_RECORDER_H
+#define PROFILING_INPUT_RECORDER_H
+
+/**
+ * @file input_recorder.h
+ * @brief Запись пользовательского ввода для воспроизведения сессий
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace s21 {
+
+/**
+ * @brief Типы записываемых событий
+ */
+enum recorded_event_t : uint8_t {
+  kEventMousePress = 0,    ///< Нажатие кнопки мыши
+  kEventMouseMove = 1,     ///< Движение мыши
+  kEventMouseRelease = 2,  ///< Отпускание кнопки мыши
+  kEventWheel = 3,         ///< Прокрутка колёсика
+  kEventSlider = 4,        ///< Изменение значения слайдера
+  kEventLoad = 5,          ///< Загрузка файла модели
+  kEventTypeCount = 6      ///< Количество типов
+};
+
+/**
+ * @brief Записанное событие ввода
+ *
+ * Значение полей зависит от типа:
+ * - мышь: a = x, b = y, c = кнопка | (зажатые кнопки << 16)
+ * - колёсико: a = x, b = y, c = angleDelta().y()
+ * - слайдер: a = номер слайдера, b = значение
+ * - загрузка: text = путь к файлу
+ */
+struct RecordedEvent {
+  uint64_t time_us = 0;  ///< Время от начала записи, мкс
+  recorded_event_t type = kEventMouseMove;  ///< Тип события
+  int32_t a = 0;     ///< Первый параметр
+  int32_t b = 0;     ///< Второй параметр
+  int32_t c = 0;     ///< Третий параметр
+  std::string text;  ///< Строковый параметр (путь к файлу)
+
+  bool operator==(const RecordedEvent& other) const {
+    return time_us == other.time_us && type == other.type && a == other.a &&
+           b == other.b && c == other.c && text == other.text;
+  }
+};
+
+/**
+ * @brief Регистратор ввода (Singleton)
+ *
+ * Во время записи точки входа ввода (View, OpenGLWidget) передают события
+ * в Record(). Сессия сохраняется в компактный бинарный файл: сигнатура,
+ * затем для каждого события - приращение времени и параметры в виде
+ * zigzag-varint. Типичное событие мыши занимает 5-8 байт.
+ *
+ * @example
+ * @code
+ * InputRecorder& recorder = InputRecorder::GetInstance();
+ * recorder.Start();
+ * recorder.Record(kEventSlider, 3, 45);
+ * recorder.Stop();
+ * recorder.Save("session.s21rec");
+ * @endcode
+ */
+class InputRecorder {
+ public:
+  /**
+   * @brief Возвращает единственный экземпляр регистратора
+   */
+  static InputRecorder& GetInstance() noexcept;
+
+  /**
+   * @brief Начинает новую запись (предыдущие события удаляются)
+   */
+  void Start();
+
+  /**
+   * @brief Останавливает запись
+   */
+  void Stop() noexcept { recording_ = false; }
+
+  /**
+   * @brief Проверяет, идёт ли запись
+   */
+  bool IsRecording() const noexcept { return recording_; }
+
+  /**
+   * @brief Добавляет событие с текущей отметкой времени
+   *
+   * Вне записи ничего не делает.
+   */
+  void Record(recorded_event_t type, int32_t a = 0, int32_t b = 0,
+              int32_t c = 0, const std::string& text = std::string());
+
+  /**
+   * @brief Возвращает записанные события
+   */
+  const std::vector<RecordedEvent>& GetEvents() const noexcept {
+    return events_;
+  }
+
+  /**
+   * @brief Сохраняет записанные события в файл
+   * @return true при успешной записи
+   */
+  bool Save(const std::string& path) const;
+
+  /**
+   * @brief Сохраняет события в файл в формате регистратора
+   * @return true при успешной записи
+   */
+  static bool SaveEvents(const std::string& path,
+                         const std::vector<RecordedEvent>& events);
+
+  /**
+   * @brief Читает события из файла
+   * @param path Путь к файлу записи
+   * @param events Выходной вектор событий
+   * @return false если файл не открыт или повреждён
+   */
+  static bool LoadEvents(const std::string& path,
+                         std::vector<RecordedEvent>& events);
+
+ private:
+  InputRecorder() = default;
+  ~InputRecorder() = default;
+  InputRecorder(const InputRecorder&) = delete;
+  InputRecorder& operator=(const InputRecorder&) = delete;
+
+  bool recording_ = false;  ///< Идёт запись
+  std::chrono::steady_clock::time_point start_;  ///< Начало записи
+  std::vector<RecordedEvent> events_;            ///< Записанные события
+};
+
+}  // namespace s21
+
+#endif  // PROFILING_INPUT_RECORDER_H
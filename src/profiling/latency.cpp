@@ -0,0 +1,158 @@
+/**
+ * @file latency.cpp
+ * @brief Реализация измерения задержки ввода
+ */
+
+#include "latency.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace s21 {
+
+namespace {
+
+constexpr const char* kInputNames[kInputKindCount] = {"slider", "mouse",
+                                                      "wheel", "automation"};
+constexpr const char* kStageNames[kStageCount] = {
+    "input", "requested", "transformed", "delivered", "presented"};
+
+double ToMicroseconds(LatencyTracker::Clock::duration duration) noexcept {
+  return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+}  // namespace
+
+void LatencyHistogram::Add(double latency_us) noexcept {
+  size_t bucket = 0;
+  if (latency_us >= 1.0) {
+    bucket = static_cast<size_t>(std::log2(latency_us));
+    if (bucket >= kBucketCount) bucket = kBucketCount - 1;
+  }
+
+  ++buckets_[bucket];
+  ++count_;
+  sum_us_ += latency_us;
+  if (latency_us > max_us_) max_us_ = latency_us;
+}
+
+double LatencyHistogram::GetPercentileUs(double fraction) const noexcept {
+  if (count_ == 0) {
+    return 0.0;
+  }
+
+  const double target = fraction * count_;
+  uint64_t seen = 0;
+  for (size_t i = 0; i < kBucketCount; ++i) {
+    seen += buckets_[i];
+    if (seen >= target && buckets_[i] > 0) {
+      // Верхняя граница корзины, но не больше наблюдавшегося максимума
+      return std::min(std::ldexp(1.0, static_cast<int>(i) + 1), max_us_);
+    }
+  }
+  return max_us_;
+}
+
+LatencyTracker& LatencyTracker::GetInstance() noexcept {
+  static LatencyTracker instance;
+  return instance;
+}
+
+void LatencyTracker::MarkInput(input_kind_t kind, Clock::time_point now) {
+  Pending& pending = pending_[kind];
+  if (pending.active) {
+    return;
+  }
+
+  pending = Pending();
+  pending.active = true;
+  pending.stamps[kStageInput] = now;
+  pending.reached[kStageInput] = true;
+}
+
+void LatencyTracker::MarkStage(latency_stage_t stage, Clock::time_point now) {
+  for (Pending& pending : pending_) {
+    if (pending.active && !pending.reached[stage]) {
+      pending.stamps[stage] = now;
+      pending.reached[stage] = true;
+    }
+  }
+}
+
+void LatencyTracker::MarkPresented(Clock::time_point now) {
+  for (size_t kind = 0; kind < kInputKindCount; ++kind) {
+    Pending& pending = pending_[kind];
+    if (!pending.active) {
+      continue;
+    }
+
+    pending.stamps[kStagePresented] = now;
+    pending.reached[kStagePresented] = true;
+
+    Clock::time_point previous = pending.stamps[kStageInput];
+    for (size_t stage = kStageRequested; stage < kStageCount; ++stage) {
+      if (!pending.reached[stage]) continue;
+      stages_[kind][stage].Add(
+          ToMicroseconds(pending.stamps[stage] - previous));
+      previous = pending.stamps[stage];
+    }
+
+    total_[kind].Add(ToMicroseconds(now - pending.stamps[kStageInput]));
+    pending.active = false;
+  }
+}
+
+std::string LatencyTracker::Report() const {
+  std::string report;
+  char line[160];
+
+  for (size_t kind = 0; kind < kInputKindCount; ++kind) {
+    const LatencyHistogram& total = total_[kind];
+    if (total.GetCount() == 0) continue;
+
+    std::snprintf(line, sizeof(line),
+                  "%s: n=%llu mean=%.2f ms p50<=%.2f ms p90<=%.2f ms "
+                  "p99<=%.2f ms max=%.2f ms\n",
+                  kInputNames[kind],
+                  static_cast<unsigned long long>(total.GetCount()),
+                  total.GetMeanUs() / 1000.0,
+                  total.GetPercentileUs(0.5) / 1000.0,
+                  total.GetPercentileUs(0.9) / 1000.0,
+                  total.GetPercentileUs(0.99) / 1000.0,
+                  total.GetMaxUs() / 1000.0);
+    report += line;
+
+    for (size_t stage = kStageRequested; stage < kStageCount; ++stage) {
+      const LatencyHistogram& histogram = stages_[kind][stage];
+      if (histogram.GetCount() == 0) continue;
+      std::snprintf(line, sizeof(line),
+                    "  -> %-11s mean=%.3f ms max=%.3f ms\n", kStageNames[stage],
+                    histogram.GetMeanUs() / 1000.0,
+                    histogram.GetMaxUs() / 1000.0);
+      report += line;
+    }
+
+    report += "  histogram:";
+    for (size_t i = 0; i < LatencyHistogram::kBucketCount; ++i) {
+      if (total.GetBucket(i) == 0) continue;
+      std::snprintf(line, sizeof(line), " [<%.0fus]=%llu",
+                    std::ldexp(1.0, static_cast<int>(i) + 1),
+                    static_cast<unsigned long long>(total.GetBucket(i)));
+      report += line;
+    }
+    report += '\n';
+  }
+
+  return report;
+}
+
+void LatencyTracker::Clear() noexcept {
+  pending_ = {};
+  for (auto& histogram : total_) histogram.Clear();
+  for (auto& per_kind : stages_) {
+    for (auto& histogram : per_kind) histogram.Clear();
+  }
+}
+
+}  // namespace s21
@@ -0,0 +1,199 @@
+#ifndef PROFILING_LATENCY_H
+#define PROFILING_LATENCY_H
+
+/**
+ * @file latency.h
+ * @brief Измерение задержки от ввода до вывода кадра (input-to-photon)
+ */
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace s21 {
+
+/**
+ * @brief Источники пользовательского ввода
+ */
+enum input_kind_t {
+  kInputSlider = 0,  ///< Изменение значения слайдера трансформации
+  kInputMouse = 1,   ///< Вращение модели перетаскиванием мыши
+  kInputWheel = 2,   ///< Масштабирование колёсиком мыши
+  kInputAutomation = 3,  ///< Команда канала автоматизации
+  kInputKindCount = 4    ///< Количество источников
+};
+
+/**
+ * @brief Этапы прохождения события ввода через приложение
+ */
+enum latency_stage_t {
+  kStageInput = 0,        ///< Событие получено View/OpenGLWidget
+  kStageRequested = 1,    ///< Испущен View::TransformRequested
+  kStageTransformed = 2,  ///< Controller::TransformModel изменил модель
+  kStageDelivered = 3,    ///< View обработал ModelTransformed
+  kStagePresented = 4,    ///< Кадр выведен (frameSwapped после paintGL)
+  kStageCount = 5         ///< Количество этапов
+};
+
+/**
+ * @brief Гистограмма задержек с логарифмическими корзинами
+ *
+ * Корзина i содержит задержки в диапазоне [2^i, 2^(i+1)) микросекунд.
+ * Добавление значения стоит O(1) и не выделяет память.
+ */
+class LatencyHistogram {
+ public:
+  static constexpr size_t kBucketCount = 32;  ///< Количество корзин
+
+  /**
+   * @brief Добавляет значение задержки
+   * @param latency_us Задержка в микросекундах
+   */
+  void Add(double latency_us) noexcept;
+
+  /**
+   * @brief Возвращает количество значений
+   */
+  uint64_t GetCount() const noexcept { return count_; }
+
+  /**
+   * @brief Возвращает среднюю задержку, мкс
+   */
+  double GetMeanUs() const noexcept {
+    return count_ == 0 ? 0.0 : sum_us_ / count_;
+  }
+
+  /**
+   * @brief Возвращает максимальную задержку, мкс
+   */
+  double GetMaxUs() const noexcept { return max_us_; }
+
+  /**
+   * @brief Оценивает перцентиль по корзинам
+   * @param fraction Доля в диапазоне [0, 1], например 0.99
+   * @return Верхняя граница корзины, содержащей перцентиль, мкс
+   */
+  double GetPercentileUs(double fraction) const noexcept;
+
+  /**
+   * @brief Возвращает количество значений в корзине
+   * @param bucket Номер корзины, bucket < kBucketCount
+   */
+  uint64_t GetBucket(size_t bucket) const noexcept {
+    return buckets_[bucket];
+  }
+
+  /**
+   * @brief Очищает гистограмму
+   */
+  void Clear() noexcept { *this = LatencyHistogram(); }
+
+ private:
+  std::array<uint64_t, kBucketCount> buckets_{};  ///< Счётчики корзин
+  uint64_t count_ = 0;                            ///< Всего значений
+  double sum_us_ = 0.0;                           ///< Сумма задержек
+  double max_us_ = 0.0;                           ///< Максимум
+};
+
+/**
+ * @brief Трекер задержки ввода (Singleton)
+ *
+ * Событие ввода отмечается в точке входа, затем проходит этапы
+ * TransformRequested → Controller::TransformModel → ModelTransformed →
+ * вывод кадра. Если до вывода кадра приходит несколько событий одного
+ * источника, задержка считается от самого раннего: именно его пользователь
+ * ждёт дольше всего.
+ *
+ * @note Все методы вызываются из GUI-потока.
+ *
+ * @example
+ * @code
+ * LatencyTracker& tracker = LatencyTracker::GetInstance();
+ * tracker.MarkInput(kInputSlider);
+ * tracker.MarkStage(kStageRequested);
+ * // ... трансформация и отрисовка ...
+ * tracker.MarkPresented();
+ * std::string report = tracker.Report();
+ * @endcode
+ */
+class LatencyTracker {
+ public:
+  using Clock = std::chrono::steady_clock;  ///< Часы для отметок времени
+
+  /**
+   * @brief Возвращает единственный экземпляр трекера
+   */
+  static LatencyTracker& GetInstance() noexcept;
+
+  /**
+   * @brief Отмечает поступление события ввода
+   * @param kind Источник ввода
+   * @param now Момент поступления (по умолчанию - текущий)
+   */
+  void MarkInput(input_kind_t kind, Clock::time_point now = Clock::now());
+
+  /**
+   * @brief Отмечает прохождение этапа всеми ожидающими событиями
+   * @param stage Промежуточный этап (kStageRequested..kStageDelivered)
+   * @param now Момент прохождения
+   */
+  void MarkStage(latency_stage_t stage, Clock::time_point now = Clock::now());
+
+  /**
+   * @brief Отмечает вывод кадра и закрывает ожидающие события
+   * @param now Момент вывода кадра
+   */
+  void MarkPresented(Clock::time_point now = Clock::now());
+
+  /**
+   * @brief Возвращает гистограмму полной задержки для источника
+   */
+  const LatencyHistogram& GetHistogram(input_kind_t kind) const noexcept {
+    return total_[kind];
+  }
+
+  /**
+   * @brief Возвращает гистограмму задержки этапа для источника
+   * @param kind Источник ввода
+   * @param stage Этап; задержка считается от предыдущего пройденного этапа
+   */
+  const LatencyHistogram& GetStageHistogram(
+      input_kind_t kind, latency_stage_t stage) const noexcept {
+    return stages_[kind][stage];
+  }
+
+  /**
+   * @brief Формирует текстовый отчёт по всем источникам
+   */
+  std::string Report() const;
+
+  /**
+   * @brief Сбрасывает накопленную статистику и ожидающие события
+   */
+  void Clear() noexcept;
+
+ private:
+  LatencyTracker() = default;
+  ~LatencyTracker() = default;
+  LatencyTracker(const LatencyTracker&) = delete;
+  LatencyTracker& operator=(const LatencyTracker&) = delete;
+
+  /**
+   * @brief Ожидающее вывода событие ввода
+   */
+  struct Pending {
+    bool active = false;  ///< Событие ждёт вывода кадра
+    std::array<Clock::time_point, kStageCount> stamps{};  ///< Отметки этапов
+    std::array<bool, kStageCount> reached{};  ///< Пройденные этапы
+  };
+
+  std::array<Pending, kInputKindCount> pending_{};  ///< По одному на источник
+  std::array<LatencyHistogram, kInputKindCount> total_{};  ///< Полная задержка
+  std::array<std::array<LatencyHistogram, kStageCount>, kInputKindCount>
+      stages_{};  ///< Задержки этапов
+};
+
+}  // namespace s21
+
+#endif  // PROFILING_LATENCY_H
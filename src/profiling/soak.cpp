@@ -0,0 +1,146 @@
+/**
+ * @file soak.cpp
+ * @brief Реализация сценария и проверки дрейфа soak-прогонов
+ */
+
+#include "soak.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace s21 {
+
+namespace {
+
+constexpr int kSliderMove = 0;
+constexpr int kSliderRotateX = 3;
+constexpr int kSliderRotateY = 4;
+constexpr int kSliderScale = 6;
+constexpr int kLeftButton = 1;  ///< Qt::LeftButton
+
+double Median(std::vector<double>& values) {
+  const size_t middle = values.size() / 2;
+  std::nth_element(values.begin(), values.begin() + middle, values.end());
+  return values[middle];
+}
+
+}  // namespace
+
+std::string DriftReport::Summary() const {
+  char text[512];
+  std::snprintf(text, sizeof(text),
+                "samples: %zu, windows: %zu\n"
+                "rss: %.0f -> %.0f KiB%s\n"
+                "frame: %.3f -> %.3f ms%s\n",
+                samples, windows_used, rss_start_kb, rss_end_kb,
+                rss_growth ? " [GROWTH]" : "", frame_start_ms, frame_end_ms,
+                frame_drift ? " [DRIFT]" : "");
+  return text;
+}
+
+DriftReport CheckDrift(const std::vector<TelemetrySample>& samples,
+                       const DriftThresholds& thresholds) {
+  DriftReport report;
+  report.samples = samples.size();
+  const size_t window_count = std::max<size_t>(thresholds.windows, 2);
+  if (samples.empty()) {
+    return report;
+  }
+
+  const auto [first, last] = std::minmax_element(
+      samples.begin(), samples.end(),
+      [](const TelemetrySample& a, const TelemetrySample& b) {
+        return a.time_s < b.time_s;
+      });
+  const double start_s = first->time_s;
+  const double span_s = std::max(last->time_s - start_s, 1e-9);
+
+  std::vector<std::vector<double>> rss(window_count);
+  std::vector<std::vector<double>> frames(window_count);
+  for (const TelemetrySample& sample : samples) {
+    const size_t window = std::min(
+        static_cast<size_t>((sample.time_s - start_s) / span_s * window_count),
+        window_count - 1);
+    if (sample.rss_kb >= 0) rss[window].push_back(sample.rss_kb);
+    if (sample.kind == kTelemetryFrame) {
+      frames[window].push_back(sample.duration_ms);
+    }
+  }
+
+  // Окно 0 - прогрев: кэши, первые загрузки, ленивые инициализации
+  std::vector<double> rss_medians;
+  std::vector<double> frame_medians;
+  for (size_t window = 1; window < window_count; ++window) {
+    if (!rss[window].empty()) rss_medians.push_back(Median(rss[window]));
+    if (!frames[window].empty()) {
+      frame_medians.push_back(Median(frames[window]));
+    }
+  }
+  report.windows_used = rss_medians.size();
+
+  if (!rss_medians.empty()) {
+    report.rss_start_kb = rss_medians.front();
+    report.rss_end_kb = rss_medians.back();
+    report.rss_growth =
+        rss_medians.size() >= 3 &&
+        std::is_sorted(rss_medians.begin(), rss_medians.end()) &&
+        report.rss_end_kb - report.rss_start_kb > thresholds.rss_growth_kb;
+  }
+
+  if (!frame_medians.empty()) {
+    report.frame_start_ms = frame_medians.front();
+    report.frame_end_ms = frame_medians.back();
+    const double growth = report.frame_end_ms - report.frame_start_ms;
+    report.frame_drift =
+        growth > thresholds.frame_drift_min_ms &&
+        growth > report.frame_start_ms * thresholds.frame_drift_ratio;
+  }
+
+  return report;
+}
+
+std::vector<RecordedEvent> BuildSoakScript(
+    const std::vector<std::string>& models, int steps) {
+  std::vector<RecordedEvent> script;
+  uint64_t time_us = 0;
+  auto add = [&script, &time_us](recorded_event_t type, int32_t a, int32_t b,
+                                 int32_t c, const std::string& text = "") {
+    script.push_back({time_us, type, a, b, c, text});
+    time_us += kSoakStepUs;
+  };
+
+  constexpr double kPi = 3.14159265358979323846;
+  for (const std::string& model : models) {
+    add(kEventLoad, 0, 0, 0, model);
+
+    for (int step = 0; step < steps; ++step) {
+      const double phase = 2.0 * kPi * step / std::max(steps, 1);
+      add(kEventSlider, kSliderRotateX, (step * 6) % 361 - 180, 0);
+      add(kEventSlider, kSliderRotateY,
+          static_cast<int32_t>(180 * std::sin(phase)), 0);
+      add(kEventSlider, kSliderMove,
+          static_cast<int32_t>(50 * std::cos(phase)), 0);
+      add(kEventSlider, kSliderScale,
+          100 + static_cast<int32_t>(50 * std::sin(phase)), 0);
+    }
+
+    // Вращение мышью: нажатие, полукруг, отпускание
+    add(kEventMousePress, 400, 300, kLeftButton | (kLeftButton << 16));
+    for (int step = 0; step < steps; ++step) {
+      const double phase = kPi * step / std::max(steps, 1);
+      add(kEventMouseMove, 400 + static_cast<int32_t>(200 * std::cos(phase)),
+          300 + static_cast<int32_t>(150 * std::sin(phase)),
+          kLeftButton << 16);
+    }
+    add(kEventMouseRelease, 400, 300, kLeftButton);
+
+    for (int step = 0; step < 8; ++step) {
+      add(kEventWheel, 400, 300, step < 4 ? 120 : -120);
+    }
+  }
+
+  return script;
+}
+
+}  // namespace s21
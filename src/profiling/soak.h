@@ -0,0 +1,84 @@
+#ifndef PROFILING_SOAK_H
+#define PROFILING_SOAK_H
+
+/**
+ * @file soak.h
+ * @brief Сценарий и проверка дрейфа для длительных (soak) прогонов
+ */
+
+#include <string>
+#include <vector>
+
+#include "input_recorder.h"
+#include "telemetry.h"
+
+namespace s21 {
+
+constexpr uint64_t kSoakStepUs = 16000;  ///< Шаг встроенного сценария, мкс
+
+/**
+ * @brief Пороги проверки дрейфа
+ */
+struct DriftThresholds {
+  size_t windows = 8;  ///< Число временных окон (первое - прогрев)
+  double rss_growth_kb = 16384.0;  ///< Допустимый рост RSS за прогон, КиБ
+  double frame_drift_ratio = 0.25;  ///< Допустимый относительный рост кадра
+  double frame_drift_min_ms = 0.5;  ///< Рост кадра меньше этого - шум, мс
+};
+
+/**
+ * @brief Результат проверки дрейфа
+ */
+struct DriftReport {
+  size_t samples = 0;          ///< Проанализировано строк
+  size_t windows_used = 0;     ///< Непустых окон после прогрева
+  bool rss_growth = false;     ///< Обнаружен монотонный рост RSS
+  bool frame_drift = false;    ///< Обнаружен рост времени кадра
+  double rss_start_kb = 0.0;   ///< Медиана RSS в первом окне после прогрева
+  double rss_end_kb = 0.0;     ///< Медиана RSS в последнем окне
+  double frame_start_ms = 0.0;  ///< Медиана кадра в первом окне
+  double frame_end_ms = 0.0;    ///< Медиана кадра в последнем окне
+
+  /**
+   * @brief Проверяет, обнаружен ли какой-либо дрейф
+   */
+  bool HasDrift() const noexcept { return rss_growth || frame_drift; }
+
+  /**
+   * @brief Формирует текстовую сводку
+   */
+  std::string Summary() const;
+};
+
+/**
+ * @brief Проверяет телеметрию на утечку памяти и деградацию кадра
+ *
+ * Прогон делится на равные по времени окна, первое окно отбрасывается как
+ * прогрев. В каждом окне берутся медианы RSS и времени кадра - медиана
+ * устойчива к разовым всплескам (загрузка большой модели, сборка кэша).
+ *
+ * - Рост RSS: медианы не убывают во всех окнах (не менее трёх) и итоговый
+ *   рост превышает rss_growth_kb.
+ * - Дрейф кадра: медиана последнего окна выше первой более чем на
+ *   frame_drift_ratio и более чем на frame_drift_min_ms.
+ */
+DriftReport CheckDrift(const std::vector<TelemetrySample>& samples,
+                       const DriftThresholds& thresholds = DriftThresholds());
+
+/**
+ * @brief Строит встроенный сценарий soak-прогона
+ *
+ * Для каждой модели: загрузка, проход всех слайдеров по диапазону,
+ * вращение мышью и масштабирование колёсиком. События идут с шагом
+ * kSoakStepUs, сценарий воспроизводится InputReplayer по кругу.
+ *
+ * @param models Пути к OBJ файлам
+ * @param steps Шагов трансформации на модель
+ * @return События в формате InputRecorder
+ */
+std::vector<RecordedEvent> BuildSoakScript(
+    const std::vector<std::string>& models, int steps = 120);
+
+}  // namespace s21
+
+#endif  // PROFILING_SOAK_H
@@ -0,0 +1,216 @@
+/**
+ * @file stall_watchdog.cpp
+ * @brief Реализация сторожевого потока
+ */
+
+#include "stall_watchdog.h"
+
+#include <execinfo.h>
+#include <signal.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+#include "trace.h"
+
+namespace s21 {
+
+namespace {
+
+constexpr int kStackSignal = SIGUSR2;  ///< Сигнал для снятия стека
+constexpr int kStackWaitMs = 100;      ///< Ожидание обработчика сигнала
+
+void* g_stack_frames[StallWatchdog::kMaxStackDepth];
+std::atomic<int> g_stack_depth{-1};
+std::mutex g_capture_mutex;
+std::once_flag g_handler_once;
+
+/**
+ * @brief Обработчик сигнала: снимает стек прерванного потока
+ */
+void StackSignalHandler(int) {
+  const int depth = backtrace(
+      g_stack_frames, static_cast<int>(StallWatchdog::kMaxStackDepth));
+  g_stack_depth.store(depth, std::memory_order_release);
+}
+
+void InstallStackHandler() {
+  std::call_once(g_handler_once, [] {
+    // Первый вызов backtrace загружает libgcc - делаем это вне обработчика
+    void* warmup[1];
+    backtrace(warmup, 1);
+
+    struct sigaction action {};
+    action.sa_handler = StackSignalHandler;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    sigaction(kStackSignal, &action, nullptr);
+  });
+}
+
+}  // namespace
+
+StallWatchdog::StallWatchdog(std::chrono::milliseconds threshold,
+                             size_t log_capacity)
+    : threshold_(threshold), log_capacity_(std::max<size_t>(log_capacity, 1)) {}
+
+StallWatchdog::~StallWatchdog() { Stop(); }
+
+void StallWatchdog::SetPingFunction(std::function<void()> ping) {
+  ping_ = std::move(ping);
+}
+
+void StallWatchdog::Start() {
+  if (thread_.joinable()) {
+    return;
+  }
+
+  InstallStackHandler();
+  target_ = pthread_self();
+  target_span_ = &Tracer::ActiveSpan();
+  started_ns_ = NowNs_();
+  last_heartbeat_ns_.store(started_ns_, std::memory_order_relaxed);
+  stop_requested_ = false;
+  thread_ = std::thread(&StallWatchdog::Run_, this);
+}
+
+void StallWatchdog::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(wake_mutex_);
+    stop_requested_ = true;
+  }
+  wake_cv_.notify_all();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void StallWatchdog::Heartbeat() noexcept {
+  last_heartbeat_ns_.store(NowNs_(), std::memory_order_relaxed);
+}
+
+int64_t StallWatchdog::NowNs_() noexcept {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void StallWatchdog::Run_() {
+  const auto period =
+      std::max(threshold_ / 4, std::chrono::milliseconds(1));
+  const int64_t threshold_ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(threshold_).count();
+
+  bool stalled = false;
+  int64_t stall_begin_ns = 0;
+  StallRecord current;
+
+  auto finish_stall = [this, &current, &stall_begin_ns](int64_t end_ns) {
+    current.duration_ms = (end_ns - stall_begin_ns) / 1e6;
+
+    std::lock_guard<std::mutex> lock(log_mutex_);
+    ++total_stalls_;
+    ++counts_[current.span];
+    if (log_.size() == log_capacity_) log_.pop_front();
+    log_.push_back(std::move(current));
+  };
+
+  std::unique_lock<std::mutex> lock(wake_mutex_);
+  while (!stop_requested_) {
+    wake_cv_.wait_for(lock, period);
+    if (stop_requested_) break;
+    lock.unlock();
+
+    const int64_t now = NowNs_();
+    const int64_t heartbeat =
+        last_heartbeat_ns_.load(std::memory_order_relaxed);
+
+    if (!stalled && now - heartbeat > threshold_ns) {
+      stalled = true;
+      stall_begin_ns = heartbeat;
+      current = StallRecord();
+      current.started_ms = (heartbeat - started_ns_) / 1e6;
+      const char* span = target_span_->load(std::memory_order_acquire);
+      current.span = span ? span : "unknown";
+      current.stack = CaptureStack_();
+    } else if (stalled && heartbeat > stall_begin_ns) {
+      stalled = false;
+      finish_stall(heartbeat);
+    }
+
+    if (ping_) ping_();
+    lock.lock();
+  }
+
+  if (stalled) {
+    finish_stall(NowNs_());
+  }
+}
+
+std::vector<std::string> StallWatchdog::CaptureStack_() {
+  std::lock_guard<std::mutex> lock(g_capture_mutex);
+  g_stack_depth.store(-1, std::memory_order_release);
+  if (pthread_kill(target_, kStackSignal) != 0) {
+    return {};
+  }
+
+  int depth = -1;
+  for (int waited = 0; waited < kStackWaitMs && depth < 0; ++waited) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    depth = g_stack_depth.load(std::memory_order_acquire);
+  }
+  if (depth <= 0) {
+    return {"<стек недоступен>"};
+  }
+
+  std::vector<std::string> stack;
+  char** symbols = backtrace_symbols(g_stack_frames, depth);
+  if (symbols) {
+    stack.assign(symbols, symbols + depth);
+    std::free(symbols);
+  }
+  return stack;
+}
+
+std::vector<StallRecord> StallWatchdog::GetLog() const {
+  std::lock_guard<std::mutex> lock(log_mutex_);
+  return std::vector<StallRecord>(log_.begin(), log_.end());
+}
+
+std::map<std::string, size_t> StallWatchdog::GetStallCounts() const {
+  std::lock_guard<std::mutex> lock(log_mutex_);
+  return counts_;
+}
+
+size_t StallWatchdog::GetStallCount() const {
+  std::lock_guard<std::mutex> lock(log_mutex_);
+  return total_stalls_;
+}
+
+std::string StallWatchdog::Report() const {
+  std::lock_guard<std::mutex> lock(log_mutex_);
+  std::string report;
+  char line[256];
+
+  std::snprintf(line, sizeof(line), "stalls > %lld ms: %zu\n",
+                static_cast<long long>(threshold_.count()), total_stalls_);
+  report += line;
+  for (const auto& [cause, count] : counts_) {
+    std::snprintf(line, sizeof(line), "  %s: %zu\n", cause.c_str(), count);
+    report += line;
+  }
+
+  for (const StallRecord& record : log_) {
+    std::snprintf(line, sizeof(line), "stall at %.0f ms, %.0f ms in %s\n",
+                  record.started_ms, record.duration_ms, record.span.c_str());
+    report += line;
+    for (const std::string& frame : record.stack) {
+      report += "    " + frame + '\n';
+    }
+  }
+
+  return report;
+}
+
+}  // namespace s21
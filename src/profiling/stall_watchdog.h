@@ -0,0 +1,167 @@
+#ifndef PROFILING_STALL_WATCHDOG_H
+#define PROFILING_STALL_WATCHDOG_H
+
+/**
+ * @file stall_watchdog.h
+ * @brief Сторожевой поток для обнаружения зависаний GUI-потока
+ */
+
+#include <pthread.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace s21 {
+
+
+/**
+ * @brief Запись о зависании наблюдаемого потока
+ */
+struct StallRecord {
+  double duration_ms = 0.0;  ///< Длительность зависания
+  double started_ms = 0.0;   ///< Начало зависания от запуска сторожа
+  std::string span;  ///< Активный интервал трассировки ("unknown" если нет)
+  std::vector<std::string> stack;  ///< Стек наблюдаемого потока
+};
+
+/**
+ * @brief Сторожевой поток, обнаруживающий зависания цикла событий
+ *
+ * Сторож периодически вызывает функцию ping, которая должна поставить в
+ * очередь наблюдаемого потока вызов Heartbeat(). Если ответ не приходит
+ * дольше порога, сторож считает поток зависшим: отправляет ему сигнал,
+ * обработчик которого снимает стек, и читает активный интервал
+ * трассировки. Когда поток оживает, запись с итоговой длительностью
+ * попадает в кольцевой журнал, а счётчик зависаний по причине
+ * (имени интервала) увеличивается.
+ *
+ * В нормальной работе стоимость - один ping за период и одна
+ * atomic-запись в Heartbeat().
+ *
+ * @note Снятие стека реализовано для Linux (pthread_kill + backtrace).
+ *
+ * @example
+ * @code
+ * StallWatchdog watchdog(std::chrono::milliseconds(100));
+ * watchdog.SetPingFunction([&watchdog] {
+ *   QMetaObject::invokeMethod(qApp, [&watchdog] { watchdog.Heartbeat(); },
+ *                             Qt::QueuedConnection);
+ * });
+ * watchdog.Start();  // из GUI-потока
+ * @endcode
+ */
+class StallWatchdog {
+ public:
+  static constexpr size_t kMaxStackDepth = 48;  ///< Глубина снимаемого стека
+
+  /**
+   * @brief Создаёт сторожа
+   * @param threshold Порог зависания
+   * @param log_capacity Размер журнала зависаний
+   */
+  explicit StallWatchdog(
+      std::chrono::milliseconds threshold = std::chrono::milliseconds(100),
+      size_t log_capacity = 64);
+
+  /**
+   * @brief Останавливает сторожевой поток
+   */
+  ~StallWatchdog();
+
+  StallWatchdog(const StallWatchdog&) = delete;
+  StallWatchdog& operator=(const StallWatchdog&) = delete;
+
+  /**
+   * @brief Устанавливает функцию опроса наблюдаемого потока
+   *
+   * Вызывается из сторожевого потока раз в период и должна асинхронно
+   * привести к вызову Heartbeat() в наблюдаемом потоке.
+   */
+  void SetPingFunction(std::function<void()> ping);
+
+  /**
+   * @brief Запускает наблюдение за текущим потоком
+   * @pre Вызывается из наблюдаемого потока
+   */
+  void Start();
+
+  /**
+   * @brief Останавливает наблюдение
+   */
+  void Stop();
+
+  /**
+   * @brief Сообщает, что наблюдаемый поток обработал события
+   */
+  void Heartbeat() noexcept;
+
+  /**
+   * @brief Возвращает копию журнала зависаний (от старых к новым)
+   */
+  std::vector<StallRecord> GetLog() const;
+
+  /**
+   * @brief Возвращает количество зависаний по причинам
+   */
+  std::map<std::string, size_t> GetStallCounts() const;
+
+  /**
+   * @brief Возвращает общее количество зависаний
+   */
+  size_t GetStallCount() const;
+
+  /**
+   * @brief Формирует текстовую сводку по зависаниям
+   */
+  std::string Report() const;
+
+ private:
+  /**
+   * @brief Основной цикл сторожевого потока
+   */
+  void Run_();
+
+  /**
+   * @brief Снимает стек наблюдаемого потока сигналом
+   * @return Символизированные кадры стека
+   */
+  std::vector<std::string> CaptureStack_();
+
+  /**
+   * @brief Возвращает монотонное время в наносекундах
+   */
+  static int64_t NowNs_() noexcept;
+
+  std::chrono::milliseconds threshold_;  ///< Порог зависания
+  size_t log_capacity_;                  ///< Размер журнала
+  std::function<void()> ping_;           ///< Опрос наблюдаемого потока
+
+  pthread_t target_{};                    ///< Наблюдаемый поток
+  /// Активный интервал трассы наблюдаемого потока
+  const std::atomic<const char*>* target_span_ = nullptr;
+  std::atomic<int64_t> last_heartbeat_ns_{0};  ///< Последний ответ
+  int64_t started_ns_ = 0;                     ///< Запуск сторожа
+
+  std::thread thread_;                ///< Сторожевой поток
+  std::mutex wake_mutex_;             ///< Для ожидания и остановки
+  std::condition_variable wake_cv_;   ///< Пробуждение при остановке
+  bool stop_requested_ = false;       ///< Запрошена остановка
+
+  mutable std::mutex log_mutex_;             ///< Защищает журнал и счётчики
+  std::deque<StallRecord> log_;              ///< Кольцевой журнал
+  std::map<std::string, size_t> counts_;     ///< Зависания по причинам
+  size_t total_stalls_ = 0;                  ///< Всего зависаний
+};
+
+}  // namespace s21
+
+#endif  // PROFILING_STALL_WATCHDOG_H
@@ -0,0 +1,83 @@
+/**
+ * @file startup_profiler.cpp
+ * @brief Реализация профилировщика запуска
+ */
+
+#include "startup_profiler.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace s21 {
+
+namespace {
+
+double ToMs(StartupProfiler::Clock::duration duration) noexcept {
+  return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+}  // namespace
+
+StartupProfiler& StartupProfiler::GetInstance() noexcept {
+  static StartupProfiler instance;
+  return instance;
+}
+
+void StartupProfiler::Mark(const char* phase) noexcept {
+  const Clock::time_point now = Clock::now();
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (count_ < kMaxMarks) {
+    marks_[count_++] = MarkEntry{phase, now};
+  }
+}
+
+void StartupProfiler::MarkOnce(const char* phase) noexcept {
+  const Clock::time_point now = Clock::now();
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (count_ < kMaxMarks && !Find_(phase)) {
+    marks_[count_++] = MarkEntry{phase, now};
+  }
+}
+
+double StartupProfiler::GetMarkMs(const char* phase) const noexcept {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const MarkEntry* entry = Find_(phase);
+  return entry ? ToMs(entry->time - origin_) : -1.0;
+}
+
+size_t StartupProfiler::GetMarkCount() const noexcept {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return count_;
+}
+
+std::string StartupProfiler::Report() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::string report = "startup:     phase ms      total ms\n";
+  char line[160];
+
+  Clock::time_point previous = origin_;
+  for (size_t i = 0; i < count_; ++i) {
+    std::snprintf(line, sizeof(line), "  %12.2f  %12.2f  %s\n",
+                  ToMs(marks_[i].time - previous),
+                  ToMs(marks_[i].time - origin_), marks_[i].phase);
+    report += line;
+    previous = marks_[i].time;
+  }
+  return report;
+}
+
+void StartupProfiler::Reset() noexcept {
+  std::lock_guard<std::mutex> lock(mutex_);
+  origin_ = Clock::now();
+  count_ = 0;
+}
+
+const StartupProfiler::MarkEntry* StartupProfiler::Find_(
+    const char* phase) const noexcept {
+  for (size_t i = 0; i < count_; ++i) {
+    if (std::strcmp(marks_[i].phase, phase) == 0) return &marks_[i];
+  }
+  return nullptr;
+}
+
+}  // namespace s21
@@ -0,0 +1,107 @@
+#ifndef PROFILING_STARTUP_PROFILER_H
+#define PROFILING_STARTUP_PROFILER_H
+
+/**
+ * @file startup_profiler.h
+ * @brief Разбивка времени запуска приложения по этапам
+ */
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <string>
+
+namespace s21 {
+
+/**
+ * @brief Профилировщик запуска (Singleton)
+ *
+ * Хранит отметки этапов запуска: имя и момент от начала отсчёта (первого
+ * обращения к профилировщику, то есть начала main). Отчёт показывает
+ * длительность каждого этапа и накопленное время до него - так видно,
+ * сколько стоят создание QApplication, setupUi, разбор таблицы стилей,
+ * создание GL контекста и первый кадр.
+ *
+ * Отметки хранятся в массиве фиксированного размера, лишние отбрасываются.
+ *
+ * @example
+ * @code
+ * StartupProfiler& startup = StartupProfiler::GetInstance();
+ * startup.Mark("main");
+ * QApplication app(argc, argv);
+ * startup.Mark("QApplication");
+ * ...
+ * std::fputs(startup.Report().c_str(), stderr);
+ * @endcode
+ */
+class StartupProfiler {
+ public:
+  using Clock = std::chrono::steady_clock;
+  static constexpr size_t kMaxMarks = 32;  ///< Максимум отметок
+
+  /**
+   * @brief Возвращает единственный экземпляр (начинает отсчёт)
+   */
+  static StartupProfiler& GetInstance() noexcept;
+
+  /**
+   * @brief Отмечает окончание этапа
+   * @param phase Имя этапа (строковый литерал)
+   */
+  void Mark(const char* phase) noexcept;
+
+  /**
+   * @brief Отмечает этап, только если он ещё не отмечен
+   *
+   * Для событий, которые повторяются, но интересны один раз (первый кадр).
+   */
+  void MarkOnce(const char* phase) noexcept;
+
+  /**
+   * @brief Возвращает момент отметки от начала отсчёта, мс
+   * @return -1, если этап не отмечен
+   */
+  double GetMarkMs(const char* phase) const noexcept;
+
+  /**
+   * @brief Возвращает количество отметок
+   */
+  size_t GetMarkCount() const noexcept;
+
+  /**
+   * @brief Формирует таблицу этапов: длительность, накопленное время, имя
+   */
+  std::string Report() const;
+
+  /**
+   * @brief Удаляет отметки и перезапускает отсчёт
+   */
+  void Reset() noexcept;
+
+ private:
+  struct MarkEntry {
+    const char* phase = nullptr;  ///< Имя этапа
+    Clock::time_point time;       ///< Момент отметки
+  };
+
+  StartupProfiler() noexcept : origin_(Clock::now()) {}
+  ~StartupProfiler() = default;
+  StartupProfiler(const StartupProfiler&) = delete;
+  StartupProfiler& operator=(const StartupProfiler&) = delete;
+
+  /**
+   * @brief Ищет отметку этапа
+   * @pre mutex_ захвачен
+   */
+  const MarkEntry* Find_(const char* phase) const noexcept;
+
+  mutable std::mutex mutex_;  ///< Отметки ставятся и из потока предзагрузки
+  Clock::time_point origin_;  ///< Начало отсчёта
+  std::array<MarkEntry, kMaxMarks> marks_{};  ///< Отметки этапов
+  size_t count_ = 0;                          ///< Количество отметок
+};
+
+}  // namespace s21
+
+#endif  // PROFILING_STARTUP_PROFILER_H
@@ -0,0 +1,130 @@
+/**
+ * @file telemetry.cpp
+ * @brief Реализация покадровой телеметрии
+ */
+
+#include "telemetry.h"
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+namespace s21 {
+
+namespace {
+
+constexpr const char* kCsvHeader =
+    "time_s,kind,duration_ms,rss_kb,heap_kb,cache_kb";
+constexpr const char* kKindNames[kTelemetryKindCount] = {"frame", "load",
+                                                         "transform"};
+
+}  // namespace
+
+MemoryStats ReadMemoryStats() noexcept {
+  MemoryStats stats;
+
+  // statm: размер, резидентные страницы, ... - читаем второе поле
+  if (std::FILE* statm = std::fopen("/proc/self/statm", "r")) {
+    long long size_pages = 0;
+    long long resident_pages = 0;
+    if (std::fscanf(statm, "%lld %lld", &size_pages, &resident_pages) == 2) {
+      stats.rss_kb = resident_pages * (sysconf(_SC_PAGESIZE) / 1024);
+    }
+    std::fclose(statm);
+  }
+
+#if defined(__GLIBC__) && \
+    (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+  const struct mallinfo2 info = mallinfo2();
+  stats.heap_kb = static_cast<int64_t>((info.uordblks + info.hblkhd) / 1024);
+#endif
+
+  return stats;
+}
+
+const char* TelemetryKindName(telemetry_kind_t kind) noexcept {
+  return kind < kTelemetryKindCount ? kKindNames[kind] : "unknown";
+}
+
+bool TelemetryWriter::Open(const std::string& path) {
+  file_.open(path, std::ios::out | std::ios::trunc);
+  if (!file_.is_open()) {
+    return false;
+  }
+
+  file_ << kCsvHeader << '\n';
+  start_ = std::chrono::steady_clock::now();
+  last_memory_ms_ = -kMemorySampleMs;
+  sample_count_ = 0;
+  return true;
+}
+
+void TelemetryWriter::Append(telemetry_kind_t kind, double duration_ms,
+                             int64_t cache_kb) {
+  if (!file_.is_open()) {
+    return;
+  }
+
+  const auto elapsed = std::chrono::steady_clock::now() - start_;
+  const int64_t elapsed_ms =
+      std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+  if (elapsed_ms - last_memory_ms_ >= kMemorySampleMs) {
+    memory_ = ReadMemoryStats();
+    last_memory_ms_ = elapsed_ms;
+  }
+
+  char line[160];
+  std::snprintf(line, sizeof(line), "%.4f,%s,%.4f,%lld,%lld,%lld\n",
+                std::chrono::duration<double>(elapsed).count(),
+                TelemetryKindName(kind), duration_ms,
+                static_cast<long long>(memory_.rss_kb),
+                static_cast<long long>(memory_.heap_kb),
+                static_cast<long long>(cache_kb));
+  file_ << line;
+  ++sample_count_;
+}
+
+bool ReadTelemetryCsv(const std::string& path,
+                      std::vector<TelemetrySample>& samples) {
+  std::ifstream file(path);
+  std::string line;
+  if (!file.is_open() || !std::getline(file, line) || line != kCsvHeader) {
+    return false;
+  }
+
+  samples.clear();
+  while (std::getline(file, line)) {
+    TelemetrySample sample;
+    char kind[16] = {};
+    long long rss_kb = 0;
+    long long heap_kb = 0;
+    long long cache_kb = 0;
+    if (std::sscanf(line.c_str(), "%lf,%15[^,],%lf,%lld,%lld,%lld",
+                    &sample.time_s, kind, &sample.duration_ms, &rss_kb,
+                    &heap_kb, &cache_kb) != 6) {
+      continue;
+    }
+
+    uint8_t index = 0;
+    while (index < kTelemetryKindCount &&
+           std::strcmp(kind, kKindNames[index]) != 0) {
+      ++index;
+    }
+    if (index == kTelemetryKindCount) continue;
+
+    sample.kind = static_cast<telemetry_kind_t>(index);
+    sample.rss_kb = rss_kb;
+    sample.heap_kb = heap_kb;
+    sample.cache_kb = cache_kb;
+    samples.push_back(sample);
+  }
+
+  return true;
+}
+
+}  // namespace s21
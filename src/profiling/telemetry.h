@@ -0,0 +1,126 @@
+#ifndef PROFILING_TELEMETRY_H
+#define PROFILING_TELEMETRY_H
+
+/**
+ * @file telemetry.h
+ * @brief Покадровая телеметрия для длительных (soak) прогонов
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace s21 {
+
+/**
+ * @brief Источник записи телеметрии
+ */
+enum telemetry_kind_t : uint8_t {
+  kTelemetryFrame = 0,      ///< Отрисованный кадр
+  kTelemetryLoad = 1,       ///< Загрузка модели
+  kTelemetryTransform = 2,  ///< Трансформация модели
+  kTelemetryKindCount = 3   ///< Количество источников
+};
+
+/**
+ * @brief Снимок памяти процесса
+ */
+struct MemoryStats {
+  int64_t rss_kb = -1;   ///< Резидентная память, КиБ (-1 - недоступно)
+  int64_t heap_kb = -1;  ///< Занято в куче malloc, КиБ (-1 - недоступно)
+};
+
+/**
+ * @brief Одна строка телеметрии
+ */
+struct TelemetrySample {
+  double time_s = 0.0;  ///< Время от начала прогона, с
+  telemetry_kind_t kind = kTelemetryFrame;  ///< Источник записи
+  double duration_ms = 0.0;  ///< Длительность кадра или операции, мс
+  int64_t rss_kb = -1;       ///< Резидентная память, КиБ
+  int64_t heap_kb = -1;      ///< Занято в куче, КиБ
+  int64_t cache_kb = 0;      ///< Размер кэшей приложения, КиБ
+};
+
+/**
+ * @brief Читает текущее потребление памяти процессом
+ *
+ * RSS берётся из /proc/self/statm, занятая куча - из mallinfo2() (glibc).
+ * На других платформах соответствующие поля равны -1.
+ */
+MemoryStats ReadMemoryStats() noexcept;
+
+/**
+ * @brief Возвращает имя источника телеметрии ("frame", "load", ...)
+ */
+const char* TelemetryKindName(telemetry_kind_t kind) noexcept;
+
+/**
+ * @brief Запись телеметрии в CSV
+ *
+ * Формат строки: time_s,kind,duration_ms,rss_kb,heap_kb,cache_kb.
+ * Память опрашивается не чаще раза в kMemorySampleMs - чтение /proc на
+ * каждом кадре заметно в профиле, а для поиска утечек хватает и этого.
+ *
+ * @example
+ * @code
+ * TelemetryWriter writer;
+ * writer.Open("soak.csv");
+ * writer.Append(kTelemetryFrame, frame_ms, cache_kb);
+ * @endcode
+ */
+class TelemetryWriter {
+ public:
+  static constexpr int64_t kMemorySampleMs = 100;  ///< Период опроса памяти
+
+  /**
+   * @brief Открывает файл и пишет заголовок
+   * @return false если файл не открыт
+   */
+  bool Open(const std::string& path);
+
+  /**
+   * @brief Проверяет, открыт ли файл
+   */
+  bool IsOpen() const noexcept { return file_.is_open(); }
+
+  /**
+   * @brief Добавляет строку телеметрии
+   * @param kind Источник записи
+   * @param duration_ms Длительность кадра или операции, мс
+   * @param cache_kb Размер кэшей приложения, КиБ
+   */
+  void Append(telemetry_kind_t kind, double duration_ms, int64_t cache_kb);
+
+  /**
+   * @brief Сбрасывает буфер на диск
+   */
+  void Flush() { file_.flush(); }
+
+  /**
+   * @brief Возвращает количество записанных строк
+   */
+  size_t GetSampleCount() const noexcept { return sample_count_; }
+
+ private:
+  std::ofstream file_;                           ///< Файл телеметрии
+  std::chrono::steady_clock::time_point start_;  ///< Начало прогона
+  int64_t last_memory_ms_ = -kMemorySampleMs;    ///< Последний опрос памяти
+  MemoryStats memory_;                           ///< Последний снимок памяти
+  size_t sample_count_ = 0;                      ///< Записано строк
+};
+
+/**
+ * @brief Читает телеметрию из CSV, записанного TelemetryWriter
+ * @param path Путь к файлу
+ * @param samples Выходной вектор строк
+ * @return false если файл не открыт или заголовок не совпадает
+ */
+bool ReadTelemetryCsv(const std::string& path,
+                      std::vector<TelemetrySample>& samples);
+
+}  // namespace s21
+
+#endif  // PROFILING_TELEMETRY_H
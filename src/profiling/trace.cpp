@@ -0,0 +1,150 @@
+/**
+ * @file trace.cpp
+ * @brief Реализация трассировки интервалов
+ */
+
+#include "trace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+
+namespace s21 {
+
+namespace {
+
+int64_t SteadyNowNs() noexcept {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void WriteJsonString(std::ofstream& out, const char* text) {
+  out << '"';
+  for (const char* c = text ? text : ""; *c; ++c) {
+    if (*c == '"' || *c == '\\') out << '\\';
+    out << *c;
+  }
+  out << '"';
+}
+
+}  // namespace
+
+TraceBuffer::TraceBuffer(uint32_t thread_id)
+    : events_(new TraceEvent[kCapacity]), thread_id_(thread_id) {}
+
+void TraceBuffer::Push(const TraceEvent& event) noexcept {
+  const uint64_t head = head_.load(std::memory_order_relaxed);
+  events_[head % kCapacity] = event;
+  head_.store(head + 1, std::memory_order_release);
+}
+
+void TraceBuffer::Snapshot(std::vector<TraceEvent>& out) const {
+  const uint64_t end = head_.load(std::memory_order_acquire);
+  const uint64_t begin =
+      std::max(end > kCapacity ? end - kCapacity : 0,
+               cleared_.load(std::memory_order_acquire));
+  if (begin >= end) return;
+  const size_t first = out.size();
+  for (uint64_t i = begin; i < end; ++i) {
+    out.push_back(events_[i % kCapacity]);
+  }
+
+  // Слоты, которые владелец мог перезаписать во время копирования,
+  // отбрасываются: их содержимое не гарантировано. Пока head_ == after,
+  // владелец может уже писать слот after % kCapacity, поэтому он тоже
+  // считается испорченным
+  const uint64_t after = head_.load(std::memory_order_acquire);
+  if (after + 1 > begin + kCapacity) {
+    const uint64_t torn = std::min<uint64_t>(after + 1 - kCapacity - begin,
+                                             end - begin);
+    out.erase(out.begin() + first, out.begin() + first + torn);
+  }
+}
+
+void TraceBuffer::Clear() noexcept {
+  // head_ пишет только владелец, поэтому очистка лишь сдвигает нижнюю
+  // границу снимка и безопасна при работающем потоке
+  cleared_.store(head_.load(std::memory_order_acquire),
+                 std::memory_order_release);
+}
+
+Tracer::Tracer() : epoch_ns_(SteadyNowNs()) {}
+
+Tracer& Tracer::GetInstance() noexcept {
+  static Tracer instance;
+  return instance;
+}
+
+TraceBuffer& Tracer::LocalBuffer() {
+  thread_local TraceBuffer* buffer = nullptr;
+  if (!buffer) {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    buffers_.push_back(
+        std::make_unique<TraceBuffer>(static_cast<uint32_t>(buffers_.size())));
+    buffer = buffers_.back().get();
+  }
+  return *buffer;
+}
+
+int64_t Tracer::Now() const noexcept { return SteadyNowNs() - epoch_ns_; }
+
+std::vector<std::pair<uint32_t, TraceEvent>> Tracer::CollectEvents() const {
+  std::vector<std::pair<uint32_t, TraceEvent>> result;
+  std::vector<TraceEvent> events;
+
+  std::lock_guard<std::mutex> lock(registry_mutex_);
+  for (const auto& buffer : buffers_) {
+    events.clear();
+    buffer->Snapshot(events);
+    for (const TraceEvent& event : events) {
+      result.emplace_back(buffer->GetThreadId(), event);
+    }
+  }
+  return result;
+}
+
+bool Tracer::WriteChromeTrace(const std::string& path) const {
+  std::ofstream out(path);
+  if (!out.is_open()) {
+    return false;
+  }
+
+  char number[64];
+  bool first = true;
+  out << "{\"traceEvents\":[";
+  for (const auto& [thread_id, event] : CollectEvents()) {
+    out << (first ? "\n" : ",\n") << "{\"name\":";
+    WriteJsonString(out, event.name);
+    // Chrome Trace ожидает микросекунды
+    std::snprintf(number, sizeof(number), "%.3f,\"dur\":%.3f",
+                  event.start_ns / 1000.0, event.duration_ns / 1000.0);
+    out << ",\"cat\":\"s21\",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread_id
+        << ",\"ts\":" << number << '}';
+    first = false;
+  }
+  out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+  return static_cast<bool>(out);
+}
+
+void Tracer::Clear() {
+  std::lock_guard<std::mutex> lock(registry_mutex_);
+  for (auto& buffer : buffers_) {
+    buffer->Clear();
+  }
+}
+
+void TraceScope::Begin_() {
+  Tracer& tracer = Tracer::GetInstance();
+  buffer_ = &tracer.LocalBuffer();
+  start_ns_ = tracer.Now();
+}
+
+void TraceScope::End_() noexcept {
+  const int64_t end_ns = Tracer::GetInstance().Now();
+  buffer_->Push({name_, start_ns_, end_ns - start_ns_});
+}
+
+}  // namespace s21
@@ -0,0 +1,240 @@
+#ifndef PROFILING_TRACE_H
+#define PROFILING_TRACE_H
+
+/**
+ * @file trace.h
+ * @brief Лёгкая трассировка интервалов (span) в формате Chrome Trace
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace s21 {
+
+/**
+ * @brief Один завершённый интервал трассировки
+ */
+struct TraceEvent {
+  const char* name = nullptr;  ///< Имя интервала (строковый литерал)
+  int64_t start_ns = 0;     ///< Начало относительно старта трассировщика
+  int64_t duration_ns = 0;  ///< Длительность интервала в наносекундах
+};
+
+/**
+ * @brief Кольцевой буфер событий одного потока
+ *
+ * Запись выполняет только поток-владелец, поэтому публикация события
+ * сводится к одной atomic-записи счётчика без блокировок. Читатель
+ * (дамп трассы) копирует снимок и отбрасывает слоты, которые могли быть
+ * перезаписаны во время копирования. Очистка не трогает счётчик владельца,
+ * а запоминает его значение как нижнюю границу следующих снимков.
+ */
+class TraceBuffer {
+ public:
+  static constexpr size_t kCapacity = 1 << 16;  ///< Ёмкость буфера (событий)
+
+  /**
+   * @brief Создаёт буфер для потока
+   * @param thread_id Порядковый номер потока в трассе
+   */
+  explicit TraceBuffer(uint32_t thread_id);
+
+  /**
+   * @brief Добавляет событие (вызывается только потоком-владельцем)
+   * @param event Завершённый интервал
+   */
+  void Push(const TraceEvent& event) noexcept;
+
+  /**
+   * @brief Копирует накопленные события
+   * @param out Вектор, в конец которого добавляются события
+   */
+  void Snapshot(std::vector<TraceEvent>& out) const;
+
+  /**
+   * @brief Удаляет накопленные события
+   *
+   * Можно вызывать из любого потока, в том числе пока владелец пишет.
+   */
+  void Clear() noexcept;
+
+  /**
+   * @brief Возвращает номер потока в трассе
+   */
+  uint32_t GetThreadId() const noexcept { return thread_id_; }
+
+ private:
+  std::unique_ptr<TraceEvent[]> events_;  ///< Слоты кольцевого буфера
+  std::atomic<uint64_t> head_{0};         ///< Число записанных событий
+  std::atomic<uint64_t> cleared_{0};      ///< head_ на момент очистки
+  uint32_t thread_id_;                    ///< Номер потока
+};
+
+/**
+ * @brief Глобальный трассировщик (Singleton)
+ *
+ * Владеет буферами всех потоков, которые хотя бы раз записывали интервал
+ * (буфер создаётся только при включённой записи).
+ * Буферы живут до конца процесса, поэтому трассу можно выгрузить и после
+ * завершения рабочих потоков.
+ *
+ * @example
+ * @code
+ * Tracer::GetInstance().SetEnabled(true);
+ * {
+ *   S21_TRACE_SCOPE("Model::Parser");
+ *   model.Parser();
+ * }
+ * Tracer::GetInstance().WriteChromeTrace("trace.json");
+ * @endcode
+ */
+class Tracer {
+ public:
+  /**
+   * @brief Возвращает единственный экземпляр трассировщика
+   */
+  static Tracer& GetInstance() noexcept;
+
+  /**
+   * @brief Включает или выключает запись интервалов во время работы
+   * @param enabled true - интервалы записываются
+   */
+  void SetEnabled(bool enabled) noexcept {
+    enabled_.store(enabled, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Проверяет, включена ли запись интервалов
+   */
+  bool IsEnabled() const noexcept {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Возвращает буфер текущего потока, создавая его при первом вызове
+   */
+  TraceBuffer& LocalBuffer();
+
+  /**
+   * @brief Возвращает активный (незавершённый) интервал текущего потока
+   *
+   * Лёгкая thread_local-переменная без буфера событий: её обновляет каждый
+   * интервал, а сторожевой поток читает по адресу, полученному в
+   * наблюдаемом потоке. Значение - имя интервала или nullptr.
+   */
+  static std::atomic<const char*>& ActiveSpan() noexcept {
+    static thread_local std::atomic<const char*> span{nullptr};
+    return span;
+  }
+
+  /**
+   * @brief Возвращает время в наносекундах от создания трассировщика
+   */
+  int64_t Now() const noexcept;
+
+  /**
+   * @brief Собирает события всех потоков
+   * @return Пары (номер потока, событие) в порядке потоков
+   */
+  std::vector<std::pair<uint32_t, TraceEvent>> CollectEvents() const;
+
+  /**
+   * @brief Записывает трассу в формате Chrome Trace JSON
+   *
+   * Файл открывается в chrome://tracing и ui.perfetto.dev.
+   *
+   * @param path Путь к выходному файлу
+   * @return true при успешной записи
+   */
+  bool WriteChromeTrace(const std::string& path) const;
+
+  /**
+   * @brief Удаляет события из всех буферов
+   */
+  void Clear();
+
+ private:
+  Tracer();
+  ~Tracer() = default;
+  Tracer(const Tracer&) = delete;
+  Tracer& operator=(const Tracer&) = delete;
+
+  std::atomic<bool> enabled_{false};  ///< Флаг записи интервалов
+  int64_t epoch_ns_;                  ///< Момент создания трассировщика
+  mutable std::mutex registry_mutex_;  ///< Защищает список буферов
+  std::vector<std::unique_ptr<TraceBuffer>> buffers_;  ///< Буферы потоков
+};
+
+/**
+ * @brief RAII-интервал трассировки
+ *
+ * Фиксирует время создания и при разрушении записывает событие в буфер
+ * текущего потока. Активный интервал потока отслеживается всегда (его
+ * читает сторожевой поток при зависаниях), а буфер, время и событие
+ * затрагиваются только при включённом трассировщике.
+ */
+class TraceScope {
+ public:
+  /**
+   * @brief Открывает интервал
+   * @param name Имя интервала (должно жить до конца процесса)
+   */
+  explicit TraceScope(const char* name)
+      : name_(name),
+        parent_(Tracer::ActiveSpan().load(std::memory_order_relaxed)) {
+    Tracer::ActiveSpan().store(name_, std::memory_order_release);
+    if (Tracer::GetInstance().IsEnabled()) Begin_();
+  }
+
+  /**
+   * @brief Закрывает интервал и записывает событие
+   */
+  ~TraceScope() {
+    if (buffer_) End_();
+    Tracer::ActiveSpan().store(parent_, std::memory_order_release);
+  }
+
+  TraceScope(const TraceScope&) = delete;
+  TraceScope& operator=(const TraceScope&) = delete;
+
+ private:
+  /**
+   * @brief Запоминает буфер потока и время открытия
+   */
+  void Begin_();
+
+  /**
+   * @brief Записывает завершённый интервал в буфер
+   */
+  void End_() noexcept;
+
+  TraceBuffer* buffer_ = nullptr;  ///< Буфер потока, если запись включена
+  const char* name_;               ///< Имя интервала
+  const char* parent_;             ///< Внешний активный интервал
+  int64_t start_ns_ = 0;           ///< Время открытия
+};
+
+}  // namespace s21
+
+#define S21_TRACE_CONCAT_IMPL(a, b) a##b
+#define S21_TRACE_CONCAT(a, b) S21_TRACE_CONCAT_IMPL(a, b)
+
+/**
+ * @brief Открывает интервал трассировки до конца текущей области видимости
+ *
+ * Без определения S21_ENABLE_TRACING раскрывается в пустую инструкцию.
+ */
+#ifdef S21_ENABLE_TRACING
+#define S21_TRACE_SCOPE(name) \
+  ::s21::TraceScope S21_TRACE_CONCAT(s21_trace_scope_, __LINE__)(name)
+#else
+#define S21_TRACE_SCOPE(name) \
+  do {                        \
+  } while (0)
+#endif
+
+#endif  // PROFILING_TRACE_H
@@ -0,0 +1,130 @@
+/**
+ * @file camera.cpp
+ * @brief Построение матрицы камеры
+ */
+
+#include "camera.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace s21 {
+
+namespace {
+
+constexpr double kDegreeToRadian = M_PI / 180.0;
+
+Matrix4 Identity() {
+  Matrix4 m{};
+  m[0] = m[5] = m[10] = m[15] = 1.0;
+  return m;
+}
+
+Matrix4 Multiply(const Matrix4& a, const Matrix4& b) {
+  Matrix4 result{};
+  for (int column = 0; column < 4; ++column) {
+    for (int row = 0; row < 4; ++row) {
+      double sum = 0.0;
+      for (int k = 0; k < 4; ++k) sum += a[k * 4 + row] * b[column * 4 + k];
+      result[column * 4 + row] = sum;
+    }
+  }
+  return result;
+}
+
+/**
+ * @brief Поворот как в glRotatef вокруг оси axis (0 - X, 1 - Y, 2 - Z)
+ */
+Matrix4 Rotation(int axis, double degrees) {
+  const double c = std::cos(degrees * kDegreeToRadian);
+  const double s = std::sin(degrees * kDegreeToRadian);
+  const int u = (axis + 1) % 3;
+  const int v = (axis + 2) % 3;
+  Matrix4 m = Identity();
+  m[u * 4 + u] = c;
+  m[u * 4 + v] = s;
+  m[v * 4 + u] = -s;
+  m[v * 4 + v] = c;
+  return m;
+}
+
+}  // namespace
+
+Matrix4 Camera::BuildMatrix(int width, int height) const {
+  Matrix4 model = Identity();
+  model[12] = translate[0];
+  model[13] = translate[1];
+  model[14] = translate[2];
+  for (int axis = 0; axis < 3; ++axis) {
+    model = Multiply(model, Rotation(axis, rotation[axis]));
+  }
+  Matrix4 scaling = Identity();
+  scaling[0] = scaling[5] = scaling[10] = scale;
+  model = Multiply(model, scaling);
+
+  // Короткая сторона кадра соответствует [-1, 1]
+  const double aspect = height > 0 && keep_aspect
+                            ? static_cast<double>(width) / height
+                            : 1.0;
+  const double sx = aspect > 1.0 ? 1.0 / aspect : 1.0;
+  const double sy = aspect > 1.0 ? 1.0 : aspect;
+
+  Matrix4 clip = Identity();
+  if (projection == kProjectionOrthographic) {
+    clip[0] = sx;
+    clip[5] = sy;
+  } else {
+    const double focal =
+        1.0 / std::tan(kPerspectiveFovDeg * 0.5 * kDegreeToRadian);
+    Matrix4 view = Identity();
+    view[14] = -kPerspectiveDistance;
+    clip[0] = focal * sx;
+    clip[5] = focal * sy;
+    clip[10] = -1.0;
+    clip[11] = -1.0;
+    clip[14] = -kNearPlane;
+    clip[15] = 0.0;
+    clip = Multiply(clip, view);
+  }
+
+  return Multiply(clip, model);
+}
+
+Camera FitCameraToBox(const OrientedBox& box, double margin) {
+  // Поворот R переводит оси box в X, Y, Z: строки R - оси box.
+  // R = Rx(a) Ry(b) Rz(c) в порядке glRotatef; R[0][2] = sin b,
+  // R[1][2] = -sin a cos b, R[2][2] = cos a cos b, R[0][1] = -cos b sin c
+  const double (&r)[3][3] = box.axis;
+  Camera camera;
+  const double sin_b = std::clamp(r[0][2], -1.0, 1.0);
+  double a = 0.0, c = 0.0;
+  if (std::abs(sin_b) < 1.0 - 1e-12) {
+    a = std::atan2(-r[1][2], r[2][2]);
+    c = std::atan2(-r[0][1], r[0][0]);
+  } else {
+    // Вырожденный случай: поворот вокруг Z сливается с X
+    a = std::atan2(r[2][1], r[1][1]);
+  }
+  camera.rotation[0] = a / kDegreeToRadian;
+  camera.rotation[1] = std::asin(sin_b) / kDegreeToRadian;
+  camera.rotation[2] = c / kDegreeToRadian;
+  camera.scale = box.half[0] > 0.0 ? margin / box.half[0] : 1.0;
+  for (int row = 0; row < 3; ++row) {
+    double rotated = 0.0;
+    for (int k = 0; k < 3; ++k) rotated += r[row][k] * box.center[k];
+    camera.translate[row] = -rotated * camera.scale;
+  }
+  return camera;
+}
+
+Matrix4 TileMatrix(int column, int row, int columns, int rows) {
+  // Плитка [-1 + 2c/n, -1 + 2(c+1)/n] переходит в [-1, 1]
+  Matrix4 m = Identity();
+  m[0] = columns;
+  m[5] = rows;
+  m[12] = columns - 1.0 - 2.0 * column;
+  m[13] = rows - 1.0 - 2.0 * row;
+  return m;
+}
+
+}  // namespace s21
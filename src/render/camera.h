@@ -0,0 +1,87 @@
+#ifndef RENDER_CAMERA_H
+#define RENDER_CAMERA_H
+
+/**
+ * @file camera.h
+ * @brief Камера программного рендера
+ */
+
+#include <array>
+
+#include "../model/hull.h"
+
+namespace s21 {
+
+/**
+ * @brief Тип проекции
+ */
+enum projection_t {
+  kProjectionOrthographic = 0,  ///< Параллельная (как в окне просмотра)
+  kProjectionPerspective = 1    ///< Центральная
+};
+
+/**
+ * @brief Матрица 4x4 по столбцам (как в OpenGL)
+ */
+using Matrix4 = std::array<double, 16>;
+
+/**
+ * @brief Параметры камеры
+ *
+ * Преобразование повторяет конвейер OpenGLWidget: смещение, повороты
+ * вокруг X, Y, Z (градусы), масштаб. При ортографической проекции
+ * видимый объём - куб [-1, 1], как в окне; для неквадратного кадра
+ * короткая сторона соответствует [-1, 1], а при keep_aspect == false
+ * куб растягивается на весь кадр, как в OpenGLWidget. Перспективная камера
+ * смотрит вдоль -Z с расстояния kPerspectiveDistance с углом обзора
+ * kPerspectiveFovDeg.
+ */
+struct Camera {
+  double rotation[3] = {0.0, 0.0, 0.0};   ///< Повороты вокруг X, Y, Z
+  double translate[3] = {0.0, 0.0, 0.0};  ///< Смещение модели
+  double scale = 1.0;                     ///< Масштаб модели
+  projection_t projection = kProjectionOrthographic;  ///< Проекция
+  bool keep_aspect = true;  ///< Сохранять пропорции неквадратного кадра
+
+  static constexpr double kPerspectiveDistance = 3.0;  ///< До центра
+  static constexpr double kPerspectiveFovDeg = 45.0;   ///< Угол обзора
+  static constexpr double kNearPlane = 0.1;  ///< Ближняя плоскость
+
+  /**
+   * @brief Строит матрицу модель-вид-проекция для кадра width x height
+   *
+   * Результат переводит координаты модели в однородные координаты
+   * отсечения; после деления на w видимая область - [-1, 1] по X и Y.
+   */
+  Matrix4 BuildMatrix(int width, int height) const;
+};
+
+/**
+ * @brief Камера, показывающая ориентированный box крупно и по центру
+ *
+ * Поворот ставит самую длинную ось box по горизонтали кадра, среднюю -
+ * по вертикали, а самую короткую направляет на зрителя: вытянутая или
+ * повёрнутая деталь занимает всю ширину кадра. Масштаб переводит
+ * длинную сторону в [-margin, margin], центр box - в центр кадра.
+ *
+ * @param box Box модели (оси - правая тройка)
+ * @param margin Доля поля, занимаемая длинной стороной
+ */
+Camera FitCameraToBox(const OrientedBox& box, double margin = 0.9);
+
+constexpr int kMaxCaptureScale = 8;  ///< Наибольшее число плиток по стороне
+
+/**
+ * @brief Матрица, растягивающая плитку кадра на всю область [-1, 1]
+ *
+ * Кадр делится на columns x rows плиток; column считается слева,
+ * row - снизу, как в OpenGL. Умножение проекции слева на эту матрицу
+ * рисует только плитку, но в полном разрешении окна: склеенные
+ * плитки дают кадр в columns x rows раз больше окна (снимки выше
+ * разрешения экрана).
+ */
+Matrix4 TileMatrix(int column, int row, int columns, int rows);
+
+}  // namespace s21
+
+#endif  // RENDER_CAMERA_H
@@ -0,0 +1,321 @@
+/**
+ * @file gif_encoder.cpp
+ * @brief Реализация кодировщика GIF
+ */
+
+#include "gif_encoder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+
+#include "../model/parallel.h"
+#include "../profiling/trace.h"
+
+namespace s21 {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int kMaxCodeCount = 4096;  ///< Словарь LZW (коды до 12 бит)
+constexpr int kHashBits = 13;        ///< Хеш-таблица вдвое больше словаря
+constexpr size_t kSubBlockSize = 255;  ///< Наибольший подблок данных
+
+double ElapsedMs(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+      .count();
+}
+
+/**
+ * @brief Номер ячейки RGB555 для цвета RGBA
+ */
+inline uint16_t PackRgb555(uint32_t color) noexcept {
+  return static_cast<uint16_t>((color & 0xF8) << 7 | (color >> 6 & 0x3E0) |
+                               (color >> 19 & 0x1F));
+}
+
+/**
+ * @brief Компонента канала (0 - R, 1 - G, 2 - B) ячейки RGB555
+ */
+inline int Channel(uint16_t bin, int channel) noexcept {
+  return bin >> (10 - 5 * channel) & 0x1F;
+}
+
+void AppendLe16(std::string& out, int value) {
+  out.push_back(static_cast<char>(value & 0xFF));
+  out.push_back(static_cast<char>(value >> 8 & 0xFF));
+}
+
+/**
+ * @brief Дописывает данные подблоками по 255 байт и терминатор
+ */
+void AppendSubBlocks(std::string& out, const std::string& data) {
+  for (size_t offset = 0; offset < data.size(); offset += kSubBlockSize) {
+    const size_t size = std::min(kSubBlockSize, data.size() - offset);
+    out.push_back(static_cast<char>(size));
+    out.append(data, offset, size);
+  }
+  out.push_back('\0');
+}
+
+}  // namespace
+
+GifEncoder::GifEncoder(unsigned threads)
+    : threads_(threads), histogram_(kBinCount) {}
+
+bool GifEncoder::AddFrame(const Image& frame) {
+  S21_TRACE_SCOPE("GifEncoder::AddFrame");
+  if (frame.width <= 0 || frame.height <= 0) return false;
+  if (frames_.empty()) {
+    width_ = frame.width;
+    height_ = frame.height;
+  } else if (frame.width != width_ || frame.height != height_) {
+    return false;
+  }
+
+  const size_t count = frame.pixels.size();
+  std::vector<uint16_t> packed(count);
+  // Кадр каркаса - в основном длинные серии фона, поэтому гистограмма
+  // пополняется сериями одинаковых пикселей, а не каждым пикселем
+  size_t run_start = 0;
+  for (size_t i = 0; i < count; ++i) {
+    packed[i] = PackRgb555(frame.pixels[i]);
+    if (i + 1 < count && frame.pixels[i + 1] == frame.pixels[run_start]) {
+      continue;
+    }
+    const uint32_t color = frame.pixels[run_start];
+    const uint64_t run = i + 1 - run_start;
+    Bin& bin = histogram_[packed[run_start]];
+    bin.count += run;
+    bin.r += run * (color & 0xFF);
+    bin.g += run * (color >> 8 & 0xFF);
+    bin.b += run * (color >> 16 & 0xFF);
+    run_start = i + 1;
+  }
+  frames_.push_back(std::move(packed));
+  return true;
+}
+
+std::vector<uint8_t> GifEncoder::BuildPalette_() {
+  S21_TRACE_SCOPE("GifEncoder::BuildPalette");
+  std::vector<uint16_t> bins;
+  uint64_t total = 0;
+  for (int bin = 0; bin < kBinCount; ++bin) {
+    if (histogram_[bin].count == 0) continue;
+    bins.push_back(static_cast<uint16_t>(bin));
+    total += histogram_[bin].count;
+  }
+
+  // Медианное сечение: самая населённая делимая коробка режется по
+  // самому широкому каналу так, чтобы пиксели разошлись поровну.
+  // Если ячеек не больше kMaxColors, каждая станет своим цветом.
+  struct Box {
+    size_t begin, end;
+    uint64_t count;
+  };
+  std::vector<Box> boxes = {{0, bins.size(), total}};
+  while (boxes.size() < static_cast<size_t>(kMaxColors)) {
+    Box* box = nullptr;
+    for (Box& candidate : boxes) {
+      if (candidate.end - candidate.begin >= 2 &&
+          (!box || candidate.count > box->count)) {
+        box = &candidate;
+      }
+    }
+    if (!box) break;
+
+    int widest = 0;
+    int widest_range = -1;
+    for (int channel = 0; channel < 3; ++channel) {
+      int low = 31, high = 0;
+      for (size_t i = box->begin; i < box->end; ++i) {
+        low = std::min(low, Channel(bins[i], channel));
+        high = std::max(high, Channel(bins[i], channel));
+      }
+      if (high - low > widest_range) {
+        widest_range = high - low;
+        widest = channel;
+      }
+    }
+    std::sort(bins.begin() + box->begin, bins.begin() + box->end,
+              [widest](uint16_t a, uint16_t b) {
+                const int ca = Channel(a, widest), cb = Channel(b, widest);
+                return ca != cb ? ca < cb : a < b;
+              });
+
+    uint64_t lower = 0;
+    size_t split = box->begin;
+    do {
+      lower += histogram_[bins[split++]].count;
+    } while (split + 1 < box->end && lower < box->count / 2);
+    const Box upper = {split, box->end, box->count - lower};
+    box->end = split;
+    box->count = lower;
+    boxes.push_back(upper);
+  }
+
+  std::vector<uint8_t> palette;
+  palette.reserve(boxes.size() * 3);
+  for (size_t index = 0; index < boxes.size(); ++index) {
+    Bin sum;
+    for (size_t i = boxes[index].begin; i < boxes[index].end; ++i) {
+      const Bin& bin = histogram_[bins[i]];
+      sum.count += bin.count;
+      sum.r += bin.r;
+      sum.g += bin.g;
+      sum.b += bin.b;
+      lut_[bins[i]] = static_cast<uint8_t>(index);
+    }
+    const uint64_t half = sum.count / 2;
+    palette.push_back(static_cast<uint8_t>((sum.r + half) / sum.count));
+    palette.push_back(static_cast<uint8_t>((sum.g + half) / sum.count));
+    palette.push_back(static_cast<uint8_t>((sum.b + half) / sum.count));
+  }
+  return palette;
+}
+
+std::string GifEncoder::Encode(int delay_cs, GifStats* stats) {
+  S21_TRACE_SCOPE("GifEncoder::Encode");
+  if (frames_.empty()) return std::string();
+
+  Clock::time_point start = Clock::now();
+  std::vector<uint8_t> palette = BuildPalette_();
+  const int colors = static_cast<int>(palette.size() / 3);
+  int bits = 1;
+  while ((1 << bits) < colors) ++bits;
+  palette.resize(static_cast<size_t>(3) << bits, 0);
+  const double palette_ms = ElapsedMs(start);
+
+  // Кадры независимы: каждый квантуется и сжимается отдельной задачей
+  start = Clock::now();
+  const int min_code_size = std::max(bits, 2);
+  const size_t pixels = static_cast<size_t>(width_) * height_;
+  std::vector<std::string> blocks(frames_.size());
+  std::vector<std::vector<uint8_t>> indices(std::max(threads_, 1u));
+  ParallelFor(frames_.size(), threads_, [&](unsigned worker, size_t frame) {
+    std::vector<uint8_t>& out = indices[worker];
+    out.resize(pixels);
+    const uint16_t* in = frames_[frame].data();
+    for (size_t i = 0; i < pixels; ++i) out[i] = lut_[in[i]];
+    blocks[frame] = EncodeLzw(out.data(), pixels, min_code_size);
+  });
+  const double encode_ms = ElapsedMs(start);
+
+  const int delay = std::clamp(delay_cs, 0, 0xFFFF);
+  std::string gif("GIF89a", 6);
+  AppendLe16(gif, width_);
+  AppendLe16(gif, height_);
+  // Глобальная палитра, 8 бит на канал, 2^bits цветов
+  gif.push_back(static_cast<char>(0xF0 | (bits - 1)));
+  gif.push_back('\0');  // Цвет фона
+  gif.push_back('\0');  // Пропорции пикселя
+  gif.append(palette.begin(), palette.end());
+  // Бесконечный повтор
+  gif.append("\x21\xFF\x0BNETSCAPE2.0\x03\x01\x00\x00\x00", 19);
+  for (const std::string& block : blocks) {
+    // Управление графикой: кадр остаётся на экране, без прозрачности
+    gif.append("\x21\xF9\x04\x04", 4);
+    AppendLe16(gif, delay);
+    gif.append("\x00\x00", 2);
+    gif.push_back('\x2C');
+    AppendLe16(gif, 0);
+    AppendLe16(gif, 0);
+    AppendLe16(gif, width_);
+    AppendLe16(gif, height_);
+    gif.push_back('\0');  // Без локальной палитры и чересстрочности
+    gif.push_back(static_cast<char>(min_code_size));
+    AppendSubBlocks(gif, block);
+  }
+  gif.push_back('\x3B');
+
+  if (stats) {
+    stats->frames = frames_.size();
+    stats->colors = colors;
+    stats->palette_ms = palette_ms;
+    stats->encode_ms = encode_ms;
+    stats->bytes = gif.size();
+  }
+  return gif;
+}
+
+bool GifEncoder::Write(const std::string& path, int delay_cs,
+                       GifStats* stats) {
+  const std::string gif = Encode(delay_cs, stats);
+  if (gif.empty()) return false;
+  std::ofstream file(path, std::ios::binary);
+  file.write(gif.data(), static_cast<std::streamsize>(gif.size()));
+  return static_cast<bool>(file);
+}
+
+void GifEncoder::Clear() {
+  frames_.clear();
+  std::fill(histogram_.begin(), histogram_.end(), Bin());
+  width_ = 0;
+  height_ = 0;
+}
+
+std::string EncodeLzw(const uint8_t* indices, size_t count,
+                      int min_code_size) {
+  const int clear_code = 1 << min_code_size;
+  const int end_code = clear_code + 1;
+  int code_size = min_code_size + 1;
+  int next_code = end_code + 1;
+
+  std::string out;
+  out.reserve(count / 2 + 16);
+  uint32_t buffer = 0;
+  int buffered_bits = 0;
+  auto emit = [&](int code) {
+    buffer |= static_cast<uint32_t>(code) << buffered_bits;
+    buffered_bits += code_size;
+    while (buffered_bits >= 8) {
+      out.push_back(static_cast<char>(buffer & 0xFF));
+      buffer >>= 8;
+      buffered_bits -= 8;
+    }
+  };
+
+  // Словарь: (код префикса << 8 | индекс) -> код, открытая адресация
+  constexpr size_t kHashSize = size_t{1} << kHashBits;
+  std::vector<int32_t> keys(kHashSize, -1);
+  std::vector<uint16_t> codes(kHashSize);
+
+  emit(clear_code);
+  if (count > 0) {
+    int prefix = indices[0];
+    for (size_t i = 1; i < count; ++i) {
+      const int32_t key = prefix << 8 | indices[i];
+      size_t slot = static_cast<uint32_t>(key) * 2654435761u >>
+                    (32 - kHashBits);
+      while (keys[slot] != -1 && keys[slot] != key) {
+        slot = (slot + 1) & (kHashSize - 1);
+      }
+      if (keys[slot] == key) {
+        prefix = codes[slot];
+        continue;
+      }
+
+      emit(prefix);
+      if (next_code < kMaxCodeCount) {
+        keys[slot] = key;
+        codes[slot] = static_cast<uint16_t>(next_code++);
+        // Декодер добавляет код на шаг позже, поэтому разрядность растёт,
+        // когда следующий код уже не помещается
+        if (next_code > (1 << code_size) && code_size < 12) ++code_size;
+      } else {
+        emit(clear_code);
+        std::fill(keys.begin(), keys.end(), -1);
+        next_code = end_code + 1;
+        code_size = min_code_size + 1;
+      }
+      prefix = indices[i];
+    }
+    emit(prefix);
+  }
+  emit(end_code);
+  if (buffered_bits > 0) out.push_back(static_cast<char>(buffer & 0xFF));
+  return out;
+}
+
+}  // namespace s21
@@ -0,0 +1,145 @@
+#ifndef RENDER_GIF_ENCODER_H
+#define RENDER_GIF_ENCODER_H
+
+/**
+ * @file gif_encoder.h
+ * @brief Кодирование последовательности кадров в анимированный GIF
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "image.h"
+
+namespace s21 {
+
+/**
+ * @brief Замеры последнего кодирования GifEncoder
+ */
+struct GifStats {
+  size_t frames = 0;         ///< Кадров в файле
+  int colors = 0;            ///< Цветов в общей палитре
+  double palette_ms = 0.0;   ///< Построение палитры
+  double encode_ms = 0.0;    ///< Квантование и LZW всех кадров
+  size_t bytes = 0;          ///< Размер файла
+};
+
+/**
+ * @brief Кодировщик анимированного GIF с общей палитрой
+ *
+ * Кадры добавляются по одному (AddFrame) и хранятся в виде RGB555 -
+ * 2 байта на пиксель вместо 4, что вдвое увеличивает запись, которая
+ * помещается в память. Одновременно копится гистограмма цветов всех
+ * кадров.
+ *
+ * Encode строит по гистограмме одну палитру на весь ролик (медианное
+ * сечение): кадры не несут локальных таблиц, а цвета не «прыгают» между
+ * кадрами. Затем кадры независимо квантуются по таблице RGB555 ->
+ * индекс и сжимаются LZW в потоках ParallelFor; готовые блоки
+ * записываются по порядку. Файл зациклен (расширение NETSCAPE2.0).
+ *
+ * Экземпляр не потокобезопасен: AddFrame и Encode вызываются из одного
+ * потока (например, задачами одной WorkerQueue).
+ *
+ * @example
+ * @code
+ * GifEncoder encoder(DefaultThreadCount());
+ * for (const Image& frame : frames) encoder.AddFrame(frame);
+ * GifStats stats;
+ * encoder.Write("screencast.gif", 10, &stats);
+ * @endcode
+ */
+class GifEncoder {
+ public:
+  static constexpr int kMaxColors = 256;  ///< Наибольший размер палитры
+
+  /**
+   * @brief Создаёт кодировщик
+   * @param threads Потоков для квантования и LZW
+   */
+  explicit GifEncoder(unsigned threads = 1);
+
+  /**
+   * @brief Устанавливает число потоков кодирования
+   */
+  void SetThreadCount(unsigned threads) noexcept { threads_ = threads; }
+
+  /**
+   * @brief Добавляет кадр
+   * @return false если размер отличается от первого кадра или пуст
+   */
+  bool AddFrame(const Image& frame);
+
+  /**
+   * @brief Возвращает число добавленных кадров
+   */
+  size_t GetFrameCount() const noexcept { return frames_.size(); }
+
+  /**
+   * @brief Кодирует добавленные кадры в GIF
+   *
+   * @param delay_cs Длительность кадра в сотых долях секунды
+   * @param stats Замеры кодирования (может быть nullptr)
+   * @return Содержимое файла; пустая строка, если кадров нет
+   */
+  std::string Encode(int delay_cs, GifStats* stats = nullptr);
+
+  /**
+   * @brief Кодирует кадры и записывает файл
+   * @return true при успешной записи
+   */
+  bool Write(const std::string& path, int delay_cs,
+             GifStats* stats = nullptr);
+
+  /**
+   * @brief Удаляет кадры и гистограмму
+   */
+  void Clear();
+
+ private:
+  static constexpr int kBinCount = 1 << 15;  ///< Ячеек RGB555
+
+  /**
+   * @brief Ячейка гистограммы: число пикселей и суммы каналов
+   */
+  struct Bin {
+    uint64_t count = 0;
+    uint64_t r = 0, g = 0, b = 0;
+  };
+
+  /**
+   * @brief Строит палитру медианным сечением и таблицу ячейка -> индекс
+   * @return Цвета палитры (RGB, по 3 байта)
+   */
+  std::vector<uint8_t> BuildPalette_();
+
+  unsigned threads_;                      ///< Потоков кодирования
+  int width_ = 0;                         ///< Ширина кадров
+  int height_ = 0;                        ///< Высота кадров
+  std::vector<std::vector<uint16_t>> frames_;  ///< Кадры в RGB555
+  std::vector<Bin> histogram_;            ///< Цвета всех кадров
+  std::array<uint8_t, kBinCount> lut_{};  ///< Ячейка RGB555 -> индекс
+};
+
+/**
+ * @brief Сжимает индексы пикселей кодом LZW в варианте GIF
+ *
+ * Коды переменной длины (до 12 бит) упакованы младшими битами вперёд,
+ * без разбиения на подблоки. При заполнении словаря выдаётся код
+ * очистки.
+ *
+ * @param indices Индексы палитры
+ * @param count Количество индексов
+ * @param min_code_size Начальная разрядность (2..8), индексы меньше
+ * 1 << min_code_size
+ * @return Упакованные коды от кода очистки до кода конца данных
+ */
+std::string EncodeLzw(const uint8_t* indices, size_t count,
+                      int min_code_size);
+
+}  // namespace s21
+
+#endif  // RENDER_GIF_ENCODER_H
@@ -0,0 +1,78 @@
+/**
+ * @file image.cpp
+ * @brief Кодирование изображения в PNG
+ */
+
+#include "image.h"
+
+#include <zlib.h>
+
+#include <cstring>
+#include <fstream>
+
+#include "../profiling/trace.h"
+
+namespace s21 {
+
+namespace {
+
+void AppendBigEndian(std::string& out, uint32_t value) {
+  out.push_back(static_cast<char>(value >> 24));
+  out.push_back(static_cast<char>(value >> 16));
+  out.push_back(static_cast<char>(value >> 8));
+  out.push_back(static_cast<char>(value));
+}
+
+void AppendChunk(std::string& out, const char* type, const std::string& data) {
+  AppendBigEndian(out, static_cast<uint32_t>(data.size()));
+  const size_t type_pos = out.size();
+  out.append(type, 4);
+  out += data;
+  const uLong crc =
+      crc32(0, reinterpret_cast<const Bytef*>(out.data() + type_pos),
+            static_cast<uInt>(data.size() + 4));
+  AppendBigEndian(out, static_cast<uint32_t>(crc));
+}
+
+}  // namespace
+
+std::string EncodePng(const Image& image, int level) {
+  S21_TRACE_SCOPE("EncodePng");
+
+  // Каждая строка начинается с байта фильтра (0 - без фильтра)
+  const size_t row_bytes = static_cast<size_t>(image.width) * 4;
+  std::string raw(static_cast<size_t>(image.height) * (row_bytes + 1), '\0');
+  for (int y = 0; y < image.height; ++y) {
+    std::memcpy(&raw[y * (row_bytes + 1) + 1],
+                image.pixels.data() + static_cast<size_t>(y) * image.width,
+                row_bytes);
+  }
+
+  uLongf compressed_size = compressBound(static_cast<uLong>(raw.size()));
+  std::string compressed(compressed_size, '\0');
+  compress2(reinterpret_cast<Bytef*>(&compressed[0]), &compressed_size,
+            reinterpret_cast<const Bytef*>(raw.data()),
+            static_cast<uLong>(raw.size()), level);
+  compressed.resize(compressed_size);
+
+  std::string header;
+  AppendBigEndian(header, static_cast<uint32_t>(image.width));
+  AppendBigEndian(header, static_cast<uint32_t>(image.height));
+  // 8 бит на канал, цвет RGBA, сжатие и фильтрация по умолчанию
+  header += std::string("\x08\x06\x00\x00\x00", 5);
+
+  std::string png("\x89PNG\r\n\x1a\n", 8);
+  AppendChunk(png, "IHDR", header);
+  AppendChunk(png, "IDAT", compressed);
+  AppendChunk(png, "IEND", std::string());
+  return png;
+}
+
+bool WritePng(const Image& image, const std::string& path, int level) {
+  const std::string png = EncodePng(image, level);
+  std::ofstream file(path, std::ios::binary);
+  file.write(png.data(), static_cast<std::streamsize>(png.size()));
+  return static_cast<bool>(file);
+}
+
+}  // namespace s21
@@ -0,0 +1,75 @@
+#ifndef RENDER_IMAGE_H
+#define RENDER_IMAGE_H
+
+/**
+ * @file image.h
+ * @brief RGBA изображение в памяти и кодирование в PNG
+ */
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace s21 {
+
+/**
+ * @brief Собирает цвет RGBA (байты в памяти: R, G, B, A)
+ */
+constexpr uint32_t MakeColor(uint8_t r, uint8_t g, uint8_t b,
+                             uint8_t a = 255) noexcept {
+  return static_cast<uint32_t>(r) | static_cast<uint32_t>(g) << 8 |
+         static_cast<uint32_t>(b) << 16 | static_cast<uint32_t>(a) << 24;
+}
+
+/**
+ * @brief Изображение 32 бита на пиксель, строки сверху вниз
+ */
+struct Image {
+  int width = 0;                 ///< Ширина в пикселях
+  int height = 0;                ///< Высота в пикселях
+  std::vector<uint32_t> pixels;  ///< Пиксели RGBA построчно
+
+  /**
+   * @brief Меняет размер (память переиспользуется) и заливает цветом
+   */
+  void Reset(int new_width, int new_height, uint32_t color) {
+    width = new_width;
+    height = new_height;
+    pixels.assign(static_cast<size_t>(width) * height, color);
+  }
+
+  /**
+   * @brief Меняет размер без заливки (содержимое не определено)
+   */
+  void Resize(int new_width, int new_height) {
+    width = new_width;
+    height = new_height;
+    pixels.resize(static_cast<size_t>(width) * height);
+  }
+
+  /**
+   * @brief Возвращает пиксель (x, y)
+   */
+  uint32_t At(int x, int y) const noexcept {
+    return pixels[static_cast<size_t>(y) * width + x];
+  }
+};
+
+/**
+ * @brief Кодирует изображение в PNG (RGBA, 8 бит на канал)
+ *
+ * @param image Изображение
+ * @param level Уровень сжатия zlib (1 - быстро, 9 - компактно)
+ * @return Содержимое PNG файла
+ */
+std::string EncodePng(const Image& image, int level = 1);
+
+/**
+ * @brief Сохраняет изображение в PNG файл
+ * @return true при успешной записи
+ */
+bool WritePng(const Image& image, const std::string& path, int level = 1);
+
+}  // namespace s21
+
+#endif  // RENDER_IMAGE_H
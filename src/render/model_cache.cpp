@@ -0,0 +1,117 @@
+/**
+ * @file model_cache.cpp
+ * @brief Реализация кэша моделей
+ */
+
+#include "model_cache.h"
+
+#include <filesystem>
+
+#include "../model/obj_parser.h"
+#include "../profiling/trace.h"
+
+namespace s21 {
+
+ModelCache::ModelCache(size_t capacity_bytes)
+    : capacity_bytes_(capacity_bytes) {}
+
+std::shared_ptr<const RenderMesh> ModelCache::Get(const std::string& path,
+                                                  int& error) {
+  S21_TRACE_SCOPE("ModelCache::Get");
+
+  if (!ObjParser::IsValidObjExtension(path)) {
+    error = kFileWrongExtension;
+    return nullptr;
+  }
+
+  std::error_code code;
+  const auto write_time = std::filesystem::last_write_time(path, code);
+  const uint64_t size = code ? 0 : std::filesystem::file_size(path, code);
+  if (code) {
+    error = kFailedToOpen;
+    return nullptr;
+  }
+  const int64_t mtime = write_time.time_since_epoch().count();
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  auto it = entries_.find(path);
+  if (it != entries_.end() && it->second.mtime == mtime &&
+      it->second.size == size) {
+    ++stats_.hits;
+    lru_.splice(lru_.begin(), lru_, it->second.lru);
+    const std::shared_future<Loaded> loaded = it->second.loaded;
+    lock.unlock();
+
+    error = loaded.get().error;
+    return loaded.get().mesh;
+  }
+
+  // Файл новый или изменился: загружаем, остальные потоки ждут future
+  if (it != entries_.end()) Erase_(it);
+  ++stats_.misses;
+  std::promise<Loaded> promise;
+  Entry entry;
+  entry.loaded = promise.get_future().share();
+  entry.mtime = mtime;
+  entry.size = size;
+  entry.generation = ++next_generation_;
+  lru_.push_front(path);
+  entry.lru = lru_.begin();
+  const uint64_t generation = entry.generation;
+  entries_.emplace(path, std::move(entry));
+  lock.unlock();
+
+  Loaded loaded = Load_(path);
+  promise.set_value(loaded);
+
+  lock.lock();
+  it = entries_.find(path);
+  if (it != entries_.end() && it->second.generation == generation) {
+    if (loaded.error != kNoError) {
+      Erase_(it);
+    } else {
+      it->second.bytes = loaded.mesh->GetByteSize();
+      stats_.bytes += it->second.bytes;
+      Evict_(path);
+    }
+  }
+
+  error = loaded.error;
+  return loaded.mesh;
+}
+
+ModelCache::Stats ModelCache::GetStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Stats stats = stats_;
+  stats.entries = entries_.size();
+  return stats;
+}
+
+ModelCache::Loaded ModelCache::Load_(const std::string& path) {
+  // Парсер переиспользует буферы строк между загрузками в потоке
+  thread_local ObjParser parser;
+  Mesh mesh;
+
+  Loaded loaded;
+  loaded.error = parser.Load(path, mesh);
+  if (loaded.error == kNoError) {
+    loaded.mesh = std::make_shared<const RenderMesh>(BuildRenderMesh(mesh));
+  }
+  return loaded;
+}
+
+void ModelCache::Erase_(std::unordered_map<std::string, Entry>::iterator it) {
+  stats_.bytes -= it->second.bytes;
+  lru_.erase(it->second.lru);
+  entries_.erase(it);
+}
+
+void ModelCache::Evict_(const std::string& keep) {
+  while (stats_.bytes > capacity_bytes_ && !lru_.empty() &&
+         lru_.back() != keep) {
+    Erase_(entries_.find(lru_.back()));
+    ++stats_.evictions;
+  }
+}
+
+}  // namespace s21
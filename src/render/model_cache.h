@@ -0,0 +1,119 @@
+#ifndef RENDER_MODEL_CACHE_H
+#define RENDER_MODEL_CACHE_H
+
+/**
+ * @file model_cache.h
+ * @brief Потокобезопасный LRU-кэш разобранных моделей
+ */
+
+#include <cstdint>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "render_mesh.h"
+
+namespace s21 {
+
+/**
+ * @brief Кэш буферов рендера, ключ - путь к OBJ файлу
+ *
+ * Запись действительна, пока не изменились размер и время изменения
+ * файла. Параллельные запросы одного и того же файла ждут единственный
+ * разбор. Ошибки загрузки не кэшируются. При превышении ёмкости
+ * вытесняются давно не использованные модели; буферы, которые ещё
+ * рисуются, живут до конца отрисовки благодаря shared_ptr.
+ *
+ * @example
+ * @code
+ * ModelCache cache(256 << 20);
+ * int error = kNoError;
+ * auto mesh = cache.Get("cube.obj", error);
+ * if (mesh) rasterizer.Render(*mesh, camera, style, 512, 512, image);
+ * @endcode
+ */
+class ModelCache {
+ public:
+  /**
+   * @brief Счётчики кэша
+   */
+  struct Stats {
+    size_t hits = 0;       ///< Найдено в кэше
+    size_t misses = 0;     ///< Загружено с диска
+    size_t evictions = 0;  ///< Вытеснено
+    size_t entries = 0;    ///< Моделей в кэше
+    size_t bytes = 0;      ///< Занято памяти
+  };
+
+  /**
+   * @brief Создаёт кэш
+   * @param capacity_bytes Ёмкость в байтах буферов рендера
+   */
+  explicit ModelCache(size_t capacity_bytes);
+
+  /**
+   * @brief Возвращает буферы модели, загружая файл при необходимости
+   *
+   * @param path Путь к OBJ файлу
+   * @param error Код ошибки из error_list
+   * @return Буферы модели или nullptr при ошибке
+   */
+  std::shared_ptr<const RenderMesh> Get(const std::string& path, int& error);
+
+  /**
+   * @brief Возвращает счётчики кэша
+   */
+  Stats GetStats() const;
+
+ private:
+  /**
+   * @brief Результат загрузки модели
+   */
+  struct Loaded {
+    int error = 0;                            ///< Код ошибки
+    std::shared_ptr<const RenderMesh> mesh;  ///< Буферы при успехе
+  };
+
+  /**
+   * @brief Запись кэша
+   */
+  struct Entry {
+    std::shared_future<Loaded> loaded;  ///< Результат (возможно, в работе)
+    int64_t mtime = 0;                  ///< Время изменения файла
+    uint64_t size = 0;                  ///< Размер файла
+    size_t bytes = 0;                   ///< Занятая память (после загрузки)
+    uint64_t generation = 0;            ///< Номер загрузки
+    std::list<std::string>::iterator lru;  ///< Позиция в списке LRU
+  };
+
+  /**
+   * @brief Загружает файл и строит буферы рендера
+   */
+  static Loaded Load_(const std::string& path);
+
+  /**
+   * @brief Удаляет запись из кэша
+   * @pre mutex_ захвачен
+   */
+  void Erase_(std::unordered_map<std::string, Entry>::iterator it);
+
+  /**
+   * @brief Вытесняет старые записи до ёмкости, кроме keep
+   * @pre mutex_ захвачен
+   */
+  void Evict_(const std::string& keep);
+
+  const size_t capacity_bytes_;  ///< Ёмкость кэша
+  mutable std::mutex mutex_;     ///< Защищает поля ниже
+  std::unordered_map<std::string, Entry> entries_;  ///< Записи по пути
+  std::list<std::string> lru_;  ///< Пути, свежие в начале
+  Stats stats_;                 ///< Счётчики
+  uint64_t next_generation_ = 0;  ///< Счётчик загрузок
+};
+
+}  // namespace s21
+
+#endif  // RENDER_MODEL_CACHE_H
@@ -0,0 +1,462 @@
+/**
+ * @file picker.cpp
+ * @brief Реализация выбора элементов каркаса
+ */
+
+#include "picker.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "../profiling/trace.h"
+
+namespace s21 {
+
+namespace {
+
+/**
+ * @brief Точка в пространстве отсечения
+ */
+struct ClipPoint {
+  double x, y, z, w;
+};
+
+inline ClipPoint Transform(const Matrix4& m, const float p[3]) {
+  return {m[0] * p[0] + m[4] * p[1] + m[8] * p[2] + m[12],
+          m[1] * p[0] + m[5] * p[1] + m[9] * p[2] + m[13],
+          m[2] * p[0] + m[6] * p[1] + m[10] * p[2] + m[14],
+          m[3] * p[0] + m[7] * p[1] + m[11] * p[2] + m[15]};
+}
+
+inline ClipPoint Lerp(const ClipPoint& a, const ClipPoint& b, double t) {
+  return {a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t,
+          a.z + (b.z - a.z) * t, a.w + (b.w - a.w) * t};
+}
+
+inline bool Visible(const ClipPoint& c) {
+  return c.w >= Camera::kNearPlane && c.z >= -c.w && c.z <= c.w;
+}
+
+/**
+ * @brief Сужает [t0, t1] до части, где d0 + (d1 - d0) t >= 0
+ * @return false если такой части нет
+ */
+inline bool ClipParameter(double d0, double d1, double& t0, double& t1) {
+  if (d0 < 0.0 && d1 < 0.0) return false;
+  if (d0 < 0.0) t0 = std::max(t0, d0 / (d0 - d1));
+  if (d1 < 0.0) t1 = std::min(t1, d0 / (d0 - d1));
+  return t0 <= t1;
+}
+
+/**
+ * @brief Переводит точку отсечения в пиксели кадра
+ */
+class ScreenMapping {
+ public:
+  ScreenMapping(int width, int height)
+      : half_width_(width * 0.5), half_height_(height * 0.5) {}
+
+  double X(const ClipPoint& c) const {
+    return (c.x / c.w + 1.0) * half_width_;
+  }
+  double Y(const ClipPoint& c) const {
+    return (1.0 - c.y / c.w) * half_height_;
+  }
+
+ private:
+  double half_width_;
+  double half_height_;
+};
+
+/**
+ * @brief Видимость проекции box
+ */
+enum box_view_t {
+  kBoxHidden = 0,     ///< Box целиком за плоскостью отсечения
+  kBoxUnbounded = 1,  ///< Box пересекает ближнюю плоскость
+  kBoxClipped = 2,    ///< Часть box за плоскостями глубины
+  kBoxVisible = 3     ///< Box целиком виден
+};
+
+/**
+ * @brief Прямоугольник на экране, содержащий проекцию box
+ *
+ * Область видимости выпукла, поэтому box с видимыми углами виден
+ * целиком. Если box пересекает ближнюю плоскость, проекция не
+ * ограничена и прямоугольник не заполняется.
+ */
+box_view_t ProjectBox(const Matrix4& m, const ScreenMapping& screen,
+                        const BvhBox& box, double rect[4]) {
+  if (box.IsEmpty()) return kBoxHidden;
+  rect[0] = rect[1] = INFINITY;
+  rect[2] = rect[3] = -INFINITY;
+  int behind = 0, before = 0, beyond = 0;
+  for (int corner = 0; corner < 8; ++corner) {
+    const float p[3] = {corner & 1 ? box.max[0] : box.min[0],
+                        corner & 2 ? box.max[1] : box.min[1],
+                        corner & 4 ? box.max[2] : box.min[2]};
+    const ClipPoint c = Transform(m, p);
+    if (c.w < Camera::kNearPlane) {
+      ++behind;
+      continue;
+    }
+    before += c.z < -c.w;
+    beyond += c.z > c.w;
+    const double sx = screen.X(c), sy = screen.Y(c);
+    rect[0] = std::min(rect[0], sx);
+    rect[1] = std::min(rect[1], sy);
+    rect[2] = std::max(rect[2], sx);
+    rect[3] = std::max(rect[3], sy);
+  }
+  if (behind == 8 || before == 8 || beyond == 8) return kBoxHidden;
+  if (behind > 0) return kBoxUnbounded;
+  return before > 0 || beyond > 0 ? kBoxClipped : kBoxVisible;
+}
+
+/**
+ * @brief Нижняя оценка расстояния от курсора до проекции box, пиксели
+ */
+double ScreenBound(const Matrix4& m, const ScreenMapping& screen,
+                   const BvhBox& box, double x, double y) {
+  double rect[4];
+  const box_view_t view = ProjectBox(m, screen, box, rect);
+  if (view == kBoxHidden) return INFINITY;
+  if (view == kBoxUnbounded) return 0.0;
+  const double dx = std::max({rect[0] - x, 0.0, x - rect[2]});
+  const double dy = std::max({rect[1] - y, 0.0, y - rect[3]});
+  return std::sqrt(dx * dx + dy * dy);
+}
+
+/**
+ * @brief Квадрат расстояния от точки до box
+ */
+double BoxDistance2(const BvhBox& box, const double point[3]) {
+  if (box.IsEmpty()) return INFINITY;
+  double sum = 0.0;
+  for (int axis = 0; axis < 3; ++axis) {
+    const double d = std::max(
+        {box.min[axis] - point[axis], 0.0, point[axis] - box.max[axis]});
+    sum += d * d;
+  }
+  return sum;
+}
+
+/**
+ * @brief Лучший кандидат с правилом выбора при равных расстояниях
+ */
+struct Candidate {
+  bool found = false;
+  double distance = INFINITY;
+  double depth = INFINITY;
+  size_t index = 0;
+
+  bool Better(double d, double z, size_t i) const {
+    if (!found || d < distance) return true;
+    if (d > distance) return false;
+    return z < depth || (z == depth && i < index);
+  }
+};
+
+}  // namespace
+
+void Picker::Build(std::vector<float> positions, std::vector<int> edges) {
+  S21_TRACE_SCOPE("Picker::Build");
+  positions_ = std::move(positions);
+  edges_ = std::move(edges);
+  edges_.resize(edges_.size() / 2 * 2);
+  vertex_tree_.Build(GetVertexCount(), [this](size_t i) {
+    BvhBox box;
+    box.Expand(Vertex_(static_cast<uint32_t>(i)));
+    return box;
+  });
+  edge_tree_.Build(GetEdgeCount(),
+                   [this](size_t edge) { return EdgeBox_(edge); });
+}
+
+std::vector<float> Picker::Refit(std::vector<float> positions) {
+  S21_TRACE_SCOPE("Picker::Refit");
+  positions_.swap(positions);
+  if (positions.size() != positions_.size()) {
+    Build(std::move(positions_), std::move(edges_));
+    return positions;
+  }
+  vertex_tree_.Refit([this](size_t i) {
+    BvhBox box;
+    box.Expand(Vertex_(static_cast<uint32_t>(i)));
+    return box;
+  });
+  edge_tree_.Refit([this](size_t edge) { return EdgeBox_(edge); });
+  return positions;
+}
+
+BvhBox Picker::EdgeBox_(size_t edge) const noexcept {
+  BvhBox box;
+  const int a = edges_[edge * 2], b = edges_[edge * 2 + 1];
+  const size_t count = GetVertexCount();
+  if (a < 0 || b < 0 || size_t(a) >= count || size_t(b) >= count) {
+    return box;
+  }
+  box.Expand(Vertex_(a));
+  box.Expand(Vertex_(b));
+  return box;
+}
+
+PickResult Picker::Pick(const Camera& camera, int width, int height,
+                        double x, double y, double radius) const {
+  if (width <= 0 || height <= 0) return PickResult();
+  const Matrix4 matrix = camera.BuildMatrix(width, height);
+  PickResult result = PickVertex_(matrix, width, height, x, y, radius);
+  if (result.kind == kPickNone) {
+    result = PickEdge_(matrix, width, height, x, y, radius);
+  }
+  return result;
+}
+
+PickResult Picker::PickVertex_(const Matrix4& matrix, int width, int height,
+                               double x, double y, double radius) const {
+  const ScreenMapping screen(width, height);
+  Candidate best;
+  vertex_tree_.VisitNearest(
+      [&](const BvhBox& box) {
+        return ScreenBound(matrix, screen, box, x, y);
+      },
+      [&](uint32_t i, double& limit) {
+        const ClipPoint c = Transform(matrix, Vertex_(i));
+        if (!Visible(c)) return;
+        const double dx = screen.X(c) - x, dy = screen.Y(c) - y;
+        const double distance = std::sqrt(dx * dx + dy * dy);
+        if (distance > limit || !best.Better(distance, c.z / c.w, i)) return;
+        best = {true, distance, c.z / c.w, i};
+        limit = distance;
+      },
+      radius);
+
+  PickResult result;
+  if (!best.found) return result;
+  result.kind = kPickVertex;
+  result.index = best.index;
+  result.vertex[0] = result.vertex[1] = static_cast<uint32_t>(best.index);
+  const float* p = Vertex_(static_cast<uint32_t>(best.index));
+  std::copy(p, p + 3, result.position);
+  result.distance = best.distance;
+  return result;
+}
+
+PickResult Picker::PickEdge_(const Matrix4& matrix, int width, int height,
+                             double x, double y, double radius) const {
+  const ScreenMapping screen(width, height);
+  const size_t count = GetVertexCount();
+  Candidate best;
+  double best_t = 0.0;
+  edge_tree_.VisitNearest(
+      [&](const BvhBox& box) {
+        return ScreenBound(matrix, screen, box, x, y);
+      },
+      [&](uint32_t edge, double& limit) {
+        const int a = edges_[size_t{edge} * 2];
+        const int b = edges_[size_t{edge} * 2 + 1];
+        if (a < 0 || b < 0 || size_t(a) >= count || size_t(b) >= count) {
+          return;
+        }
+        const ClipPoint ca = Transform(matrix, Vertex_(a));
+        const ClipPoint cb = Transform(matrix, Vertex_(b));
+        double t0 = 0.0, t1 = 1.0;
+        const double near = Camera::kNearPlane;
+        if (!ClipParameter(ca.w - near, cb.w - near, t0, t1) ||
+            !ClipParameter(ca.w + ca.z, cb.w + cb.z, t0, t1) ||
+            !ClipParameter(ca.w - ca.z, cb.w - cb.z, t0, t1)) {
+          return;
+        }
+        const ClipPoint p0 = Lerp(ca, cb, t0), p1 = Lerp(ca, cb, t1);
+        const double x0 = screen.X(p0), y0 = screen.Y(p0);
+        const double dx = screen.X(p1) - x0, dy = screen.Y(p1) - y0;
+        const double length2 = dx * dx + dy * dy;
+        const double s =
+            length2 > 0.0
+                ? std::clamp(((x - x0) * dx + (y - y0) * dy) / length2, 0.0,
+                             1.0)
+                : 0.0;
+        const double ex = x0 + dx * s - x, ey = y0 + dy * s - y;
+        const double distance = std::sqrt(ex * ex + ey * ey);
+        if (distance > limit) return;
+        // Доля s на экране соответствует доле u отрезка в пространстве:
+        // линейно на экране меняются 1 / w и u / w
+        const double denominator = s * p0.w + (1.0 - s) * p1.w;
+        const double u = denominator > 0.0 ? s * p0.w / denominator : 0.0;
+        const double t = t0 + (t1 - t0) * u;
+        const ClipPoint c = Lerp(ca, cb, t);
+        if (!best.Better(distance, c.z / c.w, edge)) return;
+        best = {true, distance, c.z / c.w, edge};
+        best_t = t;
+        limit = distance;
+      },
+      radius);
+
+  PickResult result;
+  if (!best.found) return result;
+  result.kind = kPickEdge;
+  result.index = best.index;
+  result.vertex[0] = static_cast<uint32_t>(edges_[best.index * 2]);
+  result.vertex[1] = static_cast<uint32_t>(edges_[best.index * 2 + 1]);
+  const float* a = Vertex_(result.vertex[0]);
+  const float* b = Vertex_(result.vertex[1]);
+  for (int axis = 0; axis < 3; ++axis) {
+    result.position[axis] = a[axis] + (double(b[axis]) - a[axis]) * best_t;
+  }
+  result.distance = best.distance;
+  return result;
+}
+
+PickResult Picker::Nearest(const double point[3], pick_t kind) const {
+  Candidate best;
+  double best_t = 0.0;
+  const size_t count = GetVertexCount();
+  auto bound = [&](const BvhBox& box) {
+    return std::sqrt(BoxDistance2(box, point));
+  };
+  if (kind == kPickVertex) {
+    vertex_tree_.VisitNearest(
+        bound,
+        [&](uint32_t i, double& limit) {
+          const float* p = Vertex_(i);
+          double sum = 0.0;
+          for (int axis = 0; axis < 3; ++axis) {
+            sum += (p[axis] - point[axis]) * (p[axis] - point[axis]);
+          }
+          const double distance = std::sqrt(sum);
+          if (distance > limit || !best.Better(distance, 0.0, i)) return;
+          best = {true, distance, 0.0, i};
+          limit = distance;
+        },
+        INFINITY);
+  } else if (kind == kPickEdge) {
+    edge_tree_.VisitNearest(
+        bound,
+        [&](uint32_t edge, double& limit) {
+          const int a = edges_[size_t{edge} * 2];
+          const int b = edges_[size_t{edge} * 2 + 1];
+          if (a < 0 || b < 0 || size_t(a) >= count || size_t(b) >= count) {
+            return;
+          }
+          const float* pa = Vertex_(a);
+          const float* pb = Vertex_(b);
+          double d[3], w[3], length2 = 0.0, dot = 0.0;
+          for (int axis = 0; axis < 3; ++axis) {
+            d[axis] = double(pb[axis]) - pa[axis];
+            w[axis] = point[axis] - pa[axis];
+            length2 += d[axis] * d[axis];
+            dot += d[axis] * w[axis];
+          }
+          const double t = length2 > 0.0 ? std::clamp(dot / length2, 0.0, 1.0)
+                                         : 0.0;
+          double sum = 0.0;
+          for (int axis = 0; axis < 3; ++axis) {
+            const double e = w[axis] - d[axis] * t;
+            sum += e * e;
+          }
+          const double distance = std::sqrt(sum);
+          if (distance > limit || !best.Better(distance, 0.0, edge)) return;
+          best = {true, distance, 0.0, edge};
+          best_t = t;
+          limit = distance;
+        },
+        INFINITY);
+  }
+
+  PickResult result;
+  if (!best.found) return result;
+  result.kind = kind;
+  result.index = best.index;
+  if (kind == kPickVertex) {
+    result.vertex[0] = result.vertex[1] = static_cast<uint32_t>(best.index);
+  } else {
+    result.vertex[0] = static_cast<uint32_t>(edges_[best.index * 2]);
+    result.vertex[1] = static_cast<uint32_t>(edges_[best.index * 2 + 1]);
+  }
+  const float* a = Vertex_(result.vertex[0]);
+  const float* b = Vertex_(result.vertex[1]);
+  for (int axis = 0; axis < 3; ++axis) {
+    result.position[axis] = a[axis] + (double(b[axis]) - a[axis]) * best_t;
+  }
+  result.distance = best.distance;
+  return result;
+}
+
+void Picker::Select(const Camera& camera, int width, int height,
+                    const ScreenRegion& region, select_mode_t mode,
+                    SelectionBits& selection) const {
+  S21_TRACE_SCOPE("Picker::Select");
+  const size_t count = GetVertexCount();
+  if (selection.GetSize() != count) selection.Reset(count);
+  SelectionBits hit;
+  hit.Reset(count);
+  if (width > 0 && height > 0 && !region.IsEmpty()) {
+    const Matrix4 matrix = camera.BuildMatrix(width, height);
+    const ScreenMapping screen(width, height);
+    vertex_tree_.VisitOverlap(
+        [&](const BvhBox& box) {
+          double rect[4];
+          const box_view_t view = ProjectBox(matrix, screen, box, rect);
+          if (view == kBoxHidden) return kBvhOutside;
+          if (view == kBoxUnbounded) return kBvhPartial;
+          const bvh_overlap_t overlap =
+              region.Classify(rect[0], rect[1], rect[2], rect[3]);
+          return overlap == kBvhInside && view == kBoxClipped ? kBvhPartial
+                                                              : overlap;
+        },
+        [&](size_t begin, size_t end) { hit.SetRange(begin, end); },
+        [&](size_t position, uint32_t vertex) {
+          const ClipPoint c = Transform(matrix, Vertex_(vertex));
+          if (Visible(c) && region.Contains(screen.X(c), screen.Y(c))) {
+            hit.Set(position);
+          }
+        },
+        vertex_tree_.GetThreadCount());
+  }
+  selection.Combine(hit, mode);
+}
+
+SelectionStats Picker::Summarize(const SelectionBits& selection) const {
+  SelectionStats stats;
+  const size_t count = GetVertexCount();
+  if (selection.GetSize() != count || count == 0) return stats;
+  static_assert(64 % Bvh::kLeafSize == 0, "лист не должен делить слово");
+  constexpr uint64_t kLeafMask = (uint64_t{1} << Bvh::kLeafSize) - 1;
+  const std::vector<uint32_t>& order = vertex_tree_.GetOrder();
+  BvhBox bounds;
+  for (size_t leaf = 0; leaf < vertex_tree_.GetLeafCount(); ++leaf) {
+    const size_t first = leaf * Bvh::kLeafSize;
+    const size_t size = std::min(Bvh::kLeafSize, count - first);
+    const uint64_t bits =
+        selection.GetWord(first / 64) >> (first % 64) & kLeafMask;
+    if (bits == 0) continue;
+    if (bits == (kLeafMask >> (Bvh::kLeafSize - size))) {
+      bounds.Expand(vertex_tree_.GetLeafBox(leaf));
+      stats.count += size;
+      continue;
+    }
+    for (size_t k = 0; k < size; ++k) {
+      if (bits >> k & 1) {
+        bounds.Expand(Vertex_(order[first + k]));
+        ++stats.count;
+      }
+    }
+  }
+  if (stats.count > 0) {
+    std::copy(bounds.min, bounds.min + 3, stats.min);
+    std::copy(bounds.max, bounds.max + 3, stats.max);
+  }
+  return stats;
+}
+
+void Picker::GetSelectedVertices(const SelectionBits& selection,
+                                 std::vector<uint32_t>& vertices) const {
+  vertices.clear();
+  if (selection.GetSize() != GetVertexCount()) return;
+  const std::vector<uint32_t>& order = vertex_tree_.GetOrder();
+  selection.ForEach([&](size_t position) {
+    vertices.push_back(order[position]);
+  });
+}
+
+}  // namespace s21
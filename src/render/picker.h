@@ -0,0 +1,176 @@
+#ifndef RENDER_PICKER_H
+#define RENDER_PICKER_H
+
+/**
+ * @file picker.h
+ * @brief Выбор вершины или ребра под курсором
+ */
+
+#include <cstdint>
+#include <vector>
+
+#include "../model/bvh.h"
+#include "camera.h"
+#include "selection.h"
+
+namespace s21 {
+
+/**
+ * @brief Тип выбранного элемента
+ */
+enum pick_t {
+  kPickNone = 0,    ///< Под курсором ничего нет
+  kPickVertex = 1,  ///< Вершина
+  kPickEdge = 2     ///< Ребро
+};
+
+constexpr double kDefaultPickRadius = 6.0;  ///< Допуск выбора, пикселей
+
+/**
+ * @brief Результат выбора
+ */
+struct PickResult {
+  pick_t kind = kPickNone;  ///< Что выбрано
+  size_t index = 0;         ///< Номер вершины или ребра
+  uint32_t vertex[2] = {0, 0};  ///< Концы ребра; для вершины - она же
+  double position[3] = {0.0, 0.0, 0.0};  ///< Точка в координатах модели
+  double distance = 0.0;  ///< До курсора (пиксели) или до точки запроса
+};
+
+/**
+ * @brief Итог выделения вершин
+ */
+struct SelectionStats {
+  size_t count = 0;                 ///< Выделено вершин
+  double min[3] = {0.0, 0.0, 0.0};  ///< Box выделенных (при count > 0)
+  double max[3] = {0.0, 0.0, 0.0};
+};
+
+/**
+ * @brief Ускоренный иерархиями выбор элементов каркаса
+ *
+ * Над вершинами и над рёбрами строится по Bvh. Запрос луча под
+ * курсором выполняется в пространстве экрана: box узла проецируется
+ * камерой, расстояние от курсора до проекции - нижняя оценка, поэтому
+ * обход спускается только в узлы, пересекающие допуск вокруг курсора,
+ * и на 50 млн рёбер занимает доли миллисекунды. Это тот же луч с
+ * конусом допуска в радиус пикселей, но без выбора толщины луча в
+ * единицах модели. Вершина в пределах допуска предпочитается ребру,
+ * при равенстве расстояний выигрывает ближний к камере элемент.
+ *
+ * Picker хранит собственную копию координат в float: вид меняет свои
+ * буферы при трансформациях, а построение идёт в фоне. После
+ * трансформации (топология не меняется) достаточно Refit.
+ *
+ * Выделение рамкой или лассо обходит иерархию вершин: узел, проекция
+ * которого целиком в области, принимается одним диапазоном бит, целиком
+ * вне - отбрасывается, проверяются только вершины пограничных листьев.
+ * Биты SelectionBits идут в порядке листьев иерархии, поэтому принятый
+ * узел - непрерывный диапазон слов; разметка сохраняется при Refit и
+ * теряет смысл после Build.
+ *
+ * @example
+ * @code
+ * Picker picker(DefaultThreadCount());
+ * picker.Build(std::move(positions), std::move(edges));
+ * PickResult hit = picker.Pick(camera, width(), height(), x + 0.5, y + 0.5);
+ * if (hit.kind == kPickVertex) ShowVertex(hit.index, hit.position);
+ * @endcode
+ */
+class Picker {
+ public:
+  explicit Picker(unsigned threads = 1) : vertex_tree_(threads),
+                                          edge_tree_(threads) {}
+
+  /**
+   * @brief Строит иерархии заново
+   *
+   * @param positions Координаты вершин x, y, z подряд
+   * @param edges Пары индексов концов рёбер; рёбра с индексами вне
+   * диапазона вершин не выбираются
+   */
+  void Build(std::vector<float> positions, std::vector<int> edges);
+
+  /**
+   * @brief Обновляет координаты при прежних рёбрах
+   *
+   * Число вершин должно совпадать с переданным в Build.
+   *
+   * @return Прежние координаты: вызывающий заполняет их при следующем
+   *         Refit без выделения памяти
+   */
+  std::vector<float> Refit(std::vector<float> positions);
+
+  size_t GetVertexCount() const noexcept { return positions_.size() / 3; }
+  size_t GetEdgeCount() const noexcept { return edges_.size() / 2; }
+
+  /**
+   * @brief Выбирает элемент под точкой кадра
+   *
+   * @param camera Камера кадра (та же, что при отрисовке)
+   * @param width Ширина кадра, пикселей
+   * @param height Высота кадра, пикселей
+   * @param x Координата курсора (центр пикселя i - i + 0.5)
+   * @param y Координата курсора, ось вниз
+   * @param radius Допуск, пикселей
+   * @return Ближайшая видимая камере вершина, иначе ребро, иначе kPickNone
+   */
+  PickResult Pick(const Camera& camera, int width, int height, double x,
+                  double y, double radius = kDefaultPickRadius) const;
+
+  /**
+   * @brief Ближайший к точке модели элемент
+   *
+   * @param point Точка в координатах модели
+   * @param kind kPickVertex или kPickEdge
+   */
+  PickResult Nearest(const double point[3], pick_t kind) const;
+
+  /**
+   * @brief Выделяет видимые камере вершины в области кадра
+   *
+   * @param region Рамка или лассо в пикселях кадра
+   * @param mode Как сочетать с прежним выделением
+   * @param selection Выделение; при другом числе вершин очищается
+   */
+  void Select(const Camera& camera, int width, int height,
+              const ScreenRegion& region, select_mode_t mode,
+              SelectionBits& selection) const;
+
+  /**
+   * @brief Число и box выделенных вершин
+   *
+   * Полностью выделенный лист учитывается своим box без обхода вершин.
+   */
+  SelectionStats Summarize(const SelectionBits& selection) const;
+
+  /**
+   * @brief Номера выделенных вершин в порядке иерархии
+   */
+  void GetSelectedVertices(const SelectionBits& selection,
+                           std::vector<uint32_t>& vertices) const;
+
+ private:
+  const float* Vertex_(uint32_t index) const noexcept {
+    return &positions_[size_t{index} * 3];
+  }
+
+  /**
+   * @brief Box ребра; пустой для ребра с неверным индексом
+   */
+  BvhBox EdgeBox_(size_t edge) const noexcept;
+
+  PickResult PickVertex_(const Matrix4& matrix, int width, int height,
+                         double x, double y, double radius) const;
+  PickResult PickEdge_(const Matrix4& matrix, int width, int height,
+                       double x, double y, double radius) const;
+
+  std::vector<float> positions_;  ///< Координаты вершин
+  std::vector<int> edges_;        ///< Пары концов рёбер
+  Bvh vertex_tree_;               ///< Иерархия над вершинами
+  Bvh edge_tree_;                 ///< Иерархия над рёбрами
+};
+
+}  // namespace s21
+
+#endif  // RENDER_PICKER_H
@@ -0,0 +1,452 @@
+/**
+ * @file rasterizer.cpp
+ * @brief Реализация программного растеризатора
+ */
+
+#include "rasterizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#include "../model/parallel.h"
+#include "../profiling/trace.h"
+
+namespace s21 {
+
+namespace {
+
+constexpr size_t kProjectChunk = size_t{1} << 15;  ///< Вершин на задачу
+constexpr size_t kEdgesPerChunk = size_t{1} << 12;  ///< Минимум рёбер
+
+/**
+ * @brief Отсечение отрезка прямоугольником (Лианг-Барски)
+ *
+ * @param t0 Начало видимой части (доля отрезка)
+ * @param t1 Конец видимой части
+ * @return false если отрезок целиком вне прямоугольника
+ */
+bool ClipRange(double x0, double y0, double dx, double dy, double min_x,
+               double min_y, double max_x, double max_y, double& t0,
+               double& t1) {
+  t0 = 0.0;
+  t1 = 1.0;
+  const double p[4] = {-dx, dx, -dy, dy};
+  const double q[4] = {x0 - min_x, max_x - x0, y0 - min_y, max_y - y0};
+
+  for (int i = 0; i < 4; ++i) {
+    if (p[i] == 0.0) {
+      if (q[i] < 0.0) return false;
+      continue;
+    }
+    const double t = q[i] / p[i];
+    if (p[i] < 0.0) {
+      if (t > t1) return false;
+      t0 = std::max(t0, t);
+    } else {
+      if (t < t0) return false;
+      t1 = std::min(t1, t);
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Проецирует вершины [begin, end) в столбцы координат отсечения
+ *
+ * Без ветвлений и с __restrict: GCC и Clang векторизуют цикл (SSE/AVX,
+ * NEON) без ручных интринсиков.
+ */
+void ProjectRange(const float* __restrict position, size_t begin, size_t end,
+                  const float* __restrict m, float* __restrict out_x,
+                  float* __restrict out_y, float* __restrict out_z,
+                  float* __restrict out_w) {
+  for (size_t i = begin; i < end; ++i) {
+    const float x = position[i * 3];
+    const float y = position[i * 3 + 1];
+    const float z = position[i * 3 + 2];
+    out_x[i] = m[0] * x + m[4] * y + m[8] * z + m[12];
+    out_y[i] = m[1] * x + m[5] * y + m[9] * z + m[13];
+    out_z[i] = m[2] * x + m[6] * y + m[10] * z + m[14];
+    out_w[i] = m[3] * x + m[7] * y + m[11] * z + m[15];
+  }
+}
+
+/**
+ * @brief Смешивает цвет с пикселем с долей покрытия coverage
+ *
+ * Каналы R/B и G/A обрабатываются парами в одном 32-битном слове.
+ */
+inline uint32_t Blend(uint32_t dst, uint32_t color, float coverage) {
+  const uint32_t a = static_cast<uint32_t>(coverage * 256.0f + 0.5f);
+  if (a >= 256) return color;
+  const uint32_t rb =
+      ((dst & 0xFF00FFu) * (256 - a) + (color & 0xFF00FFu) * a) >> 8 &
+      0xFF00FFu;
+  const uint32_t ga = ((dst >> 8 & 0xFF00FFu) * (256 - a) +
+                       (color >> 8 & 0xFF00FFu) * a) &
+                      0xFF00FF00u;
+  return rb | ga;
+}
+
+/**
+ * @brief Область кадра, в которую рисует одна плитка
+ */
+struct TileTarget {
+  uint32_t* pixels;  ///< Пиксели кадра
+  float* depth;      ///< Глубина кадра
+  int width;         ///< Ширина кадра
+  int x0, y0, x1, y1;  ///< Границы плитки [x0, x1) x [y0, y1)
+  uint32_t color;    ///< Цвет рёбер
+};
+
+/**
+ * @brief Закрашивает пиксель плитки с тестом глубины GL_LEQUAL
+ *
+ * Глубина записывается, если пиксель покрыт больше чем наполовину:
+ * полупрозрачная кайма сглаживания не закрывает рёбра позади.
+ */
+inline void Plot(const TileTarget& target, int x, int y, float z,
+                 float coverage) {
+  if (x < target.x0 || x >= target.x1 || y < target.y0 || y >= target.y1 ||
+      coverage <= 0.0f) {
+    return;
+  }
+  const size_t index = static_cast<size_t>(y) * target.width + x;
+  if (z > target.depth[index]) return;
+  target.pixels[index] = Blend(target.pixels[index], target.color, coverage);
+  if (coverage >= 0.5f) target.depth[index] = z;
+}
+
+/**
+ * @brief Рисует часть ребра, попадающую в плитку
+ *
+ * Ребро проходится по столбцам основной оси; положение на второй оси и
+ * глубина вычисляются из уравнения всего ребра, а не обрезанного по
+ * плитке, поэтому на стыках плиток нет швов. Со сглаживанием (Ву)
+ * каждый столбец закрашивает два соседних пикселя пропорционально
+ * расстоянию до линии.
+ */
+void DrawEdgeInTile(float x0, float y0, float z0, float x1, float y1,
+                    float z1, const TileTarget& target, bool antialias) {
+  const bool steep = std::fabs(y1 - y0) > std::fabs(x1 - x0);
+  if (steep) {
+    std::swap(x0, y0);
+    std::swap(x1, y1);
+  }
+  if (x0 > x1) {
+    std::swap(x0, x1);
+    std::swap(y0, y1);
+    std::swap(z0, z1);
+  }
+
+  const float dx = x1 - x0;
+  const float slope = dx > 0.0f ? (y1 - y0) / dx : 0.0f;
+  const float z_slope = dx > 0.0f ? (z1 - z0) / dx : 0.0f;
+  const int first = std::max(static_cast<int>(std::lround(x0)),
+                             steep ? target.y0 : target.x0);
+  const int last = std::min(static_cast<int>(std::lround(x1)),
+                            (steep ? target.y1 : target.x1) - 1);
+
+  for (int column = first; column <= last; ++column) {
+    const float offset = column - x0;
+    const float y = y0 + offset * slope;
+    const float z = z0 + offset * z_slope;
+    if (antialias) {
+      const float base = std::floor(y);
+      const float fraction = y - base;
+      const int row = static_cast<int>(base);
+      if (steep) {
+        Plot(target, row, column, z, 1.0f - fraction);
+        Plot(target, row + 1, column, z, fraction);
+      } else {
+        Plot(target, column, row, z, 1.0f - fraction);
+        Plot(target, column, row + 1, z, fraction);
+      }
+    } else {
+      const int row = static_cast<int>(std::lround(y));
+      if (steep) {
+        Plot(target, row, column, z, 1.0f);
+      } else {
+        Plot(target, column, row, z, 1.0f);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+bool DrawLine(Image& image, double x0, double y0, double x1, double y1,
+              uint32_t color) {
+  double t0 = 0.0, t1 = 1.0;
+  if (image.width <= 0 || image.height <= 0 || !std::isfinite(x0) ||
+      !std::isfinite(y0) || !std::isfinite(x1) || !std::isfinite(y1) ||
+      !ClipRange(x0, y0, x1 - x0, y1 - y0, 0.0, 0.0, image.width - 1.0,
+                 image.height - 1.0, t0, t1)) {
+    return false;
+  }
+  const double dx = x1 - x0;
+  const double dy = y1 - y0;
+  x1 = x0 + t1 * dx;
+  y1 = y0 + t1 * dy;
+  x0 = x0 + t0 * dx;
+  y0 = y0 + t0 * dy;
+
+  int ix0 = static_cast<int>(std::lround(x0));
+  int iy0 = static_cast<int>(std::lround(y0));
+  const int ix1 = static_cast<int>(std::lround(x1));
+  const int iy1 = static_cast<int>(std::lround(y1));
+  const int step_dx = std::abs(ix1 - ix0);
+  const int step_dy = -std::abs(iy1 - iy0);
+  const int step_x = ix0 < ix1 ? 1 : -1;
+  const int step_y = iy0 < iy1 ? 1 : -1;
+  int error = step_dx + step_dy;
+
+  uint32_t* pixels = image.pixels.data();
+  for (;;) {
+    pixels[static_cast<size_t>(iy0) * image.width + ix0] = color;
+    if (ix0 == ix1 && iy0 == iy1) break;
+    const int doubled = 2 * error;
+    if (doubled >= step_dy) {
+      error += step_dy;
+      ix0 += step_x;
+    }
+    if (doubled <= step_dx) {
+      error += step_dx;
+      iy0 += step_y;
+    }
+  }
+  return true;
+}
+
+size_t Rasterizer::Render(const RenderMesh& mesh, const Camera& camera,
+                          const RenderStyle& style, int width, int height,
+                          Image& image) {
+  S21_TRACE_SCOPE("Rasterizer::Render");
+
+  image.Resize(std::max(width, 0), std::max(height, 0));
+  if (width <= 0 || height <= 0) {
+    return 0;
+  }
+  depth_.resize(image.pixels.size());
+  tiles_x_ = (width + kTileSize - 1) / kTileSize;
+  tiles_y_ = (height + kTileSize - 1) / kTileSize;
+  const size_t tile_count = static_cast<size_t>(tiles_x_) * tiles_y_;
+
+  ProjectVertices_(mesh, camera.BuildMatrix(width, height));
+
+  size_t drawn = 0;
+  if (style.style & kStyleLines) {
+    drawn = BinEdges_(mesh, width, height);
+  } else {
+    bin_offset_.assign(tile_count + 1, 0);
+  }
+
+  {
+    S21_TRACE_SCOPE("Rasterizer::RasterizeTiles");
+    ParallelFor(tile_count, threads_, [&](unsigned, size_t tile) {
+      RasterizeTile_(tile, style, image);
+    });
+  }
+
+  if (style.style & kStylePoints) {
+    DrawPoints_(style, image);
+  }
+  return drawn;
+}
+
+void Rasterizer::ProjectVertices_(const RenderMesh& mesh,
+                                  const Matrix4& matrix) {
+  S21_TRACE_SCOPE("Rasterizer::ProjectVertices_");
+
+  const size_t count = mesh.GetVertexCount();
+  clip_x_.resize(count);
+  clip_y_.resize(count);
+  clip_z_.resize(count);
+  clip_w_.resize(count);
+
+  float m[16];
+  for (int i = 0; i < 16; ++i) m[i] = static_cast<float>(matrix[i]);
+
+  const size_t chunks = (count + kProjectChunk - 1) / kProjectChunk;
+  ParallelFor(chunks, threads_, [&](unsigned, size_t chunk) {
+    const size_t begin = chunk * kProjectChunk;
+    ProjectRange(mesh.position.data(), begin,
+                 std::min(count, begin + kProjectChunk), m, clip_x_.data(),
+                 clip_y_.data(), clip_z_.data(), clip_w_.data());
+  });
+}
+
+size_t Rasterizer::BinEdges_(const RenderMesh& mesh, int width, int height) {
+  S21_TRACE_SCOPE("Rasterizer::BinEdges_");
+
+  const size_t edge_count = mesh.edges.size() / 2;
+  const size_t vertex_count = clip_w_.size();
+  const size_t tile_count = static_cast<size_t>(tiles_x_) * tiles_y_;
+  const size_t chunks = std::clamp<size_t>(
+      (edge_count + kEdgesPerChunk - 1) / kEdgesPerChunk, 1,
+      std::max(threads_, 1u));
+  screen_.resize(edge_count);
+  chunk_bins_.resize(chunks);
+  std::vector<size_t> visible(chunks, 0);
+
+  const double half_width = width * 0.5;
+  const double half_height = height * 0.5;
+  const double near = Camera::kNearPlane;
+
+  ParallelFor(chunks, threads_, [&](unsigned, size_t chunk) {
+    auto& bins = chunk_bins_[chunk];
+    bins.clear();
+    const size_t begin = edge_count * chunk / chunks;
+    const size_t end = edge_count * (chunk + 1) / chunks;
+
+    for (size_t edge = begin; edge < end; ++edge) {
+      const uint32_t a = mesh.edges[edge * 2];
+      const uint32_t b = mesh.edges[edge * 2 + 1];
+      if (a >= vertex_count || b >= vertex_count) continue;
+
+      // Отсечение по плоскостям w >= near, -w <= z <= w, как в OpenGL
+      const double ax = clip_x_[a], ay = clip_y_[a], az = clip_z_[a],
+                   aw = clip_w_[a];
+      const double bx = clip_x_[b], by = clip_y_[b], bz = clip_z_[b],
+                   bw = clip_w_[b];
+      const double distance[3][2] = {
+          {aw - near, bw - near}, {aw + az, bw + bz}, {aw - az, bw - bz}};
+      double t0 = 0.0, t1 = 1.0;
+      bool rejected = false;
+      for (const auto& d : distance) {
+        if (!(d[0] >= 0.0) && !(d[1] >= 0.0)) {
+          rejected = true;
+          break;
+        }
+        if (d[0] < 0.0) t0 = std::max(t0, d[0] / (d[0] - d[1]));
+        if (d[1] < 0.0) t1 = std::min(t1, d[0] / (d[0] - d[1]));
+      }
+      if (rejected || t0 > t1) continue;
+
+      double point[2][3];
+      for (int end_index = 0; end_index < 2; ++end_index) {
+        const double t = end_index ? t1 : t0;
+        const double w = aw + (bw - aw) * t;
+        point[end_index][0] = ((ax + (bx - ax) * t) / w + 1.0) * half_width -
+                              0.5;
+        point[end_index][1] = (1.0 - (ay + (by - ay) * t) / w) * half_height -
+                              0.5;
+        point[end_index][2] = (az + (bz - az) * t) / w;
+      }
+
+      // Кадр с запасом в пиксель под кайму сглаживания
+      const double dx = point[1][0] - point[0][0];
+      const double dy = point[1][1] - point[0][1];
+      const double dz = point[1][2] - point[0][2];
+      double s0 = 0.0, s1 = 1.0;
+      if (!std::isfinite(dx) || !std::isfinite(dy) ||
+          !ClipRange(point[0][0], point[0][1], dx, dy, -1.0, -1.0, width,
+                     height, s0, s1)) {
+        continue;
+      }
+      ScreenEdge& screen = screen_[edge];
+      screen.x0 = static_cast<float>(point[0][0] + dx * s0);
+      screen.y0 = static_cast<float>(point[0][1] + dy * s0);
+      screen.z0 = static_cast<float>(point[0][2] + dz * s0);
+      screen.x1 = static_cast<float>(point[0][0] + dx * s1);
+      screen.y1 = static_cast<float>(point[0][1] + dy * s1);
+      screen.z1 = static_cast<float>(point[0][2] + dz * s1);
+      ++visible[chunk];
+
+      // Плитки из охватывающего прямоугольника, которые ребро задевает
+      const auto tile_of = [](float coord, int limit) {
+        return std::clamp(static_cast<int>(std::floor(coord / kTileSize)), 0,
+                          limit - 1);
+      };
+      const int tx0 = tile_of(std::min(screen.x0, screen.x1) - 1.0f, tiles_x_);
+      const int tx1 = tile_of(std::max(screen.x0, screen.x1) + 1.0f, tiles_x_);
+      const int ty0 = tile_of(std::min(screen.y0, screen.y1) - 1.0f, tiles_y_);
+      const int ty1 = tile_of(std::max(screen.y0, screen.y1) + 1.0f, tiles_y_);
+      for (int ty = ty0; ty <= ty1; ++ty) {
+        for (int tx = tx0; tx <= tx1; ++tx) {
+          double u0 = 0.0, u1 = 1.0;
+          if ((tx0 == tx1 && ty0 == ty1) ||
+              ClipRange(screen.x0, screen.y0, screen.x1 - screen.x0,
+                        screen.y1 - screen.y0, tx * kTileSize - 1.0,
+                        ty * kTileSize - 1.0, (tx + 1.0) * kTileSize,
+                        (ty + 1.0) * kTileSize, u0, u1)) {
+            bins.emplace_back(static_cast<uint32_t>(ty * tiles_x_ + tx),
+                              static_cast<uint32_t>(edge));
+          }
+        }
+      }
+    }
+  });
+
+  // Списки плиток собираются в порядке рёбер, чтобы порядок смешивания
+  // не зависел от числа потоков
+  bin_offset_.assign(tile_count + 1, 0);
+  for (const auto& bins : chunk_bins_) {
+    for (const auto& entry : bins) ++bin_offset_[entry.first + 1];
+  }
+  for (size_t tile = 0; tile < tile_count; ++tile) {
+    bin_offset_[tile + 1] += bin_offset_[tile];
+  }
+  bin_edges_.resize(bin_offset_[tile_count]);
+  std::vector<uint32_t> cursor(bin_offset_.begin(), bin_offset_.end() - 1);
+  for (const auto& bins : chunk_bins_) {
+    for (const auto& entry : bins) {
+      bin_edges_[cursor[entry.first]++] = entry.second;
+    }
+  }
+
+  size_t total = 0;
+  for (size_t count : visible) total += count;
+  return total;
+}
+
+void Rasterizer::RasterizeTile_(size_t tile, const RenderStyle& style,
+                                Image& image) {
+  TileTarget target;
+  target.pixels = image.pixels.data();
+  target.depth = depth_.data();
+  target.width = image.width;
+  target.x0 = static_cast<int>(tile % tiles_x_) * kTileSize;
+  target.y0 = static_cast<int>(tile / tiles_x_) * kTileSize;
+  target.x1 = std::min(target.x0 + kTileSize, image.width);
+  target.y1 = std::min(target.y0 + kTileSize, image.height);
+  target.color = style.line_color;
+
+  for (int y = target.y0; y < target.y1; ++y) {
+    const size_t row = static_cast<size_t>(y) * image.width;
+    std::fill(target.pixels + row + target.x0, target.pixels + row + target.x1,
+              style.background);
+    std::fill(target.depth + row + target.x0, target.depth + row + target.x1,
+              1.0f);
+  }
+
+  for (uint32_t i = bin_offset_[tile]; i < bin_offset_[tile + 1]; ++i) {
+    const ScreenEdge& edge = screen_[bin_edges_[i]];
+    DrawEdgeInTile(edge.x0, edge.y0, edge.z0, edge.x1, edge.y1, edge.z1,
+                   target, style.antialias);
+  }
+}
+
+void Rasterizer::DrawPoints_(const RenderStyle& style, Image& image) const {
+  const int width = image.width;
+  const int height = image.height;
+  const float half = style.point_size * 0.5f;
+  for (size_t i = 0; i < clip_w_.size(); ++i) {
+    const float w = clip_w_[i];
+    if (!(w >= Camera::kNearPlane) || !(std::fabs(clip_z_[i]) <= w)) continue;
+    const float x = (clip_x_[i] / w + 1.0f) * 0.5f * width;
+    const float y = (1.0f - clip_y_[i] / w) * 0.5f * height;
+    if (!(std::fabs(x) < 1e6f && std::fabs(y) < 1e6f)) continue;
+    const int x0 = std::max(0, static_cast<int>(std::floor(x - half)));
+    const int y0 = std::max(0, static_cast<int>(std::floor(y - half)));
+    const int x1 = std::min(width, static_cast<int>(std::floor(x + half)));
+    const int y1 = std::min(height, static_cast<int>(std::floor(y + half)));
+    for (int py = y0; py < y1 && x0 < x1; ++py) {
+      std::fill_n(image.pixels.data() + static_cast<size_t>(py) * width + x0,
+                  x1 - x0, style.point_color);
+    }
+  }
+}
+
+}  // namespace s21
@@ -0,0 +1,146 @@
+#ifndef RENDER_RASTERIZER_H
+#define RENDER_RASTERIZER_H
+
+/**
+ * @file rasterizer.h
+ * @brief Программный растеризатор каркаса
+ */
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "camera.h"
+#include "image.h"
+#include "render_mesh.h"
+
+namespace s21 {
+
+/**
+ * @brief Что рисовать
+ */
+enum render_style_t {
+  kStyleLines = 1,   ///< Рёбра
+  kStylePoints = 2,  ///< Вершины
+  kStyleBoth = 3     ///< Рёбра и вершины
+};
+
+/**
+ * @brief Оформление кадра
+ *
+ * Значения по умолчанию совпадают с окном просмотра: белые линии на
+ * тёмно-сером фоне.
+ */
+struct RenderStyle {
+  render_style_t style = kStyleLines;                   ///< Что рисовать
+  uint32_t line_color = MakeColor(255, 255, 255);       ///< Цвет рёбер
+  uint32_t point_color = MakeColor(255, 255, 255);      ///< Цвет вершин
+  uint32_t background = MakeColor(26, 26, 26);          ///< Цвет фона
+  int point_size = 3;  ///< Сторона квадрата вершины, пикселей
+  bool antialias = true;  ///< Сглаживание рёбер (иначе - по пикселю)
+};
+
+/**
+ * @brief Многопоточный растеризатор каркаса без OpenGL
+ *
+ * Кадр строится в три прохода, каждый раскладывается по потокам
+ * ParallelFor:
+ * 1. Проекция: вершины переводятся в координаты отсечения циклом без
+ *    ветвлений по массивам-столбцам (x, y, z, w), который компилятор
+ *    векторизует.
+ * 2. Разбиение: рёбра отсекаются по ближней и дальней плоскостям и
+ *    границам кадра, переводятся в пиксели и раскладываются по плиткам
+ *    kTileSize x kTileSize, которые задевают.
+ * 3. Растеризация: каждая плитка рисует свои рёбра сглаженными линиями
+ *    (алгоритм Ву) с тестом глубины (GL_LEQUAL). Плитка пишет только
+ *    свои пиксели, поэтому потоки не синхронизируются, а результат не
+ *    зависит от их числа.
+ *
+ * Экземпляр хранит буферы между кадрами и не потокобезопасен: одному
+ * вызывающему потоку - один растеризатор, как один контекст OpenGL.
+ *
+ * @example
+ * @code
+ * Rasterizer rasterizer(DefaultThreadCount());
+ * Image image;
+ * rasterizer.Render(render_mesh, camera, RenderStyle(), 512, 512, image);
+ * WritePng(image, "model.png");
+ * @endcode
+ */
+class Rasterizer {
+ public:
+  static constexpr int kTileSize = 64;  ///< Сторона плитки, пикселей
+
+  /**
+   * @brief Создаёт растеризатор
+   * @param threads Потоков на кадр (1 - в вызывающем потоке)
+   */
+  explicit Rasterizer(unsigned threads = 1) noexcept : threads_(threads) {}
+
+  /**
+   * @brief Устанавливает число потоков на кадр
+   */
+  void SetThreadCount(unsigned threads) noexcept { threads_ = threads; }
+
+  /**
+   * @brief Рисует модель в изображение width x height
+   *
+   * @return Количество нарисованных (не отсечённых) рёбер
+   */
+  size_t Render(const RenderMesh& mesh, const Camera& camera,
+                const RenderStyle& style, int width, int height,
+                Image& image);
+
+ private:
+  /**
+   * @brief Ребро в пикселях; z - глубина NDC в [-1, 1]
+   */
+  struct ScreenEdge {
+    float x0, y0, z0, x1, y1, z1;
+  };
+
+  /**
+   * @brief Переводит вершины в координаты отсечения (столбцы clip_*)
+   */
+  void ProjectVertices_(const RenderMesh& mesh, const Matrix4& matrix);
+
+  /**
+   * @brief Отсекает рёбра и раскладывает их по плиткам
+   * @return Количество видимых рёбер
+   */
+  size_t BinEdges_(const RenderMesh& mesh, int width, int height);
+
+  /**
+   * @brief Очищает плитку и рисует её рёбра
+   */
+  void RasterizeTile_(size_t tile, const RenderStyle& style, Image& image);
+
+  /**
+   * @brief Рисует вершины квадратами (поверх рёбер, без теста глубины)
+   */
+  void DrawPoints_(const RenderStyle& style, Image& image) const;
+
+  unsigned threads_;  ///< Потоков на кадр
+  int tiles_x_ = 0;   ///< Плиток по горизонтали
+  int tiles_y_ = 0;   ///< Плиток по вертикали
+
+  std::vector<float> clip_x_, clip_y_, clip_z_, clip_w_;  ///< Проекция
+  std::vector<ScreenEdge> screen_;  ///< Рёбра в пикселях (по индексу)
+  std::vector<float> depth_;        ///< Буфер глубины кадра
+
+  /// Пары (плитка, ребро) от каждого куска рёбер при разбиении
+  std::vector<std::vector<std::pair<uint32_t, uint32_t>>> chunk_bins_;
+  std::vector<uint32_t> bin_offset_;  ///< Начало списка плитки в bin_edges_
+  std::vector<uint32_t> bin_edges_;   ///< Рёбра плиток подряд
+};
+
+/**
+ * @brief Рисует отрезок в пикселях с отсечением по границам кадра
+ * @return false если отрезок целиком вне кадра
+ */
+bool DrawLine(Image& image, double x0, double y0, double x1, double y1,
+              uint32_t color);
+
+}  // namespace s21
+
+#endif  // RENDER_RASTERIZER_H
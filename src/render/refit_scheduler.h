@@ -0,0 +1,194 @@
+#ifndef RENDER_REFIT_SCHEDULER_H
+#define RENDER_REFIT_SCHEDULER_H
+
+/**
+ * @file refit_scheduler.h
+ * @brief Фоновое обновление иерархий выбора и сечения без Qt
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "../model/worker_queue.h"
+
+namespace s21 {
+
+/**
+ * @brief Планировщик фонового Build и Refit иерархии (Picker, Slicer)
+ *
+ * Логика вида, вынесенная из OpenGLWidget: трансформация только
+ * отмечает иерархию устаревшей (Invalidate), а обновление запускает
+ * вызывающий, когда иерархия нужна. В фоне выполняется не больше одной
+ * задачи; изменения, пришедшие во время неё, объединяются в следующую.
+ *
+ * Координаты передаются в Refit через двойной буфер: вызывающий поток
+ * заполняет свободную половину, задача меняет её местами с координатами
+ * иерархии, и прежние координаты становятся свободной половиной. Задача
+ * захватывает только this, поэтому после прогрева StartRefit не
+ * выделяет память. Build (смена топологии) копирует данные как обычно.
+ *
+ * Все методы, кроме notify, вызываются в одном (GUI) потоке. Пока
+ * задача выполняется, иерархия недоступна.
+ *
+ * @tparam Hierarchy Тип с конструктором от числа потоков и методом
+ *         std::vector<float> Refit(std::vector<float>)
+ *
+ * @example
+ * @code
+ * RefitScheduler<Picker> picker(worker, threads, &Notify, this);
+ * picker.Invalidate(false);  // трансформация
+ * if (picker.NeedsUpdate() && !picker.NeedsBuild()) {
+ *   picker.StartRefit(coords, count);
+ * }
+ * // ... после notify, в GUI-потоке:
+ * picker.Finish();
+ * if (const Picker* ready = picker.Get()) ready->Pick(...);
+ * @endcode
+ */
+template <typename Hierarchy>
+class RefitScheduler {
+ public:
+  /// Вызывается в фоновом потоке после каждой задачи
+  using Notify = void (*)(void* context);
+
+  /**
+   * @brief Создаёт планировщик
+   * @param worker Очередь, в которой выполняются задачи
+   * @param threads Число потоков построения иерархии
+   * @param notify Сообщает о завершении задачи (из фонового потока)
+   * @param context Аргумент notify
+   */
+  RefitScheduler(WorkerQueue& worker, unsigned threads, Notify notify,
+                 void* context) noexcept
+      : worker_(worker), threads_(threads), notify_(notify),
+        context_(context) {}
+
+  /**
+   * @brief Дожидается задачи, которая обращается к планировщику
+   */
+  ~RefitScheduler() { worker_.WaitIdle(); }
+
+  RefitScheduler(const RefitScheduler&) = delete;
+  RefitScheduler& operator=(const RefitScheduler&) = delete;
+
+  /**
+   * @brief Отмечает иерархию устаревшей
+   * @param rebuild true - сменилась топология, иначе достаточно Refit
+   */
+  void Invalidate(bool rebuild) noexcept {
+    dirty_ = true;
+    rebuild_ = rebuild_ || rebuild;
+  }
+
+  /**
+   * @brief Проверяет, что обновление нужно и его можно запустить
+   */
+  bool NeedsUpdate() const noexcept { return dirty_ && !busy_; }
+
+  /**
+   * @brief Проверяет, что вместо Refit нужен Build
+   */
+  bool NeedsBuild() const noexcept { return rebuild_ || !hierarchy_; }
+
+  /**
+   * @brief Проверяет, идёт ли задача в фоне
+   */
+  bool IsBusy() const noexcept { return busy_; }
+
+  /**
+   * @brief Возвращает актуальную иерархию
+   * @return nullptr, если иерархия строится, устарела или её нет
+   */
+  const Hierarchy* Get() const noexcept {
+    return busy_ || dirty_ || !built_ ? nullptr : hierarchy_.get();
+  }
+
+  /**
+   * @brief Запускает Refit по координатам вида
+   *
+   * @pre NeedsUpdate() и !NeedsBuild()
+   * @param coord Координаты x, y, z подряд
+   * @param count Число значений в coord
+   * @return false если задача уже идёт или очередь её не приняла
+   *         (иерархия остаётся устаревшей)
+   */
+  bool StartRefit(const double* coord, size_t count) {
+    if (busy_) return false;
+    spare_.resize(count);
+    std::copy(coord, coord + count, spare_.begin());
+    return Post_([this] { spare_ = hierarchy_->Refit(std::move(spare_)); });
+  }
+
+  /**
+   * @brief Запускает построение новой иерархии
+   *
+   * @pre NeedsUpdate()
+   * @param build Строит иерархию по собственным копиям данных
+   * @return false если задача уже идёт или очередь её не приняла
+   */
+  bool StartBuild(std::function<void(Hierarchy&)> build) {
+    if (busy_) return false;
+    hierarchy_ = std::make_unique<Hierarchy>(threads_);
+    built_ = false;
+    rebuild_ = false;
+    if (Post_([this, build = std::move(build)] { build(*hierarchy_); })) {
+      return true;
+    }
+    rebuild_ = true;
+    return false;
+  }
+
+  /**
+   * @brief Принимает результат задачи (после notify, в GUI-потоке)
+   */
+  void Finish() noexcept {
+    busy_ = false;
+    built_ = true;
+  }
+
+  /**
+   * @brief Освобождает иерархию, если задача не идёт
+   *
+   * Следующее обновление выполнит Build.
+   */
+  void Release() noexcept {
+    if (busy_) return;
+    hierarchy_.reset();
+    built_ = false;
+    dirty_ = true;
+  }
+
+ private:
+  /**
+   * @brief Ставит задачу в очередь и отмечает иерархию занятой
+   */
+  template <typename Task>
+  bool Post_(Task task) {
+    dirty_ = false;
+    busy_ = worker_.Post([this, task = std::move(task)]() mutable {
+      task();
+      notify_(context_);
+    });
+    if (!busy_) dirty_ = true;
+    return busy_;
+  }
+
+  WorkerQueue& worker_;                   ///< Очередь фоновых задач
+  unsigned threads_;                      ///< Потоки построения
+  Notify notify_;                         ///< Сообщение о завершении
+  void* context_;                         ///< Аргумент notify_
+  std::unique_ptr<Hierarchy> hierarchy_;  ///< Иерархия (нет - не строилась)
+  std::vector<float> spare_;              ///< Свободная половина координат
+  bool built_ = false;    ///< hierarchy_ построена хотя бы раз
+  bool busy_ = false;     ///< Задача выполняется
+  bool dirty_ = false;    ///< Данные изменились после последней задачи
+  bool rebuild_ = false;  ///< Нужен Build
+};
+
+}  // namespace s21
+
+#endif  // RENDER_REFIT_SCHEDULER_H
@@ -0,0 +1,42 @@
+/**
+ * @file render_mesh.cpp
+ * @brief Подготовка буферов рендера
+ */
+
+#include "render_mesh.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "../profiling/trace.h"
+
+namespace s21 {
+
+RenderMesh BuildRenderMesh(const Mesh& mesh) {
+  S21_TRACE_SCOPE("BuildRenderMesh");
+
+  RenderMesh result;
+  result.position.assign(mesh.vertex_coord.begin(), mesh.vertex_coord.end());
+
+  const uint32_t vertex_count = static_cast<uint32_t>(mesh.GetVertexCount());
+  std::vector<uint64_t> keys;
+  keys.reserve(mesh.GetEdgeCount());
+  for (size_t i = 0; i + 1 < mesh.vertex_index.size(); i += 2) {
+    uint32_t a = static_cast<uint32_t>(mesh.vertex_index[i]);
+    uint32_t b = static_cast<uint32_t>(mesh.vertex_index[i + 1]);
+    if (a == b || a >= vertex_count || b >= vertex_count) continue;
+    if (a > b) std::swap(a, b);
+    keys.push_back(static_cast<uint64_t>(a) << 32 | b);
+  }
+  std::sort(keys.begin(), keys.end());
+  keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+  result.edges.reserve(keys.size() * 2);
+  for (uint64_t key : keys) {
+    result.edges.push_back(static_cast<uint32_t>(key >> 32));
+    result.edges.push_back(static_cast<uint32_t>(key));
+  }
+  return result;
+}
+
+}  // namespace s21
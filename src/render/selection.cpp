@@ -0,0 +1,166 @@
+/**
+ * @file selection.cpp
+ * @brief Реализация области выделения и битового множества
+ */
+
+#include "selection.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "../profiling/trace.h"
+
+namespace s21 {
+
+ScreenRegion ScreenRegion::Rect(double x0, double y0, double x1, double y1) {
+  ScreenRegion region;
+  region.min_x_ = std::min(x0, x1);
+  region.max_x_ = std::max(x0, x1);
+  region.min_y_ = std::min(y0, y1);
+  region.max_y_ = std::max(y0, y1);
+  return region;
+}
+
+ScreenRegion ScreenRegion::Lasso(const std::vector<double>& points,
+                                 int width, int height) {
+  S21_TRACE_SCOPE("ScreenRegion::Lasso");
+  ScreenRegion region;
+  const size_t count = points.size() / 2;
+  if (count < 3 || width <= 0 || height <= 0) return region;
+  region.lasso_ = true;
+  region.width_ = width;
+  region.height_ = height;
+  region.min_x_ = region.min_y_ = INFINITY;
+  region.max_x_ = region.max_y_ = -INFINITY;
+  for (size_t i = 0; i < count; ++i) {
+    region.min_x_ = std::min(region.min_x_, points[i * 2]);
+    region.max_x_ = std::max(region.max_x_, points[i * 2]);
+    region.min_y_ = std::min(region.min_y_, points[i * 2 + 1]);
+    region.max_y_ = std::max(region.max_y_, points[i * 2 + 1]);
+  }
+
+  // Строка маски: пересечения контура с горизонталью через центры
+  // пикселей, между чётным и нечётным пересечением - внутри
+  const size_t stride = static_cast<size_t>(width) + 1;
+  region.sums_.assign(stride * (height + 1), 0);
+  region.mask_stride_ = (static_cast<size_t>(width) + 63) / 64;
+  region.mask_.assign(region.mask_stride_ * height, 0);
+  std::vector<double> crossings;
+  std::vector<uint8_t> row(width);
+  for (int y = 0; y < height; ++y) {
+    const double center = y + 0.5;
+    crossings.clear();
+    for (size_t i = 0; i < count; ++i) {
+      const double ax = points[i * 2], ay = points[i * 2 + 1];
+      const size_t j = (i + 1) % count;
+      const double bx = points[j * 2], by = points[j * 2 + 1];
+      if ((ay <= center) != (by <= center)) {
+        crossings.push_back(ax + (center - ay) * (bx - ax) / (by - ay));
+      }
+    }
+    std::sort(crossings.begin(), crossings.end());
+    std::fill(row.begin(), row.end(), 0);
+    for (size_t k = 0; k + 1 < crossings.size(); k += 2) {
+      // Пиксели с центром в [left, right)
+      const double left = std::ceil(crossings[k] - 0.5);
+      const double right = std::ceil(crossings[k + 1] - 0.5);
+      const int from = static_cast<int>(std::clamp(left, 0.0, double(width)));
+      const int to = static_cast<int>(std::clamp(right, 0.0, double(width)));
+      std::fill(row.begin() + from, row.begin() + std::max(from, to), 1);
+    }
+    uint32_t* above = &region.sums_[y * stride];
+    uint32_t* current = above + stride;
+    uint64_t* bits = &region.mask_[y * region.mask_stride_];
+    uint32_t line = 0;
+    for (int x = 0; x < width; ++x) {
+      line += row[x];
+      current[x + 1] = above[x + 1] + line;
+      bits[x >> 6] |= uint64_t{row[x]} << (x & 63);
+    }
+  }
+  return region;
+}
+
+uint32_t ScreenRegion::Sum_(int px0, int py0, int px1,
+                            int py1) const noexcept {
+  const size_t stride = static_cast<size_t>(width_) + 1;
+  return sums_[py1 * stride + px1] - sums_[py0 * stride + px1] -
+         sums_[py1 * stride + px0] + sums_[py0 * stride + px0];
+}
+
+bool ScreenRegion::IsEmpty() const noexcept {
+  if (lasso_) return sums_.back() == 0;
+  return !(min_x_ < max_x_ && min_y_ < max_y_);
+}
+
+bvh_overlap_t ScreenRegion::Classify(double x0, double y0, double x1,
+                                     double y1) const noexcept {
+  if (!lasso_) {
+    if (x1 < min_x_ || x0 >= max_x_ || y1 < min_y_ || y0 >= max_y_) {
+      return kBvhOutside;
+    }
+    return x0 >= min_x_ && x1 < max_x_ && y0 >= min_y_ && y1 < max_y_
+               ? kBvhInside
+               : kBvhPartial;
+  }
+  // Пиксели, в которые могут попасть точки прямоугольника
+  if (!(x0 <= x1 && y0 <= y1)) return kBvhOutside;
+  const double px0 = std::floor(x0), py0 = std::floor(y0);
+  const double px1 = std::floor(x1) + 1.0, py1 = std::floor(y1) + 1.0;
+  const int cx0 = static_cast<int>(std::clamp(px0, 0.0, double(width_)));
+  const int cy0 = static_cast<int>(std::clamp(py0, 0.0, double(height_)));
+  const int cx1 = static_cast<int>(std::clamp(px1, 0.0, double(width_)));
+  const int cy1 = static_cast<int>(std::clamp(py1, 0.0, double(height_)));
+  if (cx0 >= cx1 || cy0 >= cy1) return kBvhOutside;
+  const uint32_t inside = Sum_(cx0, cy0, cx1, cy1);
+  if (inside == 0) return kBvhOutside;
+  const bool clipped = px0 < 0.0 || py0 < 0.0 || px1 > width_ ||
+                       py1 > height_;
+  const uint64_t area = uint64_t(cx1 - cx0) * uint64_t(cy1 - cy0);
+  return !clipped && inside == area ? kBvhInside : kBvhPartial;
+}
+
+void SelectionBits::Reset(size_t size) {
+  size_ = size;
+  words_.assign((size + 63) / 64, 0);
+}
+
+void SelectionBits::SetRange(size_t begin, size_t end) noexcept {
+  if (begin >= end) return;
+  const size_t first = begin >> 6, last = (end - 1) >> 6;
+  const uint64_t head = ~uint64_t{0} << (begin & 63);
+  const uint64_t tail = ~uint64_t{0} >> (63 - ((end - 1) & 63));
+  if (first == last) {
+    words_[first] |= head & tail;
+    return;
+  }
+  words_[first] |= head;
+  std::fill(words_.begin() + first + 1, words_.begin() + last, ~uint64_t{0});
+  words_[last] |= tail;
+}
+
+size_t SelectionBits::Count() const noexcept {
+  size_t count = 0;
+  for (uint64_t word : words_) count += __builtin_popcountll(word);
+  return count;
+}
+
+void SelectionBits::Combine(const SelectionBits& other,
+                            select_mode_t mode) noexcept {
+  const size_t count = std::min(words_.size(), other.words_.size());
+  for (size_t i = 0; i < count; ++i) {
+    switch (mode) {
+      case kSelectReplace:
+        words_[i] = other.words_[i];
+        break;
+      case kSelectAdd:
+        words_[i] |= other.words_[i];
+        break;
+      case kSelectSubtract:
+        words_[i] &= ~other.words_[i];
+        break;
+    }
+  }
+}
+
+}  // namespace s21
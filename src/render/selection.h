@@ -0,0 +1,167 @@
+#ifndef RENDER_SELECTION_H
+#define RENDER_SELECTION_H
+
+/**
+ * @file selection.h
+ * @brief Область выделения на экране и битовое множество выделенного
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../model/bvh.h"
+
+namespace s21 {
+
+/**
+ * @brief Как новое выделение сочетается с прежним
+ */
+enum select_mode_t {
+  kSelectReplace = 0,  ///< Заменить
+  kSelectAdd = 1,      ///< Добавить
+  kSelectSubtract = 2  ///< Вычесть
+};
+
+/**
+ * @brief Прямоугольник или лассо в пикселях кадра (y вниз)
+ *
+ * Прямоугольник проверяется аналитически. Лассо заливается по правилу
+ * чёт-нечет в маску пикселей кадра (пиксель внутри, если внутри его
+ * центр), по маске строится таблица сумм, поэтому прямоугольник узла
+ * иерархии классифицируется за O(1) независимо от числа точек лассо.
+ * Точки проверяются по битовой маске: она в 32 раза меньше таблицы
+ * сумм и остаётся в кэше.
+ *
+ * @example
+ * @code
+ * ScreenRegion lasso = ScreenRegion::Lasso(points, width(), height());
+ * if (lasso.Classify(x0, y0, x1, y1) == kBvhInside) AcceptNode();
+ * @endcode
+ */
+class ScreenRegion {
+ public:
+  ScreenRegion() = default;
+
+  /**
+   * @brief Прямоугольник между двумя углами в любом порядке
+   */
+  static ScreenRegion Rect(double x0, double y0, double x1, double y1);
+
+  /**
+   * @brief Многоугольник, ограниченный кадром width x height
+   *
+   * @param points Вершины x, y подряд; контур замыкается автоматически
+   */
+  static ScreenRegion Lasso(const std::vector<double>& points, int width,
+                            int height);
+
+  /**
+   * @brief Проверяет точку
+   */
+  bool Contains(double x, double y) const noexcept;
+
+  /**
+   * @brief Положение прямоугольника [x0, x1] x [y0, y1] относительно
+   * области
+   */
+  bvh_overlap_t Classify(double x0, double y0, double x1,
+                         double y1) const noexcept;
+
+  /**
+   * @brief Пустая область: ни одна точка в неё не попадает
+   */
+  bool IsEmpty() const noexcept;
+
+ private:
+  /**
+   * @brief Число пикселей маски в [px0, px1) x [py0, py1)
+   */
+  uint32_t Sum_(int px0, int py0, int px1, int py1) const noexcept;
+
+  bool lasso_ = false;
+  double min_x_ = 0.0, min_y_ = 0.0;  ///< Прямоугольник или box лассо
+  double max_x_ = 0.0, max_y_ = 0.0;
+  int width_ = 0;                     ///< Размер маски лассо
+  int height_ = 0;
+  size_t mask_stride_ = 0;            ///< Слов маски на строку
+  std::vector<uint64_t> mask_;  ///< Бит на пиксель лассо, для точек
+  std::vector<uint32_t> sums_;  ///< Таблица сумм (width_ + 1) x (height_ + 1)
+};
+
+inline bool ScreenRegion::Contains(double x, double y) const noexcept {
+  if (!lasso_) return x >= min_x_ && x < max_x_ && y >= min_y_ && y < max_y_;
+  // Лассо проверяется только по маске: так же, как в Classify
+  if (!(x >= 0.0 && y >= 0.0 && x < width_ && y < height_)) return false;
+  const size_t px = static_cast<size_t>(x), py = static_cast<size_t>(y);
+  return mask_[py * mask_stride_ + (px >> 6)] >> (px & 63) & 1;
+}
+
+/**
+ * @brief Компактное битовое множество выделенных элементов
+ *
+ * Бит на элемент; диапазоны заполняются целыми словами, поэтому
+ * узел иерархии, принятый целиком, выделяется за время, пропорциональное
+ * числу слов.
+ */
+class SelectionBits {
+ public:
+  /**
+   * @brief Задаёт размер и очищает множество
+   */
+  void Reset(size_t size);
+
+  size_t GetSize() const noexcept { return size_; }
+
+  bool Test(size_t index) const noexcept {
+    return words_[index >> 6] >> (index & 63) & 1;
+  }
+
+  void Set(size_t index) noexcept {
+    words_[index >> 6] |= uint64_t{1} << (index & 63);
+  }
+
+  /**
+   * @brief Выделяет [begin, end)
+   */
+  void SetRange(size_t begin, size_t end) noexcept;
+
+  /**
+   * @brief Число выделенных элементов
+   */
+  size_t Count() const noexcept;
+
+  /**
+   * @brief Сочетает с other того же размера
+   */
+  void Combine(const SelectionBits& other, select_mode_t mode) noexcept;
+
+  /**
+   * @brief Вызывает fn(index) для выделенных элементов по возрастанию
+   */
+  template <typename Fn>
+  void ForEach(Fn&& fn) const;
+
+  /**
+   * @brief Слово с битами [word * 64, word * 64 + 64)
+   */
+  uint64_t GetWord(size_t word) const noexcept { return words_[word]; }
+  size_t GetWordCount() const noexcept { return words_.size(); }
+
+ private:
+  size_t size_ = 0;
+  std::vector<uint64_t> words_;
+};
+
+template <typename Fn>
+void SelectionBits::ForEach(Fn&& fn) const {
+  for (size_t word = 0; word < words_.size(); ++word) {
+    for (uint64_t bits = words_[word]; bits != 0; bits &= bits - 1) {
+      fn(word * 64 + static_cast<size_t>(__builtin_ctzll(bits)));
+    }
+  }
+}
+
+}  // namespace s21
+
+#endif  // RENDER_SELECTION_H
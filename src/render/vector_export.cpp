@@ -0,0 +1,749 @@
+/**
+ * @file vector_export.cpp
+ * @brief Реализация векторного чертежа каркаса
+ */
+
+#include "vector_export.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+#include "../model/parallel.h"
+#include "../profiling/trace.h"
+#include "render_mesh.h"
+
+namespace s21 {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t kProjectChunk = size_t{1} << 15;  ///< Вершин на задачу
+constexpr size_t kEdgesPerChunk = size_t{1} << 14;  ///< Рёбер на задачу
+constexpr size_t kTrianglesPerChunk = size_t{1} << 14;  ///< На задачу
+constexpr size_t kLinesPerChunk = size_t{1} << 16;  ///< Отрезков на блок
+constexpr size_t kCellsPerChunk = size_t{1} << 12;  ///< Ячеек на задачу
+constexpr double kTrianglesPerCell = 2.0;  ///< Целевая загрузка сетки
+constexpr double kMaxCells = 1 << 22;      ///< Наибольший размер сетки
+constexpr double kDepthEpsilon = 1e-6;     ///< Допуск глубины NDC
+constexpr double kInset = 1e-3;  ///< Сжатие треугольника, пикселей
+constexpr double kMinPiece = 1e-2;  ///< Короче - не рисуется, пикселей
+constexpr double kMergeTolerance = 1e-2;  ///< Допуск склейки, пикселей
+constexpr double kAngleQuantum = 1e-5;    ///< Шаг направления, радиан
+constexpr size_t kMergeBuckets = 64;  ///< Не зависит от числа потоков
+
+double ElapsedMs(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+      .count();
+}
+
+/**
+ * @brief Сужает [t0, t1] до части, где d0 + (d1 - d0) t >= 0
+ * @return false если такой части нет
+ */
+inline bool ClipParameter(double d0, double d1, double& t0, double& t1) {
+  if (d0 < 0.0 && d1 < 0.0) return false;
+  if (d0 < 0.0) t0 = std::max(t0, d0 / (d0 - d1));
+  if (d1 < 0.0) t1 = std::min(t1, d0 / (d0 - d1));
+  return t0 <= t1;
+}
+
+/**
+ * @brief Ближайшее к value снизу число float
+ */
+inline float FloorFloat(double value) {
+  const float rounded = static_cast<float>(value);
+  return rounded > value ? std::nextafter(rounded, -INFINITY) : rounded;
+}
+
+/**
+ * @brief Проверяет, закрывают ли интервалы весь отрезок [0, 1]
+ *
+ * Просветы короче gap не считаются: такие куски не рисуются.
+ * Упорядочивает hidden, что не мешает дальнейшему сбору.
+ */
+bool Covered(std::vector<std::pair<double, double>>& hidden, double gap) {
+  std::sort(hidden.begin(), hidden.end());
+  double cursor = 0.0;
+  for (const auto& interval : hidden) {
+    if (interval.first - cursor >= gap) return false;
+    cursor = std::max(cursor, interval.second);
+  }
+  return 1.0 - cursor < gap;
+}
+
+/**
+ * @brief Дописывает число, заданное в сотых, без лишних нулей
+ */
+void AppendHundredths(std::string& out, long long value) {
+  if (value < 0) {
+    out.push_back('-');
+    value = -value;
+  }
+  char digits[24];
+  const auto end =
+      std::to_chars(digits, digits + sizeof(digits), value / 100).ptr;
+  out.append(digits, end);
+  const int fraction = static_cast<int>(value % 100);
+  if (fraction != 0) {
+    out.push_back('.');
+    out.push_back(static_cast<char>('0' + fraction / 10));
+    if (fraction % 10 != 0) {
+      out.push_back(static_cast<char>('0' + fraction % 10));
+    }
+  }
+}
+
+inline long long ToHundredths(double value) {
+  return std::llround(value * 100.0);
+}
+
+/**
+ * @brief Цвет в виде #rrggbb
+ */
+std::string HexColor(uint32_t color) {
+  char text[8];
+  std::snprintf(text, sizeof(text), "#%02x%02x%02x", color & 0xFF,
+                color >> 8 & 0xFF, color >> 16 & 0xFF);
+  return text;
+}
+
+/**
+ * @brief Цвет в виде компонент PDF "r g b"
+ */
+std::string PdfColor(uint32_t color) {
+  char text[32];
+  std::snprintf(text, sizeof(text), "%.3f %.3f %.3f",
+                (color & 0xFF) / 255.0, (color >> 8 & 0xFF) / 255.0,
+                (color >> 16 & 0xFF) / 255.0);
+  return text;
+}
+
+/**
+ * @brief Кусок отрезка на прямой для склейки
+ */
+struct LinePiece {
+  uint64_t key;      ///< Направление и смещение прямой
+  double t0, t1;     ///< Проекции концов на направление
+  Segment2D segment;  ///< Отрезок от t0 к t1
+};
+
+/**
+ * @brief Приводит отрезок к виду для склейки
+ * @return false для вырожденного отрезка
+ */
+bool MakePiece(const Segment2D& segment, LinePiece& piece) {
+  Segment2D s = segment;
+  double dx = s.x1 - s.x0, dy = s.y1 - s.y0;
+  if (dx < 0.0 || (dx == 0.0 && dy < 0.0)) {
+    std::swap(s.x0, s.x1);
+    std::swap(s.y0, s.y1);
+    dx = -dx;
+    dy = -dy;
+  }
+  const double length = std::hypot(dx, dy);
+  if (length == 0.0) return false;
+  const double ux = dx / length, uy = dy / length;
+  const long long angle = std::llround(std::atan2(uy, ux) / kAngleQuantum);
+  const long long offset =
+      std::llround((ux * s.y0 - uy * s.x0) / kMergeTolerance);
+  piece.key = static_cast<uint64_t>(angle + (1 << 20)) << 32 |
+              static_cast<uint32_t>(offset + (1ll << 31));
+  piece.t0 = ux * s.x0 + uy * s.y0;
+  piece.t1 = piece.t0 + length;
+  piece.segment = s;
+  return true;
+}
+
+/**
+ * @brief Склеивает перекрывающиеся куски одной прямой
+ */
+std::vector<Segment2D> MergeCollinear(const std::vector<Segment2D>& segments,
+                                      unsigned threads) {
+  std::vector<std::vector<LinePiece>> buckets(kMergeBuckets);
+  for (const Segment2D& segment : segments) {
+    LinePiece piece;
+    if (MakePiece(segment, piece)) {
+      buckets[(piece.key * 0x9E3779B97F4A7C15ull) >> 58].push_back(piece);
+    }
+  }
+
+  std::vector<std::vector<Segment2D>> merged(kMergeBuckets);
+  ParallelFor(kMergeBuckets, threads, [&](unsigned, size_t index) {
+    std::vector<LinePiece>& pieces = buckets[index];
+    std::sort(pieces.begin(), pieces.end(),
+              [](const LinePiece& a, const LinePiece& b) {
+                if (a.key != b.key) return a.key < b.key;
+                if (a.t0 != b.t0) return a.t0 < b.t0;
+                return a.t1 < b.t1;
+              });
+    for (size_t i = 0; i < pieces.size();) {
+      LinePiece line = pieces[i++];
+      while (i < pieces.size() && pieces[i].key == line.key &&
+             pieces[i].t0 <= line.t1 + kMergeTolerance) {
+        if (pieces[i].t1 > line.t1) {
+          line.t1 = pieces[i].t1;
+          line.segment.x1 = pieces[i].segment.x1;
+          line.segment.y1 = pieces[i].segment.y1;
+        }
+        ++i;
+      }
+      merged[index].push_back(line.segment);
+    }
+  });
+
+  std::vector<Segment2D> result;
+  for (const auto& part : merged) {
+    result.insert(result.end(), part.begin(), part.end());
+  }
+  return result;
+}
+
+}  // namespace
+
+std::vector<Segment2D> VectorExporter::Build(const Mesh& mesh,
+                                             const Camera& camera, int width,
+                                             int height,
+                                             const VectorStyle& style,
+                                             VectorStats* stats) {
+  S21_TRACE_SCOPE("VectorExporter::Build");
+  VectorStats local;
+  if (width <= 0 || height <= 0) {
+    if (stats) *stats = local;
+    return {};
+  }
+
+  Clock::time_point start = Clock::now();
+  const RenderMesh render = BuildRenderMesh(mesh);
+  Project_(mesh, camera.BuildMatrix(width, height), width, height);
+  if (style.hidden_line_removal) {
+    BinTriangles_(mesh, width, height);
+  } else {
+    triangles_.clear();
+  }
+  local.edges = render.GetEdgeCount();
+  local.triangles = triangles_.size() / 3;
+  local.project_ms = ElapsedMs(start);
+
+  start = Clock::now();
+  const size_t edge_count = render.GetEdgeCount();
+  const size_t vertex_count = clip_w_.size();
+  const size_t chunks = (edge_count + kEdgesPerChunk - 1) / kEdgesPerChunk;
+  const bool occlusion = !triangles_.empty();
+  std::vector<std::vector<Segment2D>> pieces(chunks);
+  std::vector<std::vector<std::pair<double, double>>> scratch(
+      std::max(threads_, 1u));
+
+  ParallelFor(chunks, threads_, [&](unsigned worker, size_t chunk) {
+    std::vector<Segment2D>& out = pieces[chunk];
+    const size_t end = std::min(edge_count, (chunk + 1) * kEdgesPerChunk);
+    for (size_t edge = chunk * kEdgesPerChunk; edge < end; ++edge) {
+      const uint32_t a = render.edges[edge * 2];
+      const uint32_t b = render.edges[edge * 2 + 1];
+      if (a >= vertex_count || b >= vertex_count) continue;
+
+      // Отсечение по плоскостям w >= near, -w <= z <= w, как в Rasterizer
+      const double near = Camera::kNearPlane;
+      double t0 = 0.0, t1 = 1.0;
+      if (!ClipParameter(clip_w_[a] - near, clip_w_[b] - near, t0, t1) ||
+          !ClipParameter(clip_w_[a] + clip_z_[a], clip_w_[b] + clip_z_[b], t0,
+                         t1) ||
+          !ClipParameter(clip_w_[a] - clip_z_[a], clip_w_[b] - clip_z_[b], t0,
+                         t1)) {
+        continue;
+      }
+      double point[2][3];
+      for (int end_index = 0; end_index < 2; ++end_index) {
+        const double t = end_index ? t1 : t0;
+        const double w = clip_w_[a] + (clip_w_[b] - clip_w_[a]) * t;
+        point[end_index][0] =
+            ((clip_x_[a] + (clip_x_[b] - clip_x_[a]) * t) / w + 1.0) * width *
+            0.5;
+        point[end_index][1] =
+            (1.0 - (clip_y_[a] + (clip_y_[b] - clip_y_[a]) * t) / w) *
+            height * 0.5;
+        point[end_index][2] = (clip_z_[a] + (clip_z_[b] - clip_z_[a]) * t) / w;
+      }
+
+      // Отсечение по кадру; глубина NDC линейна в экранных координатах
+      double s0 = 0.0, s1 = 1.0;
+      const double dx = point[1][0] - point[0][0];
+      const double dy = point[1][1] - point[0][1];
+      const double dz = point[1][2] - point[0][2];
+      if (!std::isfinite(dx) || !std::isfinite(dy) ||
+          !ClipParameter(point[0][0], point[1][0], s0, s1) ||
+          !ClipParameter(width - point[0][0], width - point[1][0], s0, s1) ||
+          !ClipParameter(point[0][1], point[1][1], s0, s1) ||
+          !ClipParameter(height - point[0][1], height - point[1][1], s0,
+                         s1)) {
+        continue;
+      }
+      const double from[3] = {point[0][0] + dx * s0, point[0][1] + dy * s0,
+                              point[0][2] + dz * s0};
+      const double to[3] = {point[0][0] + dx * s1, point[0][1] + dy * s1,
+                            point[0][2] + dz * s1};
+      const double length =
+          std::sqrt((to[0] - from[0]) * (to[0] - from[0]) +
+                    (to[1] - from[1]) * (to[1] - from[1]));
+
+      auto& hidden = scratch[worker];
+      hidden.clear();
+      if (occlusion) {
+        CollectHidden_(a, b, from, to, hidden);
+        std::sort(hidden.begin(), hidden.end());
+      }
+      // Видимые куски - дополнение закрытых интервалов
+      double cursor = 0.0;
+      auto emit = [&](double u0, double u1) {
+        if ((u1 - u0) * length < kMinPiece) return;
+        out.push_back({static_cast<float>(from[0] + (to[0] - from[0]) * u0),
+                       static_cast<float>(from[1] + (to[1] - from[1]) * u0),
+                       static_cast<float>(from[0] + (to[0] - from[0]) * u1),
+                       static_cast<float>(from[1] + (to[1] - from[1]) * u1)});
+      };
+      for (const auto& interval : hidden) {
+        if (interval.first > cursor) emit(cursor, interval.first);
+        cursor = std::max(cursor, interval.second);
+      }
+      if (cursor < 1.0) emit(cursor, 1.0);
+    }
+  });
+
+  std::vector<Segment2D> segments;
+  for (const auto& part : pieces) {
+    segments.insert(segments.end(), part.begin(), part.end());
+  }
+  local.segments = segments.size();
+  local.hidden_ms = ElapsedMs(start);
+
+  start = Clock::now();
+  if (style.merge_collinear) {
+    S21_TRACE_SCOPE("VectorExporter::MergeCollinear");
+    segments = MergeCollinear(segments, threads_);
+  }
+  local.lines = segments.size();
+  local.merge_ms = ElapsedMs(start);
+  if (stats) *stats = local;
+  return segments;
+}
+
+void VectorExporter::Project_(const Mesh& mesh, const Matrix4& matrix,
+                              int width, int height) {
+  S21_TRACE_SCOPE("VectorExporter::Project_");
+  const size_t count = mesh.GetVertexCount();
+  for (auto* column : {&clip_x_, &clip_y_, &clip_z_, &clip_w_}) {
+    column->resize(count);
+  }
+  screen_.resize(count * 3);
+
+  const double* m = matrix.data();
+  const size_t chunks = (count + kProjectChunk - 1) / kProjectChunk;
+  ParallelFor(chunks, threads_, [&](unsigned, size_t chunk) {
+    const size_t end = std::min(count, (chunk + 1) * kProjectChunk);
+    for (size_t i = chunk * kProjectChunk; i < end; ++i) {
+      const double x = mesh.vertex_coord[i * 3];
+      const double y = mesh.vertex_coord[i * 3 + 1];
+      const double z = mesh.vertex_coord[i * 3 + 2];
+      const double cx = m[0] * x + m[4] * y + m[8] * z + m[12];
+      const double cy = m[1] * x + m[5] * y + m[9] * z + m[13];
+      const double cz = m[2] * x + m[6] * y + m[10] * z + m[14];
+      const double cw = m[3] * x + m[7] * y + m[11] * z + m[15];
+      clip_x_[i] = cx;
+      clip_y_[i] = cy;
+      clip_z_[i] = cz;
+      clip_w_[i] = cw;
+      // Вершина вне диапазона глубины не может быть заслонкой
+      const bool inside = cw >= Camera::kNearPlane && cz >= -cw && cz <= cw;
+      double* point = &screen_[i * 3];
+      point[0] = inside ? (cx / cw + 1.0) * width * 0.5 : NAN;
+      point[1] = (1.0 - cy / cw) * height * 0.5;
+      point[2] = cz / cw;
+    }
+  });
+}
+
+void VectorExporter::BinTriangles_(const Mesh& mesh, int width,
+                                   int height) {
+  S21_TRACE_SCOPE("VectorExporter::BinTriangles_");
+  const size_t vertex_count = clip_w_.size();
+  auto usable = [&](int index) {
+    return index >= 0 && static_cast<size_t>(index) < vertex_count &&
+           std::isfinite(screen_[index * size_t{3}]);
+  };
+
+  // Грани разбиваются веером; вырожденные и закрытые плоскостями
+  // отсечения треугольники отбрасываются
+  triangles_.clear();
+  for (size_t face = 0; face < mesh.GetFaceCount(); ++face) {
+    const int begin = mesh.face_offset[face];
+    const int end = mesh.face_offset[face + 1];
+    const int first = mesh.face_index[begin];
+    if (!usable(first)) continue;
+    for (int i = begin + 1; i + 1 < end; ++i) {
+      const int second = mesh.face_index[i];
+      const int third = mesh.face_index[i + 1];
+      if (!usable(second) || !usable(third)) continue;
+      const double* p0 = &screen_[first * size_t{3}];
+      const double* p1 = &screen_[second * size_t{3}];
+      const double* p2 = &screen_[third * size_t{3}];
+      const double area = (p1[0] - p0[0]) * (p2[1] - p0[1]) -
+                          (p1[1] - p0[1]) * (p2[0] - p0[0]);
+      if (std::fabs(area) < 1e-12) continue;
+      triangles_.insert(triangles_.end(),
+                        {static_cast<uint32_t>(first),
+                         static_cast<uint32_t>(second),
+                         static_cast<uint32_t>(third)});
+    }
+  }
+
+  const size_t triangle_count = triangles_.size() / 3;
+  const double cells =
+      std::clamp(triangle_count / kTrianglesPerCell, 1.0, kMaxCells);
+  cell_size_ = std::max(1.0, std::sqrt(double(width) * height / cells));
+  cells_x_ = std::max(1, static_cast<int>(std::ceil(width / cell_size_)));
+  cells_y_ = std::max(1, static_cast<int>(std::ceil(height / cell_size_)));
+  const size_t cell_count = static_cast<size_t>(cells_x_) * cells_y_;
+
+  // Пары (ячейка, треугольник) по кускам, затем подсчёт и раскладка
+  // в порядке кусков: списки ячеек упорядочены и не зависят от потоков
+  const size_t chunks = std::clamp<size_t>(
+      (triangle_count + kTrianglesPerChunk - 1) / kTrianglesPerChunk, 1,
+      std::max(threads_, 1u));
+  std::vector<std::vector<std::pair<uint32_t, uint32_t>>> bins(chunks);
+  bounds_.resize(triangle_count * 4);
+  ParallelFor(chunks, threads_, [&](unsigned, size_t chunk) {
+    const size_t begin = triangle_count * chunk / chunks;
+    const size_t end = triangle_count * (chunk + 1) / chunks;
+    for (size_t triangle = begin; triangle < end; ++triangle) {
+      double min_x = INFINITY, min_y = INFINITY;
+      double max_x = -INFINITY, max_y = -INFINITY;
+      for (int k = 0; k < 3; ++k) {
+        const uint32_t vertex = triangles_[triangle * 3 + k];
+        const double* point = &screen_[vertex * size_t{3}];
+        min_x = std::min(min_x, point[0]);
+        max_x = std::max(max_x, point[0]);
+        min_y = std::min(min_y, point[1]);
+        max_y = std::max(max_y, point[1]);
+      }
+      float* bounds = &bounds_[triangle * 4];
+      bounds[0] = FloorFloat(min_x);
+      bounds[1] = FloorFloat(min_y);
+      bounds[2] = -FloorFloat(-max_x);
+      bounds[3] = -FloorFloat(-max_y);
+      if (max_x < 0.0 || max_y < 0.0 || min_x > width || min_y > height) {
+        continue;
+      }
+      const auto cell_of = [this](double coord, int limit) {
+        return std::clamp(static_cast<int>(coord / cell_size_), 0, limit - 1);
+      };
+      const int cx0 = cell_of(min_x, cells_x_), cx1 = cell_of(max_x, cells_x_);
+      const int cy0 = cell_of(min_y, cells_y_), cy1 = cell_of(max_y, cells_y_);
+      for (int cy = cy0; cy <= cy1; ++cy) {
+        for (int cx = cx0; cx <= cx1; ++cx) {
+          bins[chunk].emplace_back(static_cast<uint32_t>(cy * cells_x_ + cx),
+                                   static_cast<uint32_t>(triangle));
+        }
+      }
+    }
+  });
+
+  cell_offset_.assign(cell_count + 1, 0);
+  for (const auto& chunk : bins) {
+    for (const auto& entry : chunk) ++cell_offset_[entry.first + 1];
+  }
+  for (size_t cell = 0; cell < cell_count; ++cell) {
+    cell_offset_[cell + 1] += cell_offset_[cell];
+  }
+  cell_triangles_.resize(cell_offset_[cell_count]);
+  std::vector<uint32_t> fill(cell_offset_.begin(), cell_offset_.end() - 1);
+  for (const auto& chunk : bins) {
+    for (const auto& entry : chunk) {
+      cell_triangles_[fill[entry.first]++] = entry.second;
+    }
+  }
+
+  // Списки ячеек упорядочиваются по ближайшей вершине треугольника:
+  // просмотр для ребра останавливается на первом треугольнике за ним
+  cell_depth_.resize(cell_triangles_.size());
+  const size_t cell_chunks = (cell_count + kCellsPerChunk - 1) / kCellsPerChunk;
+  ParallelFor(cell_chunks, threads_, [&](unsigned, size_t chunk) {
+    std::vector<std::pair<float, uint32_t>> order;
+    const size_t end = std::min(cell_count, (chunk + 1) * kCellsPerChunk);
+    for (size_t cell = chunk * kCellsPerChunk; cell < end; ++cell) {
+      order.clear();
+      for (uint32_t k = cell_offset_[cell]; k < cell_offset_[cell + 1]; ++k) {
+        const uint32_t* vertex = &triangles_[cell_triangles_[k] * 3];
+        order.emplace_back(
+            FloorFloat(std::min({screen_[vertex[0] * size_t{3} + 2],
+                                 screen_[vertex[1] * size_t{3} + 2],
+                                 screen_[vertex[2] * size_t{3} + 2]})),
+            cell_triangles_[k]);
+      }
+      std::sort(order.begin(), order.end());
+      for (size_t k = 0; k < order.size(); ++k) {
+        cell_depth_[cell_offset_[cell] + k] = order[k].first;
+        cell_triangles_[cell_offset_[cell] + k] = order[k].second;
+      }
+    }
+  });
+}
+
+void VectorExporter::CollectHidden_(
+    uint32_t a, uint32_t b, const double from[3], const double to[3],
+    std::vector<std::pair<double, double>>& hidden) const {
+  const auto cell_of = [this](double coord, int limit) {
+    return std::clamp(static_cast<int>(coord / cell_size_), 0, limit - 1);
+  };
+  const double dx = to[0] - from[0], dy = to[1] - from[1];
+  const double edge_max_z = std::max(from[2], to[2]);
+  const double gap = kMinPiece / std::sqrt(dx * dx + dy * dy);
+
+  // Обход ячеек, через которые проходит ребро (DDA по сетке): каждая
+  // посещается один раз, шаг - по оси, чья граница ближе
+  int cx = cell_of(from[0], cells_x_), cy = cell_of(from[1], cells_y_);
+  const int end_x = cell_of(to[0], cells_x_);
+  const int end_y = cell_of(to[1], cells_y_);
+  const int step_x = end_x > cx ? 1 : -1, step_y = end_y > cy ? 1 : -1;
+  const double delta_x = dx != 0.0 ? cell_size_ / std::fabs(dx) : INFINITY;
+  const double delta_y = dy != 0.0 ? cell_size_ / std::fabs(dy) : INFINITY;
+  double next_x = dx != 0.0 ? ((cx + (dx > 0.0)) * cell_size_ - from[0]) / dx
+                            : INFINITY;
+  double next_y = dy != 0.0 ? ((cy + (dy > 0.0)) * cell_size_ - from[1]) / dy
+                            : INFINITY;
+  size_t checked = 0;
+  for (int left = std::abs(end_x - cx) + std::abs(end_y - cy); left >= 0;
+       --left) {
+    const size_t cell = static_cast<size_t>(cy) * cells_x_ + cx;
+    // Дальше - треугольники целиком за ребром: глубина их плоскости
+    // внутри не меньше глубины ближней вершины
+    for (uint32_t k = cell_offset_[cell];
+         k < cell_offset_[cell + 1] &&
+         cell_depth_[k] + kDepthEpsilon < edge_max_z;
+         ++k) {
+      double lo = 0.0, hi = 1.0;
+      if (HiddenInterval_(cell_triangles_[k], a, b, from, to, lo, hi)) {
+        hidden.emplace_back(lo, hi);
+      }
+    }
+    if (hidden.size() > checked) {
+      checked = hidden.size();
+      if (Covered(hidden, gap)) return;
+    }
+    // Ось, по которой конечная ячейка уже достигнута, не шагает: обход
+    // заканчивается точно в ней при любых ошибках округления
+    if (cy == end_y || (cx != end_x && next_x < next_y)) {
+      cx += step_x;
+      next_x += delta_x;
+    } else {
+      cy += step_y;
+      next_y += delta_y;
+    }
+  }
+}
+
+bool VectorExporter::HiddenInterval_(uint32_t triangle, uint32_t a,
+                                     uint32_t b, const double from[3],
+                                     const double to[3], double& lo,
+                                     double& hi) const {
+  // Быстрый отказ: рамки ребра и треугольника не пересекаются
+  const float* bounds = &bounds_[triangle * size_t{4}];
+  if (bounds[2] < std::min(from[0], to[0]) ||
+      bounds[0] > std::max(from[0], to[0]) ||
+      bounds[3] < std::min(from[1], to[1]) ||
+      bounds[1] > std::max(from[1], to[1])) {
+    return false;
+  }
+  const uint32_t* vertex = &triangles_[triangle * 3];
+  const double* p0 = &screen_[vertex[0] * size_t{3}];
+  const double* p1 = &screen_[vertex[1] * size_t{3}];
+  const double* p2 = &screen_[vertex[2] * size_t{3}];
+  const double x[3] = {p0[0], p1[0], p2[0]};
+  const double y[3] = {p0[1], p1[1], p2[1]};
+  const bool has_a = vertex[0] == a || vertex[1] == a || vertex[2] == a;
+  const bool has_b = vertex[0] == b || vertex[1] == b || vertex[2] == b;
+  // Грань, которой принадлежит ребро, его не закрывает
+  if (has_a && has_b) return false;
+
+  const double area =
+      (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]);
+  const double sign = area > 0.0 ? 1.0 : -1.0;
+
+  // Часть ребра внутри треугольника, сжатого на kInset (касание в
+  // общей вершине не считается перекрытием)
+  for (int i = 0; i < 3; ++i) {
+    const int j = (i + 1) % 3;
+    const double ex = x[j] - x[i], ey = y[j] - y[i];
+    const double inset = kInset * std::sqrt(ex * ex + ey * ey);
+    const double f0 =
+        sign * (ex * (from[1] - y[i]) - ey * (from[0] - x[i])) - inset;
+    const double f1 =
+        sign * (ex * (to[1] - y[i]) - ey * (to[0] - x[i])) - inset;
+    if (!ClipParameter(f0, f1, lo, hi)) return false;
+  }
+
+  // Ребро закрыто там, где оно дальше плоскости треугольника
+  const double z[3] = {p0[2], p1[2], p2[2]};
+  const double gx =
+      ((z[1] - z[0]) * (y[2] - y[0]) - (z[2] - z[0]) * (y[1] - y[0])) / area;
+  const double gy =
+      ((z[2] - z[0]) * (x[1] - x[0]) - (z[1] - z[0]) * (x[2] - x[0])) / area;
+  const double d0 =
+      from[2] - (z[0] + gx * (from[0] - x[0]) + gy * (from[1] - y[0])) -
+      kDepthEpsilon;
+  const double d1 =
+      to[2] - (z[0] + gx * (to[0] - x[0]) + gy * (to[1] - y[0])) -
+      kDepthEpsilon;
+  return ClipParameter(d0, d1, lo, hi) && lo < hi;
+}
+
+std::string FormatSvg(const std::vector<Segment2D>& lines, int width,
+                      int height, const VectorStyle& style,
+                      unsigned threads) {
+  S21_TRACE_SCOPE("FormatSvg");
+  const size_t chunks = (lines.size() + kLinesPerChunk - 1) / kLinesPerChunk;
+  std::vector<std::string> parts(chunks);
+  ParallelFor(chunks, threads, [&](unsigned, size_t chunk) {
+    std::string& out = parts[chunk];
+    const size_t end = std::min(lines.size(), (chunk + 1) * kLinesPerChunk);
+    out.reserve((end - chunk * kLinesPerChunk) * 24);
+    for (size_t i = chunk * kLinesPerChunk; i < end; ++i) {
+      // Конец относительно начала: разность округлённых координат точна
+      const long long x0 = ToHundredths(lines[i].x0);
+      const long long y0 = ToHundredths(lines[i].y0);
+      out.push_back('M');
+      AppendHundredths(out, x0);
+      out.push_back(' ');
+      AppendHundredths(out, y0);
+      out.push_back('l');
+      AppendHundredths(out, ToHundredths(lines[i].x1) - x0);
+      const long long dy = ToHundredths(lines[i].y1) - y0;
+      if (dy >= 0) out.push_back(' ');
+      AppendHundredths(out, dy);
+      if ((i + 1) % 8 == 0) out.push_back('\n');
+    }
+  });
+
+  const std::string size = std::to_string(width) + "\" height=\"" +
+                           std::to_string(height);
+  std::string svg =
+      "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+      "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"" +
+      size + "\" viewBox=\"0 0 " + std::to_string(width) + ' ' +
+      std::to_string(height) + "\">\n<rect width=\"" + size +
+      "\" fill=\"" + HexColor(style.background) +
+      "\"/>\n<path fill=\"none\" stroke=\"" + HexColor(style.line_color) +
+      "\" stroke-width=\"";
+  AppendHundredths(svg, ToHundredths(style.line_width));
+  svg += "\" stroke-linecap=\"round\" d=\"\n";
+  for (const std::string& part : parts) svg += part;
+  svg += "\"/>\n</svg>\n";
+  return svg;
+}
+
+std::string FormatPdf(const std::vector<Segment2D>& lines, int width,
+                      int height, const VectorStyle& style,
+                      unsigned threads) {
+  S21_TRACE_SCOPE("FormatPdf");
+  // Оформление: заливка фона, цвет, толщина, круглые концы
+  std::string header = PdfColor(style.background) + " rg\n0 0 " +
+                       std::to_string(width) + ' ' + std::to_string(height) +
+                       " re f\n" + PdfColor(style.line_color) + " RG\n";
+  AppendHundredths(header, ToHundredths(style.line_width));
+  header += " w\n1 J\n1 j\n";
+
+  // Каждый блок отрезков - отдельный поток содержимого: блоки
+  // формируются и сжимаются независимо
+  const size_t chunks = (lines.size() + kLinesPerChunk - 1) / kLinesPerChunk;
+  std::vector<std::string> streams(chunks);
+  ParallelFor(chunks, threads, [&](unsigned, size_t chunk) {
+    std::string text;
+    const size_t end = std::min(lines.size(), (chunk + 1) * kLinesPerChunk);
+    text.reserve((end - chunk * kLinesPerChunk) * 32);
+    for (size_t i = chunk * kLinesPerChunk; i < end; ++i) {
+      // В PDF ось Y направлена вверх
+      AppendHundredths(text, ToHundredths(lines[i].x0));
+      text.push_back(' ');
+      AppendHundredths(text, ToHundredths(height - lines[i].y0));
+      text += " m ";
+      AppendHundredths(text, ToHundredths(lines[i].x1));
+      text.push_back(' ');
+      AppendHundredths(text, ToHundredths(height - lines[i].y1));
+      text += " l\n";
+    }
+    text += "S\n";
+    uLongf size = compressBound(static_cast<uLong>(text.size()));
+    std::string& compressed = streams[chunk];
+    compressed.resize(size);
+    compress2(reinterpret_cast<Bytef*>(&compressed[0]), &size,
+              reinterpret_cast<const Bytef*>(text.data()),
+              static_cast<uLong>(text.size()), Z_BEST_SPEED);
+    compressed.resize(size);
+  });
+
+  std::string pdf("%PDF-1.4\n%\xE2\xE3\xCF\xD3\n");
+  std::vector<size_t> offsets;
+  auto begin_object = [&pdf, &offsets] {
+    offsets.push_back(pdf.size());
+    pdf += std::to_string(offsets.size()) + " 0 obj\n";
+  };
+  begin_object();
+  pdf += "<< /Type /Catalog /Pages 2 0 R >>\nendobj\n";
+  begin_object();
+  pdf += "<< /Type /Pages /Kids [3 0 R] /Count 1 >>\nendobj\n";
+  begin_object();
+  pdf += "<< /Type /Page /Parent 2 0 R /MediaBox [0 0 " +
+         std::to_string(width) + ' ' + std::to_string(height) +
+         "] /Resources << >> /Contents [";
+  for (size_t i = 0; i <= chunks; ++i) {
+    pdf += std::to_string(4 + i) + " 0 R ";
+  }
+  pdf += "] >>\nendobj\n";
+  begin_object();
+  pdf += "<< /Length " + std::to_string(header.size()) + " >>\nstream\n" +
+         header + "\nendstream\nendobj\n";
+  for (const std::string& stream : streams) {
+    begin_object();
+    pdf += "<< /Length " + std::to_string(stream.size()) +
+           " /Filter /FlateDecode >>\nstream\n";
+    pdf += stream;
+    pdf += "\nendstream\nendobj\n";
+  }
+
+  const size_t xref = pdf.size();
+  pdf += "xref\n0 " + std::to_string(offsets.size() + 1) +
+         "\n0000000000 65535 f \n";
+  for (size_t offset : offsets) {
+    char entry[24];
+    std::snprintf(entry, sizeof(entry), "%010zu 00000 n \n", offset);
+    pdf += entry;
+  }
+  pdf += "trailer\n<< /Size " + std::to_string(offsets.size() + 1) +
+         " /Root 1 0 R >>\nstartxref\n" + std::to_string(xref) +
+         "\n%%EOF\n";
+  return pdf;
+}
+
+bool WriteVectorDrawing(const std::string& path,
+                        const std::vector<Segment2D>& lines, int width,
+                        int height, const VectorStyle& style,
+                        unsigned threads) {
+  std::string extension =
+      path.size() >= 4 ? path.substr(path.size() - 4) : std::string();
+  std::transform(extension.begin(), extension.end(), extension.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+  const std::string data =
+      extension == ".pdf" ? FormatPdf(lines, width, height, style, threads)
+                          : FormatSvg(lines, width, height, style, threads);
+  std::ofstream file(path, std::ios::binary);
+  file.write(data.data(), static_cast<std::streamsize>(data.size()));
+  return static_cast<bool>(file);
+}
+
+}  // namespace s21
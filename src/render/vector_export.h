@@ -0,0 +1,182 @@
+#ifndef RENDER_VECTOR_EXPORT_H
+#define RENDER_VECTOR_EXPORT_H
+
+/**
+ * @file vector_export.h
+ * @brief Векторный чертёж каркаса (SVG, PDF) с удалением невидимых линий
+ */
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../model/mesh.h"
+#include "camera.h"
+#include "image.h"
+
+namespace s21 {
+
+/**
+ * @brief Видимый отрезок в пикселях кадра (y вниз, как в Image)
+ */
+struct Segment2D {
+  float x0, y0, x1, y1;
+};
+
+/**
+ * @brief Параметры чертежа
+ *
+ * По умолчанию - чёрные линии на белом фоне, как принято в
+ * документации.
+ */
+struct VectorStyle {
+  bool hidden_line_removal = true;  ///< Удалять линии, закрытые гранями
+  bool merge_collinear = true;      ///< Склеивать отрезки одной прямой
+  double line_width = 1.0;          ///< Толщина линии, пикселей
+  uint32_t line_color = MakeColor(0, 0, 0);        ///< Цвет линий
+  uint32_t background = MakeColor(255, 255, 255);  ///< Цвет фона
+};
+
+/**
+ * @brief Замеры последнего построения чертежа
+ */
+struct VectorStats {
+  size_t edges = 0;       ///< Уникальных рёбер модели
+  size_t triangles = 0;   ///< Треугольников-заслонок
+  size_t segments = 0;    ///< Видимых кусков рёбер
+  size_t lines = 0;       ///< Отрезков после склейки
+  double project_ms = 0.0;  ///< Проекция и раскладка граней по сетке
+  double hidden_ms = 0.0;   ///< Удаление невидимых линий
+  double merge_ms = 0.0;    ///< Склейка коллинеарных отрезков
+};
+
+/**
+ * @brief Строит видимые линии каркаса для текущей камеры
+ *
+ * Рёбра и грани проецируются той же матрицей, что и в Rasterizer.
+ * Грани разбиваются веером на треугольники и раскладываются по
+ * равномерной сетке экрана (ячейка подбирается так, чтобы на неё
+ * приходилось несколько треугольников); список ячейки упорядочен по
+ * глубине ближней вершины. Каждое ребро проверяется только против
+ * треугольников ячеек, через которые проходит, и только пока они не
+ * оказываются целиком за ним; ребро, закрытое полностью, дальше не
+ * проверяется. Глубина NDC линейна вдоль проекции и ребра, и плоскости
+ * треугольника, поэтому закрытая часть ребра - один интервал,
+ * вычисляемый точно, без растра. Результат не зависит от разрешения:
+ * чертёж можно масштабировать.
+ *
+ * Рёбра обрабатываются кусками в потоках ParallelFor, каждый кусок
+ * пишет свои отрезки, поэтому порядок и результат не зависят от числа
+ * потоков. Видимые куски затем группируются по прямой (направление и
+ * смещение) и склеиваются, если перекрываются или соприкасаются: ребра
+ * сетки, лежащие на одной прямой, превращаются в одну линию.
+ *
+ * Треугольники, пересекающие ближнюю плоскость или вышедшие за
+ * диапазон глубины, заслонками не считаются.
+ *
+ * @example
+ * @code
+ * VectorExporter exporter(DefaultThreadCount());
+ * const auto lines = exporter.Build(mesh, camera, 1600, 1200, style);
+ * WriteVectorDrawing("drawing.pdf", lines, 1600, 1200, style);
+ * @endcode
+ */
+class VectorExporter {
+ public:
+  /**
+   * @brief Создаёт построитель
+   * @param threads Потоков на чертёж (1 - в вызывающем потоке)
+   */
+  explicit VectorExporter(unsigned threads = 1) noexcept
+      : threads_(threads) {}
+
+  /**
+   * @brief Устанавливает число потоков
+   */
+  void SetThreadCount(unsigned threads) noexcept { threads_ = threads; }
+
+  /**
+   * @brief Строит видимые отрезки кадра width x height
+   *
+   * @param mesh Модель (рёбра рисуются, грани заслоняют)
+   * @param camera Камера, как у окна просмотра или Rasterizer
+   * @param stats Замеры (может быть nullptr)
+   */
+  std::vector<Segment2D> Build(const Mesh& mesh, const Camera& camera,
+                               int width, int height,
+                               const VectorStyle& style,
+                               VectorStats* stats = nullptr);
+
+ private:
+  /**
+   * @brief Проецирует вершины в пиксели и глубину NDC
+   */
+  void Project_(const Mesh& mesh, const Matrix4& matrix, int width,
+                int height);
+
+  /**
+   * @brief Собирает треугольники граней и раскладывает их по сетке
+   */
+  void BinTriangles_(const Mesh& mesh, int width, int height);
+
+  /**
+   * @brief Добавляет к hidden закрытые гранями интервалы ребра a-b
+   *
+   * Останавливается, как только ребро закрыто целиком.
+   *
+   * @param from, to Видимая часть ребра в пикселях (x, y, глубина)
+   */
+  void CollectHidden_(uint32_t a, uint32_t b, const double from[3],
+                      const double to[3],
+                      std::vector<std::pair<double, double>>& hidden) const;
+
+  /**
+   * @brief Находит часть [lo, hi] ребра, закрытую треугольником
+   * @return false если треугольник ребро не закрывает
+   */
+  bool HiddenInterval_(uint32_t triangle, uint32_t a, uint32_t b,
+                       const double from[3], const double to[3], double& lo,
+                       double& hi) const;
+
+  unsigned threads_;  ///< Потоков на чертёж
+  std::vector<double> clip_x_, clip_y_, clip_z_, clip_w_;  ///< Отсечение
+  std::vector<double> screen_;  ///< Тройки x, y в пикселях и z NDC
+  std::vector<uint32_t> triangles_;   ///< Тройки индексов вершин
+  std::vector<float> bounds_;  ///< Рамки треугольников (x0, y0, x1, y1)
+  double cell_size_ = 1.0;            ///< Сторона ячейки сетки, пикселей
+  int cells_x_ = 0;                   ///< Ячеек по горизонтали
+  int cells_y_ = 0;                   ///< Ячеек по вертикали
+  std::vector<uint32_t> cell_offset_;     ///< Начало списка ячейки
+  std::vector<uint32_t> cell_triangles_;  ///< Треугольники ячеек подряд
+  std::vector<float> cell_depth_;  ///< Глубина ближней вершины, по росту
+};
+
+/**
+ * @brief Формирует SVG: один path с абсолютным началом и относительным
+ * концом каждого отрезка, координаты с точностью 0.01 пикселя
+ */
+std::string FormatSvg(const std::vector<Segment2D>& lines, int width,
+                      int height, const VectorStyle& style,
+                      unsigned threads = 1);
+
+/**
+ * @brief Формирует PDF 1.4: страница width x height пунктов, линии в
+ * нескольких сжатых (Flate) потоках содержимого, сжимаемых параллельно
+ */
+std::string FormatPdf(const std::vector<Segment2D>& lines, int width,
+                      int height, const VectorStyle& style,
+                      unsigned threads = 1);
+
+/**
+ * @brief Записывает чертёж; формат по расширению (.pdf - PDF, иначе SVG)
+ * @return true при успешной записи
+ */
+bool WriteVectorDrawing(const std::string& path,
+                        const std::vector<Segment2D>& lines, int width,
+                        int height, const VectorStyle& style,
+                        unsigned threads = 1);
+
+}  // namespace s21
+
+#endif  // RENDER_VECTOR_EXPORT_H
@@ -0,0 +1,76 @@
+/**
+ * @file bench_deviation.cpp
+ * @brief Скорость расстояний от вершин до эталонной поверхности
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "benchmark.h"
+#include "model/deviation.h"
+#include "model/parallel.h"
+
+using namespace s21;
+
+namespace {
+
+/**
+ * @brief Тор rings x segments четырёхугольников, поверхность с рябью
+ *
+ * ripple задаёт высоту ряби: у эталона 0, у "скана" - отклонение.
+ */
+void MakeTorus(int rings, int segments, double ripple, Mesh& mesh) {
+  const double pi = 3.141592653589793;
+  mesh.Clear();
+  mesh.vertex_coord.reserve(size_t(rings) * segments * 3);
+  for (int ring = 0; ring < rings; ++ring) {
+    const double u = 2.0 * pi * ring / rings;
+    for (int segment = 0; segment < segments; ++segment) {
+      const double v = 2.0 * pi * segment / segments;
+      const double r = 1.0 + ripple * std::sin(40.0 * u) * std::sin(9.0 * v);
+      mesh.vertex_coord.insert(
+          mesh.vertex_coord.end(),
+          {(4.0 + r * std::cos(v)) * std::cos(u),
+           (4.0 + r * std::cos(v)) * std::sin(u), r * std::sin(v)});
+    }
+  }
+  mesh.face_index.reserve(size_t(rings) * segments * 4);
+  for (int ring = 0; ring < rings; ++ring) {
+    for (int segment = 0; segment < segments; ++segment) {
+      auto id = [&](int i, int j) {
+        return (i % rings) * segments + j % segments;
+      };
+      for (int vertex : {id(ring, segment), id(ring, segment + 1),
+                         id(ring + 1, segment + 1), id(ring + 1, segment)}) {
+        mesh.face_index.push_back(vertex);
+      }
+      mesh.face_offset.push_back(static_cast<int>(mesh.face_index.size()));
+    }
+  }
+}
+
+}  // namespace
+
+S21_BENCHMARK("deviation/measure") {
+  // Эталон и "скан" разной плотности; время на вершину не должно
+  // расти с размером
+  Mesh reference, scan;
+  for (int rings : {1000, 3000}) {
+    MakeTorus(rings, rings / 4, 0.0, reference);
+    MakeTorus(rings * 3 / 2, rings * 3 / 8, 0.01, scan);
+    Deviation deviation(DefaultThreadCount());
+    const double build_ms =
+        bench::BestOfMs(1, [&] { deviation.Build(reference); });
+    std::vector<float> distance;
+    DeviationStats stats;
+    const double measure_ms = bench::BestOfMs(
+        1, [&] { stats = deviation.Measure(scan.vertex_coord, distance); });
+    std::printf(
+        "  эталон %zu треугольников: построение %.0f мс; %zu вершин: "
+        "%.0f мс (%.0f нс на вершину, %u потоков); max %.4f, rms %.4f\n",
+        deviation.GetTriangleCount(), build_ms, stats.vertex_count,
+        measure_ms, measure_ms * 1e6 / stats.vertex_count,
+        DefaultThreadCount(), stats.max, stats.rms);
+  }
+}
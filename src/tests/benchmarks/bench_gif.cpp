@@ -0,0 +1,97 @@
+/**
+ * @file bench_gif.cpp
+ * @brief Пропускная способность записи экрана в GIF
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "benchmark.h"
+#include "model/parallel.h"
+#include "render/gif_encoder.h"
+#include "render/rasterizer.h"
+
+using namespace s21;
+
+namespace {
+
+/**
+ * @brief Тор из четырёхугольников (только рёбра)
+ */
+RenderMesh MakeTorus(int rings, int segments) {
+  RenderMesh mesh;
+  const double pi = 3.141592653589793;
+  for (int ring = 0; ring < rings; ++ring) {
+    const double theta = 2.0 * pi * ring / rings;
+    for (int segment = 0; segment < segments; ++segment) {
+      const double phi = 2.0 * pi * segment / segments;
+      const double radius = 0.6 + 0.25 * std::cos(phi);
+      mesh.position.push_back(static_cast<float>(radius * std::cos(theta)));
+      mesh.position.push_back(static_cast<float>(0.25 * std::sin(phi)));
+      mesh.position.push_back(static_cast<float>(radius * std::sin(theta)));
+    }
+  }
+  for (int ring = 0; ring < rings; ++ring) {
+    for (int segment = 0; segment < segments; ++segment) {
+      const uint32_t a = ring * segments + segment;
+      const uint32_t b = ring * segments + (segment + 1) % segments;
+      const uint32_t c = (ring + 1) % rings * segments + segment;
+      mesh.edges.insert(mesh.edges.end(), {a, b, a, c});
+    }
+  }
+  return mesh;
+}
+
+/**
+ * @brief Кадры вращающейся модели, как их снимает запись экрана
+ */
+std::vector<Image> RenderFrames(int width, int height, int count) {
+  const RenderMesh mesh = MakeTorus(120, 48);
+  Rasterizer rasterizer(DefaultThreadCount());
+  Camera camera;
+  std::vector<Image> frames(count);
+  for (int i = 0; i < count; ++i) {
+    camera.rotation[0] = 30.0;
+    camera.rotation[1] = 360.0 * i / count;
+    rasterizer.Render(mesh, camera, RenderStyle(), width, height, frames[i]);
+  }
+  return frames;
+}
+
+}  // namespace
+
+S21_BENCHMARK("gif/encode") {
+  // 5 секунд по 10 кадров/с: формат записи окна и увеличенные варианты
+  struct Size {
+    int width, height, frames;
+  };
+  std::vector<unsigned> counts = {1, 2};
+  if (DefaultThreadCount() > 2) counts.push_back(DefaultThreadCount());
+
+  for (const Size& size : {Size{640, 480, 50}, Size{1280, 720, 50},
+                           Size{640, 480, 300}}) {
+    const std::vector<Image> frames =
+        RenderFrames(size.width, size.height, size.frames);
+    std::printf("  %d кадров %dx%d\n", size.frames, size.width,
+                size.height);
+    double single = 0.0;
+    for (unsigned threads : counts) {
+      GifEncoder encoder(threads);
+      const double add_ms = bench::BestOfMs(1, [&] {
+        for (const Image& frame : frames) encoder.AddFrame(frame);
+      });
+      GifStats stats;
+      const double encode_ms = bench::BestOfMs(3, [&] {
+        bench::DoNotOptimize(encoder.Encode(10, &stats).size());
+      });
+      if (threads == 1) single = encode_ms;
+      std::printf(
+          "  %2u потоков: приём %.2f мс/кадр, кодирование %8.2f мс "
+          "(%.0f кадр/с, x%.2f), %d цветов, %.1f КБ\n",
+          threads, add_ms / size.frames, encode_ms,
+          1000.0 * size.frames / encode_ms, single / encode_ms, stats.colors,
+          stats.bytes / 1024.0);
+    }
+  }
+}
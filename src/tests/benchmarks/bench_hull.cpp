@@ -0,0 +1,84 @@
+/**
+ * @file bench_hull.cpp
+ * @brief Скорость выпуклой оболочки и ориентированного box
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "benchmark.h"
+#include "model/hull.h"
+#include "model/parallel.h"
+
+using namespace s21;
+
+namespace {
+
+/**
+ * @brief Вершины повёрнутого вытянутого тора rings x segments
+ *
+ * На оболочку попадает только внешняя сторона тора, у сферы - все
+ * вершины; сфера задаётся sphere = true.
+ */
+void MakeCloud(int rings, int segments, bool sphere,
+               std::vector<double>& coord) {
+  const double pi = 3.141592653589793;
+  coord.clear();
+  coord.reserve(size_t(rings) * segments * 3);
+  for (int ring = 0; ring < rings; ++ring) {
+    const double u = 2.0 * pi * ring / rings;
+    for (int segment = 0; segment < segments; ++segment) {
+      const double v = 2.0 * pi * segment / segments;
+      double x, y, z;
+      if (sphere) {
+        x = std::cos(u) * std::sin(v / 2.0);
+        y = std::sin(u) * std::sin(v / 2.0);
+        z = std::cos(v / 2.0);
+      } else {
+        x = (4.0 + std::cos(v)) * std::cos(u) * 3.0;
+        y = (4.0 + std::cos(v)) * std::sin(u);
+        z = std::sin(v) * 0.5;
+      }
+      // Поворот на 30 градусов вокруг Z: осевой box заметно больше
+      coord.insert(coord.end(),
+                   {x * 0.866 - y * 0.5, x * 0.5 + y * 0.866, z});
+    }
+  }
+}
+
+}  // namespace
+
+S21_BENCHMARK("hull/obb") {
+  std::vector<double> coord;
+  for (bool sphere : {false, true}) {
+    for (int rings : {500, 1500}) {
+      MakeCloud(rings, rings / 2, sphere, coord);
+      ConvexHull hull;
+      const double hull_ms = bench::BestOfMs(1, [&] {
+        hull = ComputeConvexHull(coord, DefaultThreadCount());
+      });
+      OrientedBox box;
+      const double box_ms = bench::BestOfMs(1, [&] {
+        box = ComputeOrientedBox(hull, DefaultThreadCount());
+      });
+      double aabb = 1.0;
+      for (int axis = 0; axis < 3; ++axis) {
+        double low = coord[axis], high = low;
+        for (size_t i = axis; i < coord.size(); i += 3) {
+          low = std::min(low, coord[i]);
+          high = std::max(high, coord[i]);
+        }
+        aabb *= high - low;
+      }
+      std::printf(
+          "  %s, %zu вершин: оболочка %zu вершин за %.0f мс (%.0f нс на "
+          "вершину), box за %.0f мс (%u потоков); объём box %.3g, "
+          "осевого %.3g\n",
+          sphere ? "сфера" : "тор", coord.size() / 3, hull.GetVertexCount(),
+          hull_ms, hull_ms * 1e6 / (coord.size() / 3), box_ms,
+          DefaultThreadCount(), box.GetVolume(), aabb);
+    }
+  }
+}
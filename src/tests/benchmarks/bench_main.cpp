@@ -0,0 +1,21 @@
+/**
+ * @file bench_main.cpp
+ * @brief Точка входа бенчмарков: ./run_benchmarks [фильтр]
+ */
+
+#include <cstdio>
+#include <cstring>
+
+#include "benchmark.h"
+
+int main(int argc, char* argv[]) {
+  const char* filter = argc > 1 ? argv[1] : "";
+
+  for (const auto& bench_case : s21::bench::Registry()) {
+    if (std::strstr(bench_case.name.c_str(), filter) == nullptr) continue;
+    std::printf("=== %s ===\n", bench_case.name.c_str());
+    bench_case.body();
+  }
+
+  return 0;
+}
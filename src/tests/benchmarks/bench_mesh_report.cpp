@@ -0,0 +1,67 @@
+/**
+ * @file bench_mesh_report.cpp
+ * @brief Скорость подробного отчёта о сетке
+ */
+
+#include <cstdio>
+#include <vector>
+
+#include "benchmark.h"
+#include "model/mesh_tools.h"
+#include "model/parallel.h"
+
+using namespace s21;
+
+namespace {
+
+/**
+ * @brief Сетка side x side четырёхугольников с рёбрами, как из парсера
+ */
+void MakeGrid(int side, Mesh& mesh) {
+  mesh.Clear();
+  mesh.vertex_coord.reserve(size_t(side + 1) * (side + 1) * 3);
+  for (int y = 0; y <= side; ++y) {
+    for (int x = 0; x <= side; ++x) {
+      mesh.vertex_coord.insert(mesh.vertex_coord.end(),
+                               {double(x), double(y), 0.1 * ((x ^ y) & 3)});
+    }
+  }
+  mesh.face_index.reserve(size_t(side) * side * 4);
+  mesh.vertex_index.reserve(size_t(side) * side * 8);
+  for (int y = 0; y < side; ++y) {
+    for (int x = 0; x < side; ++x) {
+      const int a = y * (side + 1) + x;
+      const int quad[4] = {a, a + 1, a + side + 2, a + side + 1};
+      for (int i = 0; i < 4; ++i) {
+        mesh.face_index.push_back(quad[i]);
+        mesh.vertex_index.push_back(quad[i]);
+        mesh.vertex_index.push_back(quad[(i + 1) % 4]);
+      }
+      mesh.face_offset.push_back(static_cast<int>(mesh.face_index.size()));
+    }
+  }
+}
+
+}  // namespace
+
+S21_BENCHMARK("mesh/report") {
+  // Отчёт читает каждый буфер один-два раза: время сравнивается с
+  // объёмом прочитанных данных
+  Mesh mesh;
+  for (int side : {1000, 2000}) {
+    MakeGrid(side, mesh);
+    MeshReport report;
+    const double ms = bench::BestOfMs(3, [&] {
+      report = ComputeMeshReport(mesh, DefaultThreadCount());
+    });
+    const double bytes =
+        (mesh.vertex_coord.size() * sizeof(double) +
+         2 * mesh.vertex_index.size() * sizeof(int) +
+         (mesh.face_index.size() + mesh.face_offset.size()) * sizeof(int));
+    std::printf(
+        "  %zu граней, %zu рёбер: %.0f мс (%.2f ГБ/с буферов, %u потоков); "
+        "различных рёбер %zu, площадь %.0f\n",
+        report.face_count, report.edge_count, ms, bytes / ms / 1e6,
+        DefaultThreadCount(), report.unique_edge_count, report.surface_area);
+  }
+}
@@ -0,0 +1,144 @@
+/**
+ * @file bench_picker.cpp
+ * @brief Скорость построения иерархий и выбора под курсором
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "benchmark.h"
+#include "model/parallel.h"
+#include "render/picker.h"
+
+using namespace s21;
+
+namespace {
+
+/**
+ * @brief Сфера rings x segments: координаты и рёбра четырёхугольников
+ *
+ * Каждое ребро встречается дважды, как в буфере рёбер вида.
+ */
+void MakeSphere(int rings, int segments, std::vector<float>& positions,
+                std::vector<int>& edges) {
+  const double pi = 3.141592653589793;
+  positions.clear();
+  edges.clear();
+  positions.reserve(size_t(rings + 1) * segments * 3);
+  edges.reserve(size_t(rings) * segments * 8);
+  for (int ring = 0; ring <= rings; ++ring) {
+    const double theta = pi * ring / rings;
+    for (int segment = 0; segment < segments; ++segment) {
+      const double phi = 2.0 * pi * segment / segments;
+      positions.push_back(float(0.9 * std::sin(theta) * std::cos(phi)));
+      positions.push_back(float(0.9 * std::cos(theta)));
+      positions.push_back(float(0.9 * std::sin(theta) * std::sin(phi)));
+    }
+  }
+  for (int ring = 0; ring < rings; ++ring) {
+    for (int segment = 0; segment < segments; ++segment) {
+      const int a = ring * segments + segment;
+      const int b = ring * segments + (segment + 1) % segments;
+      const int quad[4] = {a, b, b + segments, a + segments};
+      for (int k = 0; k < 4; ++k) {
+        edges.push_back(quad[k]);
+        edges.push_back(quad[(k + 1) % 4]);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+S21_BENCHMARK("picker/hover") {
+  std::vector<float> positions;
+  std::vector<int> edges;
+  MakeSphere(2500, 5000, positions, edges);
+  Camera camera;
+  camera.rotation[0] = 25.0;
+  camera.projection = kProjectionPerspective;
+  constexpr int kWidth = 1920, kHeight = 1080;
+  constexpr int kQueries = 2000;
+
+  Picker picker(DefaultThreadCount());
+  const double build_ms =
+      bench::BestOfMs(1, [&] { picker.Build(positions, edges); });
+  const double refit_ms = bench::BestOfMs(1, [&] { picker.Refit(positions); });
+  std::printf(
+      "  %zu вершин, %zu рёбер: построение %.0f мс, обновление %.0f мс "
+      "(%u потоков)\n",
+      picker.GetVertexCount(), picker.GetEdgeCount(), build_ms, refit_ms,
+      DefaultThreadCount());
+
+  // Курсор в случайных точках кадра, половина - над моделью
+  std::mt19937 random(1);
+  std::uniform_real_distribution<double> x(0.0, kWidth), y(0.0, kHeight);
+  std::vector<double> times;
+  size_t vertices = 0, edge_hits = 0;
+  for (int query = 0; query < kQueries; ++query) {
+    const double cx = x(random), cy = y(random);
+    PickResult hit;
+    times.push_back(bench::BestOfMs(1, [&] {
+      hit = picker.Pick(camera, kWidth, kHeight, cx, cy);
+    }));
+    vertices += hit.kind == kPickVertex;
+    edge_hits += hit.kind == kPickEdge;
+  }
+  std::sort(times.begin(), times.end());
+  double sum = 0.0;
+  for (double ms : times) sum += ms;
+  std::printf(
+      "  выбор: среднее %.3f мс, медиана %.3f мс, 99%% %.3f мс, максимум "
+      "%.3f мс (вершин %zu, рёбер %zu из %d)\n",
+      sum / kQueries, times[kQueries / 2], times[kQueries * 99 / 100],
+      times.back(), vertices, edge_hits, kQueries);
+}
+
+S21_BENCHMARK("picker/select") {
+  std::vector<float> positions;
+  std::vector<int> edges;
+  MakeSphere(2500, 5000, positions, edges);
+  Camera camera;
+  camera.rotation[0] = 25.0;
+  constexpr int kWidth = 1920, kHeight = 1080;
+  Picker picker(DefaultThreadCount());
+  picker.Build(positions, {});
+
+  // Звезда из 64 точек поверх модели - невыпуклое лассо
+  std::vector<double> star;
+  for (int i = 0; i < 64; ++i) {
+    const double angle = 3.141592653589793 * i / 32.0;
+    const double radius = i % 2 == 0 ? 500.0 : 250.0;
+    star.push_back(kWidth * 0.5 + radius * std::sin(angle));
+    star.push_back(kHeight * 0.5 - radius * std::cos(angle));
+  }
+  const double mask_ms = bench::BestOfMs(3, [&] {
+    bench::DoNotOptimize(ScreenRegion::Lasso(star, kWidth, kHeight));
+  });
+  const ScreenRegion regions[] = {
+      ScreenRegion::Rect(400.0, 100.0, 1500.0, 900.0),
+      ScreenRegion::Lasso(star, kWidth, kHeight)};
+  const char* names[] = {"рамка", "лассо"};
+  for (int k = 0; k < 2; ++k) {
+    SelectionBits selection;
+    const double select_ms = bench::BestOfMs(3, [&] {
+      picker.Select(camera, kWidth, kHeight, regions[k], kSelectReplace,
+                    selection);
+    });
+    SelectionStats stats;
+    const double summary_ms =
+        bench::BestOfMs(3, [&] { stats = picker.Summarize(selection); });
+    std::vector<uint32_t> vertices;
+    const double list_ms = bench::BestOfMs(
+        3, [&] { picker.GetSelectedVertices(selection, vertices); });
+    std::printf(
+        "  %s: выделено %zu из %zu вершин за %.1f мс, итог %.1f мс, "
+        "список %.1f мс\n",
+        names[k], stats.count, picker.GetVertexCount(), select_ms, summary_ms,
+        list_ms);
+  }
+  std::printf("  маска лассо %dx%d: %.1f мс\n", kWidth, kHeight, mask_ms);
+}
@@ -0,0 +1,75 @@
+/**
+ * @file bench_rasterizer.cpp
+ * @brief Скорость программного растеризатора в зависимости от потоков
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "benchmark.h"
+#include "model/parallel.h"
+#include "render/rasterizer.h"
+
+using namespace s21;
+
+namespace {
+
+/**
+ * @brief Сфера rings x segments из четырёхугольников (только рёбра)
+ */
+RenderMesh MakeSphere(int rings, int segments) {
+  RenderMesh mesh;
+  const double pi = 3.141592653589793;
+  for (int ring = 0; ring <= rings; ++ring) {
+    const double theta = pi * ring / rings;
+    for (int segment = 0; segment < segments; ++segment) {
+      const double phi = 2.0 * pi * segment / segments;
+      mesh.position.push_back(
+          static_cast<float>(0.9 * std::sin(theta) * std::cos(phi)));
+      mesh.position.push_back(static_cast<float>(0.9 * std::cos(theta)));
+      mesh.position.push_back(
+          static_cast<float>(0.9 * std::sin(theta) * std::sin(phi)));
+    }
+  }
+  for (int ring = 0; ring < rings; ++ring) {
+    for (int segment = 0; segment < segments; ++segment) {
+      const uint32_t a = ring * segments + segment;
+      const uint32_t b = ring * segments + (segment + 1) % segments;
+      mesh.edges.insert(mesh.edges.end(), {a, b, a, a + segments});
+    }
+  }
+  return mesh;
+}
+
+}  // namespace
+
+S21_BENCHMARK("rasterizer/threads") {
+  constexpr int kWidth = 1920;
+  constexpr int kHeight = 1080;
+  const RenderMesh mesh = MakeSphere(500, 1000);
+  Camera camera;
+  camera.rotation[0] = 25.0;
+  camera.keep_aspect = false;
+  Image image;
+
+  std::printf("  %zu вершин, %zu рёбер, кадр %dx%d\n", mesh.GetVertexCount(),
+              mesh.edges.size() / 2, kWidth, kHeight);
+  std::vector<unsigned> counts = {1, 2};
+  if (DefaultThreadCount() > 2) counts.push_back(DefaultThreadCount());
+  double single[2] = {};
+  for (unsigned threads : counts) {
+    Rasterizer rasterizer(threads);
+    for (bool antialias : {false, true}) {
+      RenderStyle style;
+      style.antialias = antialias;
+      const double ms = bench::BestOfMs(5, [&] {
+        rasterizer.Render(mesh, camera, style, kWidth, kHeight, image);
+      });
+      if (threads == 1) single[antialias] = ms;
+      std::printf("  %2u потоков, %-7s %8.2f мс (%.1f кадр/с, x%.2f)\n",
+                  threads, antialias ? "AA" : "без AA", ms, 1000.0 / ms,
+                  single[antialias] / ms);
+    }
+  }
+}
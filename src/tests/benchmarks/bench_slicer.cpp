@@ -0,0 +1,94 @@
+/**
+ * @file bench_slicer.cpp
+ * @brief Скорость сечения плоскостью при перетаскивании
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "benchmark.h"
+#include "model/parallel.h"
+#include "model/slicer.h"
+
+using namespace s21;
+
+namespace {
+
+/**
+ * @brief Тор из rings x segments четырёхугольников, разбитых на треугольники
+ */
+void MakeTorus(int rings, int segments, std::vector<float>& positions,
+               std::vector<int>& face_index, std::vector<int>& face_offset) {
+  const double pi = 3.141592653589793;
+  positions.clear();
+  face_index.clear();
+  face_offset.assign(1, 0);
+  positions.reserve(size_t(rings) * segments * 3);
+  face_index.reserve(size_t(rings) * segments * 6);
+  face_offset.reserve(size_t(rings) * segments * 2 + 1);
+  for (int ring = 0; ring < rings; ++ring) {
+    const double u = 2.0 * pi * ring / rings;
+    for (int segment = 0; segment < segments; ++segment) {
+      const double v = 2.0 * pi * segment / segments;
+      const double r = 0.6 + 0.25 * std::cos(v);
+      positions.push_back(float(r * std::cos(u)));
+      positions.push_back(float(r * std::sin(u)));
+      positions.push_back(float(0.25 * std::sin(v)));
+    }
+  }
+  for (int ring = 0; ring < rings; ++ring) {
+    for (int segment = 0; segment < segments; ++segment) {
+      const int a = ring * segments + segment;
+      const int b = ring * segments + (segment + 1) % segments;
+      const int c = (ring + 1) % rings * segments + (segment + 1) % segments;
+      const int d = (ring + 1) % rings * segments + segment;
+      for (int vertex : {a, b, c, a, c, d}) face_index.push_back(vertex);
+      face_offset.push_back(static_cast<int>(face_index.size()) - 3);
+      face_offset.push_back(static_cast<int>(face_index.size()));
+    }
+  }
+}
+
+}  // namespace
+
+S21_BENCHMARK("slicer/drag") {
+  std::vector<float> positions;
+  std::vector<int> face_index, face_offset;
+  MakeTorus(5000, 2000, positions, face_index, face_offset);
+  constexpr int kSteps = 100;
+
+  Slicer slicer(DefaultThreadCount());
+  const double build_ms = bench::BestOfMs(1, [&] {
+    slicer.Build(positions, face_index, face_offset);
+  });
+  std::printf("  %zu граней: построение %.0f мс (%u потоков)\n",
+              slicer.GetFaceCount(), build_ms, DefaultThreadCount());
+
+  // Плоскость протягивается через модель поперёк и наискось
+  for (int tilted = 0; tilted < 2; ++tilted) {
+    SlicePlane plane;
+    plane.normal[0] = tilted ? 0.3 : 0.0;
+    plane.normal[1] = tilted ? -0.2 : 0.0;
+    std::vector<double> times;
+    size_t points = 0, faces = 0, contours = 0;
+    for (int step = 0; step < kSteps; ++step) {
+      plane.offset = -0.24 + 0.48 * step / (kSteps - 1);
+      Section section;
+      times.push_back(
+          bench::BestOfMs(1, [&] { section = slicer.Slice(plane); }));
+      points += section.GetPointCount();
+      faces += section.faces_tested;
+      contours += section.polylines.size();
+    }
+    std::sort(times.begin(), times.end());
+    double sum = 0.0;
+    for (double ms : times) sum += ms;
+    std::printf(
+        "  %s: среднее %.2f мс, медиана %.2f мс, максимум %.2f мс; "
+        "в среднем %zu точек, %zu контуров, %zu граней проверено\n",
+        tilted ? "наклонная" : "z = const", sum / kSteps, times[kSteps / 2],
+        times.back(), points / kSteps, contours / kSteps, faces / kSteps);
+  }
+}
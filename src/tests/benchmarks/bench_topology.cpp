@@ -0,0 +1,76 @@
+/**
+ * @file bench_topology.cpp
+ * @brief Скорость построения полурёбер и оболочек
+ */
+
+#include <cstdio>
+#include <vector>
+
+#include "benchmark.h"
+#include "model/parallel.h"
+#include "model/topology.h"
+
+using namespace s21;
+
+namespace {
+
+/**
+ * @brief shells торов из rings x segments четырёхугольников
+ *
+ * Четырёхугольники разбиты на треугольники, вершины тора общие. При
+ * stride > 1 номера вершин перемешиваются: соседние грани ссылаются на
+ * далёкие вершины, как в файлах без локальности.
+ */
+void MakeTori(int shells, int rings, int segments, size_t stride,
+              Mesh& mesh) {
+  const int per_shell = rings * segments;
+  const size_t vertices = size_t(shells) * per_shell;
+  mesh.Clear();
+  mesh.vertex_coord.assign(vertices * 3, 0.0);
+  mesh.face_index.reserve(vertices * 6);
+  mesh.face_offset.reserve(vertices * 2 + 1);
+  auto id = [&](int shell, int ring, int segment) {
+    const size_t linear = size_t(shell) * per_shell +
+                          size_t(ring % rings) * segments + segment % segments;
+    return static_cast<int>(linear * stride % vertices);
+  };
+  for (int shell = 0; shell < shells; ++shell) {
+    for (int ring = 0; ring < rings; ++ring) {
+      for (int segment = 0; segment < segments; ++segment) {
+        const int a = id(shell, ring, segment);
+        const int b = id(shell, ring, segment + 1);
+        const int c = id(shell, ring + 1, segment + 1);
+        const int d = id(shell, ring + 1, segment);
+        for (int vertex : {a, b, c, a, c, d}) {
+          mesh.face_index.push_back(vertex);
+        }
+        mesh.face_offset.push_back(static_cast<int>(mesh.face_index.size()) -
+                                   3);
+        mesh.face_offset.push_back(static_cast<int>(mesh.face_index.size()));
+      }
+    }
+  }
+}
+
+}  // namespace
+
+S21_BENCHMARK("topology/build") {
+  // Время на грань не должно расти с размером: проверка линейности.
+  // Шаг 7919 взаимно прост с числом вершин
+  Mesh mesh;
+  for (size_t stride : {size_t{1}, size_t{7919}}) {
+    for (int rings : {625, 2500}) {
+      MakeTori(4, rings, 1000, stride, mesh);
+      Topology topology(DefaultThreadCount());
+      const double ms = bench::BestOfMs(1, [&] { topology.Build(mesh); });
+      const TopologyStats& stats = topology.GetStats();
+      std::printf(
+          "  %s, %zu граней: %.0f мс (%.0f нс на грань, %u потоков); "
+          "рёбер %zu, оболочек %zu, край %zu, замкнута: %s\n",
+          stride == 1 ? "локальные номера" : "перемешанные номера",
+          stats.face_count, ms, ms * 1e6 / stats.face_count,
+          DefaultThreadCount(), stats.edge_count, stats.component_count,
+          stats.boundary_edge_count, stats.IsClosed() ? "да" : "нет");
+    }
+  }
+}
@@ -0,0 +1,57 @@
+/**
+ * @file bench_trace.cpp
+ * @brief Накладные расходы трассировки интервалов
+ */
+
+#include <cstdio>
+
+#include "benchmark.h"
+#include "model/model.h"
+#include "profiling/trace.h"
+
+using namespace s21;
+
+S21_BENCHMARK("trace/span_cost") {
+  constexpr int kSpans = 1000000;
+  Tracer& tracer = Tracer::GetInstance();
+
+  for (bool enabled : {false, true}) {
+    tracer.SetEnabled(enabled);
+    double ms = bench::BestOfMs(5, [] {
+      for (int i = 0; i < kSpans; ++i) {
+        S21_TRACE_SCOPE("bench/empty");
+      }
+    });
+    std::printf("  %-8s %.1f нс/интервал\n", enabled ? "enabled" : "disabled",
+                ms * 1e6 / kSpans);
+  }
+
+  tracer.SetEnabled(false);
+  tracer.Clear();
+}
+
+S21_BENCHMARK("trace/transform_overhead") {
+  constexpr size_t kVertices = 100000;
+  constexpr int kTicks = 200;
+  Model& model = Model::GetInstance();
+  Tracer& tracer = Tracer::GetInstance();
+
+  model.GetVertexCoord().assign(kVertices * 3, 0.5);
+
+  double ms[2] = {};
+  for (bool enabled : {false, true}) {
+    tracer.SetEnabled(enabled);
+    ms[enabled] = bench::BestOfMs(5, [&model] {
+      for (int i = 0; i < kTicks; ++i) {
+        model.Transform(kRotate, 1.0, kY);
+      }
+    });
+  }
+
+  std::printf("  disabled %.3f мс, enabled %.3f мс, overhead %.2f%%\n", ms[0],
+              ms[1], (ms[1] - ms[0]) * 100.0 / ms[0]);
+
+  tracer.SetEnabled(false);
+  tracer.Clear();
+  model.GetVertexCoord().clear();
+}
@@ -0,0 +1,84 @@
+/**
+ * @file bench_vector_export.cpp
+ * @brief Скорость векторного чертежа с удалением невидимых линий
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "benchmark.h"
+#include "model/parallel.h"
+#include "render/vector_export.h"
+
+using namespace s21;
+
+namespace {
+
+/**
+ * @brief Сфера rings x segments из четырёхугольников
+ */
+Mesh MakeSphere(int rings, int segments) {
+  Mesh mesh;
+  const double pi = 3.141592653589793;
+  for (int ring = 0; ring <= rings; ++ring) {
+    const double theta = pi * ring / rings;
+    for (int segment = 0; segment < segments; ++segment) {
+      const double phi = 2.0 * pi * segment / segments;
+      mesh.vertex_coord.insert(mesh.vertex_coord.end(),
+                               {0.9 * std::sin(theta) * std::cos(phi),
+                                0.9 * std::cos(theta),
+                                0.9 * std::sin(theta) * std::sin(phi)});
+    }
+  }
+  for (int ring = 0; ring < rings; ++ring) {
+    for (int segment = 0; segment < segments; ++segment) {
+      const int a = ring * segments + segment;
+      const int b = ring * segments + (segment + 1) % segments;
+      const int quad[4] = {a, b, b + segments, a + segments};
+      for (int k = 0; k < 4; ++k) {
+        mesh.face_index.push_back(quad[k]);
+        mesh.vertex_index.push_back(quad[k]);
+        mesh.vertex_index.push_back(quad[(k + 1) % 4]);
+      }
+      mesh.face_offset.push_back(static_cast<int>(mesh.face_index.size()));
+    }
+  }
+  return mesh;
+}
+
+}  // namespace
+
+S21_BENCHMARK("vector/hidden_lines") {
+  constexpr int kSize = 2048;
+  const Mesh mesh = MakeSphere(1250, 2000);
+  Camera camera;
+  camera.rotation[0] = 25.0;
+
+  std::vector<unsigned> counts = {1};
+  if (DefaultThreadCount() > 1) counts.push_back(DefaultThreadCount());
+  for (unsigned threads : counts) {
+    VectorExporter exporter(threads);
+    VectorStats stats;
+    std::vector<Segment2D> lines;
+    const double ms = bench::BestOfMs(2, [&] {
+      lines = exporter.Build(mesh, camera, kSize, kSize, VectorStyle(),
+                             &stats);
+    });
+    std::printf(
+        "  %2u потоков: %zu рёбер, %zu треугольников -> %zu кусков, %zu "
+        "линий за %.0f мс (проекция %.0f, невидимые %.0f, склейка %.0f)\n",
+        threads, stats.edges, stats.triangles, stats.segments, stats.lines,
+        ms, stats.project_ms, stats.hidden_ms, stats.merge_ms);
+
+    std::string svg, pdf;
+    const double svg_ms = bench::BestOfMs(1, [&] {
+      svg = FormatSvg(lines, kSize, kSize, VectorStyle(), threads);
+    });
+    const double pdf_ms = bench::BestOfMs(1, [&] {
+      pdf = FormatPdf(lines, kSize, kSize, VectorStyle(), threads);
+    });
+    std::printf("  SVG %.1f МБ за %.0f мс, PDF %.1f МБ за %.0f мс\n",
+                svg.size() / 1e6, svg_ms, pdf.size() / 1e6, pdf_ms);
+  }
+}
@@ -0,0 +1,81 @@
+#ifndef TESTS_BENCHMARKS_BENCHMARK_H
+#define TESTS_BENCHMARKS_BENCHMARK_H
+
+/**
+ * @file benchmark.h
+ * @brief Минимальный каркас бенчмарков без внешних зависимостей
+ */
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace s21::bench {
+
+/**
+ * @brief Зарегистрированный бенчмарк
+ */
+struct Case {
+  std::string name;            ///< Имя бенчмарка
+  std::function<void()> body;  ///< Тело, печатающее результаты
+};
+
+/**
+ * @brief Возвращает список зарегистрированных бенчмарков
+ */
+inline std::vector<Case>& Registry() {
+  static std::vector<Case> cases;
+  return cases;
+}
+
+/**
+ * @brief Регистрирует бенчмарк при статической инициализации
+ */
+struct Registrar {
+  Registrar(const char* name, std::function<void()> body) {
+    Registry().push_back({name, std::move(body)});
+  }
+};
+
+/**
+ * @brief Возвращает лучшее время выполнения fn в миллисекундах
+ * @param repeats Количество повторов
+ * @param fn Измеряемая функция
+ */
+template <typename Fn>
+double BestOfMs(int repeats, Fn&& fn) {
+  double best = 1e300;
+  for (int i = 0; i < repeats; ++i) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    if (elapsed.count() < best) best = elapsed.count();
+  }
+  return best;
+}
+
+/**
+ * @brief Не даёт компилятору выбросить вычисление значения
+ */
+template <typename T>
+inline void DoNotOptimize(const T& value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+}  // namespace s21::bench
+
+#define S21_BENCHMARK_CONCAT_IMPL(a, b) a##b
+#define S21_BENCHMARK_CONCAT(a, b) S21_BENCHMARK_CONCAT_IMPL(a, b)
+
+/**
+ * @brief Объявляет бенчмарк с заданным именем
+ */
+#define S21_BENCHMARK(name)                                            \
+  static void S21_BENCHMARK_CONCAT(BenchBody_, __LINE__)();            \
+  static ::s21::bench::Registrar S21_BENCHMARK_CONCAT(bench_, __LINE__)( \
+      name, S21_BENCHMARK_CONCAT(BenchBody_, __LINE__));               \
+  static void S21_BENCHMARK_CONCAT(BenchBody_, __LINE__)()
+
+#endif  // TESTS_BENCHMARKS_BENCHMARK_H
@@ -0,0 +1,194 @@
+#!/usr/bin/env python3
+"""Замер задержки команд канала автоматизации 3DViewer.
+
+Запускает 3DViewer --automation на временном сокете (по умолчанию без
+дисплея, QT_QPA_PLATFORM=offscreen), загружает модель и измеряет:
+
+- ping: круговая задержка канала без участия модели;
+- transform: последовательные команды rotate, ответ приходит после
+  вывода кадра с результатом;
+- burst: пакет из N команд без ожидания ответов; показывает, сколько
+  трансформаций осталось после объединения и сколько кадров понадобилось;
+- capture: снимок в --capture-scale раз больше окна и повороты, пока он
+  кодируется; задержка поворотов не должна заметно вырасти;
+- record: запись GIF на --record-seconds секунд под непрерывными
+  поворотами; частота кадров окна во время записи и кодирования и
+  замеры кодировщика из ответа.
+
+    python3 automation_latency.py ../../build/3DViewer model.obj --count 200
+
+Код возврата 1 - команда завершилась ошибкой или viewer не ответил.
+"""
+
+import argparse
+import os
+import socket
+import statistics
+import subprocess
+import sys
+import tempfile
+import time
+
+
+class Client:
+    def __init__(self, path, timeout=15.0):
+        deadline = time.monotonic() + timeout
+        while True:
+            self.sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+            try:
+                self.sock.connect(path)
+                break
+            except OSError:
+                self.sock.close()
+                if time.monotonic() > deadline:
+                    raise
+                time.sleep(0.05)
+        self.sock.settimeout(timeout)
+        self.buffer = b""
+
+    def send(self, line):
+        self.sock.sendall(line.encode() + b"\n")
+
+    def read_reply(self):
+        while b"\n" not in self.buffer:
+            chunk = self.sock.recv(65536)
+            if not chunk:
+                raise ConnectionError("viewer closed the connection")
+            self.buffer += chunk
+        line, self.buffer = self.buffer.split(b"\n", 1)
+        return line.decode()
+
+    def request(self, line):
+        self.send(line)
+        reply = self.read_reply()
+        if reply.split(" ", 1)[0].startswith("@"):
+            reply = reply.split(" ", 1)[1]
+        if not reply.startswith("ok"):
+            raise RuntimeError("%s -> %s" % (line, reply))
+        return reply[3:]
+
+
+def summary(name, samples_ms):
+    samples_ms = sorted(samples_ms)
+    p95 = samples_ms[min(len(samples_ms) - 1, int(len(samples_ms) * 0.95))]
+    print("%-10s n=%-5d median %.3f ms  p95 %.3f ms  max %.3f ms" % (
+        name, len(samples_ms), statistics.median(samples_ms), p95,
+        samples_ms[-1]))
+
+
+def timed(client, line):
+    start = time.perf_counter()
+    client.request(line)
+    return (time.perf_counter() - start) * 1000.0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("binary")
+    parser.add_argument("model")
+    parser.add_argument("--count", type=int, default=200)
+    parser.add_argument("--burst", type=int, default=1000)
+    parser.add_argument("--capture-scale", type=int, default=4)
+    parser.add_argument("--record-seconds", type=float, default=5.0)
+    args = parser.parse_args()
+
+    env = dict(os.environ)
+    env.setdefault("QT_QPA_PLATFORM", "offscreen")
+    path = os.path.join(tempfile.mkdtemp(), "3dviewer.sock")
+    viewer = subprocess.Popen([args.binary, "--automation", path], env=env,
+                              stderr=subprocess.DEVNULL)
+    try:
+        client = Client(path)
+        print("load       %s" % client.request(
+            "load " + os.path.abspath(args.model)))
+
+        summary("ping", [timed(client, "ping") for _ in range(args.count)])
+        summary("transform", [timed(client, "@%d rotate y 1" % i)
+                              for i in range(args.count)])
+
+        before = dict(item.split("=") for item in
+                      client.request("stats").split())
+        start = time.perf_counter()
+        client.send("; ".join("@b%d rotate x 0.5" % i
+                              for i in range(args.burst)))
+        for _ in range(args.burst):
+            reply = client.read_reply()
+            if " ok" not in reply:
+                raise RuntimeError(reply)
+        burst_ms = (time.perf_counter() - start) * 1000.0
+        after = dict(item.split("=") for item in
+                     client.request("stats").split())
+
+        print("burst      %d commands in %.1f ms: %d transforms applied, "
+              "%d frames" % (
+                  args.burst, burst_ms,
+                  int(after["applied"]) - int(before["applied"]),
+                  int(after["frames"]) - int(before["frames"])))
+        print("ack        p50 %s ms  p99 %s ms" % (after["ack_ms_p50"],
+                                                   after["ack_ms_p99"]))
+
+        # Ответ на снимок приходит после записи файла; повороты идут
+        # параллельно с кодированием
+        capture_path = os.path.join(os.path.dirname(path), "capture.jpg")
+        start = time.perf_counter()
+        client.send("@capture capture %s %d" % (capture_path,
+                                                args.capture_scale))
+        during = []
+        capture_reply = None
+        for i in range(args.count):
+            sent = time.perf_counter()
+            client.send("@c%d rotate y 1" % i)
+            while True:
+                reply = client.read_reply()
+                if reply.startswith("@capture "):
+                    capture_reply = reply
+                    capture_ms = (time.perf_counter() - start) * 1000.0
+                    continue
+                during.append((time.perf_counter() - sent) * 1000.0)
+                break
+        while capture_reply is None:
+            capture_reply = client.read_reply()
+            capture_ms = (time.perf_counter() - start) * 1000.0
+        if " ok" not in capture_reply:
+            raise RuntimeError(capture_reply)
+        summary("capture", during)
+        print("snapshot   %s in %.1f ms" % (capture_reply.split()[-1],
+                                           capture_ms))
+
+        # Повороты без пауз, пока GIF снимается и кодируется: каждый
+        # ответ приходит после кадра, поэтому их темп - частота кадров
+        record_path = os.path.join(os.path.dirname(path), "record.gif")
+        start = time.perf_counter()
+        client.send("@record record %s %g" % (record_path,
+                                              args.record_seconds))
+        during = []
+        record_reply = None
+        while record_reply is None:
+            sent = time.perf_counter()
+            client.send("@r%d rotate y 1" % len(during))
+            while True:
+                reply = client.read_reply()
+                if reply.startswith("@record "):
+                    record_reply = reply
+                    continue
+                during.append((time.perf_counter() - sent) * 1000.0)
+                break
+        record_ms = (time.perf_counter() - start) * 1000.0
+        if " ok" not in record_reply:
+            raise RuntimeError(record_reply)
+        summary("record", during)
+        print("recording  %.1f frames/s in view, %s" % (
+            len(during) * 1000.0 / record_ms,
+            record_reply.split(" ok ", 1)[1]))
+        client.send("quit")
+    except (OSError, RuntimeError) as error:
+        print(error, file=sys.stderr)
+        return 1
+    finally:
+        viewer.terminate()
+        viewer.wait(timeout=10)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
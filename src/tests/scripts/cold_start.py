@@ -0,0 +1,91 @@
+#!/usr/bin/env python3
+"""Замер холодного запуска 3DViewer.
+
+Запускает приложение N раз с --startup-report --exit-after-first-frame,
+собирает медианы этапов запуска и общее время до выхода, дописывает
+результат в CSV истории и сравнивает с предыдущей записью.
+
+    python3 cold_start.py ../../../build/3DViewer --runs 10 [model.obj]
+
+Код возврата 2 - медиана запуска выросла больше допустимого (--tolerance).
+"""
+
+import argparse
+import csv
+import datetime
+import os
+import statistics
+import subprocess
+import sys
+import time
+
+
+def run_once(binary, model):
+    env = dict(os.environ)
+    env.setdefault("QT_QPA_PLATFORM", "offscreen")
+    command = [binary, "--startup-report", "--exit-after-first-frame"]
+    if model:
+        command.append(model)
+
+    start = time.perf_counter()
+    result = subprocess.run(command, env=env, capture_output=True, text=True,
+                            timeout=60)
+    wall_ms = (time.perf_counter() - start) * 1000.0
+
+    phases = {}
+    for line in result.stderr.splitlines():
+        parts = line.split(maxsplit=2)
+        if len(parts) == 3:
+            try:
+                phases[parts[2]] = float(parts[1])
+            except ValueError:
+                pass
+    return wall_ms, phases
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("binary")
+    parser.add_argument("model", nargs="?")
+    parser.add_argument("--runs", type=int, default=10)
+    parser.add_argument("--history", default="cold_start_history.csv")
+    parser.add_argument("--tolerance", type=float, default=0.2)
+    args = parser.parse_args()
+
+    walls = []
+    phases = {}
+    for _ in range(args.runs):
+        wall_ms, run_phases = run_once(args.binary, args.model)
+        walls.append(wall_ms)
+        for name, total_ms in run_phases.items():
+            phases.setdefault(name, []).append(total_ms)
+
+    wall_median = statistics.median(walls)
+    print(f"cold start: median {wall_median:.1f} ms over {args.runs} runs")
+    for name, values in phases.items():
+        print(f"  {statistics.median(values):10.2f} ms  {name}")
+
+    previous = None
+    if os.path.exists(args.history):
+        with open(args.history, newline="") as history:
+            rows = list(csv.DictReader(history))
+            if rows:
+                previous = float(rows[-1]["wall_ms"])
+
+    first_frame = phases.get("first frame presented", [0.0])
+    with open(args.history, "a", newline="") as history:
+        writer = csv.writer(history)
+        if history.tell() == 0:
+            writer.writerow(["date", "runs", "wall_ms", "first_frame_ms"])
+        writer.writerow([datetime.datetime.now().isoformat(timespec="seconds"),
+                         args.runs, f"{wall_median:.2f}",
+                         f"{statistics.median(first_frame):.2f}"])
+
+    if previous and wall_median > previous * (1.0 + args.tolerance):
+        print(f"regression: {previous:.1f} -> {wall_median:.1f} ms")
+        return 2
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,150 @@
+#!/usr/bin/env python3
+"""Замер пропускной способности сервиса рендера 3dviewer-cli.
+
+Запускает 3dviewer-cli --serve на временном Unix-сокете, открывает
+несколько параллельных клиентов и в течение заданного времени шлёт
+команды render с меняющимся углом. Печатает рендеры в секунду,
+перцентили задержки и счётчики кэша моделей из команды stats.
+
+    python3 render_service_bench.py ../../build/cli/3dviewer-cli model.obj \\
+        --clients 4 --seconds 10 --size 512
+
+Код возврата 1 - хотя бы один запрос завершился ошибкой.
+"""
+
+import argparse
+import os
+import socket
+import statistics
+import subprocess
+import sys
+import tempfile
+import threading
+import time
+
+
+def read_line(sock):
+    data = bytearray()
+    while True:
+        chunk = sock.recv(1)
+        if not chunk:
+            raise ConnectionError("connection closed")
+        if chunk == b"\n":
+            return data.decode()
+        data += chunk
+
+
+def request(sock, command):
+    sock.sendall(command.encode() + b"\n")
+    header = read_line(sock)
+    if not header.startswith("ok "):
+        raise RuntimeError(header)
+    size = int(header[3:])
+    body = bytearray()
+    while len(body) < size:
+        chunk = sock.recv(size - len(body))
+        if not chunk:
+            raise ConnectionError("connection closed")
+        body += chunk
+    return bytes(body)
+
+
+def connect(path, timeout=10.0):
+    deadline = time.monotonic() + timeout
+    while True:
+        sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        try:
+            sock.connect(path)
+            return sock
+        except OSError:
+            sock.close()
+            if time.monotonic() > deadline:
+                raise
+            time.sleep(0.05)
+
+
+def client(path, model, size, deadline, latencies, errors, lock):
+    local = []
+    local_errors = 0
+    sock = connect(path)
+    angle = 0
+    while time.monotonic() < deadline:
+        command = "render %s width=%d height=%d ry=%d" % (model, size, size,
+                                                           angle)
+        start = time.perf_counter()
+        try:
+            request(sock, command)
+            local.append((time.perf_counter() - start) * 1000.0)
+        except RuntimeError as error:
+            local_errors += 1
+            print(error, file=sys.stderr)
+        angle = (angle + 7) % 360
+    sock.sendall(b"quit\n")
+    sock.close()
+    with lock:
+        latencies.extend(local)
+        errors.append(local_errors)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("binary")
+    parser.add_argument("model")
+    parser.add_argument("--clients", type=int, default=4)
+    parser.add_argument("--seconds", type=float, default=10.0)
+    parser.add_argument("--size", type=int, default=512)
+    parser.add_argument("--workers", type=int, default=0)
+    args = parser.parse_args()
+
+    model = os.path.abspath(args.model)
+    path = os.path.join(tempfile.mkdtemp(), "render.sock")
+    # По умолчанию по рабочему потоку на клиента: соединение занимает поток
+    workers = args.workers or args.clients
+    server = subprocess.Popen([args.binary, "--serve", path, "-j",
+                               str(workers)],
+                              stdout=subprocess.DEVNULL)
+    try:
+        # Первый запрос прогревает кэш и не входит в замер
+        sock = connect(path)
+        request(sock, "render %s width=%d height=%d" % (model, args.size,
+                                                        args.size))
+        sock.sendall(b"quit\n")
+        sock.close()
+
+        latencies, errors, lock = [], [], threading.Lock()
+        deadline = time.monotonic() + args.seconds
+        threads = [threading.Thread(target=client,
+                                    args=(path, model, args.size, deadline,
+                                          latencies, errors, lock))
+                   for _ in range(args.clients)]
+        start = time.monotonic()
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+        elapsed = time.monotonic() - start
+
+        sock = connect(path)
+        stats = request(sock, "stats").decode()
+        sock.sendall(b"quit\n")
+        sock.close()
+    finally:
+        server.terminate()
+        server.wait(timeout=10)
+
+    if not latencies:
+        print("no successful renders", file=sys.stderr)
+        return 1
+    latencies.sort()
+    p95 = latencies[min(len(latencies) - 1, int(len(latencies) * 0.95))]
+    print("clients        %d" % args.clients)
+    print("renders        %d" % len(latencies))
+    print("renders_per_s  %.1f" % (len(latencies) / elapsed))
+    print("latency_ms     median %.2f  p95 %.2f  max %.2f" % (
+        statistics.median(latencies), p95, latencies[-1]))
+    print(stats, end="")
+    return 1 if sum(errors) else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,77 @@
+#!/usr/bin/env python3
+"""Сравнение программного растеризатора с OpenGL (llvmpipe).
+
+Запускает 3DViewer дважды - с --renderer gl и --renderer cpu - через
+канал автоматизации, загружает модель и выполняет N поворотов. Ответ на
+поворот приходит после вывода кадра, поэтому время команды - время
+кадра вместе с доставкой. По умолчанию OpenGL программный
+(LIBGL_ALWAYS_SOFTWARE=1, llvmpipe) и окно без дисплея
+(QT_QPA_PLATFORM=offscreen), как на машинах без GPU.
+
+    python3 renderer_compare.py ../../build/3DViewer model.obj --count 100
+
+Ключ --hardware оставляет драйвер OpenGL системным.
+"""
+
+import argparse
+import os
+import subprocess
+import sys
+import tempfile
+import time
+
+from automation_latency import Client, summary, timed
+
+
+def measure(binary, model, renderer, count, env):
+    path = os.path.join(tempfile.mkdtemp(), "3dviewer.sock")
+    viewer = subprocess.Popen(
+        [binary, "--automation", path, "--renderer", renderer], env=env,
+        stderr=subprocess.DEVNULL)
+    try:
+        client = Client(path)
+        client.request("load " + os.path.abspath(model))
+        # Первые кадры прогревают кэши и драйвер
+        for _ in range(5):
+            client.request("rotate y 1")
+        start = time.perf_counter()
+        samples = [timed(client, "rotate y 1") for _ in range(count)]
+        elapsed = time.perf_counter() - start
+        client.send("quit")
+        return samples, count / elapsed
+    finally:
+        viewer.terminate()
+        viewer.wait(timeout=10)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("binary")
+    parser.add_argument("model")
+    parser.add_argument("--count", type=int, default=100)
+    parser.add_argument("--hardware", action="store_true")
+    args = parser.parse_args()
+
+    env = dict(os.environ)
+    env.setdefault("QT_QPA_PLATFORM", "offscreen")
+    if not args.hardware:
+        env["LIBGL_ALWAYS_SOFTWARE"] = "1"
+
+    results = {}
+    try:
+        for renderer in ("gl", "cpu"):
+            samples, fps = measure(args.binary, args.model, renderer,
+                                   args.count, env)
+            summary(renderer, samples)
+            results[renderer] = fps
+    except (OSError, RuntimeError) as error:
+        print(error, file=sys.stderr)
+        return 1
+
+    print("frames/s   gl %.1f  cpu %.1f  (cpu/gl x%.2f)" % (
+        results["gl"], results["cpu"], results["cpu"] / results["gl"]))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,212 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+
+#include "../model/model.h"
+#include "../model/slicer.h"
+#include "../model/worker_queue.h"
+#include "../profiling/frame_stats.h"
+#include "../profiling/input_recorder.h"
+#include "../profiling/latency.h"
+#include "../profiling/trace.h"
+#include "../render/picker.h"
+#include "../render/refit_scheduler.h"
+
+// Перехват выделений памяти для всего исполняемого файла тестов.
+// Счёт ведётся только в потоке, где взведён AllocationCounter, поэтому
+// остальные тесты и потоки gtest на результат не влияют.
+
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* pointer, size_t size);
+}
+
+namespace {
+
+thread_local bool g_counting = false;
+thread_local size_t g_allocations = 0;
+
+void CountAllocation() noexcept {
+  if (g_counting) ++g_allocations;
+}
+
+/**
+ * @brief Считает выделения памяти в текущем потоке за время жизни объекта
+ */
+class AllocationCounter {
+ public:
+  AllocationCounter() noexcept {
+    g_allocations = 0;
+    g_counting = true;
+  }
+  ~AllocationCounter() { g_counting = false; }
+
+  size_t Count() const noexcept { return g_allocations; }
+};
+
+}  // namespace
+
+extern "C" void* malloc(size_t size) {
+  CountAllocation();
+  return __libc_malloc(size);
+}
+
+extern "C" void* calloc(size_t count, size_t size) {
+  CountAllocation();
+  return __libc_calloc(count, size);
+}
+
+extern "C" void* realloc(void* pointer, size_t size) {
+  CountAllocation();
+  return __libc_realloc(pointer, size);
+}
+
+void* operator new(size_t size) {
+  CountAllocation();
+  if (void* pointer = __libc_malloc(size ? size : 1)) return pointer;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+
+void operator delete(void* pointer, size_t) noexcept { std::free(pointer); }
+
+using namespace s21;
+
+class AllocationTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    std::ofstream file(path_);
+    for (int i = 0; i < 64; ++i) {
+      file << "v " << i * 0.1 << ' ' << i * 0.2 << ' ' << -i * 0.1 << '\n';
+    }
+    for (int i = 1; i + 2 <= 64; ++i) {
+      file << "f " << i << ' ' << i + 1 << ' ' << i + 2 << '\n';
+    }
+    file.close();
+
+    Model& model = Model::GetInstance();
+    model.SetFileName(path_);
+    model.Parser();
+    ASSERT_EQ(model.GetError(), kNoError);
+  }
+
+  void TearDown() override {
+    Model::GetInstance().SetFileName("");
+    std::remove(path_.c_str());
+  }
+
+  std::string path_ = "test_allocations.obj";
+};
+
+TEST(AllocationCounterTest, DetectsNewAndMalloc) {
+  AllocationCounter counter;
+  int* value = new int(1);
+  void* block = std::malloc(16);
+  delete value;
+  std::free(block);
+  EXPECT_EQ(counter.Count(), 2u);
+}
+
+TEST_F(AllocationTest, Transform_SteadyStateAllocationFree) {
+  Model& model = Model::GetInstance();
+  // Прогрев: первое обращение к буферу трассы потока
+  model.Transform(kMove, 0.01, kX);
+
+  AllocationCounter counter;
+  for (int i = 0; i < 1000; ++i) {
+    model.Transform(kMove, 0.01, static_cast<transformation_t>(i % 3));
+    model.Transform(kRotate, 1.0, static_cast<transformation_t>(i % 3));
+    model.Transform(kScale, i % 2 ? 1.01 : 1.0 / 1.01, kX);
+  }
+  EXPECT_EQ(counter.Count(), 0u);
+}
+
+TEST_F(AllocationTest, FrameBookkeeping_SteadyStateAllocationFree) {
+  Tracer& tracer = Tracer::GetInstance();
+  tracer.SetEnabled(true);
+  LatencyTracker& latency = LatencyTracker::GetInstance();
+  FrameStats stats;
+  const auto start = LatencyTracker::Clock::now();
+  // Прогрев: буфер трассы потока и регистрация деструкторов синглтонов
+  // (atexit выделяет память при первом обращении)
+  {
+    S21_TRACE_SCOPE("warmup");
+  }
+  InputRecorder::GetInstance();
+
+  // Итерация кадра так, как её проходят слайдер, контроллер и paintGL
+  AllocationCounter counter;
+  for (int i = 0; i < 1000; ++i) {
+    S21_TRACE_SCOPE("frame");
+    const auto now = start + std::chrono::microseconds(i * 16000);
+    latency.MarkInput(kInputSlider, now);
+    latency.MarkStage(kStageRequested, now);
+    Model::GetInstance().Transform(kRotate, 0.5, kY);
+    latency.MarkStage(kStageTransformed, now);
+    latency.MarkStage(kStageDelivered, now);
+    InputRecorder::GetInstance().Record(kEventSlider, 3, i);
+    stats.AddFrame(i * 16.0, 1.0);
+    stats.SetCounters(RenderCounters{100, 0, 4800});
+    latency.MarkPresented(now + std::chrono::microseconds(500));
+  }
+  const size_t allocations = counter.Count();
+
+  tracer.SetEnabled(false);
+  tracer.Clear();
+  latency.Clear();
+  EXPECT_EQ(allocations, 0u);
+}
+
+TEST_F(AllocationTest, ViewRefit_SteadyStateAllocationFree) {
+  Model& model = Model::GetInstance();
+  const std::vector<double>& coords = model.GetVertexCoord();
+  std::atomic<int> finished{0};
+  auto notify = [](void* done) { ++*static_cast<std::atomic<int>*>(done); };
+  WorkerQueue worker(2);
+  RefitScheduler<Picker> picker(worker, 1, notify, &finished);
+  RefitScheduler<Slicer> slicer(worker, 1, notify, &finished);
+
+  // Смена модели: построение копирует данные и может выделять память
+  const Mesh mesh = model.GetMesh();
+  picker.Invalidate(true);
+  slicer.Invalidate(true);
+  picker.StartBuild([mesh](Picker& hierarchy) {
+    hierarchy.Build({mesh.vertex_coord.begin(), mesh.vertex_coord.end()},
+                    mesh.vertex_index);
+  });
+  slicer.StartBuild([mesh](Slicer& hierarchy) { hierarchy.Build(mesh); });
+  worker.WaitIdle();
+  picker.Finish();
+  slicer.Finish();
+
+  // Обновление так, как его проходит OpenGLWidget::SetModelData:
+  // трансформация, отметка иерархий и Refit из двойного буфера
+  auto tick = [&](int i) {
+    model.Transform(kRotate, 0.5, static_cast<transformation_t>(i % 3));
+    picker.Invalidate(false);
+    slicer.Invalidate(false);
+    picker.StartRefit(coords.data(), coords.size());
+    slicer.StartRefit(coords.data(), coords.size());
+    worker.WaitIdle();
+    picker.Finish();
+    slicer.Finish();
+  };
+  // Прогрев: свободные половины буферов получают память
+  tick(0);
+
+  AllocationCounter counter;
+  for (int i = 1; i <= 200; ++i) tick(i);
+  const size_t allocations = counter.Count();
+
+  EXPECT_EQ(allocations, 0u);
+  EXPECT_EQ(finished, 2 * 201 + 2);
+  ASSERT_NE(picker.Get(), nullptr);
+  ASSERT_NE(slicer.Get(), nullptr);
+  EXPECT_EQ(picker.Get()->GetVertexCount(), model.GetVertexCount());
+}
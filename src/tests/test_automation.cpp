@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "../automation/automation_protocol.h"
+
+using namespace s21;
+
+TEST(AutomationProtocolTest, ParsesBatchWithIds) {
+  std::vector<AutomationCommand> commands;
+  std::string error;
+  ASSERT_TRUE(ParseAutomationBatch(
+      "@1 load /tmp/cube.obj; @2 rotate y 30; move Z -0.5; scale 1.2;"
+      " capture out.png; stats; ping",
+      commands, error))
+      << error;
+  ASSERT_EQ(commands.size(), 7u);
+
+  EXPECT_EQ(commands[0].id, "1");
+  EXPECT_EQ(commands[0].type, kCommandLoad);
+  EXPECT_EQ(commands[0].path, "/tmp/cube.obj");
+  EXPECT_EQ(commands[1].id, "2");
+  EXPECT_EQ(commands[1].type, kCommandTransform);
+  EXPECT_EQ(commands[1].strategy, kRotate);
+  EXPECT_EQ(commands[1].axis, kY);
+  EXPECT_DOUBLE_EQ(commands[1].value, 30.0);
+  EXPECT_TRUE(commands[2].id.empty());
+  EXPECT_EQ(commands[2].strategy, kMove);
+  EXPECT_EQ(commands[2].axis, kZ);
+  EXPECT_DOUBLE_EQ(commands[2].value, -0.5);
+  EXPECT_EQ(commands[3].strategy, kScale);
+  EXPECT_EQ(commands[4].type, kCommandCapture);
+  EXPECT_DOUBLE_EQ(commands[4].value, 1.0);
+  EXPECT_EQ(commands[5].type, kCommandStats);
+  EXPECT_EQ(commands[6].type, kCommandPing);
+}
+
+TEST(AutomationProtocolTest, RejectsBadCommands) {
+  const std::vector<std::string> bad = {
+      "jump",        "move w 1",    "rotate x",  "rotate x ten",
+      "scale 0",     "scale -2",    "load",      "capture a.png b.png",
+      "stats now",   "@7",          "move x nan",  "capture a.png 0",
+      "capture a.png 9", "capture a.png 1.5", "record", "record a.gif 0",
+      "record a.gif 61", "record a.gif 5 6"};
+  for (const std::string& line : bad) {
+    std::vector<AutomationCommand> commands;
+    std::string error;
+    EXPECT_FALSE(ParseAutomationBatch(line, commands, error)) << line;
+    EXPECT_FALSE(error.empty()) << line;
+  }
+
+  // Команды до ошибочной сохраняются
+  std::vector<AutomationCommand> commands;
+  std::string error;
+  EXPECT_FALSE(ParseAutomationBatch("ping; bogus; stats", commands, error));
+  EXPECT_EQ(commands.size(), 1u);
+  EXPECT_NE(error.find("bogus"), std::string::npos);
+}
+
+TEST(AutomationProtocolTest, ParsesCaptureScale) {
+  std::vector<AutomationCommand> commands;
+  std::string error;
+  ASSERT_TRUE(ParseAutomationBatch("@p capture /tmp/poster.jpg 4", commands,
+                                   error))
+      << error;
+  ASSERT_EQ(commands.size(), 1u);
+  EXPECT_EQ(commands[0].path, "/tmp/poster.jpg");
+  EXPECT_DOUBLE_EQ(commands[0].value, 4.0);
+}
+
+TEST(AutomationProtocolTest, ParsesRecordDuration) {
+  std::vector<AutomationCommand> commands;
+  std::string error;
+  ASSERT_TRUE(ParseAutomationBatch(
+      "record /tmp/a.gif; @r record /tmp/b.gif 2.5", commands, error))
+      << error;
+  ASSERT_EQ(commands.size(), 2u);
+  EXPECT_EQ(commands[0].type, kCommandRecord);
+  EXPECT_DOUBLE_EQ(commands[0].value, kDefaultRecordSeconds);
+  EXPECT_EQ(commands[1].id, "r");
+  EXPECT_EQ(commands[1].path, "/tmp/b.gif");
+  EXPECT_DOUBLE_EQ(commands[1].value, 2.5);
+}
+
+TEST(AutomationProtocolTest, FormatsReplies) {
+  EXPECT_EQ(FormatAutomationReply("", true, ""), "ok\n");
+  EXPECT_EQ(FormatAutomationReply("42", true, "640x480"), "@42 ok 640x480\n");
+  EXPECT_EQ(FormatAutomationReply("x", false, "bad\nline"),
+            "@x error bad line\n");
+}
+
+TEST(TransformCoalescerTest, MergesAdjacentSameAxis) {
+  TransformCoalescer coalescer;
+  for (int i = 0; i < 100; ++i) coalescer.Add(kRotate, 0.5, kY);
+  coalescer.Add(kMove, 0.25, kX);
+  coalescer.Add(kMove, 0.25, kX);
+  coalescer.Add(kScale, 2.0, kZ);
+  coalescer.Add(kScale, 1.5, kX);
+  EXPECT_EQ(coalescer.GetPendingCount(), 104u);
+
+  const std::vector<CoalescedTransform> transforms = coalescer.Take();
+  ASSERT_EQ(transforms.size(), 3u);
+  EXPECT_EQ(transforms[0].strategy, kRotate);
+  EXPECT_EQ(transforms[0].axis, kY);
+  EXPECT_DOUBLE_EQ(transforms[0].value, 50.0);
+  EXPECT_EQ(transforms[0].merged, 100u);
+  EXPECT_DOUBLE_EQ(transforms[1].value, 0.5);
+  EXPECT_EQ(transforms[2].strategy, kScale);
+  EXPECT_DOUBLE_EQ(transforms[2].value, 3.0);
+  EXPECT_EQ(coalescer.GetCoalescedCount(), 101u);
+  EXPECT_TRUE(coalescer.IsEmpty());
+  EXPECT_EQ(coalescer.GetPendingCount(), 0u);
+}
+
+TEST(TransformCoalescerTest, KeepsOrderAcrossTypes) {
+  // Перемещение и поворот не коммутируют: порядок сохраняется
+  TransformCoalescer coalescer;
+  coalescer.Add(kMove, 1.0, kX);
+  coalescer.Add(kRotate, 90.0, kZ);
+  coalescer.Add(kMove, 1.0, kX);
+  coalescer.Add(kMove, 1.0, kY);
+
+  const std::vector<CoalescedTransform> transforms = coalescer.Take();
+  ASSERT_EQ(transforms.size(), 4u);
+  EXPECT_EQ(transforms[1].strategy, kRotate);
+  EXPECT_EQ(transforms[2].axis, kX);
+  EXPECT_EQ(transforms[3].axis, kY);
+  EXPECT_EQ(coalescer.GetCoalescedCount(), 0u);
+}
+
+TEST(TransformCoalescerTest, DropsCancelledDeltas) {
+  TransformCoalescer coalescer;
+  coalescer.Add(kRotate, 10.0, kX);
+  coalescer.Add(kRotate, -10.0, kX);
+  coalescer.Add(kScale, 2.0, kX);
+  coalescer.Add(kScale, 0.5, kX);
+  coalescer.Add(kMove, 0.0005, kZ);
+
+  EXPECT_TRUE(coalescer.Take().empty());
+  EXPECT_EQ(coalescer.GetCoalescedCount(), 5u);
+}
@@ -0,0 +1,346 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "../cli/batch_runner.h"
+#include "../cli/batch_script.h"
+#include "../model/model.h"
+#include "../model/obj_parser.h"
+
+using namespace s21;
+
+class BatchTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    std::filesystem::create_directories(dir_);
+    for (int i = 0; i < 6; ++i) {
+      std::ofstream file(dir_ + "/model" + std::to_string(i) + ".obj");
+      file << "v 0 0 " << i << "\nv 1 0 0\nv 1 1 0\nv 1 0 0\n";
+      file << "f 1 2 3\nf 1 4 3\n";
+    }
+    std::ofstream(dir_ + "/notes.txt") << "not a model\n";
+  }
+
+  void TearDown() override {
+    std::filesystem::remove_all(dir_);
+    Model::GetInstance().SetFileName("");
+  }
+
+  std::string dir_ = "test_batch_dir";
+};
+
+TEST(BatchScriptTest, ParsesLineScript) {
+  std::vector<BatchOp> ops;
+  std::string error;
+  ASSERT_TRUE(ParseBatchScript(
+      "# normalize\nrotate y 30; move X -0.5\nscale 2\n"
+      "weld\nweld 1e-6\nstats\nload\nexport out/{name}.obj\n",
+      ops, error))
+      << error;
+  ASSERT_EQ(ops.size(), 8u);
+  EXPECT_EQ(ops[0].type, kOpRotate);
+  EXPECT_EQ(ops[0].axis, kY);
+  EXPECT_DOUBLE_EQ(ops[0].value, 30.0);
+  EXPECT_EQ(ops[1].axis, kX);
+  EXPECT_DOUBLE_EQ(ops[1].value, -0.5);
+  EXPECT_EQ(ops[2].type, kOpScale);
+  EXPECT_DOUBLE_EQ(ops[3].value, 0.0);
+  EXPECT_DOUBLE_EQ(ops[4].value, 1e-6);
+  EXPECT_EQ(ops[7].type, kOpExport);
+  EXPECT_EQ(ops[7].path, "out/{name}.obj");
+}
+
+TEST(BatchScriptTest, ParsesJsonScript) {
+  std::vector<BatchOp> ops;
+  std::string error;
+  ASSERT_TRUE(ParseBatchScript(
+      R"( [ {"op": "rotate", "axis": "z", "value": 90},
+            {"op": "scale", "value": "0.5"},
+            {"op": "export", "path": "out\/{name}.obj"} ] )",
+      ops, error))
+      << error;
+  ASSERT_EQ(ops.size(), 3u);
+  EXPECT_EQ(ops[0].axis, kZ);
+  EXPECT_DOUBLE_EQ(ops[0].value, 90.0);
+  EXPECT_DOUBLE_EQ(ops[1].value, 0.5);
+  EXPECT_EQ(ops[2].path, "out/{name}.obj");
+}
+
+TEST(BatchScriptTest, RejectsMalformedScripts) {
+  std::vector<BatchOp> ops;
+  std::string error;
+  EXPECT_FALSE(ParseBatchScript("stats\nrotate w 10\n", ops, error));
+  EXPECT_NE(error.find("line 2"), std::string::npos);
+  EXPECT_FALSE(ParseBatchScript("scale -1", ops, error));
+  EXPECT_FALSE(ParseBatchScript("stats now", ops, error));
+  EXPECT_FALSE(ParseBatchScript("explode", ops, error));
+  EXPECT_FALSE(ParseBatchScript("export", ops, error));
+  EXPECT_FALSE(ParseBatchScript("thumbnail", ops, error));
+  EXPECT_FALSE(ParseBatchScript("thumbnail a.png 0", ops, error));
+  EXPECT_FALSE(ParseBatchScript("thumbnail a.png 12.5", ops, error));
+  EXPECT_FALSE(ParseBatchScript("vector", ops, error));
+  EXPECT_FALSE(ParseBatchScript("vector a.svg 5000", ops, error));
+  EXPECT_FALSE(ParseBatchScript(R"([{"op": "move"}])", ops, error));
+  EXPECT_FALSE(ParseBatchScript(R"([{"op": "stats"})", ops, error));
+  EXPECT_TRUE(ParseBatchScript("", ops, error));
+  EXPECT_TRUE(ops.empty());
+}
+
+TEST(BatchRunnerTest, ExpandOutputPath_ReplacesName) {
+  EXPECT_EQ(BatchRunner::ExpandOutputPath("out/{name}_{name}.obj",
+                                          "in/dir/cube.obj"),
+            "out/cube_cube.obj");
+  EXPECT_EQ(BatchRunner::ExpandOutputPath("fixed.obj", "cube.obj"),
+            "fixed.obj");
+}
+
+TEST_F(BatchTest, CollectInputFiles_ExpandsDirectories) {
+  std::vector<std::string> files;
+  std::string error;
+  ASSERT_TRUE(BatchRunner::CollectInputFiles({dir_}, files, error));
+  ASSERT_EQ(files.size(), 6u);
+  EXPECT_EQ(std::filesystem::path(files[0]).filename(), "model0.obj");
+  EXPECT_FALSE(
+      BatchRunner::CollectInputFiles({dir_ + "/missing.obj"}, files, error));
+}
+
+TEST_F(BatchTest, Run_MatchesGuiPipeline) {
+  std::vector<BatchOp> ops;
+  std::string error;
+  ASSERT_TRUE(ParseBatchScript(
+      "rotate x 25; move z 0.5; weld; stats; export " + dir_ +
+          "/out/{name}.obj",
+      ops, error));
+
+  std::vector<std::string> files;
+  ASSERT_TRUE(BatchRunner::CollectInputFiles({dir_}, files, error));
+  BatchSummary summary;
+  const auto results = BatchRunner(ops).Run(files, 3, summary);
+
+  EXPECT_EQ(summary.files, 6u);
+  EXPECT_EQ(summary.failed, 0u);
+  EXPECT_EQ(summary.threads, 3u);
+  EXPECT_EQ(summary.vertices, 24u);
+  ASSERT_EQ(results.size(), files.size());
+
+  Model& model = Model::GetInstance();
+  for (const BatchFileResult& result : results) {
+    ASSERT_EQ(result.error, kNoError) << result.message;
+    EXPECT_EQ(result.welded, 1u);
+    ASSERT_EQ(result.stats.size(), 1u);
+    EXPECT_EQ(result.stats[0].vertex_count, 3u);
+    ASSERT_EQ(result.exported.size(), 1u);
+
+    // Тот же путь, что проходит GUI: Model + слайдеры
+    model.SetFileName(result.path);
+    model.Parser();
+    model.Transform(kRotate, 25.0, kX);
+    model.Transform(kMove, 0.5, kZ);
+    Mesh expected = model.GetMesh();
+    WeldVertices(expected);
+
+    Mesh exported;
+    ASSERT_EQ(ObjParser().Load(result.exported[0], exported), kNoError);
+    EXPECT_EQ(exported.vertex_coord, expected.vertex_coord);
+    EXPECT_EQ(exported.face_index, expected.face_index);
+  }
+
+  const std::string report = BatchRunner::FormatReport(results, summary);
+  EXPECT_NE(report.find("6 files (0 failed)"), std::string::npos);
+  EXPECT_NE(report.find("stats: vertices 3"), std::string::npos);
+}
+
+TEST_F(BatchTest, Run_WritesThumbnails) {
+  std::vector<BatchOp> ops;
+  std::string error;
+  ASSERT_TRUE(ParseBatchScript("thumbnail " + dir_ + "/thumbs/{name}.png 64",
+                               ops, error))
+      << error;
+  ASSERT_EQ(ops.size(), 1u);
+  EXPECT_EQ(ops[0].type, kOpThumbnail);
+  EXPECT_DOUBLE_EQ(ops[0].value, 64.0);
+
+  BatchSummary summary;
+  const auto results =
+      BatchRunner(ops).Run({dir_ + "/model0.obj", dir_ + "/model1.obj"}, 2,
+                           summary);
+  EXPECT_EQ(summary.failed, 0u);
+  for (const BatchFileResult& result : results) {
+    ASSERT_EQ(result.thumbnails.size(), 1u) << result.message;
+    std::ifstream png(result.thumbnails[0], std::ios::binary);
+    std::string signature(8, '\0');
+    ASSERT_TRUE(png.read(&signature[0], 8));
+    EXPECT_EQ(signature, "\x89PNG\r\n\x1a\n");
+  }
+  EXPECT_NE(BatchRunner::FormatReport(results, summary).find("thumbnail: "),
+            std::string::npos);
+
+  std::vector<BatchOp> defaults;
+  ASSERT_TRUE(ParseBatchScript("thumbnail t.png", defaults, error));
+  EXPECT_DOUBLE_EQ(defaults[0].value, kDefaultThumbnailSize);
+}
+
+TEST_F(BatchTest, Run_WritesVectorDrawings) {
+  std::vector<BatchOp> ops;
+  std::string error;
+  ASSERT_TRUE(ParseBatchScript("vector " + dir_ + "/{name}.svg; vector " +
+                                   dir_ + "/{name}.pdf 300",
+                               ops, error))
+      << error;
+  ASSERT_EQ(ops.size(), 2u);
+  EXPECT_EQ(ops[0].type, kOpVector);
+  EXPECT_DOUBLE_EQ(ops[0].value, kDefaultVectorSize);
+  EXPECT_DOUBLE_EQ(ops[1].value, 300.0);
+
+  BatchSummary summary;
+  const auto results = BatchRunner(ops).Run({dir_ + "/model0.obj"}, 1,
+                                            summary);
+  ASSERT_EQ(results[0].drawings.size(), 2u) << results[0].message;
+  std::ifstream svg(results[0].drawings[0]);
+  std::string text((std::istreambuf_iterator<char>(svg)),
+                   std::istreambuf_iterator<char>());
+  EXPECT_NE(text.find("<svg"), std::string::npos);
+  std::ifstream pdf(results[0].drawings[1], std::ios::binary);
+  std::string signature(5, '\0');
+  ASSERT_TRUE(pdf.read(&signature[0], 5));
+  EXPECT_EQ(signature, "%PDF-");
+  EXPECT_NE(BatchRunner::FormatReport(results, summary).find("vector: "),
+            std::string::npos);
+}
+
+TEST_F(BatchTest, Run_WritesSections) {
+  std::vector<BatchOp> ops;
+  std::string error;
+  ASSERT_TRUE(ParseBatchScript("section x " + dir_ + "/{name}_x.obj 0.5",
+                               ops, error))
+      << error;
+  ASSERT_EQ(ops.size(), 1u);
+  EXPECT_EQ(ops[0].type, kOpSection);
+  EXPECT_EQ(ops[0].axis, kX);
+  EXPECT_DOUBLE_EQ(ops[0].value, 0.5);
+
+  BatchSummary summary;
+  const auto results = BatchRunner(ops).Run({dir_ + "/model0.obj"}, 1,
+                                            summary);
+  ASSERT_EQ(results[0].sections.size(), 1u) << results[0].message;
+  // Два треугольника квадрата x, y in [0, 1]: один открытый контур
+  EXPECT_EQ(results[0].sections[0].contours, 1u);
+  EXPECT_EQ(results[0].sections[0].points, 3u);
+  std::ifstream obj(results[0].sections[0].path);
+  std::string text((std::istreambuf_iterator<char>(obj)),
+                   std::istreambuf_iterator<char>());
+  EXPECT_NE(text.find("\nl 1 2 3\n"), std::string::npos) << text;
+  EXPECT_NE(BatchRunner::FormatReport(results, summary).find("section: "),
+            std::string::npos);
+
+  EXPECT_FALSE(ParseBatchScript("section", ops, error));
+  EXPECT_FALSE(ParseBatchScript("section z", ops, error));
+  EXPECT_FALSE(ParseBatchScript("section z a.obj high", ops, error));
+  ASSERT_TRUE(ParseBatchScript(R"([{"op": "section", "axis": "y", )"
+                               R"("path": "s.obj"}])",
+                               ops, error))
+      << error;
+  EXPECT_DOUBLE_EQ(ops[0].value, 0.0);
+}
+
+TEST_F(BatchTest, Run_ReportsTopology) {
+  std::vector<BatchOp> ops;
+  std::string error;
+  ASSERT_TRUE(ParseBatchScript("topology; weld; topology", ops, error))
+      << error;
+  ASSERT_EQ(ops.size(), 3u);
+  EXPECT_EQ(ops[0].type, kOpTopology);
+  EXPECT_FALSE(ParseBatchScript("topology 1", ops, error));
+  ASSERT_TRUE(ParseBatchScript("topology; weld; topology", ops, error));
+
+  BatchSummary summary;
+  const auto results = BatchRunner(ops).Run({dir_ + "/model1.obj"}, 1,
+                                            summary);
+  ASSERT_EQ(results[0].topology.size(), 2u) << results[0].message;
+  // Квадрат из двух треугольников, вершины 2 и 4 совпадают, но не сварены
+  const TopologyStats& before = results[0].topology[0];
+  EXPECT_EQ(before.component_count, 1u);
+  EXPECT_EQ(before.edge_count, 5u);
+  EXPECT_EQ(before.boundary_edge_count, 4u);
+  EXPECT_FALSE(before.IsClosed());
+  // После сварки треугольники совпадают: двусторонняя, но замкнутая
+  // поверхность, все рёбра обходятся в одну сторону
+  const TopologyStats& after = results[0].topology[1];
+  EXPECT_EQ(after.edge_count, 3u);
+  EXPECT_EQ(after.flipped_edge_count, 3u);
+  EXPECT_TRUE(after.IsClosed());
+  const std::string report = BatchRunner::FormatReport(results, summary);
+  EXPECT_NE(report.find("topology: shells 1, edges 5, boundary 4"),
+            std::string::npos)
+      << report;
+  EXPECT_NE(report.find("flipped 3, closed"), std::string::npos) << report;
+}
+
+TEST_F(BatchTest, Run_ReportsDeviationFromReference) {
+  std::vector<BatchOp> ops;
+  std::string error;
+  EXPECT_FALSE(ParseBatchScript("deviation", ops, error));
+  EXPECT_NE(error.find("expected reference path"), std::string::npos);
+  ASSERT_TRUE(
+      ParseBatchScript("deviation " + dir_ + "/model0.obj", ops, error))
+      << error;
+  EXPECT_EQ(ops[0].type, kOpDeviation);
+
+  BatchSummary summary;
+  auto results = BatchRunner(ops).Run({dir_ + "/model1.obj"}, 1, summary);
+  ASSERT_EQ(results[0].deviations.size(), 1u) << results[0].message;
+  // Первая вершина поднята на 1 над плоскостью эталона, остальные на ней
+  const BatchDeviation& deviation = results[0].deviations[0];
+  EXPECT_NEAR(deviation.stats.max, 1.0, 1e-6);
+  EXPECT_EQ(deviation.stats.max_vertex, 0u);
+  EXPECT_NEAR(deviation.stats.mean, 0.25, 1e-6);
+  EXPECT_NEAR(deviation.stats.rms, 0.5, 1e-6);
+  EXPECT_NEAR(deviation.hausdorff, 1.0, 1e-6);
+  const std::string report = BatchRunner::FormatReport(results, summary);
+  EXPECT_NE(report.find("max 1 (vertex 1), mean 0.25, rms 0.5, hausdorff 1"),
+            std::string::npos)
+      << report;
+
+  ASSERT_TRUE(ParseBatchScript("deviation missing.obj", ops, error));
+  results = BatchRunner(ops).Run({dir_ + "/model1.obj"}, 1, summary);
+  EXPECT_EQ(results[0].error, kFailedToOpen);
+  EXPECT_EQ(results[0].message, "deviation missing.obj: failed to open");
+}
+
+TEST_F(BatchTest, Run_ReportsFailedFiles) {
+  BatchSummary summary;
+  const auto results = BatchRunner({}).Run(
+      {dir_ + "/model0.obj", dir_ + "/notes.txt", dir_ + "/gone.obj"}, 0,
+      summary);
+  EXPECT_EQ(summary.failed, 2u);
+  EXPECT_EQ(results[0].error, kNoError);
+  EXPECT_EQ(results[1].error, kFileWrongExtension);
+  EXPECT_EQ(results[2].error, kFailedToOpen);
+  EXPECT_EQ(results[2].message, "failed to open");
+}
+
+TEST_F(BatchTest, Run_LocatesParseErrorsAndSkipsInLenientMode) {
+  const std::string path = dir_ + "/broken.obj";
+  std::ofstream(path) << "v 0 0 0\nv 1 0 0\nv 1 1 0\nf 1 2 3\n"
+                      << "v 2 x 0\nf 1 2 7/1\n";
+  BatchSummary summary;
+  BatchRunner runner({});
+  auto results = runner.Run({path}, 1, summary);
+  EXPECT_EQ(results[0].error, kIncorrectData);
+  EXPECT_EQ(results[0].message,
+            "line 5, column 5, token \"x\": incorrect data");
+
+  runner.SetLenient(true);
+  results = runner.Run({path}, 1, summary);
+  EXPECT_EQ(summary.failed, 0u);
+  EXPECT_EQ(results[0].vertex_count, 3u);
+  EXPECT_EQ(results[0].skipped_lines, 2u);
+  EXPECT_NE(BatchRunner::FormatReport(results, summary)
+                .find("lenient: 2 bad lines skipped, first at line 5"),
+            std::string::npos);
+}
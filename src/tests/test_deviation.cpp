@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "../model/deviation.h"
+#include "test_meshes.h"
+
+using namespace s21;
+using s21::test::MakeSphere;
+
+namespace {
+
+/**
+ * @brief Квадрат [0, side] x [0, side] в плоскости z = 0 из квадов
+ */
+Mesh MakePlate(int side) {
+  Mesh mesh;
+  for (int y = 0; y <= side; ++y) {
+    for (int x = 0; x <= side; ++x) {
+      mesh.vertex_coord.insert(mesh.vertex_coord.end(),
+                               {double(x), double(y), 0.0});
+    }
+  }
+  for (int y = 0; y < side; ++y) {
+    for (int x = 0; x < side; ++x) {
+      const int a = y * (side + 1) + x;
+      mesh.face_index.insert(mesh.face_index.end(),
+                             {a, a + 1, a + side + 2, a + side + 1});
+      mesh.face_offset.push_back(static_cast<int>(mesh.face_index.size()));
+    }
+  }
+  return mesh;
+}
+
+}  // namespace
+
+TEST(DeviationTest, DistanceToPlateMatchesGeometry) {
+  const int side = 40;
+  Deviation deviation(3);
+  deviation.Build(MakePlate(side));
+  EXPECT_EQ(deviation.GetTriangleCount(), size_t(2 * side * side));
+
+  // Точки над квадратом и вокруг него: расстояние до прямоугольника
+  std::mt19937 random(7);
+  std::uniform_real_distribution<double> coordinate(-10.0, side + 10.0);
+  std::vector<double> points;
+  for (int i = 0; i < 20000; ++i) {
+    points.insert(points.end(), {coordinate(random), coordinate(random),
+                                 coordinate(random) - side / 2.0});
+  }
+  std::vector<float> distance;
+  const DeviationStats stats = deviation.Measure(points, distance);
+  ASSERT_EQ(distance.size(), points.size() / 3);
+  EXPECT_EQ(stats.vertex_count, distance.size());
+  double max = 0.0;
+  for (size_t i = 0; i < distance.size(); ++i) {
+    const double* p = &points[i * 3];
+    const double dx = std::max({0.0 - p[0], 0.0, p[0] - side});
+    const double dy = std::max({0.0 - p[1], 0.0, p[1] - side});
+    const double expected = std::sqrt(dx * dx + dy * dy + p[2] * p[2]);
+    ASSERT_NEAR(distance[i], expected, 1e-4) << i;
+    max = std::max(max, expected);
+  }
+  EXPECT_NEAR(stats.max, max, 1e-4);
+  EXPECT_NEAR(distance[stats.max_vertex], max, 1e-4);
+  EXPECT_GT(stats.rms, stats.mean);
+}
+
+TEST(DeviationTest, ScaledSphereHasUniformDeviation) {
+  const Mesh reference = MakeSphere(48, 64, 1.0, true);
+  Mesh scaled = reference;
+  for (double& value : scaled.vertex_coord) value *= 1.05;
+  Deviation deviation(2);
+  deviation.Build(reference);
+  std::vector<float> distance;
+  const DeviationStats stats = deviation.Measure(scaled.vertex_coord, distance);
+  // Эталон внутри единичного шара, его вершина на том же луче
+  for (float d : distance) ASSERT_NEAR(d, 0.05, 1e-6);
+  EXPECT_NEAR(stats.max, 0.05, 1e-6);
+  EXPECT_NEAR(stats.mean, 0.05, 1e-6);
+  EXPECT_NEAR(stats.rms, 0.05, 1e-6);
+
+  // Своя же поверхность: отклонения нет
+  deviation.Measure(reference.vertex_coord, distance);
+  for (float d : distance) ASSERT_LT(d, 1e-6);
+}
+
+TEST(DeviationTest, ResultDoesNotDependOnThreads) {
+  const Mesh reference = MakeSphere(80, 120, 1.0, true);
+  Mesh model = MakeSphere(60, 90, 1.0, true);
+  std::mt19937 random(3);
+  std::normal_distribution<double> noise(0.0, 0.01);
+  for (double& value : model.vertex_coord) value += noise(random);
+
+  Deviation single(1), parallel(4);
+  single.Build(reference);
+  parallel.Build(reference);
+  std::vector<float> one, many;
+  const DeviationStats a = single.Measure(model.vertex_coord, one);
+  const DeviationStats b = parallel.Measure(model.vertex_coord, many);
+  EXPECT_EQ(one, many);
+  EXPECT_EQ(std::memcmp(&a, &b, sizeof(DeviationStats)), 0);
+  EXPECT_GT(a.max, 0.01);
+  EXPECT_LT(a.max, 0.1);
+}
+
+TEST(DeviationTest, EmptyReferenceAndInvalidFaces) {
+  Deviation deviation;
+  deviation.Build(Mesh());
+  std::vector<float> distance;
+  const DeviationStats stats =
+      deviation.Measure({0.0, 0.0, 0.0, 1.0, 1.0, 1.0}, distance);
+  EXPECT_EQ(stats.vertex_count, 0u);
+  ASSERT_EQ(distance.size(), 2u);
+  EXPECT_TRUE(std::isnan(distance[0]));
+
+  // Грань с индексом вне диапазона и отрезок пропускаются
+  Mesh mesh;
+  mesh.vertex_coord = {0, 0, 0, 1, 0, 0, 0, 1, 0};
+  mesh.face_index = {0, 1, 2, 0, 1, 7, 0, 1};
+  mesh.face_offset = {0, 3, 6, 8};
+  deviation.Build(mesh);
+  EXPECT_EQ(deviation.GetTriangleCount(), 1u);
+  deviation.Measure({0.25, 0.25, 2.0}, distance);
+  EXPECT_NEAR(distance[0], 2.0, 1e-6);
+}
+
+TEST(DeviationTest, HeatMapRunsBlueGreenRed) {
+  std::vector<float> rgb;
+  MakeHeatMap({0.0f, 0.5f, 1.0f, 3.0f, NAN}, 1.0, rgb, 2);
+  ASSERT_EQ(rgb.size(), 15u);
+  EXPECT_EQ(std::vector<float>(rgb.begin(), rgb.begin() + 3),
+            (std::vector<float>{0.0f, 0.0f, 1.0f}));
+  EXPECT_EQ(std::vector<float>(rgb.begin() + 3, rgb.begin() + 6),
+            (std::vector<float>{0.0f, 1.0f, 0.0f}));
+  EXPECT_EQ(std::vector<float>(rgb.begin() + 6, rgb.begin() + 9),
+            (std::vector<float>{1.0f, 0.0f, 0.0f}));
+  EXPECT_EQ(std::vector<float>(rgb.begin() + 9, rgb.begin() + 12),
+            (std::vector<float>{1.0f, 0.0f, 0.0f}));
+  EXPECT_EQ(std::vector<float>(rgb.begin() + 12, rgb.end()),
+            (std::vector<float>{0.5f, 0.5f, 0.5f}));
+}
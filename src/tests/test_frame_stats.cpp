@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+
+#include "../profiling/frame_stats.h"
+
+using namespace s21;
+
+TEST(FrameStatsTest, Empty_ZeroValues) {
+  FrameStats stats;
+
+  EXPECT_EQ(stats.GetHistorySize(), 0u);
+  EXPECT_DOUBLE_EQ(stats.GetFps(), 0.0);
+  EXPECT_DOUBLE_EQ(stats.GetCpuMs(), 0.0);
+  EXPECT_LT(stats.GetGpuMs(), 0.0);
+}
+
+TEST(FrameStatsTest, SteadyFrames_FpsMatchesInterval) {
+  FrameStats stats;
+  for (int i = 0; i < 100; ++i) {
+    stats.AddFrame(i * 10.0, 2.0);
+  }
+
+  EXPECT_NEAR(stats.GetFps(), 100.0, 1e-9);
+  EXPECT_DOUBLE_EQ(stats.GetCpuMs(), 2.0);
+}
+
+TEST(FrameStatsTest, History_WrapsAndKeepsOrder) {
+  FrameStats stats;
+  const size_t total = FrameStats::kHistorySize + 5;
+  for (size_t i = 0; i < total; ++i) {
+    stats.AddFrame(static_cast<double>(i), static_cast<double>(i));
+  }
+
+  ASSERT_EQ(stats.GetHistorySize(), FrameStats::kHistorySize);
+  EXPECT_DOUBLE_EQ(stats.GetCpuMsAt(0), 5.0);
+  EXPECT_DOUBLE_EQ(stats.GetCpuMsAt(FrameStats::kHistorySize - 1),
+                   static_cast<double>(total - 1));
+  EXPECT_DOUBLE_EQ(stats.GetMaxCpuMs(), static_cast<double>(total - 1));
+}
+
+TEST(FrameStatsTest, Fps_OnlyLastSecondCounted) {
+  FrameStats stats;
+  // Медленные кадры в прошлом не должны занижать текущий FPS
+  for (int i = 0; i < 5; ++i) stats.AddFrame(i * 500.0, 1.0);
+  for (int i = 1; i <= 50; ++i) stats.AddFrame(2000.0 + i * 20.0, 1.0);
+
+  EXPECT_NEAR(stats.GetFps(), 50.0, 1e-9);
+}
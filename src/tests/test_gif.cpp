@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "../render/gif_encoder.h"
+
+using namespace s21;
+
+namespace {
+
+/**
+ * @brief Декодер LZW GIF по спецификации (независимо от кодировщика)
+ */
+std::vector<uint8_t> DecodeLzw(const std::string& data, int min_code_size) {
+  const int clear_code = 1 << min_code_size;
+  const int end_code = clear_code + 1;
+  std::vector<std::vector<uint8_t>> table;
+  auto reset = [&] {
+    table.assign(end_code + 1, {});
+    for (int i = 0; i < clear_code; ++i) table[i] = {uint8_t(i)};
+  };
+  reset();
+  int code_size = min_code_size + 1;
+  size_t bit = 0;
+  auto read = [&]() -> int {
+    int code = 0;
+    for (int i = 0; i < code_size; ++i, ++bit) {
+      if (bit / 8 >= data.size()) return -1;
+      code |= (static_cast<uint8_t>(data[bit / 8]) >> bit % 8 & 1) << i;
+    }
+    return code;
+  };
+
+  std::vector<uint8_t> out;
+  int previous = -1;
+  for (int code = read(); code >= 0 && code != end_code; code = read()) {
+    if (code == clear_code) {
+      reset();
+      code_size = min_code_size + 1;
+      previous = -1;
+      continue;
+    }
+    std::vector<uint8_t> entry;
+    if (code < static_cast<int>(table.size())) {
+      entry = table[code];
+    } else {
+      entry = table[previous];
+      entry.push_back(table[previous][0]);
+    }
+    out.insert(out.end(), entry.begin(), entry.end());
+    if (previous >= 0 && table.size() < 4096) {
+      std::vector<uint8_t> added = table[previous];
+      added.push_back(entry[0]);
+      table.push_back(added);
+      if (table.size() == (1u << code_size) && code_size < 12) ++code_size;
+    }
+    previous = code;
+  }
+  return out;
+}
+
+int Le16(const std::string& gif, size_t offset) {
+  return static_cast<uint8_t>(gif[offset]) |
+         static_cast<uint8_t>(gif[offset + 1]) << 8;
+}
+
+/**
+ * @brief Разобранный GIF: палитра и кадры в виде цветов RGBA
+ */
+struct DecodedGif {
+  int width = 0, height = 0, delay = -1;
+  std::vector<uint8_t> palette;
+  std::vector<std::vector<uint32_t>> frames;
+};
+
+DecodedGif DecodeGif(const std::string& gif) {
+  DecodedGif result;
+  EXPECT_EQ(gif.substr(0, 6), "GIF89a");
+  result.width = Le16(gif, 6);
+  result.height = Le16(gif, 8);
+  const uint8_t flags = gif[10];
+  EXPECT_TRUE(flags & 0x80);
+  const size_t palette_size = 3u << ((flags & 7) + 1);
+  result.palette.assign(gif.begin() + 13, gif.begin() + 13 + palette_size);
+  size_t pos = 13 + palette_size;
+  while (pos < gif.size() && gif[pos] != '\x3B') {
+    if (gif[pos] == '\x21') {
+      if (gif[pos + 1] == '\xF9') result.delay = Le16(gif, pos + 4);
+      pos += 2;
+      while (gif[pos] != '\0') pos += static_cast<uint8_t>(gif[pos]) + 1;
+      ++pos;
+      continue;
+    }
+    EXPECT_EQ(gif[pos], '\x2C');
+    EXPECT_EQ(Le16(gif, pos + 5), result.width);
+    EXPECT_EQ(Le16(gif, pos + 7), result.height);
+    const int min_code_size = gif[pos + 10];
+    pos += 11;
+    std::string data;
+    while (gif[pos] != '\0') {
+      const size_t size = static_cast<uint8_t>(gif[pos]);
+      data.append(gif, pos + 1, size);
+      pos += size + 1;
+    }
+    ++pos;
+    std::vector<uint32_t> frame;
+    for (uint8_t index : DecodeLzw(data, min_code_size)) {
+      frame.push_back(MakeColor(result.palette[index * 3],
+                                result.palette[index * 3 + 1],
+                                result.palette[index * 3 + 2]));
+    }
+    result.frames.push_back(frame);
+  }
+  EXPECT_LT(pos, gif.size());
+  return result;
+}
+
+}  // namespace
+
+TEST(GifTest, LzwRoundTripsAcrossDictionaryResets) {
+  // Шум переполняет словарь (код очистки), длинные серии - нет
+  std::vector<uint8_t> indices;
+  uint32_t state = 12345;
+  for (int i = 0; i < 40000; ++i) {
+    state = state * 1103515245u + 12345u;
+    indices.push_back(static_cast<uint8_t>(state >> 16 & 0x0F));
+  }
+  indices.insert(indices.end(), 20000, 3);
+  for (int min_code_size : {4, 8}) {
+    const std::string data =
+        EncodeLzw(indices.data(), indices.size(), min_code_size);
+    EXPECT_EQ(DecodeLzw(data, min_code_size), indices);
+  }
+  const uint8_t single = 1;
+  EXPECT_EQ(DecodeLzw(EncodeLzw(&single, 1, 2), 2),
+            std::vector<uint8_t>{1});
+}
+
+TEST(GifTest, EncodesFramesWithSharedExactPalette) {
+  const uint32_t background = MakeColor(26, 26, 26);
+  const uint32_t line = MakeColor(255, 255, 255);
+  const uint32_t accent = MakeColor(200, 40, 90);
+  GifEncoder encoder(2);
+  std::vector<Image> frames(3);
+  for (int f = 0; f < 3; ++f) {
+    frames[f].Reset(37, 21, background);
+    for (int x = 0; x < 37; ++x) frames[f].pixels[(f * 5) * 37 + x] = line;
+    frames[f].pixels[f] = accent;
+    ASSERT_TRUE(encoder.AddFrame(frames[f]));
+  }
+  Image other;
+  other.Reset(10, 10, background);
+  EXPECT_FALSE(encoder.AddFrame(other));
+
+  GifStats stats;
+  const DecodedGif gif = DecodeGif(encoder.Encode(10, &stats));
+  EXPECT_EQ(stats.frames, 3u);
+  EXPECT_EQ(stats.colors, 3);
+  EXPECT_EQ(gif.width, 37);
+  EXPECT_EQ(gif.height, 21);
+  EXPECT_EQ(gif.delay, 10);
+  ASSERT_EQ(gif.frames.size(), 3u);
+  for (int f = 0; f < 3; ++f) EXPECT_EQ(gif.frames[f], frames[f].pixels);
+}
+
+TEST(GifTest, LimitsPaletteAndStaysCloseToSource) {
+  // Градиент из 64 x 64 различных цветов не помещается в 256
+  Image frame;
+  frame.Reset(64, 64, 0);
+  for (int y = 0; y < 64; ++y) {
+    for (int x = 0; x < 64; ++x) {
+      frame.pixels[y * 64 + x] = MakeColor(x * 4, y * 4, 128);
+    }
+  }
+  GifEncoder encoder(1);
+  ASSERT_TRUE(encoder.AddFrame(frame));
+  GifStats stats;
+  const DecodedGif gif = DecodeGif(encoder.Encode(5, &stats));
+  EXPECT_EQ(stats.colors, GifEncoder::kMaxColors);
+  ASSERT_EQ(gif.frames.size(), 1u);
+  for (size_t i = 0; i < frame.pixels.size(); ++i) {
+    for (int shift : {0, 8, 16}) {
+      const int source = frame.pixels[i] >> shift & 0xFF;
+      const int decoded = gif.frames[0][i] >> shift & 0xFF;
+      EXPECT_LE(std::abs(source - decoded), 16) << i;
+    }
+  }
+
+  encoder.Clear();
+  EXPECT_EQ(encoder.GetFrameCount(), 0u);
+  EXPECT_TRUE(encoder.Encode(10).empty());
+}
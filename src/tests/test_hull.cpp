@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "../model/hull.h"
+#include "../render/camera.h"
+
+using namespace s21;
+
+namespace {
+
+/**
+ * @brief Поворот точек: вокруг Z на yaw, затем вокруг X на pitch
+ */
+void Rotate(std::vector<double>& coord, double yaw, double pitch) {
+  for (size_t i = 0; i < coord.size(); i += 3) {
+    const double x = coord[i] * std::cos(yaw) - coord[i + 1] * std::sin(yaw);
+    const double y = coord[i] * std::sin(yaw) + coord[i + 1] * std::cos(yaw);
+    const double z = coord[i + 2];
+    coord[i] = x;
+    coord[i + 1] = y * std::cos(pitch) - z * std::sin(pitch);
+    coord[i + 2] = y * std::sin(pitch) + z * std::cos(pitch);
+  }
+}
+
+/**
+ * @brief Наибольшее расстояние точки над плоскостью грани оболочки
+ */
+double MaxOutside(const ConvexHull& hull, const std::vector<double>& coord) {
+  double worst = -1.0;
+  for (size_t t = 0; t < hull.GetTriangleCount(); ++t) {
+    const double* a = &hull.vertex_coord[hull.triangles[t * 3] * 3];
+    const double* b = &hull.vertex_coord[hull.triangles[t * 3 + 1] * 3];
+    const double* c = &hull.vertex_coord[hull.triangles[t * 3 + 2] * 3];
+    const double u[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+    const double v[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+    double n[3] = {u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2],
+                   u[0] * v[1] - u[1] * v[0]};
+    const double length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+    for (size_t i = 0; i < coord.size(); i += 3) {
+      const double d = ((coord[i] - a[0]) * n[0] +
+                        (coord[i + 1] - a[1]) * n[1] +
+                        (coord[i + 2] - a[2]) * n[2]) /
+                       length;
+      worst = std::max(worst, d);
+    }
+  }
+  return worst;
+}
+
+/**
+ * @brief Точки на поверхности box 2 * half и внутри него
+ */
+std::vector<double> MakeBoxCloud(const double half[3], int count) {
+  std::mt19937 random(11);
+  std::uniform_real_distribution<double> unit(-1.0, 1.0);
+  std::vector<double> coord;
+  for (int corner = 0; corner < 8; ++corner) {
+    for (int k = 0; k < 3; ++k) {
+      coord.push_back((corner >> k & 1 ? 1.0 : -1.0) * half[k]);
+    }
+  }
+  for (int i = 0; i < count; ++i) {
+    for (int k = 0; k < 3; ++k) coord.push_back(unit(random) * half[k]);
+  }
+  return coord;
+}
+
+}  // namespace
+
+TEST(HullTest, CubeWithInteriorPoints) {
+  const double half[3] = {1.0, 1.0, 1.0};
+  const std::vector<double> coord = MakeBoxCloud(half, 5000);
+  const ConvexHull hull = ComputeConvexHull(coord, 3);
+  // Грани куба - по два треугольника, внутренние точки отброшены
+  EXPECT_EQ(hull.GetVertexCount(), 8u);
+  EXPECT_EQ(hull.GetTriangleCount(), 12u);
+  EXPECT_NEAR(hull.volume, 8.0, 1e-9);
+  EXPECT_NEAR(hull.area, 24.0, 1e-9);
+  EXPECT_LT(MaxOutside(hull, coord), 1e-9);
+}
+
+TEST(HullTest, RandomCloudIsEnclosedAndIndependentOfThreads) {
+  std::mt19937 random(5);
+  std::normal_distribution<double> normal(0.0, 1.0);
+  std::vector<double> coord;
+  for (int i = 0; i < 8000; ++i) {
+    double p[3] = {normal(random), normal(random), normal(random)};
+    const double length = std::sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+    // Половина точек на сфере, половина внутри
+    const double radius = i % 2 ? 1.0 : 0.5;
+    for (double value : p) coord.push_back(value / length * radius * 3.0);
+  }
+  const ConvexHull single = ComputeConvexHull(coord, 1);
+  const ConvexHull parallel = ComputeConvexHull(coord, 4);
+  EXPECT_EQ(single.vertex_coord, parallel.vertex_coord);
+  EXPECT_EQ(single.triangles, parallel.triangles);
+
+  // Замкнутая триангулированная сфера: F = 2V - 4
+  EXPECT_EQ(single.GetTriangleCount(), 2 * single.GetVertexCount() - 4);
+  EXPECT_LE(single.GetVertexCount(), 4000u);
+  EXPECT_LT(MaxOutside(single, coord), 1e-9);
+  const double pi = 3.141592653589793;
+  EXPECT_NEAR(single.volume, 4.0 / 3.0 * pi * 27.0, 0.5);
+  EXPECT_GT(single.volume, 0.0);
+}
+
+TEST(HullTest, OrientedBoxFindsRotatedBox) {
+  const double half[3] = {4.0, 1.5, 0.5};
+  std::vector<double> coord = MakeBoxCloud(half, 2000);
+  Rotate(coord, 0.6, 0.9);
+  for (size_t i = 0; i < coord.size(); i += 3) coord[i] += 10.0;
+
+  const ConvexHull hull = ComputeConvexHull(coord, 2);
+  const OrientedBox box = ComputeOrientedBox(hull, 2);
+  for (int k = 0; k < 3; ++k) EXPECT_NEAR(box.half[k], half[k], 1e-9);
+  EXPECT_NEAR(box.center[0], 10.0, 1e-9);
+  EXPECT_NEAR(box.center[1], 0.0, 1e-9);
+  EXPECT_NEAR(box.center[2], 0.0, 1e-9);
+  EXPECT_NEAR(box.GetVolume(), 8.0 * 4.0 * 1.5 * 0.5, 1e-8);
+
+  // Длинная ось - повёрнутая X
+  std::vector<double> x = {1.0, 0.0, 0.0};
+  Rotate(x, 0.6, 0.9);
+  const double along =
+      box.axis[0][0] * x[0] + box.axis[0][1] * x[1] + box.axis[0][2] * x[2];
+  EXPECT_NEAR(std::abs(along), 1.0, 1e-9);
+  // Правая тройка
+  const double* a = box.axis[0];
+  const double* b = box.axis[1];
+  const double cross_z = a[0] * b[1] - a[1] * b[0];
+  EXPECT_NEAR(cross_z, box.axis[2][2], 1e-12);
+
+  // Все точки внутри box
+  for (size_t i = 0; i < coord.size(); i += 3) {
+    for (int k = 0; k < 3; ++k) {
+      double d = 0.0;
+      for (int j = 0; j < 3; ++j) {
+        d += (coord[i + j] - box.center[j]) * box.axis[k][j];
+      }
+      ASSERT_LE(std::abs(d), box.half[k] + 1e-9);
+    }
+  }
+}
+
+TEST(HullTest, FlatAndDegenerateClouds) {
+  // Прямоугольник 6 x 2 из точек сетки в наклонной плоскости
+  std::vector<double> plate;
+  for (int y = 0; y <= 4; ++y) {
+    for (int x = 0; x <= 12; ++x) {
+      plate.insert(plate.end(), {x * 0.5, y * 0.5, 0.0});
+    }
+  }
+  Rotate(plate, 0.3, 1.1);
+  const ConvexHull flat = ComputeConvexHull(plate, 2);
+  EXPECT_EQ(flat.GetTriangleCount(), 0u);
+  EXPECT_EQ(flat.GetVertexCount(), 4u);
+  EXPECT_NEAR(flat.area, 12.0, 1e-9);
+  EXPECT_EQ(flat.volume, 0.0);
+  const OrientedBox box = ComputeOrientedBox(flat);
+  EXPECT_NEAR(box.half[0], 3.0, 1e-9);
+  EXPECT_NEAR(box.half[1], 1.0, 1e-9);
+  EXPECT_NEAR(box.half[2], 0.0, 1e-9);
+
+  const ConvexHull line = ComputeConvexHull({0, 0, 0, 1, 1, 1, 3, 3, 3});
+  EXPECT_EQ(line.vertex_coord, (std::vector<double>{0, 0, 0, 3, 3, 3}));
+  EXPECT_NEAR(ComputeOrientedBox(line).half[0], std::sqrt(27.0) / 2, 1e-9);
+
+  const ConvexHull point = ComputeConvexHull({2, 2, 2, 2, 2, 2});
+  EXPECT_EQ(point.vertex_coord, (std::vector<double>{2, 2, 2}));
+  EXPECT_EQ(ComputeOrientedBox(point).center[1], 2.0);
+  EXPECT_EQ(ComputeConvexHull({}).GetVertexCount(), 0u);
+  EXPECT_EQ(ComputeOrientedBox(ConvexHull()).GetVolume(), 0.0);
+}
+
+TEST(HullTest, FitCameraFramesBoxAlongLongAxis) {
+  const double half[3] = {4.0, 1.5, 0.5};
+  std::vector<double> coord = MakeBoxCloud(half, 0);
+  Rotate(coord, -0.7, 0.4);
+  for (size_t i = 0; i < coord.size(); i += 3) coord[i + 2] += 3.0;
+  const OrientedBox box = ComputeOrientedBox(ComputeConvexHull(coord));
+  const Camera camera = FitCameraToBox(box, 0.9);
+  const Matrix4 m = camera.BuildMatrix(100, 100);
+  // Углы box: по X ровно до края поля, по Y - пропорционально
+  double extent[3] = {0.0, 0.0, 0.0};
+  for (size_t i = 0; i < coord.size(); i += 3) {
+    for (int row = 0; row < 3; ++row) {
+      const double value = m[row] * coord[i] + m[4 + row] * coord[i + 1] +
+                           m[8 + row] * coord[i + 2] + m[12 + row];
+      extent[row] = std::max(extent[row], std::abs(value));
+    }
+  }
+  EXPECT_NEAR(extent[0], 0.9, 1e-9);
+  EXPECT_NEAR(extent[1], 0.9 * 1.5 / 4.0, 1e-9);
+  EXPECT_NEAR(extent[2], 0.9 * 0.5 / 4.0, 1e-9);
+}
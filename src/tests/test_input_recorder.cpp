@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <thread>
+
+#include "../profiling/input_recorder.h"
+
+using namespace s21;
+
+class InputRecorderTest : public ::testing::Test {
+ protected:
+  void TearDown() override {
+    InputRecorder::GetInstance().Stop();
+    std::remove(path_.c_str());
+  }
+
+  std::string path_ = "test_input_recorder.s21rec";
+};
+
+TEST_F(InputRecorderTest, Record_IgnoredWhenNotRecording) {
+  InputRecorder& recorder = InputRecorder::GetInstance();
+  recorder.Start();
+  recorder.Stop();
+  recorder.Record(kEventSlider, 1, 2);
+
+  EXPECT_TRUE(recorder.GetEvents().empty());
+}
+
+TEST_F(InputRecorderTest, Record_MonotonicTimestamps) {
+  InputRecorder& recorder = InputRecorder::GetInstance();
+  recorder.Start();
+  recorder.Record(kEventMousePress, 10, 20, 1 | (1 << 16));
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  recorder.Record(kEventMouseMove, 15, 25, 1 << 16);
+  recorder.Stop();
+
+  const auto& events = recorder.GetEvents();
+  ASSERT_EQ(events.size(), 2u);
+  EXPECT_EQ(events[0].type, kEventMousePress);
+  EXPECT_GE(events[1].time_us - events[0].time_us, 2000u);
+}
+
+TEST_F(InputRecorderTest, SaveLoad_RoundTrip) {
+  std::vector<RecordedEvent> events(5);
+  events[0] = {0, kEventLoad, 0, 0, 0, "models/cube.obj"};
+  events[1] = {1500, kEventSlider, 3, -45, 0, ""};
+  events[2] = {1600, kEventMousePress, 400, 300, 1 | (1 << 16), ""};
+  events[3] = {9000000, kEventWheel, -1, 2, -120, ""};
+  events[4] = {9000001, kEventMouseRelease, 2147483647, -2147483647 - 1, 1,
+               ""};
+
+  ASSERT_TRUE(InputRecorder::SaveEvents(path_, events));
+  std::vector<RecordedEvent> loaded;
+  ASSERT_TRUE(InputRecorder::LoadEvents(path_, loaded));
+  EXPECT_EQ(loaded, events);
+}
+
+TEST_F(InputRecorderTest, Save_CompactEncoding) {
+  std::vector<RecordedEvent> events;
+  for (int i = 0; i < 1000; ++i) {
+    events.push_back({static_cast<uint64_t>(i) * 8000, kEventMouseMove,
+                      400 + i % 50, 300 - i % 50, 1 << 16, ""});
+  }
+
+  ASSERT_TRUE(InputRecorder::SaveEvents(path_, events));
+  std::ifstream file(path_, std::ios::binary | std::ios::ate);
+  EXPECT_LT(file.tellg(), 12 * 1000);
+}
+
+TEST_F(InputRecorderTest, Load_RejectsCorruptFile) {
+  std::vector<RecordedEvent> events(1);
+  events[0] = {10, kEventLoad, 0, 0, 0, "model.obj"};
+  ASSERT_TRUE(InputRecorder::SaveEvents(path_, events));
+
+  // Обрезанный файл
+  std::ifstream in(path_, std::ios::binary);
+  std::string data((std::istreambuf_iterator<char>(in)),
+                   std::istreambuf_iterator<char>());
+  in.close();
+  std::ofstream(path_, std::ios::binary)
+      .write(data.data(), static_cast<std::streamsize>(data.size() - 3));
+
+  std::vector<RecordedEvent> loaded;
+  EXPECT_FALSE(InputRecorder::LoadEvents(path_, loaded));
+
+  std::ofstream(path_, std::ios::binary) << "not a recording";
+  EXPECT_FALSE(InputRecorder::LoadEvents(path_, loaded));
+  EXPECT_FALSE(InputRecorder::LoadEvents("missing.s21rec", loaded));
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include "../profiling/latency.h"
+
+using namespace s21;
+using std::chrono::milliseconds;
+
+class LatencyTest : public ::testing::Test {
+ protected:
+  void SetUp() override { LatencyTracker::GetInstance().Clear(); }
+  void TearDown() override { LatencyTracker::GetInstance().Clear(); }
+
+  LatencyTracker::Clock::time_point start_ = LatencyTracker::Clock::now();
+};
+
+TEST(LatencyHistogramTest, Add_BucketsByPowerOfTwo) {
+  LatencyHistogram histogram;
+  histogram.Add(0.5);
+  histogram.Add(3.0);
+  histogram.Add(1000.0);
+
+  EXPECT_EQ(histogram.GetCount(), 3u);
+  EXPECT_EQ(histogram.GetBucket(0), 1u);
+  EXPECT_EQ(histogram.GetBucket(1), 1u);
+  EXPECT_EQ(histogram.GetBucket(9), 1u);
+  EXPECT_DOUBLE_EQ(histogram.GetMaxUs(), 1000.0);
+}
+
+TEST(LatencyHistogramTest, Percentile_UpperBucketBound) {
+  LatencyHistogram histogram;
+  for (int i = 0; i < 99; ++i) histogram.Add(100.0);
+  histogram.Add(50000.0);
+
+  EXPECT_DOUBLE_EQ(histogram.GetPercentileUs(0.5), 128.0);
+  EXPECT_DOUBLE_EQ(histogram.GetPercentileUs(1.0), 50000.0);
+}
+
+TEST_F(LatencyTest, FullPipeline_StagesAndTotal) {
+  LatencyTracker& tracker = LatencyTracker::GetInstance();
+  tracker.MarkInput(kInputSlider, start_);
+  tracker.MarkStage(kStageRequested, start_ + milliseconds(1));
+  tracker.MarkStage(kStageTransformed, start_ + milliseconds(3));
+  tracker.MarkStage(kStageDelivered, start_ + milliseconds(4));
+  tracker.MarkPresented(start_ + milliseconds(10));
+
+  const LatencyHistogram& total = tracker.GetHistogram(kInputSlider);
+  ASSERT_EQ(total.GetCount(), 1u);
+  EXPECT_NEAR(total.GetMeanUs(), 10000.0, 1e-6);
+  EXPECT_NEAR(
+      tracker.GetStageHistogram(kInputSlider, kStageTransformed).GetMeanUs(),
+      2000.0, 1e-6);
+  EXPECT_NEAR(
+      tracker.GetStageHistogram(kInputSlider, kStagePresented).GetMeanUs(),
+      6000.0, 1e-6);
+}
+
+TEST_F(LatencyTest, CoalescedInputs_MeasuredFromEarliest) {
+  LatencyTracker& tracker = LatencyTracker::GetInstance();
+  tracker.MarkInput(kInputMouse, start_);
+  tracker.MarkInput(kInputMouse, start_ + milliseconds(5));
+  tracker.MarkPresented(start_ + milliseconds(8));
+
+  const LatencyHistogram& total = tracker.GetHistogram(kInputMouse);
+  ASSERT_EQ(total.GetCount(), 1u);
+  EXPECT_NEAR(total.GetMeanUs(), 8000.0, 1e-6);
+}
+
+TEST_F(LatencyTest, PresentedWithoutInput_NoSample) {
+  LatencyTracker& tracker = LatencyTracker::GetInstance();
+  tracker.MarkPresented(start_);
+
+  EXPECT_EQ(tracker.GetHistogram(kInputWheel).GetCount(), 0u);
+  EXPECT_TRUE(tracker.Report().empty());
+}
+
+TEST_F(LatencyTest, Report_ContainsSource) {
+  LatencyTracker& tracker = LatencyTracker::GetInstance();
+  tracker.MarkInput(kInputWheel, start_);
+  tracker.MarkPresented(start_ + milliseconds(2));
+
+  EXPECT_NE(tracker.Report().find("wheel"), std::string::npos);
+}
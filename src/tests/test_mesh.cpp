@@ -0,0 +1,380 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include "../model/mesh_tools.h"
+#include "../model/model.h"
+#include "../model/obj_parser.h"
+#include "../model/parallel.h"
+
+using namespace s21;
+
+namespace {
+
+// Куб из отдельных квадов: каждая грань со своими четырьмя вершинами
+const char* kSplitCube =
+    "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\nf 1 2 3 4\n"
+    "v 0 0 1\nv 1 0 1\nv 1 1 1\nv 0 1 1\nf 5 6 7 8\n"
+    "v 0 0 0\nv 1 0 0\nv 1 0 1\nv 0 0 1\nf 9 10 11 12\n";
+
+Mesh ParseText(const std::string& text) {
+  std::istringstream input(text);
+  Mesh mesh;
+  EXPECT_EQ(ObjParser().Parse(input, mesh), kNoError);
+  return mesh;
+}
+
+}  // namespace
+
+TEST(ObjParserTest, Parse_StoresFacesAndEdges) {
+  const Mesh mesh = ParseText("v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\n"
+                              "f 1/1/1 2/2/2 3/3/3\nf 1 3 4\n");
+  EXPECT_EQ(mesh.GetVertexCount(), 4u);
+  EXPECT_EQ(mesh.GetFaceCount(), 2u);
+  EXPECT_EQ(mesh.GetEdgeCount(), 6u);
+  EXPECT_EQ(mesh.face_index, (std::vector<int>{0, 1, 2, 0, 2, 3}));
+  EXPECT_EQ(mesh.face_offset, (std::vector<int>{0, 3, 6}));
+}
+
+TEST(ObjParserTest, Load_MatchesModel) {
+  const std::string path = "test_mesh_model.obj";
+  std::ofstream file(path);
+  file << "v 12 0 -3.5\nv 0 24 1\nv -7 0.25 0\nf 1 2 3\nf 3 2\n";
+  file.close();
+
+  Model& model = Model::GetInstance();
+  model.SetFileName(path);
+  model.Parser();
+  Mesh mesh;
+  EXPECT_EQ(ObjParser().Load(path, mesh), model.GetError());
+  EXPECT_EQ(mesh.vertex_coord, model.GetVertexCoord());
+  EXPECT_EQ(mesh.vertex_index, model.GetVertexIndex());
+  EXPECT_EQ(mesh.GetFaceCount(), model.GetFaceCount());
+
+  model.SetFileName("");
+  std::remove(path.c_str());
+}
+
+TEST(ObjParserTest, Load_ReportsErrors) {
+  Mesh mesh;
+  ObjParser parser;
+  EXPECT_EQ(parser.Load("model.txt", mesh), kFileWrongExtension);
+  EXPECT_EQ(parser.Load("missing_model.obj", mesh), kFailedToOpen);
+
+  std::istringstream input("v 1 2\n");
+  EXPECT_EQ(parser.Parse(input, mesh), kIncorrectData);
+}
+
+TEST(ObjParserTest, Parse_RejectsZeroIndex) {
+  ObjParser parser;
+  Mesh mesh;
+  std::istringstream zero("v 0 0 0\nv 1 0 0\nf 1 0\n");
+  EXPECT_EQ(parser.Parse(zero, mesh), kIndexOutOfRange);
+  EXPECT_EQ(parser.GetLastError().index, 0);
+  EXPECT_EQ(mesh.GetVertexCount(), 0u);
+
+  std::istringstream valid("v 0 0 0\nv 1 0 0\nf 1 2\n");
+  EXPECT_EQ(parser.Parse(valid, mesh), kNoError);
+  EXPECT_EQ(parser.GetLastError().code, kNoError);
+}
+
+TEST(ObjParserTest, Parse_ReportsErrorPosition) {
+  ObjParser parser;
+  Mesh mesh;
+  std::istringstream coordinate("# cube\nv 0 0 0\n\nv 1 0,5 0\nv 2 2 2\n");
+  EXPECT_EQ(parser.Parse(coordinate, mesh), kIncorrectData);
+  EXPECT_EQ(parser.GetLastError().offset, 20u);
+  EXPECT_EQ(parser.GetLastError().line, 4u);
+  EXPECT_EQ(parser.GetLastError().column, 5u);
+  EXPECT_EQ(parser.GetLastError().token, "0,5");
+
+  std::istringstream missing("v 0 0 0\r\nv 1 2\r\n");
+  EXPECT_EQ(parser.Parse(missing, mesh), kIncorrectData);
+  EXPECT_EQ(parser.GetLastError().line, 2u);
+  EXPECT_EQ(parser.GetLastError().column, 7u);
+  EXPECT_EQ(parser.GetLastError().token, "");
+
+  // Ссылка вперёд находится в конце разбора по наибольшему индексу
+  std::istringstream forward("v 0 0 0\nf 1 2/1 3\nv 1 0 0\nf 1 9/2/3 2\n");
+  EXPECT_EQ(parser.Parse(forward, mesh), kIndexOutOfRange);
+  EXPECT_EQ(parser.GetLastError().line, 4u);
+  EXPECT_EQ(parser.GetLastError().column, 5u);
+  EXPECT_EQ(parser.GetLastError().token, "9/2/3");
+  EXPECT_EQ(parser.GetLastError().face, 1u);
+}
+
+TEST(ObjParserTest, Parse_ReportsUnreadableIndexToken) {
+  ObjParser parser;
+  Mesh mesh;
+  std::istringstream word("v 0 0 0\nv 1 0 0\nv 1 1 0\nf 1 abc 3\n");
+  EXPECT_EQ(parser.Parse(word, mesh), kIncorrectData);
+  EXPECT_EQ(parser.GetLastError().line, 4u);
+  EXPECT_EQ(parser.GetLastError().column, 5u);
+  EXPECT_EQ(parser.GetLastError().token, "abc");
+  EXPECT_EQ(parser.GetLastError().element, 'f');
+  EXPECT_EQ(mesh.GetVertexCount(), 0u);
+
+  std::istringstream comment("v 0 0 0\nv 1 0 0\nf 1 2 #\n");
+  EXPECT_EQ(parser.Parse(comment, mesh), kIncorrectData);
+  EXPECT_EQ(parser.GetLastError().column, 7u);
+  EXPECT_EQ(parser.GetLastError().token, "#");
+
+  // Табуляции и CRLF разделяют токены, v//vn остаётся допустимым
+  std::istringstream spaced("v 0 0 0\r\nv 1 0 0\r\nf 1//1\t2//1 \r\n");
+  EXPECT_EQ(parser.Parse(spaced, mesh), kNoError);
+  EXPECT_EQ(mesh.face_index, (std::vector<int>{0, 1}));
+}
+
+TEST(ObjParserTest, Parse_ReportsElementWithOneVertex) {
+  ObjParser parser;
+  Mesh mesh;
+  std::istringstream face("v 0 0 0\nv 1 0 0\nf 1 2\nf 2\n");
+  EXPECT_EQ(parser.Parse(face, mesh), kIncorrectData);
+  EXPECT_EQ(parser.GetLastError().line, 4u);
+  EXPECT_EQ(parser.GetLastError().column, 4u);
+  EXPECT_EQ(parser.GetLastError().token, "");
+  EXPECT_EQ(parser.GetLastError().face, 1u);
+
+  std::istringstream polyline("v 0 0 0\nv 1 0 0\nl 1 2\nl 3\n");
+  EXPECT_EQ(parser.Parse(polyline, mesh), kIncorrectData);
+  EXPECT_EQ(parser.GetLastError().element, 'l');
+  EXPECT_EQ(parser.GetLastError().face, 1u);
+
+  parser.SetLenient(true);
+  std::istringstream lenient(
+      "v 0 0 0\nv 1 0 0\nf 1\nf 1 x\nf 1 2\nl 2\n");
+  ASSERT_EQ(parser.Parse(lenient, mesh), kNoError);
+  EXPECT_EQ(parser.GetLastError().skipped_lines, 3u);
+  EXPECT_EQ(parser.GetLastError().line, 3u);
+  EXPECT_EQ(mesh.face_index, (std::vector<int>{0, 1}));
+}
+
+TEST(ObjParserTest, Parse_LenientSkipsBadLines) {
+  ObjParser parser;
+  parser.SetLenient(true);
+  Mesh mesh;
+  std::istringstream input(
+      "v 0 0 0\nv 1 0 0\nv oops\nv 1 1 0\nf 1 2 3\nf 1 0 2\n"
+      "f 3 5 1\nf 2 3\n");
+  EXPECT_EQ(parser.Parse(input, mesh), kNoError);
+  EXPECT_EQ(parser.GetLastError().skipped_lines, 3u);
+  EXPECT_EQ(parser.GetLastError().code, kIncorrectData);
+  EXPECT_EQ(parser.GetLastError().line, 3u);
+  EXPECT_EQ(mesh.GetVertexCount(), 3u);
+  EXPECT_EQ(mesh.face_index, (std::vector<int>{0, 1, 2, 1, 2}));
+  EXPECT_EQ(mesh.face_offset, (std::vector<int>{0, 3, 5}));
+  EXPECT_EQ(mesh.vertex_index,
+            (std::vector<int>{0, 1, 1, 2, 2, 0, 1, 2, 2, 1}));
+}
+
+TEST(ObjParserTest, Parse_PolylinesBecomeEdgesAfterFaces) {
+  ObjParser parser;
+  Mesh mesh;
+  std::istringstream input(
+      "v 0 0 0\nv 1 0 0\nl 1 2 4/1\nv 1 1 0\nv 0 1 0\nf 1 2 3\n"
+      "l 4 1\n");
+  ASSERT_EQ(parser.Parse(input, mesh), kNoError);
+  EXPECT_EQ(mesh.GetFaceCount(), 1u);
+  EXPECT_EQ(mesh.GetPolylineBegin(), 6u);
+  EXPECT_EQ(mesh.vertex_index,
+            (std::vector<int>{0, 1, 1, 2, 2, 0, 0, 1, 1, 3, 3, 0}));
+
+  // Файл только из ломаных
+  std::istringstream curves("v 0 0 0\nv 1 0 0\nv 2 0 0\nl 1 2 3\n");
+  ASSERT_EQ(parser.Parse(curves, mesh), kNoError);
+  EXPECT_EQ(mesh.GetFaceCount(), 0u);
+  EXPECT_EQ(mesh.vertex_index, (std::vector<int>{0, 1, 1, 2}));
+
+  std::istringstream bad("v 0 0 0\nv 1 0 0\nf 1 2\nl 1 2 5\n");
+  EXPECT_EQ(parser.Parse(bad, mesh), kIndexOutOfRange);
+  EXPECT_EQ(parser.GetLastError().element, 'l');
+  EXPECT_EQ(parser.GetLastError().face, 0u);
+  EXPECT_EQ(parser.GetLastError().column, 7u);
+
+  parser.SetLenient(true);
+  std::istringstream lenient(
+      "v 0 0 0\nv 1 0 0\nl 1 2\nl 2 7 1\nf 1 2\nl 2 1\n");
+  ASSERT_EQ(parser.Parse(lenient, mesh), kNoError);
+  EXPECT_EQ(parser.GetLastError().skipped_lines, 1u);
+  EXPECT_EQ(mesh.vertex_index, (std::vector<int>{0, 1, 1, 0, 0, 1, 1, 0}));
+}
+
+TEST(MeshToolsTest, PolylinesSurviveWeldAndExport) {
+  Mesh mesh = ParseText(
+      "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 1 0 0\nf 1 2 3\n"
+      "l 1 4 3 2\nl 2 1\n");
+  EXPECT_EQ(WeldVertices(mesh), 1u);
+  // Вершина 4 сварилась со второй: отрезки ломаных переназначены
+  EXPECT_EQ(mesh.vertex_index,
+            (std::vector<int>{0, 1, 1, 2, 2, 0, 0, 1, 1, 2, 2, 1, 1, 0}));
+
+  const std::string path = "test_polyline_export.obj";
+  ASSERT_EQ(ExportObj(mesh, path), kNoError);
+  std::ifstream file(path);
+  const std::string text((std::istreambuf_iterator<char>(file)),
+                         std::istreambuf_iterator<char>());
+  EXPECT_NE(text.find("f 1 2 3\nl 1 2 3 2 1\n"), std::string::npos);
+  Mesh loaded;
+  ASSERT_EQ(ObjParser().Load(path, loaded), kNoError);
+  EXPECT_EQ(loaded.vertex_index, mesh.vertex_index);
+  std::remove(path.c_str());
+}
+
+TEST(TransformerTest, MatchesModelTransform) {
+  Mesh mesh = ParseText(kSplitCube);
+  Model& model = Model::GetInstance();
+  model.GetVertexCoord() = mesh.vertex_coord;
+
+  Transformer transformer;
+  transformer.Apply(mesh.vertex_coord, kRotate, 33.0, kY);
+  transformer.Apply(mesh.vertex_coord, kMove, 0.25, kZ);
+  model.Transform(kRotate, 33.0, kY);
+  model.Transform(kMove, 0.25, kZ);
+  EXPECT_EQ(mesh.vertex_coord, model.GetVertexCoord());
+
+  model.SetFileName("");
+}
+
+TEST(MeshToolsTest, Weld_MergesExactDuplicates) {
+  Mesh mesh = ParseText(kSplitCube);
+  EXPECT_EQ(WeldVertices(mesh), 4u);
+  EXPECT_EQ(mesh.GetVertexCount(), 8u);
+  EXPECT_EQ(mesh.GetFaceCount(), 3u);
+  // Третья грань теперь ссылается на вершины первых двух
+  EXPECT_EQ(std::vector<int>(mesh.face_index.begin() + 8,
+                             mesh.face_index.end()),
+            (std::vector<int>{0, 1, 5, 4}));
+  EXPECT_EQ(mesh.GetEdgeCount(), 12u);
+}
+
+TEST(MeshToolsTest, Weld_ToleranceDropsDegenerateFaces) {
+  Mesh mesh = ParseText("v 0 0 0\nv 1 0 0\nv 1.0000001 0 0\nv 0 1 0\n"
+                        "f 1 2 3\nf 1 2 4\n");
+  EXPECT_EQ(WeldVertices(mesh, 0.0), 0u);
+  EXPECT_EQ(WeldVertices(mesh, 1e-3), 1u);
+  EXPECT_EQ(mesh.GetVertexCount(), 3u);
+  EXPECT_EQ(mesh.face_index, (std::vector<int>{0, 1, 2}));
+  EXPECT_EQ(mesh.vertex_index, (std::vector<int>{0, 1, 1, 2, 2, 0}));
+}
+
+TEST(MeshToolsTest, Stats_CountsUniqueEdgesAndBox) {
+  Mesh mesh = ParseText(kSplitCube);
+  WeldVertices(mesh);
+  const MeshStats stats = ComputeMeshStats(mesh);
+  EXPECT_EQ(stats.vertex_count, 8u);
+  EXPECT_EQ(stats.face_count, 3u);
+  EXPECT_EQ(stats.edge_count, 12u);
+  EXPECT_EQ(stats.unique_edge_count, 10u);
+  EXPECT_DOUBLE_EQ(stats.min[0], 0.0);
+  EXPECT_DOUBLE_EQ(stats.max[2], 1.0);
+}
+
+TEST(MeshToolsTest, Report_MatchesHandCountedCube) {
+  Mesh mesh = ParseText(kSplitCube);
+  WeldVertices(mesh);
+  // Вырожденный треугольник и отрезок с повтором вершины
+  mesh.face_index.insert(mesh.face_index.end(), {0, 0, 1});
+  mesh.face_offset.push_back(static_cast<int>(mesh.face_index.size()));
+  mesh.vertex_index.insert(mesh.vertex_index.end(), {0, 0, 0, 1, 1, 0});
+  const MeshReport report = ComputeMeshReport(mesh);
+  EXPECT_EQ(report.vertex_count, 8u);
+  EXPECT_EQ(report.face_count, 4u);
+  EXPECT_EQ(report.edge_count, 15u);
+  EXPECT_EQ(report.unique_edge_count, 10u);
+  // (0, 1) общее у двух квадов и дважды в добавленном отрезке
+  EXPECT_EQ(report.duplicate_edge_count, 4u);
+  EXPECT_EQ(report.degenerate_edge_count, 1u);
+  EXPECT_DOUBLE_EQ(report.edge_min, 1.0);
+  EXPECT_DOUBLE_EQ(report.edge_max, 1.0);
+  EXPECT_DOUBLE_EQ(report.edge_mean, 1.0);
+  EXPECT_EQ(report.edge_histogram[0], 14u);
+  EXPECT_EQ(report.face_arity[3], 1u);
+  EXPECT_EQ(report.face_arity[4], 3u);
+  EXPECT_DOUBLE_EQ(report.surface_area, 3.0);
+  for (int axis = 0; axis < 3; ++axis) {
+    EXPECT_DOUBLE_EQ(report.min[axis], 0.0);
+    EXPECT_DOUBLE_EQ(report.max[axis], 1.0);
+    EXPECT_DOUBLE_EQ(report.centroid[axis], 0.5);
+  }
+
+  const MeshReport empty = ComputeMeshReport(Mesh(), 4);
+  EXPECT_EQ(empty.edge_count, 0u);
+  EXPECT_DOUBLE_EQ(empty.surface_area, 0.0);
+}
+
+TEST(MeshToolsTest, Report_DoesNotDependOnThreads) {
+  // Сетка треугольников с неравными рёбрами, больше одного куска
+  Mesh mesh;
+  const int side = 300;
+  for (int y = 0; y <= side; ++y) {
+    for (int x = 0; x <= side; ++x) {
+      mesh.vertex_coord.insert(mesh.vertex_coord.end(),
+                               {x * 0.1, y * 0.2, 0.01 * ((x * y) % 7)});
+    }
+  }
+  for (int y = 0; y < side; ++y) {
+    for (int x = 0; x < side; ++x) {
+      const int a = y * (side + 1) + x, c = a + side + 2;
+      for (int vertex : {a, a + 1, c, a, c, c - 1}) {
+        mesh.face_index.push_back(vertex);
+      }
+      mesh.face_offset.push_back(static_cast<int>(mesh.face_index.size()) -
+                                 3);
+      mesh.face_offset.push_back(static_cast<int>(mesh.face_index.size()));
+    }
+  }
+  for (size_t f = 0; f < mesh.GetFaceCount(); ++f) {
+    for (int i = mesh.face_offset[f]; i < mesh.face_offset[f + 1]; ++i) {
+      const int next =
+          i + 1 < mesh.face_offset[f + 1] ? i + 1 : mesh.face_offset[f];
+      mesh.vertex_index.push_back(mesh.face_index[i]);
+      mesh.vertex_index.push_back(mesh.face_index[next]);
+    }
+  }
+  const MeshReport single = ComputeMeshReport(mesh, 1);
+  const MeshReport parallel = ComputeMeshReport(mesh, 4);
+  // Рёбра сетки: горизонтальные, вертикальные и диагонали
+  EXPECT_EQ(single.unique_edge_count, size_t(3 * side * side + 2 * side));
+  EXPECT_EQ(single.unique_edge_count, ComputeMeshStats(mesh).unique_edge_count);
+  // Поверхность с неровностями не меньше своей проекции 30 x 60
+  EXPECT_GE(single.surface_area, 30.0 * 60.0);
+  EXPECT_LT(single.surface_area, 1.1 * 30.0 * 60.0);
+  EXPECT_EQ(std::memcmp(&single, &parallel, sizeof(MeshReport)), 0);
+  size_t histogram = 0;
+  for (size_t bin : single.edge_histogram) histogram += bin;
+  EXPECT_EQ(histogram, single.edge_count - single.degenerate_edge_count);
+}
+
+TEST(MeshToolsTest, ExportObj_RoundTripIsExact) {
+  Mesh mesh = ParseText(kSplitCube);
+  Transformer().Apply(mesh.vertex_coord, kRotate, 17.0, kX);
+
+  const std::string path = "test_mesh_export.obj";
+  ASSERT_EQ(ExportObj(mesh, path), kNoError);
+  Mesh loaded;
+  ASSERT_EQ(ObjParser().Load(path, loaded), kNoError);
+  EXPECT_EQ(loaded.vertex_coord, mesh.vertex_coord);
+  EXPECT_EQ(loaded.vertex_index, mesh.vertex_index);
+  EXPECT_EQ(loaded.face_offset, mesh.face_offset);
+  std::remove(path.c_str());
+
+  EXPECT_EQ(ExportObj(mesh, "no_such_dir/out.obj"), kFailedToWrite);
+}
+
+TEST(ParallelForTest, VisitsEveryIndexOnce) {
+  std::vector<std::atomic<int>> visits(1000);
+  std::atomic<unsigned> max_worker{0};
+  ParallelFor(visits.size(), 4, [&](unsigned worker, size_t index) {
+    visits[index].fetch_add(1);
+    unsigned seen = max_worker.load();
+    while (worker > seen && !max_worker.compare_exchange_weak(seen, worker)) {
+    }
+  });
+  for (const auto& count : visits) EXPECT_EQ(count.load(), 1);
+  EXPECT_LT(max_worker.load(), 4u);
+}
@@ -0,0 +1,85 @@
+#ifndef TESTS_TEST_MESHES_H
+#define TESTS_TEST_MESHES_H
+
+/**
+ * @file test_meshes.h
+ * @brief Сетки, общие для тестов геометрии
+ */
+
+#include <cmath>
+#include <initializer_list>
+
+#include "../model/mesh.h"
+
+namespace s21::test {
+
+/**
+ * @brief Добавляет UV-сферу с общими вершинами и полюсами
+ *
+ * У полюсов веера треугольников; каждая клетка между кольцами - два
+ * треугольника или, при quads = true, один четырёхугольник. Грани
+ * обходятся против часовой стрелки при взгляде снаружи.
+ *
+ * @param mesh Сетка, к которой добавляется сфера
+ * @param rings Число колец от полюса до полюса
+ * @param segments Число сегментов по долготе
+ * @param radius Радиус
+ * @param center_x Сдвиг центра по X
+ * @param quads Клетки четырёхугольниками
+ */
+inline void AddSphere(Mesh& mesh, int rings, int segments, double radius,
+                      double center_x = 0.0, bool quads = false) {
+  const double pi = 3.141592653589793;
+  const int base = static_cast<int>(mesh.GetVertexCount());
+  auto add = [&mesh, center_x](double x, double y, double z) {
+    mesh.vertex_coord.insert(mesh.vertex_coord.end(), {x + center_x, y, z});
+  };
+  auto face = [&mesh, base](std::initializer_list<int> vertices) {
+    for (int vertex : vertices) mesh.face_index.push_back(base + vertex);
+    mesh.face_offset.push_back(static_cast<int>(mesh.face_index.size()));
+  };
+  add(0.0, 0.0, radius);
+  for (int ring = 1; ring < rings; ++ring) {
+    const double theta = pi * ring / rings;
+    for (int segment = 0; segment < segments; ++segment) {
+      const double phi = 2.0 * pi * segment / segments;
+      add(radius * std::sin(theta) * std::cos(phi),
+          radius * std::sin(theta) * std::sin(phi), radius * std::cos(theta));
+    }
+  }
+  add(0.0, 0.0, -radius);
+  const int south = static_cast<int>(mesh.GetVertexCount()) - 1 - base;
+  auto at = [segments](int ring, int segment) {
+    return 1 + (ring - 1) * segments + segment % segments;
+  };
+  for (int segment = 0; segment < segments; ++segment) {
+    face({0, at(1, segment), at(1, segment + 1)});
+    face({south, at(rings - 1, segment + 1), at(rings - 1, segment)});
+    for (int ring = 1; ring + 1 < rings; ++ring) {
+      if (quads) {
+        face({at(ring, segment), at(ring + 1, segment),
+              at(ring + 1, segment + 1), at(ring, segment + 1)});
+        continue;
+      }
+      face({at(ring, segment), at(ring + 1, segment),
+            at(ring + 1, segment + 1)});
+      face({at(ring, segment), at(ring + 1, segment + 1),
+            at(ring, segment + 1)});
+    }
+  }
+}
+
+/**
+ * @brief Отдельная сфера с центром в начале координат
+ * @see AddSphere()
+ */
+inline Mesh MakeSphere(int rings, int segments, double radius = 1.0,
+                       bool quads = false) {
+  Mesh mesh;
+  AddSphere(mesh, rings, segments, radius, 0.0, quads);
+  return mesh;
+}
+
+}  // namespace s21::test
+
+#endif  // TESTS_TEST_MESHES_H
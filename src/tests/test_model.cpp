@@ -395,3 +395,26 @@ TEST_F(ModelTest, Parser_NegativeIndices_Ignored) {
 
   std::remove("test_negative.obj");
 }
+
+TEST_F(ModelTest, Parser_IndexOutOfRange_Rejected) {
+  std::ofstream file("test_range.obj");
+  file << "v 0.0 0.0 0.0\n";
+  file << "v 1.0 0.0 0.0\n";
+  file << "f 1 3 2\n";
+  file << "v 1.0 1.0 0.0\n";
+  file << "f 1 2 4\n";
+  file.close();
+
+  model_->SetFileName("test_range.obj");
+  model_->Parser();
+
+  // Ссылка вперёд на вершину 3 допустима, на вершину 4 - нет
+  EXPECT_EQ(model_->GetError(), kIndexOutOfRange);
+  EXPECT_EQ(model_->GetParseError().face, 1u);
+  EXPECT_EQ(model_->GetParseError().index, 4);
+  EXPECT_EQ(model_->GetParseError().vertex_count, 3u);
+  EXPECT_TRUE(model_->GetVertexIndex().empty());
+  EXPECT_TRUE(model_->GetVertexCoord().empty());
+
+  std::remove("test_range.obj");
+}
@@ -0,0 +1,290 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "../render/picker.h"
+#include "../render/refit_scheduler.h"
+
+using namespace s21;
+
+namespace {
+
+std::vector<float> RandomPoints(size_t count, unsigned seed) {
+  std::mt19937 random(seed);
+  std::uniform_real_distribution<float> coordinate(-0.9f, 0.9f);
+  std::vector<float> points(count * 3);
+  for (float& value : points) value = coordinate(random);
+  return points;
+}
+
+/**
+ * @brief Короткие рёбра между случайными вершинами
+ */
+std::vector<int> RandomEdges(size_t vertices, size_t count, unsigned seed) {
+  std::mt19937 random(seed);
+  std::uniform_int_distribution<int> index(0, int(vertices) - 1);
+  std::vector<int> edges;
+  for (size_t i = 0; i < count; ++i) {
+    const int a = index(random);
+    edges.push_back(a);
+    edges.push_back((a + 1 + index(random) % 8) % int(vertices));
+  }
+  return edges;
+}
+
+double Distance(const float* a, const double* b) {
+  double sum = 0.0;
+  for (int axis = 0; axis < 3; ++axis) {
+    sum += (a[axis] - b[axis]) * (a[axis] - b[axis]);
+  }
+  return std::sqrt(sum);
+}
+
+double SegmentDistance(const float* a, const float* b, const double* p) {
+  double d[3], w[3], length2 = 0.0, dot = 0.0;
+  for (int axis = 0; axis < 3; ++axis) {
+    d[axis] = double(b[axis]) - a[axis];
+    w[axis] = p[axis] - a[axis];
+    length2 += d[axis] * d[axis];
+    dot += d[axis] * w[axis];
+  }
+  const double t = length2 > 0.0 ? std::clamp(dot / length2, 0.0, 1.0) : 0.0;
+  double sum = 0.0;
+  for (int axis = 0; axis < 3; ++axis) {
+    sum += (w[axis] - d[axis] * t) * (w[axis] - d[axis] * t);
+  }
+  return std::sqrt(sum);
+}
+
+/**
+ * @brief Экранные координаты точки при ортографической камере
+ * @return false если точка за плоскостями отсечения по глубине
+ */
+bool Project(const Matrix4& m, int size, const float* p, double& x,
+             double& y) {
+  const double cx = m[0] * p[0] + m[4] * p[1] + m[8] * p[2] + m[12];
+  const double cy = m[1] * p[0] + m[5] * p[1] + m[9] * p[2] + m[13];
+  const double cz = m[2] * p[0] + m[6] * p[1] + m[10] * p[2] + m[14];
+  x = (cx + 1.0) * size * 0.5;
+  y = (1.0 - cy) * size * 0.5;
+  return cz >= -1.0 && cz <= 1.0;
+}
+
+}  // namespace
+
+TEST(Bvh, OrderIsPermutationIndependentOfThreads) {
+  const std::vector<float> points = RandomPoints(5000, 1);
+  auto bounds = [&](size_t i) {
+    BvhBox box;
+    box.Expand(&points[i * 3]);
+    return box;
+  };
+  Bvh single(1), multi(3);
+  single.Build(5000, bounds);
+  multi.Build(5000, bounds);
+  EXPECT_EQ(single.GetOrder(), multi.GetOrder());
+
+  std::vector<uint32_t> sorted = single.GetOrder();
+  std::sort(sorted.begin(), sorted.end());
+  for (uint32_t i = 0; i < sorted.size(); ++i) ASSERT_EQ(sorted[i], i);
+
+  const BvhBox all = single.GetBounds();
+  for (size_t i = 0; i < points.size(); ++i) {
+    EXPECT_GE(points[i], all.min[i % 3]);
+    EXPECT_LE(points[i], all.max[i % 3]);
+  }
+}
+
+TEST(Picker, NearestMatchesBruteForce) {
+  const size_t vertices = 4000;
+  const std::vector<float> points = RandomPoints(vertices, 2);
+  const std::vector<int> edges = RandomEdges(vertices, 6000, 3);
+  Picker picker(2);
+  picker.Build(points, edges);
+  ASSERT_EQ(picker.GetVertexCount(), vertices);
+  ASSERT_EQ(picker.GetEdgeCount(), 6000u);
+
+  std::mt19937 random(4);
+  std::uniform_real_distribution<double> coordinate(-1.2, 1.2);
+  for (int query = 0; query < 200; ++query) {
+    const double p[3] = {coordinate(random), coordinate(random),
+                         coordinate(random)};
+    double vertex_best = INFINITY, edge_best = INFINITY;
+    for (size_t i = 0; i < vertices; ++i) {
+      vertex_best = std::min(vertex_best, Distance(&points[i * 3], p));
+    }
+    for (size_t e = 0; e < edges.size() / 2; ++e) {
+      edge_best = std::min(
+          edge_best, SegmentDistance(&points[edges[e * 2] * 3],
+                                     &points[edges[e * 2 + 1] * 3], p));
+    }
+    const PickResult vertex = picker.Nearest(p, kPickVertex);
+    ASSERT_EQ(vertex.kind, kPickVertex);
+    EXPECT_NEAR(vertex.distance, vertex_best, 1e-9);
+    EXPECT_NEAR(Distance(&points[vertex.index * 3], p), vertex_best, 1e-9);
+
+    const PickResult edge = picker.Nearest(p, kPickEdge);
+    ASSERT_EQ(edge.kind, kPickEdge);
+    EXPECT_NEAR(edge.distance, edge_best, 1e-9);
+    const float position[3] = {float(edge.position[0]),
+                               float(edge.position[1]),
+                               float(edge.position[2])};
+    EXPECT_NEAR(Distance(position, p), edge_best, 1e-6);
+  }
+}
+
+TEST(Picker, PickMatchesBruteForceOnScreen) {
+  const size_t vertices = 3000;
+  const std::vector<float> points = RandomPoints(vertices, 5);
+  Picker picker(1);
+  picker.Build(points, {});
+  Camera camera;
+  camera.rotation[0] = 30.0;
+  camera.rotation[1] = -20.0;
+  constexpr int kSize = 400;
+  const Matrix4 matrix = camera.BuildMatrix(kSize, kSize);
+
+  std::mt19937 random(6);
+  std::uniform_real_distribution<double> coordinate(0.0, kSize);
+  int hits = 0;
+  for (int query = 0; query < 300; ++query) {
+    const double x = coordinate(random), y = coordinate(random);
+    double best = INFINITY;
+    for (size_t i = 0; i < vertices; ++i) {
+      double sx, sy;
+      if (!Project(matrix, kSize, &points[i * 3], sx, sy)) continue;
+      best = std::min(best, std::hypot(sx - x, sy - y));
+    }
+    const PickResult hit = picker.Pick(camera, kSize, kSize, x, y, 5.0);
+    if (best > 5.0) {
+      EXPECT_EQ(hit.kind, kPickNone);
+      continue;
+    }
+    ++hits;
+    ASSERT_EQ(hit.kind, kPickVertex);
+    EXPECT_NEAR(hit.distance, best, 1e-6);
+  }
+  EXPECT_GT(hits, 10);
+}
+
+TEST(Picker, PrefersVertexThenEdge) {
+  // Квадрат в плоскости z = 0, камера без поворота, кадр 200 x 200
+  const std::vector<float> points = {-0.5f, -0.5f, 0.0f, 0.5f, -0.5f, 0.0f,
+                                     0.5f,  0.5f,  0.0f, -0.5f, 0.5f, 0.0f};
+  const std::vector<int> edges = {0, 1, 1, 2, 2, 3, 3, 0, 0, 7};
+  Picker picker;
+  picker.Build(points, edges);
+  Camera camera;
+
+  // Вершина 2 в пикселе (150, 50)
+  PickResult hit = picker.Pick(camera, 200, 200, 151.0, 52.0);
+  ASSERT_EQ(hit.kind, kPickVertex);
+  EXPECT_EQ(hit.index, 2u);
+  EXPECT_NEAR(hit.distance, std::sqrt(5.0), 1e-9);
+
+  // Середина нижнего ребра 0-1 в пикселе (100, 150)
+  hit = picker.Pick(camera, 200, 200, 103.0, 148.0);
+  ASSERT_EQ(hit.kind, kPickEdge);
+  EXPECT_EQ(hit.index, 0u);
+  EXPECT_EQ(hit.vertex[0], 0u);
+  EXPECT_EQ(hit.vertex[1], 1u);
+  EXPECT_NEAR(hit.distance, 2.0, 1e-9);
+  EXPECT_NEAR(hit.position[0], 0.03, 1e-6);
+  EXPECT_NEAR(hit.position[1], -0.5, 1e-6);
+
+  EXPECT_EQ(picker.Pick(camera, 200, 200, 100.0, 100.0).kind, kPickNone);
+}
+
+TEST(Picker, PerspectiveEdgePointIsPerspectiveCorrect) {
+  // Ребро уходит вглубь: равные доли на экране - неравные в модели
+  const std::vector<float> points = {-0.5f, 0.0f, 0.5f, 0.5f, 0.0f, -1.5f};
+  Picker picker;
+  picker.Build(points, {0, 1});
+  Camera camera;
+  camera.projection = kProjectionPerspective;
+  const Matrix4 m = camera.BuildMatrix(300, 300);
+  auto screen_x = [&](double px, double pz) {
+    const double cx = m[0] * px + m[8] * pz + m[12];
+    const double cw = m[3] * px + m[11] * pz + m[15];
+    return (cx / cw + 1.0) * 150.0;
+  };
+  // Точка модели x = 0.1, z = -0.7 лежит на ребре
+  const double x = screen_x(0.1, -0.7);
+  const PickResult hit = picker.Pick(camera, 300, 300, x, 150.0);
+  ASSERT_EQ(hit.kind, kPickEdge);
+  EXPECT_NEAR(hit.distance, 0.0, 1e-6);
+  EXPECT_NEAR(hit.position[0], 0.1, 1e-5);
+  EXPECT_NEAR(hit.position[2], -0.7, 1e-5);
+}
+
+TEST(Picker, RefitFollowsMovedVertices) {
+  std::vector<float> points = RandomPoints(2000, 7);
+  Picker picker(2);
+  picker.Build(points, RandomEdges(2000, 3000, 8));
+  for (size_t i = 0; i < points.size(); i += 3) points[i] += 5.0f;
+  picker.Refit(points);
+
+  const double p[3] = {points[30], points[31], points[32]};
+  const PickResult hit = picker.Nearest(p, kPickVertex);
+  ASSERT_EQ(hit.kind, kPickVertex);
+  EXPECT_EQ(hit.index, 10u);
+  EXPECT_EQ(hit.distance, 0.0);
+  EXPECT_EQ(picker.GetEdgeCount(), 3000u);
+}
+
+TEST(Picker, SchedulerRefitsLazilyFromViewCoordinates) {
+  std::vector<double> coords = {0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0};
+  std::atomic<int> finished{0};
+  WorkerQueue worker(1);
+  RefitScheduler<Picker> scheduler(
+      worker, 1, [](void* done) { ++*static_cast<std::atomic<int>*>(done); },
+      &finished);
+  EXPECT_EQ(scheduler.Get(), nullptr);
+
+  scheduler.Invalidate(true);
+  ASSERT_TRUE(scheduler.NeedsBuild());
+  const std::vector<float> points(coords.begin(), coords.end());
+  ASSERT_TRUE(scheduler.StartBuild(
+      [points](Picker& picker) { picker.Build(points, {0, 1, 1, 2}); }));
+  EXPECT_FALSE(scheduler.NeedsUpdate());
+  worker.WaitIdle();
+  scheduler.Finish();
+  ASSERT_NE(scheduler.Get(), nullptr);
+  EXPECT_EQ(scheduler.Get()->GetEdgeCount(), 2u);
+
+  // Трансформация только отмечает иерархию устаревшей
+  for (size_t i = 0; i < coords.size(); i += 3) coords[i] += 2.0;
+  scheduler.Invalidate(false);
+  EXPECT_EQ(scheduler.Get(), nullptr);
+  ASSERT_TRUE(scheduler.NeedsUpdate());
+  ASSERT_FALSE(scheduler.NeedsBuild());
+  ASSERT_TRUE(scheduler.StartRefit(coords.data(), coords.size()));
+  EXPECT_FALSE(scheduler.StartRefit(coords.data(), coords.size()));
+  worker.WaitIdle();
+  scheduler.Finish();
+  EXPECT_EQ(finished, 2);
+
+  const double p[3] = {3.0, 0.0, 0.0};
+  const PickResult hit = scheduler.Get()->Nearest(p, kPickVertex);
+  ASSERT_EQ(hit.kind, kPickVertex);
+  EXPECT_EQ(hit.index, 1u);
+  EXPECT_EQ(hit.distance, 0.0);
+}
+
+TEST(Picker, EmptyAndInvalidInput) {
+  Picker picker;
+  Camera camera;
+  EXPECT_EQ(picker.Pick(camera, 100, 100, 50.0, 50.0).kind, kPickNone);
+  const double origin[3] = {0.0, 0.0, 0.0};
+  EXPECT_EQ(picker.Nearest(origin, kPickEdge).kind, kPickNone);
+
+  // Ребро с индексом вне диапазона не выбирается
+  picker.Build({0.0f, 0.0f, 0.0f}, {0, 5});
+  EXPECT_EQ(picker.Nearest(origin, kPickEdge).kind, kPickNone);
+  EXPECT_EQ(picker.Pick(camera, 100, 100, 50.0, 50.0).kind, kPickVertex);
+  EXPECT_EQ(picker.Pick(camera, 0, 100, 50.0, 50.0).kind, kPickNone);
+}
@@ -0,0 +1,366 @@
+#include <gtest/gtest.h>
+#include <zlib.h>
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../model/obj_parser.h"
+#include "../render/model_cache.h"
+#include "../render/rasterizer.h"
+
+using namespace s21;
+
+namespace {
+
+const uint32_t kWhite = MakeColor(255, 255, 255);
+const uint32_t kBlack = MakeColor(0, 0, 0);
+
+uint32_t ReadBigEndian(const std::string& data, size_t pos) {
+  return static_cast<uint32_t>(static_cast<uint8_t>(data[pos])) << 24 |
+         static_cast<uint32_t>(static_cast<uint8_t>(data[pos + 1])) << 16 |
+         static_cast<uint32_t>(static_cast<uint8_t>(data[pos + 2])) << 8 |
+         static_cast<uint32_t>(static_cast<uint8_t>(data[pos + 3]));
+}
+
+RenderMesh MakeMesh(const std::string& obj) {
+  std::istringstream input(obj);
+  Mesh mesh;
+  EXPECT_EQ(ObjParser().Parse(input, mesh), kNoError);
+  return BuildRenderMesh(mesh);
+}
+
+size_t CountPixels(const Image& image, uint32_t color) {
+  size_t count = 0;
+  for (uint32_t pixel : image.pixels) count += pixel == color;
+  return count;
+}
+
+void WriteFile(const std::string& path, const std::string& content) {
+  std::ofstream file(path);
+  file << content;
+}
+
+}  // namespace
+
+TEST(RenderMeshTest, DeduplicatesSharedEdges) {
+  // Два треугольника с общим ребром 1-3 и одно вырожденное ребро;
+  // ребро за пределы вершин парсер не пропустит, поэтому оно
+  // добавляется в сетку вручную
+  std::istringstream input(
+      "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\nf 1 2 3\nf 1 3 4\nf 2 2\n");
+  Mesh source;
+  ASSERT_EQ(ObjParser().Parse(input, source), kNoError);
+  source.vertex_index.insert(source.vertex_index.end(), {0, 8});
+  const RenderMesh mesh = BuildRenderMesh(source);
+  EXPECT_EQ(mesh.GetVertexCount(), 4u);
+  EXPECT_EQ(mesh.GetEdgeCount(), 5u);
+  EXPECT_GT(mesh.GetByteSize(), 0u);
+}
+
+TEST(ImageTest, EncodePng_DecodesBack) {
+  Image image;
+  image.Reset(3, 2, kBlack);
+  image.pixels[4] = MakeColor(10, 20, 30, 40);
+  const std::string png = EncodePng(image);
+
+  ASSERT_EQ(png.compare(0, 8, "\x89PNG\r\n\x1a\n"), 0);
+  EXPECT_EQ(png.substr(12, 4), "IHDR");
+  EXPECT_EQ(ReadBigEndian(png, 16), 3u);
+  EXPECT_EQ(ReadBigEndian(png, 20), 2u);
+
+  const size_t idat = png.find("IDAT");
+  ASSERT_NE(idat, std::string::npos);
+  const uint32_t length = ReadBigEndian(png, idat - 4);
+  std::string raw(2 * (3 * 4 + 1), '\0');
+  uLongf raw_size = raw.size();
+  ASSERT_EQ(uncompress(reinterpret_cast<Bytef*>(&raw[0]), &raw_size,
+                       reinterpret_cast<const Bytef*>(png.data() + idat + 4),
+                       length),
+            Z_OK);
+  ASSERT_EQ(raw_size, raw.size());
+  // Вторая строка, второй пиксель: после байта фильтра
+  EXPECT_EQ(raw.substr(13 + 1 + 4, 4), std::string("\x0a\x14\x1e\x28", 4));
+  EXPECT_EQ(png.substr(png.size() - 8, 4), "IEND");
+}
+
+TEST(RasterizerTest, DrawLine_ClipsToImage) {
+  Image image;
+  image.Reset(10, 10, kBlack);
+  EXPECT_TRUE(DrawLine(image, -5.0, 5.0, 20.0, 5.0, kWhite));
+  EXPECT_EQ(CountPixels(image, kWhite), 10u);
+  EXPECT_FALSE(DrawLine(image, -5.0, -1.0, 20.0, -1.0, kWhite));
+  EXPECT_TRUE(DrawLine(image, 0.0, 0.0, 9.0, 9.0, kWhite));
+  EXPECT_EQ(image.At(9, 9), kWhite);
+}
+
+TEST(RasterizerTest, Render_SquareOutline) {
+  const RenderMesh mesh =
+      MakeMesh("v -0.5 -0.5 0\nv 0.5 -0.5 0\nv 0.5 0.5 0\nv -0.5 0.5 0\n"
+               "f 1 2 3 4\n");
+  Rasterizer rasterizer;
+  Image image;
+  RenderStyle style;
+  style.background = kBlack;
+  style.antialias = false;
+
+  EXPECT_EQ(rasterizer.Render(mesh, Camera(), style, 101, 101, image), 4u);
+  // Квадрат [-0.5, 0.5] занимает центральную половину кадра
+  EXPECT_EQ(image.At(25, 50), kWhite);
+  EXPECT_EQ(image.At(75, 50), kWhite);
+  EXPECT_EQ(image.At(50, 25), kWhite);
+  EXPECT_EQ(image.At(50, 50), kBlack);
+  EXPECT_NEAR(static_cast<double>(CountPixels(image, kWhite)), 200.0, 8.0);
+
+  // Поворот на 90 градусов вокруг Z даёт тот же контур
+  Camera rotated;
+  rotated.rotation[2] = 90.0;
+  Image rotated_image;
+  rasterizer.Render(mesh, rotated, style, 101, 101, rotated_image);
+  EXPECT_EQ(rotated_image.At(25, 50), kWhite);
+
+  // Широкий кадр: короткая сторона соответствует [-1, 1]
+  rasterizer.Render(mesh, Camera(), style, 201, 101, image);
+  EXPECT_EQ(image.At(75, 50), kWhite);
+  EXPECT_EQ(image.At(125, 50), kWhite);
+}
+
+TEST(RasterizerTest, Render_PerspectiveShrinksDistantEdges) {
+  const RenderMesh mesh =
+      MakeMesh("v -0.5 -0.5 -1\nv 0.5 -0.5 -1\nv 0.5 0.5 -1\n"
+               "v -0.5 0.5 -1\nf 1 2 3 4\nv 0 0 5\nv 1 0 5\nf 5 6\n");
+  Rasterizer rasterizer;
+  Image image;
+  RenderStyle style;
+  style.background = kBlack;
+  style.antialias = false;
+  Camera camera;
+  camera.projection = kProjectionPerspective;
+
+  // Ребро за камерой отсекается ближней плоскостью целиком
+  EXPECT_EQ(rasterizer.Render(mesh, camera, style, 100, 100, image), 4u);
+  const size_t far_pixels = CountPixels(image, kWhite);
+  rasterizer.Render(mesh, Camera(), style, 100, 100, image);
+  EXPECT_LT(far_pixels, CountPixels(image, kWhite));
+}
+
+TEST(RasterizerTest, Render_PointsStyle) {
+  const RenderMesh mesh = MakeMesh("v 0 0 0\nv 0.5 0 0\nf 1 2\n");
+  Rasterizer rasterizer;
+  Image image;
+  RenderStyle style;
+  style.style = kStylePoints;
+  style.background = kBlack;
+  style.point_size = 4;
+
+  EXPECT_EQ(rasterizer.Render(mesh, Camera(), style, 64, 64, image), 0u);
+  EXPECT_EQ(CountPixels(image, kWhite), 32u);
+}
+
+TEST(RasterizerTest, Render_StretchedWithoutKeepAspect) {
+  const RenderMesh mesh = MakeMesh("v -0.5 0 0\nv 0.5 0 0\nf 1 2\n");
+  Rasterizer rasterizer;
+  Image image;
+  RenderStyle style;
+  style.background = kBlack;
+  style.antialias = false;
+  Camera camera;
+  camera.keep_aspect = false;
+
+  // Как в OpenGLWidget: [-1, 1] растягивается на всю ширину кадра
+  rasterizer.Render(mesh, camera, style, 201, 101, image);
+  EXPECT_EQ(image.At(50, 50), kWhite);
+  EXPECT_EQ(image.At(150, 50), kWhite);
+  EXPECT_EQ(image.At(30, 50), kBlack);
+}
+
+TEST(RasterizerTest, Render_SameImageForAnyThreadCount) {
+  // Сфера из рёбер пересекает все плитки и их границы
+  std::ostringstream obj;
+  const int rings = 24;
+  const int segments = 48;
+  for (int ring = 0; ring <= rings; ++ring) {
+    const double theta = 3.141592653589793 * ring / rings;
+    for (int segment = 0; segment < segments; ++segment) {
+      const double phi = 2.0 * 3.141592653589793 * segment / segments;
+      obj << "v " << 0.9 * std::sin(theta) * std::cos(phi) << ' '
+          << 0.9 * std::cos(theta) << ' '
+          << 0.9 * std::sin(theta) * std::sin(phi) << '\n';
+    }
+  }
+  for (int ring = 0; ring < rings; ++ring) {
+    for (int segment = 0; segment < segments; ++segment) {
+      const int a = ring * segments + segment + 1;
+      const int b = ring * segments + (segment + 1) % segments + 1;
+      obj << "f " << a << ' ' << b << ' ' << b + segments << ' '
+          << a + segments << '\n';
+    }
+  }
+  const RenderMesh mesh = MakeMesh(obj.str());
+  Camera camera;
+  camera.rotation[0] = 30.0;
+  camera.projection = kProjectionPerspective;
+
+  for (bool antialias : {false, true}) {
+    RenderStyle style;
+    style.antialias = antialias;
+    Image single;
+    Image multi;
+    Rasterizer one(1);
+    Rasterizer four(4);
+    const size_t drawn = one.Render(mesh, camera, style, 300, 200, single);
+    EXPECT_GT(drawn, 0u);
+    EXPECT_EQ(four.Render(mesh, camera, style, 300, 200, multi), drawn);
+    EXPECT_EQ(single.pixels, multi.pixels) << "antialias " << antialias;
+  }
+}
+
+TEST(RasterizerTest, Render_NoSeamsAcrossTiles) {
+  // Горизонталь по строке 50 проходит через три плитки подряд
+  const RenderMesh mesh = MakeMesh("v -1 0 0\nv 1 0 0\nf 1 2\n");
+  Rasterizer rasterizer(3);
+  Image image;
+  RenderStyle style;
+  style.background = kBlack;
+  style.antialias = false;
+  Camera camera;
+  camera.keep_aspect = false;
+  const int width = Rasterizer::kTileSize * 3;
+
+  rasterizer.Render(mesh, camera, style, width, 101, image);
+  for (int x = 0; x < width; ++x) {
+    EXPECT_EQ(image.At(x, 50), kWhite) << x;
+  }
+  EXPECT_EQ(CountPixels(image, kWhite), static_cast<size_t>(width));
+}
+
+TEST(RasterizerTest, Render_ClipsDepthRange) {
+  // Ребро уходит за дальнюю плоскость z = 1 и обрезается на ней, как в
+  // OpenGL: видна только часть от x = -1 до x = -1/7
+  const RenderMesh mesh = MakeMesh("v -1 0 -0.5\nv 1 0 3\nf 1 2\n");
+  Rasterizer rasterizer;
+  Image image;
+  RenderStyle style;
+  style.background = kBlack;
+  style.antialias = false;
+
+  EXPECT_EQ(rasterizer.Render(mesh, Camera(), style, 101, 101, image), 1u);
+  EXPECT_EQ(image.At(20, 50), kWhite);
+  EXPECT_EQ(image.At(40, 50), kWhite);
+  EXPECT_EQ(image.At(50, 50), kBlack);
+  EXPECT_EQ(image.At(70, 50), kBlack);
+
+  const RenderMesh beyond = MakeMesh("v -1 0 2\nv 1 0 2\nf 1 2\n");
+  EXPECT_EQ(rasterizer.Render(beyond, Camera(), style, 32, 32, image), 0u);
+  EXPECT_EQ(CountPixels(image, kBlack), 32u * 32u);
+}
+
+TEST(RasterizerTest, Render_AntialiasSplitsCoverage) {
+  // Горизонталь на y = 0 попадает между строками 49 и 50 кадра 100x100:
+  // сглаживание делит яркость между ними пополам
+  const RenderMesh mesh = MakeMesh("v -0.5 0 0\nv 0.5 0 0\nf 1 2\n");
+  Rasterizer rasterizer;
+  Image image;
+  RenderStyle style;
+  style.background = kBlack;
+
+  rasterizer.Render(mesh, Camera(), style, 100, 100, image);
+  const uint32_t upper = image.At(50, 49);
+  const uint32_t lower = image.At(50, 50);
+  EXPECT_EQ(upper, lower);
+  EXPECT_NEAR(static_cast<double>(upper & 0xFF), 128.0, 2.0);
+  EXPECT_EQ(image.At(50, 48), kBlack);
+  EXPECT_EQ(CountPixels(image, kWhite), 0u);
+
+  style.antialias = false;
+  rasterizer.Render(mesh, Camera(), style, 100, 100, image);
+  EXPECT_GT(CountPixels(image, kWhite), 40u);
+}
+
+TEST(RasterizerTest, TileMatrix_MapsTileToFullFrame) {
+  // Плитка (2, 0) из 3 x 2: x в [1/3, 1], y в [-1, 0]
+  const Matrix4 m = TileMatrix(2, 0, 3, 2);
+  const auto map = [&m](double x, double y) {
+    return std::make_pair(m[0] * x + m[12], m[5] * y + m[13]);
+  };
+  EXPECT_NEAR(map(1.0 / 3.0, -1.0).first, -1.0, 1e-12);
+  EXPECT_NEAR(map(1.0 / 3.0, -1.0).second, -1.0, 1e-12);
+  EXPECT_NEAR(map(1.0, 0.0).first, 1.0, 1e-12);
+  EXPECT_NEAR(map(1.0, 0.0).second, 1.0, 1e-12);
+
+  const Matrix4 whole = TileMatrix(0, 0, 1, 1);
+  for (int i = 0; i < 16; ++i) {
+    EXPECT_DOUBLE_EQ(whole[i], i % 5 == 0 ? 1.0 : 0.0) << i;
+  }
+}
+
+TEST(ModelCacheTest, HitsMissesAndInvalidation) {
+  const std::string path = "test_cache_model.obj";
+  WriteFile(path, "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n");
+  ModelCache cache(1 << 20);
+  int error = kNoError;
+
+  auto first = cache.Get(path, error);
+  ASSERT_TRUE(first);
+  EXPECT_EQ(error, kNoError);
+  auto second = cache.Get(path, error);
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(cache.GetStats().hits, 1u);
+  EXPECT_EQ(cache.GetStats().misses, 1u);
+
+  // Файл изменился (другой размер) - запись перезагружается
+  WriteFile(path, "v 0 0 0\nv 1 0 0\nv 0 1 0\nv 1 1 0\nf 1 2 3 4\n");
+  auto third = cache.Get(path, error);
+  ASSERT_TRUE(third);
+  EXPECT_EQ(third->GetVertexCount(), 4u);
+  EXPECT_EQ(first->GetVertexCount(), 3u);
+  EXPECT_EQ(cache.GetStats().entries, 1u);
+
+  EXPECT_FALSE(cache.Get("missing_cache_model.obj", error));
+  EXPECT_EQ(error, kFailedToOpen);
+  EXPECT_FALSE(cache.Get("model.txt", error));
+  EXPECT_EQ(error, kFileWrongExtension);
+  std::remove(path.c_str());
+}
+
+TEST(ModelCacheTest, EvictsLeastRecentlyUsed) {
+  const std::vector<std::string> paths = {"test_cache_a.obj",
+                                          "test_cache_b.obj"};
+  for (const std::string& path : paths) {
+    WriteFile(path, "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n");
+  }
+  // Ёмкость меньше одной модели: остаётся только последняя
+  ModelCache cache(1);
+  int error = kNoError;
+  ASSERT_TRUE(cache.Get(paths[0], error));
+  ASSERT_TRUE(cache.Get(paths[1], error));
+  EXPECT_EQ(cache.GetStats().entries, 1u);
+  EXPECT_EQ(cache.GetStats().evictions, 1u);
+  for (const std::string& path : paths) std::remove(path.c_str());
+}
+
+TEST(ModelCacheTest, ConcurrentRequestsParseOnce) {
+  const std::string path = "test_cache_concurrent.obj";
+  std::string obj;
+  for (int i = 0; i < 20000; ++i) obj += "v 0 0 0\nv 1 0 0\nv 0 1 0\n";
+  WriteFile(path, obj + "f 1 2 3\n");
+
+  ModelCache cache(64 << 20);
+  std::vector<std::thread> threads;
+  std::vector<std::shared_ptr<const RenderMesh>> meshes(8);
+  for (size_t i = 0; i < meshes.size(); ++i) {
+    threads.emplace_back([&, i] {
+      int error = kNoError;
+      meshes[i] = cache.Get(path, error);
+    });
+  }
+  for (std::thread& thread : threads) thread.join();
+
+  EXPECT_EQ(cache.GetStats().misses, 1u);
+  for (const auto& mesh : meshes) EXPECT_EQ(mesh, meshes[0]);
+  std::remove(path.c_str());
+}
@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../cli/render_service.h"
+
+using namespace s21;
+
+namespace {
+
+/**
+ * @brief Простой блокирующий клиент протокола сервиса
+ */
+class Client {
+ public:
+  explicit Client(int port) {
+    fd_ = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(static_cast<uint16_t>(port));
+    connected_ = connect(fd_, reinterpret_cast<sockaddr*>(&address),
+                         sizeof(address)) == 0;
+  }
+
+  explicit Client(const std::string& path) {
+    fd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strcpy(address.sun_path, path.c_str());
+    connected_ = connect(fd_, reinterpret_cast<sockaddr*>(&address),
+                         sizeof(address)) == 0;
+  }
+
+  ~Client() { close(fd_); }
+
+  bool IsConnected() const { return connected_; }
+
+  /**
+   * @brief Отправляет команду и возвращает заголовок и тело ответа
+   */
+  std::string Request(const std::string& command, std::string& body) {
+    const std::string line = command + '\n';
+    if (send(fd_, line.data(), line.size(), MSG_NOSIGNAL) < 0) return "";
+    std::string header;
+    char c = 0;
+    while (recv(fd_, &c, 1, 0) == 1 && c != '\n') header += c;
+
+    body.clear();
+    if (header.compare(0, 3, "ok ") == 0) {
+      body.resize(std::stoul(header.substr(3)));
+      size_t received = 0;
+      while (received < body.size()) {
+        const ssize_t n =
+            recv(fd_, &body[received], body.size() - received, 0);
+        if (n <= 0) break;
+        received += static_cast<size_t>(n);
+      }
+    }
+    return header;
+  }
+
+ private:
+  int fd_ = -1;
+  bool connected_ = false;
+};
+
+}  // namespace
+
+class RenderServiceTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    std::ofstream file(model_);
+    file << "v -0.5 -0.5 0\nv 0.5 -0.5 0\nv 0.5 0.5 0\nv -0.5 0.5 0\n";
+    file << "f 1 2 3 4\n";
+  }
+
+  void TearDown() override { std::remove(model_.c_str()); }
+
+  std::string model_ = "test_service_model.obj";
+};
+
+TEST(RenderRequestTest, ParsesKeys) {
+  RenderRequest request;
+  std::string error;
+  ASSERT_TRUE(ParseRenderRequest(
+      "render a.obj width=320 height=200 rx=10 ry=-20 tz=0.5 scale=2 "
+      "projection=perspective style=both color=ff0000 background=#000000 "
+      "point_size=5",
+      request, error))
+      << error;
+  EXPECT_EQ(request.path, "a.obj");
+  EXPECT_EQ(request.width, 320);
+  EXPECT_EQ(request.height, 200);
+  EXPECT_DOUBLE_EQ(request.camera.rotation[0], 10.0);
+  EXPECT_DOUBLE_EQ(request.camera.rotation[1], -20.0);
+  EXPECT_DOUBLE_EQ(request.camera.translate[2], 0.5);
+  EXPECT_DOUBLE_EQ(request.camera.scale, 2.0);
+  EXPECT_EQ(request.camera.projection, kProjectionPerspective);
+  EXPECT_EQ(request.style.style, kStyleBoth);
+  EXPECT_EQ(request.style.line_color, MakeColor(255, 0, 0));
+  EXPECT_EQ(request.style.background, MakeColor(0, 0, 0));
+  EXPECT_EQ(request.style.point_size, 5);
+}
+
+TEST(RenderRequestTest, RejectsBadInput) {
+  RenderRequest request;
+  std::string error;
+  EXPECT_FALSE(ParseRenderRequest("render", request, error));
+  EXPECT_FALSE(ParseRenderRequest("draw a.obj", request, error));
+  EXPECT_FALSE(ParseRenderRequest("render a.obj width=0", request, error));
+  EXPECT_FALSE(ParseRenderRequest("render a.obj width=9x", request, error));
+  EXPECT_FALSE(ParseRenderRequest("render a.obj color=red", request, error));
+  EXPECT_FALSE(ParseRenderRequest("render a.obj fov=30", request, error));
+  EXPECT_NE(error.find("fov"), std::string::npos);
+}
+
+TEST_F(RenderServiceTest, TcpRendersAndCaches) {
+  RenderService::Options options;
+  options.workers = 2;
+  RenderService service(options);
+  std::string error;
+  ASSERT_TRUE(service.Start(error)) << error;
+  ASSERT_GT(service.GetPort(), 0);
+
+  Client client(service.GetPort());
+  ASSERT_TRUE(client.IsConnected());
+  std::string body;
+  EXPECT_EQ(client.Request("render " + model_ + " width=64 height=48", body)
+                .substr(0, 3),
+            "ok ");
+  EXPECT_EQ(body.compare(0, 8, "\x89PNG\r\n\x1a\n"), 0);
+  client.Request("render " + model_ + " rz=45", body);
+  EXPECT_EQ(client.Request("render missing.obj", body),
+            "error failed to open missing.obj");
+  EXPECT_EQ(client.Request("bogus", body).substr(0, 6), "error ");
+
+  client.Request("stats", body);
+  EXPECT_NE(body.find("renders 2\n"), std::string::npos);
+  EXPECT_NE(body.find("errors 2\n"), std::string::npos);
+  EXPECT_NE(body.find("cache_hits 1\n"), std::string::npos);
+  EXPECT_NE(body.find("cache_misses 1\n"), std::string::npos);
+  service.Stop();
+}
+
+TEST_F(RenderServiceTest, UnixSocketConcurrentClients) {
+  RenderService::Options options;
+  options.socket_path = "test_render_service.sock";
+  options.workers = 3;
+  RenderService service(options);
+  std::string error;
+  ASSERT_TRUE(service.Start(error)) << error;
+
+  std::vector<std::thread> clients;
+  std::vector<int> ok(4, 0);
+  for (size_t i = 0; i < ok.size(); ++i) {
+    clients.emplace_back([&, i] {
+      Client client(options.socket_path);
+      std::string body;
+      for (int r = 0; r < 5 && client.IsConnected(); ++r) {
+        const std::string header = client.Request(
+            "render " + model_ + " width=32 height=32 ry=" + std::to_string(r),
+            body);
+        ok[i] += header.compare(0, 3, "ok ") == 0 && body.size() > 8;
+      }
+      client.Request("quit", body);
+    });
+  }
+  for (std::thread& client : clients) client.join();
+  for (int count : ok) EXPECT_EQ(count, 5);
+
+  Client client(options.socket_path);
+  std::string body;
+  client.Request("stats", body);
+  EXPECT_NE(body.find("renders 20\n"), std::string::npos);
+  EXPECT_NE(body.find("cache_misses 1\n"), std::string::npos);
+
+  // Остановка при открытом соединении не должна зависать
+  service.Stop();
+  EXPECT_NE(access(options.socket_path.c_str(), F_OK), 0);
+}
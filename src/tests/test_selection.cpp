@@ -0,0 +1,220 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "../render/picker.h"
+
+using namespace s21;
+
+namespace {
+
+std::vector<float> RandomPoints(size_t count, unsigned seed) {
+  std::mt19937 random(seed);
+  std::uniform_real_distribution<float> coordinate(-0.9f, 0.9f);
+  std::vector<float> points(count * 3);
+  for (float& value : points) value = coordinate(random);
+  return points;
+}
+
+/**
+ * @brief Пятиконечная звезда (невыпуклое лассо) с центром в (cx, cy)
+ */
+std::vector<double> Star(double cx, double cy, double radius) {
+  std::vector<double> points;
+  for (int i = 0; i < 10; ++i) {
+    const double angle = 3.141592653589793 * i / 5.0;
+    const double r = i % 2 == 0 ? radius : radius * 0.4;
+    points.push_back(cx + r * std::sin(angle));
+    points.push_back(cy - r * std::cos(angle));
+  }
+  return points;
+}
+
+/**
+ * @brief Вершины, выделяемые полным перебором
+ */
+std::vector<uint32_t> BruteForce(const std::vector<float>& points,
+                                 const Camera& camera, int width, int height,
+                                 const ScreenRegion& region) {
+  const Matrix4 m = camera.BuildMatrix(width, height);
+  std::vector<uint32_t> selected;
+  for (uint32_t i = 0; i < points.size() / 3; ++i) {
+    const float* p = &points[i * 3];
+    const double x = m[0] * p[0] + m[4] * p[1] + m[8] * p[2] + m[12];
+    const double y = m[1] * p[0] + m[5] * p[1] + m[9] * p[2] + m[13];
+    const double z = m[2] * p[0] + m[6] * p[1] + m[10] * p[2] + m[14];
+    const double w = m[3] * p[0] + m[7] * p[1] + m[11] * p[2] + m[15];
+    if (w < Camera::kNearPlane || z < -w || z > w) continue;
+    if (region.Contains((x / w + 1.0) * width * 0.5,
+                        (1.0 - y / w) * height * 0.5)) {
+      selected.push_back(i);
+    }
+  }
+  return selected;
+}
+
+std::vector<uint32_t> Selected(const Picker& picker,
+                               const SelectionBits& selection) {
+  std::vector<uint32_t> vertices;
+  picker.GetSelectedVertices(selection, vertices);
+  std::sort(vertices.begin(), vertices.end());
+  return vertices;
+}
+
+}  // namespace
+
+TEST(SelectionBits, RangesAndModes) {
+  for (size_t size : {1u, 63u, 64u, 65u, 200u}) {
+    for (size_t begin = 0; begin <= size; begin += 7) {
+      for (size_t end = begin; end <= size; end += 11) {
+        SelectionBits bits;
+        bits.Reset(size);
+        bits.SetRange(begin, end);
+        ASSERT_EQ(bits.Count(), end - begin);
+        for (size_t i = 0; i < size; ++i) {
+          ASSERT_EQ(bits.Test(i), i >= begin && i < end) << size << " " << i;
+        }
+      }
+    }
+  }
+
+  SelectionBits a, b;
+  a.Reset(100);
+  b.Reset(100);
+  a.SetRange(10, 50);
+  b.SetRange(40, 70);
+  SelectionBits added = a;
+  added.Combine(b, kSelectAdd);
+  EXPECT_EQ(added.Count(), 60u);
+  SelectionBits subtracted = a;
+  subtracted.Combine(b, kSelectSubtract);
+  EXPECT_EQ(subtracted.Count(), 30u);
+  EXPECT_FALSE(subtracted.Test(45));
+  a.Combine(b, kSelectReplace);
+  EXPECT_EQ(a.Count(), 30u);
+
+  std::vector<size_t> visited;
+  a.ForEach([&](size_t i) { visited.push_back(i); });
+  ASSERT_EQ(visited.size(), 30u);
+  EXPECT_EQ(visited.front(), 40u);
+  EXPECT_EQ(visited.back(), 69u);
+}
+
+TEST(ScreenRegion, LassoClassifyAgreesWithContains) {
+  const ScreenRegion lasso = ScreenRegion::Lasso(Star(100, 100, 80), 200, 200);
+  ASSERT_FALSE(lasso.IsEmpty());
+  EXPECT_TRUE(lasso.Contains(100.5, 100.5));
+  EXPECT_FALSE(lasso.Contains(5.0, 5.0));
+  EXPECT_FALSE(lasso.Contains(-1.0, 100.0));
+  EXPECT_FALSE(lasso.Contains(100.0, 250.0));
+
+  std::mt19937 random(1);
+  std::uniform_real_distribution<double> coordinate(-20.0, 220.0);
+  std::uniform_real_distribution<double> size(0.0, 40.0);
+  int inside = 0, outside = 0;
+  for (int i = 0; i < 2000; ++i) {
+    const double x0 = coordinate(random), y0 = coordinate(random);
+    const double x1 = x0 + size(random), y1 = y0 + size(random);
+    const bvh_overlap_t overlap = lasso.Classify(x0, y0, x1, y1);
+    inside += overlap == kBvhInside;
+    outside += overlap == kBvhOutside;
+    if (overlap == kBvhPartial) continue;
+    for (int k = 0; k <= 8; ++k) {
+      for (int m = 0; m <= 8; ++m) {
+        ASSERT_EQ(lasso.Contains(x0 + (x1 - x0) * k / 8.0,
+                                 y0 + (y1 - y0) * m / 8.0),
+                  overlap == kBvhInside);
+      }
+    }
+  }
+  EXPECT_GT(inside, 10);
+  EXPECT_GT(outside, 10);
+
+  EXPECT_TRUE(ScreenRegion::Lasso({1.0, 1.0, 2.0, 2.0}, 10, 10).IsEmpty());
+  EXPECT_TRUE(ScreenRegion::Rect(5.0, 5.0, 5.0, 9.0).IsEmpty());
+}
+
+TEST(PickerSelection, RectAndLassoMatchBruteForce) {
+  const std::vector<float> points = RandomPoints(20000, 2);
+  Picker picker(2);
+  picker.Build(points, {});
+  Camera camera;
+  camera.rotation[0] = 20.0;
+  camera.rotation[1] = 35.0;
+  camera.projection = kProjectionPerspective;
+  constexpr int kWidth = 320, kHeight = 240;
+
+  const ScreenRegion regions[] = {
+      ScreenRegion::Rect(250.0, 40.0, 60.0, 200.0),
+      ScreenRegion::Rect(-50.0, -50.0, 400.0, 300.0),
+      ScreenRegion::Lasso(Star(160, 120, 110), kWidth, kHeight)};
+  for (const ScreenRegion& region : regions) {
+    SelectionBits selection;
+    picker.Select(camera, kWidth, kHeight, region, kSelectReplace, selection);
+    const std::vector<uint32_t> expected =
+        BruteForce(points, camera, kWidth, kHeight, region);
+    ASSERT_FALSE(expected.empty());
+    EXPECT_EQ(Selected(picker, selection), expected);
+
+    const SelectionStats stats = picker.Summarize(selection);
+    EXPECT_EQ(stats.count, expected.size());
+    for (int axis = 0; axis < 3; ++axis) {
+      float lo = INFINITY, hi = -INFINITY;
+      for (uint32_t i : expected) {
+        lo = std::min(lo, points[i * 3 + axis]);
+        hi = std::max(hi, points[i * 3 + axis]);
+      }
+      EXPECT_EQ(stats.min[axis], lo);
+      EXPECT_EQ(stats.max[axis], hi);
+    }
+  }
+}
+
+TEST(PickerSelection, ModesCombineSelections) {
+  const std::vector<float> points = RandomPoints(5000, 3);
+  Picker picker;
+  picker.Build(points, {});
+  Camera camera;
+  const ScreenRegion left = ScreenRegion::Rect(0.0, 0.0, 120.0, 200.0);
+  const ScreenRegion right = ScreenRegion::Rect(80.0, 0.0, 200.0, 200.0);
+  const size_t left_count = BruteForce(points, camera, 200, 200, left).size();
+  const size_t right_count = BruteForce(points, camera, 200, 200, right).size();
+  const size_t both_count =
+      BruteForce(points, camera, 200, 200,
+                 ScreenRegion::Rect(80.0, 0.0, 120.0, 200.0))
+          .size();
+
+  SelectionBits selection;
+  picker.Select(camera, 200, 200, left, kSelectReplace, selection);
+  EXPECT_EQ(selection.Count(), left_count);
+  picker.Select(camera, 200, 200, right, kSelectAdd, selection);
+  EXPECT_EQ(selection.Count(), left_count + right_count - both_count);
+  picker.Select(camera, 200, 200, right, kSelectSubtract, selection);
+  EXPECT_EQ(selection.Count(), left_count - both_count);
+
+  // Пустая область при замене снимает выделение
+  picker.Select(camera, 200, 200, ScreenRegion(), kSelectReplace, selection);
+  EXPECT_EQ(selection.Count(), 0u);
+  EXPECT_EQ(picker.Summarize(selection).count, 0u);
+}
+
+TEST(PickerSelection, SelectionSurvivesRefit) {
+  std::vector<float> points = RandomPoints(3000, 4);
+  Picker picker;
+  picker.Build(points, {});
+  Camera camera;
+  SelectionBits selection;
+  picker.Select(camera, 200, 200, ScreenRegion::Rect(0, 0, 100, 200),
+                kSelectReplace, selection);
+  const std::vector<uint32_t> before = Selected(picker, selection);
+
+  for (size_t i = 1; i < points.size(); i += 3) points[i] += 1.0f;
+  picker.Refit(points);
+  EXPECT_EQ(Selected(picker, selection), before);
+  const SelectionStats stats = picker.Summarize(selection);
+  EXPECT_EQ(stats.count, before.size());
+  EXPECT_GT(stats.min[1], 0.0);
+}
@@ -0,0 +1,207 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../model/slicer.h"
+#include "test_meshes.h"
+
+using namespace s21;
+using s21::test::MakeSphere;
+
+namespace {
+
+/**
+ * @brief Граней, вершины которых по обе стороны плоскости (перебор)
+ */
+size_t CountCrossedFaces(const Mesh& mesh, const SlicePlane& plane) {
+  size_t crossed = 0;
+  for (size_t f = 0; f < mesh.GetFaceCount(); ++f) {
+    bool above = false, below = false;
+    for (int i = mesh.face_offset[f]; i < mesh.face_offset[f + 1]; ++i) {
+      const double* p = &mesh.vertex_coord[mesh.face_index[i] * 3];
+      const double d = plane.normal[0] * float(p[0]) +
+                       plane.normal[1] * float(p[1]) +
+                       plane.normal[2] * float(p[2]) - plane.offset;
+      (d > 0.0 ? above : below) = true;
+    }
+    crossed += above && below;
+  }
+  return crossed;
+}
+
+double PlaneDistance(const SlicePlane& plane, const double* p) {
+  return plane.normal[0] * p[0] + plane.normal[1] * p[1] +
+         plane.normal[2] * p[2] - plane.offset;
+}
+
+}  // namespace
+
+TEST(SlicerTest, SphereSectionIsOneClosedLoop) {
+  const Mesh mesh = MakeSphere(64, 96, 1.0);
+  Slicer slicer(3);
+  slicer.Build(mesh);
+  ASSERT_EQ(slicer.GetFaceCount(), mesh.GetFaceCount());
+
+  SlicePlane planes[3];
+  planes[0].offset = 0.3;
+  planes[1].normal[0] = 1.0;
+  planes[1].normal[1] = 2.0;
+  planes[1].normal[2] = -0.5;
+  planes[1].offset = 0.4;
+  planes[2].normal[0] = 0.0;
+  planes[2].normal[1] = 1.0;
+  planes[2].normal[2] = 0.0;
+  planes[2].offset = 0.013;  // мимо вершин: касания проверяются ниже
+  for (const SlicePlane& plane : planes) {
+    const Section section = slicer.Slice(plane);
+    EXPECT_EQ(section.segment_count, CountCrossedFaces(mesh, plane));
+    EXPECT_LT(section.faces_tested, mesh.GetFaceCount() / 4);
+    ASSERT_EQ(section.polylines.size(), 1u);
+    EXPECT_TRUE(section.polylines[0].closed);
+    EXPECT_EQ(section.GetPointCount(), section.segment_count);
+
+    const double length = std::sqrt(plane.normal[0] * plane.normal[0] +
+                                     plane.normal[1] * plane.normal[1] +
+                                     plane.normal[2] * plane.normal[2]);
+    const std::vector<double>& points = section.polylines[0].points;
+    for (size_t i = 0; i < points.size(); i += 3) {
+      EXPECT_NEAR(PlaneDistance(plane, &points[i]) / length, 0.0, 1e-6);
+      const double radius = std::sqrt(points[i] * points[i] +
+                                      points[i + 1] * points[i + 1] +
+                                      points[i + 2] * points[i + 2]);
+      EXPECT_LE(radius, 1.0 + 1e-6);
+    }
+  }
+
+  // Плоскость мимо модели и вырожденная нормаль
+  SlicePlane outside;
+  outside.offset = 2.0;
+  EXPECT_TRUE(slicer.Slice(outside).polylines.empty());
+  SlicePlane degenerate;
+  degenerate.normal[2] = 0.0;
+  EXPECT_TRUE(slicer.Slice(degenerate).polylines.empty());
+}
+
+TEST(SlicerTest, PlaneThroughVerticesAndOpenBoundary) {
+  // Экватор z = 0 проходит точно через кольцо вершин
+  Mesh mesh = MakeSphere(16, 24, 1.0);
+  for (size_t i = 2; i < mesh.vertex_coord.size(); i += 3) {
+    if (std::abs(mesh.vertex_coord[i]) < 1e-12) mesh.vertex_coord[i] = 0.0;
+  }
+  Slicer slicer;
+  slicer.Build(mesh);
+  SlicePlane equator;
+  const Section closed = slicer.Slice(equator);
+  ASSERT_EQ(closed.polylines.size(), 1u);
+  EXPECT_TRUE(closed.polylines[0].closed);
+  EXPECT_EQ(closed.GetPointCount(), 24u);
+
+  // Без нижней половины сферы вертикальная плоскость даёт открытую дугу
+  Mesh open = mesh;
+  open.face_index.clear();
+  open.face_offset.assign(1, 0);
+  for (size_t f = 0; f < mesh.GetFaceCount(); ++f) {
+    const int begin = mesh.face_offset[f], end = mesh.face_offset[f + 1];
+    bool lower = false;
+    for (int i = begin; i < end; ++i) {
+      lower = lower || mesh.vertex_coord[mesh.face_index[i] * 3 + 2] < -0.5;
+    }
+    if (lower) continue;
+    open.face_index.insert(open.face_index.end(),
+                           mesh.face_index.begin() + begin,
+                           mesh.face_index.begin() + end);
+    open.face_offset.push_back(static_cast<int>(open.face_index.size()));
+  }
+  slicer.Build(open);
+  SlicePlane vertical;
+  vertical.normal[0] = 1.0;
+  vertical.normal[2] = 0.0;
+  vertical.offset = 0.1;
+  const Section arc = slicer.Slice(vertical);
+  ASSERT_EQ(arc.polylines.size(), 1u);
+  EXPECT_FALSE(arc.polylines[0].closed);
+  EXPECT_EQ(arc.GetPointCount(), arc.segment_count + 1);
+}
+
+TEST(SlicerTest, NonManifoldEdgeBreaksContours) {
+  // Три квадрата с общим вертикальным ребром (0, 1)
+  Mesh mesh;
+  mesh.vertex_coord = {0, 0, 0, 0, 0, 1, 1, 0, 0, 1, 0, 1,
+                       0, 1, 0, 0, 1, 1, -1, 0, 0, -1, 0, 1};
+  mesh.face_index = {0, 2, 3, 1, 0, 4, 5, 1, 0, 6, 7, 1};
+  mesh.face_offset = {0, 4, 8, 12};
+  Slicer slicer;
+  slicer.Build(mesh);
+  SlicePlane plane;
+  plane.offset = 0.5;
+  const Section section = slicer.Slice(plane);
+  EXPECT_EQ(section.segment_count, 3u);
+  ASSERT_EQ(section.polylines.size(), 3u);
+  for (const SectionPolyline& polyline : section.polylines) {
+    EXPECT_FALSE(polyline.closed);
+    EXPECT_EQ(polyline.points.size(), 6u);
+  }
+}
+
+TEST(SlicerTest, RefitFollowsTransformedVertices) {
+  Mesh mesh = MakeSphere(32, 48, 1.0);
+  Slicer slicer(2);
+  slicer.Build(mesh);
+  SlicePlane plane;
+  plane.offset = 1.5;
+  EXPECT_TRUE(slicer.Slice(plane).polylines.empty());
+
+  std::vector<float> moved(mesh.vertex_coord.begin(), mesh.vertex_coord.end());
+  for (size_t i = 2; i < moved.size(); i += 3) moved[i] += 1.0f;
+  // Refit возвращает прежние координаты для повторного использования
+  const std::vector<float> previous = slicer.Refit(moved);
+  EXPECT_EQ(previous.size(), moved.size());
+  EXPECT_EQ(previous[2], static_cast<float>(mesh.vertex_coord[2]));
+  const Section section = slicer.Slice(plane);
+  ASSERT_EQ(section.polylines.size(), 1u);
+  EXPECT_TRUE(section.polylines[0].closed);
+  EXPECT_NEAR(section.polylines[0].points[2], 1.5, 1e-6);
+}
+
+TEST(SlicerTest, ExportWritesVerticesAndPolylines) {
+  const Mesh mesh = MakeSphere(12, 16, 1.0);
+  Slicer slicer;
+  slicer.Build(mesh);
+  SlicePlane plane;
+  plane.offset = 0.2;
+  const Section section = slicer.Slice(plane);
+  ASSERT_EQ(section.polylines.size(), 1u);
+
+  const std::string path = "test_section_export.obj";
+  ASSERT_EQ(ExportSection(section, path), kNoError);
+  std::ifstream file(path);
+  std::string line;
+  size_t vertices = 0;
+  std::vector<int> polyline;
+  while (std::getline(file, line)) {
+    std::istringstream words(line);
+    std::string tag;
+    words >> tag;
+    if (tag == "v") {
+      double x = 0, y = 0, z = 0;
+      words >> x >> y >> z;
+      EXPECT_NEAR(z, 0.2, 1e-6);
+      ++vertices;
+    } else if (tag == "l") {
+      for (int index; words >> index;) polyline.push_back(index);
+    }
+  }
+  std::remove(path.c_str());
+  EXPECT_EQ(vertices, section.GetPointCount());
+  // Замкнутый контур: первая вершина повторяется в конце
+  ASSERT_EQ(polyline.size(), vertices + 1);
+  EXPECT_EQ(polyline.front(), 1);
+  EXPECT_EQ(polyline.back(), 1);
+
+  EXPECT_EQ(ExportSection(section, "no_such_dir/section.obj"), kFailedToWrite);
+}
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <vector>
+
+#include "../profiling/soak.h"
+#include "../profiling/telemetry.h"
+
+using namespace s21;
+
+namespace {
+
+std::vector<TelemetrySample> MakeRun(double rss_growth_kb_per_s,
+                                     double frame_growth_ms_per_s) {
+  std::vector<TelemetrySample> samples;
+  for (int i = 0; i < 8000; ++i) {
+    TelemetrySample sample;
+    sample.time_s = i * 0.01;
+    sample.kind = i % 50 == 0 ? kTelemetryTransform : kTelemetryFrame;
+    // Пилообразный шум поверх тренда
+    sample.duration_ms = 4.0 + (i % 7) * 0.1 + frame_growth_ms_per_s * i * 0.01;
+    sample.rss_kb = static_cast<int64_t>(100000 + (i % 13) * 10 +
+                                         rss_growth_kb_per_s * i * 0.01);
+    samples.push_back(sample);
+  }
+  return samples;
+}
+
+}  // namespace
+
+TEST(TelemetryTest, ReadMemoryStats_ReportsRss) {
+  const MemoryStats stats = ReadMemoryStats();
+  EXPECT_GT(stats.rss_kb, 0);
+}
+
+TEST(TelemetryTest, WriteRead_RoundTrip) {
+  const std::string path = "test_telemetry.csv";
+  {
+    TelemetryWriter writer;
+    ASSERT_TRUE(writer.Open(path));
+    writer.Append(kTelemetryLoad, 12.5, 64);
+    writer.Append(kTelemetryFrame, 3.25, 64);
+    writer.Append(kTelemetryTransform, 0.5, 128);
+    EXPECT_EQ(writer.GetSampleCount(), 3u);
+  }
+
+  std::vector<TelemetrySample> samples;
+  ASSERT_TRUE(ReadTelemetryCsv(path, samples));
+  ASSERT_EQ(samples.size(), 3u);
+  EXPECT_EQ(samples[0].kind, kTelemetryLoad);
+  EXPECT_DOUBLE_EQ(samples[0].duration_ms, 12.5);
+  EXPECT_EQ(samples[2].kind, kTelemetryTransform);
+  EXPECT_EQ(samples[2].cache_kb, 128);
+  EXPECT_GT(samples[1].rss_kb, 0);
+  EXPECT_LE(samples[0].time_s, samples[2].time_s);
+  std::remove(path.c_str());
+}
+
+TEST(TelemetryTest, Read_RejectsForeignFile) {
+  const std::string path = "test_telemetry_foreign.csv";
+  std::FILE* file = std::fopen(path.c_str(), "w");
+  std::fputs("a,b,c\n1,2,3\n", file);
+  std::fclose(file);
+
+  std::vector<TelemetrySample> samples;
+  EXPECT_FALSE(ReadTelemetryCsv(path, samples));
+  EXPECT_FALSE(ReadTelemetryCsv("missing_telemetry.csv", samples));
+  std::remove(path.c_str());
+}
+
+TEST(DriftTest, StableRun_NoDrift) {
+  const DriftReport report = CheckDrift(MakeRun(0.0, 0.0));
+  EXPECT_FALSE(report.HasDrift());
+  EXPECT_EQ(report.windows_used, 7u);
+}
+
+TEST(DriftTest, LeakingRun_FlagsRssGrowth) {
+  // 1 МиБ/с в течение 80 с
+  const DriftReport report = CheckDrift(MakeRun(1024.0, 0.0));
+  EXPECT_TRUE(report.rss_growth);
+  EXPECT_FALSE(report.frame_drift);
+  EXPECT_GT(report.rss_end_kb, report.rss_start_kb);
+}
+
+TEST(DriftTest, SlowingRun_FlagsFrameDrift) {
+  const DriftReport report = CheckDrift(MakeRun(0.0, 0.05));
+  EXPECT_FALSE(report.rss_growth);
+  EXPECT_TRUE(report.frame_drift);
+  EXPECT_NE(report.Summary().find("[DRIFT]"), std::string::npos);
+}
+
+TEST(DriftTest, WarmupGrowth_Ignored) {
+  std::vector<TelemetrySample> samples = MakeRun(0.0, 0.0);
+  // Рост памяти только в первом окне (прогрев кэшей)
+  for (TelemetrySample& sample : samples) {
+    if (sample.time_s < 5.0) sample.rss_kb -= 50000;
+  }
+  EXPECT_FALSE(CheckDrift(samples).rss_growth);
+}
+
+TEST(SoakScriptTest, BuildSoakScript_LoadsEachModel) {
+  const auto script = BuildSoakScript({"a.obj", "b.obj"}, 10);
+  int loads = 0;
+  for (size_t i = 0; i < script.size(); ++i) {
+    if (script[i].type == kEventLoad) ++loads;
+    if (i > 0) EXPECT_GT(script[i].time_us, script[i - 1].time_us);
+  }
+  EXPECT_EQ(loads, 2);
+  EXPECT_EQ(script.front().text, "a.obj");
+  EXPECT_TRUE(BuildSoakScript({}).empty());
+}
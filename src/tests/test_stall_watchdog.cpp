@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include "../profiling/stall_watchdog.h"
+#include "../profiling/trace.h"
+
+using namespace s21;
+using std::chrono::milliseconds;
+
+TEST(StallWatchdogTest, ResponsiveThread_NoStalls) {
+  StallWatchdog watchdog(milliseconds(50));
+  watchdog.Start();
+  for (int i = 0; i < 30; ++i) {
+    watchdog.Heartbeat();
+    std::this_thread::sleep_for(milliseconds(5));
+  }
+  watchdog.Stop();
+
+  EXPECT_EQ(watchdog.GetStallCount(), 0u);
+}
+
+TEST(StallWatchdogTest, BlockedThread_StallWithSpanAndStack) {
+  StallWatchdog watchdog(milliseconds(30));
+  watchdog.Start();
+  watchdog.Heartbeat();
+  {
+    S21_TRACE_SCOPE("test/blocking_work");
+    std::this_thread::sleep_for(milliseconds(200));
+  }
+  for (int i = 0; i < 8; ++i) {
+    watchdog.Heartbeat();
+    std::this_thread::sleep_for(milliseconds(5));
+  }
+  watchdog.Stop();
+
+  ASSERT_EQ(watchdog.GetStallCount(), 1u);
+  std::vector<StallRecord> log = watchdog.GetLog();
+  ASSERT_EQ(log.size(), 1u);
+  EXPECT_EQ(log[0].span, "test/blocking_work");
+  EXPECT_GE(log[0].duration_ms, 150.0);
+  EXPECT_FALSE(log[0].stack.empty());
+  EXPECT_EQ(watchdog.GetStallCounts()["test/blocking_work"], 1u);
+  EXPECT_NE(watchdog.Report().find("test/blocking_work"), std::string::npos);
+}
+
+TEST(StallWatchdogTest, Ping_CalledPeriodically) {
+  StallWatchdog watchdog(milliseconds(20));
+  std::atomic<int> pings{0};
+  watchdog.SetPingFunction([&pings] { ++pings; });
+  watchdog.Start();
+  std::this_thread::sleep_for(milliseconds(60));
+  watchdog.Stop();
+
+  EXPECT_GT(pings.load(), 3);
+}
@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "../profiling/startup_profiler.h"
+
+using namespace s21;
+
+class StartupProfilerTest : public ::testing::Test {
+ protected:
+  void SetUp() override { StartupProfiler::GetInstance().Reset(); }
+  void TearDown() override { StartupProfiler::GetInstance().Reset(); }
+};
+
+TEST_F(StartupProfilerTest, Mark_OrderedTimeline) {
+  StartupProfiler& startup = StartupProfiler::GetInstance();
+  startup.Mark("main");
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  startup.Mark("QApplication");
+
+  EXPECT_EQ(startup.GetMarkCount(), 2u);
+  EXPECT_GE(startup.GetMarkMs("QApplication") - startup.GetMarkMs("main"),
+            5.0);
+  EXPECT_DOUBLE_EQ(startup.GetMarkMs("missing"), -1.0);
+}
+
+TEST_F(StartupProfilerTest, MarkOnce_KeepsFirst) {
+  StartupProfiler& startup = StartupProfiler::GetInstance();
+  startup.MarkOnce("first paintGL");
+  const double first = startup.GetMarkMs("first paintGL");
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  startup.MarkOnce("first paintGL");
+
+  EXPECT_EQ(startup.GetMarkCount(), 1u);
+  EXPECT_DOUBLE_EQ(startup.GetMarkMs("first paintGL"), first);
+}
+
+TEST_F(StartupProfilerTest, Mark_DropsOverflow) {
+  StartupProfiler& startup = StartupProfiler::GetInstance();
+  for (size_t i = 0; i < StartupProfiler::kMaxMarks + 5; ++i) {
+    startup.Mark("phase");
+  }
+  EXPECT_EQ(startup.GetMarkCount(), StartupProfiler::kMaxMarks);
+}
+
+TEST_F(StartupProfilerTest, Report_ListsPhases) {
+  StartupProfiler& startup = StartupProfiler::GetInstance();
+  startup.Mark("View::setupUi");
+  startup.Mark("GL context");
+
+  const std::string report = startup.Report();
+  EXPECT_NE(report.find("View::setupUi"), std::string::npos);
+  EXPECT_LT(report.find("View::setupUi"), report.find("GL context"));
+}
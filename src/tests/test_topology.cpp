@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "../model/topology.h"
+#include "test_meshes.h"
+
+using namespace s21;
+using s21::test::AddSphere;
+
+namespace {
+
+/**
+ * @brief Сетка columns x rows четырёхугольников в плоскости z = 0
+ */
+void AddGrid(Mesh& mesh, int columns, int rows) {
+  const int base = static_cast<int>(mesh.GetVertexCount());
+  for (int y = 0; y <= rows; ++y) {
+    for (int x = 0; x <= columns; ++x) {
+      mesh.vertex_coord.insert(mesh.vertex_coord.end(), {double(x), double(y),
+                                                         0.0});
+    }
+  }
+  for (int y = 0; y < rows; ++y) {
+    for (int x = 0; x < columns; ++x) {
+      const int a = base + y * (columns + 1) + x;
+      mesh.face_index.insert(mesh.face_index.end(),
+                             {a, a + 1, a + columns + 2, a + columns + 1});
+      mesh.face_offset.push_back(static_cast<int>(mesh.face_index.size()));
+    }
+  }
+}
+
+}  // namespace
+
+TEST(TopologyTest, ClosedSphereIsOneShell) {
+  Mesh mesh;
+  AddSphere(mesh, 24, 32, 1.0);
+  Topology topology(3);
+  topology.Build(mesh);
+  const TopologyStats& stats = topology.GetStats();
+  EXPECT_EQ(stats.face_count, mesh.GetFaceCount());
+  EXPECT_EQ(stats.edge_count, mesh.face_index.size() / 2);
+  EXPECT_EQ(stats.component_count, 1u);
+  EXPECT_EQ(stats.boundary_edge_count, 0u);
+  EXPECT_EQ(stats.non_manifold_edge_count, 0u);
+  EXPECT_EQ(stats.flipped_edge_count, 0u);
+  EXPECT_TRUE(stats.IsClosed());
+  // Эйлерова характеристика сферы
+  EXPECT_EQ(static_cast<long>(mesh.GetVertexCount()) -
+                static_cast<long>(stats.edge_count) +
+                static_cast<long>(stats.face_count),
+            2);
+
+  ASSERT_EQ(topology.GetHalfEdgeCount(), mesh.face_index.size());
+  auto next = [&mesh, &topology](size_t h) {
+    const uint32_t face = topology.GetFace(h);
+    return h + 1 < size_t(mesh.face_offset[face + 1])
+               ? h + 1
+               : size_t(mesh.face_offset[face]);
+  };
+  for (size_t h = 0; h < topology.GetHalfEdgeCount(); ++h) {
+    const uint32_t twin = topology.GetTwin(h);
+    ASSERT_NE(twin, Topology::kNoTwin);
+    EXPECT_EQ(topology.GetTwin(twin), h);
+    EXPECT_NE(topology.GetFace(twin), topology.GetFace(h));
+    // Пара идёт по тому же ребру навстречу
+    EXPECT_EQ(mesh.face_index[twin], mesh.face_index[next(h)]);
+  }
+}
+
+TEST(TopologyTest, ShellsAndBoundaryEdges) {
+  Mesh mesh;
+  AddGrid(mesh, 3, 2);
+  AddSphere(mesh, 8, 12, 1.0, 10.0);
+  AddGrid(mesh, 1, 1);
+  Topology topology;
+  topology.Build(mesh);
+  const TopologyStats& stats = topology.GetStats();
+  EXPECT_EQ(stats.component_count, 3u);
+  EXPECT_FALSE(stats.IsClosed());
+  // Край сетки 3 x 2 - 10 рёбер, одиночного квадрата - 4
+  EXPECT_EQ(stats.boundary_edge_count, 14u);
+  ASSERT_EQ(topology.GetBoundaryEdges().size(), 28u);
+  EXPECT_TRUE(topology.GetNonManifoldEdges().empty());
+
+  // Номера оболочек по возрастанию первой грани
+  const std::vector<uint32_t>& components = topology.GetComponents();
+  ASSERT_EQ(components.size(), mesh.GetFaceCount());
+  const size_t sphere_faces = 2 * 12 * (8 - 1);
+  for (size_t face = 0; face < components.size(); ++face) {
+    const uint32_t expected = face < 6 ? 0 : face < 6 + sphere_faces ? 1 : 2;
+    EXPECT_EQ(components[face], expected) << face;
+  }
+
+  // Рёбра края - пары (меньшая, большая) по возрастанию
+  const std::vector<int>& edges = topology.GetBoundaryEdges();
+  EXPECT_EQ(edges[0], 0);
+  EXPECT_EQ(edges[1], 1);
+  for (size_t i = 0; i < edges.size(); i += 2) {
+    EXPECT_LT(edges[i], edges[i + 1]);
+    if (i > 0) EXPECT_LE(edges[i - 2], edges[i]);
+  }
+}
+
+TEST(TopologyTest, NonManifoldAndFlippedEdges) {
+  // Три квадрата с общим ребром (0, 1)
+  Mesh mesh;
+  mesh.vertex_coord.assign(8 * 3, 0.0);
+  mesh.face_index = {0, 2, 3, 1, 0, 4, 5, 1, 0, 6, 7, 1};
+  mesh.face_offset = {0, 4, 8, 12};
+  Topology topology;
+  topology.Build(mesh);
+  const TopologyStats& stats = topology.GetStats();
+  EXPECT_EQ(stats.non_manifold_edge_count, 1u);
+  EXPECT_EQ(stats.boundary_edge_count, 9u);
+  EXPECT_EQ(stats.component_count, 1u);
+  EXPECT_FALSE(stats.IsClosed());
+  EXPECT_EQ(topology.GetNonManifoldEdges(), (std::vector<int>{0, 1}));
+  // Полурёбра (1, 0) трёх граней замкнуты в кольцо
+  uint32_t h = 3;
+  std::vector<uint32_t> faces;
+  do {
+    faces.push_back(topology.GetFace(h));
+    h = topology.GetTwin(h);
+  } while (h != 3 && faces.size() < 4);
+  EXPECT_EQ(faces, (std::vector<uint32_t>{0, 1, 2}));
+
+  // Соседние треугольники, обходящие общее ребро в одну сторону
+  Mesh flipped;
+  flipped.vertex_coord.assign(4 * 3, 0.0);
+  flipped.face_index = {0, 1, 2, 0, 1, 3};
+  flipped.face_offset = {0, 3, 6};
+  topology.Build(flipped);
+  EXPECT_EQ(topology.GetStats().flipped_edge_count, 1u);
+  EXPECT_EQ(topology.GetStats().edge_count, 5u);
+}
+
+TEST(TopologyTest, SkipsInvalidAndDegenerateFaces) {
+  Mesh mesh;
+  mesh.vertex_coord.assign(4 * 3, 0.0);
+  // Треугольник, грань с индексом вне диапазона, отрезок, грань с
+  // повтором вершины
+  mesh.face_index = {0, 1, 2, 0, 1, 9, 2, 3, 1, 1, 3};
+  mesh.face_offset = {0, 3, 6, 8, 11};
+  Topology topology;
+  topology.Build(mesh);
+  const TopologyStats& stats = topology.GetStats();
+  // Треугольник: 3 ребра; (0, 1) общее с второй гранью; (1, 3) - у
+  // последней
+  EXPECT_EQ(stats.edge_count, 4u);
+  EXPECT_EQ(stats.component_count, 3u);
+  EXPECT_EQ(topology.GetTwin(6), Topology::kNoTwin);
+  EXPECT_EQ(topology.GetTwin(8), Topology::kNoTwin);
+  EXPECT_EQ(topology.GetTwin(0), 3u);
+
+  topology.Build(Mesh());
+  EXPECT_EQ(topology.GetStats().component_count, 0u);
+  EXPECT_FALSE(topology.GetStats().IsClosed());
+}
+
+TEST(TopologyTest, ResultDoesNotDependOnThreads) {
+  Mesh mesh;
+  for (int i = 0; i < 6; ++i) AddSphere(mesh, 40, 60, 1.0, 3.0 * i);
+  AddGrid(mesh, 90, 70);
+  Topology single(1), parallel(4);
+  single.Build(mesh);
+  parallel.Build(mesh);
+  EXPECT_EQ(single.GetStats().component_count, 7u);
+  EXPECT_EQ(parallel.GetStats().component_count, 7u);
+  EXPECT_EQ(single.GetComponents(), parallel.GetComponents());
+  EXPECT_EQ(single.GetBoundaryEdges(), parallel.GetBoundaryEdges());
+  for (size_t h = 0; h < single.GetHalfEdgeCount(); ++h) {
+    ASSERT_EQ(single.GetTwin(h), parallel.GetTwin(h));
+  }
+}
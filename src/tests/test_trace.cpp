@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "../model/model.h"
+#include "../profiling/trace.h"
+
+using namespace s21;
+
+class TraceTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    Tracer::GetInstance().Clear();
+    Tracer::GetInstance().SetEnabled(true);
+  }
+
+  void TearDown() override {
+    Tracer::GetInstance().SetEnabled(false);
+    Tracer::GetInstance().Clear();
+    std::remove("test_trace.json");
+  }
+
+  static size_t CountEvents(const char* name) {
+    size_t count = 0;
+    for (const auto& [thread_id, event] :
+         Tracer::GetInstance().CollectEvents()) {
+      if (std::string(event.name) == name) ++count;
+    }
+    return count;
+  }
+};
+
+TEST_F(TraceTest, Scope_RecordsEvent) {
+  { S21_TRACE_SCOPE("test/scope"); }
+
+  EXPECT_EQ(CountEvents("test/scope"), 1u);
+}
+
+TEST_F(TraceTest, Scope_Disabled_NoEvent) {
+  Tracer::GetInstance().SetEnabled(false);
+  { S21_TRACE_SCOPE("test/disabled"); }
+
+  EXPECT_EQ(CountEvents("test/disabled"), 0u);
+}
+
+TEST_F(TraceTest, Scope_Nested_ActiveSpanRestored) {
+  const std::atomic<const char*>& span = Tracer::ActiveSpan();
+  {
+    S21_TRACE_SCOPE("test/outer");
+    {
+      S21_TRACE_SCOPE("test/inner");
+      EXPECT_STREQ(span.load(), "test/inner");
+    }
+    EXPECT_STREQ(span.load(), "test/outer");
+  }
+  EXPECT_EQ(span.load(), nullptr);
+}
+
+TEST_F(TraceTest, Scope_Disabled_TracksActiveSpan) {
+  Tracer::GetInstance().SetEnabled(false);
+  std::thread worker([] {
+    S21_TRACE_SCOPE("test/idle");
+    EXPECT_STREQ(Tracer::ActiveSpan().load(), "test/idle");
+  });
+  worker.join();
+
+  EXPECT_EQ(CountEvents("test/idle"), 0u);
+}
+
+TEST_F(TraceTest, Buffer_Overflow_KeepsLatestEvents) {
+  TraceBuffer buffer(0);
+  for (size_t i = 0; i < TraceBuffer::kCapacity + 10; ++i) {
+    buffer.Push({"test/overflow", static_cast<int64_t>(i), 1});
+  }
+
+  // Самый старый слот совпадает со следующим слотом записи и
+  // отбрасывается как возможно испорченный
+  std::vector<TraceEvent> events;
+  buffer.Snapshot(events);
+  ASSERT_EQ(events.size(), TraceBuffer::kCapacity - 1);
+  EXPECT_EQ(events.front().start_ns, 11);
+  EXPECT_EQ(events.back().start_ns,
+            static_cast<int64_t>(TraceBuffer::kCapacity + 9));
+}
+
+TEST_F(TraceTest, Buffer_Clear_KeepsLaterEvents) {
+  TraceBuffer buffer(0);
+  buffer.Push({"test/before", 0, 1});
+  buffer.Clear();
+  buffer.Push({"test/after", 1, 1});
+
+  std::vector<TraceEvent> events;
+  buffer.Snapshot(events);
+  ASSERT_EQ(events.size(), 1u);
+  EXPECT_STREQ(events.front().name, "test/after");
+}
+
+TEST_F(TraceTest, Threads_SeparateBuffers) {
+  std::thread worker([] { S21_TRACE_SCOPE("test/worker"); });
+  worker.join();
+  { S21_TRACE_SCOPE("test/main"); }
+
+  uint32_t worker_tid = 0, main_tid = 0;
+  for (const auto& [thread_id, event] :
+       Tracer::GetInstance().CollectEvents()) {
+    if (std::string(event.name) == "test/worker") worker_tid = thread_id;
+    if (std::string(event.name) == "test/main") main_tid = thread_id;
+  }
+  EXPECT_NE(worker_tid, main_tid);
+}
+
+TEST_F(TraceTest, WriteChromeTrace_ContainsModelSpans) {
+  std::ofstream file("test_trace.obj");
+  file << "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n";
+  file.close();
+
+  Model& model = Model::GetInstance();
+  model.SetFileName("test_trace.obj");
+  model.Parser();
+  model.Transform(kMove, 1.0, kX);
+  std::remove("test_trace.obj");
+
+  ASSERT_TRUE(Tracer::GetInstance().WriteChromeTrace("test_trace.json"));
+
+  std::ifstream in("test_trace.json");
+  std::stringstream content;
+  content << in.rdbuf();
+  const std::string json = content.str();
+  EXPECT_NE(json.find("\"traceEvents\""), std::string::npos);
+  EXPECT_NE(json.find("\"Model::Parser\""), std::string::npos);
+  EXPECT_NE(json.find("\"ObjParser::Normalize_\""), std::string::npos);
+  EXPECT_NE(json.find("\"Model::Transform\""), std::string::npos);
+  EXPECT_NE(json.find("\"ph\":\"X\""), std::string::npos);
+}
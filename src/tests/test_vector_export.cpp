@@ -0,0 +1,217 @@
+#include <gtest/gtest.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../model/obj_parser.h"
+#include "../render/vector_export.h"
+
+using namespace s21;
+
+namespace {
+
+Mesh ParseMesh(const std::string& obj) {
+  std::istringstream input(obj);
+  Mesh mesh;
+  EXPECT_EQ(ObjParser().Parse(input, mesh), kNoError);
+  return mesh;
+}
+
+const char* const kCube =
+    "v -0.5 -0.5 -0.5\nv 0.5 -0.5 -0.5\nv 0.5 0.5 -0.5\nv -0.5 0.5 -0.5\n"
+    "v -0.5 -0.5 0.5\nv 0.5 -0.5 0.5\nv 0.5 0.5 0.5\nv -0.5 0.5 0.5\n"
+    "f 1 2 3 4\nf 5 8 7 6\nf 1 5 6 2\nf 2 6 7 3\nf 3 7 8 4\nf 4 8 5 1\n";
+
+/**
+ * @brief Квадрат на глубине z и горизонтальная линия на глубине line_z
+ */
+std::string SquareAndLine(double line_z) {
+  std::ostringstream obj;
+  obj << "v -0.25 -0.25 -0.5\nv 0.25 -0.25 -0.5\nv 0.25 0.25 -0.5\n"
+         "v -0.25 0.25 -0.5\n"
+      << "v -0.8 0 " << line_z << "\nv 0.8 0 " << line_z << "\n"
+      << "f 1 2 3 4\nf 5 6\n";
+  return obj.str();
+}
+
+Camera FlatCamera() {
+  Camera camera;
+  camera.keep_aspect = false;
+  return camera;
+}
+
+/**
+ * @brief Отрезки на прямой y = 100, упорядоченные по x
+ */
+std::vector<Segment2D> OnMiddleRow(const std::vector<Segment2D>& lines) {
+  std::vector<Segment2D> row;
+  for (Segment2D line : lines) {
+    if (std::fabs(line.y0 - 100.0f) > 1e-3f ||
+        std::fabs(line.y1 - 100.0f) > 1e-3f) {
+      continue;
+    }
+    if (line.x0 > line.x1) std::swap(line.x0, line.x1);
+    row.push_back(line);
+  }
+  std::sort(row.begin(), row.end(), [](const Segment2D& a, const Segment2D& b) {
+    return a.x0 < b.x0;
+  });
+  return row;
+}
+
+}  // namespace
+
+TEST(VectorExportTest, RemovesHiddenCubeEdges) {
+  const Mesh cube = ParseMesh(kCube);
+  Camera camera = FlatCamera();
+  camera.rotation[0] = 30.0;
+  camera.rotation[1] = 30.0;
+  VectorStyle style;
+  VectorStats stats;
+  VectorExporter exporter;
+
+  EXPECT_EQ(exporter.Build(cube, camera, 200, 200, style, &stats).size(), 9u);
+  EXPECT_EQ(stats.edges, 12u);
+  EXPECT_EQ(stats.triangles, 12u);
+
+  style.hidden_line_removal = false;
+  EXPECT_EQ(exporter.Build(cube, camera, 200, 200, style).size(), 12u);
+}
+
+TEST(VectorExportTest, SplitsPartiallyHiddenEdge) {
+  VectorExporter exporter;
+  const std::vector<Segment2D> behind = OnMiddleRow(exporter.Build(
+      ParseMesh(SquareAndLine(0.5)), FlatCamera(), 200, 200, VectorStyle()));
+  ASSERT_EQ(behind.size(), 2u);
+  EXPECT_NEAR(behind[0].x0, 20.0, 1e-3);
+  EXPECT_NEAR(behind[0].x1, 75.0, 1e-3);
+  EXPECT_NEAR(behind[1].x0, 125.0, 1e-3);
+  EXPECT_NEAR(behind[1].x1, 180.0, 1e-3);
+
+  const std::vector<Segment2D> in_front = OnMiddleRow(exporter.Build(
+      ParseMesh(SquareAndLine(-0.9)), FlatCamera(), 200, 200, VectorStyle()));
+  ASSERT_EQ(in_front.size(), 1u);
+  EXPECT_NEAR(in_front[0].x1 - in_front[0].x0, 160.0, 1e-3);
+}
+
+TEST(VectorExportTest, MergesCollinearEdges) {
+  std::ostringstream obj;
+  for (int i = 0; i <= 10; ++i) obj << "v " << -0.5 + 0.1 * i << " 0.2 0\n";
+  for (int i = 1; i <= 10; ++i) obj << "f " << i << ' ' << i + 1 << '\n';
+  const Mesh line = ParseMesh(obj.str());
+
+  VectorStyle style;
+  VectorStats stats;
+  VectorExporter exporter;
+  const auto merged =
+      exporter.Build(line, FlatCamera(), 300, 200, style, &stats);
+  EXPECT_EQ(stats.segments, 10u);
+  ASSERT_EQ(merged.size(), 1u);
+  EXPECT_NEAR(std::fabs(merged[0].x1 - merged[0].x0), 150.0, 1e-3);
+
+  style.merge_collinear = false;
+  EXPECT_EQ(exporter.Build(line, FlatCamera(), 300, 200, style).size(), 10u);
+}
+
+TEST(VectorExportTest, ResultDoesNotDependOnThreads) {
+  // Сфера из четырёхугольников: рёбра задней половины закрыты
+  Mesh sphere;
+  const int rings = 24, segments = 48;
+  const double pi = 3.141592653589793;
+  for (int ring = 0; ring <= rings; ++ring) {
+    for (int segment = 0; segment < segments; ++segment) {
+      const double theta = pi * ring / rings;
+      const double phi = 2.0 * pi * segment / segments;
+      sphere.vertex_coord.insert(
+          sphere.vertex_coord.end(),
+          {0.8 * std::sin(theta) * std::cos(phi), 0.8 * std::cos(theta),
+           0.8 * std::sin(theta) * std::sin(phi)});
+    }
+  }
+  for (int ring = 0; ring < rings; ++ring) {
+    for (int segment = 0; segment < segments; ++segment) {
+      const int a = ring * segments + segment;
+      const int b = ring * segments + (segment + 1) % segments;
+      const int quad[4] = {a, b, b + segments, a + segments};
+      for (int k = 0; k < 4; ++k) {
+        sphere.face_index.push_back(quad[k]);
+        sphere.vertex_index.push_back(quad[k]);
+        sphere.vertex_index.push_back(quad[(k + 1) % 4]);
+      }
+      sphere.face_offset.push_back(static_cast<int>(sphere.face_index.size()));
+    }
+  }
+
+  Camera camera = FlatCamera();
+  camera.rotation[0] = 20.0;
+  VectorStats all, visible;
+  VectorStyle style;
+  style.hidden_line_removal = false;
+  VectorExporter(1).Build(sphere, camera, 320, 240, style, &all);
+  style.hidden_line_removal = true;
+  const auto single =
+      VectorExporter(1).Build(sphere, camera, 320, 240, style, &visible);
+  const auto parallel = VectorExporter(3).Build(sphere, camera, 320, 240,
+                                                style);
+  EXPECT_LT(visible.segments, all.segments * 3 / 4);
+  EXPECT_GT(visible.segments, all.segments / 3);
+  ASSERT_EQ(single.size(), parallel.size());
+  for (size_t i = 0; i < single.size(); ++i) {
+    EXPECT_EQ(single[i].x0, parallel[i].x0);
+    EXPECT_EQ(single[i].y1, parallel[i].y1);
+  }
+}
+
+TEST(VectorExportTest, FormatsSvgAndPdf) {
+  VectorExporter exporter;
+  const auto lines = exporter.Build(ParseMesh(SquareAndLine(0.5)),
+                                    FlatCamera(), 200, 200, VectorStyle());
+
+  const std::string svg = FormatSvg(lines, 200, 200, VectorStyle());
+  EXPECT_EQ(svg.rfind("<?xml", 0), 0u);
+  EXPECT_NE(svg.find("viewBox=\"0 0 200 200\""), std::string::npos);
+  EXPECT_NE(svg.find("M20 100l55 0"), std::string::npos);
+  EXPECT_NE(svg.find("</svg>"), std::string::npos);
+
+  const std::string pdf = FormatPdf(lines, 200, 200, VectorStyle());
+  EXPECT_EQ(pdf.rfind("%PDF-1.4", 0), 0u);
+  EXPECT_EQ(pdf.substr(pdf.size() - 6), "%%EOF\n");
+  // Таблица xref указывает на начала объектов
+  const size_t startxref = pdf.rfind("startxref\n") + 10;
+  const size_t xref = std::stoul(pdf.substr(startxref));
+  ASSERT_EQ(pdf.compare(xref, 5, "xref\n"), 0);
+  std::istringstream table(pdf.substr(xref + 5));
+  int first = 0, count = 0;
+  table >> first >> count;
+  ASSERT_GE(count, 5);
+  std::string offset, generation, kind;
+  table >> offset >> generation >> kind;
+  for (int object = 1; object < count; ++object) {
+    table >> offset >> generation >> kind;
+    EXPECT_EQ(pdf.compare(std::stoul(offset),
+                          std::to_string(object).size() + 6,
+                          std::to_string(object) + " 0 obj"),
+              0)
+        << object;
+  }
+
+  // Линии - в сжатом потоке, ось Y перевёрнута
+  const size_t filter = pdf.find("/FlateDecode");
+  ASSERT_NE(filter, std::string::npos);
+  const size_t length_pos = pdf.rfind("/Length ", filter) + 8;
+  const size_t length = std::stoul(pdf.substr(length_pos));
+  const size_t data = pdf.find("stream\n", filter) + 7;
+  std::string text(1 << 16, '\0');
+  uLongf text_size = text.size();
+  ASSERT_EQ(uncompress(reinterpret_cast<Bytef*>(&text[0]), &text_size,
+                       reinterpret_cast<const Bytef*>(pdf.data() + data),
+                       static_cast<uLong>(length)),
+            Z_OK);
+  text.resize(text_size);
+  EXPECT_NE(text.find("20 100 m 75 100 l"), std::string::npos);
+  EXPECT_EQ(text.substr(text.size() - 2), "S\n");
+}
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "../model/worker_queue.h"
+
+using namespace s21;
+using std::chrono::milliseconds;
+
+TEST(WorkerQueueTest, RunsTasksInOrderOffCallerThread) {
+  std::vector<int> order;
+  std::thread::id worker_id;
+  {
+    WorkerQueue queue(8);
+    for (int i = 0; i < 5; ++i) {
+      ASSERT_TRUE(queue.Post([&order, &worker_id, i] {
+        worker_id = std::this_thread::get_id();
+        order.push_back(i);
+      }));
+    }
+    queue.WaitIdle();
+    EXPECT_EQ(queue.GetPendingCount(), 0u);
+  }
+  EXPECT_EQ(order, (std::vector<int>{0, 1, 2, 3, 4}));
+  EXPECT_NE(worker_id, std::this_thread::get_id());
+}
+
+TEST(WorkerQueueTest, RejectsTasksWhenFull) {
+  WorkerQueue queue(2);
+  std::atomic<bool> release{false};
+  std::atomic<int> done{0};
+  auto blocking = [&] {
+    while (!release) std::this_thread::sleep_for(milliseconds(1));
+    ++done;
+  };
+
+  std::atomic<bool> started{false};
+  ASSERT_TRUE(queue.Post([&] {
+    started = true;
+    blocking();
+  }));
+  // Первая задача забрана потоком, в очереди остаётся место на две
+  while (!started) std::this_thread::sleep_for(milliseconds(1));
+  ASSERT_TRUE(queue.Post(blocking));
+  ASSERT_TRUE(queue.Post(blocking));
+  EXPECT_FALSE(queue.Post(blocking));
+  EXPECT_EQ(queue.GetPendingCount(), 3u);
+
+  release = true;
+  queue.WaitIdle();
+  EXPECT_EQ(done, 3);
+  EXPECT_TRUE(queue.Post(blocking));
+}
+
+TEST(WorkerQueueTest, DestructorDrainsAcceptedTasks) {
+  std::atomic<int> done{0};
+  {
+    WorkerQueue queue(16);
+    for (int i = 0; i < 10; ++i) {
+      queue.Post([&done] {
+        std::this_thread::sleep_for(milliseconds(2));
+        ++done;
+      });
+    }
+  }
+  EXPECT_EQ(done, 10);
+}
@@ -1,4 +1,4 @@
-QT += core widgets openglwidgets
+QT += core widgets openglwidgets network
 
 CONFIG += c++20
 
@@ -12,29 +12,99 @@ CONFIG(debug, debug|release) {
     QMAKE_CXXFLAGS += -g -O0
 }
 
+# Трассировка интервалов (S21_TRACE_SCOPE). Полностью отключается через
+# qmake CONFIG+=notrace - макросы раскрываются в пустые инструкции
+!notrace {
+    DEFINES += S21_ENABLE_TRACING
+}
+
 TARGET = 3DViewer
 TEMPLATE = app
 
+# zlib - запись PNG программного рендера
+LIBS += -lz
+
 INCLUDEPATH += $$PWD/.. \
                $$PWD/../model \
                $$PWD/../controller
 
 SOURCES += \
     ../main.cpp \
+    ../automation/automation_protocol.cpp \
+    ../model/bvh.cpp \
+    ../model/deviation.cpp \
+    ../model/hull.cpp \
+    ../model/mesh_tools.cpp \
     ../model/model.cpp \
+    ../model/obj_parser.cpp \
+    ../model/slicer.cpp \
+    ../model/topology.cpp \
     ../model/tranformation.cpp \
+    ../model/worker_queue.cpp \
     ../controller/controller.cpp \
+    ../profiling/frame_stats.cpp \
+    ../profiling/input_recorder.cpp \
+    ../profiling/latency.cpp \
+    ../profiling/soak.cpp \
+    ../profiling/stall_watchdog.cpp \
+    ../profiling/startup_profiler.cpp \
+    ../profiling/telemetry.cpp \
+    ../profiling/trace.cpp \
+    ../render/camera.cpp \
+    ../render/gif_encoder.cpp \
+    ../render/image.cpp \
+    ../render/picker.cpp \
+    ../render/selection.cpp \
+    ../render/rasterizer.cpp \
+    ../render/render_mesh.cpp \
+    ../render/vector_export.cpp \
+    automation_server.cpp \
+    gif_recorder.cpp \
     gui.cpp \
+    input_replayer.cpp \
     opengl_widget.cpp \
+    soak_runner.cpp \
     facade.cpp
 
 HEADERS += \
+    automation_server.h \
+    gif_recorder.h \
     gui.h \
+    input_replayer.h \
     opengl_widget.h \
+    soak_runner.h \
     facade.h \
+    ../automation/automation_protocol.h \
     ../controller/controller.h \
+    ../profiling/frame_stats.h \
+    ../profiling/input_recorder.h \
+    ../profiling/latency.h \
+    ../profiling/soak.h \
+    ../profiling/stall_watchdog.h \
+    ../profiling/startup_profiler.h \
+    ../profiling/telemetry.h \
+    ../profiling/trace.h \
+    ../render/camera.h \
+    ../render/gif_encoder.h \
+    ../render/image.h \
+    ../render/picker.h \
+    ../render/refit_scheduler.h \
+    ../render/selection.h \
+    ../render/rasterizer.h \
+    ../render/render_mesh.h \
+    ../render/vector_export.h \
+    ../model/bvh.h \
+    ../model/deviation.h \
+    ../model/hull.h \
+    ../model/mesh.h \
+    ../model/mesh_tools.h \
     ../model/model.h \
-    ../model/tranformation.h
+    ../model/obj_parser.h \
+    ../model/parallel.h \
+    ../model/slicer.h \
+    ../model/topology.h \
+    ../model/tranformation.h \
+    ../model/worker_queue.h
 
 FORMS += \
     view.ui
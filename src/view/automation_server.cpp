@@ -0,0 +1,259 @@
+/**
+ * @file automation_server.cpp
+ * @brief Реализация локального канала управления просмотрщиком
+ */
+
+#include "automation_server.h"
+
+#include <QSize>
+#include <cstdio>
+
+#include "../controller/controller.h"
+#include "../profiling/trace.h"
+#include "gui.h"
+
+namespace s21 {
+
+AutomationServer::AutomationServer(Controller* controller, View* view,
+                                   QObject* parent)
+    : QObject(parent), controller_(controller), view_(view) {
+  flush_timer_.setSingleShot(true);
+  frame_timeout_.setSingleShot(true);
+  connect(&flush_timer_, &QTimer::timeout, this, &AutomationServer::Flush_);
+  // Окно скрыто или свёрнуто - кадров нет, подтверждаем без них
+  connect(&frame_timeout_, &QTimer::timeout, this,
+          [this]() { HandleFrameRendered(0.0); });
+  connect(&server_, &QLocalServer::newConnection, this,
+          &AutomationServer::HandleConnection_);
+}
+
+bool AutomationServer::Listen(const QString& name, QString& error) {
+  // Сокет, оставшийся после аварийного завершения, мешает listen
+  QLocalServer::removeServer(name);
+  server_.setSocketOptions(QLocalServer::UserAccessOption);
+  if (!server_.listen(name)) {
+    error = server_.errorString();
+    return false;
+  }
+  return true;
+}
+
+void AutomationServer::HandleConnection_() {
+  while (QLocalSocket* socket = server_.nextPendingConnection()) {
+    connect(socket, &QLocalSocket::readyRead, this,
+            [this, socket]() { HandleReadyRead_(socket); });
+    connect(socket, &QLocalSocket::disconnected, socket,
+            &QObject::deleteLater);
+  }
+}
+
+void AutomationServer::HandleReadyRead_(QLocalSocket* socket) {
+  const auto received = LatencyTracker::Clock::now();
+  while (socket->canReadLine()) {
+    const QByteArray line = socket->readLine(kMaxLineLength).trimmed();
+    std::vector<AutomationCommand> batch;
+    std::string error;
+    const bool parsed = ParseAutomationBatch(line.toStdString(), batch, error);
+    // Команды до ошибочной выполняются: пакет не транзакция
+    for (const AutomationCommand& command : batch) {
+      Execute_(socket, command, received);
+    }
+    if (!parsed) Reply_(socket, "", false, error);
+  }
+
+  if (!socket->canReadLine() && socket->bytesAvailable() > kMaxLineLength) {
+    Reply_(socket, "", false, "line too long");
+    socket->disconnectFromServer();
+  }
+}
+
+void AutomationServer::Execute_(QLocalSocket* socket,
+                                const AutomationCommand& command,
+                                LatencyTracker::Clock::time_point received) {
+  ++commands_;
+  switch (command.type) {
+    case kCommandPing:
+      Reply_(socket, command.id, true, "");
+      break;
+    case kCommandTransform:
+      coalescer_.Add(command.strategy, command.value, command.axis);
+      queued_.push_back({socket, command.id, received});
+      ScheduleFlush_();
+      break;
+    case kCommandLoad: {
+      // Разбор идёт в фоне, как предзагрузка из командной строки; ответ
+      // приходит с результатом именно этой загрузки
+      Flush_();
+      QPointer<QLocalSocket> target(socket);
+      const std::string id = command.id;
+      // Ошибка уходит клиенту, а не в модальный диалог
+      view_->SetErrorDialogsEnabled(false);
+      controller_->PreloadModel(
+          QString::fromStdString(command.path),
+          [this, target, id](const QString& error) {
+            view_->SetErrorDialogsEnabled(true);
+            if (!target) return;
+            if (!error.isEmpty()) {
+              Reply_(target, id, false, error.toStdString());
+              return;
+            }
+            const Model& model = Model::GetInstance();
+            Reply_(target, id, true,
+                   "vertices=" + std::to_string(model.GetVertexCount()) +
+                       " edges=" + std::to_string(model.GetEdgeCount()) +
+                       " faces=" + std::to_string(model.GetFaceCount()));
+          });
+      break;
+    }
+    case kCommandCapture: {
+      // Ответ приходит после записи файла; пока снимок кодируется,
+      // следующие команды выполняются
+      Flush_();
+      QPointer<QLocalSocket> target(socket);
+      const std::string id = command.id;
+      const std::string path = command.path;
+      view_->SaveScreenshot(
+          QString::fromStdString(path), static_cast<int>(command.value),
+          [this, target, id, path](QSize size) {
+            if (!target) return;
+            if (size.isEmpty()) {
+              Reply_(target, id, false, "cannot write " + path);
+            } else {
+              Reply_(target, id, true,
+                     std::to_string(size.width()) + "x" +
+                         std::to_string(size.height()));
+            }
+          });
+      break;
+    }
+    case kCommandRecord: {
+      // Как capture: ответ приходит после записи файла, а команды во
+      // время записи попадают в GIF
+      Flush_();
+      QPointer<QLocalSocket> target(socket);
+      const std::string id = command.id;
+      const std::string path = command.path;
+      const bool started = view_->RecordGif(
+          QString::fromStdString(path), command.value,
+          [this, target, id, path](const GifRecording& result) {
+            if (!target) return;
+            if (!result.ok) {
+              Reply_(target, id, false, "cannot write " + path);
+              return;
+            }
+            char text[160];
+            std::snprintf(text, sizeof(text),
+                          "frames=%d dropped=%d colors=%d bytes=%zu "
+                          "palette_ms=%.3f encode_ms=%.3f",
+                          result.frames, result.dropped, result.stats.colors,
+                          result.stats.bytes, result.stats.palette_ms,
+                          result.stats.encode_ms);
+            Reply_(target, id, true, text);
+          });
+      if (!started) {
+        Reply_(socket, command.id, false, "recording already in progress");
+      }
+      break;
+    }
+    case kCommandStats:
+      // Сервер слушает уже во время предзагрузки: модель ещё пишет
+      // фоновый поток
+      controller_->FinishPreload();
+      Flush_();
+      Reply_(socket, command.id, true, FormatStats_());
+      break;
+    case kCommandQuit:
+      Reply_(socket, command.id, true, "");
+      socket->disconnectFromServer();
+      break;
+  }
+}
+
+void AutomationServer::ScheduleFlush_() {
+  if (!awaiting_frame_ && !flush_timer_.isActive()) {
+    flush_timer_.start(0);
+  }
+}
+
+void AutomationServer::Flush_() {
+  flush_timer_.stop();
+  if (queued_.empty()) {
+    return;
+  }
+
+  S21_TRACE_SCOPE("AutomationServer::Flush_");
+  const std::vector<CoalescedTransform> transforms = coalescer_.Take();
+  if (transforms.empty()) {
+    // Приращения взаимно погасились: кадра не будет, отвечаем сразу
+    for (const Waiter& waiter : queued_) {
+      Reply_(waiter.socket, waiter.id, true, "");
+    }
+    queued_.clear();
+    return;
+  }
+
+  LatencyTracker& latency = LatencyTracker::GetInstance();
+  latency.MarkInput(kInputAutomation, queued_.front().received);
+  latency.MarkStage(kStageRequested);
+  for (const CoalescedTransform& transform : transforms) {
+    controller_->TransformModel(transform.strategy, transform.value,
+                                transform.axis);
+  }
+  applied_ += transforms.size();
+
+  in_flight_.insert(in_flight_.end(), queued_.begin(), queued_.end());
+  queued_.clear();
+  awaiting_frame_ = true;
+  frame_timeout_.start(kFrameTimeoutMs);
+}
+
+void AutomationServer::HandleFrameRendered(double) {
+  if (!awaiting_frame_) {
+    return;
+  }
+
+  awaiting_frame_ = false;
+  frame_timeout_.stop();
+  ++frames_;
+
+  const auto now = LatencyTracker::Clock::now();
+  for (const Waiter& waiter : in_flight_) {
+    ack_latency_.Add(
+        std::chrono::duration<double, std::micro>(now - waiter.received)
+            .count());
+    Reply_(waiter.socket, waiter.id, true, "");
+  }
+  in_flight_.clear();
+
+  // Команды, пришедшие во время кадра, ушли в следующий сброс
+  if (!queued_.empty()) {
+    ScheduleFlush_();
+  }
+}
+
+void AutomationServer::Reply_(QLocalSocket* socket, const std::string& id,
+                              bool ok, const std::string& text) {
+  if (socket && socket->state() == QLocalSocket::ConnectedState) {
+    const std::string reply = FormatAutomationReply(id, ok, text);
+    socket->write(reply.data(), static_cast<qint64>(reply.size()));
+  }
+}
+
+std::string AutomationServer::FormatStats_() const {
+  const Model& model = Model::GetInstance();
+  const OperationTimings& timings = controller_->GetTimings();
+  char text[512];
+  std::snprintf(
+      text, sizeof(text),
+      "vertices=%zu edges=%zu faces=%zu load_ms=%.3f transform_ms=%.3f "
+      "commands=%zu applied=%zu coalesced=%zu frames=%zu "
+      "ack_ms_p50=%.3f ack_ms_p99=%.3f",
+      model.GetVertexCount(), model.GetEdgeCount(), model.GetFaceCount(),
+      timings.load_ms, timings.transform_ms, commands_, applied_,
+      coalescer_.GetCoalescedCount(), frames_,
+      ack_latency_.GetPercentileUs(0.5) / 1000.0,
+      ack_latency_.GetPercentileUs(0.99) / 1000.0);
+  return text;
+}
+
+}  // namespace s21
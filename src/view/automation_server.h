@@ -0,0 +1,159 @@
+#ifndef VIEW_AUTOMATION_SERVER_H
+#define VIEW_AUTOMATION_SERVER_H
+
+/**
+ * @file automation_server.h
+ * @brief Локальный канал управления запущенным просмотрщиком
+ */
+
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QObject>
+#include <QPointer>
+#include <QString>
+#include <QTimer>
+#include <string>
+#include <vector>
+
+#include "../automation/automation_protocol.h"
+#include "../profiling/latency.h"
+
+namespace s21 {
+
+class Controller;
+class View;
+
+/**
+ * @brief Сервер команд автоматизации на QLocalServer
+ *
+ * Скрипты подключаются к локальному сокету и шлют пакеты команд
+ * (формат - ParseAutomationBatch): загрузка файла, трансформации,
+ * снимок кадра, статистика. Команды выполняются в GUI-потоке через
+ * Controller, как пользовательский ввод.
+ *
+ * Трансформации не применяются сразу: они копятся в TransformCoalescer и
+ * сбрасываются не чаще одного раза за кадр - следующий сброс ждёт вывода
+ * кадра с результатом предыдущего. Поток команд любой частоты даёт не
+ * больше трансформаций, чем кадров, и не забивает GUI-поток.
+ *
+ * Ответы асинхронные: ping отвечает сразу, трансформация - после вывода
+ * кадра с её результатом, load - после фонового разбора файла, capture -
+ * после записи снимка. load, capture и stats сначала сбрасывают
+ * накопленные трансформации. Идентификатор "@<id>" из запроса
+ * повторяется в ответе, поэтому ответы можно сопоставлять не по порядку.
+ *
+ * @example
+ * @code
+ * AutomationServer automation(&controller, &view);
+ * connect(&view, &View::FrameRendered, &automation,
+ *         &AutomationServer::HandleFrameRendered);
+ * QString error;
+ * if (!automation.Listen("3dviewer", error)) qWarning() << error;
+ * @endcode
+ */
+class AutomationServer : public QObject {
+  Q_OBJECT
+
+ public:
+  /// Ожидание кадра, после которого сброс идёт без него (окно скрыто)
+  static constexpr int kFrameTimeoutMs = 100;
+  /// Предел длины строки команды
+  static constexpr qint64 kMaxLineLength = 64 * 1024;
+
+  /**
+   * @brief Создаёт сервер
+   * @param controller Контроллер, выполняющий команды
+   * @param view Представление (снимки кадра, диалоги ошибок)
+   * @param parent Родительский объект Qt
+   */
+  AutomationServer(Controller* controller, View* view,
+                   QObject* parent = nullptr);
+
+  /**
+   * @brief Начинает приём соединений
+   * @param name Имя сервера или полный путь к сокету
+   * @param error Описание ошибки
+   * @return false если сокет не открыт
+   */
+  bool Listen(const QString& name, QString& error);
+
+  /**
+   * @brief Возвращает полный путь к сокету (после Listen)
+   */
+  QString GetServerPath() const { return server_.fullServerName(); }
+
+ public slots:
+  /**
+   * @brief Отмечает вывод кадра: подтверждает трансформации
+   * @param cpu_ms Время CPU на кадр, мс (не используется)
+   */
+  void HandleFrameRendered(double cpu_ms);
+
+ private:
+  /**
+   * @brief Ожидающий ответа запрос трансформации
+   */
+  struct Waiter {
+    QPointer<QLocalSocket> socket;           ///< Клиент
+    std::string id;                          ///< Идентификатор запроса
+    LatencyTracker::Clock::time_point received;  ///< Момент получения
+  };
+
+  /**
+   * @brief Принимает новые соединения
+   */
+  void HandleConnection_();
+
+  /**
+   * @brief Читает и выполняет полные строки клиента
+   */
+  void HandleReadyRead_(QLocalSocket* socket);
+
+  /**
+   * @brief Выполняет одну команду пакета
+   */
+  void Execute_(QLocalSocket* socket, const AutomationCommand& command,
+                LatencyTracker::Clock::time_point received);
+
+  /**
+   * @brief Планирует сброс трансформаций, если кадр не ожидается
+   */
+  void ScheduleFlush_();
+
+  /**
+   * @brief Применяет накопленные трансформации через контроллер
+   */
+  void Flush_();
+
+  /**
+   * @brief Отправляет строку ответа клиенту, если он подключён
+   */
+  void Reply_(QLocalSocket* socket, const std::string& id, bool ok,
+              const std::string& text);
+
+  /**
+   * @brief Формирует строку статистики
+   * @pre Предзагрузка модели завершена (Controller::FinishPreload())
+   */
+  std::string FormatStats_() const;
+
+  Controller* controller_;  ///< Исполнитель команд
+  View* view_;              ///< Представление
+  QLocalServer server_;     ///< Слушающий сокет
+  QTimer flush_timer_;      ///< Сброс на следующей итерации цикла
+  QTimer frame_timeout_;    ///< Сброс без кадра
+
+  TransformCoalescer coalescer_;      ///< Накопленные трансформации
+  std::vector<Waiter> queued_;        ///< Ждут сброса
+  std::vector<Waiter> in_flight_;     ///< Сброшены, ждут кадра
+  bool awaiting_frame_ = false;       ///< Сброс выполнен, кадра ещё нет
+
+  size_t commands_ = 0;    ///< Выполнено команд
+  size_t applied_ = 0;     ///< Применено трансформаций после объединения
+  size_t frames_ = 0;      ///< Кадров с подтверждёнными трансформациями
+  LatencyHistogram ack_latency_;  ///< От получения до кадра, мкс
+};
+
+}  // namespace s21
+
+#endif  // VIEW_AUTOMATION_SERVER_H
@@ -0,0 +1,176 @@
+/**
+ * @file gif_recorder.cpp
+ * @brief Реализация записи окна в GIF
+ */
+
+#include "gif_recorder.h"
+
+#include <QPointer>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "../model/parallel.h"
+#include "../profiling/trace.h"
+#include "opengl_widget.h"
+
+namespace s21 {
+
+namespace {
+
+constexpr int kMaxFps = 50;          ///< GIF хранит задержку в 1/100 с
+constexpr int kFinishRetryMs = 10;   ///< Повтор, если очередь полна
+
+/**
+ * @brief Приводит снимок к размеру записи с обрезкой по центру
+ */
+Image ToFrame(const QImage& capture, QSize size) {
+  const QImage scaled = capture.scaled(size, Qt::KeepAspectRatioByExpanding,
+                                       Qt::SmoothTransformation);
+  const QImage cropped =
+      scaled
+          .copy((scaled.width() - size.width()) / 2,
+                (scaled.height() - size.height()) / 2, size.width(),
+                size.height())
+          .convertToFormat(QImage::Format_RGBA8888);
+  Image frame;
+  frame.Resize(size.width(), size.height());
+  for (int y = 0; y < frame.height; ++y) {
+    std::memcpy(&frame.pixels[static_cast<size_t>(y) * frame.width],
+                cropped.constScanLine(y),
+                static_cast<size_t>(frame.width) * 4);
+  }
+  return frame;
+}
+
+}  // namespace
+
+GifRecorder::GifRecorder(OpenGLWidget* widget, QObject* parent)
+    : QObject(parent), widget_(widget) {
+  timer_.setTimerType(Qt::PreciseTimer);
+  connect(&timer_, &QTimer::timeout, this, &GifRecorder::CaptureFrame_);
+  // Окно скрыто или свёрнуто - снимков нет, кодируем без них
+  stop_timeout_.setSingleShot(true);
+  connect(&stop_timeout_, &QTimer::timeout, this,
+          &GifRecorder::AbandonCaptures_);
+}
+
+bool GifRecorder::Start(const QString& path, const Options& options) {
+  if (state_ != kIdle || path.isEmpty() || options.size.isEmpty() ||
+      options.fps < 1 || options.fps > kMaxFps || options.seconds <= 0.0) {
+    return false;
+  }
+
+  path_ = path;
+  options_ = options;
+  requested_ = 0;
+  in_flight_ = 0;
+  ++capture_;
+  dropped_ = 0;
+  // Одно ядро остаётся окну просмотра и на время кодирования
+  encoder_ = std::make_unique<GifEncoder>(
+      std::max(1u, DefaultThreadCount() - 1));
+  state_ = kRecording;
+  timer_.start(1000 / options_.fps);
+  CaptureFrame_();
+  return true;
+}
+
+void GifRecorder::Stop() {
+  if (state_ != kRecording) {
+    return;
+  }
+  timer_.stop();
+  state_ = kStopping;
+  if (in_flight_ > 0) {
+    stop_timeout_.start(kStopTimeoutMs);
+  }
+  FinishIfDone_();
+}
+
+void GifRecorder::AbandonCaptures_() {
+  if (state_ != kStopping) {
+    return;
+  }
+  dropped_ += in_flight_;
+  in_flight_ = 0;
+  ++capture_;
+  FinishIfDone_();
+}
+
+void GifRecorder::CaptureFrame_() {
+  const int total = std::max(
+      1, static_cast<int>(std::lround(options_.fps * options_.seconds)));
+  if (state_ != kRecording || requested_ >= total) {
+    Stop();
+    return;
+  }
+
+  ++requested_;
+  // Прошлый снимок не готов - окно не перерисовывается; очередь
+  // запросов виджета не растёт, такт считается пропущенным
+  if (in_flight_ > 0) {
+    ++dropped_;
+    return;
+  }
+  ++in_flight_;
+  QPointer<GifRecorder> self(this);
+  widget_->RequestCapture(1, [self, capture = capture_](QImage image) {
+    if (self) self->HandleCapture_(image, capture);
+  });
+}
+
+void GifRecorder::HandleCapture_(const QImage& image, int capture) {
+  if (capture != capture_) {
+    return;
+  }
+  --in_flight_;
+  GifEncoder* encoder = encoder_.get();
+  const QSize size = options_.size;
+  const bool posted =
+      !image.isNull() && queue_.Post([encoder, image, size] {
+        S21_TRACE_SCOPE("GifRecorder::AddFrame");
+        encoder->AddFrame(ToFrame(image, size));
+      });
+  if (!posted) {
+    ++dropped_;
+  }
+  if (state_ == kStopping) {
+    FinishIfDone_();
+  }
+}
+
+void GifRecorder::FinishIfDone_() {
+  if (state_ != kStopping || in_flight_ > 0) {
+    return;
+  }
+  stop_timeout_.stop();
+
+  // Задача встаёт за кадрами: очередь выполняет их по порядку
+  GifEncoder* encoder = encoder_.get();
+  const std::string path = path_.toStdString();
+  const int delay_cs = std::max(1, 100 / options_.fps);
+  const int dropped = dropped_;
+  const bool posted = queue_.Post([this, encoder, path, delay_cs, dropped] {
+    S21_TRACE_SCOPE("GifRecorder::Encode");
+    GifRecording result;
+    result.dropped = dropped;
+    result.ok = encoder->Write(path, delay_cs, &result.stats);
+    result.frames = static_cast<int>(result.stats.frames);
+    encoder->Clear();
+    QMetaObject::invokeMethod(
+        this,
+        [this, result] {
+          state_ = kIdle;
+          emit Finished(result);
+        },
+        Qt::QueuedConnection);
+  });
+  if (posted) {
+    state_ = kEncoding;
+  } else {
+    QTimer::singleShot(kFinishRetryMs, this, &GifRecorder::FinishIfDone_);
+  }
+}
+
+}  // namespace s21
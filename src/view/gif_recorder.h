@@ -0,0 +1,153 @@
+#ifndef VIEW_GIF_RECORDER_H
+#define VIEW_GIF_RECORDER_H
+
+/**
+ * @file gif_recorder.h
+ * @brief Запись окна просмотра в анимированный GIF
+ */
+
+#include <QImage>
+#include <QObject>
+#include <QSize>
+#include <QString>
+#include <QTimer>
+#include <memory>
+
+#include "../model/worker_queue.h"
+#include "../render/gif_encoder.h"
+
+namespace s21 {
+
+class OpenGLWidget;
+
+/**
+ * @brief Итог записи GIF
+ */
+struct GifRecording {
+  bool ok = false;   ///< Файл записан
+  int frames = 0;    ///< Кадров в файле
+  int dropped = 0;   ///< Пропущено: очередь полна или нет кадров
+  GifStats stats;    ///< Замеры кодирования
+};
+
+/**
+ * @brief Записывает окно просмотра в GIF, не снижая частоту кадров
+ *
+ * По таймеру с частотой записи запрашивается снимок кадра
+ * (OpenGLWidget::RequestCapture - асинхронное чтение через PBO).
+ * Готовый снимок уходит в ограниченную очередь WorkerQueue: фоновый
+ * поток приводит его к размеру записи и добавляет в GifEncoder. Если
+ * кодировщик не успевает, кадр пропускается и учитывается в dropped -
+ * GUI-поток никогда не ждёт. Снимки отдаёт только paintGL, поэтому в
+ * пути не больше одного запроса: пока окно свёрнуто или скрыто, такты
+ * пропускаются, а Stop() ждёт снимка не дольше kStopTimeoutMs.
+ *
+ * По окончании записи GifEncoder строит общую палитру и сжимает кадры
+ * в потоках ParallelFor, оставляя одно ядро окну просмотра.
+ *
+ * @example
+ * @code
+ * GifRecorder recorder(opengl_widget);
+ * connect(&recorder, &GifRecorder::Finished,
+ *         [](const GifRecording& result) { ... });
+ * recorder.Start("screencast.gif", GifRecorder::Options());
+ * @endcode
+ */
+class GifRecorder : public QObject {
+  Q_OBJECT
+
+ public:
+  /**
+   * @brief Параметры записи (по умолчанию 640x480, 10 кадров/с, 5 с)
+   */
+  struct Options {
+    QSize size{640, 480};  ///< Размер кадров GIF
+    int fps = 10;          ///< Кадров в секунду (1..50)
+    double seconds = 5.0;  ///< Длительность записи
+  };
+
+  static constexpr size_t kQueueCapacity = 8;  ///< Кадров в очереди
+  /// Ожидание снимка в пути после Stop(), дальше кодируем без него
+  static constexpr int kStopTimeoutMs = 500;
+
+  /**
+   * @brief Создаёт рекордер окна
+   * @param widget Окно просмотра
+   * @param parent Родительский объект Qt
+   */
+  explicit GifRecorder(OpenGLWidget* widget, QObject* parent = nullptr);
+
+  /**
+   * @brief Начинает запись
+   * @return false если запись или кодирование уже идут либо параметры
+   * некорректны
+   */
+  bool Start(const QString& path, const Options& options);
+
+  /**
+   * @brief Досрочно завершает запись; снятые кадры кодируются
+   */
+  void Stop();
+
+  /**
+   * @brief Проверяет, идёт ли запись или кодирование
+   */
+  bool IsBusy() const noexcept { return state_ != kIdle; }
+
+ signals:
+  /**
+   * @brief Запись закончена
+   * @param result Итог: записан ли файл, кадры и замеры кодирования
+   */
+  void Finished(const s21::GifRecording& result);
+
+ private:
+  /**
+   * @brief Состояние рекордера
+   */
+  enum state_t {
+    kIdle = 0,       ///< Ничего не делает
+    kRecording = 1,  ///< Снимает кадры
+    kStopping = 2,   ///< Ждёт снимков в пути
+    kEncoding = 3    ///< Кодирует файл
+  };
+
+  /**
+   * @brief Запрашивает снимок очередного кадра
+   */
+  void CaptureFrame_();
+
+  /**
+   * @brief Передаёт снимок фоновому потоку
+   * @param capture Поколение запроса: снимки, от которых отказались
+   *        по таймауту, отбрасываются
+   */
+  void HandleCapture_(const QImage& image, int capture);
+
+  /**
+   * @brief Отказывается от снимков в пути и запускает кодирование
+   */
+  void AbandonCaptures_();
+
+  /**
+   * @brief Запускает кодирование, когда все снимки получены
+   */
+  void FinishIfDone_();
+
+  OpenGLWidget* widget_;  ///< Окно просмотра
+  QTimer timer_;          ///< Такт записи
+  QTimer stop_timeout_;   ///< Кодирование без снимков в пути
+  state_t state_ = kIdle;  ///< Состояние
+  QString path_;           ///< Файл GIF
+  Options options_;        ///< Параметры текущей записи
+  int requested_ = 0;      ///< Прошло тактов записи
+  int in_flight_ = 0;      ///< Снимков ещё не получено (0 или 1)
+  int capture_ = 0;        ///< Поколение ожидаемых снимков
+  int dropped_ = 0;        ///< Пропущено кадров
+  std::unique_ptr<GifEncoder> encoder_;  ///< Используется очередью
+  WorkerQueue queue_{kQueueCapacity};    ///< Приём и кодирование кадров
+};
+
+}  // namespace s21
+
+#endif  // VIEW_GIF_RECORDER_H
@@ -6,9 +6,27 @@
 #include "gui.h"
 
 #include <QFile>
+#include <QInputDialog>
+#include <QKeySequence>
+#include <QShortcut>
+#include <QStringList>
 #include <QTextStream>
 #include <QVBoxLayout>
-
+#include <algorithm>
+
+#include "../model/deviation.h"
+#include "../model/hull.h"
+#include "../model/mesh_tools.h"
+#include "../model/model.h"
+#include "../model/obj_parser.h"
+#include "../model/parallel.h"
+#include "../model/topology.h"
+#include "../profiling/input_recorder.h"
+#include "../profiling/latency.h"
+#include "../profiling/startup_profiler.h"
+#include "../profiling/trace.h"
+#include "../render/camera.h"
+#include "../render/vector_export.h"
 #include "facade.h"
 #include "ui_view.h"
 
@@ -19,8 +37,14 @@ View::View(QWidget* parent)
   // Устанавливаем C локаль для корректного парсинга чисел с точкой
   setlocale(LC_NUMERIC, "C");
 
+  StartupProfiler& startup = StartupProfiler::GetInstance();
+
   // Инициализируем пользовательский интерфейс из .ui файла
-  ui_->setupUi(this);
+  {
+    S21_TRACE_SCOPE("View::setupUi");
+    ui_->setupUi(this);
+  }
+  startup.Mark("View::setupUi");
 
   // Создаем OpenGL виджет для отображения 3D моделей
   opengl_widget_ = new OpenGLWidget(this);
@@ -33,9 +57,11 @@ View::View(QWidget* parent)
 
   // Применяем тёмную тему оформления
   LoadStyles_();
+  startup.Mark("View::LoadStyles_");
 
   // Подключаем все обработчики событий
   ConnectSlotSignals_();
+  startup.Mark("View::ConnectSlotSignals_");
 }
 
 View::~View() {
@@ -44,6 +70,8 @@ View::~View() {
 }
 
 void View::LoadStyles_() {
+  S21_TRACE_SCOPE("View::LoadStyles_");
+
   // Загружаем таблицу стилей из ресурсов приложения
   QFile file(":/style.qss");
   if (file.open(QFile::ReadOnly | QFile::Text)) {
@@ -59,6 +87,10 @@ std::function<void(int)> View::CreateSliderHandler_(int transform_type,
                                                     double scale_factor,
                                                     double& state_ref) {
   return [this, transform_type, axis, scale_factor, &state_ref](int value) {
+    // Момент входа фиксируется сразу, событие регистрируется только если
+    // оно приведёт к трансформации и, следовательно, к новому кадру
+    const auto input_time = LatencyTracker::Clock::now();
+    LatencyTracker& latency = LatencyTracker::GetInstance();
     double new_value = value * scale_factor;
 
     // Специальная обработка для масштабирования
@@ -67,12 +99,16 @@ std::function<void(int)> View::CreateSliderHandler_(int transform_type,
       double scale_factor_change = new_value / state_ref;
       if (std::abs(scale_factor_change - 1.0) > 0.001) {
         state_ref = new_value;
+        latency.MarkInput(kInputSlider, input_time);
+        latency.MarkStage(kStageRequested);
         emit TransformRequested(transform_type, scale_factor_change, axis);
       }
     } else {
       double delta = new_value - state_ref;
       if (std::abs(delta) > 0.001) {
         state_ref = new_value;
+        latency.MarkInput(kInputSlider, input_time);
+        latency.MarkStage(kStageRequested);
         emit TransformRequested(transform_type, delta, axis);
       }
     }
@@ -85,8 +121,7 @@ void View::ConnectSlotSignals_() {
     QString filepath = QFileDialog::getOpenFileName(
         this, tr("Выберите файл"), QDir::homePath(), tr("OBJ Files (*.obj)"));
     if (!filepath.isEmpty()) {
-      emit SetModel(filepath);
-      ui_->label_filename->setText(QFileInfo(filepath).fileName());
+      RequestLoad_(filepath);
     }
   });
 
@@ -112,47 +147,616 @@ void View::ConnectSlotSignals_() {
 
   // === Подключение drag&drop из OpenGL виджета ===
   connect(opengl_widget_, &OpenGLWidget::fileDropped,
-          [this](const QString& filepath) {
-            emit SetModel(filepath);
-            ui_->label_filename->setText(QFileInfo(filepath).fileName());
+          [this](const QString& filepath) { RequestLoad_(filepath); });
+
+  connect(opengl_widget_, &OpenGLWidget::FrameRendered, this,
+          &View::FrameRendered);
+
+  // === Запись ввода: значения слайдеров попадают в сессию по номеру ===
+  // Сброс слайдеров при загрузке идёт с заблокированными сигналами и
+  // не записывается - при воспроизведении его повторит сама загрузка
+  const auto sliders = Sliders_();
+  for (int id = 0; id < kSliderCount; ++id) {
+    connect(sliders[id], &QSlider::valueChanged, [id](int value) {
+      InputRecorder::GetInstance().Record(kEventSlider, id, value);
+    });
+  }
+
+  // === Оверлей производительности по F3 ===
+  connect(new QShortcut(QKeySequence(Qt::Key_F3), this),
+          &QShortcut::activated, [this]() {
+            opengl_widget_->SetHudVisible(!opengl_widget_->IsHudVisible());
           });
+
+  // === Снимок кадра по F2 ===
+  // Сохранение идёт в фоне: окно остаётся отзывчивым
+  connect(new QShortcut(QKeySequence(Qt::Key_F2), this),
+          &QShortcut::activated, [this]() {
+            const QString path = QFileDialog::getSaveFileName(
+                this, tr("Сохранить снимок"), "screenshot.bmp",
+                tr("BMP (*.bmp);;JPEG (*.jpg *.jpeg);;PNG (*.png)"));
+            if (path.isEmpty()) {
+              return;
+            }
+            bool accepted = false;
+            const int scale = QInputDialog::getInt(
+                this, tr("Снимок"), tr("Увеличение относительно окна:"), 1,
+                1, kMaxCaptureScale, 1, &accepted);
+            if (!accepted) {
+              return;
+            }
+            SaveScreenshot(path, scale, [this](QSize size) {
+              if (size.isEmpty()) {
+                QMessageBox::warning(this, "Ошибка",
+                                     "Не удалось сохранить снимок");
+              }
+            });
+          });
+
+  // === Запись GIF по F4 ===
+  // Повторное нажатие завершает запись досрочно
+  connect(new QShortcut(QKeySequence(Qt::Key_F4), this),
+          &QShortcut::activated, [this]() {
+            if (recorder_ && recorder_->IsBusy()) {
+              StopGifRecording();
+              return;
+            }
+            const QString path = QFileDialog::getSaveFileName(
+                this, tr("Записать GIF"), "screencast.gif",
+                tr("GIF (*.gif)"));
+            if (path.isEmpty()) {
+              return;
+            }
+            RecordGif(path, GifRecorder::Options().seconds,
+                      [this](const GifRecording& result) {
+                        if (!result.ok) {
+                          QMessageBox::warning(this, "Ошибка",
+                                               "Не удалось записать GIF");
+                        }
+                      });
+          });
+
+  // === Векторный чертёж по F6 ===
+  connect(new QShortcut(QKeySequence(Qt::Key_F6), this),
+          &QShortcut::activated, [this]() {
+            const QString path = QFileDialog::getSaveFileName(
+                this, tr("Сохранить чертёж"), "drawing.svg",
+                tr("SVG (*.svg);;PDF (*.pdf)"));
+            if (path.isEmpty()) {
+              return;
+            }
+            ExportVectorDrawing(path, [this](bool ok) {
+              if (!ok) {
+                QMessageBox::warning(this, "Ошибка",
+                                     "Не удалось сохранить чертёж");
+              }
+            });
+          });
+
+  // === Сечение плоскостью: F7 - следующая ось, F8 - сохранить контур ===
+  // Ось переключается по кругу X -> Y -> Z -> выключено
+  connect(new QShortcut(QKeySequence(Qt::Key_F7), this),
+          &QShortcut::activated, [this]() {
+            const int axis = opengl_widget_->GetSectionAxis();
+            opengl_widget_->SetSectionAxis(axis < 2 ? axis + 1 : -1);
+          });
+  connect(new QShortcut(QKeySequence(Qt::Key_F8), this),
+          &QShortcut::activated, [this]() {
+            if (opengl_widget_->GetSection().polylines.empty()) {
+              QMessageBox::warning(this, "Сечение",
+                                   "Плоскость не пересекает модель");
+              return;
+            }
+            const QString path = QFileDialog::getSaveFileName(
+                this, tr("Сохранить сечение"), "section.obj",
+                tr("OBJ (*.obj)"));
+            if (path.isEmpty()) {
+              return;
+            }
+            SaveSection(path, [this](bool ok) {
+              if (!ok) {
+                QMessageBox::warning(this, "Ошибка",
+                                     "Не удалось сохранить сечение");
+              }
+            });
+          });
+
+  // === Подсветка края и неманифолдных рёбер по F9 ===
+  connect(new QShortcut(QKeySequence(Qt::Key_F9), this),
+          &QShortcut::activated, [this]() {
+            opengl_widget_->SetTopologyVisible(
+                !opengl_widget_->IsTopologyVisible());
+          });
+
+  // === Сравнение с эталоном по F10: повторное нажатие снимает карту ===
+  connect(new QShortcut(QKeySequence(Qt::Key_F10), this),
+          &QShortcut::activated, [this]() {
+            if (opengl_widget_->HasVertexColors()) {
+              opengl_widget_->SetVertexColors(nullptr);
+              heat_colors_.clear();
+              deviation_info_.clear();
+              ShowStatistics_();
+              return;
+            }
+            if (vertex_coord_buffer_.empty()) {
+              return;
+            }
+            const QString path = QFileDialog::getOpenFileName(
+                this, tr("Эталон для сравнения"), "", tr("OBJ (*.obj)"));
+            if (!path.isEmpty()) {
+              CompareWithReference_(path);
+            }
+          });
+
+  // === Кадр по ориентированному box модели по Home ===
+  connect(new QShortcut(QKeySequence(Qt::Key_Home), this),
+          &QShortcut::activated, [this]() {
+            if (has_fit_camera_) opengl_widget_->SetCamera(fit_camera_);
+          });
+
+  // === Выгрузка трассы по F12 ===
+  // Первое нажатие включает запись интервалов, повторное - сохраняет трассу
+  connect(new QShortcut(QKeySequence(Qt::Key_F12), this),
+          &QShortcut::activated, [this]() {
+            Tracer& tracer = Tracer::GetInstance();
+            if (!tracer.IsEnabled()) {
+              tracer.SetEnabled(true);
+              return;
+            }
+            QString path = QFileDialog::getSaveFileName(
+                this, tr("Сохранить трассу"), "trace.json",
+                tr("Chrome Trace (*.json)"));
+            if (!path.isEmpty() &&
+                !tracer.WriteChromeTrace(path.toStdString())) {
+              QMessageBox::warning(this, "Ошибка",
+                                   "Не удалось записать трассу");
+            }
+          });
+}
+
+std::array<QSlider*, View::kSliderCount> View::Sliders_() const {
+  return {ui_->horizontalSlider_move_x,   ui_->horizontalSlider_move_y,
+          ui_->horizontalSlider_move_z,   ui_->horizontalSlider_rotate_x,
+          ui_->horizontalSlider_rotate_y, ui_->horizontalSlider_rotate_z,
+          ui_->horizontalSlider_scale};
+}
+
+void View::RequestLoad_(const QString& file_path) {
+  InputRecorder::GetInstance().Record(kEventLoad, 0, 0, 0,
+                                      file_path.toStdString());
+  emit SetModel(file_path);
+  ui_->label_filename->setText(QFileInfo(file_path).fileName());
+}
+
+InputReplayer* View::Replayer_() {
+  if (!replayer_) {
+    replayer_ = new InputReplayer(
+        [this](const RecordedEvent& event) { DispatchRecordedEvent_(event); },
+        this);
+    connect(replayer_, &InputReplayer::Finished, [this](double elapsed_ms) {
+      emit ReplayFinished(static_cast<int>(replayer_->GetEventCount()),
+                          elapsed_ms);
+    });
+  }
+  return replayer_;
+}
+
+bool View::StartReplay(const QString& file_path, bool max_speed) {
+  if (!Replayer_()->Load(file_path)) {
+    return false;
+  }
+  replayer_->Start(max_speed);
+  return true;
+}
+
+void View::StartReplay(std::vector<RecordedEvent> events, bool max_speed) {
+  Replayer_()->SetEvents(std::move(events));
+  replayer_->Start(max_speed);
+}
+
+GifRecorder* View::Recorder_() {
+  if (!recorder_) {
+    recorder_ = new GifRecorder(opengl_widget_, this);
+    connect(recorder_, &GifRecorder::Finished,
+            [this](const GifRecording& result) {
+              auto done = std::move(record_done_);
+              record_done_ = nullptr;
+              if (done) done(result);
+            });
+  }
+  return recorder_;
+}
+
+bool View::RecordGif(const QString& path, double seconds,
+                     std::function<void(const GifRecording&)> done) {
+  GifRecorder::Options options;
+  options.seconds = seconds;
+  if (!Recorder_()->Start(path, options)) {
+    return false;
+  }
+  record_done_ = std::move(done);
+  return true;
+}
+
+void View::StopGifRecording() {
+  if (recorder_) {
+    recorder_->Stop();
+  }
+}
+
+void View::SaveScreenshot(const QString& path, int scale,
+                          std::function<void(QSize)> done) {
+  opengl_widget_->RequestCapture(scale, [this, path, done](QImage image) {
+    auto finish = [this, done](QSize size) {
+      QMetaObject::invokeMethod(
+          this, [done, size] { done(size); }, Qt::QueuedConnection);
+    };
+    if (image.isNull()) {
+      finish(QSize());
+      return;
+    }
+    const bool posted = encoder_.Post([image, path, finish] {
+      S21_TRACE_SCOPE("View::EncodeScreenshot");
+      finish(image.save(path, nullptr, kJpegQuality) ? image.size() : QSize());
+    });
+    if (!posted) {
+      finish(QSize());
+    }
+  });
+}
+
+void View::ExportVectorDrawing(const QString& path,
+                               std::function<void(bool)> done) {
+  // Чертёж строится по буферам окна, как и фоновый анализ: модель во
+  // время предзагрузки ещё пишет фоновый поток
+  auto coord = CoordSnapshot_();
+  auto face_index = face_index_buffer_;
+  auto face_offset = face_offset_buffer_;
+  const Camera camera = opengl_widget_->GetCamera();
+  const int width = opengl_widget_->width();
+  const int height = opengl_widget_->height();
+  auto finish = [this, done](bool ok) {
+    QMetaObject::invokeMethod(
+        this, [done, ok] { done(ok); }, Qt::QueuedConnection);
+  };
+  const bool posted = encoder_.Post([coord, face_index, face_offset, camera,
+                                     width, height, file = path.toStdString(),
+                                     finish] {
+    S21_TRACE_SCOPE("View::ExportVectorDrawing");
+    Mesh mesh;
+    mesh.vertex_coord = *coord;
+    if (face_index && face_offset) {
+      mesh.face_index = *face_index;
+      mesh.face_offset = *face_offset;
+    }
+    // Одно ядро остаётся окну просмотра
+    const unsigned threads = std::max(1u, DefaultThreadCount() - 1);
+    const VectorStyle style;
+    const auto lines =
+        VectorExporter(threads).Build(mesh, camera, width, height, style);
+    finish(WriteVectorDrawing(file, lines, width, height, style, threads));
+  });
+  if (!posted) {
+    finish(false);
+  }
+}
+
+void View::SaveSection(const QString& path, std::function<void(bool)> done) {
+  auto finish = [this, done](bool ok) {
+    QMetaObject::invokeMethod(
+        this, [done, ok] { done(ok); }, Qt::QueuedConnection);
+  };
+  const bool posted =
+      encoder_.Post([section = opengl_widget_->GetSection(),
+                     file = path.toStdString(), finish] {
+        S21_TRACE_SCOPE("View::SaveSection");
+        finish(ExportSection(section, file) == kNoError);
+      });
+  if (!posted) {
+    finish(false);
+  }
+}
+
+void View::SetRenderBackend(render_backend_t backend) {
+  opengl_widget_->SetRenderBackend(backend);
+}
+
+void View::DispatchRecordedEvent_(const RecordedEvent& event) {
+  switch (event.type) {
+    case kEventMousePress:
+    case kEventMouseMove:
+    case kEventMouseRelease: {
+      static constexpr QEvent::Type kMouseTypes[] = {
+          QEvent::MouseButtonPress, QEvent::MouseMove,
+          QEvent::MouseButtonRelease};
+      const QPointF position(event.a, event.b);
+      QMouseEvent mouse_event(
+          kMouseTypes[event.type], position,
+          opengl_widget_->mapToGlobal(position),
+          static_cast<Qt::MouseButton>(event.c & 0xFFFF),
+          Qt::MouseButtons(QFlag(event.c >> 16)), Qt::NoModifier);
+      QApplication::sendEvent(opengl_widget_, &mouse_event);
+      break;
+    }
+    case kEventWheel: {
+      const QPointF position(event.a, event.b);
+      QWheelEvent wheel_event(position, opengl_widget_->mapToGlobal(position),
+                              QPoint(), QPoint(0, event.c), Qt::NoButton,
+                              Qt::NoModifier, Qt::NoScrollPhase, false);
+      QApplication::sendEvent(opengl_widget_, &wheel_event);
+      break;
+    }
+    case kEventSlider:
+      if (event.a >= 0 && event.a < kSliderCount) {
+        Sliders_()[event.a]->setValue(event.b);
+      }
+      break;
+    case kEventLoad:
+      RequestLoad_(QString::fromStdString(event.text));
+      break;
+    default:
+      break;
+  }
 }
 
 void View::HandleModelLoaded_(const std::vector<int>& vertex_index,
                               const std::vector<double>& vertex_coord,
                               const QString& filename, int vertex_count,
                               int edge_count) {
-  // Создаём статические копии данных для обеспечения времени жизни
-  // Статические переменные сохраняют данные между вызовами функции
-  static std::vector<int> vertex_index_copy;
-  static std::vector<double> vertex_coord_copy;
-
-  // Копируем входные данные
-  vertex_index_copy = vertex_index;
-  vertex_coord_copy = vertex_coord;
-
-  // Получаем указатели на данные для OpenGL
-  vertex_index_ = vertex_index_copy.data();
-  vertex_coord_ = vertex_coord_copy.data();
-  count_vertex_index_ = static_cast<int>(vertex_index_copy.size());
-  count_vertex_coord_ = static_cast<int>(vertex_coord_copy.size());
-
-  // Передаём данные в OpenGL виджет для отрисовки
-  opengl_widget_->SetModelData(vertex_index_, vertex_coord_,
-                               count_vertex_index_, count_vertex_coord_);
+  // Копируем данные в собственные буферы и передаём их OpenGL виджету
+  vertex_index_buffer_ = std::make_shared<const std::vector<int>>(
+      vertex_index.begin(), vertex_index.end());
+  // Грани нужны сечению и анализу: сигнал загрузки их не передаёт,
+  // модель к этому моменту уже разобрана и не меняется
+  const Mesh& mesh = Model::GetInstance().GetMesh();
+  face_index_buffer_ = std::make_shared<const std::vector<int>>(
+      mesh.face_index.begin(), mesh.face_index.end());
+  face_offset_buffer_ = std::make_shared<const std::vector<int>>(
+      mesh.face_offset.begin(), mesh.face_offset.end());
+  if (opengl_widget_) {
+    opengl_widget_->SetModelFaces(
+        face_index_buffer_->data(), face_offset_buffer_->data(),
+        static_cast<int>(mesh.GetFaceCount()));
+  }
+  UpdateCoordBuffer_(vertex_coord, true);
 
   // Обновляем информацию в пользовательском интерфейсе
   ui_->label_filename->setText(filename);
-  ui_->label_file_info->setText(
-      QString("Вершин: %1, Рёбер: %2").arg(vertex_count).arg(edge_count));
+  file_info_ =
+      QString("Вершин: %1, Рёбер: %2").arg(vertex_count).arg(edge_count);
+  ui_->label_file_info->setText(file_info_);
+  ++model_generation_;
+  // Виджет уже сбросил указатель на цвета при смене рёбер
+  heat_colors_.clear();
+  deviation_info_.clear();
+  FrameModel_();
+  AnalyzeTopology_();
+  ReportStatistics_();
 
   // Сбрасываем все слайдеры при загрузке новой модели
   ClearSliders_();
 }
 
+void View::AnalyzeTopology_() {
+  const uint64_t generation = model_generation_;
+  auto face_index = face_index_buffer_;
+  auto face_offset = face_offset_buffer_;
+  const size_t vertex_count = vertex_coord_buffer_.size() / 3;
+  const bool posted = analysis_.Post([this, generation, face_index,
+                                      face_offset, vertex_count] {
+    // Одно ядро остаётся окну просмотра
+    Topology topology(std::max(1u, DefaultThreadCount() - 1));
+    topology.Build(*face_index, *face_offset, vertex_count);
+    QMetaObject::invokeMethod(
+        this,
+        [this, generation, stats = topology.GetStats(),
+         boundary = topology.GetBoundaryEdges(),
+         non_manifold = topology.GetNonManifoldEdges()]() mutable {
+          if (generation != model_generation_) return;
+          QString text = QString("Оболочек: %1, рёбер края: %2, "
+                                 "неманифолдных: %3 - %4")
+                             .arg(stats.component_count)
+                             .arg(stats.boundary_edge_count)
+                             .arg(stats.non_manifold_edge_count)
+                             .arg(stats.IsClosed() ? "замкнута" : "открыта");
+          if (stats.flipped_edge_count > 0) {
+            text += QString(", несогласованных: %1")
+                        .arg(stats.flipped_edge_count);
+          }
+          ui_->label_file_info->setText(file_info_ + "\n" + text);
+          opengl_widget_->SetTopologyEdges(std::move(boundary),
+                                           std::move(non_manifold));
+        },
+        Qt::QueuedConnection);
+  });
+  if (posted) {
+    ui_->label_file_info->setText(file_info_ + "\nСвязность: считается...");
+  }
+}
+
+void View::ReportStatistics_() {
+  const uint64_t generation = model_generation_;
+  // Снимок координат общий с FrameModel_, рёбра и грани - общие буферы:
+  // в GUI-потоке ничего не копируется, сетка собирается уже в analysis_
+  auto coord = CoordSnapshot_();
+  auto edges = vertex_index_buffer_;
+  auto face_index = face_index_buffer_;
+  auto face_offset = face_offset_buffer_;
+  const bool posted = analysis_.Post([this, generation, coord, edges,
+                                      face_index, face_offset] {
+    Mesh mesh;
+    mesh.vertex_coord = *coord;
+    mesh.vertex_index = *edges;
+    mesh.face_index = *face_index;
+    mesh.face_offset = *face_offset;
+    const MeshReport report =
+        ComputeMeshReport(mesh, std::max(1u, DefaultThreadCount() - 1));
+    QMetaObject::invokeMethod(
+        this,
+        [this, generation, report] {
+          if (generation != model_generation_) return;
+          auto number = [](double value) {
+            return QString::number(value, 'g', 6);
+          };
+          QString text =
+              QString("Габариты: [%1; %2] x [%3; %4] x [%5; %6]\n"
+                      "Центр: (%7, %8, %9)\n")
+                  .arg(number(report.min[0]), number(report.max[0]),
+                       number(report.min[1]), number(report.max[1]),
+                       number(report.min[2]), number(report.max[2]),
+                       number(report.centroid[0]), number(report.centroid[1]),
+                       number(report.centroid[2]));
+          text += QString("Рёбра: мин %1, сред %2, макс %3\n")
+                      .arg(number(report.edge_min), number(report.edge_mean),
+                           number(report.edge_max));
+
+          // Гистограмма длин - строка столбиков от мин до макс
+          static const QString kBars[] = {" ", "▁", "▂", "▃", "▄",
+                                          "▅", "▆", "▇", "█"};
+          size_t peak = 0;
+          for (size_t bin : report.edge_histogram) peak = std::max(peak, bin);
+          QString bars;
+          for (size_t bin : report.edge_histogram) {
+            bars += kBars[peak > 0 ? (bin * 8 + peak - 1) / peak : 0];
+          }
+          text += QString("Длины: |%1|\n").arg(bars);
+          text += QString("Различных рёбер: %1, повторов: %2, нулевой "
+                          "длины: %3\n")
+                      .arg(report.unique_edge_count)
+                      .arg(report.duplicate_edge_count)
+                      .arg(report.degenerate_edge_count);
+
+          QStringList arity;
+          for (int size = 0; size < MeshReport::kArityBins; ++size) {
+            if (report.face_arity[size] == 0) continue;
+            arity << QString("%1%2: %3")
+                         .arg(size)
+                         .arg(size + 1 == MeshReport::kArityBins ? "+" : "")
+                         .arg(report.face_arity[size]);
+          }
+          text += QString("Граней по вершинам: %1\n")
+                      .arg(arity.isEmpty() ? "-" : arity.join(", "));
+          text += QString("Площадь: %1").arg(number(report.surface_area));
+          statistics_info_ = text;
+          ShowStatistics_();
+        },
+        Qt::QueuedConnection);
+  });
+  statistics_info_ = posted ? "Считается..." : "Очередь анализа занята";
+  ShowStatistics_();
+}
+
+void View::FrameModel_() {
+  const uint64_t generation = model_generation_;
+  has_fit_camera_ = false;
+  auto coord = CoordSnapshot_();
+  const Camera loaded = opengl_widget_->GetCamera();
+  const bool posted = analysis_.Post([this, generation, coord, loaded] {
+    const unsigned threads = std::max(1u, DefaultThreadCount() - 1);
+    const ConvexHull hull = ComputeConvexHull(*coord, threads);
+    const OrientedBox box = ComputeOrientedBox(hull, threads);
+    QMetaObject::invokeMethod(
+        this,
+        [this, generation, loaded, box, volume = hull.volume,
+         vertices = hull.GetVertexCount(),
+         triangles = hull.GetTriangleCount()] {
+          if (generation != model_generation_) return;
+          fit_camera_ = FitCameraToBox(box);
+          has_fit_camera_ = true;
+          // Модель, которую уже повернули или приблизили, не отбирается
+          const Camera current = opengl_widget_->GetCamera();
+          bool untouched = current.scale == loaded.scale;
+          for (int axis = 0; axis < 3; ++axis) {
+            untouched = untouched &&
+                        current.rotation[axis] == loaded.rotation[axis] &&
+                        current.translate[axis] == loaded.translate[axis];
+          }
+          if (untouched) opengl_widget_->SetCamera(fit_camera_);
+
+          auto number = [](double value) {
+            return QString::number(value, 'g', 6);
+          };
+          bounds_info_ =
+              QString("Оболочка: %1 вершин, %2 граней, объём %3\n"
+                      "Ориентированный box: %4 x %5 x %6, объём %7 (Home)")
+                  .arg(vertices)
+                  .arg(triangles)
+                  .arg(number(volume), number(box.half[0] * 2.0),
+                       number(box.half[1] * 2.0), number(box.half[2] * 2.0),
+                       number(box.GetVolume()));
+          ShowStatistics_();
+        },
+        Qt::QueuedConnection);
+  });
+  bounds_info_ = posted ? "Оболочка: считается..." : "Очередь анализа занята";
+}
+
+void View::CompareWithReference_(const QString& path) {
+  const uint64_t generation = model_generation_;
+  // Сравнивается то, что на экране: координаты с трансформациями
+  auto coord = CoordSnapshot_();
+  const QString name = QFileInfo(path).fileName();
+  const bool posted = analysis_.Post([this, generation, coord, name,
+                                      file = path.toStdString()] {
+    const unsigned threads = std::max(1u, DefaultThreadCount() - 1);
+    Mesh reference;
+    const int error = ObjParser().Load(file, reference);
+    DeviationStats stats;
+    std::vector<float> rgb;
+    if (error == kNoError) {
+      Deviation deviation(threads);
+      deviation.Build(reference);
+      std::vector<float> distance;
+      stats = deviation.Measure(*coord, distance);
+      MakeHeatMap(distance, stats.max, rgb, threads);
+    }
+    QMetaObject::invokeMethod(
+        this,
+        [this, generation, name, error, stats, rgb = std::move(rgb)]() mutable {
+          if (generation != model_generation_) return;
+          if (error != kNoError || stats.vertex_count == 0) {
+            deviation_info_ =
+                QString("Эталон %1: нет граней или ошибка чтения").arg(name);
+            ShowStatistics_();
+            return;
+          }
+          heat_colors_ = std::move(rgb);
+          opengl_widget_->SetVertexColors(heat_colors_.data());
+          deviation_info_ =
+              QString("Отклонение от %1: макс %2 (вершина %3), сред %4, "
+                      "СКО %5; синий - 0, красный - макс")
+                  .arg(name)
+                  .arg(stats.max, 0, 'g', 6)
+                  .arg(stats.max_vertex + 1)
+                  .arg(stats.mean, 0, 'g', 6)
+                  .arg(stats.rms, 0, 'g', 6);
+          ShowStatistics_();
+        },
+        Qt::QueuedConnection);
+  });
+  deviation_info_ = posted ? QString("Сравнение с %1: считается...").arg(name)
+                           : QString("Очередь анализа занята");
+  ShowStatistics_();
+}
+
+void View::ShowStatistics_() {
+  QStringList parts;
+  for (const QString* part :
+       {&statistics_info_, &bounds_info_, &deviation_info_}) {
+    if (!part->isEmpty()) parts << *part;
+  }
+  ui_->label_statistics->setText(parts.join("\n"));
+}
+
+void View::HandleOperationTimed_(double load_ms, double transform_ms) {
+  opengl_widget_->SetOperationTimings(load_ms, transform_ms);
+}
+
 void View::HandleModelLoadError_(const QString& error_message) {
   // Отображаем модальное окно с ошибкой
-  QMessageBox::warning(this, "Ошибка загрузки", error_message);
+  if (error_dialogs_enabled_) {
+    QMessageBox::warning(this, "Ошибка загрузки", error_message);
+  }
 }
 
 void View::ClearSliders_() {
@@ -222,23 +826,46 @@ void View::wheelEvent(QWheelEvent* event) {
 
 void View::HandleModelTransformed_(const std::vector<int>& vertex_index,
                                    const std::vector<double>& vertex_coord) {
-  // Обновляем статические копии данных новыми трансформированными значениями
-  static std::vector<int> vertex_index_copy;
-  static std::vector<double> vertex_coord_copy;
+  S21_TRACE_SCOPE("View::HandleModelTransformed_");
+  LatencyTracker::GetInstance().MarkStage(kStageDelivered);
+
+  // Трансформации не меняют топологию: индексы копируются только если
+  // модель сменилась в обход HandleModelLoaded_
+  const bool topology_changed =
+      !vertex_index_buffer_ ||
+      vertex_index.size() != vertex_index_buffer_->size();
+  if (topology_changed) {
+    vertex_index_buffer_ = std::make_shared<const std::vector<int>>(
+        vertex_index.begin(), vertex_index.end());
+  }
+  UpdateCoordBuffer_(vertex_coord, topology_changed);
+}
+
+std::shared_ptr<const std::vector<double>> View::CoordSnapshot_() {
+  if (!coord_snapshot_) {
+    coord_snapshot_ =
+        std::make_shared<const std::vector<double>>(vertex_coord_buffer_);
+  }
+  return coord_snapshot_;
+}
 
-  vertex_index_copy = vertex_index;
-  vertex_coord_copy = vertex_coord;
+void View::UpdateCoordBuffer_(const std::vector<double>& vertex_coord,
+                              bool topology_changed) {
+  // assign() в буфер с достаточной ёмкостью не выделяет память, поэтому
+  // в установившемся режиме слайдеров копирование обходится без malloc
+  vertex_coord_buffer_.assign(vertex_coord.begin(), vertex_coord.end());
+  coord_snapshot_.reset();
 
-  // Обновляем указатели на данные
-  vertex_index_ = vertex_index_copy.data();
-  vertex_coord_ = vertex_coord_copy.data();
-  count_vertex_index_ = static_cast<int>(vertex_index_copy.size());
-  count_vertex_coord_ = static_cast<int>(vertex_coord_copy.size());
+  const std::vector<int>* edges = vertex_index_buffer_.get();
+  vertex_index_ = edges ? edges->data() : nullptr;
+  vertex_coord_ = vertex_coord_buffer_.data();
+  count_vertex_index_ = edges ? static_cast<int>(edges->size()) : 0;
+  count_vertex_coord_ = static_cast<int>(vertex_coord_buffer_.size());
 
-  // Передаём обновлённые данные в OpenGL виджет
   if (opengl_widget_) {
     opengl_widget_->SetModelData(vertex_index_, vertex_coord_,
-                                 count_vertex_index_, count_vertex_coord_);
+                                 count_vertex_index_, count_vertex_coord_,
+                                 topology_changed);
   }
 }
 
@@ -9,15 +9,24 @@
 #include <QApplication>
 #include <QFileDialog>
 #include <QFileInfo>
+#include <QImage>
 #include <QMessageBox>
 #include <QMouseEvent>
 #include <QPoint>
+#include <QSize>
+#include <QSlider>
 #include <QWheelEvent>
 #include <QWidget>
+#include <array>
 #include <clocale>
+#include <cstdint>
 #include <functional>
+#include <memory>
 
+#include "../model/worker_queue.h"
 #include "facade.h"
+#include "gif_recorder.h"
+#include "input_replayer.h"
 #include "opengl_widget.h"
 
 QT_BEGIN_NAMESPACE
@@ -117,6 +126,101 @@ class View : public QWidget {
 
   Facade* facade;  ///< Указатель на фасад для упрощения доступа к UI
 
+  /**
+   * @brief Запускает воспроизведение записанной сессии ввода
+   *
+   * События из файла InputRecorder применяются к интерфейсу так же, как
+   * пользовательский ввод: слайдеры получают значения, OpenGL виджету
+   * отправляются синтезированные события мыши, загрузки идут через
+   * SetModel. По окончании испускается ReplayFinished.
+   *
+   * @param file_path Путь к файлу записи
+   * @param max_speed true - без пауз между событиями
+   * @return false если запись не удалось прочитать
+   */
+  bool StartReplay(const QString& file_path, bool max_speed);
+
+  /**
+   * @brief Запускает воспроизведение готового сценария ввода
+   *
+   * @param events События в формате InputRecorder
+   * @param max_speed true - без пауз между событиями
+   */
+  void StartReplay(std::vector<RecordedEvent> events, bool max_speed);
+
+  static constexpr int kJpegQuality = 90;  ///< Качество JPEG снимков
+
+  /**
+   * @brief Сохраняет кадр в файл; формат - по расширению (BMP, JPEG, PNG)
+   *
+   * Кадр читается асинхронно (OpenGLWidget::RequestCapture), а
+   * кодирование и запись идут в фоновом потоке, поэтому сохранение не
+   * прерывает взаимодействие с моделью.
+   *
+   * @param path Путь к файлу
+   * @param scale Во сколько раз снимок больше окна
+   * @param done Вызывается в GUI-потоке: размер снимка или пустой
+   * QSize при ошибке
+   */
+  void SaveScreenshot(const QString& path, int scale,
+                      std::function<void(QSize)> done);
+
+  /**
+   * @brief Начинает запись окна в GIF (640x480, 10 кадров/с)
+   *
+   * Кадры снимаются асинхронно и кодируются в фоне (GifRecorder), окно
+   * остаётся отзывчивым и во время записи, и во время кодирования.
+   *
+   * @param path Путь к файлу GIF
+   * @param seconds Длительность записи
+   * @param done Вызывается в GUI-потоке, когда файл записан (или нет)
+   * @return false если предыдущая запись ещё не закончена
+   */
+  bool RecordGif(const QString& path, double seconds,
+                 std::function<void(const GifRecording&)> done);
+
+  /**
+   * @brief Досрочно завершает запись GIF; снятые кадры сохраняются
+   */
+  void StopGifRecording();
+
+  /**
+   * @brief Сохраняет видимый каркас в SVG или PDF (по расширению)
+   *
+   * Координаты окна копируются, чертёж строится VectorExporter с камерой
+   * окна и записывается в фоновом потоке, окно остаётся отзывчивым.
+   *
+   * @param path Путь к файлу .svg или .pdf
+   * @param done Вызывается в GUI-потоке: true, если файл записан
+   */
+  void ExportVectorDrawing(const QString& path,
+                           std::function<void(bool)> done);
+
+  /**
+   * @brief Сохраняет текущий контур сечения в OBJ (ломаные l)
+   *
+   * Контур копируется и записывается в фоновом потоке.
+   *
+   * @param path Путь к файлу .obj
+   * @param done Вызывается в GUI-потоке: true, если файл записан
+   */
+  void SaveSection(const QString& path, std::function<void(bool)> done);
+
+  /**
+   * @brief Выбирает, чем рисовать модель (OpenGL или Rasterizer)
+   */
+  void SetRenderBackend(render_backend_t backend);
+
+  /**
+   * @brief Включает или отключает диалоги об ошибках загрузки
+   *
+   * Канал автоматизации отключает их на время своих команд: ошибка
+   * возвращается клиенту, а модальное окно остановило бы скрипт.
+   */
+  void SetErrorDialogsEnabled(bool enabled) noexcept {
+    error_dialogs_enabled_ = enabled;
+  }
+
  public slots:
   /**
    * @brief Обработчик успешной загрузки модели
@@ -171,6 +275,17 @@ class View : public QWidget {
   void HandleModelTransformed_(const std::vector<int>& vertex_index,
                                const std::vector<double>& vertex_coord);
 
+  /**
+   * @brief Обработчик замеров длительности операций контроллера
+   *
+   * Передаёт длительности в оверлей производительности OpenGL виджета
+   * (включается клавишей F3).
+   *
+   * @param load_ms Длительность последней загрузки модели, мс
+   * @param transform_ms Длительность последней трансформации, мс
+   */
+  void HandleOperationTimed_(double load_ms, double transform_ms);
+
  protected:
   /**
    * @brief Обработчик движения мыши
@@ -253,7 +368,53 @@ class View : public QWidget {
    */
   void TransformRequested(int strategy_type, double value, int axis);
 
+  /**
+   * @brief Сигнал окончания воспроизведения записанной сессии
+   *
+   * @param event_count Количество воспроизведённых событий
+   * @param elapsed_ms Длительность воспроизведения, мс
+   */
+  void ReplayFinished(int event_count, double elapsed_ms);
+
+  /**
+   * @brief Сигнал об отрисованном кадре (проброс из OpenGL виджета)
+   *
+   * @param cpu_ms Время CPU на кадр, мс
+   */
+  void FrameRendered(double cpu_ms);
+
  private:
+  static constexpr int kSliderCount = 7;  ///< Количество слайдеров
+
+  /**
+   * @brief Возвращает слайдеры в порядке их номеров в записи ввода
+   *
+   * Порядок: перемещение X/Y/Z, поворот X/Y/Z, масштаб.
+   */
+  std::array<QSlider*, kSliderCount> Sliders_() const;
+
+  /**
+   * @brief Запрашивает загрузку модели и записывает событие загрузки
+   * @param file_path Путь к OBJ файлу
+   */
+  void RequestLoad_(const QString& file_path);
+
+  /**
+   * @brief Применяет записанное событие ввода к интерфейсу
+   * @param event Событие из файла записи
+   */
+  void DispatchRecordedEvent_(const RecordedEvent& event);
+
+  /**
+   * @brief Создаёт проигрыватель ввода при первом обращении
+   */
+  InputReplayer* Replayer_();
+
+  /**
+   * @brief Создаёт рекордер GIF при первом обращении
+   */
+  GifRecorder* Recorder_();
+
   /**
    * @brief Создаёт обработчик для слайдеров трансформации
    */
@@ -289,6 +450,59 @@ class View : public QWidget {
    */
   void ClearSliders_();
 
+  /**
+   * @brief Считает связность загруженной модели в analysis_
+   *
+   * Итог выводится под сведениями о файле, рёбра края передаются
+   * OpenGL виджету. Итог для уже сменённой модели отбрасывается.
+   */
+  void AnalyzeTopology_();
+
+  /**
+   * @brief Строит подробный отчёт о загруженной модели в analysis_
+   *
+   * Box, центр, длины рёбер с гистограммой, вырожденные и повторные
+   * рёбра, число вершин граней и площадь выводятся в панель
+   * статистики. Итог для уже сменённой модели отбрасывается.
+   */
+  void ReportStatistics_();
+
+  /**
+   * @brief Строит оболочку и ориентированный box модели в analysis_
+   *
+   * Первый кадр рисуется сразу, без ожидания. Готовый box задаёт
+   * камеру, показывающую модель крупно и по центру вдоль длинной оси;
+   * она ставится, если пользователь ещё не двигал модель, и по Home.
+   * Размеры оболочки и box выводятся в панель статистики. Итог для уже
+   * сменённой модели отбрасывается.
+   */
+  void FrameModel_();
+
+  /**
+   * @brief Сравнивает модель с эталонной поверхностью в analysis_
+   *
+   * Эталон загружается и разбивается на треугольники в фоне. Расстояния
+   * от вершин модели (с текущими трансформациями) до эталона выводятся
+   * тепловой картой каркаса и сводкой в панели статистики. Итог для уже
+   * сменённой модели отбрасывается.
+   *
+   * @param path Файл эталона OBJ
+   */
+  void CompareWithReference_(const QString& path);
+
+  /**
+   * @brief Возвращает снимок координат для фоновых задач
+   *
+   * Координаты копируются один раз после загрузки или трансформации;
+   * отчёт, box, сравнение с эталоном и чертёж делят этот снимок.
+   */
+  std::shared_ptr<const std::vector<double>> CoordSnapshot_();
+
+  /**
+   * @brief Выводит отчёт, box и итог сравнения в панель статистики
+   */
+  void ShowStatistics_();
+
   /**
    * @brief Загружает таблицы стилей для тёмной темы
    *
@@ -304,9 +518,46 @@ class View : public QWidget {
 
   Ui::View* ui_;  ///< Указатель на сгенерированный Qt UI объект
   OpenGLWidget* opengl_widget_;  ///< Виджет для отображения 3D моделей
+  InputReplayer* replayer_ = nullptr;  ///< Проигрыватель записанного ввода
+  GifRecorder* recorder_ = nullptr;    ///< Запись окна в GIF
+  /// Получатель итога текущей записи GIF
+  std::function<void(const GifRecording&)> record_done_;
+  bool error_dialogs_enabled_ = true;  ///< Показывать диалоги ошибок
+  WorkerQueue encoder_{4};  ///< Кодирование снимков и чертежей в фоне
+  WorkerQueue analysis_{4};  ///< Анализ загруженной модели в фоне
+  uint64_t model_generation_ = 0;  ///< Номер загрузки (отсев старых итогов)
+  QString file_info_;              ///< Сведения о файле без итогов анализа
+  QString statistics_info_;  ///< Текст отчёта о модели
+  QString bounds_info_;      ///< Оболочка и ориентированный box
+  QString deviation_info_;   ///< Итог сравнения с эталоном
+  Camera fit_camera_;        ///< Камера по box модели (Home)
+  bool has_fit_camera_ = false;  ///< fit_camera_ посчитана для модели
+  std::vector<float> heat_colors_;  ///< Цвета тепловой карты для виджета
+
+  /**
+   * @brief Копирует координаты в буфер отрисовки и обновляет виджет
+   *
+   * @param vertex_coord Координаты вершин от контроллера
+   * @param topology_changed Рёбра сменились (загрузка), а не только
+   * координаты
+   *
+   * @post OpenGL виджет указывает на vertex_index_buffer_ и
+   *       vertex_coord_buffer_
+   */
+  void UpdateCoordBuffer_(const std::vector<double>& vertex_coord,
+                          bool topology_changed);
 
   // OpenGL data - данные модели для отображения
-  int* vertex_index_ = nullptr;  ///< Указатель на массив индексов вершин рёбер
+  /// Копия индексов рёбер для отрисовки (общая с фоновыми задачами;
+  /// трансформации её не меняют)
+  std::shared_ptr<const std::vector<int>> vertex_index_buffer_;
+  std::vector<double> vertex_coord_buffer_;  ///< Копия координат
+  /// Снимок vertex_coord_buffer_ для фоновых задач, пусто - устарел
+  std::shared_ptr<const std::vector<double>> coord_snapshot_;
+  /// Копия граней для сечения и анализа (общая с фоновыми задачами)
+  std::shared_ptr<const std::vector<int>> face_index_buffer_;
+  std::shared_ptr<const std::vector<int>> face_offset_buffer_;  ///< Начала
+  const int* vertex_index_ = nullptr;  ///< Индексы вершин рёбер
   double* vertex_coord_ = nullptr;  ///< Указатель на массив координат вершин
   int count_vertex_index_ = 0;  ///< Количество элементов в массиве индексов
   int count_vertex_coord_ = 0;  ///< Количество элементов в массиве координат
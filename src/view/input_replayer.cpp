@@ -0,0 +1,72 @@
+/**
+ * @file input_replayer.cpp
+ * @brief Реализация воспроизведения записанных сессий ввода
+ */
+
+#include "input_replayer.h"
+
+#include <algorithm>
+
+namespace s21 {
+
+InputReplayer::InputReplayer(Dispatcher dispatcher, QObject* parent)
+    : QObject(parent), dispatcher_(std::move(dispatcher)) {
+  timer_.setSingleShot(true);
+  timer_.setTimerType(Qt::PreciseTimer);
+  connect(&timer_, &QTimer::timeout, this, &InputReplayer::DispatchDue_);
+}
+
+bool InputReplayer::Load(const QString& path) {
+  Stop();
+  next_ = 0;
+  return InputRecorder::LoadEvents(path.toStdString(), events_);
+}
+
+void InputReplayer::SetEvents(std::vector<RecordedEvent> events) {
+  Stop();
+  next_ = 0;
+  events_ = std::move(events);
+}
+
+void InputReplayer::Start(bool max_speed) {
+  max_speed_ = max_speed;
+  next_ = 0;
+  running_ = true;
+  clock_.start();
+  timer_.start(0);
+}
+
+void InputReplayer::Stop() {
+  timer_.stop();
+  running_ = false;
+}
+
+void InputReplayer::DispatchDue_() {
+  if (max_speed_) {
+    // По одному событию за итерацию: между ними обрабатываются
+    // запросы перерисовки, и каждое событие даёт свой кадр
+    if (next_ < events_.size()) dispatcher_(events_[next_++]);
+  } else {
+    const qint64 elapsed_us = clock_.nsecsElapsed() / 1000;
+    while (next_ < events_.size() &&
+           events_[next_].time_us <= static_cast<uint64_t>(elapsed_us)) {
+      dispatcher_(events_[next_++]);
+    }
+  }
+
+  if (next_ >= events_.size()) {
+    running_ = false;
+    emit Finished(clock_.nsecsElapsed() / 1e6);
+    return;
+  }
+
+  int delay_ms = 0;
+  if (!max_speed_) {
+    const qint64 wait_us = static_cast<qint64>(events_[next_].time_us) -
+                           clock_.nsecsElapsed() / 1000;
+    delay_ms = static_cast<int>(std::max<qint64>(wait_us / 1000, 0));
+  }
+  timer_.start(delay_ms);
+}
+
+}  // namespace s21
@@ -0,0 +1,109 @@
+#ifndef VIEW_INPUT_REPLAYER_H
+#define VIEW_INPUT_REPLAYER_H
+
+/**
+ * @file input_replayer.h
+ * @brief Воспроизведение записанных сессий ввода
+ */
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+#include <functional>
+#include <vector>
+
+#include "../profiling/input_recorder.h"
+
+namespace s21 {
+
+/**
+ * @brief Проигрыватель записанного ввода
+ *
+ * Читает файл InputRecorder и передаёт события обработчику в порядке
+ * записи. В обычном режиме сохраняются исходные интервалы между
+ * событиями, в максимальном - следующее событие подаётся на очередной
+ * итерации цикла событий, чтобы между ними успевали отрисовываться кадры.
+ *
+ * Как именно событие применяется к интерфейсу (слайдер, мышь, загрузка),
+ * решает обработчик - проигрыватель отвечает только за расписание.
+ *
+ * @example
+ * @code
+ * InputReplayer replayer([this](const RecordedEvent& event) {
+ *   DispatchRecordedEvent_(event);
+ * });
+ * if (replayer.Load("session.s21rec")) replayer.Start(false);
+ * @endcode
+ */
+class InputReplayer : public QObject {
+  Q_OBJECT
+
+ public:
+  using Dispatcher = std::function<void(const RecordedEvent&)>;
+
+  /**
+   * @brief Создаёт проигрыватель
+   * @param dispatcher Обработчик, применяющий событие к интерфейсу
+   * @param parent Родительский объект Qt
+   */
+  explicit InputReplayer(Dispatcher dispatcher, QObject* parent = nullptr);
+
+  /**
+   * @brief Загружает запись из файла
+   * @return false если файл не открыт или повреждён
+   */
+  bool Load(const QString& path);
+
+  /**
+   * @brief Устанавливает запись из готового набора событий
+   * @param events События, упорядоченные по времени
+   */
+  void SetEvents(std::vector<RecordedEvent> events);
+
+  /**
+   * @brief Начинает воспроизведение загруженной записи
+   * @param max_speed true - без пауз между событиями
+   */
+  void Start(bool max_speed);
+
+  /**
+   * @brief Останавливает воспроизведение
+   */
+  void Stop();
+
+  /**
+   * @brief Проверяет, идёт ли воспроизведение
+   */
+  bool IsRunning() const noexcept { return running_; }
+
+  /**
+   * @brief Возвращает количество событий в записи
+   */
+  size_t GetEventCount() const noexcept { return events_.size(); }
+
+ signals:
+  /**
+   * @brief Все события воспроизведены
+   * @param elapsed_ms Длительность воспроизведения, мс
+   */
+  void Finished(double elapsed_ms);
+
+ private:
+  /**
+   * @brief Применяет наступившие события и планирует следующий вызов
+   */
+  void DispatchDue_();
+
+  Dispatcher dispatcher_;               ///< Применение события
+  std::vector<RecordedEvent> events_;  ///< Загруженная запись
+  size_t next_ = 0;                    ///< Индекс следующего события
+  bool max_speed_ = false;             ///< Воспроизведение без пауз
+  bool running_ = false;               ///< Идёт воспроизведение
+  QElapsedTimer clock_;                ///< Время от начала воспроизведения
+  QTimer timer_;                       ///< Таймер следующего события
+};
+
+}  // namespace s21
+
+#endif  // VIEW_INPUT_REPLAYER_H
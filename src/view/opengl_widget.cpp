@@ -5,19 +5,53 @@
 
 #include "opengl_widget.h"
 
+#include <QCoreApplication>
 #include <QDragEnterEvent>
 #include <QDropEvent>
 #include <QFileInfo>
+#include <QImage>
+#include <QLineF>
 #include <QMimeData>
 #include <QMouseEvent>
+#include <QOpenGLExtraFunctions>
+#include <QOpenGLFramebufferObject>
 #include <QOpenGLFunctions>
+#include <QPainter>
 #include <QPoint>
+#include <QPointer>
+#include <QTimer>
 #include <QUrl>
 #include <QWheelEvent>
+#include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <memory>
+
+#include "../model/parallel.h"
+#include "../profiling/latency.h"
+#include "../profiling/startup_profiler.h"
+#include "../profiling/trace.h"
 
 namespace s21 {
 
+namespace {
+
+/**
+ * @brief Проецирует точку в пиксели кадра; false - за ближней плоскостью
+ */
+bool ProjectToFrame(const Matrix4& m, int width, int height, const double* p,
+                    double screen[2]) {
+  const double cx = m[0] * p[0] + m[4] * p[1] + m[8] * p[2] + m[12];
+  const double cy = m[1] * p[0] + m[5] * p[1] + m[9] * p[2] + m[13];
+  const double cw = m[3] * p[0] + m[7] * p[1] + m[11] * p[2] + m[15];
+  if (cw < Camera::kNearPlane) return false;
+  screen[0] = (cx / cw + 1.0) * width * 0.5;
+  screen[1] = (1.0 - cy / cw) * height * 0.5;
+  return true;
+}
+
+}  // namespace
+
 OpenGLWidget::OpenGLWidget(QWidget* parent)
     : QOpenGLWidget(parent),
       vertex_coord_(nullptr),
@@ -31,27 +65,75 @@ OpenGLWidget::OpenGLWidget(QWidget* parent)
       scale_factor_(1.0f),
       translate_x_(0.0f),
       translate_y_(0.0f),
-      translate_z_(0.0f) {
+      translate_z_(0.0f),
+      rasterizer_(DefaultThreadCount()),
+      picker_(picker_worker_, DefaultThreadCount(), &NotifyPicker_, this),
+      slicer_(picker_worker_, DefaultThreadCount(), &NotifySlicer_, this) {
   setMinimumSize(800, 600);
 
   // Включаем поддержку drag&drop операций для загрузки файлов
   setAcceptDrops(true);
+
+  // Движение без нажатых кнопок нужно для выбора элемента под курсором
+  setMouseTracking(true);
+
+  frame_clock_.start();
+
+  // Текст HUD многострочный, строки разделяются HTML-переносами
+  hud_text_.setTextFormat(Qt::RichText);
+  hud_text_.setPerformanceHint(QStaticText::AggressiveCaching);
+
+  // Кадр считается выведенным после обмена буферов, а не после paintGL
+  connect(this, &QOpenGLWidget::frameSwapped, [this]() {
+    LatencyTracker::GetInstance().MarkPresented();
+    if (!first_frame_presented_) {
+      first_frame_presented_ = true;
+      StartupProfiler::GetInstance().Mark("first frame presented");
+    }
+  });
+}
+
+OpenGLWidget::~OpenGLWidget() {
+  // Запросы таймера удаляются только при активном контексте
+  makeCurrent();
+  for (auto& timer : gpu_timers_) {
+    timer.destroy();
+  }
+  if (!readbacks_.empty()) {
+    QOpenGLExtraFunctions* gl = context()->extraFunctions();
+    for (PendingReadback& readback : readbacks_) {
+      gl->glDeleteSync(readback.fence);
+      gl->glDeleteBuffers(1, &readback.buffer);
+    }
+  }
+  doneCurrent();
 }
 
-void OpenGLWidget::SetModelData(int* vertex_index, double* vertex_coord,
-                                int count_vertex_index,
-                                int count_vertex_coord) {
+void OpenGLWidget::SetModelData(const int* vertex_index,
+                                double* vertex_coord, int count_vertex_index,
+                                int count_vertex_coord,
+                                bool topology_changed) {
   // Сохраняем указатели на данные модели
   vertex_index_ = vertex_index;
   vertex_coord_ = vertex_coord;
   count_vertex_index_ = count_vertex_index;
   count_vertex_coord_ = count_vertex_coord;
+  if (topology_changed) {
+    boundary_edges_.clear();
+    non_manifold_edges_.clear();
+    vertex_colors_ = nullptr;
+  }
+  UpdatePicker_(topology_changed);
+  UpdateSlicer_(topology_changed);
 
   // Запрашиваем перерисовку для отображения новых данных
   update();
 }
 
 void OpenGLWidget::initializeGL() {
+  // К этому моменту контекст создан и сделан текущим
+  StartupProfiler::GetInstance().Mark("GL context");
+
   // Инициализируем функции OpenGL для использования в коде
   initializeOpenGLFunctions();
 
@@ -60,6 +142,10 @@ void OpenGLWidget::initializeGL() {
 
   // Включаем тест глубины для корректного отображения 3D объектов
   glEnable(GL_DEPTH_TEST);
+
+  // Запросы таймера GPU создаются при первом включении HUD,
+  // чтобы не задерживать первый кадр
+  StartupProfiler::GetInstance().Mark("initializeGL");
 }
 
 void OpenGLWidget::resizeGL(int w, int h) {
@@ -74,11 +160,66 @@ void OpenGLWidget::resizeGL(int w, int h) {
 }
 
 void OpenGLWidget::paintGL() {
+  S21_TRACE_SCOPE("OpenGLWidget::paintGL");
+
+  const qint64 frame_start_ns = frame_clock_.nsecsElapsed();
+  RestoreGlState_();
+  if (hud_visible_) {
+    BeginGpuTimer_();
+  }
+
   // Очищаем буферы цвета и глубины для нового кадра
   glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
+  if (backend_ == kBackendCpu) {
+    DrawModelCpu_();
+  } else {
+    DrawModel_();
+  }
+
+  // Снимки снимаются до HUD: оверлей в них не попадает
+  if (!capture_requests_.empty()) {
+    std::vector<CaptureRequest> requests;
+    requests.swap(capture_requests_);
+    for (const CaptureRequest& request : requests) {
+      if (backend_ == kBackendCpu) {
+        CaptureCpu_(request);
+      } else {
+        StartReadback_(request);
+      }
+    }
+  }
+
+  if (hover_.kind != kPickNone) {
+    DrawHovered_();
+  }
+  if (selecting_ || selection_stats_.count > 0) {
+    DrawSelectionOverlay_();
+  }
+  if (section_axis_ >= 0) {
+    DrawSectionOverlay_();
+  }
+
+  if (hud_visible_) {
+    EndGpuTimer_();
+    frame_stats_.AddFrame(
+        frame_start_ns / 1e6,
+        (frame_clock_.nsecsElapsed() - frame_start_ns) / 1e6);
+    DrawHud_();
+  }
+
+  if (!first_frame_presented_) {
+    StartupProfiler::GetInstance().MarkOnce("first paintGL");
+  }
+  emit FrameRendered((frame_clock_.nsecsElapsed() - frame_start_ns) / 1e6);
+}
+
+void OpenGLWidget::DrawModel_() {
+  RenderCounters counters;
+
   // Проверяем наличие валидных данных модели
   if (!vertex_coord_ || !vertex_index_ || count_vertex_coord_ == 0) {
+    frame_stats_.SetCounters(counters);
     return;
   }
 
@@ -116,22 +257,442 @@ void OpenGLWidget::paintGL() {
    *
    * Проходим по массиву индексов рёбер попарно. Каждая пара индексов
    * определяет одно ребро модели. Для каждого ребра получаем координаты
-   * вершин и отрисовываем линию между ними.
+   * вершин и отрисовываем линию между ними. Вырожденные рёбра (обе
+   * вершины совпадают) не дают пикселей и отбрасываются.
    */
   for (int i = 0; i < count_vertex_index_; i += 2) {
     // Получаем индексы первой и второй вершины ребра
     int idx1 = vertex_index_[i] * 3;  // Умножаем на 3 (x,y,z координаты)
     int idx2 = vertex_index_[i + 1] * 3;
 
-    // Отрисовываем линию от первой вершины ко второй
+    if (idx1 == idx2) {
+      ++counters.edges_culled;
+      continue;
+    }
+
+    // Отрисовываем линию от первой вершины ко второй; с тепловой картой
+    // цвет интерполируется между цветами вершин
+    if (vertex_colors_) glColor3fv(vertex_colors_ + idx1);
     glVertex3d(vertex_coord_[idx1], vertex_coord_[idx1 + 1],
                vertex_coord_[idx1 + 2]);
+    if (vertex_colors_) glColor3fv(vertex_colors_ + idx2);
     glVertex3d(vertex_coord_[idx2], vertex_coord_[idx2 + 1],
                vertex_coord_[idx2 + 2]);
+    ++counters.edges_submitted;
   }
 
   // Завершаем отрисовку линий
   glEnd();
+
+  // Выделенные вершины - точками поверх каркаса прямо из буфера вида
+  if (!selected_vertices_.empty()) {
+    glPointSize(4.0f);
+    glColor3f(1.0f, 0.55f, 0.0f);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(3, GL_DOUBLE, 0, vertex_coord_);
+    glDrawElements(GL_POINTS, static_cast<GLsizei>(selected_vertices_.size()),
+                   GL_UNSIGNED_INT, selected_vertices_.data());
+    glDisableClientState(GL_VERTEX_ARRAY);
+  }
+
+  // Край и неманифолдные рёбра - толще и цветом поверх каркаса
+  if (topology_visible_ &&
+      (!boundary_edges_.empty() || !non_manifold_edges_.empty())) {
+    glLineWidth(2.0f);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(3, GL_DOUBLE, 0, vertex_coord_);
+    glColor3f(0.2f, 0.75f, 1.0f);
+    glDrawElements(GL_LINES, static_cast<GLsizei>(boundary_edges_.size()),
+                   GL_UNSIGNED_INT, boundary_edges_.data());
+    glColor3f(1.0f, 0.2f, 1.0f);
+    glDrawElements(GL_LINES, static_cast<GLsizei>(non_manifold_edges_.size()),
+                   GL_UNSIGNED_INT, non_manifold_edges_.data());
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glLineWidth(1.0f);
+  }
+
+  // Контуры сечения - ломаными поверх каркаса
+  if (!section_.polylines.empty()) {
+    glLineWidth(2.0f);
+    glColor3f(1.0f, 0.25f, 0.25f);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    for (const SectionPolyline& polyline : section_.polylines) {
+      glVertexPointer(3, GL_DOUBLE, 0, polyline.points.data());
+      glDrawArrays(polyline.closed ? GL_LINE_LOOP : GL_LINE_STRIP, 0,
+                   static_cast<GLsizei>(polyline.points.size() / 3));
+    }
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glLineWidth(1.0f);
+  }
+
+  // Непосредственный режим передаёт две вершины по три double на ребро
+  counters.upload_bytes = counters.edges_submitted * 2 * 3 * sizeof(double);
+  frame_stats_.SetCounters(counters);
+}
+
+void OpenGLWidget::DrawModelCpu_() {
+  S21_TRACE_SCOPE("OpenGLWidget::DrawModelCpu_");
+  RenderCounters counters;
+
+  if (!vertex_coord_ || !vertex_index_ || count_vertex_coord_ == 0) {
+    frame_stats_.SetCounters(counters);
+    return;
+  }
+
+  // Координаты меняются трансформациями на месте, поэтому копируются
+  // каждый кадр; буферы после первого кадра не перевыделяются
+  cpu_mesh_.position.resize(count_vertex_coord_);
+  std::copy(vertex_coord_, vertex_coord_ + count_vertex_coord_,
+            cpu_mesh_.position.begin());
+  cpu_mesh_.edges.clear();
+  const int vertex_count = count_vertex_coord_ / 3;
+  for (int i = 0; i + 1 < count_vertex_index_; i += 2) {
+    const int a = vertex_index_[i];
+    const int b = vertex_index_[i + 1];
+    if (a == b || a < 0 || b < 0 || a >= vertex_count || b >= vertex_count) {
+      ++counters.edges_culled;
+      continue;
+    }
+    cpu_mesh_.edges.push_back(static_cast<uint32_t>(a));
+    cpu_mesh_.edges.push_back(static_cast<uint32_t>(b));
+    ++counters.edges_submitted;
+  }
+
+  const qreal ratio = devicePixelRatio();
+  const int frame_width = static_cast<int>(width() * ratio);
+  const int frame_height = static_cast<int>(height() * ratio);
+  rasterizer_.Render(cpu_mesh_, CurrentCamera_(), RenderStyle(), frame_width,
+                     frame_height, cpu_frame_);
+  DrawVertexColorsCpu_();
+  DrawTopologyCpu_();
+  DrawSelectionCpu_();
+  DrawSectionCpu_();
+
+  // Байты Image идут как R, G, B, A - картинка оборачивается без копии
+  QImage frame(reinterpret_cast<const uchar*>(cpu_frame_.pixels.data()),
+               frame_width, frame_height, QImage::Format_RGBA8888);
+  frame.setDevicePixelRatio(ratio);
+  QPainter painter(this);
+  painter.drawImage(QPointF(0.0, 0.0), frame);
+
+  // В драйвер уходит готовый кадр, а не вершины
+  counters.upload_bytes = cpu_frame_.pixels.size() * sizeof(uint32_t);
+  frame_stats_.SetCounters(counters);
+}
+
+Camera OpenGLWidget::CurrentCamera_() const {
+  // Тот же конвейер, что glTranslate/glRotate/glScale в DrawModel_
+  Camera camera;
+  camera.rotation[0] = rotation_x_;
+  camera.rotation[1] = rotation_y_;
+  camera.rotation[2] = rotation_z_;
+  camera.translate[0] = translate_x_;
+  camera.translate[1] = translate_y_;
+  camera.translate[2] = translate_z_;
+  camera.scale = scale_factor_;
+  camera.keep_aspect = false;
+  return camera;
+}
+
+void OpenGLWidget::SetCamera(const Camera& camera) {
+  rotation_x_ = static_cast<float>(camera.rotation[0]);
+  rotation_y_ = static_cast<float>(camera.rotation[1]);
+  rotation_z_ = static_cast<float>(camera.rotation[2]);
+  scale_factor_ =
+      std::clamp(static_cast<float>(camera.scale), kMinScale, kMaxScale);
+  // Смещение центрирует модель после масштаба и меняется вместе с ним
+  const double ratio = camera.scale > 0.0 ? scale_factor_ / camera.scale : 1.0;
+  translate_x_ = static_cast<float>(camera.translate[0] * ratio);
+  translate_y_ = static_cast<float>(camera.translate[1] * ratio);
+  translate_z_ = static_cast<float>(camera.translate[2] * ratio);
+  // Под неподвижным курсором теперь другой элемент
+  if (hover_.kind != kPickNone) PickAt_(hover_position_);
+  update();
+}
+
+void OpenGLWidget::RequestCapture(int scale, CaptureCallback done) {
+  capture_requests_.push_back(
+      {std::clamp(scale, 1, kMaxCaptureScale), std::move(done)});
+  update();
+}
+
+QSize OpenGLWidget::CaptureSize_(int& scale) const {
+  const qreal ratio = devicePixelRatio();
+  const int frame_width = std::max(1, static_cast<int>(width() * ratio));
+  const int frame_height = std::max(1, static_cast<int>(height() * ratio));
+  while (scale > 1 && std::max(frame_width, frame_height) * scale >
+                          kMaxCaptureSide) {
+    --scale;
+  }
+  return QSize(frame_width, frame_height);
+}
+
+void OpenGLWidget::StartReadback_(const CaptureRequest& request) {
+  S21_TRACE_SCOPE("OpenGLWidget::StartReadback_");
+  QOpenGLExtraFunctions* gl = context()->extraFunctions();
+  int scale = request.scale;
+  const QSize tile = CaptureSize_(scale);
+
+  PendingReadback readback;
+  readback.width = tile.width() * scale;
+  readback.height = tile.height() * scale;
+  readback.done = request.done;
+  gl->glGenBuffers(1, &readback.buffer);
+  gl->glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.buffer);
+  gl->glBufferData(GL_PIXEL_PACK_BUFFER,
+                   static_cast<GLsizeiptr>(readback.width) * readback.height *
+                       4,
+                   nullptr, GL_STREAM_READ);
+  glPixelStorei(GL_PACK_ALIGNMENT, 4);
+
+  if (scale == 1) {
+    // glReadPixels в PBO только ставит копирование в очередь GPU
+    glReadPixels(0, 0, tile.width(), tile.height(), GL_RGBA,
+                 GL_UNSIGNED_BYTE, nullptr);
+  } else {
+    // Плитки рисуются во внеэкранный буфер размером с окно и читаются
+    // каждая на своё место общего буфера (строка - вся ширина снимка)
+    QOpenGLFramebufferObject target(
+        tile, QOpenGLFramebufferObject::CombinedDepthStencil);
+    target.bind();
+    glPixelStorei(GL_PACK_ROW_LENGTH, readback.width);
+    for (int row = 0; row < scale; ++row) {
+      for (int column = 0; column < scale; ++column) {
+        const Matrix4 projection = TileMatrix(column, row, scale, scale);
+        glMatrixMode(GL_PROJECTION);
+        glLoadMatrixd(projection.data());
+        glMatrixMode(GL_MODELVIEW);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        DrawModel_();
+        const size_t offset =
+            (static_cast<size_t>(row) * tile.height() * readback.width +
+             static_cast<size_t>(column) * tile.width()) *
+            4;
+        glReadPixels(0, 0, tile.width(), tile.height(), GL_RGBA,
+                     GL_UNSIGNED_BYTE, reinterpret_cast<void*>(offset));
+      }
+    }
+    glPixelStorei(GL_PACK_ROW_LENGTH, 0);
+    glMatrixMode(GL_PROJECTION);
+    glLoadIdentity();
+    glMatrixMode(GL_MODELVIEW);
+    gl->glBindFramebuffer(GL_FRAMEBUFFER, defaultFramebufferObject());
+  }
+
+  gl->glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  readback.fence = gl->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  glFlush();
+  readbacks_.push_back(std::move(readback));
+  QTimer::singleShot(kReadbackPollMs, this, &OpenGLWidget::PollReadbacks_);
+}
+
+void OpenGLWidget::PollReadbacks_() {
+  if (readbacks_.empty()) {
+    return;
+  }
+  S21_TRACE_SCOPE("OpenGLWidget::PollReadbacks_");
+
+  std::vector<std::pair<CaptureCallback, QImage>> finished;
+  makeCurrent();
+  QOpenGLExtraFunctions* gl = context()->extraFunctions();
+  for (auto it = readbacks_.begin(); it != readbacks_.end();) {
+    // Нулевой таймаут: опрос не блокирует GUI-поток
+    const GLenum status = gl->glClientWaitSync(it->fence, 0, 0);
+    if (status == GL_TIMEOUT_EXPIRED) {
+      ++it;
+      continue;
+    }
+
+    QImage image;
+    if (status != GL_WAIT_FAILED) {
+      const qsizetype row_bytes = static_cast<qsizetype>(it->width) * 4;
+      gl->glBindBuffer(GL_PIXEL_PACK_BUFFER, it->buffer);
+      const auto* data = static_cast<const uchar*>(gl->glMapBufferRange(
+          GL_PIXEL_PACK_BUFFER, 0, row_bytes * it->height, GL_MAP_READ_BIT));
+      if (data) {
+        // Строки OpenGL идут снизу вверх
+        image = QImage(it->width, it->height, QImage::Format_RGBX8888);
+        for (int y = 0; y < it->height; ++y) {
+          std::memcpy(image.scanLine(y),
+                      data + (it->height - 1 - y) * row_bytes, row_bytes);
+        }
+        gl->glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+      }
+      gl->glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    }
+    gl->glDeleteSync(it->fence);
+    gl->glDeleteBuffers(1, &it->buffer);
+    finished.emplace_back(std::move(it->done), std::move(image));
+    it = readbacks_.erase(it);
+  }
+  doneCurrent();
+
+  if (!readbacks_.empty()) {
+    QTimer::singleShot(kReadbackPollMs, this, &OpenGLWidget::PollReadbacks_);
+  }
+  for (auto& [done, image] : finished) {
+    done(std::move(image));
+  }
+}
+
+void OpenGLWidget::CaptureCpu_(const CaptureRequest& request) {
+  int scale = request.scale;
+  const QSize frame = CaptureSize_(scale);
+  const int capture_width = frame.width() * scale;
+  const int capture_height = frame.height() * scale;
+  // Снимок не зависит от дальнейших трансформаций модели
+  auto mesh = std::make_shared<const RenderMesh>(cpu_mesh_);
+  const Camera camera = CurrentCamera_();
+  QPointer<OpenGLWidget> self(this);
+  CaptureCallback done = request.done;
+
+  const bool posted = capture_worker_.Post([mesh, camera, self, done,
+                                           capture_width, capture_height] {
+    S21_TRACE_SCOPE("OpenGLWidget::CaptureCpu_");
+    Rasterizer rasterizer(DefaultThreadCount());
+    Image image;
+    rasterizer.Render(*mesh, camera, RenderStyle(), capture_width,
+                      capture_height, image);
+    QImage result(capture_width, capture_height, QImage::Format_RGBX8888);
+    for (int y = 0; y < capture_height; ++y) {
+      std::memcpy(result.scanLine(y),
+                  image.pixels.data() + static_cast<size_t>(y) * image.width,
+                  static_cast<size_t>(capture_width) * 4);
+    }
+    QMetaObject::invokeMethod(
+        qApp, [self, done, result] {
+          if (self) done(result);
+        },
+        Qt::QueuedConnection);
+  });
+  if (!posted) {
+    QMetaObject::invokeMethod(
+        this, [done] { done(QImage()); }, Qt::QueuedConnection);
+  }
+}
+
+void OpenGLWidget::SetRenderBackend(render_backend_t backend) {
+  backend_ = backend;
+  update();
+}
+
+void OpenGLWidget::SetHudVisible(bool visible) {
+  hud_visible_ = visible;
+  hud_text_updated_ms_ = -1e9;
+  update();
+}
+
+void OpenGLWidget::SetOperationTimings(double load_ms, double transform_ms) {
+  timings_.load_ms = load_ms;
+  timings_.transform_ms = transform_ms;
+}
+
+void OpenGLWidget::RestoreGlState_() {
+  // QPainter оставляет свою программу, буферы и смешивание - возвращаем
+  // состояние, на которое рассчитан фиксированный конвейер
+  glUseProgram(0);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  for (GLuint attribute = 0; attribute < 3; ++attribute) {
+    glDisableVertexAttribArray(attribute);
+  }
+  glDisable(GL_BLEND);
+  glDisable(GL_SCISSOR_TEST);
+  glDisable(GL_STENCIL_TEST);
+  glEnable(GL_DEPTH_TEST);
+  glDepthMask(GL_TRUE);
+  glViewport(0, 0, static_cast<GLsizei>(width() * devicePixelRatio()),
+             static_cast<GLsizei>(height() * devicePixelRatio()));
+}
+
+void OpenGLWidget::BeginGpuTimer_() {
+  if (!gpu_timer_created_) {
+    // Таймеры GPU (GL_TIME_ELAPSED) поддерживаются и программным llvmpipe;
+    // без них HUD показывает только время CPU
+    gpu_timer_created_ = true;
+    gpu_timer_supported_ = gpu_timers_[0].create() && gpu_timers_[1].create();
+  }
+  if (!gpu_timer_supported_) {
+    return;
+  }
+
+  // Результат читается только когда готов, иначе кадр пропускается
+  for (int i = 0; i < 2; ++i) {
+    if (gpu_timer_pending_[i] && gpu_timers_[i].isResultAvailable()) {
+      frame_stats_.SetGpuMs(gpu_timers_[i].waitForResult() / 1e6);
+      gpu_timer_pending_[i] = false;
+    }
+  }
+
+  gpu_timers_[gpu_timer_index_].begin();
+}
+
+void OpenGLWidget::EndGpuTimer_() {
+  if (!gpu_timer_supported_) {
+    return;
+  }
+
+  gpu_timers_[gpu_timer_index_].end();
+  gpu_timer_pending_[gpu_timer_index_] = true;
+  gpu_timer_index_ ^= 1;
+}
+
+void OpenGLWidget::DrawHud_() {
+  constexpr double kGraphWidth = 240.0;
+  constexpr double kGraphHeight = 50.0;
+  constexpr double kTargetFrameMs = 1000.0 / 60.0;
+  const QRectF panel(8.0, 8.0, 256.0, 214.0);
+
+  const double now_ms = frame_clock_.nsecsElapsed() / 1e6;
+  if (now_ms - hud_text_updated_ms_ >= kHudTextIntervalMs) {
+    const RenderCounters& counters = frame_stats_.GetCounters();
+    const double gpu_ms = frame_stats_.GetGpuMs();
+    const LatencyHistogram& slider_latency =
+        LatencyTracker::GetInstance().GetHistogram(kInputSlider);
+    hud_text_.setText(
+        QString("FPS: %1<br>CPU: %2 мс<br>GPU: %3<br>Рёбер: %4<br>"
+                "Отброшено: %5<br>Передано: %6 КБ<br>"
+                "Загрузка: %7 мс<br>Трансформация: %8 мс<br>"
+                "Ввод→кадр p50/p99: %9/%10 мс")
+            .arg(frame_stats_.GetFps(), 0, 'f', 1)
+            .arg(frame_stats_.GetCpuMs(), 0, 'f', 2)
+            .arg(gpu_ms < 0.0 ? QString("н/д")
+                              : QString("%1 мс").arg(gpu_ms, 0, 'f', 2))
+            .arg(counters.edges_submitted)
+            .arg(counters.edges_culled)
+            .arg(counters.upload_bytes / 1024)
+            .arg(timings_.load_ms, 0, 'f', 1)
+            .arg(timings_.transform_ms, 0, 'f', 2)
+            .arg(slider_latency.GetPercentileUs(0.5) / 1000.0, 0, 'f', 1)
+            .arg(slider_latency.GetPercentileUs(0.99) / 1000.0, 0, 'f', 1));
+    hud_text_updated_ms_ = now_ms;
+  }
+
+  QPainter painter(this);
+  painter.fillRect(panel, QColor(0, 0, 0, 170));
+  painter.setPen(QColor(120, 255, 120));
+  painter.drawStaticText(QPointF(panel.left() + 8.0, panel.top() + 4.0),
+                         hud_text_);
+
+  // График: шкала не меньше бюджета кадра 60 FPS, линия бюджета - жёлтая
+  const double graph_left = panel.left() + 8.0;
+  const double graph_bottom = panel.bottom() - 6.0;
+  const double scale_ms = std::max(frame_stats_.GetMaxCpuMs(), kTargetFrameMs);
+  const double target_y =
+      graph_bottom - kGraphHeight * kTargetFrameMs / scale_ms;
+  painter.setPen(QColor(255, 200, 0));
+  painter.drawLine(QPointF(graph_left, target_y),
+                   QPointF(graph_left + kGraphWidth, target_y));
+
+  const size_t count = frame_stats_.GetHistorySize();
+  const double step = kGraphWidth / (FrameStats::kHistorySize - 1);
+  for (size_t i = 0; i < count; ++i) {
+    graph_points_[i] =
+        QPointF(graph_left + i * step,
+                graph_bottom -
+                    kGraphHeight * frame_stats_.GetCpuMsAt(i) / scale_ms);
+  }
+  painter.setPen(QColor(120, 255, 120));
+  painter.drawPolyline(graph_points_.data(), static_cast<int>(count));
 }
 
 // === Публичные методы-обёртки для внешнего доступа ===
@@ -161,17 +722,66 @@ void OpenGLWidget::mousePressEvent(QMouseEvent* event) {
    * При нажатии левой кнопки мыши запоминаем позицию для
    * последующего вычисления перемещения курсора.
    */
+  RecordMouseEvent_(kEventMousePress, event);
+  if (event->modifiers().testFlag(Qt::ShiftModifier) &&
+      (event->button() == Qt::LeftButton ||
+       event->button() == Qt::RightButton)) {
+    selecting_ = true;
+    selecting_lasso_ = event->button() == Qt::RightButton;
+    selection_path_.assign(2, QPointF(event->pos()));
+    hover_ = PickResult();
+    // Иерархии обновляются, пока рисуется рамка
+    StartPickerJob_();
+    update();
+    return;
+  }
+  if (section_axis_ >= 0 && event->button() == Qt::LeftButton &&
+      event->modifiers().testFlag(Qt::AltModifier)) {
+    dragging_section_ = true;
+    last_mouse_position_ = event->pos();
+    hover_ = PickResult();
+    update();
+    return;
+  }
   if (event->button() == Qt::LeftButton) {
     mouse_pressed_ = true;
     last_mouse_position_ = event->pos();
+    // Вращение сдвигает модель из-под курсора
+    hover_ = PickResult();
+    update();
   }
 }
 
 void OpenGLWidget::mouseMoveEvent(QMouseEvent* event) {
+  RecordMouseEvent_(kEventMouseMove, event);
+  if (selecting_) {
+    const QPointF point(event->pos());
+    if (!selecting_lasso_) {
+      selection_path_.back() = point;
+    } else if (QLineF(selection_path_.back(), point).length() >= 2.0) {
+      selection_path_.push_back(point);
+    }
+    update();
+    return;
+  }
+  if (dragging_section_) {
+    LatencyTracker::GetInstance().MarkInput(kInputMouse);
+    // Высота окна - весь габарит модели по оси, вверх - к большим значениям
+    const double delta = last_mouse_position_.y() - event->pos().y();
+    section_level_ =
+        std::clamp(section_level_ + delta * (section_max_ - section_min_) /
+                                        std::max(1, height()),
+                   section_min_, section_max_);
+    last_mouse_position_ = event->pos();
+    Reslice_();
+    return;
+  }
   if (!mouse_pressed_ || !(event->buttons() & Qt::LeftButton)) {
+    if (event->buttons() == Qt::NoButton) PickAt_(event->pos());
     return;
   }
 
+  LatencyTracker::GetInstance().MarkInput(kInputMouse);
   QPoint delta = event->pos() - last_mouse_position_;
 
   // Обновляем углы поворота с нормализацией
@@ -192,22 +802,495 @@ void OpenGLWidget::mouseReleaseEvent(QMouseEvent* event) {
   /**
    * @brief Завершение интерактивного вращения
    */
+  RecordMouseEvent_(kEventMouseRelease, event);
+  if (selecting_ && event->button() == (selecting_lasso_ ? Qt::RightButton
+                                                          : Qt::LeftButton)) {
+    selecting_ = false;
+    const Qt::KeyboardModifiers modifiers = event->modifiers();
+    ApplySelection_(modifiers.testFlag(Qt::ControlModifier) ? kSelectSubtract
+                    : modifiers.testFlag(Qt::AltModifier)   ? kSelectAdd
+                                                            : kSelectReplace);
+    return;
+  }
   if (event->button() == Qt::LeftButton) {
     mouse_pressed_ = false;
+    dragging_section_ = false;
   }
 }
 
 void OpenGLWidget::wheelEvent(QWheelEvent* event) {
   constexpr float kScaleSensitivity = 1200.0f;
-  constexpr float kMinScale = 0.1f;
-  constexpr float kMaxScale = 10.0f;
+
+  LatencyTracker::GetInstance().MarkInput(kInputWheel);
+  const QPoint wheel_position = event->position().toPoint();
+  InputRecorder::GetInstance().Record(kEventWheel, wheel_position.x(),
+                                      wheel_position.y(),
+                                      event->angleDelta().y());
 
   float scale_delta = event->angleDelta().y() / kScaleSensitivity;
   scale_factor_ = std::clamp(scale_factor_ + scale_delta, kMinScale, kMaxScale);
 
+  // Под неподвижным курсором после масштабирования другой элемент
+  if (hover_.kind != kPickNone) PickAt_(hover_position_);
+  update();
+}
+
+void OpenGLWidget::leaveEvent(QEvent* event) {
+  QOpenGLWidget::leaveEvent(event);
+  if (hover_.kind != kPickNone) {
+    hover_ = PickResult();
+    update();
+  }
+}
+
+// === Выбор под курсором ===
+
+void OpenGLWidget::UpdatePicker_(bool rebuild) {
+  picker_.Invalidate(rebuild);
+  hover_ = PickResult();
+  // Биты выделения привязаны к порядку иерархии и после Build неверны
+  if (rebuild) ClearSelection();
+  // Итог выделения показывает box выделенных, он должен идти за моделью
+  if (selection_stats_.count > 0) StartPickerJob_();
+}
+
+void OpenGLWidget::StartPickerJob_() {
+  if (!picker_.NeedsUpdate()) return;
+  const int count = vertex_coord_ ? std::max(count_vertex_coord_, 0) : 0;
+  if (!picker_.NeedsBuild()) {
+    picker_.StartRefit(vertex_coord_, count);
+    return;
+  }
+
+  // Вид меняет свои буферы на каждой трансформации, поэтому иерархии
+  // строятся по собственной копии
+  std::vector<float> positions(vertex_coord_, vertex_coord_ + count);
+  std::vector<int> edges;
+  if (vertex_index_ && count_vertex_index_ > 0) {
+    edges.assign(vertex_index_, vertex_index_ + count_vertex_index_);
+  }
+  picker_.StartBuild([positions = std::move(positions),
+                      edges = std::move(edges)](Picker& picker) mutable {
+    picker.Build(std::move(positions), std::move(edges));
+  });
+}
+
+void OpenGLWidget::FinishPickerJob_() {
+  picker_.Finish();
+  if (picker_.NeedsUpdate()) {
+    // Модель менялась во время обновления
+    if (selection_stats_.count > 0 || underMouse()) StartPickerJob_();
+    return;
+  }
+  // После Refit выделение прежнее, но box выделенных сдвинулся
+  if (selection_stats_.count > 0) RefreshSelection_();
+  if (underMouse() && !mouse_pressed_) PickAt_(hover_position_);
+}
+
+void OpenGLWidget::NotifyPicker_(void* widget) {
+  auto* self = static_cast<OpenGLWidget*>(widget);
+  // Виджет - контекст вызова: после его удаления вызов отбрасывается
+  QMetaObject::invokeMethod(
+      self, [self] { self->FinishPickerJob_(); }, Qt::QueuedConnection);
+}
+
+void OpenGLWidget::PickAt_(const QPoint& position) {
+  hover_position_ = position;
+  PickResult hit;
+  if (const Picker* picker = picker_.Get()) {
+    S21_TRACE_SCOPE("OpenGLWidget::PickAt_");
+    hit = picker->Pick(CurrentCamera_(), width(), height(),
+                       position.x() + 0.5, position.y() + 0.5);
+  } else {
+    // Иерархии устарели после трансформации: ответ придёт в
+    // FinishPickerJob_
+    StartPickerJob_();
+  }
+  const bool changed = hit.kind != hover_.kind || hit.index != hover_.index ||
+                       (hit.kind == kPickEdge &&
+                        std::memcmp(hit.position, hover_.position,
+                                    sizeof(hit.position)) != 0);
+  hover_ = hit;
+  if (changed) update();
+}
+
+void OpenGLWidget::DrawHovered_() {
+  const Matrix4 m = CurrentCamera_().BuildMatrix(width(), height());
+  const double* p = hover_.position;
+  const double cx = m[0] * p[0] + m[4] * p[1] + m[8] * p[2] + m[12];
+  const double cy = m[1] * p[0] + m[5] * p[1] + m[9] * p[2] + m[13];
+  const double cw = m[3] * p[0] + m[7] * p[1] + m[11] * p[2] + m[15];
+  if (cw <= 0.0) return;
+  const QPointF marker((cx / cw + 1.0) * width() * 0.5,
+                       (1.0 - cy / cw) * height() * 0.5);
+
+  // Координаты вершины берутся из буфера вида (double), точка ребра -
+  // из копии Picker
+  double position[3] = {p[0], p[1], p[2]};
+  if (hover_.kind == kPickVertex &&
+      (hover_.index + 1) * 3 <= static_cast<size_t>(count_vertex_coord_)) {
+    std::copy(vertex_coord_ + hover_.index * 3,
+              vertex_coord_ + hover_.index * 3 + 3, position);
+  }
+  const QString coordinates = QString("(%1, %2, %3)")
+                                  .arg(position[0], 0, 'g', 6)
+                                  .arg(position[1], 0, 'g', 6)
+                                  .arg(position[2], 0, 'g', 6);
+  const QString text =
+      hover_.kind == kPickVertex
+          ? QString("Вершина #%1 %2").arg(hover_.index).arg(coordinates)
+          : QString("Ребро #%1 (%2-%3), точка %4")
+                .arg(hover_.index)
+                .arg(hover_.vertex[0])
+                .arg(hover_.vertex[1])
+                .arg(coordinates);
+
+  QPainter painter(this);
+  painter.setRenderHint(QPainter::Antialiasing);
+  painter.setPen(QPen(QColor(255, 200, 0), 2.0));
+  painter.setBrush(Qt::NoBrush);
+  painter.drawEllipse(marker, 5.0, 5.0);
+
+  const QRectF label(8.0, height() - 30.0, width() - 16.0, 22.0);
+  const QRectF bounds = painter.boundingRect(label, Qt::AlignLeft, text);
+  painter.fillRect(bounds.adjusted(-6.0, -3.0, 6.0, 3.0), QColor(0, 0, 0, 170));
+  painter.setPen(QColor(255, 200, 0));
+  painter.drawText(label, Qt::AlignLeft, text);
+}
+
+// === Выделение вершин ===
+
+void OpenGLWidget::ClearSelection() {
+  const bool had_selection = selection_stats_.count > 0;
+  selection_.Reset(0);
+  selected_vertices_.clear();
+  selection_stats_ = SelectionStats();
+  if (had_selection) update();
+}
+
+void OpenGLWidget::ApplySelection_(select_mode_t mode) {
+  // Пока иерархии строятся, выделять не по чему
+  const Picker* picker = picker_.Get();
+  if (!picker) {
+    StartPickerJob_();
+    update();
+    return;
+  }
+  S21_TRACE_SCOPE("OpenGLWidget::ApplySelection_");
+  // Координаты пикселей - как при выборе под курсором: центр пикселя
+  ScreenRegion region;
+  if (selecting_lasso_) {
+    std::vector<double> points;
+    points.reserve(selection_path_.size() * 2);
+    for (const QPointF& point : selection_path_) {
+      points.push_back(point.x() + 0.5);
+      points.push_back(point.y() + 0.5);
+    }
+    region = ScreenRegion::Lasso(points, width(), height());
+  } else {
+    const QPointF& from = selection_path_.front();
+    const QPointF& to = selection_path_.back();
+    region = ScreenRegion::Rect(from.x() + 0.5, from.y() + 0.5,
+                                to.x() + 0.5, to.y() + 0.5);
+  }
+  picker->Select(CurrentCamera_(), width(), height(), region, mode,
+                 selection_);
+  RefreshSelection_();
+  update();
+}
+
+void OpenGLWidget::RefreshSelection_() {
+  const Picker* picker = picker_.Get();
+  if (!picker) return;
+  picker->GetSelectedVertices(selection_, selected_vertices_);
+  selection_stats_ = picker->Summarize(selection_);
+}
+
+void OpenGLWidget::DrawSelectionCpu_() {
+  if (selected_vertices_.empty()) return;
+  S21_TRACE_SCOPE("OpenGLWidget::DrawSelectionCpu_");
+  const int frame_width = cpu_frame_.width, frame_height = cpu_frame_.height;
+  const Matrix4 m = CurrentCamera_().BuildMatrix(frame_width, frame_height);
+  const uint32_t color = MakeColor(255, 140, 0);
+  const int vertex_count = count_vertex_coord_ / 3;
+  for (uint32_t vertex : selected_vertices_) {
+    if (vertex >= static_cast<uint32_t>(vertex_count)) continue;
+    const double* p = vertex_coord_ + size_t{vertex} * 3;
+    const double cx = m[0] * p[0] + m[4] * p[1] + m[8] * p[2] + m[12];
+    const double cy = m[1] * p[0] + m[5] * p[1] + m[9] * p[2] + m[13];
+    const double cw = m[3] * p[0] + m[7] * p[1] + m[11] * p[2] + m[15];
+    if (cw < Camera::kNearPlane) continue;
+    // Квадрат 3 x 3 вокруг вершины
+    const int x = static_cast<int>((cx / cw + 1.0) * frame_width * 0.5);
+    const int y = static_cast<int>((1.0 - cy / cw) * frame_height * 0.5);
+    for (int py = std::max(y - 1, 0); py <= std::min(y + 1, frame_height - 1);
+         ++py) {
+      for (int px = std::max(x - 1, 0);
+           px <= std::min(x + 1, frame_width - 1); ++px) {
+        cpu_frame_.pixels[static_cast<size_t>(py) * frame_width + px] = color;
+      }
+    }
+  }
+}
+
+void OpenGLWidget::DrawSelectionOverlay_() {
+  QPainter painter(this);
+  painter.setRenderHint(QPainter::Antialiasing);
+  if (selecting_) {
+    painter.setPen(QPen(QColor(255, 140, 0), 1.0, Qt::DashLine));
+    painter.setBrush(QColor(255, 140, 0, 40));
+    if (selecting_lasso_) {
+      painter.drawPolygon(selection_path_.data(),
+                          static_cast<int>(selection_path_.size()));
+    } else {
+      painter.drawRect(
+          QRectF(selection_path_.front(), selection_path_.back()));
+    }
+  }
+  if (selection_stats_.count == 0) return;
+
+  const SelectionStats& stats = selection_stats_;
+  const QString text =
+      QString("Выделено вершин: %1, box (%2, %3, %4) - (%5, %6, %7)")
+          .arg(stats.count)
+          .arg(stats.min[0], 0, 'g', 6)
+          .arg(stats.min[1], 0, 'g', 6)
+          .arg(stats.min[2], 0, 'g', 6)
+          .arg(stats.max[0], 0, 'g', 6)
+          .arg(stats.max[1], 0, 'g', 6)
+          .arg(stats.max[2], 0, 'g', 6);
+  // Над подписью элемента под курсором
+  const QRectF label(8.0, height() - 58.0, width() - 16.0, 22.0);
+  const QRectF bounds = painter.boundingRect(label, Qt::AlignLeft, text);
+  painter.fillRect(bounds.adjusted(-6.0, -3.0, 6.0, 3.0), QColor(0, 0, 0, 170));
+  painter.setPen(QColor(255, 140, 0));
+  painter.drawText(label, Qt::AlignLeft, text);
+}
+
+// === Сечение плоскостью ===
+
+void OpenGLWidget::SetModelFaces(const int* face_index,
+                                 const int* face_offset, int face_count) {
+  face_index_ = face_index;
+  face_offset_ = face_offset;
+  face_count_ = face_count;
+}
+
+void OpenGLWidget::SetSectionAxis(int axis) {
+  section_axis_ = axis >= 0 && axis <= 2 ? axis : -1;
+  dragging_section_ = false;
+  section_ = Section();
+  if (section_axis_ >= 0) {
+    // Плоскость - в середине габарита модели по оси
+    double low = 0.0, high = 0.0;
+    for (int i = section_axis_; i < count_vertex_coord_; i += 3) {
+      const double value = vertex_coord_[i];
+      low = i == section_axis_ ? value : std::min(low, value);
+      high = i == section_axis_ ? value : std::max(high, value);
+    }
+    section_min_ = low;
+    section_max_ = high;
+    section_level_ = 0.5 * (low + high);
+    if (slicer_.Get()) {
+      Reslice_();
+    } else {
+      StartSlicerJob_();
+    }
+  }
+  update();
+}
+
+void OpenGLWidget::UpdateSlicer_(bool rebuild) {
+  slicer_.Invalidate(rebuild);
+  section_ = Section();
+  if (section_axis_ < 0) {
+    // Иерархия прежних граней больше не понадобится
+    if (rebuild) slicer_.Release();
+    return;
+  }
+  // Контур на экране должен идти за моделью
+  StartSlicerJob_();
+}
+
+void OpenGLWidget::StartSlicerJob_() {
+  if (!slicer_.NeedsUpdate()) return;
+  const int count = vertex_coord_ ? std::max(count_vertex_coord_, 0) : 0;
+  if (!slicer_.NeedsBuild()) {
+    slicer_.StartRefit(vertex_coord_, count);
+    return;
+  }
+
+  std::vector<float> positions(vertex_coord_, vertex_coord_ + count);
+  std::vector<int> face_index, face_offset;
+  if (face_offset_ && face_count_ > 0) {
+    face_offset.assign(face_offset_, face_offset_ + face_count_ + 1);
+    face_index.assign(face_index_, face_index_ + face_offset.back());
+  }
+  slicer_.StartBuild([positions = std::move(positions),
+                      face_index = std::move(face_index),
+                      face_offset = std::move(face_offset)](
+                         Slicer& slicer) mutable {
+    slicer.Build(std::move(positions), std::move(face_index),
+                 std::move(face_offset));
+  });
+}
+
+void OpenGLWidget::FinishSlicerJob_() {
+  slicer_.Finish();
+  if (section_axis_ < 0) {
+    if (slicer_.NeedsBuild()) slicer_.Release();
+    return;
+  }
+  if (slicer_.NeedsUpdate()) {
+    StartSlicerJob_();
+  } else {
+    Reslice_();
+  }
+}
+
+void OpenGLWidget::NotifySlicer_(void* widget) {
+  auto* self = static_cast<OpenGLWidget*>(widget);
+  QMetaObject::invokeMethod(
+      self, [self] { self->FinishSlicerJob_(); }, Qt::QueuedConnection);
+}
+
+void OpenGLWidget::Reslice_() {
+  section_ = Section();
+  const Slicer* slicer = slicer_.Get();
+  if (slicer && section_axis_ >= 0) {
+    S21_TRACE_SCOPE("OpenGLWidget::Reslice_");
+    SlicePlane plane;
+    plane.normal[0] = plane.normal[1] = plane.normal[2] = 0.0;
+    plane.normal[section_axis_] = 1.0;
+    plane.offset = section_level_;
+    section_ = slicer->Slice(plane);
+  }
+  update();
+}
+
+void OpenGLWidget::DrawSectionCpu_() {
+  if (section_.polylines.empty()) return;
+  S21_TRACE_SCOPE("OpenGLWidget::DrawSectionCpu_");
+  const int frame_width = cpu_frame_.width, frame_height = cpu_frame_.height;
+  const Matrix4 m = CurrentCamera_().BuildMatrix(frame_width, frame_height);
+  const uint32_t color = MakeColor(255, 64, 64);
+  auto project = [&m, frame_width, frame_height](const double* p,
+                                                  double* screen) {
+    return ProjectToFrame(m, frame_width, frame_height, p, screen);
+  };
+  for (const SectionPolyline& polyline : section_.polylines) {
+    const size_t count = polyline.points.size() / 3;
+    const size_t segments = polyline.closed ? count : count - 1;
+    double from[2], to[2];
+    bool from_visible = count > 0 && project(polyline.points.data(), from);
+    for (size_t i = 0; i < segments && count > 1; ++i) {
+      const bool to_visible =
+          project(&polyline.points[(i + 1) % count * 3], to);
+      // Отрезок за ближней плоскостью пропускается целиком
+      if (from_visible && to_visible) {
+        DrawLine(cpu_frame_, from[0], from[1], to[0], to[1], color);
+      }
+      from[0] = to[0];
+      from[1] = to[1];
+      from_visible = to_visible;
+    }
+  }
+}
+
+void OpenGLWidget::DrawSectionOverlay_() {
+  static const char* const kAxisNames[] = {"X", "Y", "Z"};
+  const QString text =
+      !slicer_.Get()
+          ? QString("Сечение %1: строится иерархия граней...")
+                .arg(kAxisNames[section_axis_])
+          : QString("Сечение %1 = %2: контуров %3, точек %4")
+                .arg(kAxisNames[section_axis_])
+                .arg(section_level_, 0, 'g', 6)
+                .arg(section_.polylines.size())
+                .arg(section_.GetPointCount());
+  QPainter painter(this);
+  // Над подписями выделения и элемента под курсором
+  const QRectF label(8.0, height() - 86.0, width() - 16.0, 22.0);
+  const QRectF bounds = painter.boundingRect(label, Qt::AlignLeft, text);
+  painter.fillRect(bounds.adjusted(-6.0, -3.0, 6.0, 3.0), QColor(0, 0, 0, 170));
+  painter.setPen(QColor(255, 64, 64));
+  painter.drawText(label, Qt::AlignLeft, text);
+}
+
+// === Края и неманифолдные рёбра ===
+
+void OpenGLWidget::SetTopologyEdges(std::vector<int> boundary,
+                                    std::vector<int> non_manifold) {
+  boundary_edges_ = std::move(boundary);
+  non_manifold_edges_ = std::move(non_manifold);
+  update();
+}
+
+void OpenGLWidget::SetTopologyVisible(bool visible) {
+  topology_visible_ = visible;
   update();
 }
 
+void OpenGLWidget::SetVertexColors(const float* rgb) {
+  vertex_colors_ = rgb;
+  update();
+}
+
+void OpenGLWidget::DrawVertexColorsCpu_() {
+  if (!vertex_colors_) return;
+  const int frame_width = cpu_frame_.width, frame_height = cpu_frame_.height;
+  const Matrix4 m = CurrentCamera_().BuildMatrix(frame_width, frame_height);
+  // Растеризатор рисует линию одним цветом: берётся средний цвет концов
+  for (size_t i = 0; i + 1 < cpu_mesh_.edges.size(); i += 2) {
+    const size_t a = cpu_mesh_.edges[i], b = cpu_mesh_.edges[i + 1];
+    double from[2], to[2];
+    if (!ProjectToFrame(m, frame_width, frame_height, vertex_coord_ + a * 3,
+                        from) ||
+        !ProjectToFrame(m, frame_width, frame_height, vertex_coord_ + b * 3,
+                        to)) {
+      continue;
+    }
+    const float* ca = vertex_colors_ + a * 3;
+    const float* cb = vertex_colors_ + b * 3;
+    DrawLine(cpu_frame_, from[0], from[1], to[0], to[1],
+             MakeColor(static_cast<uint8_t>((ca[0] + cb[0]) * 127.5f),
+                       static_cast<uint8_t>((ca[1] + cb[1]) * 127.5f),
+                       static_cast<uint8_t>((ca[2] + cb[2]) * 127.5f)));
+  }
+}
+
+void OpenGLWidget::DrawTopologyCpu_() {
+  if (!topology_visible_) return;
+  const int frame_width = cpu_frame_.width, frame_height = cpu_frame_.height;
+  const Matrix4 m = CurrentCamera_().BuildMatrix(frame_width, frame_height);
+  const int vertex_count = count_vertex_coord_ / 3;
+  auto draw = [&](const std::vector<int>& edges, uint32_t color) {
+    for (size_t i = 0; i + 1 < edges.size(); i += 2) {
+      if (edges[i] >= vertex_count || edges[i + 1] >= vertex_count) continue;
+      double from[2], to[2];
+      if (ProjectToFrame(m, frame_width, frame_height,
+                         vertex_coord_ + size_t(edges[i]) * 3, from) &&
+          ProjectToFrame(m, frame_width, frame_height,
+                         vertex_coord_ + size_t(edges[i + 1]) * 3, to)) {
+        DrawLine(cpu_frame_, from[0], from[1], to[0], to[1], color);
+      }
+    }
+  };
+  draw(boundary_edges_, MakeColor(50, 190, 255));
+  draw(non_manifold_edges_, MakeColor(255, 50, 255));
+}
+
+void OpenGLWidget::RecordMouseEvent_(recorded_event_t type,
+                                     const QMouseEvent* event) {
+  InputRecorder& recorder = InputRecorder::GetInstance();
+  if (!recorder.IsRecording()) {
+    return;
+  }
+  const int buttons = static_cast<int>(event->buttons()) << 16;
+  recorder.Record(type, event->pos().x(), event->pos().y(),
+                  static_cast<int>(event->button()) | buttons);
+}
+
 void OpenGLWidget::dropEvent(QDropEvent* event) {
   /**
    * @brief Обработка drag&drop для загрузки OBJ файлов
@@ -6,17 +6,42 @@
  * @brief OpenGL виджет для отображения 3D моделей в каркасном режиме
  */
 
+#include <QElapsedTimer>
+#include <QImage>
 #include <QOpenGLFunctions>
+#include <QOpenGLTimerQuery>
 #include <QOpenGLWidget>
 #include <QPoint>
+#include <QPointF>
+#include <QSize>
+#include <QStaticText>
+#include <array>
+#include <functional>
+#include <memory>
 #include <vector>
 
+#include "../model/slicer.h"
+#include "../model/worker_queue.h"
+#include "../profiling/frame_stats.h"
+#include "../profiling/input_recorder.h"
+#include "../render/picker.h"
+#include "../render/rasterizer.h"
+#include "../render/refit_scheduler.h"
+
 class QMouseEvent;
 class QWheelEvent;
 class QDropEvent;
 
 namespace s21 {
 
+/**
+ * @brief Чем рисуется модель в виджете
+ */
+enum render_backend_t {
+  kBackendOpenGL = 0,  ///< Драйвер OpenGL (GL_LINES)
+  kBackendCpu = 1      ///< Многопоточный Rasterizer, кадр выводится QPainter
+};
+
 /**
  * @brief Виджет OpenGL для интерактивного отображения 3D моделей
  *
@@ -79,9 +104,11 @@ class OpenGLWidget : public QOpenGLWidget, protected QOpenGLFunctions {
   explicit OpenGLWidget(QWidget* parent = nullptr);
 
   /**
-   * @brief Деструктор по умолчанию
+   * @brief Деструктор
+   *
+   * Освобождает запросы таймера GPU в контексте виджета.
    */
-  ~OpenGLWidget() = default;
+  ~OpenGLWidget();
 
   /**
    * @brief Устанавливает данные 3D модели для отображения
@@ -94,6 +121,8 @@ class OpenGLWidget : public QOpenGLWidget, protected QOpenGLFunctions {
    * @param vertex_coord Массив координат вершин (x,y,z последовательно)
    * @param count_vertex_index Количество элементов в массиве индексов
    * @param count_vertex_coord Количество элементов в массиве координат
+   * @param topology_changed false - сдвинулись только вершины
+   * (трансформация), иерархии выбора не перестраиваются, а обновляются
    *
    * @pre vertex_index и vertex_coord не должны быть nullptr при count > 0
    * @pre count_vertex_index должен быть чётным (пары индексов рёбер)
@@ -104,8 +133,9 @@ class OpenGLWidget : public QOpenGLWidget, protected QOpenGLFunctions {
    * @warning Виджет не владеет данными, указатели должны оставаться валидными
    * @see paintGL()
    */
-  void SetModelData(int* vertex_index, double* vertex_coord,
-                    int count_vertex_index, int count_vertex_coord);
+  void SetModelData(const int* vertex_index, double* vertex_coord,
+                    int count_vertex_index, int count_vertex_coord,
+                    bool topology_changed = true);
 
   /**
    * @brief Обрабатывает нажатие кнопки мыши (публичная обёртка)
@@ -172,6 +202,184 @@ class OpenGLWidget : public QOpenGLWidget, protected QOpenGLFunctions {
    */
   void HandleDrop(QDropEvent* event);
 
+  /**
+   * @brief Показывает или скрывает оверлей производительности (HUD)
+   *
+   * HUD выводит FPS, время CPU и GPU кадра, счётчики рёбер, объём
+   * переданных вершинных данных, длительности последних загрузки и
+   * трансформации, а также график времени кадра.
+   *
+   * @param visible true - оверлей отображается
+   */
+  void SetHudVisible(bool visible);
+
+  /**
+   * @brief Проверяет, отображается ли оверлей производительности
+   */
+  bool IsHudVisible() const noexcept { return hud_visible_; }
+
+  /**
+   * @brief Передаёт в HUD длительности операций контроллера
+   * @param load_ms Длительность последней загрузки, мс
+   * @param transform_ms Длительность последней трансформации, мс
+   */
+  void SetOperationTimings(double load_ms, double transform_ms);
+
+  /**
+   * @brief Выбирает, чем рисовать модель
+   *
+   * kBackendCpu строит кадр программным Rasterizer во всех ядрах и
+   * выводит его картинкой: сглаженные линии без поддержки драйвера и
+   * предсказуемое время кадра там, где OpenGL программный (llvmpipe).
+   * Проекция та же, что у OpenGL: куб [-1, 1] растянут на весь виджет.
+   */
+  void SetRenderBackend(render_backend_t backend);
+
+  /**
+   * @brief Возвращает текущий способ отрисовки
+   */
+  render_backend_t GetRenderBackend() const noexcept { return backend_; }
+
+  /**
+   * @brief Возвращает камеру, повторяющую трансформации окна
+   */
+  Camera GetCamera() const { return CurrentCamera_(); }
+
+  /**
+   * @brief Ставит повороты, смещение и масштаб окна по камере
+   *
+   * Проекция камеры не меняется; масштаб ограничивается пределами
+   * колеса мыши.
+   *
+   * @see FitCameraToBox
+   */
+  void SetCamera(const Camera& camera);
+
+  static constexpr float kMinScale = 0.1f;   ///< Наименьший масштаб
+  static constexpr float kMaxScale = 10.0f;  ///< Наибольший масштаб
+
+  /**
+   * @brief Обработчик готового снимка; пустой QImage - ошибка
+   */
+  using CaptureCallback = std::function<void(QImage)>;
+
+  static constexpr int kMaxCaptureSide = 16384;  ///< Наибольшая сторона снимка
+
+  /**
+   * @brief Запрашивает снимок кадра в scale раз больше окна
+   *
+   * Снимок снимается в ближайшем paintGL без HUD и не останавливает
+   * конвейер: пиксели копируются в pixel buffer object, готовность
+   * проверяется забором (glFenceSync) в следующих итерациях цикла
+   * событий. При scale > 1 кадр рисуется плитками размером с окно во
+   * внеэкранный буфер (TileMatrix), плитки читаются в общий буфер.
+   * Программный растеризатор рисует снимок целиком в фоновом потоке.
+   *
+   * @param scale Увеличение 1..kMaxCaptureScale; сторона снимка
+   * ограничивается kMaxCaptureSide
+   * @param done Вызывается в GUI-потоке с изображением сверху вниз
+   */
+  void RequestCapture(int scale, CaptureCallback done);
+
+  /**
+   * @brief Возвращает элемент под курсором (kPickNone - нет)
+   */
+  const PickResult& GetHoveredElement() const noexcept { return hover_; }
+
+  /**
+   * @brief Возвращает число и box выделенных вершин
+   *
+   * Выделение: Shift + левая кнопка - рамка, Shift + правая - лассо;
+   * с Alt область добавляется к выделению, с Ctrl - вычитается.
+   * Shift + щелчок без перетаскивания снимает выделение.
+   */
+  const SelectionStats& GetSelectionStats() const noexcept {
+    return selection_stats_;
+  }
+
+  /**
+   * @brief Снимает выделение вершин
+   */
+  void ClearSelection();
+
+  /**
+   * @brief Передаёт грани модели для сечения плоскостью
+   *
+   * Вызывается при смене модели перед SetModelData. Грани не меняются
+   * трансформациями, поэтому передаются один раз на модель.
+   *
+   * @param face_index Индексы вершин граней подряд
+   * @param face_offset Начала граней в face_index (face_count + 1)
+   * @param face_count Число граней
+   *
+   * @warning Виджет не владеет данными, указатели должны оставаться валидными
+   */
+  void SetModelFaces(const int* face_index, const int* face_offset,
+                     int face_count);
+
+  /**
+   * @brief Включает сечение плоскостью, перпендикулярной оси
+   *
+   * Плоскость ставится в середину габарита модели по оси; Alt + левая
+   * кнопка сдвигает её перетаскиванием по вертикали. Иерархия граней
+   * строится в фоне при первом включении и после смены модели, пока
+   * она строится, контур не показывается.
+   *
+   * @param axis Ось:
+   *   - 0 (kX) - ось X
+   *   - 1 (kY) - ось Y
+   *   - 2 (kZ) - ось Z
+   *   - -1 - сечение выключено
+   */
+  void SetSectionAxis(int axis);
+
+  /**
+   * @brief Возвращает ось сечения (-1 - выключено)
+   */
+  int GetSectionAxis() const noexcept { return section_axis_; }
+
+  /**
+   * @brief Возвращает текущий контур сечения
+   */
+  const Section& GetSection() const noexcept { return section_; }
+
+  /**
+   * @brief Передаёт рёбра края и неманифолдные рёбра для подсветки
+   *
+   * Пары вершин, как vertex_index; сбрасываются при смене модели.
+   *
+   * @see Topology
+   */
+  void SetTopologyEdges(std::vector<int> boundary,
+                        std::vector<int> non_manifold);
+
+  /**
+   * @brief Показывает или скрывает подсветку рёбер края
+   */
+  void SetTopologyVisible(bool visible);
+
+  /**
+   * @brief Проверяет, показывается ли подсветка рёбер края
+   */
+  bool IsTopologyVisible() const noexcept { return topology_visible_; }
+
+  /**
+   * @brief Задаёт цвета вершин каркаса (тепловая карта отклонений)
+   *
+   * Массив r, g, b в [0, 1] на вершину принадлежит вызывающему и должен
+   * жить, пока задан; сбрасывается при смене модели.
+   *
+   * @param rgb Цвета или nullptr - белый каркас
+   *
+   * @see MakeHeatMap
+   */
+  void SetVertexColors(const float* rgb);
+
+  /**
+   * @brief Проверяет, раскрашен ли каркас цветами вершин
+   */
+  bool HasVertexColors() const noexcept { return vertex_colors_ != nullptr; }
+
  protected:
   /**
    * @brief Инициализирует OpenGL контекст и настройки рендеринга
@@ -320,10 +528,222 @@ class OpenGLWidget : public QOpenGLWidget, protected QOpenGLFunctions {
    */
   void dropEvent(QDropEvent* event) override;
 
+  /**
+   * @brief Снимает подсветку элемента, когда курсор покидает виджет
+   */
+  void leaveEvent(QEvent* event) override;
+
  private:
+  /**
+   * @brief Передаёт событие мыши в регистратор ввода (если идёт запись)
+   * @param type Тип события: нажатие, движение или отпускание
+   * @param event Событие мыши в координатах виджета
+   */
+  void RecordMouseEvent_(recorded_event_t type, const QMouseEvent* event);
+
+  /**
+   * @brief Отрисовывает рёбра модели и обновляет счётчики кадра
+   */
+  void DrawModel_();
+
+  /**
+   * @brief Рисует модель программным растеризатором
+   */
+  void DrawModelCpu_();
+
+  /**
+   * @brief Камера растеризатора, повторяющая трансформации виджета
+   */
+  Camera CurrentCamera_() const;
+
+  /**
+   * @brief Запрос снимка до ближайшего кадра
+   */
+  struct CaptureRequest {
+    int scale = 1;          ///< Увеличение относительно окна
+    CaptureCallback done;   ///< Получатель снимка
+  };
+
+  /**
+   * @brief Чтение снимка, ожидающее завершения на GPU
+   */
+  struct PendingReadback {
+    GLuint buffer = 0;        ///< Pixel buffer object
+    GLsync fence = nullptr;   ///< Забор после glReadPixels
+    int width = 0;            ///< Ширина снимка
+    int height = 0;           ///< Высота снимка
+    CaptureCallback done;     ///< Получатель снимка
+  };
+
+  /**
+   * @brief Запускает асинхронное чтение кадра (или плиток) в PBO
+   */
+  void StartReadback_(const CaptureRequest& request);
+
+  /**
+   * @brief Забирает готовые PBO и передаёт снимки получателям
+   */
+  void PollReadbacks_();
+
+  /**
+   * @brief Рисует снимок программным растеризатором в фоновом потоке
+   */
+  void CaptureCpu_(const CaptureRequest& request);
+
+  /**
+   * @brief Размер снимка: размер кадра в scale раз, не больше предела
+   */
+  QSize CaptureSize_(int& scale) const;
+
+  /**
+   * @brief Рисует оверлей производительности поверх кадра
+   *
+   * Текст пересобирается не чаще kHudTextIntervalMs, график строится
+   * в заранее выделенном массиве точек, поэтому HUD не выделяет память
+   * на каждом кадре.
+   */
+  void DrawHud_();
+
+  /**
+   * @brief Восстанавливает состояние OpenGL после рисования QPainter
+   */
+  void RestoreGlState_();
+
+  /**
+   * @brief Запускает запрос времени GPU для текущего кадра
+   *
+   * Использует два чередующихся запроса GL_TIME_ELAPSED: результат
+   * предыдущего кадра читается только если уже готов, поэтому
+   * конвейер не останавливается.
+   */
+  void BeginGpuTimer_();
+
+  /**
+   * @brief Завершает запрос времени GPU текущего кадра
+   */
+  void EndGpuTimer_();
+
+  /**
+   * @brief Отмечает иерархии выбора устаревшими
+   *
+   * Трансформация не копирует координаты: иерархии обновляются при
+   * следующем наведении или нажатии, а сразу - только пока показан итог
+   * выделения. Пока иерархии строятся, выбор под курсором недоступен.
+   *
+   * @param rebuild true - сменились рёбра, иначе достаточно Refit
+   */
+  void UpdatePicker_(bool rebuild);
+
+  /**
+   * @brief Запускает обновление устаревших иерархий в picker_worker_
+   *
+   * Refit идёт через двойной буфер picker_ без выделения памяти; при
+   * смене рёбер иерархии строятся по копии данных модели.
+   */
+  void StartPickerJob_();
+
+  /**
+   * @brief Принимает обновлённые иерархии в GUI-потоке
+   */
+  void FinishPickerJob_();
+
+  /**
+   * @brief Передаёт завершение задачи picker_ в GUI-поток
+   * @param widget Виджет (вызывается в picker_worker_)
+   */
+  static void NotifyPicker_(void* widget);
+
+  /**
+   * @brief Выбирает элемент под точкой виджета и перерисовывает подсветку
+   */
+  void PickAt_(const QPoint& position);
+
+  /**
+   * @brief Рисует маркер и подпись элемента под курсором
+   */
+  void DrawHovered_();
+
+  /**
+   * @brief Выделяет вершины в нарисованной рамке или лассо
+   * @param mode Как сочетать с прежним выделением
+   */
+  void ApplySelection_(select_mode_t mode);
+
+  /**
+   * @brief Пересобирает список и итог выделения после его изменения
+   */
+  void RefreshSelection_();
+
+  /**
+   * @brief Рисует выделенные вершины поверх кадра растеризатора
+   */
+  void DrawSelectionCpu_();
+
+  /**
+   * @brief Рисует рамку или лассо при выделении и итог выделения
+   */
+  void DrawSelectionOverlay_();
+
+  /**
+   * @brief Отмечает иерархию граней устаревшей и запускает обновление
+   *
+   * Работает как UpdatePicker_, но иерархия строится только при
+   * включённом сечении: без него достаточно отметки.
+   *
+   * @param rebuild true - сменились грани, иначе достаточно Refit
+   */
+  void UpdateSlicer_(bool rebuild);
+
+  /**
+   * @brief Запускает обновление устаревшей иерархии в picker_worker_
+   *
+   * Как и для Picker, Refit идёт через двойной буфер без выделения
+   * памяти, а грани копируются только при перестройке.
+   */
+  void StartSlicerJob_();
+
+  /**
+   * @brief Принимает обновлённую иерархию в GUI-потоке
+   */
+  void FinishSlicerJob_();
+
+  /**
+   * @brief Передаёт завершение задачи slicer_ в GUI-поток
+   * @param widget Виджет (вызывается в picker_worker_)
+   */
+  static void NotifySlicer_(void* widget);
+
+  /**
+   * @brief Пересчитывает контур на текущем уровне плоскости
+   */
+  void Reslice_();
+
+  /**
+   * @brief Рисует контур сечения поверх кадра растеризатора
+   */
+  void DrawSectionCpu_();
+
+  /**
+   * @brief Рисует подпись сечения
+   */
+  void DrawSectionOverlay_();
+
+  /**
+   * @brief Рисует рёбра края поверх кадра растеризатора
+   */
+  void DrawTopologyCpu_();
+
+  /**
+   * @brief Перерисовывает каркас цветами вершин поверх кадра
+   */
+  void DrawVertexColorsCpu_();
+
+  static constexpr double kHudTextIntervalMs =
+      250.0;  ///< Период обновления текста HUD
+
   // === Данные 3D модели ===
   double* vertex_coord_;  ///< Указатель на массив координат вершин (x,y,z,...)
-  int* vertex_index_;  ///< Указатель на массив индексов рёбер (пары индексов)
+  const int* vertex_index_;  ///< Индексы рёбер (пары индексов)
   int count_vertex_coord_;  ///< Количество элементов в массиве координат
   int count_vertex_index_;  ///< Количество элементов в массиве индексов
 
@@ -340,6 +760,68 @@ class OpenGLWidget : public QOpenGLWidget, protected QOpenGLFunctions {
   float translate_y_;  ///< Смещение по оси Y в единицах модели
   float translate_z_;  ///< Смещение по оси Z в единицах модели
 
+  // === Оверлей производительности ===
+  bool hud_visible_ = false;  ///< Флаг отображения HUD
+  FrameStats frame_stats_;    ///< История времени кадров
+  OperationTimings timings_;  ///< Длительности операций контроллера
+  QElapsedTimer frame_clock_;  ///< Монотонные часы для замеров кадра
+  QOpenGLTimerQuery gpu_timers_[2];  ///< Чередующиеся запросы GL_TIME_ELAPSED
+  bool gpu_timer_pending_[2] = {false, false};  ///< Запрос ждёт результата
+  int gpu_timer_index_ = 0;            ///< Запрос текущего кадра
+  bool gpu_timer_created_ = false;     ///< Запросы таймера созданы
+  bool first_frame_presented_ = false;  ///< Первый кадр выведен (запуск)
+  bool gpu_timer_supported_ = false;   ///< Драйвер поддерживает таймеры
+  QStaticText hud_text_;               ///< Закэшированный текст HUD
+  double hud_text_updated_ms_ = -1e9;  ///< Момент обновления текста
+  std::array<QPointF, FrameStats::kHistorySize>
+      graph_points_;  ///< Точки графика времени кадра
+
+  // === Программная отрисовка ===
+  render_backend_t backend_ = kBackendOpenGL;  ///< Способ отрисовки
+  Rasterizer rasterizer_;  ///< Растеризатор (буферы живут между кадрами)
+  RenderMesh cpu_mesh_;    ///< Модель в формате растеризатора
+  Image cpu_frame_;        ///< Последний кадр растеризатора
+
+  // === Снимки ===
+  static constexpr int kReadbackPollMs = 2;  ///< Период опроса заборов
+  std::vector<CaptureRequest> capture_requests_;  ///< Ждут кадра
+  std::vector<PendingReadback> readbacks_;        ///< Ждут GPU
+  WorkerQueue capture_worker_{2};  ///< Снимки программного растеризатора
+
+  // === Выбор под курсором ===
+  PickResult hover_;             ///< Элемент под курсором
+  QPoint hover_position_;        ///< Последняя позиция курсора без кнопок
+  WorkerQueue picker_worker_{2};  ///< Иерархии выбора и сечения (по слоту)
+  RefitScheduler<Picker> picker_;  ///< Иерархии выбора (после очереди)
+
+  // === Выделение вершин ===
+  bool selecting_ = false;        ///< Идёт перетаскивание рамки или лассо
+  bool selecting_lasso_ = false;  ///< Лассо (иначе рамка)
+  std::vector<QPointF> selection_path_;  ///< Углы рамки или точки лассо
+  SelectionBits selection_;  ///< Выделение в порядке иерархии picker_
+  std::vector<uint32_t> selected_vertices_;  ///< Номера для отрисовки
+  SelectionStats selection_stats_;           ///< Число и box выделенных
+
+  // === Сечение плоскостью ===
+  const int* face_index_ = nullptr;   ///< Индексы вершин граней
+  const int* face_offset_ = nullptr;  ///< Начала граней (face_count_ + 1)
+  int face_count_ = 0;                ///< Число граней
+  int section_axis_ = -1;         ///< Ось нормали плоскости (-1 - выключено)
+  double section_level_ = 0.0;    ///< Положение плоскости на оси
+  double section_min_ = 0.0;      ///< Габарит модели по оси при включении
+  double section_max_ = 0.0;      ///< (пределы перетаскивания)
+  bool dragging_section_ = false;  ///< Плоскость перетаскивается
+  RefitScheduler<Slicer> slicer_;  ///< Иерархия граней (после очереди)
+  Section section_;                ///< Контур на текущем уровне
+
+  // === Края и неманифолдные рёбра ===
+  std::vector<int> boundary_edges_;      ///< Пары вершин рёбер края
+  std::vector<int> non_manifold_edges_;  ///< Пары вершин рёбер 3+ граней
+  bool topology_visible_ = true;         ///< Подсветка включена
+
+  // === Тепловая карта ===
+  const float* vertex_colors_ = nullptr;  ///< Цвета вершин (не владеет)
+
  signals:
   /**
    * @brief Сигнал о перетаскивании файла на виджет
@@ -356,6 +838,16 @@ class OpenGLWidget : public QOpenGLWidget, protected QOpenGLFunctions {
    * @see View::HandleFileDropped()
    */
   void fileDropped(const QString& filepath);
+
+  /**
+   * @brief Сигнал об отрисованном кадре
+   *
+   * Испускается в конце каждого paintGL. Используется телеметрией
+   * soak-прогонов.
+   *
+   * @param cpu_ms Время CPU на кадр, мс
+   */
+  void FrameRendered(double cpu_ms);
 };
 
 }  // namespace s21
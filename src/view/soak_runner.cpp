@@ -0,0 +1,69 @@
+/**
+ * @file soak_runner.cpp
+ * @brief Реализация длительного (soak) прогона
+ */
+
+#include "soak_runner.h"
+
+#include "gui.h"
+
+namespace s21 {
+
+SoakRunner::SoakRunner(View* view, QObject* parent)
+    : QObject(parent), view_(view) {
+  connect(view_, &View::ReplayFinished, this,
+          &SoakRunner::HandlePassFinished_);
+}
+
+void SoakRunner::SetCacheSizeFunction(std::function<int64_t()> cache_size) {
+  cache_size_ = std::move(cache_size);
+}
+
+bool SoakRunner::Start(const QString& telemetry_path,
+                       std::vector<RecordedEvent> script,
+                       qint64 duration_ms) {
+  if (script.empty() || !writer_.Open(telemetry_path.toStdString())) {
+    return false;
+  }
+
+  script_ = std::move(script);
+  telemetry_path_ = telemetry_path;
+  duration_ms_ = duration_ms;
+  passes_ = 0;
+  running_ = true;
+  clock_.start();
+  view_->StartReplay(script_, false);
+  return true;
+}
+
+void SoakRunner::RecordFrame(double cpu_ms) {
+  if (running_) {
+    writer_.Append(kTelemetryFrame, cpu_ms, cache_size_ ? cache_size_() : 0);
+  }
+}
+
+void SoakRunner::RecordOperation(telemetry_kind_t kind, double duration_ms) {
+  if (running_) {
+    writer_.Append(kind, duration_ms, cache_size_ ? cache_size_() : 0);
+  }
+}
+
+void SoakRunner::HandlePassFinished_() {
+  if (!running_) {
+    return;
+  }
+
+  ++passes_;
+  writer_.Flush();
+  if (clock_.elapsed() < duration_ms_) {
+    view_->StartReplay(script_, false);
+    return;
+  }
+
+  running_ = false;
+  std::vector<TelemetrySample> samples;
+  ReadTelemetryCsv(telemetry_path_.toStdString(), samples);
+  emit Finished(CheckDrift(samples));
+}
+
+}  // namespace s21
@@ -0,0 +1,104 @@
+#ifndef VIEW_SOAK_RUNNER_H
+#define VIEW_SOAK_RUNNER_H
+
+/**
+ * @file soak_runner.h
+ * @brief Длительный (soak) прогон с записью телеметрии
+ */
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QString>
+#include <functional>
+#include <vector>
+
+#include "../profiling/soak.h"
+#include "../profiling/telemetry.h"
+
+namespace s21 {
+
+class View;
+
+/**
+ * @brief Длительный прогон сценария с покадровой телеметрией
+ *
+ * Воспроизводит сценарий через View::StartReplay по кругу, пока не истечёт
+ * заданное время. Каждый кадр и каждая операция контроллера пишутся в CSV
+ * (время, RSS, занятая куча, размер кэшей). По окончании телеметрия
+ * проверяется CheckDrift и испускается Finished.
+ *
+ * Работает и без дисплея: QT_QPA_PLATFORM=offscreen.
+ *
+ * @example
+ * @code
+ * SoakRunner soak(&view);
+ * connect(&view, &View::FrameRendered, &soak, &SoakRunner::RecordFrame);
+ * soak.Start("soak.csv", BuildSoakScript(models), 60 * 60 * 1000);
+ * @endcode
+ */
+class SoakRunner : public QObject {
+  Q_OBJECT
+
+ public:
+  /**
+   * @brief Создаёт прогон для представления
+   * @param view Представление, через которое воспроизводится сценарий
+   */
+  explicit SoakRunner(View* view, QObject* parent = nullptr);
+
+  /**
+   * @brief Устанавливает функцию оценки размера кэшей приложения, КиБ
+   */
+  void SetCacheSizeFunction(std::function<int64_t()> cache_size);
+
+  /**
+   * @brief Начинает прогон
+   * @param telemetry_path Путь к CSV телеметрии
+   * @param script Сценарий в формате InputRecorder
+   * @param duration_ms Длительность прогона, мс
+   * @return false если файл телеметрии не открыт или сценарий пуст
+   */
+  bool Start(const QString& telemetry_path, std::vector<RecordedEvent> script,
+             qint64 duration_ms);
+
+ public slots:
+  /**
+   * @brief Записывает отрисованный кадр
+   * @param cpu_ms Время CPU на кадр, мс
+   */
+  void RecordFrame(double cpu_ms);
+
+  /**
+   * @brief Записывает операцию контроллера
+   * @param kind kTelemetryLoad или kTelemetryTransform
+   * @param duration_ms Длительность операции, мс
+   */
+  void RecordOperation(s21::telemetry_kind_t kind, double duration_ms);
+
+ signals:
+  /**
+   * @brief Прогон завершён и телеметрия проверена
+   * @param report Результат проверки дрейфа
+   */
+  void Finished(const s21::DriftReport& report);
+
+ private:
+  /**
+   * @brief Обрабатывает конец очередного прохода сценария
+   */
+  void HandlePassFinished_();
+
+  View* view_;                          ///< Представление для воспроизведения
+  std::function<int64_t()> cache_size_;  ///< Оценка размера кэшей
+  std::vector<RecordedEvent> script_;   ///< Сценарий прогона
+  TelemetryWriter writer_;              ///< Запись телеметрии
+  QString telemetry_path_;              ///< Путь к CSV
+  QElapsedTimer clock_;                 ///< Время от начала прогона
+  qint64 duration_ms_ = 0;              ///< Длительность прогона
+  bool running_ = false;                ///< Идёт прогон
+  int passes_ = 0;                      ///< Завершённых проходов сценария
+};
+
+}  // namespace s21
+
+#endif  // VIEW_SOAK_RUNNER_H